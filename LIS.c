@@ -1,35 +1,24 @@
 #include <stdio.h>
-
-int f(int A[],int i, int j){
-    if (i < 0)
-    {
-        return 0;
-    }
-    if (A[j] < A[i])
-    {
-        return f(A, i - 1, j);
-    }
-    if (A[i] < A[j])
-    {
-        return 1 + f(A, i-1, i);
-    }
-}
+#include "data_structures/sequence/lis.h"
 
 int LIS(int A[], int n) {
-    int maxLen = 0;
-    for (int j = 0; j < n; j++) {
-        int len = 1 + f(A, j - 1, j); // +1 for A[j] itself
-        if (len > maxLen) {
-            maxLen = len;
-        }
-    }
-    return maxLen;
+    return (int)lis_compute(A, (size_t)n, true, NULL);
 }
 
 
 int main(int argc, char *argv[]) {
-   int A[] = {10, 9, 2, 5, 3, 57, 101, 18};
+    (void)argc;
+    (void)argv;
+    int A[] = {10, 9, 2, 5, 3, 57, 101, 18};
     int n = sizeof(A) / sizeof(A[0]);
     printf("Length of LIS = %d\n", LIS(A, n));
+
+    size_t indices[sizeof(A) / sizeof(A[0])];
+    size_t length = lis_compute(A, (size_t)n, true, indices);
+    printf("One LIS:");
+    for (size_t k = 0; k < length; k++) {
+        printf(" %d", A[indices[k]]);
+    }
+    printf("\n");
     return 0;
-}
\ No newline at end of file
+}
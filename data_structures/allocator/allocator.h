@@ -0,0 +1,102 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+/**
+ * ALLOCATOR INTERFACE
+ *
+ * Pluggable memory source for node-based containers (tree, doubly linked list,
+ * hash table entries, graph vertices/edges). Each container stores a
+ * `const Allocator *` set by its *_init_with_allocator function; plain *_init
+ * uses HEAP_ALLOCATOR (malloc/free), and a NULL allocator behaves the same.
+ *
+ * Allocators with a reset hook (Pool, Arena) reclaim everything at once, so
+ * containers skip the per-node walk in their *_free and let the owner call
+ * allocator_reset() or the pool/arena destroy function instead. Containers
+ * that own other heap memory per node (copied hash keys, neighbor arrays)
+ * still walk to release that.
+ *
+ * Bundled implementations:
+ * - allocator/pool.h:  fixed-size slab pool with free list, O(1) alloc/free
+ * - allocator/arena.h: bump arena, O(1) alloc, free is a no-op
+ */
+
+// Allocator vtable plus its context
+typedef struct Allocator {
+    void *(*alloc)(void *ctx, size_t size);           // NULL on failure
+    void (*free)(void *ctx, void *ptr, size_t size);  // size as passed to alloc
+    void (*reset)(void *ctx);                         // Release everything, or NULL
+    void *ctx;                                        // Implementation state
+} Allocator;
+
+// ==================== DEFAULT HEAP ALLOCATOR ====================
+
+static inline void *heap_allocator_alloc(void *ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static inline void heap_allocator_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)size;
+    free(ptr);
+}
+
+static const Allocator HEAP_ALLOCATOR = {
+    .alloc = heap_allocator_alloc,
+    .free = heap_allocator_free,
+    .reset = NULL,
+    .ctx = NULL
+};
+
+// ==================== ALLOCATOR OPERATIONS ====================
+
+/**
+ * Allocate memory from allocator
+ * @param allocator: Allocator (NULL = heap)
+ * @param size: Bytes to allocate
+ * @return: Memory or NULL on failure
+ */
+static inline void *allocator_alloc(const Allocator *allocator, size_t size) {
+    if (!allocator) return malloc(size);
+    return allocator->alloc(allocator->ctx, size);
+}
+
+/**
+ * Return memory to allocator
+ * @param allocator: Allocator (NULL = heap)
+ * @param ptr: Memory from allocator_alloc (NULL is ignored)
+ * @param size: Size passed to allocator_alloc
+ */
+static inline void allocator_free(const Allocator *allocator, void *ptr, size_t size) {
+    if (!ptr) return;
+    if (!allocator) {
+        free(ptr);
+        return;
+    }
+    allocator->free(allocator->ctx, ptr, size);
+}
+
+/**
+ * Release all memory handed out by allocator
+ * @param allocator: Allocator
+ * @return: true if allocator supports reset
+ */
+static inline bool allocator_reset(const Allocator *allocator) {
+    if (!allocator || !allocator->reset) return false;
+    allocator->reset(allocator->ctx);
+    return true;
+}
+
+/**
+ * Check whether allocator reclaims memory in bulk (containers may skip per-node frees)
+ * @param allocator: Allocator
+ * @return: true for region-style allocators
+ */
+static inline bool allocator_frees_in_bulk(const Allocator *allocator) {
+    return allocator && allocator->reset != NULL;
+}
+
+#endif // ALLOCATOR_H
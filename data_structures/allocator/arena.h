@@ -0,0 +1,178 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "allocator.h"
+#include <stdint.h>
+
+/**
+ * BUMP ARENA ALLOCATOR
+ *
+ * Variable-size allocations carved sequentially from large chunks. Individual
+ * frees are no-ops; arena_reset() rewinds to empty (keeping one chunk for
+ * reuse) and arena_destroy() returns everything to the system. Ideal for data
+ * with a shared lifetime, e.g. every Player in a BasketballSystem.
+ *
+ * The arena embeds its Allocator (ctx points back at the arena), so an Arena
+ * must not be moved or copied after arena_init.
+ *
+ * Time Complexities:
+ * - Alloc: O(1)
+ * - Free: O(1) (no-op)
+ * - Reset / Destroy: O(number of chunks)
+ *
+ * Space Complexity: O(total bytes allocated since last reset)
+ */
+
+// Configuration constants
+#define ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT 16
+
+// Chunk header, payload follows
+typedef struct ArenaChunk {
+    struct ArenaChunk *next; // Older chunk
+    size_t capacity;         // Payload bytes
+} ArenaChunk;
+
+// Arena structure
+typedef struct Arena {
+    ArenaChunk *chunks;    // Newest first
+    unsigned char *cursor; // Next free byte in newest chunk
+    unsigned char *end;    // End of newest chunk
+    size_t chunk_size;     // Default payload size for new chunks
+    size_t used;           // Bytes handed out since last reset
+    Allocator allocator;   // Interface bound to this arena
+} Arena;
+
+// Bytes reserved for the chunk header so payload stays aligned
+#define ARENA_HEADER_SIZE \
+    ((sizeof(ArenaChunk) + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT)
+
+// ==================== CORE OPERATIONS ====================
+
+/**
+ * Add chunk with at least min_size payload bytes (internal helper)
+ * @param arena: Target arena
+ * @param min_size: Bytes needed
+ * @return: true on success
+ */
+static inline bool arena_add_chunk(Arena *arena, size_t min_size) {
+    size_t capacity = min_size > arena->chunk_size ? min_size : arena->chunk_size;
+    ArenaChunk *chunk = (ArenaChunk *)malloc(ARENA_HEADER_SIZE + capacity);
+    if (!chunk) return false;
+    chunk->next = arena->chunks;
+    chunk->capacity = capacity;
+    arena->chunks = chunk;
+    arena->cursor = (unsigned char *)chunk + ARENA_HEADER_SIZE;
+    arena->end = arena->cursor + capacity;
+    return true;
+}
+
+/**
+ * Allocate aligned memory from arena
+ * @param arena: Target arena
+ * @param size: Bytes to allocate
+ * @return: Memory or NULL on failure
+ */
+static inline void *arena_alloc(Arena *arena, size_t size) {
+    size = (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+    if (size == 0) size = ARENA_ALIGNMENT;
+
+    if (!arena->cursor || (size_t)(arena->end - arena->cursor) < size) {
+        if (!arena_add_chunk(arena, size)) return NULL;
+    }
+
+    void *ptr = arena->cursor;
+    arena->cursor += size;
+    arena->used += size;
+    return ptr;
+}
+
+/**
+ * Rewind arena to empty, keeping the newest chunk for reuse
+ * @param arena: Target arena
+ */
+static inline void arena_reset(Arena *arena) {
+    if (!arena->chunks) return;
+
+    ArenaChunk *keep = arena->chunks;
+    ArenaChunk *chunk = keep->next;
+    while (chunk) {
+        ArenaChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    keep->next = NULL;
+    arena->cursor = (unsigned char *)keep + ARENA_HEADER_SIZE;
+    arena->end = arena->cursor + keep->capacity;
+    arena->used = 0;
+}
+
+/**
+ * Free all chunks (arena may be re-initialized afterwards)
+ * @param arena: Target arena
+ */
+static inline void arena_destroy(Arena *arena) {
+    ArenaChunk *chunk = arena->chunks;
+    while (chunk) {
+        ArenaChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    arena->chunks = NULL;
+    arena->cursor = NULL;
+    arena->end = NULL;
+    arena->used = 0;
+}
+
+/**
+ * Get bytes handed out since last reset
+ * @param arena: Target arena
+ * @return: Bytes used (including alignment padding)
+ */
+static inline size_t arena_used(const Arena *arena) {
+    return arena->used;
+}
+
+// ==================== INTERFACE IMPLEMENTATION ====================
+
+static inline void *arena_interface_alloc(void *ctx, size_t size) {
+    return arena_alloc((Arena *)ctx, size);
+}
+
+static inline void arena_interface_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)ptr;
+    (void)size; // Reclaimed on reset
+}
+
+static inline void arena_interface_reset(void *ctx) {
+    arena_reset((Arena *)ctx);
+}
+
+/**
+ * Initialize empty arena
+ * @param arena: Arena to initialize
+ * @param chunk_size: Payload bytes per chunk (0 uses default)
+ */
+static inline void arena_init(Arena *arena, size_t chunk_size) {
+    arena->chunks = NULL;
+    arena->cursor = NULL;
+    arena->end = NULL;
+    arena->chunk_size = chunk_size > 0 ? chunk_size : ARENA_DEFAULT_CHUNK_SIZE;
+    arena->used = 0;
+    arena->allocator.alloc = arena_interface_alloc;
+    arena->allocator.free = arena_interface_free;
+    arena->allocator.reset = arena_interface_reset;
+    arena->allocator.ctx = arena;
+}
+
+/**
+ * Get Allocator interface for arena
+ * @param arena: Initialized arena
+ * @return: Allocator to pass to container init functions
+ */
+static inline const Allocator *arena_allocator(Arena *arena) {
+    return &arena->allocator;
+}
+
+#endif // ARENA_H
@@ -0,0 +1,185 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include "allocator.h"
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * SLAB POOL ALLOCATOR
+ *
+ * Fixed-size object pool. Objects are carved from large blocks so nodes sit
+ * next to each other in memory; freed objects go on an intrusive free list and
+ * are reused first. pool_reset() drops every object in O(blocks).
+ *
+ * The pool embeds its Allocator (ctx points back at the pool), so a Pool must
+ * not be moved or copied after pool_init.
+ *
+ * Time Complexities:
+ * - Alloc / Free: O(1)
+ * - Reset / Destroy: O(number of blocks)
+ *
+ * Space Complexity: O(peak live objects * object_size)
+ */
+
+// Configuration constants
+#define POOL_DEFAULT_OBJECTS_PER_BLOCK 256
+#define POOL_ALIGNMENT 16
+
+// Block header, objects follow (aligned)
+typedef struct PoolBlock {
+    struct PoolBlock *next;
+} PoolBlock;
+
+// Free list link stored inside a freed object
+typedef struct PoolFreeNode {
+    struct PoolFreeNode *next;
+} PoolFreeNode;
+
+// Pool structure
+typedef struct Pool {
+    size_t object_size;       // Rounded up to POOL_ALIGNMENT
+    size_t objects_per_block; // Objects carved from each block
+    PoolBlock *blocks;        // All blocks, newest first
+    PoolFreeNode *free_list;  // Recycled objects
+    unsigned char *cursor;    // Next uncarved object in newest block
+    unsigned char *end;       // End of newest block
+    size_t live;              // Objects currently handed out
+    Allocator allocator;      // Interface bound to this pool
+} Pool;
+
+// Bytes reserved for the block header so objects stay aligned
+#define POOL_HEADER_SIZE \
+    ((sizeof(PoolBlock) + POOL_ALIGNMENT - 1) / POOL_ALIGNMENT * POOL_ALIGNMENT)
+
+// ==================== CORE OPERATIONS ====================
+
+/**
+ * Allocate one object
+ * @param pool: Target pool
+ * @return: Object memory or NULL on failure
+ */
+static inline void *pool_alloc(Pool *pool) {
+    if (pool->free_list) {
+        PoolFreeNode *node = pool->free_list;
+        pool->free_list = node->next;
+        pool->live++;
+        return node;
+    }
+
+    if (pool->cursor == pool->end) {
+        size_t bytes = POOL_HEADER_SIZE + pool->object_size * pool->objects_per_block;
+        PoolBlock *block = (PoolBlock *)malloc(bytes);
+        if (!block) return NULL;
+        block->next = pool->blocks;
+        pool->blocks = block;
+        pool->cursor = (unsigned char *)block + POOL_HEADER_SIZE;
+        pool->end = (unsigned char *)block + bytes;
+    }
+
+    void *object = pool->cursor;
+    pool->cursor += pool->object_size;
+    pool->live++;
+    return object;
+}
+
+/**
+ * Return object to pool
+ * @param pool: Target pool
+ * @param ptr: Object from pool_alloc (NULL is ignored)
+ */
+static inline void pool_free(Pool *pool, void *ptr) {
+    if (!ptr) return;
+    PoolFreeNode *node = (PoolFreeNode *)ptr;
+    node->next = pool->free_list;
+    pool->free_list = node;
+    pool->live--;
+}
+
+/**
+ * Release all objects, freeing every block
+ * @param pool: Target pool
+ */
+static inline void pool_reset(Pool *pool) {
+    PoolBlock *block = pool->blocks;
+    while (block) {
+        PoolBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    pool->blocks = NULL;
+    pool->free_list = NULL;
+    pool->cursor = NULL;
+    pool->end = NULL;
+    pool->live = 0;
+}
+
+/**
+ * Destroy pool (same as reset; pool may be re-initialized afterwards)
+ * @param pool: Target pool
+ */
+static inline void pool_destroy(Pool *pool) {
+    pool_reset(pool);
+}
+
+/**
+ * Get number of objects currently allocated
+ * @param pool: Target pool
+ * @return: Live object count
+ */
+static inline size_t pool_live_count(const Pool *pool) {
+    return pool->live;
+}
+
+// ==================== INTERFACE IMPLEMENTATION ====================
+
+static inline void *pool_interface_alloc(void *ctx, size_t size) {
+    Pool *pool = (Pool *)ctx;
+    if (size > pool->object_size) {
+        fprintf(stderr, "pool_alloc: request of %zu bytes exceeds object size %zu\n",
+                size, pool->object_size);
+        return NULL;
+    }
+    return pool_alloc(pool);
+}
+
+static inline void pool_interface_free(void *ctx, void *ptr, size_t size) {
+    (void)size;
+    pool_free((Pool *)ctx, ptr);
+}
+
+static inline void pool_interface_reset(void *ctx) {
+    pool_reset((Pool *)ctx);
+}
+
+/**
+ * Initialize pool for objects of one size
+ * @param pool: Pool to initialize
+ * @param object_size: Size of each object
+ * @param objects_per_block: Objects per slab (0 uses default)
+ */
+static inline void pool_init(Pool *pool, size_t object_size, size_t objects_per_block) {
+    if (object_size < sizeof(PoolFreeNode)) object_size = sizeof(PoolFreeNode);
+    pool->object_size = (object_size + POOL_ALIGNMENT - 1) / POOL_ALIGNMENT * POOL_ALIGNMENT;
+    pool->objects_per_block = objects_per_block > 0 ? objects_per_block : POOL_DEFAULT_OBJECTS_PER_BLOCK;
+    pool->blocks = NULL;
+    pool->free_list = NULL;
+    pool->cursor = NULL;
+    pool->end = NULL;
+    pool->live = 0;
+    pool->allocator.alloc = pool_interface_alloc;
+    pool->allocator.free = pool_interface_free;
+    pool->allocator.reset = pool_interface_reset;
+    pool->allocator.ctx = pool;
+}
+
+/**
+ * Get Allocator interface for pool
+ * @param pool: Initialized pool
+ * @return: Allocator to pass to container init functions
+ */
+static inline const Allocator *pool_allocator(Pool *pool) {
+    return &pool->allocator;
+}
+
+#endif // POOL_H
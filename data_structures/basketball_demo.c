@@ -91,6 +91,30 @@ void demo_complex_queries(BasketballSystem *system) {
     
     printf("\n4. Veterans (Age 35+):\n");
     find_players_in_age_range(system, 35, 45);
+    
+    // 5. Height range and rank queries on the ordered indices
+    printf("\n5. Big Men (2.08m+):\n");
+    find_players_in_height_range(system, 2.08f, 2.30f);
+    
+    printf("\n6. Players aged 25-30: %zu\n", count_players_in_age_range(system, 25, 30));
+    Player *second = get_player_by_skill_rank(system, 1);
+    if (second) printf("Second most skilled: %s (%.1f)\n", second->name, second->skill_rating);
+    
+    // 7. Aggregates over a player id range from the segment tree
+    SkillStats first_five = get_skill_stats_in_id_range(system, 1, 5);
+    if (first_five.count > 0) {
+        printf("7. Players 1-5: average skill %.1f, best %.1f\n", first_five.sum / (double)first_five.count,
+               first_five.max);
+    }
+    
+    // 8. Name completion from the trie, best-rated first
+    Player *completions[3];
+    size_t completed = get_top_players_by_name_prefix(system, "L", 3, completions);
+    printf("8. Best players named L*:");
+    for (size_t i = 0; i < completed; i++) {
+        printf(" %s (%.1f)", completions[i]->name, completions[i]->skill_rating);
+    }
+    printf("\n");
 }
 
 void demo_trade_system(BasketballSystem *system) {
@@ -143,6 +167,19 @@ void demo_statistics_and_reporting(BasketballSystem *system) {
     // Top players by skill
     printf("\n2. Top 5 Players by Skill:\n");
     print_top_players_by_skill(system, 5);
+    print_top_players_by_age(system, 3, true);
+    print_top_players_by_height(system, 3, true);
+    
+    // Full orderings on fields without a leaderboard heap
+    print_players_sorted(system, PLAYER_SORT_WEIGHT, true, 3);
+    print_players_sorted(system, PLAYER_SORT_NAME, false, 3);
+    
+    // Rating change keeps the leaderboard live without a rebuild
+    Player *wemby = find_player_by_name(system, "Victor Wembanyama");
+    if (wemby && update_player_skill(system, wemby->player_id, 97.0f)) {
+        printf("\nAfter %s's rating jumps to 97.0:\n", wemby->name);
+        print_top_players_by_skill(system, 3);
+    }
     
     // League information
     printf("\n3. League Information:\n");
@@ -152,6 +189,161 @@ void demo_statistics_and_reporting(BasketballSystem *system) {
     }
 }
 
+void demo_snapshot(BasketballSystem *system) {
+    printf("\n=== SNAPSHOT PERSISTENCE DEMO ===\n");
+    const char *path = "basketball_demo.snapshot";
+    
+    if (!basketball_system_save(system, path)) return;
+    
+    BasketballSystem restored;
+    if (basketball_system_load_mmap(&restored, path)) {
+        printf("Loaded snapshot: %zu players, %zu teams, %zu leagues\n",
+               dynarray_size(&restored.players), dynarray_size(&restored.teams),
+               dynarray_size(&restored.leagues));
+        
+        Player *luka = find_player_by_name(&restored, "Luka Doncic");
+        if (luka) print_player_info(luka);
+        print_top_players_by_skill(&restored, 3);
+        find_players_in_age_range(&restored, 20, 25);
+        find_elite_players_by_nationality_and_position(&restored, "USA", "SF", 90.0f);
+        print_league_info(&restored, (League*)dynarray_get(&restored.leagues, 0));
+        
+        // Records live in a private mapping, so updates stay in memory
+        if (luka && update_player_skill(&restored, luka->player_id, 98.0f)) {
+            printf("\nAfter %s's rating jumps to 98.0 in the restored system:\n", luka->name);
+            print_top_players_by_skill(&restored, 2);
+        }
+    }
+    basketball_system_free(&restored);
+    remove(path);
+}
+
+void demo_bulk_load(void) {
+    printf("\n=== BULK LOAD DEMO ===\n");
+    const size_t count = 20000;
+    const char *nations[] = {"USA", "France", "Serbia", "Canada", "Spain"};
+    const char *positions[] = {"PG", "SG", "SF", "PF", "C"};
+    
+    Player *records = calloc(count, sizeof(Player));
+    if (!records) return;
+    for (size_t i = 0; i < count; i++) {
+        snprintf(records[i].name, sizeof(records[i].name), "Prospect %zu", i);
+        strcpy(records[i].nationality, nations[i % 5]);
+        strcpy(records[i].position, positions[(i / 5) % 5]);
+        records[i].age = 19 + (int)(i * 7 % 20);
+        records[i].height = 1.80f + (float)(i * 13 % 45) / 100.0f;
+        records[i].weight = 90.0f + (float)(i % 30);
+        records[i].jersey_number = (int)(i % 100);
+        records[i].skill_rating = 50.0f + (float)(i * 31 % 500) / 10.0f;
+        records[i].team_id = 1 + (int)(i % 30);
+    }
+    
+    BasketballSystem bulk;
+    basketball_system_init(&bulk);
+    clock_t start = clock();
+    add_players_bulk(&bulk, records, count);
+    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("Indexed %zu players in %.3f s (CPU time)\n", count, elapsed);
+    
+    Player *found = find_player_by_name(&bulk, "Prospect 12345");
+    if (found) printf("Lookup by name: %s, ID %d\n", found->name, found->player_id);
+    Player *prospects[3];
+    size_t prefixed = find_players_by_name_prefix(&bulk, "Prospect 1234", prospects, 3);
+    printf("Names starting with \"Prospect 1234\":");
+    for (size_t i = 0; i < prefixed; i++) printf(" %s", prospects[i]->name);
+    printf("\n");
+    print_top_players_by_skill(&bulk, 3);
+    print_top_players_by_age(&bulk, 2, true);
+    start = clock();
+    print_players_sorted(&bulk, PLAYER_SORT_NAME, true, 2);
+    printf("Sorted %zu players by name in %.3f s (CPU time)\n", count,
+           (double)(clock() - start) / CLOCKS_PER_SEC);
+    
+    // Multi-attribute scan over the columnar mirror
+    PlayerFilter filter;
+    player_filter_init(&filter);
+    filter.nationality = "France";
+    filter.position = "C";
+    filter.min_age = 20;
+    filter.max_age = 25;
+    filter.min_skill = 90.0f;
+    start = clock();
+    size_t matches = count_players_matching(&bulk, &filter);
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("French centers aged 20-25 rated 90+: %zu (columnar scan %.3f ms)\n", matches, elapsed * 1000);
+    
+    SkillStats slice = get_skill_stats_in_id_range(&bulk, 5001, 15000);
+    printf("IDs 5001-15000: %zu players, average skill %.2f, best %.1f\n", slice.count,
+           slice.count ? slice.sum / (double)slice.count : 0.0, slice.max);
+    
+    // Deadline day: every team sends a player to the next team, applied as one batch
+    for (int id = 1; id <= 30; id++) {
+        Player *player = find_player_by_id(&bulk, id);
+        if (player) request_trade(&bulk, player->team_id, player->team_id % 30 + 1, id);
+    }
+    process_all_trades(&bulk);
+    printf("Team 1 roster: %zu players, team 2 roster: %zu players\n",
+           dynarray_size(get_team_roster(&bulk, 1)), dynarray_size(get_team_roster(&bulk, 2)));
+    
+    remove_player(&bulk, 12346);
+    printf("After release: Prospect 12345 %s, %zu players remain\n",
+           find_player_by_name(&bulk, "Prospect 12345") ? "still listed" : "gone",
+           dynarray_size(&bulk.players));
+    
+    basketball_system_free(&bulk);
+    free(records);
+}
+
+void demo_ingest(void) {
+    printf("\n=== STREAMING INGEST DEMO ===\n");
+    const char *csv_path = "basketball_demo_feed.csv";
+    const char *json_path = "basketball_demo_feed.jsonl";
+    const size_t count = 50000;
+    const char *nations[] = {"USA", "France", "Serbia", "Canada", "Spain"};
+    const char *positions[] = {"PG", "SG", "SF", "PF", "C"};
+    
+    FILE *feed = fopen(csv_path, "w");
+    if (!feed) return;
+    fprintf(feed, "name,nationality,position,age,height,weight,jersey_number,skill_rating,team_id\n");
+    for (size_t i = 0; i < count; i++) {
+        fprintf(feed, "Rookie %zu,%s,%s,%d,%.2f,%.1f,%zu,%.1f,%zu\n", i, nations[i % 5], positions[(i / 5) % 5],
+                19 + (int)(i * 7 % 20), 1.80 + (double)(i * 13 % 45) / 100.0, 90.0 + (double)(i % 30), i % 100,
+                50.0 + (double)(i * 31 % 500) / 10.0, 1 + i % 30);
+        if (i == count / 2) fprintf(feed, "Broken Row,USA,PG,not-a-number,2.00,100,1,80,1\n");
+    }
+    fclose(feed);
+    
+    BasketballSystem ingested;
+    basketball_system_init(&ingested);
+    IngestOptions options;
+    ingest_options_init(&options);
+    options.chunk_bytes = 256 * 1024;
+    IngestReport report;
+    if (basketball_system_ingest(&ingested, csv_path, &options, &report)) print_ingest_report(&report);
+    Player *rookie = find_player_by_name(&ingested, "Rookie 31337");
+    if (rookie) printf("Lookup by name: %s, ID %d, team %d\n", rookie->name, rookie->player_id, rookie->team_id);
+    
+    // JSON Lines feed appended to the same system: ids continue after the CSV players
+    feed = fopen(json_path, "w");
+    if (feed) {
+        fprintf(feed, "{\"name\": \"Nikola Jokic\", \"nationality\": \"Serbia\", \"position\": \"C\", \"age\": 29, "
+                      "\"height\": 2.11, \"weight\": 129, \"jersey_number\": 15, \"skill_rating\": 97.5, \"team_id\": 2}\n");
+        fprintf(feed, "{\"name\": \"Victor Wembanyama\", \"nationality\": \"France\", \"position\": \"C\", \"age\": 20, "
+                      "\"height\": 2.24, \"weight\": 95, \"jersey_number\": 1, \"skill_rating\": 91.0, \"team_id\": 3}\n");
+        fclose(feed);
+        options.format = INGEST_FORMAT_JSON_LINES;
+        if (basketball_system_ingest(&ingested, json_path, &options, &report)) {
+            printf("JSON Lines feed: %zu players added, %zu rejected\n", report.records, report.rejected);
+        }
+        Player *jokic = find_player_by_name(&ingested, "Nikola Jokic");
+        if (jokic) print_player_info(jokic);
+        remove(json_path);
+    }
+    
+    basketball_system_free(&ingested);
+    remove(csv_path);
+}
+
 int main() {
     printf("=== BASKETBALL LEAGUE MANAGEMENT SYSTEM ===\n");
     printf("Demonstrating comprehensive data structure integration\n");
@@ -168,6 +360,9 @@ int main() {
     demo_complex_queries(&system);
     demo_trade_system(&system);
     demo_statistics_and_reporting(&system);
+    demo_snapshot(&system);
+    demo_bulk_load();
+    demo_ingest();
     
     // Performance demonstration
     printf("\n=== PERFORMANCE ANALYSIS ===\n");
@@ -187,6 +382,11 @@ int main() {
     printf("• Stacks: Transaction history with undo\n");
     printf("• Queues: FIFO trade request processing\n");
     
+#ifdef DS_STATS
+    printf("\nContainer statistics (DS_STATS):\n");
+    ds_stats_write_json(stdout);
+#endif
+    
     // Clean up
     basketball_system_free(&system);
     
@@ -1,4 +1,13 @@
 #include "basketball_system.h"
+#include "parallel/thread_pool.h"
+#include "dynarray/dynarray_sort.h"
+#include <stddef.h>
+#include <float.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sched.h>
 
 // Comparison functions for heaps
 static int player_age_compare_min(const void *a, const void *b) {
@@ -34,33 +43,226 @@ static int player_skill_compare_max(const void *a, const void *b) {
 
 // Hash function helpers are already defined in hashtable.h
 
+// Columnar player store: column arrays grow together, dictionaries map strings to codes
+
+static void player_columns_init(PlayerColumns *columns) {
+    memset(columns, 0, sizeof(*columns));
+}
+
+static void player_columns_free(PlayerColumns *columns) {
+    free(columns->age);
+    free(columns->height);
+    free(columns->weight);
+    free(columns->skill_rating);
+    free(columns->nationality);
+    free(columns->position);
+    free(columns->row_of_id);
+    free(columns->group_slot);
+    memset(columns, 0, sizeof(*columns));
+}
+
+static void *player_columns_grow(void *column, size_t count, size_t element_size) {
+    void *grown = realloc(column, count * element_size);
+    if (!grown) {
+        fprintf(stderr, "player_columns_reserve: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return grown;
+}
+
+// Make room for rows players and ids up to max_id
+static void player_columns_reserve(PlayerColumns *columns, size_t rows, int max_id) {
+    if (rows > columns->capacity) {
+        size_t capacity = columns->capacity ? columns->capacity : 64;
+        while (capacity < rows) capacity *= 2;
+        columns->age = player_columns_grow(columns->age, capacity, sizeof(int32_t));
+        columns->height = player_columns_grow(columns->height, capacity, sizeof(float));
+        columns->weight = player_columns_grow(columns->weight, capacity, sizeof(float));
+        columns->skill_rating = player_columns_grow(columns->skill_rating, capacity, sizeof(float));
+        columns->nationality = player_columns_grow(columns->nationality, capacity, sizeof(uint16_t));
+        columns->position = player_columns_grow(columns->position, capacity, sizeof(uint16_t));
+        columns->capacity = capacity;
+    }
+    if ((size_t)max_id >= columns->id_capacity) {
+        size_t capacity = columns->id_capacity ? columns->id_capacity : 64;
+        while (capacity <= (size_t)max_id) capacity *= 2;
+        columns->row_of_id = player_columns_grow(columns->row_of_id, capacity, sizeof(uint32_t));
+        columns->group_slot = player_columns_grow(columns->group_slot, capacity, sizeof(*columns->group_slot));
+        columns->id_capacity = capacity;
+    }
+}
+
+// Id of an attribute string, interning it on first use (columns store ids as uint16)
+static uint16_t intern_attribute(StringInterner *interner, const char *value) {
+    uint32_t id = string_interner_intern(interner, value);
+    if (id > UINT16_MAX) {
+        fprintf(stderr, "intern_attribute: too many distinct values\n");
+        exit(EXIT_FAILURE);
+    }
+    return (uint16_t)id;
+}
+
+// Write player's attributes into an existing row
+static void player_columns_set(PlayerColumns *columns, size_t row, const Player *player) {
+    columns->age[row] = player->age;
+    columns->height[row] = player->height;
+    columns->weight[row] = player->weight;
+    columns->skill_rating[row] = player->skill_rating;
+    columns->row_of_id[player->player_id] = (uint32_t)row;
+}
+
+// Append player as the next row (players.data[row] must be this player)
+static void player_columns_append(BasketballSystem *system, const Player *player) {
+    PlayerColumns *columns = &system->columns;
+    size_t row = columns->rows;
+    player_columns_reserve(columns, row + 1, player->player_id);
+    columns->nationality[row] = intern_attribute(&system->nationalities, player->nationality);
+    columns->position[row] = intern_attribute(&system->positions, player->position);
+    player_columns_set(columns, row, player);
+    columns->rows++;
+}
+
+// Copy row from into row to and point its player at the new row
+static void player_columns_move_row(PlayerColumns *columns, size_t from, size_t to, const Player *player) {
+    columns->age[to] = columns->age[from];
+    columns->height[to] = columns->height[from];
+    columns->weight[to] = columns->weight[from];
+    columns->skill_rating[to] = columns->skill_rating[from];
+    columns->nationality[to] = columns->nationality[from];
+    columns->position[to] = columns->position[from];
+    columns->row_of_id[player->player_id] = (uint32_t)to;
+}
+
+// Group list for an interned id; ids are dense, so a new id is the next slot
+static DynArray *group_for_id(BasketballSystem *system, DynArray *groups, uint32_t id,
+                              size_t initial_capacity) {
+    while (groups->size <= id) {
+        DynArray *list = arena_alloc(&system->arena, sizeof(DynArray));
+        dynarray_init(list, initial_capacity);
+        dynarray_push(groups, list);
+    }
+    return (DynArray*)groups->data[id];
+}
+
+// Team group list, created on first use
+static DynArray *team_group(BasketballSystem *system, int team_id) {
+    DynArray *list = (DynArray*)hashtable_get(&system->players_by_team, &team_id);
+    if (!list) {
+        list = arena_alloc(&system->arena, sizeof(DynArray));
+        dynarray_init(list, 15); // Typical roster size
+        hashtable_put(&system->players_by_team, &team_id, list);
+    }
+    return list;
+}
+
+// Append player to a group list, remembering its index there
+static void group_push(BasketballSystem *system, DynArray *list, int group, Player *player) {
+    system->columns.group_slot[player->player_id][group] = (uint32_t)list->size;
+    dynarray_push(list, player);
+}
+
+// Swap-remove player from a group list in O(1); the player moved into its slot is re-indexed
+static void group_remove(BasketballSystem *system, DynArray *list, int group, Player *player) {
+    uint32_t (*group_slot)[PLAYER_GROUP_COUNT] = system->columns.group_slot;
+    uint32_t slot = group_slot[player->player_id][group];
+    if (!list || slot >= list->size || list->data[slot] != player) return;
+    dynarray_swap_remove(list, slot);
+    if (slot < list->size) group_slot[((Player*)list->data[slot])->player_id][group] = slot;
+    group_slot[player->player_id][group] = PLAYER_SLOT_NONE;
+}
+
+// Add player at row to its nationality and position groups (ids read from the columns)
+static void add_to_attribute_groups(BasketballSystem *system, size_t row, Player *player) {
+    group_push(system, group_for_id(system, &system->players_by_nationality, system->columns.nationality[row], 10),
+               PLAYER_GROUP_NATIONALITY, player);
+    group_push(system, group_for_id(system, &system->players_by_position, system->columns.position[row], 20),
+               PLAYER_GROUP_POSITION, player);
+}
+
+// Skill aggregate leaf of one player
+static SkillStats skill_stats_of(const Player *player) {
+    SkillStats stats = {player->skill_rating, 1, player->skill_rating};
+    return stats;
+}
+
+// Write players' leaves into the id-indexed skill tree and refresh the aggregates
+static void skill_index_add(BasketballSystem *system, Player *const *players, size_t count, int max_id) {
+    SkillStatsTree *tree = &system->skill_by_id;
+    SkillStatsTree_resize(tree, (size_t)max_id + 1);
+    if (count < tree->size / 16) {
+        for (size_t i = 0; i < count; i++) {
+            SkillStatsTree_set(tree, (size_t)players[i]->player_id, skill_stats_of(players[i]));
+        }
+        return;
+    }
+    // Large batch: one O(n) rebuild instead of a path update per player
+    SkillStats *leaves = SkillStatsTree_leaves(tree);
+    for (size_t i = 0; i < count; i++) leaves[players[i]->player_id] = skill_stats_of(players[i]);
+    SkillStatsTree_rebuild(tree);
+}
+
+// Free every group list of an id-indexed group array
+static void free_group_lists(DynArray *groups) {
+    for (size_t i = 0; i < groups->size; i++) {
+        dynarray_free((DynArray*)groups->data[i]);
+    }
+    dynarray_free(groups);
+}
+
 void basketball_system_init(BasketballSystem *system) {
+    // Memory sources: players/teams/leagues share one lifetime, index entries are pooled
+    arena_init(&system->arena, 0);
+    pool_init(&system->entry_pool, sizeof(HashEntry), 0);
+    pool_init(&system->order_pool, sizeof(AVLOrderNode), 0);
+    const Allocator *entries = pool_allocator(&system->entry_pool);
+    
     // Initialize primary storage
     dynarray_init(&system->players, 1000);
     dynarray_init(&system->teams, 100);
     dynarray_init(&system->leagues, 10);
     
     // Initialize hash tables using the predefined convenience functions
-    hashtable_init_string(&system->player_by_name);
-    hashtable_init_int(&system->player_by_id);
-    hashtable_init_string(&system->team_by_name);
-    hashtable_init_int(&system->team_by_id);
+    flat_hashtable_init_string(&system->player_by_name);
+    flat_hashtable_init_int(&system->player_by_id);
+    bloom_filter_init(&system->name_filter, 1024, BASKETBALL_NAME_FILTER_FP_RATE);
+    trie_init(&system->player_names);
+    hashtable_init_with_allocator(&system->team_by_name, HASHTABLE_DEFAULT_SIZE, &STRING_HASH_FUNC, entries);
+    hashtable_init_with_allocator(&system->team_by_id, HASHTABLE_DEFAULT_SIZE, &INT_HASH_FUNC, entries);
     
     // Initialize specialized indices
-    hashtable_init_string(&system->players_by_nationality);
-    hashtable_init_string(&system->players_by_position);
-    hashtable_init_int(&system->players_by_team);
+    string_interner_init(&system->nationalities);
+    string_interner_init(&system->positions);
+    dynarray_init(&system->players_by_nationality, 16);
+    dynarray_init(&system->players_by_position, 8);
+    hashtable_init_with_allocator(&system->players_by_team, HASHTABLE_DEFAULT_SIZE, &INT_HASH_FUNC, entries);
     
     // Initialize heaps with comparison functions
-    min_heap_init(&system->youngest_players, 100);
-    max_heap_init(&system->oldest_players, 100);
-    min_heap_init(&system->shortest_players, 100);
-    max_heap_init(&system->tallest_players, 100);
-    max_heap_init(&system->top_skilled_players, 100);
+    indexed_heap_init(&system->youngest_players, player_age_compare_min, 100);
+    indexed_heap_init(&system->oldest_players, player_age_compare_max, 100);
+    indexed_heap_init(&system->shortest_players, player_height_compare_min, 100);
+    indexed_heap_init(&system->tallest_players, player_height_compare_max, 100);
+    indexed_heap_init(&system->top_skilled_players, player_skill_compare_max, 100);
+    
+    // Initialize ordered indices for range queries
+    const Allocator *order_nodes = pool_allocator(&system->order_pool);
+    avl_order_init_with_allocator(&system->players_by_age, avl_compare_int, order_nodes);
+    avl_order_init_with_allocator(&system->players_by_height, avl_compare_float, order_nodes);
+    avl_order_init_with_allocator(&system->players_by_skill, avl_compare_float, order_nodes);
+    
+    // Initialize columnar mirror and id-range aggregates
+    player_columns_init(&system->columns);
+    SkillStatsTree_init(&system->skill_by_id, 0);
     
     // Initialize utility structures
     stack_init(&system->recent_transactions);
-    queue_init(&system->trade_requests);
+    mpmc_queue_init(&system->trade_requests, TRADE_QUEUE_CAPACITY);
+    
+    // No worker threads until parallel work needs them
+    system->workers = NULL;
+    
+    // Nothing mapped until a snapshot is loaded
+    system->snapshot = NULL;
+    system->snapshot_size = 0;
     
     // Initialize counters
     system->next_player_id = 1;
@@ -68,55 +270,131 @@ void basketball_system_init(BasketballSystem *system) {
     system->next_league_id = 1;
 }
 
+// Shared worker pool with one thread per CPU, started on first use; NULL on a single CPU
+static ThreadPool *system_workers(BasketballSystem *system) {
+    if (system->workers) return system->workers;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus <= 1) return NULL;
+    system->workers = malloc(sizeof(ThreadPool));
+    if (!system->workers) {
+        fprintf(stderr, "system_workers: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    thread_pool_init(system->workers, (size_t)cpus);
+    return system->workers;
+}
+
+// Free the element buffer of every DynArray stored as a value in an index
+static void free_index_arrays(HashTable *index) {
+    HashTableIterator it;
+    HashEntry *entry;
+    hashtable_iter_init(&it, index);
+    while ((entry = hashtable_iter_next(&it))) {
+        dynarray_free((DynArray*)entry->value);
+    }
+}
+
 void basketball_system_free(BasketballSystem *system) {
-    // Free all players
-    for (size_t i = 0; i < dynarray_size(&system->players); i++) {
-        Player *player = (Player*)dynarray_get(&system->players, i);
-        free(player);
+    // Idle between calls, so the workers can be joined first
+    if (system->workers) {
+        thread_pool_free(system->workers);
+        free(system->workers);
+        system->workers = NULL;
     }
+    
+    // Players, teams, leagues and index array headers live in the arena;
+    // only their element buffers need freeing before the arena goes
     dynarray_free(&system->players);
     
-    // Free all teams
     for (size_t i = 0; i < dynarray_size(&system->teams); i++) {
         Team *team = (Team*)dynarray_get(&system->teams, i);
         dynarray_free(&team->roster);
-        free(team);
     }
     dynarray_free(&system->teams);
     
-    // Free all leagues
     for (size_t i = 0; i < dynarray_size(&system->leagues); i++) {
         League *league = (League*)dynarray_get(&system->leagues, i);
         dynarray_free(&league->teams);
-        free(league);
     }
     dynarray_free(&system->leagues);
     
+    free_group_lists(&system->players_by_nationality);
+    free_group_lists(&system->players_by_position);
+    free_index_arrays(&system->players_by_team);
+    
     // Free hash tables
-    hashtable_free(&system->player_by_name);
-    hashtable_free(&system->player_by_id);
+    flat_hashtable_free(&system->player_by_name);
+    flat_hashtable_free(&system->player_by_id);
+    bloom_filter_free(&system->name_filter);
+    trie_free(&system->player_names);
     hashtable_free(&system->team_by_name);
     hashtable_free(&system->team_by_id);
-    hashtable_free(&system->players_by_nationality);
-    hashtable_free(&system->players_by_position);
+    string_interner_free(&system->nationalities);
+    string_interner_free(&system->positions);
     hashtable_free(&system->players_by_team);
     
     // Free heaps
-    min_heap_free(&system->youngest_players);
-    max_heap_free(&system->oldest_players);
-    min_heap_free(&system->shortest_players);
-    max_heap_free(&system->tallest_players);
-    max_heap_free(&system->top_skilled_players);
+    indexed_heap_free(&system->youngest_players);
+    indexed_heap_free(&system->oldest_players);
+    indexed_heap_free(&system->shortest_players);
+    indexed_heap_free(&system->tallest_players);
+    indexed_heap_free(&system->top_skilled_players);
+    
+    // Ordered index nodes are released with the pool below
+    avl_order_free(&system->players_by_age);
+    avl_order_free(&system->players_by_height);
+    avl_order_free(&system->players_by_skill);
+    player_columns_free(&system->columns);
+    SkillStatsTree_free(&system->skill_by_id);
     
     // Free utility structures
+    TradeTransaction *pending;
+    while ((pending = (TradeTransaction*)stack_pop(&system->recent_transactions))) {
+        free(pending);
+    }
     stack_free(&system->recent_transactions);
-    queue_free(&system->trade_requests);
+    while ((pending = (TradeTransaction*)mpmc_queue_try_dequeue(&system->trade_requests))) {
+        free(pending);
+    }
+    mpmc_queue_free(&system->trade_requests);
+    
+    // Release all pooled entries and arena objects at once
+    pool_destroy(&system->entry_pool);
+    pool_destroy(&system->order_pool);
+    arena_destroy(&system->arena);
+    
+    // Loaded records live in the mapping, so it goes last
+    if (system->snapshot) {
+        munmap(system->snapshot, system->snapshot_size);
+        system->snapshot = NULL;
+        system->snapshot_size = 0;
+    }
 }
 
-Player* create_player(int id, const char *name, const char *nationality, const char *position,
-                     int age, float height, float weight, int jersey_number, 
-                     float skill_rating, int team_id) {
-    Player *player = malloc(sizeof(Player));
+// Add a name to the filter in front of player_by_name (hash shared with the table)
+static void name_filter_add(BasketballSystem *system, const Player *player) {
+    bloom_filter_add_hash(&system->name_filter, flat_hashtable_hash(&system->player_by_name, player->name));
+}
+
+// Rebuild the name filter from the current players; this also forgets removed ones
+static void name_filter_rebuild(BasketballSystem *system, size_t expected) {
+    bloom_filter_free(&system->name_filter);
+    bloom_filter_init(&system->name_filter, expected, BASKETBALL_NAME_FILTER_FP_RATE);
+    for (size_t i = 0; i < system->players.size; i++) name_filter_add(system, (Player*)system->players.data[i]);
+}
+
+// Make room in the name filter for incoming more names
+static void name_filter_reserve(BasketballSystem *system, size_t incoming) {
+    const BloomFilter *filter = &system->name_filter;
+    if (filter->count + incoming <= filter->capacity) return;
+    name_filter_rebuild(system, 2 * (system->players.size + incoming));
+}
+
+Player* create_player_with(const Allocator *allocator, int id, const char *name,
+                          const char *nationality, const char *position,
+                          int age, float height, float weight, int jersey_number,
+                          float skill_rating, int team_id) {
+    Player *player = allocator_alloc(allocator, sizeof(Player));
     if (!player) return NULL;
     
     player->player_id = id;
@@ -136,76 +414,310 @@ Player* create_player(int id, const char *name, const char *nationality, const c
     return player;
 }
 
+Player* create_player(int id, const char *name, const char *nationality, const char *position,
+                     int age, float height, float weight, int jersey_number, 
+                     float skill_rating, int team_id) {
+    return create_player_with(&HEAP_ALLOCATOR, id, name, nationality, position, age, height,
+                              weight, jersey_number, skill_rating, team_id);
+}
+
 void add_player(BasketballSystem *system, const char *name, const char *nationality, 
                 const char *position, int age, float height, float weight, 
                 int jersey_number, float skill_rating, int team_id) {
     
-    Player *player = create_player(system->next_player_id++, name, nationality, position,
-                                  age, height, weight, jersey_number, skill_rating, team_id);
+    Player *player = create_player_with(arena_allocator(&system->arena), system->next_player_id++,
+                                       name, nationality, position, age, height, weight,
+                                       jersey_number, skill_rating, team_id);
     if (!player) {
         printf("Error: Failed to create player\n");
         return;
     }
     
-    // Add to primary storage
+    // Add to primary storage and its columnar mirror
+    name_filter_reserve(system, 1);
     dynarray_push(&system->players, player);
+    player_columns_append(system, player);
     
     // Add to hash table indices for O(1) lookups
-    hashtable_put(&system->player_by_name, player->name, player);
-    hashtable_put(&system->player_by_id, &player->player_id, player);
+    flat_hashtable_put(&system->player_by_name, player->name, player);
+    name_filter_add(system, player);
+    flat_hashtable_put(&system->player_by_id, &player->player_id, player);
+    trie_insert(&system->player_names, player->name, player->skill_rating, player);
     
     // Update specialized indices
     
-    // 1. Players by nationality
-    DynArray *nat_players = (DynArray*)hashtable_get(&system->players_by_nationality,
-                                                     player->nationality);
-    if (!nat_players) {
-        nat_players = malloc(sizeof(DynArray));
-        dynarray_init(nat_players, 10);
-        hashtable_put(&system->players_by_nationality, player->nationality, nat_players);
+    // 1-2. Players by nationality and position (array slots by interned id)
+    add_to_attribute_groups(system, system->players.size - 1, player);
+    
+    // 3. Players by team
+    group_push(system, team_group(system, player->team_id), PLAYER_GROUP_TEAM, player);
+    
+    // Update heaps for performance queries
+    indexed_heap_push(&system->youngest_players, (size_t)player->player_id, player);
+    indexed_heap_push(&system->oldest_players, (size_t)player->player_id, player);
+    indexed_heap_push(&system->shortest_players, (size_t)player->player_id, player);
+    indexed_heap_push(&system->tallest_players, (size_t)player->player_id, player);
+    indexed_heap_push(&system->top_skilled_players, (size_t)player->player_id, player);
+    
+    // Ordered indices for range and rank queries
+    avl_order_insert(&system->players_by_age, &player->age, player);
+    avl_order_insert(&system->players_by_height, &player->height, player);
+    avl_order_insert(&system->players_by_skill, &player->skill_rating, player);
+    skill_index_add(system, &player, 1, player->player_id);
+    
+    printf("Added player %s (ID: %d) to system\n", player->name, player->player_id);
+}
+
+// Independent index builds run by add_players_bulk, one task each
+enum {
+    BULK_NAME_INDEX,
+    BULK_ID_INDEX,
+    BULK_NAME_TRIE,
+    BULK_GROUPS,      // The group indexes share the entry pool and arena
+    BULK_HEAP_FIRST,  // One task per heap
+    BULK_ORDERS = BULK_HEAP_FIRST + 5, // The ordered indices share the node pool
+    BULK_TASK_COUNT
+};
+
+typedef struct {
+    BasketballSystem *system;
+    Player *players; // New contiguous records
+    size_t count;
+    size_t first_row; // Row of the first new record
+    size_t *handles;  // player_id of each new record
+    void **items;    // Address of each new record
+} BulkLoad;
+
+static void bulk_build_orders(AVLOrderTree *tree, const BulkLoad *load, size_t key_offset) {
+    const void **keys = malloc(load->count * sizeof(void*));
+    if (!keys) {
+        fprintf(stderr, "add_players_bulk: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < load->count; i++) {
+        keys[i] = (const char*)&load->players[i] + key_offset;
+    }
+    avl_order_insert_many(tree, keys, load->items, load->count);
+    free(keys);
+}
+
+// ThreadPoolRangeFn over task ids; tasks touch disjoint structures
+static void bulk_build_indexes(void *ctx, size_t begin, size_t end, size_t worker) {
+    (void)worker;
+    BulkLoad *load = (BulkLoad*)ctx;
+    BasketballSystem *system = load->system;
+    IndexedHeap *heaps[] = {&system->youngest_players, &system->oldest_players, &system->shortest_players,
+                            &system->tallest_players, &system->top_skilled_players};
+    
+    for (size_t task = begin; task < end; task++) {
+        if (task == BULK_NAME_INDEX) {
+            flat_hashtable_reserve(&system->player_by_name, system->player_by_name.size + load->count);
+            for (size_t i = 0; i < load->count; i++) {
+                flat_hashtable_put(&system->player_by_name, load->players[i].name, &load->players[i]);
+                name_filter_add(system, &load->players[i]);
+            }
+        } else if (task == BULK_ID_INDEX) {
+            flat_hashtable_reserve(&system->player_by_id, system->player_by_id.size + load->count);
+            for (size_t i = 0; i < load->count; i++) {
+                flat_hashtable_put(&system->player_by_id, &load->players[i].player_id, &load->players[i]);
+            }
+        } else if (task == BULK_NAME_TRIE) {
+            for (size_t i = 0; i < load->count; i++) {
+                Player *player = &load->players[i];
+                trie_insert(&system->player_names, player->name, player->skill_rating, player);
+            }
+        } else if (task == BULK_GROUPS) {
+            for (size_t i = 0; i < load->count; i++) {
+                Player *player = &load->players[i];
+                add_to_attribute_groups(system, load->first_row + i, player);
+                group_push(system, team_group(system, player->team_id), PLAYER_GROUP_TEAM, player);
+            }
+        } else if (task < BULK_ORDERS) {
+            // Floyd heapify once instead of one sift per player
+            indexed_heap_push_many(heaps[task - BULK_HEAP_FIRST], load->handles, load->items, load->count);
+        } else {
+            bulk_build_orders(&system->players_by_age, load, offsetof(Player, age));
+            bulk_build_orders(&system->players_by_height, load, offsetof(Player, height));
+            bulk_build_orders(&system->players_by_skill, load, offsetof(Player, skill_rating));
+        }
+    }
+}
+
+// Insert records with ids from next_player_id on, building every index once (internal helper)
+static bool bulk_insert_players(BasketballSystem *system, const Player *records, size_t count) {
+    
+    // One contiguous block instead of an allocation per player
+    Player *players = arena_alloc(&system->arena, count * sizeof(Player));
+    size_t *handles = malloc(count * sizeof(size_t));
+    void **items = malloc(count * sizeof(void*));
+    if (!players || !handles || !items) {
+        free(handles);
+        free(items);
+        printf("Error: Failed to allocate %zu players\n", count);
+        return false;
     }
-    dynarray_push(nat_players, player);
     
-    // 2. Players by position
-    DynArray *pos_players = (DynArray*)hashtable_get(&system->players_by_position,
-                                                     player->position);
-    if (!pos_players) {
-        pos_players = malloc(sizeof(DynArray));
-        dynarray_init(pos_players, 20);
-        hashtable_put(&system->players_by_position, player->position, pos_players);
+    name_filter_reserve(system, count);
+    dynarray_reserve(&system->players, system->players.size + count);
+    for (size_t i = 0; i < count; i++) {
+        Player *player = &players[i];
+        *player = records[i];
+        player->player_id = system->next_player_id++;
+        player->name[sizeof(player->name) - 1] = '\0';
+        player->nationality[sizeof(player->nationality) - 1] = '\0';
+        player->position[sizeof(player->position) - 1] = '\0';
+        handles[i] = (size_t)player->player_id;
+        items[i] = player;
+        dynarray_push(&system->players, player);
+    }
+    player_columns_reserve(&system->columns, system->players.size, system->next_player_id - 1);
+    for (size_t i = 0; i < count; i++) {
+        player_columns_append(system, &players[i]);
     }
-    dynarray_push(pos_players, player);
     
-    // 3. Players by team
-    DynArray *team_players = (DynArray*)hashtable_get(&system->players_by_team,
-                                                      &player->team_id);
-    if (!team_players) {
-        team_players = malloc(sizeof(DynArray));
-        dynarray_init(team_players, 15); // Typical roster size
-        hashtable_put(&system->players_by_team, &player->team_id, team_players);
+    skill_index_add(system, (Player *const *)items, count, system->next_player_id - 1);
+    
+    BulkLoad load = {system, players, count, system->players.size - count, handles, items};
+    ThreadPool *workers = count >= BASKETBALL_BULK_PARALLEL_MIN ? system_workers(system) : NULL;
+    if (workers) {
+        thread_pool_parallel_for(workers, 0, BULK_TASK_COUNT, 1, bulk_build_indexes, &load);
+    } else {
+        bulk_build_indexes(&load, 0, BULK_TASK_COUNT, 0);
     }
-    dynarray_push(team_players, player);
     
-    // Update heaps for performance queries
-    min_heap_push(&system->youngest_players, player);
-    max_heap_push(&system->oldest_players, player);
-    min_heap_push(&system->shortest_players, player);
-    max_heap_push(&system->tallest_players, player);
-    max_heap_push(&system->top_skilled_players, player);
+    free(handles);
+    free(items);
+    return true;
+}
+
+bool add_players_bulk(BasketballSystem *system, const Player *records, size_t count) {
+    if (count == 0) return true;
     
-    printf("Added player %s (ID: %d) to system\n", player->name, player->player_id);
+    int first_id = system->next_player_id;
+    if (!bulk_insert_players(system, records, count)) return false;
+    printf("Added %zu players (IDs %d-%d) to system\n", count, first_id, system->next_player_id - 1);
+    return true;
 }
 
 Player* find_player_by_name(BasketballSystem *system, const char *name) {
-    return (Player*)hashtable_get(&system->player_by_name, name);
+    // Unknown names mostly stop at one filter cache line instead of a probe sequence
+    uint64_t hash = flat_hashtable_hash(&system->player_by_name, name);
+    flat_hashtable_prefetch(&system->player_by_name, hash); // Overlaps the table miss with the filter's on hits
+    if (!bloom_filter_may_contain_hash(&system->name_filter, hash)) return NULL;
+    return (Player*)flat_hashtable_get_with_hash(&system->player_by_name, name, hash);
 }
 
 Player* find_player_by_id(BasketballSystem *system, int id) {
-    return (Player*)hashtable_get(&system->player_by_id, &id);
+    return (Player*)flat_hashtable_get(&system->player_by_id, &id);
 }
 
-Team* create_team(int id, const char *name, const char *city, int league_id) {
-    Team *team = malloc(sizeof(Team));
+typedef struct {
+    Player **players;
+    size_t count;
+    size_t max_count;
+} PrefixMatches;
+
+static bool collect_prefix_match(const char *key, void *value, void *ctx) {
+    (void)key;
+    PrefixMatches *matches = (PrefixMatches*)ctx;
+    matches->players[matches->count++] = (Player*)value;
+    return matches->count < matches->max_count;
+}
+
+size_t find_players_by_name_prefix(BasketballSystem *system, const char *prefix, Player **players,
+                                   size_t max_count) {
+    // Alphabetical order; only the trie path below prefix is walked
+    if (max_count == 0) return 0;
+    PrefixMatches matches = {players, 0, max_count};
+    trie_prefix_iterate(&system->player_names, prefix, collect_prefix_match, &matches);
+    return matches.count;
+}
+
+size_t get_top_players_by_name_prefix(BasketballSystem *system, const char *prefix, size_t k,
+                                      Player **players) {
+    return trie_top_k(&system->player_names, prefix, k, (void**)players);
+}
+
+void remove_player(BasketballSystem *system, int player_id) {
+    Player *player = find_player_by_id(system, player_id);
+    if (!player) {
+        printf("Error: Player %d not found\n", player_id);
+        return;
+    }
+    PlayerColumns *columns = &system->columns;
+    size_t row = columns->row_of_id[player_id];
+    
+    // Lookups; a namesake may own the name entries
+    flat_hashtable_remove(&system->player_by_id, &player->player_id);
+    if (flat_hashtable_get(&system->player_by_name, player->name) == player) {
+        flat_hashtable_remove(&system->player_by_name, player->name);
+    }
+    if (trie_get(&system->player_names, player->name) == player) {
+        trie_remove(&system->player_names, player->name);
+    }
+    
+    // Group lists swap-remove through the stored slots
+    group_remove(system, (DynArray*)system->players_by_nationality.data[columns->nationality[row]],
+                 PLAYER_GROUP_NATIONALITY, player);
+    group_remove(system, (DynArray*)system->players_by_position.data[columns->position[row]],
+                 PLAYER_GROUP_POSITION, player);
+    group_remove(system, get_team_roster(system, player->team_id), PLAYER_GROUP_TEAM, player);
+    
+    indexed_heap_remove(&system->youngest_players, (size_t)player_id);
+    indexed_heap_remove(&system->oldest_players, (size_t)player_id);
+    indexed_heap_remove(&system->shortest_players, (size_t)player_id);
+    indexed_heap_remove(&system->tallest_players, (size_t)player_id);
+    indexed_heap_remove(&system->top_skilled_players, (size_t)player_id);
+    avl_order_remove(&system->players_by_age, &player->age, player);
+    avl_order_remove(&system->players_by_height, &player->height, player);
+    avl_order_remove(&system->players_by_skill, &player->skill_rating, player);
+    SkillStatsTree_set(&system->skill_by_id, (size_t)player_id, SKILL_STATS_IDENTITY);
+    
+    // The last row fills the hole in primary storage and the columns alike
+    size_t last = columns->rows - 1;
+    dynarray_swap_remove(&system->players, row);
+    if (row < last) player_columns_move_row(columns, last, row, (Player*)system->players.data[row]);
+    columns->rows--;
+    
+    // The record itself stays in the arena (or snapshot) until the system is freed
+    printf("Removed player %s (ID: %d) from system\n", player->name, player_id);
+}
+
+bool update_player_skill(BasketballSystem *system, int player_id, float skill_rating) {
+    Player *player = find_player_by_id(system, player_id);
+    if (!player) return false;
+    
+    // Ordered index keys are borrowed from the player: unlink before changing
+    avl_order_remove(&system->players_by_skill, &player->skill_rating, player);
+    player->skill_rating = skill_rating;
+    avl_order_insert(&system->players_by_skill, &player->skill_rating, player);
+    system->columns.skill_rating[system->columns.row_of_id[player_id]] = skill_rating;
+    SkillStatsTree_set(&system->skill_by_id, (size_t)player_id, skill_stats_of(player));
+    if (trie_get(&system->player_names, player->name) == player) {
+        trie_update_score(&system->player_names, player->name, skill_rating);
+    }
+    
+    indexed_heap_update_key(&system->top_skilled_players, (size_t)player_id);
+    return true;
+}
+
+bool update_player_age(BasketballSystem *system, int player_id, int age) {
+    Player *player = find_player_by_id(system, player_id);
+    if (!player) return false;
+    
+    avl_order_remove(&system->players_by_age, &player->age, player);
+    player->age = age;
+    avl_order_insert(&system->players_by_age, &player->age, player);
+    system->columns.age[system->columns.row_of_id[player_id]] = age;
+    
+    indexed_heap_update_key(&system->youngest_players, (size_t)player_id);
+    indexed_heap_update_key(&system->oldest_players, (size_t)player_id);
+    return true;
+}
+
+Team* create_team_with(const Allocator *allocator, int id, const char *name, const char *city,
+                      int league_id) {
+    Team *team = allocator_alloc(allocator, sizeof(Team));
     if (!team) return NULL;
     
     team->team_id = id;
@@ -222,8 +734,13 @@ Team* create_team(int id, const char *name, const char *city, int league_id) {
     return team;
 }
 
+Team* create_team(int id, const char *name, const char *city, int league_id) {
+    return create_team_with(&HEAP_ALLOCATOR, id, name, city, league_id);
+}
+
 void add_team(BasketballSystem *system, const char *name, const char *city, int league_id) {
-    Team *team = create_team(system->next_team_id++, name, city, league_id);
+    Team *team = create_team_with(arena_allocator(&system->arena), system->next_team_id++,
+                                  name, city, league_id);
     if (!team) {
         printf("Error: Failed to create team\n");
         return;
@@ -247,8 +764,9 @@ Team* find_team_by_id(BasketballSystem *system, int id) {
     return (Team*)hashtable_get(&system->team_by_id, &id);
 }
 
-League* create_league(int id, const char *name, const char *country, int season_year) {
-    League *league = malloc(sizeof(League));
+League* create_league_with(const Allocator *allocator, int id, const char *name,
+                          const char *country, int season_year) {
+    League *league = allocator_alloc(allocator, sizeof(League));
     if (!league) return NULL;
     
     league->league_id = id;
@@ -262,8 +780,13 @@ League* create_league(int id, const char *name, const char *country, int season_
     return league;
 }
 
+League* create_league(int id, const char *name, const char *country, int season_year) {
+    return create_league_with(&HEAP_ALLOCATOR, id, name, country, season_year);
+}
+
 void add_league(BasketballSystem *system, const char *name, const char *country, int season_year) {
-    League *league = create_league(system->next_league_id++, name, country, season_year);
+    League *league = create_league_with(arena_allocator(&system->arena), system->next_league_id++,
+                                        name, country, season_year);
     if (!league) {
         printf("Error: Failed to create league\n");
         return;
@@ -277,11 +800,13 @@ void add_league(BasketballSystem *system, const char *name, const char *country,
 
 // Query operations
 DynArray* get_players_by_nationality(BasketballSystem *system, const char *nationality) {
-    return (DynArray*)hashtable_get(&system->players_by_nationality, nationality);
+    uint32_t id = string_interner_lookup(&system->nationalities, nationality);
+    return id != STRING_INTERNER_NONE ? (DynArray*)system->players_by_nationality.data[id] : NULL;
 }
 
 DynArray* get_players_by_position(BasketballSystem *system, const char *position) {
-    return (DynArray*)hashtable_get(&system->players_by_position, position);
+    uint32_t id = string_interner_lookup(&system->positions, position);
+    return id != STRING_INTERNER_NONE ? (DynArray*)system->players_by_position.data[id] : NULL;
 }
 
 DynArray* get_team_roster(BasketballSystem *system, int team_id) {
@@ -289,23 +814,23 @@ DynArray* get_team_roster(BasketballSystem *system, int team_id) {
 }
 
 Player* get_youngest_player(BasketballSystem *system) {
-    return (Player*)min_heap_peek(&system->youngest_players);
+    return (Player*)indexed_heap_peek(&system->youngest_players);
 }
 
 Player* get_oldest_player(BasketballSystem *system) {
-    return (Player*)max_heap_peek(&system->oldest_players);
+    return (Player*)indexed_heap_peek(&system->oldest_players);
 }
 
 Player* get_tallest_player(BasketballSystem *system) {
-    return (Player*)max_heap_peek(&system->tallest_players);
+    return (Player*)indexed_heap_peek(&system->tallest_players);
 }
 
 Player* get_shortest_player(BasketballSystem *system) {
-    return (Player*)min_heap_peek(&system->shortest_players);
+    return (Player*)indexed_heap_peek(&system->shortest_players);
 }
 
 Player* get_most_skilled_player(BasketballSystem *system) {
-    return (Player*)max_heap_peek(&system->top_skilled_players);
+    return (Player*)indexed_heap_peek(&system->top_skilled_players);
 }
 
 // Complex queries
@@ -316,66 +841,182 @@ void find_elite_players_by_nationality_and_position(BasketballSystem *system,
     printf("Elite %s %ss (Skill > %.1f):\n", nationality, position, min_skill);
     printf("=====================================\n");
     
-    // Get players by nationality
-    DynArray *nat_players = get_players_by_nationality(system, nationality);
-    if (!nat_players) {
+    if (string_interner_lookup(&system->nationalities, nationality) == STRING_INTERNER_NONE) {
         printf("No %s players found.\n", nationality);
         return;
     }
-    
-    // Get players by position
-    DynArray *pos_players = get_players_by_position(system, position);
-    if (!pos_players) {
+    if (string_interner_lookup(&system->positions, position) == STRING_INTERNER_NONE) {
         printf("No %s players found.\n", position);
         return;
     }
     
-    // Find intersection using hash set
-    HashSet nat_set;
-    hashset_init_string(&nat_set);
+    // One vectorized pass over the code and skill columns
+    PlayerFilter filter;
+    player_filter_init(&filter);
+    filter.nationality = nationality;
+    filter.position = position;
+    filter.min_skill = min_skill;
     
-    // Add all nationality players to set
-    for (size_t i = 0; i < dynarray_size(nat_players); i++) {
-        Player *player = (Player*)dynarray_get(nat_players, i);
-        hashset_add(&nat_set, player->name); // Use name as unique identifier
+    uint32_t *rows = malloc((system->columns.rows + 1) * sizeof(uint32_t));
+    if (!rows) {
+        printf("Error: Failed to allocate selection\n");
+        return;
     }
-    
-    // Check each position player
-    int count = 0;
-    for (size_t i = 0; i < dynarray_size(pos_players); i++) {
-        Player *player = (Player*)dynarray_get(pos_players, i);
-        
-        if (hashset_contains(&nat_set, player->name) && player->skill_rating >= min_skill) {
-            printf("%d. %s - Age: %d, Skill: %.1f, Team ID: %d\n",
-                   ++count, player->name, player->age, player->skill_rating, player->team_id);
-        }
+    size_t count = select_players(system, &filter, rows);
+    for (size_t i = 0; i < count; i++) {
+        Player *player = (Player*)system->players.data[rows[i]];
+        printf("%zu. %s - Age: %d, Skill: %.1f, Team ID: %d\n",
+               i + 1, player->name, player->age, player->skill_rating, player->team_id);
     }
     
     if (count == 0) {
         printf("No elite %s %ss found.\n", nationality, position);
     }
-    
-    hashset_free(&nat_set);
+    free(rows);
+}
+
+void player_filter_init(PlayerFilter *filter) {
+    filter->nationality = NULL;
+    filter->position = NULL;
+    filter->min_age = INT32_MIN;
+    filter->max_age = INT32_MAX;
+    filter->min_height = -FLT_MAX;
+    filter->max_height = FLT_MAX;
+    filter->min_weight = -FLT_MAX;
+    filter->max_weight = FLT_MAX;
+    filter->min_skill = -FLT_MAX;
+    filter->max_skill = FLT_MAX;
+}
+
+// Translate filter into column predicates, codes first; false if a string matches nobody
+static bool build_player_predicates(const BasketballSystem *system, const PlayerFilter *filter,
+                                    ColumnPredicate *predicates, size_t *count) {
+    const PlayerColumns *columns = &system->columns;
+    size_t n = 0;
+    if (filter->nationality) {
+        uint32_t id = string_interner_lookup(&system->nationalities, filter->nationality);
+        if (id == STRING_INTERNER_NONE) return false;
+        predicates[n++] = column_predicate_code_equals(columns->nationality, (uint16_t)id);
+    }
+    if (filter->position) {
+        uint32_t id = string_interner_lookup(&system->positions, filter->position);
+        if (id == STRING_INTERNER_NONE) return false;
+        predicates[n++] = column_predicate_code_equals(columns->position, (uint16_t)id);
+    }
+    // Unbounded ranges are dropped so they cost nothing
+    if (filter->min_age != INT32_MIN || filter->max_age != INT32_MAX) {
+        predicates[n++] = column_predicate_int_range(columns->age, filter->min_age, filter->max_age);
+    }
+    if (filter->min_height != -FLT_MAX || filter->max_height != FLT_MAX) {
+        predicates[n++] = column_predicate_float_range(columns->height, filter->min_height, filter->max_height);
+    }
+    if (filter->min_weight != -FLT_MAX || filter->max_weight != FLT_MAX) {
+        predicates[n++] = column_predicate_float_range(columns->weight, filter->min_weight, filter->max_weight);
+    }
+    if (filter->min_skill != -FLT_MAX || filter->max_skill != FLT_MAX) {
+        predicates[n++] = column_predicate_float_range(columns->skill_rating, filter->min_skill,
+                                                       filter->max_skill);
+    }
+    *count = n;
+    return true;
+}
+
+size_t select_players(BasketballSystem *system, const PlayerFilter *filter, uint32_t *rows) {
+    ColumnPredicate predicates[6];
+    size_t count;
+    if (!build_player_predicates(system, filter, predicates, &count)) return 0;
+    return column_filter(predicates, count, system->columns.rows, rows);
+}
+
+size_t count_players_matching(BasketballSystem *system, const PlayerFilter *filter) {
+    ColumnPredicate predicates[6];
+    size_t count;
+    if (!build_player_predicates(system, filter, predicates, &count)) return 0;
+    return column_count(predicates, count, system->columns.rows);
+}
+
+// Range query printers (ctx counts printed players)
+static bool print_age_range_player(const void *key, void *value, void *ctx) {
+    (void)key;
+    const Player *player = (const Player*)value;
+    printf("%d. %s - Age: %d, Position: %s, Skill: %.1f\n",
+           ++*(int*)ctx, player->name, player->age, player->position, player->skill_rating);
+    return true;
+}
+
+static bool print_height_range_player(const void *key, void *value, void *ctx) {
+    (void)key;
+    const Player *player = (const Player*)value;
+    printf("%d. %s - Height: %.2fm, Position: %s, Skill: %.1f\n",
+           ++*(int*)ctx, player->name, player->height, player->position, player->skill_rating);
+    return true;
+}
+
+static bool print_skill_range_player(const void *key, void *value, void *ctx) {
+    (void)key;
+    const Player *player = (const Player*)value;
+    printf("%d. %s - Skill: %.1f, Position: %s, Team: %d\n",
+           ++*(int*)ctx, player->name, player->skill_rating, player->position, player->team_id);
+    return true;
 }
 
 void find_players_in_age_range(BasketballSystem *system, int min_age, int max_age) {
     printf("Players aged %d-%d:\n", min_age, max_age);
     printf("==================\n");
     
+    // O(log n + k) walk of the age index, youngest first
     int count = 0;
-    for (size_t i = 0; i < dynarray_size(&system->players); i++) {
-        Player *player = (Player*)dynarray_get(&system->players, i);
-        if (player->age >= min_age && player->age <= max_age) {
-            printf("%d. %s - Age: %d, Position: %s, Skill: %.1f\n",
-                   ++count, player->name, player->age, player->position, player->skill_rating);
-        }
-    }
+    avl_range(&system->players_by_age, &min_age, &max_age, print_age_range_player, &count);
     
     if (count == 0) {
         printf("No players found in age range %d-%d.\n", min_age, max_age);
     }
 }
 
+void find_players_in_height_range(BasketballSystem *system, float min_height, float max_height) {
+    printf("Players %.2fm-%.2fm tall:\n", min_height, max_height);
+    printf("==================\n");
+    
+    int count = 0;
+    avl_range(&system->players_by_height, &min_height, &max_height, print_height_range_player, &count);
+    
+    if (count == 0) {
+        printf("No players found in height range %.2fm-%.2fm.\n", min_height, max_height);
+    }
+}
+
+void find_players_in_skill_range(BasketballSystem *system, float min_skill, float max_skill) {
+    printf("Players rated %.1f-%.1f:\n", min_skill, max_skill);
+    printf("==================\n");
+    
+    int count = 0;
+    avl_range(&system->players_by_skill, &min_skill, &max_skill, print_skill_range_player, &count);
+    
+    if (count == 0) {
+        printf("No players found in skill range %.1f-%.1f.\n", min_skill, max_skill);
+    }
+}
+
+size_t count_players_in_age_range(BasketballSystem *system, int min_age, int max_age) {
+    return avl_count_range(&system->players_by_age, &min_age, &max_age);
+}
+
+Player* get_player_by_skill_rank(BasketballSystem *system, size_t rank) {
+    // Rank 0 is the best player: select from the top of the ascending index
+    size_t n = avl_order_size(&system->players_by_skill);
+    if (rank >= n) return NULL;
+    const AVLOrderNode *node = avl_select(&system->players_by_skill, n - 1 - rank);
+    return node ? (Player*)node->value : NULL;
+}
+
+SkillStats get_skill_stats_in_id_range(BasketballSystem *system, int first_id, int last_id) {
+    // Ids past the last assigned one hold no player; clamp to the tree
+    if (first_id < 0) first_id = 0;
+    if (last_id < first_id || (size_t)first_id >= system->skill_by_id.n) return SKILL_STATS_IDENTITY;
+    size_t end = (size_t)last_id + 1 < system->skill_by_id.n ? (size_t)last_id + 1 : system->skill_by_id.n;
+    return SkillStatsTree_query(&system->skill_by_id, (size_t)first_id, end);
+}
+
 // Trade system
 void request_trade(BasketballSystem *system, int from_team, int to_team, int player_id) {
     TradeTransaction *trade = malloc(sizeof(TradeTransaction));
@@ -392,13 +1033,34 @@ void request_trade(BasketballSystem *system, int from_team, int to_team, int pla
     // Simple timestamp
     sprintf(trade->timestamp, "2024-Season-%ld", trade->trade_time);
     
-    queue_enqueue(&system->trade_requests, trade);
+    if (!mpmc_queue_try_enqueue(&system->trade_requests, trade)) {
+        printf("Error: Trade queue full, request dropped\n");
+        free(trade);
+        return;
+    }
     printf("Trade request queued: Player %d from Team %d to Team %d\n",
            player_id, from_team, to_team);
 }
 
+// Move player's team group entry from its current team to team_id in O(1)
+static void move_player_to_team(BasketballSystem *system, Player *player, int team_id) {
+    group_remove(system, get_team_roster(system, player->team_id), PLAYER_GROUP_TEAM, player);
+    player->team_id = team_id;
+    group_push(system, team_group(system, team_id), PLAYER_GROUP_TEAM, player);
+}
+
+// Order traded players by destination team, then id
+static inline int compare_player_team(const void *a, const void *b) {
+    const Player *p1 = (const Player*)a;
+    const Player *p2 = (const Player*)b;
+    if (p1->team_id != p2->team_id) return p1->team_id < p2->team_id ? -1 : 1;
+    return (p1->player_id > p2->player_id) - (p1->player_id < p2->player_id);
+}
+
+DEFINE_SORT(trade_order, void *, compare_player_team)
+
 void process_next_trade(BasketballSystem *system) {
-    TradeTransaction *trade = (TradeTransaction*)queue_dequeue(&system->trade_requests);
+    TradeTransaction *trade = (TradeTransaction*)mpmc_queue_try_dequeue(&system->trade_requests);
     
     if (!trade) {
         printf("No pending trades.\n");
@@ -409,17 +1071,7 @@ void process_next_trade(BasketballSystem *system) {
     Player *player = find_player_by_id(system, trade->player_id);
     if (player) {
         int old_team = player->team_id;
-        player->team_id = trade->to_team_id;
-        
-        // Update team roster indices (simplified for demo)
-        DynArray *new_roster = get_team_roster(system, trade->to_team_id);
-        
-        if (!new_roster) {
-            new_roster = malloc(sizeof(DynArray));
-            dynarray_init(new_roster, 15);
-            hashtable_put(&system->players_by_team, &trade->to_team_id, new_roster);
-        }
-        dynarray_push(new_roster, player);
+        move_player_to_team(system, player, trade->to_team_id);
         
         // Push to recent transactions stack for undo capability
         stack_push(&system->recent_transactions, trade);
@@ -432,6 +1084,49 @@ void process_next_trade(BasketballSystem *system) {
     }
 }
 
+size_t process_all_trades(BasketballSystem *system) {
+    // Drain the queue first: players leave their old lists as trades apply, then join
+    // their final team's list once, grouped by team
+    DynArray moved;
+    dynarray_init(&moved, 64);
+    size_t processed = 0;
+    TradeTransaction *trade;
+    while ((trade = (TradeTransaction*)mpmc_queue_try_dequeue(&system->trade_requests))) {
+        Player *player = find_player_by_id(system, trade->player_id);
+        if (!player) {
+            printf("Error: Player %d not found\n", trade->player_id);
+            free(trade);
+            continue;
+        }
+        // No-op for a player already moved in this batch (it is in no list until the end)
+        group_remove(system, get_team_roster(system, player->team_id), PLAYER_GROUP_TEAM, player);
+        player->team_id = trade->to_team_id;
+        dynarray_push(&moved, player);
+        stack_push(&system->recent_transactions, trade);
+        processed++;
+    }
+    
+    // One roster lookup and reserve per destination team; repeats of a player are adjacent
+    trade_order_sort(moved.data, moved.size);
+    size_t players_moved = 0;
+    for (size_t i = 0; i < moved.size;) {
+        int team_id = ((Player*)moved.data[i])->team_id;
+        size_t end = i;
+        while (end < moved.size && ((Player*)moved.data[end])->team_id == team_id) end++;
+        DynArray *roster = team_group(system, team_id);
+        dynarray_reserve(roster, roster->size + (end - i));
+        for (; i < end; i++) {
+            if (i > 0 && moved.data[i] == moved.data[i - 1]) continue;
+            group_push(system, roster, PLAYER_GROUP_TEAM, (Player*)moved.data[i]);
+            players_moved++;
+        }
+    }
+    dynarray_free(&moved);
+    
+    printf("Processed %zu trades (%zu players moved)\n", processed, players_moved);
+    return processed;
+}
+
 void undo_last_trade(BasketballSystem *system) {
     TradeTransaction *last_trade = (TradeTransaction*)stack_pop(&system->recent_transactions);
     
@@ -443,7 +1138,7 @@ void undo_last_trade(BasketballSystem *system) {
     // Reverse the trade
     Player *player = find_player_by_id(system, last_trade->player_id);
     if (player) {
-        player->team_id = last_trade->from_team_id;
+        move_player_to_team(system, player, last_trade->from_team_id);
         printf("Trade undone: Player %s (ID: %d) returned to Team %d\n",
                player->name, last_trade->player_id, last_trade->from_team_id);
     }
@@ -506,7 +1201,7 @@ void print_system_statistics(BasketballSystem *system) {
     printf("Total Players: %zu\n", dynarray_size(&system->players));
     printf("Total Teams: %zu\n", dynarray_size(&system->teams));
     printf("Total Leagues: %zu\n", dynarray_size(&system->leagues));
-    printf("Pending Trades: %zu\n", queue_size(&system->trade_requests));
+    printf("Pending Trades: %zu\n", mpmc_queue_size(&system->trade_requests));
     printf("Recent Transactions: %zu\n", stack_size(&system->recent_transactions));
     
     if (dynarray_size(&system->players) > 0) {
@@ -517,6 +1212,10 @@ void print_system_statistics(BasketballSystem *system) {
         if (youngest) printf("Youngest Player: %s (%d years)\n", youngest->name, youngest->age);
         if (oldest) printf("Oldest Player: %s (%d years)\n", oldest->name, oldest->age);
         if (best) printf("Most Skilled: %s (%.1f rating)\n", best->name, best->skill_rating);
+        
+        // Whole-table aggregate is the segment tree root, no scan
+        SkillStats skill = SkillStatsTree_all(&system->skill_by_id);
+        if (skill.count > 0) printf("Average Skill: %.1f\n", skill.sum / (double)skill.count);
     }
     printf("===================================\n");
 }
@@ -537,41 +1236,1767 @@ void print_league_info(BasketballSystem *system, const League *league) {
     printf("==================\n");
 }
 
-void print_top_players_by_skill(BasketballSystem *system, int count) {
-    printf("=== Top %d Players by Skill ===\n", count);
+// Print the first count players of a leaderboard heap (non-destructive, O(k log k))
+static void print_leaderboard(IndexedHeap *heap, int count,
+                              void (*print_entry)(int rank, const Player *player)) {
+    if (count <= 0) return;
     
-    // Create temporary array and sort by skill
-    DynArray temp_players;
-    dynarray_init(&temp_players, dynarray_size(&system->players));
-    
-    // Copy all players
-    for (size_t i = 0; i < dynarray_size(&system->players); i++) {
-        Player *player = (Player*)dynarray_get(&system->players, i);
-        dynarray_push(&temp_players, player);
-    }
-    
-    // Simple bubble sort by skill (for demo purposes)
-    size_t n = dynarray_size(&temp_players);
-    for (size_t i = 0; i < n - 1; i++) {
-        for (size_t j = 0; j < n - i - 1; j++) {
-            Player *p1 = (Player*)dynarray_get(&temp_players, j);
-            Player *p2 = (Player*)dynarray_get(&temp_players, j + 1);
-            if (p1->skill_rating < p2->skill_rating) {
-                // Swap
-                dynarray_set(&temp_players, j, p2);
-                dynarray_set(&temp_players, j + 1, p1);
-            }
-        }
+    void **top = malloc((size_t)count * sizeof(void*));
+    if (!top) {
+        printf("Error: Failed to build leaderboard\n");
+        return;
     }
-    
-    // Print top players
-    int limit = (count < (int)n) ? count : (int)n;
-    for (int i = 0; i < limit; i++) {
-        Player *player = (Player*)dynarray_get(&temp_players, i);
-        printf("%d. %s - %.1f skill (%s, %s)\n", 
-               i+1, player->name, player->skill_rating, player->position, player->nationality);
+    size_t n = indexed_heap_top_k(heap, (size_t)count, top);
+    for (size_t i = 0; i < n; i++) {
+        print_entry((int)i + 1, (const Player*)top[i]);
     }
-    
-    dynarray_free(&temp_players);
+    free(top);
+}
+
+static void print_skill_entry(int rank, const Player *player) {
+    printf("%d. %s - %.1f skill (%s, %s)\n",
+           rank, player->name, player->skill_rating, player->position, player->nationality);
+}
+
+static void print_age_entry(int rank, const Player *player) {
+    printf("%d. %s - %d years (%s, Team %d)\n",
+           rank, player->name, player->age, player->position, player->team_id);
+}
+
+static void print_height_entry(int rank, const Player *player) {
+    printf("%d. %s - %.2fm (%s, Team %d)\n",
+           rank, player->name, player->height, player->position, player->team_id);
+}
+
+void print_top_players_by_skill(BasketballSystem *system, int count) {
+    printf("=== Top %d Players by Skill ===\n", count);
+    print_leaderboard(&system->top_skilled_players, count, print_skill_entry);
+    printf("==============================\n");
+}
+
+void print_top_players_by_age(BasketballSystem *system, int count, bool youngest_first) {
+    printf("=== Top %d %s Players ===\n", count, youngest_first ? "Youngest" : "Oldest");
+    print_leaderboard(youngest_first ? &system->youngest_players : &system->oldest_players,
+                      count, print_age_entry);
+    printf("==============================\n");
+}
+
+void print_top_players_by_height(BasketballSystem *system, int count, bool tallest_first) {
+    printf("=== Top %d %s Players ===\n", count, tallest_first ? "Tallest" : "Shortest");
+    print_leaderboard(tallest_first ? &system->tallest_players : &system->shortest_players,
+                      count, print_height_entry);
     printf("==============================\n");
 }
+
+// Full orderings: numeric fields radix sort on (field, id) keys, names merge sort in parallel
+typedef struct
+{
+    PlayerSortField field;
+    bool descending;
+} PlayerSortOrder;
+
+static uint64_t player_sort_key(const void *element, const void *ctx) {
+    const Player *player = (const Player*)element;
+    const PlayerSortOrder *order = (const PlayerSortOrder*)ctx;
+    uint32_t key;
+    switch (order->field) {
+        case PLAYER_SORT_AGE: key = sort_key_from_int(player->age); break;
+        case PLAYER_SORT_HEIGHT: key = sort_key_from_float(player->height); break;
+        case PLAYER_SORT_WEIGHT: key = sort_key_from_float(player->weight); break;
+        default: key = sort_key_from_float(player->skill_rating); break;
+    }
+    if (order->descending) key = ~key;
+    return (uint64_t)key << 32 | sort_key_from_int(player->player_id);
+}
+
+static inline int compare_player_name(bool descending, const void *a, const void *b) {
+    const Player *p1 = (const Player*)a;
+    const Player *p2 = (const Player*)b;
+    int order = strcmp(p1->name, p2->name);
+    if (order != 0) return descending ? -order : order;
+    return (p1->player_id > p2->player_id) - (p1->player_id < p2->player_id);
+}
+
+DEFINE_SORT_WITH(player_name_order, void *, bool, compare_player_name)
+
+size_t get_players_sorted(BasketballSystem *system, PlayerSortField field, bool descending, DynArray *out) {
+    dynarray_clear(out);
+    dynarray_reserve(out, system->players.size);
+    if (system->players.size > 0) {
+        memcpy(out->data, system->players.data, system->players.size * sizeof(void*));
+    }
+    out->size = system->players.size;
+    
+    if (field != PLAYER_SORT_NAME) {
+        PlayerSortOrder order = {field, descending};
+        dynarray_sort_by_key(out, player_sort_key, &order);
+        return out->size;
+    }
+    // Players sit in allocation order, which suits merge sort (without a pool it runs on this thread)
+    ThreadPool *workers = out->size >= SORT_PARALLEL_THRESHOLD ? system_workers(system) : NULL;
+    player_name_order_parallel_sort(out->data, out->size, descending, workers);
+    return out->size;
+}
+
+void print_players_sorted(BasketballSystem *system, PlayerSortField field, bool descending, int count) {
+    static const char *const field_names[] = {"Skill", "Age", "Height", "Weight", "Name"};
+    DynArray sorted;
+    dynarray_init(&sorted, system->players.size);
+    size_t n = get_players_sorted(system, field, descending, &sorted);
+    if (count >= 0 && (size_t)count < n) n = (size_t)count;
+    
+    printf("=== Players by %s (%s) ===\n", field_names[field], descending ? "descending" : "ascending");
+    for (size_t i = 0; i < n; i++) {
+        const Player *player = (const Player*)sorted.data[i];
+        printf("%zu. %s - %.1f skill, %d years, %.2fm, %.1fkg\n", i + 1, player->name,
+               player->skill_rating, player->age, player->height, player->weight);
+    }
+    printf("==============================\n");
+    dynarray_free(&sorted);
+}
+
+// Snapshot persistence
+//
+// File layout: header, then 64-byte aligned sections. Player, Team and League
+// records are stored verbatim (embedded DynArrays zeroed) and are used in
+// place from a private copy-on-write mapping. Each index is stored in its
+// in-memory shape with record positions instead of pointers: flat-table slots
+// in slot order, chained tables as (hash, position) entries at their stored
+// capacity, heaps in heap order, AVL trees node by node in preorder, the name
+// trie node by node in breadth-first order, the skill segment tree and the
+// name filter bits as arrays. Loading turns positions back into addresses: no
+// key is hashed or compared and no tree is rebalanced. Only the interned
+// nationality/position strings are rebuilt (one hash per distinct value).
+
+#define SNAPSHOT_ALIGNMENT 64
+#define SNAPSHOT_NONE UINT32_MAX
+#define SNAPSHOT_TRIE_LEAF 0x80000000u // Trie edge to a leaf: low bits are the player position
+
+static const char SNAPSHOT_MAGIC[8] = {'B', 'B', 'A', 'L', 'L', 'S', 'N', 'P'};
+
+enum {
+    SNAPSHOT_PLAYERS,
+    SNAPSHOT_TEAMS,
+    SNAPSHOT_LEAGUES,
+    SNAPSHOT_NAME_INDEX,
+    SNAPSHOT_ID_INDEX,
+    SNAPSHOT_NAME_TRIE,
+    SNAPSHOT_NAME_FILTER,
+    SNAPSHOT_TEAM_BY_NAME,
+    SNAPSHOT_TEAM_BY_ID,
+    SNAPSHOT_HEAP_YOUNGEST,
+    SNAPSHOT_HEAP_OLDEST,
+    SNAPSHOT_HEAP_SHORTEST,
+    SNAPSHOT_HEAP_TALLEST,
+    SNAPSHOT_HEAP_SKILL,
+    SNAPSHOT_ORDER_AGE,
+    SNAPSHOT_ORDER_HEIGHT,
+    SNAPSHOT_ORDER_SKILL,
+    SNAPSHOT_SKILL_INDEX,
+    SNAPSHOT_GROUP_NATIONALITY,
+    SNAPSHOT_GROUP_POSITION,
+    SNAPSHOT_GROUP_TEAM,
+    SNAPSHOT_LEAGUE_TEAMS,
+    SNAPSHOT_COLUMNS,
+    SNAPSHOT_SECTION_COUNT
+};
+
+typedef struct {
+    char magic[8];
+    uint32_t version;      // BASKETBALL_SNAPSHOT_VERSION
+    uint32_t player_size;  // Record sizes of the writing build
+    uint32_t team_size;
+    uint32_t league_size;
+    uint64_t hash_probe;   // Stored slot hashes are only valid for the same hash function
+    uint64_t player_count;
+    uint64_t team_count;
+    uint64_t league_count;
+    int32_t next_player_id;
+    int32_t next_team_id;
+    int32_t next_league_id;
+    int32_t reserved;
+    uint64_t sections[SNAPSHOT_SECTION_COUNT]; // File offsets
+    uint64_t file_size;
+} SnapshotHeader;
+
+// Flat hash table section: SnapshotTable, capacity control bytes, capacity slots
+typedef struct {
+    uint64_t capacity;
+    uint64_t size;
+} SnapshotTable;
+
+typedef struct {
+    uint64_t hash;
+    uint32_t player; // SNAPSHOT_NONE for an empty slot
+    uint32_t reserved;
+} SnapshotSlot;
+
+// Chained hash table section: SnapshotTable, then size entries bucket by bucket in chain order
+typedef struct {
+    uint64_t hash;
+    uint32_t record; // Team position
+    uint32_t reserved;
+} SnapshotEntry;
+
+// Ordered index section: SnapshotOrder, then count nodes in preorder
+typedef struct {
+    uint64_t count;
+    uint64_t root; // SNAPSHOT_NONE when empty
+} SnapshotOrder;
+
+typedef struct {
+    uint32_t player;
+    uint32_t left;  // Node positions, SNAPSHOT_NONE for no child
+    uint32_t right;
+    int32_t height;
+    uint64_t count;
+} SnapshotOrderNode;
+
+// Name trie section: SnapshotTrie, then node_count inner nodes in breadth-first order, each a
+// SnapshotTrieNode followed by its edges in key byte order
+typedef struct {
+    uint32_t child; // Inner node position, SNAPSHOT_TRIE_LEAF | player position, or SNAPSHOT_NONE
+    float score;    // Leaf score, for leaves
+    uint8_t key;    // Edge byte (unused for the root)
+    uint8_t reserved[3];
+} SnapshotTrieEdge;
+
+typedef struct {
+    uint64_t size;       // Keys
+    uint64_t node_count; // Inner nodes
+    SnapshotTrieEdge root;
+    uint32_t reserved;
+} SnapshotTrie;
+
+typedef struct {
+    uint32_t prefix_len;
+    float best;
+    uint16_t count;
+    uint8_t type;
+    unsigned char prefix[TRIE_MAX_PREFIX];
+    uint8_t reserved[3];
+} SnapshotTrieNode;
+
+// Name filter section: SnapshotFilter, then block_count blocks of filter bits
+typedef struct {
+    uint64_t block_count;
+    uint64_t count;
+    uint64_t capacity;
+    uint32_t hashes;    // Bits set per key (k)
+    uint32_t reserved;
+    uint64_t bit_probe; // snapshot_filter_probe(hashes) of the writing build
+} SnapshotFilter;
+
+// Skill tree section: SnapshotSkillTree, then the tree's 2 * size nodes
+typedef struct {
+    uint64_t n;
+    uint64_t size;
+} SnapshotSkillTree;
+
+// Team group section: SnapshotTable of players_by_team, then per group a SnapshotGroup and its
+// member positions. Nationality/position group sections: uint64 group count, then one list per
+// interned id.
+typedef struct {
+    uint64_t hash; // Cached hash of team_id in players_by_team
+    int32_t team_id;
+    uint32_t count;
+} SnapshotGroup;
+
+// Column section: SnapshotColumns, interned strings in id order, then each column array
+typedef struct {
+    uint64_t rows;
+    uint64_t nationality_count;
+    uint64_t position_count;
+} SnapshotColumns;
+
+#define SNAPSHOT_NATIONALITY_SIZE sizeof(((Player*)0)->nationality)
+#define SNAPSHOT_POSITION_SIZE sizeof(((Player*)0)->position)
+
+// Sequential writer that tracks the file offset
+typedef struct {
+    FILE *file;
+    uint64_t offset;
+    bool ok;
+} SnapshotWriter;
+
+static void snapshot_put(SnapshotWriter *writer, const void *data, size_t bytes) {
+    if (writer->ok && bytes > 0 && fwrite(data, 1, bytes, writer->file) != bytes) writer->ok = false;
+    writer->offset += bytes;
+}
+
+static void snapshot_pad(SnapshotWriter *writer, size_t alignment) {
+    static const unsigned char zeros[SNAPSHOT_ALIGNMENT] = {0};
+    size_t padding = (alignment - writer->offset % alignment) % alignment;
+    snapshot_put(writer, zeros, padding);
+}
+
+// Start a section on an aligned offset and record where it begins
+static void snapshot_begin_section(SnapshotWriter *writer, SnapshotHeader *header, int section) {
+    snapshot_pad(writer, SNAPSHOT_ALIGNMENT);
+    header->sections[section] = writer->offset;
+}
+
+// Bounds-checked reader over the mapped file
+typedef struct {
+    unsigned char *base;
+    size_t size;
+    size_t offset;
+    bool ok;
+} SnapshotReader;
+
+static void *snapshot_take(SnapshotReader *reader, size_t bytes, size_t alignment) {
+    size_t start = (reader->offset + alignment - 1) / alignment * alignment;
+    if (!reader->ok || start > reader->size || bytes > reader->size - start) {
+        reader->ok = false;
+        return NULL;
+    }
+    reader->offset = start + bytes;
+    return reader->base + start;
+}
+
+static void *snapshot_take_array(SnapshotReader *reader, uint64_t count, size_t element_size) {
+    if (count > SIZE_MAX / element_size) {
+        reader->ok = false;
+        return NULL;
+    }
+    return snapshot_take(reader, (size_t)count * element_size, element_size < 8 ? element_size : 8);
+}
+
+static void snapshot_seek(SnapshotReader *reader, const SnapshotHeader *header, int section) {
+    reader->offset = (size_t)header->sections[section];
+    if (header->sections[section] > reader->size) reader->ok = false;
+}
+
+// Position of a player in system->players, looked up by its id
+static uint32_t snapshot_player_index(const uint32_t *index_of_id, const Player *player) {
+    return index_of_id[player->player_id];
+}
+
+static void snapshot_save_table(SnapshotWriter *writer, const FlatHashTable *table, const uint32_t *index_of_id) {
+    SnapshotTable info = {table->capacity, table->size};
+    snapshot_put(writer, &info, sizeof(info));
+    snapshot_put(writer, table->ctrl, table->capacity);
+    snapshot_pad(writer, sizeof(uint64_t));
+    for (size_t i = 0; i < table->capacity; i++) {
+        SnapshotSlot slot = {0, SNAPSHOT_NONE, 0};
+        if (table->ctrl[i] != FLAT_HASHTABLE_EMPTY) {
+            const unsigned char *bytes = flat_hashtable_slot(table, i);
+            slot.hash = flat_hashtable_slot_hash(bytes);
+            slot.player = snapshot_player_index(index_of_id, (const Player*)flat_hashtable_slot_value(bytes));
+        }
+        snapshot_put(writer, &slot, sizeof(slot));
+    }
+}
+
+// Team lookup table: every entry's cached hash and team position
+static void snapshot_save_team_table(SnapshotWriter *writer, const HashTable *table, const uint32_t *team_index) {
+    SnapshotTable info = {table->capacity, table->size};
+    snapshot_put(writer, &info, sizeof(info));
+    HashTableIterator it;
+    HashEntry *entry;
+    hashtable_iter_init(&it, table);
+    while ((entry = hashtable_iter_next(&it))) {
+        SnapshotEntry stored = {entry->hash, team_index[((const Team*)entry->value)->team_id], 0};
+        snapshot_put(writer, &stored, sizeof(stored));
+    }
+}
+
+static void snapshot_save_heap(SnapshotWriter *writer, const IndexedHeap *heap, const uint32_t *index_of_id) {
+    uint64_t size = heap->size;
+    snapshot_put(writer, &size, sizeof(size));
+    for (size_t i = 0; i < heap->size; i++) {
+        uint32_t player = snapshot_player_index(index_of_id, (const Player*)heap->items[heap->heap[i]]);
+        snapshot_put(writer, &player, sizeof(player));
+    }
+}
+
+// Number nodes in preorder; returns the position of node
+static uint32_t snapshot_collect_order(const AVLOrderNode *node, SnapshotOrderNode *nodes, uint32_t *next,
+                                       const uint32_t *index_of_id) {
+    if (!node) return SNAPSHOT_NONE;
+    uint32_t position = (*next)++;
+    nodes[position].player = snapshot_player_index(index_of_id, (const Player*)node->value);
+    nodes[position].height = node->height;
+    nodes[position].count = node->count;
+    nodes[position].left = snapshot_collect_order(node->left, nodes, next, index_of_id);
+    nodes[position].right = snapshot_collect_order(node->right, nodes, next, index_of_id);
+    return position;
+}
+
+// Stored positions in key order (internal helper)
+static void snapshot_order_inorder(const SnapshotOrderNode *nodes, uint32_t position, uint32_t *out, size_t *count) {
+    while (position != SNAPSHOT_NONE) {
+        snapshot_order_inorder(nodes, nodes[position].left, out, count);
+        out[(*count)++] = position;
+        position = nodes[position].right;
+    }
+}
+
+static int snapshot_compare_index(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Loaded pairs tie-break on record address, i.e. snapshot position, while live ones use the
+// original addresses (removals reorder rows): renumber each run of equal keys ascending
+static bool snapshot_order_ties(SnapshotOrderNode *nodes, size_t count, const AVLOrderTree *tree,
+                                void *const *rows, size_t key_offset) {
+    uint32_t *inorder = malloc((count > 0 ? count : 1) * sizeof(uint32_t));
+    uint32_t *run = malloc((count > 0 ? count : 1) * sizeof(uint32_t));
+    if (!inorder || !run) {
+        free(inorder);
+        free(run);
+        return false;
+    }
+    size_t visited = 0;
+    if (count > 0) snapshot_order_inorder(nodes, 0, inorder, &visited);
+    for (size_t begin = 0, end; begin < visited; begin = end) {
+        const char *key = (const char*)rows[nodes[inorder[begin]].player] + key_offset;
+        for (end = begin + 1; end < visited; end++) {
+            if (tree->compare(key, (const char*)rows[nodes[inorder[end]].player] + key_offset) != 0) break;
+        }
+        if (end - begin < 2) continue;
+        for (size_t i = begin; i < end; i++) run[i - begin] = nodes[inorder[i]].player;
+        qsort(run, end - begin, sizeof(uint32_t), snapshot_compare_index);
+        for (size_t i = begin; i < end; i++) nodes[inorder[i]].player = run[i - begin];
+    }
+    free(inorder);
+    free(run);
+    return true;
+}
+
+static void snapshot_save_order(SnapshotWriter *writer, const AVLOrderTree *tree, const uint32_t *index_of_id,
+                                void *const *rows, size_t key_offset) {
+    size_t count = avl_order_size(tree);
+    SnapshotOrderNode *nodes = malloc((count > 0 ? count : 1) * sizeof(SnapshotOrderNode));
+    if (!nodes) {
+        writer->ok = false;
+        return;
+    }
+    uint32_t next = 0;
+    SnapshotOrder info = {count, snapshot_collect_order(tree->root, nodes, &next, index_of_id)};
+    if (!snapshot_order_ties(nodes, count, tree, rows, key_offset)) writer->ok = false;
+    snapshot_put(writer, &info, sizeof(info));
+    snapshot_put(writer, nodes, count * sizeof(SnapshotOrderNode));
+    free(nodes);
+}
+
+static void snapshot_save_team_groups(SnapshotWriter *writer, HashTable *index, const uint32_t *index_of_id) {
+    SnapshotTable info = {index->capacity, index->size};
+    snapshot_put(writer, &info, sizeof(info));
+    
+    HashTableIterator it;
+    HashEntry *entry;
+    hashtable_iter_init(&it, index);
+    while ((entry = hashtable_iter_next(&it))) {
+        const DynArray *members = (const DynArray*)entry->value;
+        SnapshotGroup group = {entry->hash, *(const int*)entry->key, (uint32_t)members->size};
+        snapshot_pad(writer, sizeof(uint64_t));
+        snapshot_put(writer, &group, sizeof(group));
+        for (size_t i = 0; i < members->size; i++) {
+            uint32_t player = snapshot_player_index(index_of_id, (const Player*)members->data[i]);
+            snapshot_put(writer, &player, sizeof(player));
+        }
+    }
+}
+
+// Children of a trie node in key byte order
+static unsigned snapshot_trie_children(const TrieNode *node, unsigned char *keys, void **children) {
+    unsigned count = 0;
+    switch (node->type) {
+    case TRIE_NODE4:
+    case TRIE_NODE16: {
+        bool small = node->type == TRIE_NODE4;
+        const unsigned char *stored = small ? ((const TrieNode4*)node)->keys : ((const TrieNode16*)node)->keys;
+        void *const *links = small ? ((const TrieNode4*)node)->children : ((const TrieNode16*)node)->children;
+        for (; count < node->count; count++) {
+            keys[count] = stored[count];
+            children[count] = links[count];
+        }
+        break;
+    }
+    case TRIE_NODE48: {
+        const TrieNode48 *n = (const TrieNode48*)node;
+        for (unsigned b = 0; b < 256; b++) {
+            if (!n->index[b]) continue;
+            keys[count] = (unsigned char)b;
+            children[count++] = n->children[n->index[b] - 1];
+        }
+        break;
+    }
+    default: {
+        const TrieNode256 *n = (const TrieNode256*)node;
+        for (unsigned b = 0; b < 256; b++) {
+            if (!n->children[b]) continue;
+            keys[count] = (unsigned char)b;
+            children[count++] = n->children[b];
+        }
+        break;
+    }
+    }
+    return count;
+}
+
+// Edge to a trie child; inner nodes take the next breadth-first position
+static SnapshotTrieEdge snapshot_trie_edge(const void *child, unsigned char key, uint32_t *next_node,
+                                           const uint32_t *index_of_id) {
+    SnapshotTrieEdge edge = {SNAPSHOT_NONE, 0.0f, key, {0}};
+    if (!child) return edge;
+    if (TRIE_IS_LEAF(child)) {
+        const TrieLeaf *leaf = TRIE_LEAF(child);
+        edge.child = SNAPSHOT_TRIE_LEAF | snapshot_player_index(index_of_id, (const Player*)leaf->value);
+        edge.score = leaf->score;
+    } else {
+        edge.child = (*next_node)++;
+    }
+    return edge;
+}
+
+static void snapshot_save_trie(SnapshotWriter *writer, const Trie *trie, const uint32_t *index_of_id) {
+    // Breadth-first node list first: the section header carries its length
+    DynArray nodes;
+    dynarray_init(&nodes, 64);
+    unsigned char keys[256];
+    void *children[256];
+    if (trie->root && !TRIE_IS_LEAF(trie->root)) dynarray_push(&nodes, trie->root);
+    for (size_t i = 0; i < nodes.size; i++) {
+        unsigned count = snapshot_trie_children((const TrieNode*)nodes.data[i], keys, children);
+        for (unsigned c = 0; c < count; c++) {
+            if (!TRIE_IS_LEAF(children[c])) dynarray_push(&nodes, children[c]);
+        }
+    }
+    
+    uint32_t next_node = 0;
+    SnapshotTrie info = {trie->size, nodes.size, snapshot_trie_edge(trie->root, 0, &next_node, index_of_id), 0};
+    snapshot_put(writer, &info, sizeof(info));
+    for (size_t i = 0; i < nodes.size; i++) {
+        const TrieNode *node = (const TrieNode*)nodes.data[i];
+        SnapshotTrieNode stored = {node->prefix_len, node->best, node->count, node->type, {0}, {0}};
+        memcpy(stored.prefix, node->prefix, TRIE_MAX_PREFIX);
+        snapshot_pad(writer, sizeof(uint64_t));
+        snapshot_put(writer, &stored, sizeof(stored));
+        unsigned count = snapshot_trie_children(node, keys, children);
+        for (unsigned c = 0; c < count; c++) {
+            SnapshotTrieEdge edge = snapshot_trie_edge(children[c], keys[c], &next_node, index_of_id);
+            snapshot_put(writer, &edge, sizeof(edge));
+        }
+    }
+    dynarray_free(&nodes);
+}
+
+static void snapshot_save_skill_tree(SnapshotWriter *writer, const SkillStatsTree *tree) {
+    SnapshotSkillTree info = {tree->n, tree->size};
+    snapshot_put(writer, &info, sizeof(info));
+    snapshot_put(writer, tree->tree, 2 * tree->size * sizeof(SkillStats));
+}
+
+// One list per record: uint32 count, then positions given by index_of_id
+static void snapshot_save_list(SnapshotWriter *writer, const DynArray *list, const uint32_t *index_of_id,
+                               size_t id_offset) {
+    uint32_t count = (uint32_t)list->size;
+    snapshot_put(writer, &count, sizeof(count));
+    for (size_t i = 0; i < list->size; i++) {
+        int id;
+        memcpy(&id, (const char*)list->data[i] + id_offset, sizeof(int));
+        snapshot_put(writer, &index_of_id[id], sizeof(uint32_t));
+    }
+}
+
+// Groups indexed by interned id: group count, then one member list per id
+static void snapshot_save_id_groups(SnapshotWriter *writer, const DynArray *groups, const uint32_t *index_of_id) {
+    uint64_t count = groups->size;
+    snapshot_put(writer, &count, sizeof(count));
+    for (size_t i = 0; i < groups->size; i++) {
+        snapshot_save_list(writer, (const DynArray*)groups->data[i], index_of_id, offsetof(Player, player_id));
+    }
+}
+
+static void snapshot_save_names(SnapshotWriter *writer, const StringInterner *names, size_t width) {
+    char buffer[SNAPSHOT_NATIONALITY_SIZE];
+    for (uint32_t i = 0; i < string_interner_count(names); i++) {
+        memset(buffer, 0, sizeof(buffer));
+        strncpy(buffer, string_interner_string(names, i), width - 1);
+        snapshot_put(writer, buffer, width);
+    }
+}
+
+// Column arrays are written as-is, each starting on an 8-byte boundary
+static void snapshot_save_columns(SnapshotWriter *writer, const BasketballSystem *system) {
+    const PlayerColumns *columns = &system->columns;
+    SnapshotColumns info = {columns->rows, string_interner_count(&system->nationalities),
+                            string_interner_count(&system->positions)};
+    snapshot_put(writer, &info, sizeof(info));
+    snapshot_save_names(writer, &system->nationalities, SNAPSHOT_NATIONALITY_SIZE);
+    snapshot_save_names(writer, &system->positions, SNAPSHOT_POSITION_SIZE);
+    
+    const void *arrays[] = {columns->age, columns->height, columns->weight, columns->skill_rating,
+                            columns->nationality, columns->position};
+    const size_t widths[] = {sizeof(int32_t), sizeof(float), sizeof(float), sizeof(float),
+                             sizeof(uint16_t), sizeof(uint16_t)};
+    for (int c = 0; c < 6; c++) {
+        snapshot_pad(writer, sizeof(uint64_t));
+        snapshot_put(writer, arrays[c], columns->rows * widths[c]);
+    }
+}
+
+static uint64_t snapshot_hash_probe(void) {
+    return (uint64_t)STRING_HASH_FUNC.hash("basketball-snapshot", SIZE_MAX);
+}
+
+// Filter bits hang off the name hash (covered by hash_probe) through filter_remix and the
+// per-bit salts, which play the part of a seed; stored bits are only valid for the same ones
+static uint64_t snapshot_filter_probe(unsigned hashes) {
+    uint64_t mixed = filter_remix(snapshot_hash_probe());
+    uint64_t probe = 0;
+    for (unsigned i = 0; i < hashes; i++) probe = probe * 31 + mixed * BLOOM_FILTER_SALTS[i];
+    return probe;
+}
+
+static void snapshot_save_filter(SnapshotWriter *writer, const BloomFilter *filter) {
+    SnapshotFilter info = {filter->block_count, filter->count, filter->capacity, filter->hashes, 0,
+                           snapshot_filter_probe(filter->hashes)};
+    snapshot_put(writer, &info, sizeof(info));
+    snapshot_put(writer, filter->blocks, bloom_filter_bytes(filter));
+}
+
+bool basketball_system_save(BasketballSystem *system, const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        printf("Error: Cannot open snapshot %s for writing\n", path);
+        return false;
+    }
+    
+    // Record positions by id (ids are dense and below the next_* counters)
+    uint32_t *player_index = malloc((size_t)system->next_player_id * sizeof(uint32_t));
+    uint32_t *team_index = malloc((size_t)system->next_team_id * sizeof(uint32_t));
+    if (!player_index || !team_index) {
+        free(player_index);
+        free(team_index);
+        fclose(file);
+        printf("Error: Failed to build snapshot\n");
+        return false;
+    }
+    for (size_t i = 0; i < system->players.size; i++) {
+        player_index[((Player*)system->players.data[i])->player_id] = (uint32_t)i;
+    }
+    for (size_t i = 0; i < system->teams.size; i++) {
+        team_index[((Team*)system->teams.data[i])->team_id] = (uint32_t)i;
+    }
+    
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = BASKETBALL_SNAPSHOT_VERSION;
+    header.player_size = sizeof(Player);
+    header.team_size = sizeof(Team);
+    header.league_size = sizeof(League);
+    header.hash_probe = snapshot_hash_probe();
+    header.player_count = system->players.size;
+    header.team_count = system->teams.size;
+    header.league_count = system->leagues.size;
+    header.next_player_id = system->next_player_id;
+    header.next_team_id = system->next_team_id;
+    header.next_league_id = system->next_league_id;
+    
+    SnapshotWriter writer = {file, 0, true};
+    snapshot_put(&writer, &header, sizeof(header)); // Rewritten once offsets are known
+    
+    snapshot_begin_section(&writer, &header, SNAPSHOT_PLAYERS);
+    for (size_t i = 0; i < system->players.size; i++) {
+        snapshot_put(&writer, system->players.data[i], sizeof(Player));
+    }
+    snapshot_begin_section(&writer, &header, SNAPSHOT_TEAMS);
+    for (size_t i = 0; i < system->teams.size; i++) {
+        Team team = *(const Team*)system->teams.data[i];
+        memset(&team.roster, 0, sizeof(team.roster));
+        snapshot_put(&writer, &team, sizeof(team));
+    }
+    snapshot_begin_section(&writer, &header, SNAPSHOT_LEAGUES);
+    for (size_t i = 0; i < system->leagues.size; i++) {
+        League league = *(const League*)system->leagues.data[i];
+        memset(&league.teams, 0, sizeof(league.teams));
+        snapshot_put(&writer, &league, sizeof(league));
+    }
+    
+    snapshot_begin_section(&writer, &header, SNAPSHOT_NAME_INDEX);
+    snapshot_save_table(&writer, &system->player_by_name, player_index);
+    snapshot_begin_section(&writer, &header, SNAPSHOT_ID_INDEX);
+    snapshot_save_table(&writer, &system->player_by_id, player_index);
+    snapshot_begin_section(&writer, &header, SNAPSHOT_NAME_TRIE);
+    snapshot_save_trie(&writer, &system->player_names, player_index);
+    snapshot_begin_section(&writer, &header, SNAPSHOT_NAME_FILTER);
+    snapshot_save_filter(&writer, &system->name_filter);
+    snapshot_begin_section(&writer, &header, SNAPSHOT_TEAM_BY_NAME);
+    snapshot_save_team_table(&writer, &system->team_by_name, team_index);
+    snapshot_begin_section(&writer, &header, SNAPSHOT_TEAM_BY_ID);
+    snapshot_save_team_table(&writer, &system->team_by_id, team_index);
+    
+    const IndexedHeap *heaps[] = {&system->youngest_players, &system->oldest_players, &system->shortest_players,
+                                  &system->tallest_players, &system->top_skilled_players};
+    for (int h = 0; h < 5; h++) {
+        snapshot_begin_section(&writer, &header, SNAPSHOT_HEAP_YOUNGEST + h);
+        snapshot_save_heap(&writer, heaps[h], player_index);
+    }
+    
+    const AVLOrderTree *orders[] = {&system->players_by_age, &system->players_by_height, &system->players_by_skill};
+    const size_t order_keys[] = {offsetof(Player, age), offsetof(Player, height), offsetof(Player, skill_rating)};
+    for (int o = 0; o < 3; o++) {
+        snapshot_begin_section(&writer, &header, SNAPSHOT_ORDER_AGE + o);
+        snapshot_save_order(&writer, orders[o], player_index, system->players.data, order_keys[o]);
+    }
+    snapshot_begin_section(&writer, &header, SNAPSHOT_SKILL_INDEX);
+    snapshot_save_skill_tree(&writer, &system->skill_by_id);
+    
+    snapshot_begin_section(&writer, &header, SNAPSHOT_GROUP_NATIONALITY);
+    snapshot_save_id_groups(&writer, &system->players_by_nationality, player_index);
+    snapshot_begin_section(&writer, &header, SNAPSHOT_GROUP_POSITION);
+    snapshot_save_id_groups(&writer, &system->players_by_position, player_index);
+    snapshot_begin_section(&writer, &header, SNAPSHOT_GROUP_TEAM);
+    snapshot_save_team_groups(&writer, &system->players_by_team, player_index);
+    
+    snapshot_begin_section(&writer, &header, SNAPSHOT_LEAGUE_TEAMS);
+    for (size_t i = 0; i < system->leagues.size; i++) {
+        snapshot_save_list(&writer, &((League*)system->leagues.data[i])->teams, team_index,
+                           offsetof(Team, team_id));
+    }
+    
+    snapshot_begin_section(&writer, &header, SNAPSHOT_COLUMNS);
+    snapshot_save_columns(&writer, system);
+    
+    header.file_size = writer.offset;
+    if (writer.ok && fseek(file, 0, SEEK_SET) == 0) {
+        snapshot_put(&writer, &header, sizeof(header));
+    } else {
+        writer.ok = false;
+    }
+    if (fclose(file) != 0) writer.ok = false;
+    free(player_index);
+    free(team_index);
+    
+    if (!writer.ok) {
+        printf("Error: Failed to write snapshot %s\n", path);
+        return false;
+    }
+    printf("Saved snapshot %s (%zu players, %llu bytes)\n", path, system->players.size,
+           (unsigned long long)header.file_size);
+    return true;
+}
+
+// Rebuild a flat table's slots from stored positions (identical capacity, no probing)
+static bool snapshot_load_table(SnapshotReader *reader, FlatHashTable *table, Player *players,
+                                uint64_t player_count, size_t key_offset) {
+    SnapshotTable *info = snapshot_take(reader, sizeof(SnapshotTable), sizeof(uint64_t));
+    if (!info || info->capacity > SIZE_MAX / 2) return false;
+    uint8_t *ctrl = snapshot_take_array(reader, info->capacity, 1);
+    SnapshotSlot *slots = snapshot_take_array(reader, info->capacity, sizeof(SnapshotSlot));
+    if (!ctrl || !slots) return false;
+    
+    const HashFunction *hash_func = table->hash_func;
+    size_t key_size = table->key_size;
+    flat_hashtable_free(table);
+    flat_hashtable_init(table, (size_t)info->capacity, hash_func, key_size);
+    if (table->capacity != info->capacity) return false;
+    
+    memcpy(table->ctrl, ctrl, table->capacity);
+    size_t filled = 0;
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (ctrl[i] == FLAT_HASHTABLE_EMPTY) continue;
+        if (slots[i].player >= player_count) return false;
+        Player *player = &players[slots[i].player];
+        flat_hashtable_slot_fill(table, flat_hashtable_slot(table, i), (char*)player + key_offset, player,
+                                 slots[i].hash);
+        filled++;
+    }
+    table->size = filled;
+    return filled == info->size;
+}
+
+// Read a chained table's header and reset the table to its stored capacity
+static bool snapshot_load_chained_info(SnapshotReader *reader, HashTable *table, uint64_t max_size,
+                                       uint64_t *size) {
+    SnapshotTable *info = snapshot_take(reader, sizeof(SnapshotTable), sizeof(uint64_t));
+    // Tables only grow, doubling once the load factor is passed, so capacity stays near size
+    if (!info || info->size > max_size || info->capacity < HASHTABLE_MIN_SIZE ||
+        info->capacity > 4 * info->size + HASHTABLE_DEFAULT_SIZE) return false;
+    
+    const HashFunction *hash_func = table->hash_func;
+    const Allocator *allocator = table->allocator;
+    hashtable_free(table);
+    hashtable_init_with_allocator(table, (size_t)info->capacity, hash_func, allocator);
+    *size = info->size;
+    return true;
+}
+
+// Refill a team lookup table from stored hashes (entries in reverse, so chains keep their order)
+static bool snapshot_load_team_table(SnapshotReader *reader, HashTable *table, Team *teams, uint64_t team_count,
+                                     size_t key_offset) {
+    uint64_t size;
+    if (!snapshot_load_chained_info(reader, table, team_count, &size)) return false;
+    SnapshotEntry *entries = snapshot_take_array(reader, size, sizeof(SnapshotEntry));
+    if (!entries) return false;
+    for (size_t i = (size_t)size; i-- > 0;) {
+        if (entries[i].record >= team_count) return false;
+        Team *team = &teams[entries[i].record];
+        hashtable_insert_hashed(table, (char*)team + key_offset, team, entries[i].hash);
+    }
+    return true;
+}
+
+// Restore heap order as stored and derive the handle map from it
+static bool snapshot_load_heap(SnapshotReader *reader, IndexedHeap *heap, Player *players,
+                               uint64_t player_count, int max_player_id) {
+    uint64_t *size = snapshot_take(reader, sizeof(uint64_t), sizeof(uint64_t));
+    uint32_t *order = size ? snapshot_take_array(reader, *size, sizeof(uint32_t)) : NULL;
+    if (!order || *size > player_count) return false;
+    
+    heap_compare_fn compare = heap->compare;
+    indexed_heap_free(heap);
+    indexed_heap_init(heap, compare, (size_t)*size);
+    if (max_player_id > 0) indexed_heap_reserve_handle(heap, (size_t)max_player_id);
+    for (size_t i = 0; i < *size; i++) {
+        if (order[i] >= player_count) return false;
+        Player *player = &players[order[i]];
+        size_t handle = (size_t)player->player_id;
+        if (player->player_id <= 0 || player->player_id > max_player_id ||
+            heap->position[handle] != INDEXED_HEAP_ABSENT) return false;
+        heap->heap[i] = handle;
+        heap->position[handle] = i;
+        heap->items[handle] = player;
+    }
+    heap->size = (size_t)*size;
+    return true;
+}
+
+// Recreate AVL nodes with their stored shape, heights and subtree counts
+static bool snapshot_load_order(SnapshotReader *reader, AVLOrderTree *tree, Player *players,
+                                uint64_t player_count, size_t key_offset) {
+    SnapshotOrder *info = snapshot_take(reader, sizeof(SnapshotOrder), sizeof(uint64_t));
+    SnapshotOrderNode *stored = info ? snapshot_take_array(reader, info->count, sizeof(SnapshotOrderNode)) : NULL;
+    if (!stored || info->count > player_count) return false;
+    if (info->count == 0) return info->root == SNAPSHOT_NONE;
+    if (info->root != 0) return false;
+    
+    size_t count = (size_t)info->count;
+    AVLOrderNode **nodes = malloc(count * sizeof(AVLOrderNode*));
+    if (!nodes) return false;
+    for (size_t i = 0; i < count; i++) {
+        nodes[i] = allocator_alloc(tree->allocator, sizeof(AVLOrderNode));
+        if (!nodes[i] || stored[i].player >= player_count) {
+            free(nodes);
+            return false;
+        }
+    }
+    // Preorder positions: every child comes after its parent and has one parent, so this is a tree
+    unsigned char *linked = calloc(count, 1);
+    bool ok = linked != NULL;
+    for (size_t i = 0; ok && i < count; i++) {
+        Player *player = &players[stored[i].player];
+        uint32_t children[2] = {stored[i].left, stored[i].right};
+        AVLOrderNode *links[2] = {NULL, NULL};
+        for (int c = 0; c < 2 && ok; c++) {
+            if (children[c] == SNAPSHOT_NONE) continue;
+            ok = children[c] > i && children[c] < count && !linked[children[c]];
+            if (ok) {
+                linked[children[c]] = 1;
+                links[c] = nodes[children[c]];
+            }
+        }
+        nodes[i]->key = (const char*)player + key_offset;
+        nodes[i]->value = player;
+        nodes[i]->height = stored[i].height;
+        nodes[i]->count = (size_t)stored[i].count;
+        nodes[i]->left = links[0];
+        nodes[i]->right = links[1];
+    }
+    if (ok) tree->root = nodes[0];
+    // On failure the unlinked nodes go back with the pool
+    free(linked);
+    free(nodes);
+    return ok;
+}
+
+// Resolve a stored trie edge: a new leaf for a player, or a node made in the first pass. Positions
+// are breadth-first, so a node's children come after it, and each node has one parent.
+static bool snapshot_load_trie_edge(Trie *trie, const SnapshotTrieEdge *edge, size_t first, TrieNode **nodes,
+                                    unsigned char *linked, size_t node_count, Player *players,
+                                    uint64_t player_count, void **child) {
+    if (edge->child & SNAPSHOT_TRIE_LEAF) {
+        uint32_t position = edge->child & ~SNAPSHOT_TRIE_LEAF;
+        if (position >= player_count) return false;
+        Player *player = &players[position];
+        size_t length = strnlen(player->name, sizeof(player->name));
+        TrieLeaf *leaf = length < sizeof(player->name) ? pool_alloc(&trie->leaf_pool) : NULL;
+        if (!leaf) return false;
+        leaf->key = (const unsigned char*)player->name;
+        leaf->key_len = (uint32_t)length + 1;
+        leaf->score = edge->score;
+        leaf->value = player;
+        *child = TRIE_TAG_LEAF(leaf);
+        trie->size++;
+        return true;
+    }
+    if (edge->child < first || edge->child >= node_count || linked[edge->child]) return false;
+    linked[edge->child] = 1;
+    *child = nodes[edge->child];
+    return true;
+}
+
+// Recreate trie nodes with their stored kind, prefix and best score, then link them
+static bool snapshot_load_trie(SnapshotReader *reader, Trie *trie, Player *players, uint64_t player_count) {
+    static const unsigned capacity[] = {0, 4, 16, 48, 256};
+    SnapshotTrie *info = snapshot_take(reader, sizeof(SnapshotTrie), sizeof(uint64_t));
+    if (!info || info->size > player_count || info->node_count > info->size) return false;
+    if (info->root.child == SNAPSHOT_NONE) return info->size == 0 && info->node_count == 0;
+    
+    size_t count = (size_t)info->node_count;
+    TrieNode **nodes = malloc((count > 0 ? count : 1) * sizeof(TrieNode*));
+    SnapshotTrieEdge **edges = malloc((count > 0 ? count : 1) * sizeof(SnapshotTrieEdge*));
+    unsigned char *linked = calloc(count > 0 ? count : 1, 1);
+    bool ok = nodes && edges && linked;
+    for (size_t i = 0; ok && i < count; i++) {
+        SnapshotTrieNode *stored = snapshot_take(reader, sizeof(SnapshotTrieNode), sizeof(uint64_t));
+        ok = stored && stored->type >= TRIE_NODE4 && stored->type <= TRIE_NODE256 && stored->count >= 2 &&
+             stored->count <= capacity[stored->type];
+        edges[i] = ok ? snapshot_take_array(reader, stored->count, sizeof(SnapshotTrieEdge)) : NULL;
+        if (!(ok = edges[i] != NULL)) break;
+        nodes[i] = trie_node_new(trie, stored->type);
+        nodes[i]->prefix_len = stored->prefix_len;
+        nodes[i]->best = stored->best;
+        nodes[i]->count = stored->count;
+        memcpy(nodes[i]->prefix, stored->prefix, TRIE_MAX_PREFIX);
+    }
+    void *root = NULL;
+    ok = ok && snapshot_load_trie_edge(trie, &info->root, 0, nodes, linked, count, players, player_count, &root);
+    for (size_t i = 0; ok && i < count; i++) {
+        TrieNode *node = nodes[i];
+        for (unsigned e = 0; ok && e < node->count; e++) {
+            const SnapshotTrieEdge *edge = &edges[i][e];
+            void *child = NULL;
+            // Keys strictly ascending: Node4/Node16 lookups and inserts rely on the order
+            ok = (e == 0 || edge->key > edges[i][e - 1].key) &&
+                 snapshot_load_trie_edge(trie, edge, i + 1, nodes, linked, count, players, player_count, &child);
+            if (!ok) break;
+            switch (node->type) {
+            case TRIE_NODE4:
+                ((TrieNode4*)node)->keys[e] = edge->key;
+                ((TrieNode4*)node)->children[e] = child;
+                break;
+            case TRIE_NODE16:
+                ((TrieNode16*)node)->keys[e] = edge->key;
+                ((TrieNode16*)node)->children[e] = child;
+                break;
+            case TRIE_NODE48:
+                ((TrieNode48*)node)->children[e] = child;
+                ((TrieNode48*)node)->index[edge->key] = (unsigned char)(e + 1);
+                break;
+            default:
+                ((TrieNode256*)node)->children[edge->key] = child;
+                break;
+            }
+        }
+    }
+    for (size_t i = 0; ok && i < count; i++) ok = linked[i];
+    ok = ok && trie->size == info->size;
+    if (ok) trie->root = root;
+    // On failure the unlinked nodes and leaves go back with the pools
+    free(linked);
+    free(edges);
+    free(nodes);
+    return ok;
+}
+
+// Copy the filter bits into a fresh cache-line aligned array
+static bool snapshot_load_filter(SnapshotReader *reader, BloomFilter *filter) {
+    SnapshotFilter *info = snapshot_take(reader, sizeof(SnapshotFilter), sizeof(uint64_t));
+    if (!info || info->block_count == 0 || info->hashes < 1 || info->hashes > BLOOM_FILTER_MAX_HASHES ||
+        info->bit_probe != snapshot_filter_probe(info->hashes)) return false;
+    uint64_t *blocks = snapshot_take_array(reader, info->block_count, BLOOM_FILTER_BLOCK_BYTES);
+    if (!blocks) return false;
+    
+    bloom_filter_free(filter);
+    size_t bytes = (size_t)info->block_count * BLOOM_FILTER_BLOCK_BYTES;
+    filter->blocks = (uint64_t*)aligned_alloc(BLOOM_FILTER_BLOCK_BYTES, bytes);
+    if (!filter->blocks) {
+        fprintf(stderr, "snapshot_load_filter: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(filter->blocks, blocks, bytes);
+    filter->block_count = (size_t)info->block_count;
+    filter->hashes = info->hashes;
+    filter->count = (size_t)info->count;
+    filter->capacity = (size_t)info->capacity;
+    return true;
+}
+
+// Copy the skill tree's nodes back; every stored player must fall inside it
+static bool snapshot_load_skill_tree(SnapshotReader *reader, SkillStatsTree *tree, const Player *players,
+                                     uint64_t player_count, int next_player_id) {
+    SnapshotSkillTree *info = snapshot_take(reader, sizeof(SnapshotSkillTree), sizeof(uint64_t));
+    if (!info || info->n > (uint64_t)next_player_id || info->size != segtree_leaf_count((size_t)info->n, NULL)) {
+        return false;
+    }
+    SkillStats *nodes = snapshot_take_array(reader, 2 * info->size, sizeof(SkillStats));
+    if (!nodes) return false;
+    for (size_t i = 0; i < player_count; i++) {
+        if ((uint64_t)players[i].player_id >= info->n) return false;
+    }
+    
+    SkillStatsTree_free(tree);
+    SkillStatsTree_init(tree, (size_t)info->n);
+    memcpy(tree->tree, nodes, 2 * tree->size * sizeof(SkillStats));
+    return true;
+}
+
+static bool snapshot_load_team_groups(SnapshotReader *reader, BasketballSystem *system, Player *players,
+                                      uint64_t player_count) {
+    uint64_t groups;
+    if (!snapshot_load_chained_info(reader, &system->players_by_team, player_count, &groups)) return false;
+    for (uint64_t g = 0; g < groups; g++) {
+        SnapshotGroup *group = snapshot_take(reader, sizeof(SnapshotGroup), sizeof(uint64_t));
+        uint32_t *members = group ? snapshot_take_array(reader, group->count, sizeof(uint32_t)) : NULL;
+        if (!members) return false;
+        
+        // Groups come in stored order, so each chain comes back reversed (only iteration order differs)
+        DynArray *list = arena_alloc(&system->arena, sizeof(DynArray));
+        dynarray_init(list, group->count > 0 ? group->count : 1);
+        hashtable_insert_hashed(&system->players_by_team, &group->team_id, list, group->hash);
+        for (uint32_t i = 0; i < group->count; i++) {
+            if (members[i] >= player_count) return false;
+            dynarray_push(list, &players[members[i]]);
+        }
+    }
+    return true;
+}
+
+static bool snapshot_load_list(SnapshotReader *reader, DynArray *list, size_t min_capacity,
+                               char *records, size_t record_size, uint64_t record_count) {
+    uint32_t *count = snapshot_take(reader, sizeof(uint32_t), sizeof(uint32_t));
+    uint32_t *items = count ? snapshot_take_array(reader, *count, sizeof(uint32_t)) : NULL;
+    dynarray_init(list, count && *count > min_capacity ? *count : min_capacity);
+    if (!items) return false;
+    for (uint32_t i = 0; i < *count; i++) {
+        if (items[i] >= record_count) return false;
+        dynarray_push(list, records + (size_t)items[i] * record_size);
+    }
+    return true;
+}
+
+// Groups indexed by interned id; needs the interner loaded first to check the id range
+static bool snapshot_load_id_groups(SnapshotReader *reader, BasketballSystem *system, DynArray *groups,
+                                    const StringInterner *names, Player *players, uint64_t player_count) {
+    uint64_t *count = snapshot_take(reader, sizeof(uint64_t), sizeof(uint64_t));
+    if (!count || *count != string_interner_count(names)) return false;
+    dynarray_reserve(groups, (size_t)*count);
+    for (uint64_t g = 0; g < *count; g++) {
+        DynArray *list = arena_alloc(&system->arena, sizeof(DynArray));
+        bool loaded = snapshot_load_list(reader, list, 1, (char*)players, sizeof(Player), player_count);
+        dynarray_push(groups, list); // Pushed even on failure so free releases it
+        if (!loaded) return false;
+    }
+    return true;
+}
+
+// Re-intern strings in id order (one hash per distinct value)
+static bool snapshot_load_names(SnapshotReader *reader, StringInterner *names, uint64_t count, size_t width) {
+    char *stored = snapshot_take_array(reader, count, width);
+    if (!stored || count > UINT16_MAX) return false;
+    for (uint64_t i = 0; i < count; i++) {
+        char *name = stored + i * width;
+        name[width - 1] = '\0';
+        if (string_interner_intern(names, name) != i) return false; // Duplicate entry
+    }
+    return true;
+}
+
+// Copy the column arrays back; row_of_id follows from the player records
+static bool snapshot_load_columns(SnapshotReader *reader, BasketballSystem *system, Player *players,
+                                  uint64_t player_count, int max_player_id) {
+    PlayerColumns *columns = &system->columns;
+    SnapshotColumns *info = snapshot_take(reader, sizeof(SnapshotColumns), sizeof(uint64_t));
+    if (!info || info->rows != player_count) return false;
+    if (!snapshot_load_names(reader, &system->nationalities, info->nationality_count, SNAPSHOT_NATIONALITY_SIZE) ||
+        !snapshot_load_names(reader, &system->positions, info->position_count, SNAPSHOT_POSITION_SIZE)) {
+        return false;
+    }
+    
+    size_t rows = (size_t)info->rows;
+    player_columns_reserve(columns, rows, max_player_id);
+    void *arrays[] = {columns->age, columns->height, columns->weight, columns->skill_rating,
+                      columns->nationality, columns->position};
+    const size_t widths[] = {sizeof(int32_t), sizeof(float), sizeof(float), sizeof(float),
+                             sizeof(uint16_t), sizeof(uint16_t)};
+    for (int c = 0; c < 6; c++) {
+        snapshot_take(reader, 0, sizeof(uint64_t));
+        void *stored = snapshot_take_array(reader, rows, widths[c]);
+        if (!stored) return false;
+        if (rows > 0) memcpy(arrays[c], stored, rows * widths[c]);
+    }
+    for (size_t row = 0; row < rows; row++) {
+        columns->row_of_id[players[row].player_id] = (uint32_t)row;
+    }
+    columns->rows = rows;
+    return true;
+}
+
+// Slots of every grouped player; a player listed twice in one index is corrupt
+static bool snapshot_rebuild_group_slots(BasketballSystem *system) {
+    PlayerColumns *columns = &system->columns;
+    memset(columns->group_slot, 0xFF, columns->id_capacity * sizeof(*columns->group_slot));
+    DynArray *id_groups[] = {&system->players_by_nationality, &system->players_by_position};
+    for (int group = 0; group < PLAYER_GROUP_TEAM; group++) {
+        for (size_t g = 0; g < id_groups[group]->size; g++) {
+            DynArray *list = (DynArray*)id_groups[group]->data[g];
+            for (size_t i = 0; i < list->size; i++) {
+                uint32_t *slot = &columns->group_slot[((Player*)list->data[i])->player_id][group];
+                if (*slot != PLAYER_SLOT_NONE) return false;
+                *slot = (uint32_t)i;
+            }
+        }
+    }
+    HashTableIterator it;
+    HashEntry *entry;
+    hashtable_iter_init(&it, &system->players_by_team);
+    while ((entry = hashtable_iter_next(&it))) {
+        DynArray *list = (DynArray*)entry->value;
+        for (size_t i = 0; i < list->size; i++) {
+            uint32_t *slot = &columns->group_slot[((Player*)list->data[i])->player_id][PLAYER_GROUP_TEAM];
+            if (*slot != PLAYER_SLOT_NONE) return false;
+            *slot = (uint32_t)i;
+        }
+    }
+    return true;
+}
+
+// Check header fields and that every record array fits in the file
+static bool snapshot_header_valid(const SnapshotHeader *header, size_t file_size) {
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0) return false;
+    if (header->version != BASKETBALL_SNAPSHOT_VERSION) return false;
+    if (header->player_size != sizeof(Player) || header->team_size != sizeof(Team) ||
+        header->league_size != sizeof(League)) return false;
+    if (header->hash_probe != snapshot_hash_probe() || header->file_size != file_size) return false;
+    if (header->next_player_id < 1 || header->next_team_id < 1 || header->next_league_id < 1) return false;
+    for (int s = 0; s < SNAPSHOT_SECTION_COUNT; s++) {
+        if (header->sections[s] > file_size || header->sections[s] % SNAPSHOT_ALIGNMENT != 0) return false;
+    }
+    return header->player_count <= (file_size - header->sections[SNAPSHOT_PLAYERS]) / sizeof(Player) &&
+           header->team_count <= (file_size - header->sections[SNAPSHOT_TEAMS]) / sizeof(Team) &&
+           header->league_count <= (file_size - header->sections[SNAPSHOT_LEAGUES]) / sizeof(League);
+}
+
+bool basketball_system_load_mmap(BasketballSystem *system, const char *path) {
+    basketball_system_init(system);
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Error: Cannot open snapshot %s\n", path);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(SnapshotHeader)) {
+        close(fd);
+        printf("Error: Snapshot %s is truncated\n", path);
+        return false;
+    }
+    size_t size = (size_t)info.st_size;
+    // Private mapping: records may be updated in memory without touching the file
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        printf("Error: Cannot map snapshot %s\n", path);
+        return false;
+    }
+    system->snapshot = map;
+    system->snapshot_size = size;
+    
+    SnapshotHeader *header = (SnapshotHeader*)map;
+    if (!snapshot_header_valid(header, size)) {
+        basketball_system_free(system);
+        basketball_system_init(system);
+        printf("Error: Snapshot %s has an incompatible format\n", path);
+        return false;
+    }
+    
+    SnapshotReader reader = {(unsigned char*)map, size, 0, true};
+    uint64_t player_count = header->player_count;
+    uint64_t team_count = header->team_count;
+    uint64_t league_count = header->league_count;
+    Player *players = (Player*)(reader.base + header->sections[SNAPSHOT_PLAYERS]);
+    Team *teams = (Team*)(reader.base + header->sections[SNAPSHOT_TEAMS]);
+    League *leagues = (League*)(reader.base + header->sections[SNAPSHOT_LEAGUES]);
+    int max_player_id = header->next_player_id - 1;
+    bool ok = true;
+    
+    // Primary storage points straight into the mapping
+    dynarray_free(&system->players);
+    dynarray_init(&system->players, player_count > 0 ? (size_t)player_count : 1);
+    for (size_t i = 0; ok && i < player_count; i++) {
+        ok = players[i].player_id > 0 && players[i].player_id <= max_player_id;
+        dynarray_push(&system->players, &players[i]);
+    }
+    for (size_t i = 0; i < team_count; i++) {
+        dynarray_push(&system->teams, &teams[i]);
+        dynarray_init(&teams[i].roster, 1); // Unused: players_by_team holds the roster
+    }
+    for (size_t i = 0; i < league_count; i++) {
+        dynarray_push(&system->leagues, &leagues[i]);
+        memset(&leagues[i].teams, 0, sizeof(leagues[i].teams));
+    }
+    
+    snapshot_seek(&reader, header, SNAPSHOT_NAME_INDEX);
+    ok = ok && snapshot_load_table(&reader, &system->player_by_name, players, player_count, offsetof(Player, name));
+    snapshot_seek(&reader, header, SNAPSHOT_ID_INDEX);
+    ok = ok && snapshot_load_table(&reader, &system->player_by_id, players, player_count,
+                                   offsetof(Player, player_id));
+    snapshot_seek(&reader, header, SNAPSHOT_NAME_TRIE);
+    ok = ok && snapshot_load_trie(&reader, &system->player_names, players, player_count);
+    snapshot_seek(&reader, header, SNAPSHOT_NAME_FILTER);
+    ok = ok && snapshot_load_filter(&reader, &system->name_filter);
+    snapshot_seek(&reader, header, SNAPSHOT_TEAM_BY_NAME);
+    ok = ok && snapshot_load_team_table(&reader, &system->team_by_name, teams, team_count, offsetof(Team, name));
+    snapshot_seek(&reader, header, SNAPSHOT_TEAM_BY_ID);
+    ok = ok && snapshot_load_team_table(&reader, &system->team_by_id, teams, team_count, offsetof(Team, team_id));
+    
+    IndexedHeap *heaps[] = {&system->youngest_players, &system->oldest_players, &system->shortest_players,
+                            &system->tallest_players, &system->top_skilled_players};
+    for (int h = 0; ok && h < 5; h++) {
+        snapshot_seek(&reader, header, SNAPSHOT_HEAP_YOUNGEST + h);
+        ok = snapshot_load_heap(&reader, heaps[h], players, player_count, max_player_id);
+    }
+    
+    AVLOrderTree *orders[] = {&system->players_by_age, &system->players_by_height, &system->players_by_skill};
+    size_t order_keys[] = {offsetof(Player, age), offsetof(Player, height), offsetof(Player, skill_rating)};
+    for (int o = 0; ok && o < 3; o++) {
+        snapshot_seek(&reader, header, SNAPSHOT_ORDER_AGE + o);
+        ok = snapshot_load_order(&reader, orders[o], players, player_count, order_keys[o]);
+    }
+    snapshot_seek(&reader, header, SNAPSHOT_SKILL_INDEX);
+    ok = ok && snapshot_load_skill_tree(&reader, &system->skill_by_id, players, player_count,
+                                        header->next_player_id);
+    
+    // Columns first: they re-intern the strings the id-indexed groups refer to
+    snapshot_seek(&reader, header, SNAPSHOT_COLUMNS);
+    ok = ok && snapshot_load_columns(&reader, system, players, player_count, max_player_id);
+    snapshot_seek(&reader, header, SNAPSHOT_GROUP_NATIONALITY);
+    ok = ok && snapshot_load_id_groups(&reader, system, &system->players_by_nationality, &system->nationalities,
+                                       players, player_count);
+    snapshot_seek(&reader, header, SNAPSHOT_GROUP_POSITION);
+    ok = ok && snapshot_load_id_groups(&reader, system, &system->players_by_position, &system->positions,
+                                       players, player_count);
+    snapshot_seek(&reader, header, SNAPSHOT_GROUP_TEAM);
+    ok = ok && snapshot_load_team_groups(&reader, system, players, player_count);
+    ok = ok && snapshot_rebuild_group_slots(system);
+    
+    snapshot_seek(&reader, header, SNAPSHOT_LEAGUE_TEAMS);
+    for (size_t i = 0; i < league_count; i++) {
+        bool loaded = ok && snapshot_load_list(&reader, &leagues[i].teams, 30, (char*)teams, sizeof(Team),
+                                               team_count);
+        if (!ok) dynarray_init(&leagues[i].teams, 1);
+        ok = loaded;
+    }
+    
+    if (!ok || !reader.ok) {
+        basketball_system_free(system);
+        basketball_system_init(system);
+        printf("Error: Snapshot %s is corrupt\n", path);
+        return false;
+    }
+    
+    system->next_player_id = header->next_player_id;
+    system->next_team_id = header->next_team_id;
+    system->next_league_id = header->next_league_id;
+    return true;
+}
+
+// Streaming ingest
+//
+// The feed is mapped read-only and cut into chunks of about chunk_bytes that
+// end on a line break. Reader tasks on a thread pool claim chunks in order,
+// parse each into a batch of Player records and pass it to the committer (the
+// calling thread) on an MPMC queue. Batches are recycled through a second
+// queue holding queue_depth free batches, so readers that get ahead of the
+// committer wait for one instead of buffering the whole feed. The committer
+// inserts batches in chunk order through the bulk-load path, so ids follow
+// the feed just as repeated add_player calls would. Large batches build their
+// indexes on the system's shared workers, not on the reader pool: its threads
+// run the reader loops, and waiting on it would wait for those as well.
+
+enum {
+    INGEST_NAME,
+    INGEST_NATIONALITY,
+    INGEST_POSITION,
+    INGEST_AGE,
+    INGEST_HEIGHT,
+    INGEST_WEIGHT,
+    INGEST_JERSEY_NUMBER,
+    INGEST_SKILL_RATING,
+    INGEST_TEAM_ID,
+    INGEST_FIELD_COUNT
+};
+
+// CSV column order and JSON keys
+static const char *const INGEST_FIELD_NAMES[INGEST_FIELD_COUNT] = {
+    "name", "nationality", "position", "age", "height", "weight", "jersey_number", "skill_rating", "team_id"};
+
+#define INGEST_FIELD_MAX 128      // Longest field kept (text fields are truncated further by Player)
+#define INGEST_BATCH_MIN_RECORDS 1024
+
+// Records parsed from one chunk
+typedef struct {
+    Player *records;
+    size_t count;
+    size_t capacity; // Kept when the batch is recycled
+    size_t rejected; // Malformed lines in the chunk
+    size_t chunk;    // Chunk index, the commit order
+    double stall_seconds; // Reader wait for this free batch
+    double parse_seconds;
+    double ready_at; // When the batch was queued for the committer
+} IngestBatch;
+
+// State shared by the readers and the committer
+typedef struct {
+    const char *data;
+    const size_t *chunk_starts; // chunk_count + 1 offsets; the last one is the feed size
+    size_t chunk_count;
+    IngestFormat format;
+    atomic_size_t next_chunk;   // Next chunk to claim
+    MPMCQueue free_batches;     // Empty batches; readers block here when the committer lags
+    MPMCQueue ready_batches;    // Parsed batches in completion order
+} IngestPipeline;
+
+void ingest_options_init(IngestOptions *options) {
+    options->format = INGEST_FORMAT_CSV;
+    options->readers = 0;
+    options->chunk_bytes = INGEST_CHUNK_BYTES;
+    options->queue_depth = 0;
+}
+
+// Monotonic wall clock in seconds (threads overlap, so CPU time would overcount)
+static double ingest_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static void ingest_stage_add(IngestStage *stage, double seconds) {
+    stage->batches++;
+    stage->total_seconds += seconds;
+    if (seconds > stage->max_seconds) stage->max_seconds = seconds;
+}
+
+// Whole-field numbers; empty fields and trailing characters are rejected
+static bool ingest_parse_int(const char *text, size_t length, int *out) {
+    char *end;
+    if (length == 0) return false;
+    long value = strtol(text, &end, 10);
+    if (end != text + length || value < INT32_MIN || value > INT32_MAX) return false;
+    *out = (int)value;
+    return true;
+}
+
+static bool ingest_parse_float(const char *text, size_t length, float *out) {
+    char *end;
+    if (length == 0) return false;
+    *out = strtof(text, &end);
+    return end == text + length;
+}
+
+static void ingest_copy_text(char *dest, size_t size, const char *text, size_t length) {
+    if (length >= size) length = size - 1;
+    memcpy(dest, text, length);
+    dest[length] = '\0';
+}
+
+// Store one field of a record; text is NUL-terminated at length
+static bool ingest_set_field(Player *player, int field, const char *text, size_t length) {
+    switch (field) {
+    case INGEST_NAME:
+        ingest_copy_text(player->name, sizeof(player->name), text, length);
+        return length > 0;
+    case INGEST_NATIONALITY:
+        ingest_copy_text(player->nationality, sizeof(player->nationality), text, length);
+        return length > 0;
+    case INGEST_POSITION:
+        ingest_copy_text(player->position, sizeof(player->position), text, length);
+        return length > 0;
+    case INGEST_AGE:
+        return ingest_parse_int(text, length, &player->age);
+    case INGEST_HEIGHT:
+        return ingest_parse_float(text, length, &player->height);
+    case INGEST_WEIGHT:
+        return ingest_parse_float(text, length, &player->weight);
+    case INGEST_JERSEY_NUMBER:
+        return ingest_parse_int(text, length, &player->jersey_number);
+    case INGEST_SKILL_RATING:
+        return ingest_parse_float(text, length, &player->skill_rating);
+    case INGEST_TEAM_ID:
+        return ingest_parse_int(text, length, &player->team_id);
+    default:
+        return false;
+    }
+}
+
+static const char *ingest_skip_spaces(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    return p;
+}
+
+// Parse one CSV line; fields may be double-quoted with "" for a literal quote
+static bool ingest_parse_csv(const char *p, const char *end, Player *player) {
+    char field[INGEST_FIELD_MAX];
+    int index = 0;
+    
+    while (true) {
+        size_t length = 0;
+        bool closed = true;
+        p = ingest_skip_spaces(p, end);
+        if (p < end && *p == '"') {
+            closed = false;
+            for (p++; p < end; p++) {
+                if (*p == '"') {
+                    if (p + 1 < end && p[1] == '"') {
+                        p++;
+                    } else {
+                        p++;
+                        closed = true;
+                        break;
+                    }
+                }
+                if (length < sizeof(field) - 1) field[length++] = *p;
+            }
+            p = ingest_skip_spaces(p, end);
+            if (p < end && *p != ',') return false;
+        } else {
+            const char *start = p;
+            while (p < end && *p != ',') p++;
+            const char *stop = p;
+            while (stop > start && (stop[-1] == ' ' || stop[-1] == '\t')) stop--;
+            for (const char *c = start; c < stop && length < sizeof(field) - 1; c++) field[length++] = *c;
+        }
+        field[length] = '\0';
+        if (!closed || index >= INGEST_FIELD_COUNT || !ingest_set_field(player, index, field, length)) {
+            return false;
+        }
+        index++;
+        if (p >= end) break;
+        p++; // Past the comma
+    }
+    return index == INGEST_FIELD_COUNT;
+}
+
+// Append a code point as UTF-8 (lone surrogates become '?')
+static size_t ingest_put_utf8(char *out, size_t length, size_t size, unsigned code) {
+    char bytes[3];
+    size_t count;
+    if (code >= 0xD800 && code <= 0xDFFF) code = '?';
+    if (code < 0x80) {
+        bytes[0] = (char)code;
+        count = 1;
+    } else if (code < 0x800) {
+        bytes[0] = (char)(0xC0 | (code >> 6));
+        bytes[1] = (char)(0x80 | (code & 0x3F));
+        count = 2;
+    } else {
+        bytes[0] = (char)(0xE0 | (code >> 12));
+        bytes[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        bytes[2] = (char)(0x80 | (code & 0x3F));
+        count = 3;
+    }
+    for (size_t i = 0; i < count && length < size - 1; i++) out[length++] = bytes[i];
+    return length;
+}
+
+// Parse a JSON string at p (on the opening quote) into out; NULL if malformed
+static const char *ingest_json_string(const char *p, const char *end, char *out, size_t size, size_t *length) {
+    size_t n = 0;
+    for (p++; p < end && *p != '"'; p++) {
+        char c = *p;
+        if (c == '\\') {
+            if (++p >= end) return NULL;
+            switch (*p) {
+            case '"': case '\\': case '/': c = *p; break;
+            case 'b': c = '\b'; break;
+            case 'f': c = '\f'; break;
+            case 'n': c = '\n'; break;
+            case 'r': c = '\r'; break;
+            case 't': c = '\t'; break;
+            case 'u': {
+                unsigned code = 0;
+                for (int i = 0; i < 4; i++) {
+                    if (++p >= end) return NULL;
+                    char h = *p;
+                    unsigned digit = (h >= '0' && h <= '9') ? (unsigned)(h - '0')
+                                   : (h >= 'a' && h <= 'f') ? (unsigned)(h - 'a' + 10)
+                                   : (h >= 'A' && h <= 'F') ? (unsigned)(h - 'A' + 10) : 16u;
+                    if (digit == 16) return NULL;
+                    code = code << 4 | digit;
+                }
+                n = ingest_put_utf8(out, n, size, code);
+                continue;
+            }
+            default: return NULL;
+            }
+        }
+        if (n < size - 1) out[n++] = c;
+    }
+    if (p >= end) return NULL;
+    out[n] = '\0';
+    *length = n;
+    return p + 1;
+}
+
+// Parse one flat JSON object; every field must be present, unknown keys are ignored
+static bool ingest_parse_json(const char *p, const char *end, Player *player) {
+    char key[INGEST_FIELD_MAX];
+    char value[INGEST_FIELD_MAX];
+    unsigned seen = 0;
+    
+    p = ingest_skip_spaces(p, end);
+    if (p >= end || *p++ != '{') return false;
+    p = ingest_skip_spaces(p, end);
+    if (p < end && *p == '}') return false;
+    while (true) {
+        size_t key_length;
+        size_t length;
+        if (p >= end || *p != '"' || !(p = ingest_json_string(p, end, key, sizeof(key), &key_length))) return false;
+        p = ingest_skip_spaces(p, end);
+        if (p >= end || *p++ != ':') return false;
+        p = ingest_skip_spaces(p, end);
+        if (p < end && *p == '"') {
+            if (!(p = ingest_json_string(p, end, value, sizeof(value), &length))) return false;
+        } else {
+            // Bare scalar: number, true, false or null
+            const char *start = p;
+            while (p < end && *p != ',' && *p != '}' && *p != ' ' && *p != '\t') p++;
+            length = (size_t)(p - start);
+            if (length == 0 || length >= sizeof(value)) return false;
+            memcpy(value, start, length);
+            value[length] = '\0';
+        }
+        for (int field = 0; field < INGEST_FIELD_COUNT; field++) {
+            if (strcmp(key, INGEST_FIELD_NAMES[field]) != 0) continue;
+            if (!ingest_set_field(player, field, value, length)) return false;
+            seen |= 1u << field;
+            break;
+        }
+        p = ingest_skip_spaces(p, end);
+        if (p < end && *p == ',') {
+            p = ingest_skip_spaces(p + 1, end);
+            continue;
+        }
+        if (p >= end || *p++ != '}') return false;
+        break;
+    }
+    return ingest_skip_spaces(p, end) == end && seen == (1u << INGEST_FIELD_COUNT) - 1;
+}
+
+// Parse every line of the batch's chunk; blank lines and a leading CSV header are skipped
+static void ingest_parse_chunk(const IngestPipeline *pipeline, IngestBatch *batch) {
+    const char *p = pipeline->data + pipeline->chunk_starts[batch->chunk];
+    const char *end = pipeline->data + pipeline->chunk_starts[batch->chunk + 1];
+    
+    while (p < end) {
+        const char *newline = memchr(p, '\n', (size_t)(end - p));
+        const char *line_end = newline ? newline : end;
+        const char *next = newline ? newline + 1 : end;
+        if (line_end > p && line_end[-1] == '\r') line_end--;
+        bool header = p == pipeline->data && pipeline->format == INGEST_FORMAT_CSV &&
+                      (size_t)(line_end - p) >= 5 && memcmp(p, "name,", 5) == 0;
+        if (header || ingest_skip_spaces(p, line_end) == line_end) {
+            p = next;
+            continue;
+        }
+        
+        if (batch->count == batch->capacity) {
+            size_t capacity = batch->capacity ? 2 * batch->capacity : INGEST_BATCH_MIN_RECORDS;
+            Player *records = realloc(batch->records, capacity * sizeof(Player));
+            if (!records) {
+                fprintf(stderr, "basketball_system_ingest: allocation failed\n");
+                exit(EXIT_FAILURE);
+            }
+            batch->records = records;
+            batch->capacity = capacity;
+        }
+        Player *player = &batch->records[batch->count];
+        memset(player, 0, sizeof(Player));
+        bool ok = pipeline->format == INGEST_FORMAT_CSV ? ingest_parse_csv(p, line_end, player)
+                                                        : ingest_parse_json(p, line_end, player);
+        if (ok) {
+            batch->count++;
+        } else {
+            batch->rejected++;
+        }
+        p = next;
+    }
+}
+
+// ThreadPoolRangeFn run once per reader: parse chunks until none are left
+static void ingest_reader(void *ctx, size_t begin, size_t end, size_t worker) {
+    (void)begin;
+    (void)end;
+    (void)worker;
+    IngestPipeline *pipeline = (IngestPipeline*)ctx;
+    
+    while (true) {
+        double wait_start = ingest_now();
+        IngestBatch *batch;
+        while (!(batch = mpmc_queue_try_dequeue(&pipeline->free_batches))) sched_yield();
+        
+        size_t chunk = atomic_fetch_add(&pipeline->next_chunk, 1);
+        if (chunk >= pipeline->chunk_count) {
+            mpmc_queue_try_enqueue(&pipeline->free_batches, batch); // Room for every batch
+            return;
+        }
+        double parse_start = ingest_now();
+        batch->stall_seconds = parse_start - wait_start;
+        batch->chunk = chunk;
+        batch->count = 0;
+        batch->rejected = 0;
+        ingest_parse_chunk(pipeline, batch);
+        batch->ready_at = ingest_now();
+        batch->parse_seconds = batch->ready_at - parse_start;
+        while (!mpmc_queue_try_enqueue(&pipeline->ready_batches, batch)) sched_yield();
+    }
+}
+
+// Cut the feed into chunks of at least chunk_bytes ending after a newline; returns the chunk count
+static size_t ingest_split_chunks(const char *data, size_t size, size_t chunk_bytes, size_t *starts) {
+    size_t count = 0;
+    size_t offset = 0;
+    while (offset < size) {
+        starts[count++] = offset;
+        if (size - offset <= chunk_bytes) break;
+        const char *newline = memchr(data + offset + chunk_bytes - 1, '\n', size - offset - chunk_bytes + 1);
+        offset = newline ? (size_t)(newline - data) + 1 : size;
+    }
+    starts[count] = size;
+    return count;
+}
+
+bool basketball_system_ingest(BasketballSystem *system, const char *path, const IngestOptions *options,
+                              IngestReport *report) {
+    IngestOptions defaults;
+    IngestReport local;
+    if (!options) {
+        ingest_options_init(&defaults);
+        options = &defaults;
+    }
+    if (!report) report = &local;
+    memset(report, 0, sizeof(*report));
+    double start = ingest_now();
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Error: Cannot open feed %s\n", path);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        printf("Error: Cannot read feed %s\n", path);
+        return false;
+    }
+    size_t size = (size_t)info.st_size;
+    if (size == 0) {
+        close(fd);
+        return true;
+    }
+    const char *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        printf("Error: Cannot map feed %s\n", path);
+        return false;
+    }
+    posix_madvise((void*)data, size, POSIX_MADV_SEQUENTIAL);
+    
+    size_t chunk_bytes = options->chunk_bytes ? options->chunk_bytes : INGEST_CHUNK_BYTES;
+    size_t *starts = malloc((size / chunk_bytes + 2) * sizeof(size_t));
+    if (!starts) {
+        fprintf(stderr, "basketball_system_ingest: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t chunk_count = ingest_split_chunks(data, size, chunk_bytes, starts);
+    
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t readers = options->readers ? options->readers : (cpus > 0 ? (size_t)cpus : 1);
+    if (readers > chunk_count) readers = chunk_count;
+    size_t depth = options->queue_depth ? options->queue_depth : INGEST_BATCHES_PER_READER * readers;
+    IngestBatch *batches = calloc(depth, sizeof(IngestBatch));
+    IngestBatch **pending = calloc(chunk_count, sizeof(IngestBatch*)); // Parsed ahead of the commit point
+    if (!batches || !pending) {
+        fprintf(stderr, "basketball_system_ingest: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    
+    IngestPipeline pipeline;
+    pipeline.data = data;
+    pipeline.chunk_starts = starts;
+    pipeline.chunk_count = chunk_count;
+    pipeline.format = options->format;
+    atomic_init(&pipeline.next_chunk, 0);
+    mpmc_queue_init(&pipeline.free_batches, depth);
+    mpmc_queue_init(&pipeline.ready_batches, depth);
+    for (size_t i = 0; i < depth; i++) mpmc_queue_try_enqueue(&pipeline.free_batches, &batches[i]);
+    
+    // Start the commit workers up front so no batch's commit latency includes it
+    system_workers(system);
+    ThreadPool pool;
+    thread_pool_init(&pool, readers);
+    for (size_t i = 0; i < readers; i++) thread_pool_submit(&pool, ingest_reader, &pipeline, i, i + 1);
+    
+    // Commit in chunk order; batches that finish early wait in pending
+    bool ok = true;
+    size_t next = 0;
+    while (next < chunk_count) {
+        IngestBatch *batch = mpmc_queue_try_dequeue(&pipeline.ready_batches);
+        if (!batch) {
+            sched_yield();
+            continue;
+        }
+        pending[batch->chunk] = batch;
+        while (next < chunk_count && pending[next]) {
+            batch = pending[next];
+            pending[next++] = NULL;
+            double commit_start = ingest_now();
+            if (ok && batch->count > 0) ok = bulk_insert_players(system, batch->records, batch->count);
+            if (ok) report->records += batch->count;
+            report->rejected += batch->rejected;
+            ingest_stage_add(&report->stall, batch->stall_seconds);
+            ingest_stage_add(&report->parse, batch->parse_seconds);
+            ingest_stage_add(&report->queued, commit_start - batch->ready_at);
+            ingest_stage_add(&report->commit, ingest_now() - commit_start);
+            mpmc_queue_try_enqueue(&pipeline.free_batches, batch);
+        }
+    }
+    thread_pool_wait(&pool);
+    thread_pool_free(&pool);
+    
+    mpmc_queue_free(&pipeline.free_batches);
+    mpmc_queue_free(&pipeline.ready_batches);
+    for (size_t i = 0; i < depth; i++) free(batches[i].records);
+    free(batches);
+    free(pending);
+    free(starts);
+    munmap((void*)data, size);
+    
+    report->bytes = size;
+    report->readers = readers;
+    report->seconds = ingest_now() - start;
+    report->records_per_second = report->seconds > 0 ? (double)report->records / report->seconds : 0.0;
+    return ok;
+}
+
+static void print_ingest_stage(const char *name, const IngestStage *stage) {
+    double mean = stage->batches ? stage->total_seconds / (double)stage->batches : 0.0;
+    printf("  %-7s %zu batches, mean %.3f ms, max %.3f ms\n", name, stage->batches, mean * 1e3,
+           stage->max_seconds * 1e3);
+}
+
+void print_ingest_report(const IngestReport *report) {
+    printf("Ingested %zu players (%zu rejected) from %.1f MB in %.3f s: %.0f records/s (readers: %zu)\n",
+           report->records, report->rejected, (double)report->bytes / (1024.0 * 1024.0), report->seconds,
+           report->records_per_second, report->readers);
+    print_ingest_stage("parse", &report->parse);
+    print_ingest_stage("stall", &report->stall);
+    print_ingest_stage("queued", &report->queued);
+    print_ingest_stage("commit", &report->commit);
+}
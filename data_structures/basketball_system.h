@@ -3,17 +3,43 @@
 
 #include "dynarray/dynarray.h"
 #include "hash/hashtable.h"
+#include "hash/flat_hashtable.h"
 #include "hash/hashset.h"
-#include "heap/min_heap.h"
-#include "heap/max_heap.h"
+#include "hash/string_interner.h"
+#include "hash/filter.h"
+#include "heap/indexed_heap.h"
 #include "linkedlist/doubly_linked_list.h"
+#include "tree/avl.h"
 #include "containers/stack.h"
-#include "containers/queue.h"
+#include "containers/concurrent_queue.h"
+#include "columnar/column_filter.h"
+#include "segtree/segtree.h"
+#include "trie/trie.h"
+#include "allocator/arena.h"
+#include "allocator/pool.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+// Maximum number of queued, unprocessed trade requests
+#define TRADE_QUEUE_CAPACITY 1024
+
+// add_players_bulk builds indexes on worker threads from this many players
+#define BASKETBALL_BULK_PARALLEL_MIN 4096
+
+// Target false-positive rate of the name filter in front of player_by_name
+#define BASKETBALL_NAME_FILTER_FP_RATE 0.01
+
+// basketball_system_ingest defaults: feed bytes parsed into one batch
+#define INGEST_CHUNK_BYTES (1 << 20)
+
+// basketball_system_ingest defaults: batches in flight per reader thread
+#define INGEST_BATCHES_PER_READER 2
+
+// On-disk snapshot format revision (bump when records or sections change)
+#define BASKETBALL_SNAPSHOT_VERSION 7
+
 // Player structure
 typedef struct
 {
@@ -62,6 +88,104 @@ typedef struct
     time_t trade_time;
 } TradeTransaction;
 
+// Group indexes listing each player once; PlayerColumns.group_slot holds its slot in each
+enum { PLAYER_GROUP_NATIONALITY, PLAYER_GROUP_POSITION, PLAYER_GROUP_TEAM, PLAYER_GROUP_COUNT };
+
+#define PLAYER_SLOT_NONE UINT32_MAX // Player not in that group's list
+
+// Columnar mirror of the player table: row i describes players.data[i]
+typedef struct
+{
+    int32_t *age;
+    float *height;
+    float *weight;
+    float *skill_rating;
+    uint16_t *nationality; // Interned nationality ids
+    uint16_t *position;    // Interned position ids
+    size_t rows;
+    size_t capacity;
+    uint32_t *row_of_id; // player_id -> row
+    uint32_t (*group_slot)[PLAYER_GROUP_COUNT]; // player_id -> index in each group list
+    size_t id_capacity;
+} PlayerColumns;
+
+// Multi-attribute player filter; player_filter_init makes every field pass
+typedef struct
+{
+    const char *nationality; // NULL = any
+    const char *position;    // NULL = any
+    int min_age, max_age;
+    float min_height, max_height;
+    float min_weight, max_weight;
+    float min_skill, max_skill;
+} PlayerFilter;
+
+// Field ordering get_players_sorted / print_players_sorted (ties go by player id)
+typedef enum
+{
+    PLAYER_SORT_SKILL,
+    PLAYER_SORT_AGE,
+    PLAYER_SORT_HEIGHT,
+    PLAYER_SORT_WEIGHT,
+    PLAYER_SORT_NAME
+} PlayerSortField;
+
+// Skill aggregate over a range of player ids
+typedef struct
+{
+    double sum;   // Sum of skill ratings
+    size_t count; // Players in the range
+    float max;    // Highest rating, -1 if count is 0
+} SkillStats;
+
+#define SKILL_STATS_IDENTITY ((SkillStats){0.0, 0, -1.0f})
+
+static inline SkillStats skill_stats_combine(SkillStats a, SkillStats b) {
+    SkillStats combined = {a.sum + b.sum, a.count + b.count, a.max < b.max ? b.max : a.max};
+    return combined;
+}
+
+DEFINE_SEGTREE(SkillStatsTree, SkillStats, skill_stats_combine, SKILL_STATS_IDENTITY)
+
+// Player feed formats read by basketball_system_ingest
+typedef enum
+{
+    INGEST_FORMAT_CSV,       // name,nationality,position,age,height,weight,jersey_number,skill_rating,team_id
+    INGEST_FORMAT_JSON_LINES // One flat object per line with the same keys
+} IngestFormat;
+
+// Ingest pipeline settings; ingest_options_init fills in the defaults
+typedef struct
+{
+    IngestFormat format;
+    size_t readers;     // Parser threads (0 = one per online CPU)
+    size_t chunk_bytes; // Feed bytes per batch, extended to the next line end
+    size_t queue_depth; // Batches in flight; readers wait when all are taken (0 = 2 per reader)
+} IngestOptions;
+
+// Per-batch latency of one pipeline stage
+typedef struct
+{
+    size_t batches;
+    double total_seconds;
+    double max_seconds;
+} IngestStage;
+
+// Outcome of basketball_system_ingest
+typedef struct
+{
+    size_t records;  // Players committed
+    size_t rejected; // Malformed lines skipped
+    size_t bytes;    // Feed size
+    size_t readers;  // Parser threads used
+    double seconds;  // Wall time from mapping the feed to the last commit
+    double records_per_second;
+    IngestStage parse;  // Reader: chunk -> batch of Player records
+    IngestStage stall;  // Reader: waiting for a free batch (backpressure)
+    IngestStage queued; // Parsed batch waiting for the committer
+    IngestStage commit; // Committer: bulk insert of one batch
+} IngestReport;
+
 // Main basketball management system
 typedef struct
 {
@@ -71,26 +195,52 @@ typedef struct
     DynArray leagues; // All leagues
 
     // Fast lookup indices
-    HashTable player_by_name; // name -> Player*
-    HashTable player_by_id;   // id -> Player*
+    FlatHashTable player_by_name; // name -> Player* (key borrowed from Player)
+    FlatHashTable player_by_id;   // id -> Player*
+    BloomFilter name_filter;      // Names ever added since the last rebuild; rejects most unknown names
+    Trie player_names;            // name -> Player*, prefix search ranked by skill (keys borrowed)
     HashTable team_by_name;   // name -> Team*
     HashTable team_by_id;     // id -> Team*
 
+    // Interned attribute strings: dense ids shared by the groups and columns below
+    StringInterner nationalities;
+    StringInterner positions;
+
     // Specialized indices
-    HashTable players_by_nationality; // nationality -> DynArray of Player*
-    HashTable players_by_position;    // position -> DynArray of Player*
-    HashTable players_by_team;        // team_id -> DynArray of Player*
+    DynArray players_by_nationality; // nationality id -> DynArray of Player*
+    DynArray players_by_position;    // position id -> DynArray of Player*
+    HashTable players_by_team;       // team_id -> DynArray of Player*
 
     // Performance optimized structures
-    MinHeap youngest_players;    // Min heap by age
-    MaxHeap oldest_players;      // Max heap by age
-    MinHeap shortest_players;    // Min heap by height
-    MaxHeap tallest_players;     // Max heap by height
-    MaxHeap top_skilled_players; // Max heap by skill rating
+    // Indexed by player_id so entries follow rating/age changes in O(log n)
+    IndexedHeap youngest_players;    // Min heap by age
+    IndexedHeap oldest_players;      // Max heap by age
+    IndexedHeap shortest_players;    // Min heap by height
+    IndexedHeap tallest_players;     // Max heap by height
+    IndexedHeap top_skilled_players; // Max heap by skill rating
+
+    // Ordered indices for range/rank queries (keys borrowed from Player)
+    AVLOrderTree players_by_age;    // age -> Player*
+    AVLOrderTree players_by_height; // height -> Player*
+    AVLOrderTree players_by_skill;  // skill_rating -> Player*
+
+    // Range aggregates by player_id
+    SkillStatsTree skill_by_id; // player_id -> skill, summed/maxed over id ranges
+
+    // Struct-of-arrays copy of the scanned attributes for vectorized filters
+    PlayerColumns columns;
 
     // Utility structures
     Stack recent_transactions; // Recent player moves
-    Queue trade_requests;      // Pending trades
+    MPMCQueue trade_requests;  // Pending trades (any thread may request)
+    struct ThreadPool *workers; // Shared by parallel bulk work, started on first use (NULL until then)
+
+    // Memory sources (must not move after init)
+    Arena arena;     // Players, teams, leagues, index array headers
+    Pool entry_pool; // HashEntry nodes of the HashTable indices
+    Pool order_pool; // AVLOrderNode nodes of the ordered indices
+    void *snapshot;       // Mapped snapshot holding loaded players/teams/leagues, or NULL
+    size_t snapshot_size; // Length of the mapping
 
     // System counters
     int next_player_id;
@@ -107,9 +257,16 @@ void basketball_system_free(BasketballSystem *system);
 void add_player(BasketballSystem *system, const char *name, const char *nationality,
                 const char *position, int age, float height, float weight,
                 int jersey_number, float skill_rating, int team_id);
+bool add_players_bulk(BasketballSystem *system, const Player *records, size_t count);
 Player *find_player_by_name(BasketballSystem *system, const char *name);
 Player *find_player_by_id(BasketballSystem *system, int id);
+size_t find_players_by_name_prefix(BasketballSystem *system, const char *prefix, Player **players,
+                                   size_t max_count);
+size_t get_top_players_by_name_prefix(BasketballSystem *system, const char *prefix, size_t k,
+                                      Player **players);
 void remove_player(BasketballSystem *system, int player_id);
+bool update_player_skill(BasketballSystem *system, int player_id, float skill_rating);
+bool update_player_age(BasketballSystem *system, int player_id, int age);
 
 // Team operations
 void add_team(BasketballSystem *system, const char *name, const char *city, int league_id);
@@ -137,10 +294,20 @@ void find_elite_players_by_nationality_and_position(BasketballSystem *system,
                                                     float min_skill);
 void find_players_in_age_range(BasketballSystem *system, int min_age, int max_age);
 void find_players_in_height_range(BasketballSystem *system, float min_height, float max_height);
+void find_players_in_skill_range(BasketballSystem *system, float min_skill, float max_skill);
+size_t count_players_in_age_range(BasketballSystem *system, int min_age, int max_age);
+
+// Columnar filters (rows index system->players; rows array needs room for every player)
+void player_filter_init(PlayerFilter *filter);
+size_t select_players(BasketballSystem *system, const PlayerFilter *filter, uint32_t *rows);
+size_t count_players_matching(BasketballSystem *system, const PlayerFilter *filter);
+Player *get_player_by_skill_rank(BasketballSystem *system, size_t rank);
+SkillStats get_skill_stats_in_id_range(BasketballSystem *system, int first_id, int last_id);
 
 // Trade system
 void request_trade(BasketballSystem *system, int from_team, int to_team, int player_id);
 void process_next_trade(BasketballSystem *system);
+size_t process_all_trades(BasketballSystem *system);
 void undo_last_trade(BasketballSystem *system);
 void show_pending_trades(BasketballSystem *system);
 void show_recent_transactions(BasketballSystem *system);
@@ -151,6 +318,20 @@ void print_team_info(BasketballSystem *system, const Team *team);
 void print_league_info(BasketballSystem *system, const League *league);
 void print_system_statistics(BasketballSystem *system);
 void print_top_players_by_skill(BasketballSystem *system, int count);
+void print_top_players_by_age(BasketballSystem *system, int count, bool youngest_first);
+void print_top_players_by_height(BasketballSystem *system, int count, bool tallest_first);
+size_t get_players_sorted(BasketballSystem *system, PlayerSortField field, bool descending, DynArray *out);
+void print_players_sorted(BasketballSystem *system, PlayerSortField field, bool descending, int count);
+
+// Snapshot persistence (same-architecture binary image of players and indexes)
+bool basketball_system_save(BasketballSystem *system, const char *path);
+bool basketball_system_load_mmap(BasketballSystem *system, const char *path);
+
+// Streaming ingest (readers parse a mapped feed, one committer bulk-inserts in file order)
+void ingest_options_init(IngestOptions *options);
+bool basketball_system_ingest(BasketballSystem *system, const char *path, const IngestOptions *options,
+                              IngestReport *report);
+void print_ingest_report(const IngestReport *report);
 
 // Utility functions
 Player *create_player(int id, const char *name, const char *nationality, const char *position,
@@ -158,5 +339,13 @@ Player *create_player(int id, const char *name, const char *nationality, const c
                       float skill_rating, int team_id);
 Team *create_team(int id, const char *name, const char *city, int league_id);
 League *create_league(int id, const char *name, const char *country, int season_year);
+Player *create_player_with(const Allocator *allocator, int id, const char *name,
+                           const char *nationality, const char *position,
+                           int age, float height, float weight, int jersey_number,
+                           float skill_rating, int team_id);
+Team *create_team_with(const Allocator *allocator, int id, const char *name, const char *city,
+                       int league_id);
+League *create_league_with(const Allocator *allocator, int id, const char *name,
+                           const char *country, int season_year);
 
 #endif // BASKETBALL_SYSTEM_H
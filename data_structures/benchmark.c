@@ -0,0 +1,2674 @@
+// Benchmark suite for the data structure headers and BasketballSystem queries.
+//
+// Every case is run at each requested scale: one untimed setup, warmup
+// repetitions, then timed repetitions split into batches. Each batch gives one
+// ns/op sample; min/median/p99/mean are taken over all samples. Allocations
+// are counted by wrapping malloc/calloc/realloc/aligned_alloc at link time
+// (see the bench target in the Makefile). Results are written as JSON, one
+// result per line, so two runs can be diffed or compared with --baseline.
+//
+// Usage: ./benchmark [--scales 10000,1000000] [--reps N] [--warmup N]
+//                    [--filter substring] [--output file.json]
+//                    [--baseline old.json] [--threshold percent]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "dynarray/dynarray.h"
+#include "dynarray/dynarray_sort.h"
+#include "linkedlist/singly_linked_list.h"
+#include "linkedlist/doubly_linked_list.h"
+#include "linkedlist/circular_linked_list.h"
+#include "containers/stack.h"
+#include "containers/queue.h"
+#include "containers/deque.h"
+#include "heap/min_heap.h"
+#include "heap/max_heap.h"
+#include "heap/indexed_heap.h"
+#include "heap/dary_heap.h"
+#include "hash/hashtable.h"
+#include "hash/hashset.h"
+#include "hash/flat_hashtable.h"
+#include "hash/concurrent_hashtable.h"
+#include "hash/filter.h"
+#include "bitset/bitset.h"
+#include "bitset/roaring.h"
+#include "tree/avl.h"
+#include "tree/btree.h"
+#include "trie/trie.h"
+#include "graph/graph.h"
+#include "graph/csr_graph.h"
+#include "graph/parallel_graph.h"
+#include "unionfind/unionfind.h"
+#include "sequence/lis.h"
+#include "segtree/segtree.h"
+#include "poly/polynomial.h"
+#include "columnar/column_filter.h"
+#include "basketball_system.h"
+
+// Configuration constants
+#define BENCH_DEFAULT_REPETITIONS 5
+#define BENCH_DEFAULT_WARMUP 1
+#define BENCH_DEFAULT_THRESHOLD 10.0 // Median slowdown (%) reported as a regression
+#define BENCH_BATCHES 100            // Timed samples per repetition
+#define BENCH_MAX_SCALES 8
+#define BENCH_LOOKUP_NAMES 65536     // Player names kept for find_player_by_name
+#define BENCH_PLAYER_CHUNK 65536     // Players generated per add_players_bulk call
+#define BENCH_GRAPH_DEGREE 4         // Random edges per vertex in graph cases
+
+// ==================== ALLOCATION COUNTING ====================
+
+#ifdef BENCH_COUNT_ALLOCATIONS
+// Linked with -Wl,--wrap=<fn>: calls to fn land in __wrap_fn, the original is __real_fn
+static atomic_size_t bench_allocations;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void *__real_aligned_alloc(size_t alignment, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    atomic_fetch_add_explicit(&bench_allocations, 1, memory_order_relaxed);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    atomic_fetch_add_explicit(&bench_allocations, 1, memory_order_relaxed);
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    atomic_fetch_add_explicit(&bench_allocations, 1, memory_order_relaxed);
+    return __real_realloc(ptr, size);
+}
+
+void *__wrap_aligned_alloc(size_t alignment, size_t size) {
+    atomic_fetch_add_explicit(&bench_allocations, 1, memory_order_relaxed);
+    return __real_aligned_alloc(alignment, size);
+}
+
+#define BENCH_ALLOCATIONS() atomic_load_explicit(&bench_allocations, memory_order_relaxed)
+#define BENCH_COUNTING true
+#else
+#define BENCH_ALLOCATIONS() ((size_t)0)
+#define BENCH_COUNTING false
+#endif
+
+// ==================== HARNESS ====================
+
+// One benchmarked operation; run performs operations [begin, end) on the state
+typedef struct {
+    const char *name;                                   // "structure/operation"
+    void *(*setup)(size_t size);                        // Untimed: build state for a scale
+    void (*run)(void *state, size_t begin, size_t end); // Timed
+    void (*reset)(void *state);                         // Untimed: restore state between repetitions (NULL = none)
+    void (*teardown)(void *state);
+    size_t max_ops;    // Operations per repetition (0 = scale)
+    size_t max_size;   // Largest scale to run at (0 = any)
+    bool single_batch; // Time a whole repetition as one sample
+} BenchCase;
+
+// Timing summary of one case at one scale
+typedef struct {
+    const char *name;
+    size_t size;
+    size_t ops;     // Operations per repetition
+    size_t samples; // Timed batches
+    double min_ns, median_ns, p99_ns, mean_ns;
+    double allocs_per_op;
+} BenchResult;
+
+// Command-line options
+typedef struct {
+    size_t scales[BENCH_MAX_SCALES];
+    size_t scale_count;
+    int repetitions;
+    int warmup;
+    const char *filter;
+    const char *output;
+    const char *baseline;
+    double threshold;
+} BenchOptions;
+
+static volatile uintptr_t bench_sink; // Keeps query results observable
+static int bench_saved_stdout = -1;
+
+// Monotonic clock in nanoseconds
+static double bench_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+// Silence stdout while a case runs (the system API reports progress with printf)
+static void bench_quiet(bool quiet) {
+    fflush(stdout);
+    if (quiet) {
+        int null_fd = open("/dev/null", O_WRONLY);
+        bench_saved_stdout = dup(STDOUT_FILENO);
+        if (null_fd < 0 || bench_saved_stdout < 0) {
+            fprintf(stderr, "bench_quiet: cannot redirect stdout\n");
+            exit(EXIT_FAILURE);
+        }
+        dup2(null_fd, STDOUT_FILENO);
+        close(null_fd);
+    } else if (bench_saved_stdout >= 0) {
+        dup2(bench_saved_stdout, STDOUT_FILENO);
+        close(bench_saved_stdout);
+        bench_saved_stdout = -1;
+    }
+}
+
+static int bench_compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted samples
+static double bench_percentile(const double *sorted, size_t count, double percent) {
+    size_t rank = (size_t)(percent / 100.0 * (double)count + 0.999999);
+    if (rank == 0) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1];
+}
+
+// Run one case at one scale
+static void bench_run_case(const BenchCase *bench, size_t size, const BenchOptions *options, BenchResult *result) {
+    size_t ops = (bench->max_ops && bench->max_ops < size) ? bench->max_ops : size;
+    size_t batches = bench->single_batch ? 1 : (ops < BENCH_BATCHES ? ops : BENCH_BATCHES);
+    double *samples = (double *)malloc((size_t)options->repetitions * batches * sizeof(double));
+    if (!samples) {
+        fprintf(stderr, "bench_run_case: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t sample_count = 0;
+    size_t allocations = 0;
+    double total_ns = 0.0;
+
+    bench_quiet(true);
+    void *state = bench->setup(size);
+    for (int rep = -options->warmup; rep < options->repetitions; rep++) {
+        for (size_t batch = 0; batch < batches; batch++) {
+            size_t begin = ops * batch / batches;
+            size_t end = ops * (batch + 1) / batches;
+            size_t allocated = BENCH_ALLOCATIONS();
+            double start = bench_now_ns();
+            bench->run(state, begin, end);
+            double elapsed = bench_now_ns() - start;
+            allocated = BENCH_ALLOCATIONS() - allocated;
+            if (rep >= 0) {
+                samples[sample_count++] = elapsed / (double)(end - begin);
+                total_ns += elapsed;
+                allocations += allocated;
+            }
+        }
+        if (bench->reset && rep + 1 < options->repetitions) bench->reset(state);
+    }
+    bench->teardown(state);
+    bench_quiet(false);
+
+    qsort(samples, sample_count, sizeof(double), bench_compare_double);
+    size_t total_ops = ops * (size_t)options->repetitions;
+    result->name = bench->name;
+    result->size = size;
+    result->ops = ops;
+    result->samples = sample_count;
+    result->min_ns = samples[0];
+    result->median_ns = bench_percentile(samples, sample_count, 50.0);
+    result->p99_ns = bench_percentile(samples, sample_count, 99.0);
+    result->mean_ns = total_ns / (double)total_ops;
+    result->allocs_per_op = (double)allocations / (double)total_ops;
+    free(samples);
+}
+
+// ==================== SHARED INPUTS ====================
+
+// Deterministic key for index i in [0, 1e9+7), spread over the range
+static int bench_key(size_t i) {
+    return (int)(((uint64_t)i * 2654435761u) % 1000000007u);
+}
+
+// Pseudo-random index in [0, n) for operation i
+static size_t bench_index(size_t i, size_t n) {
+    return (size_t)((i * 2654435761ull + 12345u) % n);
+}
+
+DEFINE_BTREE(BenchBTree, int, int, BTREE_CMP)
+DEFINE_SORT(BenchIntSort, int, SORT_CMP)
+
+// State shared by the container cases
+typedef struct {
+    size_t size;
+    int *keys; // bench_key(0..size-1)
+    union {
+        DynArray dynarray;
+        struct {
+            DynArray items;
+            ThreadPool pool;
+        } sort;
+        Stack stack;
+        Queue queue;
+        Deque deque;
+        SinglyLinkedList singly;
+        DoublyLinkedList doubly;
+        CircularLinkedList circular;
+        HashTable hashtable;
+        FlatHashTable flat;
+        HashSet hashset;
+        BitSet bitset;
+        RoaringSet roaring;
+        MinHeap min_heap;
+        MaxHeap max_heap;
+        DaryHeap dary_heap;
+        IndexedHeap indexed_heap;
+        AVLTree avl;
+        AVLOrderTree avl_order;
+        Tree tree;
+        StaticTree static_tree;
+        BenchBTree btree;
+        UnionFind unionfind;
+        G graph;
+        LISState lis;
+        size_t *positions; // lis_compute reconstruction output
+        int *ints;         // Unboxed copy of keys for the int sort cases
+    } as;
+} BenchState;
+
+static BenchState *bench_state_new(size_t size) {
+    BenchState *state = (BenchState *)calloc(1, sizeof(BenchState));
+    if (!state || !(state->keys = (int *)malloc(size * sizeof(int)))) {
+        fprintf(stderr, "bench_state_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    state->size = size;
+    for (size_t i = 0; i < size; i++) state->keys[i] = bench_key(i);
+    return state;
+}
+
+static void bench_state_free(BenchState *state) {
+    free(state->keys);
+    free(state);
+}
+
+// ==================== DYNAMIC ARRAY ====================
+
+static void dynarray_bench_fill(BenchState *s) {
+    dynarray_init(&s->as.dynarray, 0);
+    for (size_t i = 0; i < s->size; i++) dynarray_push(&s->as.dynarray, &s->keys[i]);
+}
+static void *dynarray_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    dynarray_init(&s->as.dynarray, 0);
+    return s;
+}
+static void *dynarray_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    dynarray_bench_fill(s);
+    return s;
+}
+static void dynarray_bench_push(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) dynarray_push(&s->as.dynarray, &s->keys[i]);
+}
+static void dynarray_bench_get(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)dynarray_get(&s->as.dynarray, bench_index(i, s->size));
+}
+static void dynarray_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    dynarray_free(&s->as.dynarray);
+    dynarray_init(&s->as.dynarray, 0);
+}
+static void dynarray_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    dynarray_free(&s->as.dynarray);
+    bench_state_free(s);
+}
+
+// Sorts reorder pointers to bench_key values; reset restores the unsorted order
+static int sort_bench_compare(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+static int sort_bench_compare_slots(const void *a, const void *b) {
+    return sort_bench_compare(*(void *const *)a, *(void *const *)b);
+}
+static uint64_t sort_bench_key(const void *element, const void *ctx) {
+    (void)ctx;
+    return sort_key_from_int(*(const int *)element);
+}
+static void sort_bench_reset(void *state) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = 0; i < s->size; i++) s->as.sort.items.data[i] = &s->keys[i];
+}
+static void *sort_bench_new(size_t size) {
+    BenchState *s = bench_state_new(size);
+    dynarray_init(&s->as.sort.items, size);
+    s->as.sort.items.size = size;
+    sort_bench_reset(s);
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    thread_pool_init(&s->as.sort.pool, cpus > 1 ? (size_t)cpus : 1);
+    return s;
+}
+static void sort_bench_qsort(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    (void)begin;
+    (void)end;
+    qsort(s->as.sort.items.data, s->as.sort.items.size, sizeof(void *), sort_bench_compare_slots);
+}
+static void sort_bench_sort(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    (void)begin;
+    (void)end;
+    dynarray_sort(&s->as.sort.items, sort_bench_compare);
+}
+static void sort_bench_stable(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    (void)begin;
+    (void)end;
+    dynarray_sort_stable(&s->as.sort.items, sort_bench_compare);
+}
+static void sort_bench_by_key(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    (void)begin;
+    (void)end;
+    dynarray_sort_by_key(&s->as.sort.items, sort_bench_key, NULL);
+}
+static void sort_bench_parallel(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    (void)begin;
+    (void)end;
+    dynarray_sort_parallel(&s->as.sort.items, sort_bench_compare, &s->as.sort.pool);
+}
+static void sort_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    thread_pool_free(&s->as.sort.pool);
+    dynarray_free(&s->as.sort.items);
+    bench_state_free(s);
+}
+
+// Sorting the keys stored inline: libc qsort vs introsort with the comparison inlined
+static void int_sort_bench_reset(void *state) {
+    BenchState *s = (BenchState *)state;
+    memcpy(s->as.ints, s->keys, s->size * sizeof(int));
+}
+static void *int_sort_bench_new(size_t size) {
+    BenchState *s = bench_state_new(size);
+    s->as.ints = (int *)malloc(size * sizeof(int));
+    if (!s->as.ints) {
+        fprintf(stderr, "int_sort_bench_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    int_sort_bench_reset(s);
+    return s;
+}
+static void int_sort_bench_qsort(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    (void)begin;
+    (void)end;
+    qsort(s->as.ints, s->size, sizeof(int), sort_bench_compare);
+}
+static void int_sort_bench_sort(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    (void)begin;
+    (void)end;
+    BenchIntSort_sort(s->as.ints, s->size);
+}
+static void int_sort_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    free(s->as.ints);
+    bench_state_free(s);
+}
+
+// ==================== STACK / QUEUE / DEQUE ====================
+
+static void stack_bench_fill(BenchState *s) {
+    stack_init(&s->as.stack);
+    for (size_t i = 0; i < s->size; i++) stack_push(&s->as.stack, &s->keys[i]);
+}
+static void *stack_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    stack_init(&s->as.stack);
+    return s;
+}
+static void *stack_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    stack_bench_fill(s);
+    return s;
+}
+static void stack_bench_push(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) stack_push(&s->as.stack, &s->keys[i]);
+}
+static void stack_bench_pop(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)stack_pop(&s->as.stack);
+}
+static void stack_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    stack_free(&s->as.stack);
+    stack_init(&s->as.stack);
+}
+static void stack_bench_refill(void *state) {
+    BenchState *s = (BenchState *)state;
+    stack_free(&s->as.stack);
+    stack_bench_fill(s);
+}
+static void stack_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    stack_free(&s->as.stack);
+    bench_state_free(s);
+}
+
+static void queue_bench_fill(BenchState *s) {
+    queue_init(&s->as.queue);
+    for (size_t i = 0; i < s->size; i++) queue_enqueue(&s->as.queue, &s->keys[i]);
+}
+static void *queue_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    queue_init(&s->as.queue);
+    return s;
+}
+static void *queue_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    queue_bench_fill(s);
+    return s;
+}
+static void queue_bench_enqueue(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) queue_enqueue(&s->as.queue, &s->keys[i]);
+}
+static void queue_bench_dequeue(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)queue_dequeue(&s->as.queue);
+}
+static void queue_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    queue_free(&s->as.queue);
+    queue_init(&s->as.queue);
+}
+static void queue_bench_refill(void *state) {
+    BenchState *s = (BenchState *)state;
+    queue_free(&s->as.queue);
+    queue_bench_fill(s);
+}
+static void queue_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    queue_free(&s->as.queue);
+    bench_state_free(s);
+}
+
+static void deque_bench_fill(BenchState *s) {
+    deque_init(&s->as.deque);
+    for (size_t i = 0; i < s->size; i++) deque_push_back(&s->as.deque, &s->keys[i]);
+}
+static void *deque_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    deque_init(&s->as.deque);
+    return s;
+}
+static void *deque_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    deque_bench_fill(s);
+    return s;
+}
+static void deque_bench_push_back(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) deque_push_back(&s->as.deque, &s->keys[i]);
+}
+static void deque_bench_push_front(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) deque_push_front(&s->as.deque, &s->keys[i]);
+}
+static void deque_bench_pop_front(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)deque_pop_front(&s->as.deque);
+}
+static void deque_bench_get_at(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)deque_get_at(&s->as.deque, bench_index(i, s->size));
+}
+static void deque_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    deque_free(&s->as.deque);
+    deque_init(&s->as.deque);
+}
+static void deque_bench_refill(void *state) {
+    BenchState *s = (BenchState *)state;
+    deque_free(&s->as.deque);
+    deque_bench_fill(s);
+}
+static void deque_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    deque_free(&s->as.deque);
+    bench_state_free(s);
+}
+
+// ==================== LINKED LISTS ====================
+
+static void singly_bench_fill(BenchState *s) {
+    singly_init(&s->as.singly);
+    for (size_t i = 0; i < s->size; i++) singly_push_front(&s->as.singly, &s->keys[i]);
+}
+static void *singly_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    singly_init(&s->as.singly);
+    return s;
+}
+static void *singly_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    singly_bench_fill(s);
+    return s;
+}
+static void singly_bench_push_front(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) singly_push_front(&s->as.singly, &s->keys[i]);
+}
+static void singly_bench_pop_front(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)singly_pop_front(&s->as.singly);
+}
+static void singly_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    singly_free(&s->as.singly);
+    singly_init(&s->as.singly);
+}
+static void singly_bench_refill(void *state) {
+    BenchState *s = (BenchState *)state;
+    singly_free(&s->as.singly);
+    singly_bench_fill(s);
+}
+static void singly_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    singly_free(&s->as.singly);
+    bench_state_free(s);
+}
+
+static void doubly_bench_fill(BenchState *s) {
+    doubly_init(&s->as.doubly);
+    for (size_t i = 0; i < s->size; i++) doubly_push_back(&s->as.doubly, &s->keys[i]);
+}
+static void *doubly_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    doubly_init(&s->as.doubly);
+    return s;
+}
+static void *doubly_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    doubly_bench_fill(s);
+    return s;
+}
+static void doubly_bench_push_back(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) doubly_push_back(&s->as.doubly, &s->keys[i]);
+}
+static void doubly_bench_pop_front(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)doubly_pop_front(&s->as.doubly);
+}
+static void doubly_bench_get_at(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)doubly_get_at(&s->as.doubly, bench_index(i, s->size));
+}
+static void doubly_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    doubly_free(&s->as.doubly);
+    doubly_init(&s->as.doubly);
+}
+static void doubly_bench_refill(void *state) {
+    BenchState *s = (BenchState *)state;
+    doubly_free(&s->as.doubly);
+    doubly_bench_fill(s);
+}
+static void doubly_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    doubly_free(&s->as.doubly);
+    bench_state_free(s);
+}
+
+static void circular_bench_fill(BenchState *s) {
+    circular_init(&s->as.circular);
+    for (size_t i = 0; i < s->size; i++) circular_push_back(&s->as.circular, &s->keys[i]);
+}
+static void *circular_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    circular_init(&s->as.circular);
+    return s;
+}
+static void *circular_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    circular_bench_fill(s);
+    return s;
+}
+static void circular_bench_push_back(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) circular_push_back(&s->as.circular, &s->keys[i]);
+}
+static void circular_bench_pop_front(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)circular_pop_front(&s->as.circular);
+}
+static void circular_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    circular_free(&s->as.circular);
+    circular_init(&s->as.circular);
+}
+static void circular_bench_refill(void *state) {
+    BenchState *s = (BenchState *)state;
+    circular_free(&s->as.circular);
+    circular_bench_fill(s);
+}
+static void circular_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    circular_free(&s->as.circular);
+    bench_state_free(s);
+}
+
+// ==================== HASH STRUCTURES ====================
+
+static void hashtable_bench_fill(BenchState *s) {
+    hashtable_init_int(&s->as.hashtable);
+    for (size_t i = 0; i < s->size; i++) hashtable_put(&s->as.hashtable, &s->keys[i], &s->keys[i]);
+}
+static void *hashtable_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    hashtable_init_int(&s->as.hashtable);
+    return s;
+}
+static void *hashtable_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    hashtable_bench_fill(s);
+    return s;
+}
+static void hashtable_bench_put(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) hashtable_put(&s->as.hashtable, &s->keys[i], &s->keys[i]);
+}
+static void hashtable_bench_get(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += (uintptr_t)hashtable_get(&s->as.hashtable, &s->keys[bench_index(i, s->size)]);
+    }
+}
+static void hashtable_bench_remove(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += hashtable_remove(&s->as.hashtable, &s->keys[i]);
+}
+static void hashtable_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    hashtable_free(&s->as.hashtable);
+    hashtable_init_int(&s->as.hashtable);
+}
+static void hashtable_bench_refill(void *state) {
+    BenchState *s = (BenchState *)state;
+    hashtable_free(&s->as.hashtable);
+    hashtable_bench_fill(s);
+}
+static void hashtable_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    hashtable_free(&s->as.hashtable);
+    bench_state_free(s);
+}
+
+static void *flat_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    flat_hashtable_init_int(&s->as.flat);
+    return s;
+}
+static void *flat_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    flat_hashtable_init_int(&s->as.flat);
+    for (size_t i = 0; i < size; i++) flat_hashtable_put(&s->as.flat, &s->keys[i], &s->keys[i]);
+    return s;
+}
+static void flat_bench_put(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) flat_hashtable_put(&s->as.flat, &s->keys[i], &s->keys[i]);
+}
+static void flat_bench_get(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += (uintptr_t)flat_hashtable_get(&s->as.flat, &s->keys[bench_index(i, s->size)]);
+    }
+}
+static void flat_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    flat_hashtable_free(&s->as.flat);
+    flat_hashtable_init_int(&s->as.flat);
+}
+static void flat_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    flat_hashtable_free(&s->as.flat);
+    bench_state_free(s);
+}
+
+static void *hashset_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    hashset_init_int(&s->as.hashset);
+    return s;
+}
+static void *hashset_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    hashset_init_int(&s->as.hashset);
+    for (size_t i = 0; i < size; i++) hashset_add_int(&s->as.hashset, s->keys[i]);
+    return s;
+}
+static void hashset_bench_add(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) hashset_add_int(&s->as.hashset, s->keys[i]);
+}
+static void hashset_bench_contains(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += hashset_contains_int(&s->as.hashset, s->keys[bench_index(i, s->size)]);
+    }
+}
+static void hashset_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    hashset_free(&s->as.hashset);
+    hashset_init_int(&s->as.hashset);
+}
+static void hashset_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    hashset_free(&s->as.hashset);
+    bench_state_free(s);
+}
+
+// Integer sets hold dense ids 0..size-1, the workload they are meant for
+static void *bitset_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    bitset_init(&s->as.bitset, 0);
+    return s;
+}
+static void *bitset_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    bitset_init(&s->as.bitset, size);
+    for (size_t i = 0; i < size; i++) bitset_add(&s->as.bitset, (uint32_t)i);
+    return s;
+}
+static void bitset_bench_add(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bitset_add(&s->as.bitset, (uint32_t)bench_index(i, s->size));
+}
+static void bitset_bench_contains(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += bitset_contains(&s->as.bitset, (uint32_t)bench_index(i, s->size));
+}
+static void bitset_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    bitset_free(&s->as.bitset);
+    bitset_init(&s->as.bitset, 0);
+}
+static void bitset_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    bitset_free(&s->as.bitset);
+    bench_state_free(s);
+}
+
+static void *roaring_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    roaring_init(&s->as.roaring);
+    return s;
+}
+static void *roaring_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    roaring_init(&s->as.roaring);
+    for (size_t i = 0; i < size; i++) roaring_add(&s->as.roaring, (uint32_t)i);
+    return s;
+}
+static void roaring_bench_add(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) roaring_add(&s->as.roaring, (uint32_t)bench_index(i, s->size));
+}
+static void roaring_bench_contains(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += roaring_contains(&s->as.roaring, (uint32_t)bench_index(i, s->size));
+}
+static void roaring_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    roaring_clear(&s->as.roaring);
+}
+static void roaring_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    roaring_free(&s->as.roaring);
+    bench_state_free(s);
+}
+
+// Two overlapping id sets drawn from [0, 2 * size) in every representation
+typedef struct {
+    HashSet hash_a, hash_b, hash_out;
+    BitSet bits_a, bits_b, bits_out;
+    RoaringSet roar_a, roar_b, roar_out;
+} SetAlgebraBenchState;
+
+static void *set_algebra_bench_new(size_t size) {
+    SetAlgebraBenchState *s = (SetAlgebraBenchState *)malloc(sizeof(SetAlgebraBenchState));
+    if (!s) {
+        fprintf(stderr, "set_algebra_bench_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    hashset_init_int(&s->hash_a);
+    hashset_init_int(&s->hash_b);
+    hashset_init_int(&s->hash_out);
+    bitset_init(&s->bits_a, 0);
+    bitset_init(&s->bits_b, 0);
+    bitset_init(&s->bits_out, 0);
+    roaring_init(&s->roar_a);
+    roaring_init(&s->roar_b);
+    roaring_init(&s->roar_out);
+    for (size_t id = 0; id < 2 * size; id++) {
+        unsigned mix = (unsigned)id * 2654435761u;
+        if (mix >> 31) {
+            hashset_add_int(&s->hash_a, (int)id);
+            bitset_add_int(&s->bits_a, (int)id);
+            roaring_add_int(&s->roar_a, (int)id);
+        }
+        if ((mix >> 30) & 1) {
+            hashset_add_int(&s->hash_b, (int)id);
+            bitset_add_int(&s->bits_b, (int)id);
+            roaring_add_int(&s->roar_b, (int)id);
+        }
+    }
+    return s;
+}
+// Each set operation below is timed per id of the universe
+static void set_algebra_bench_hash_and(void *state, size_t begin, size_t end) {
+    SetAlgebraBenchState *s = (SetAlgebraBenchState *)state;
+    (void)begin;
+    (void)end;
+    hashset_intersection(&s->hash_a, &s->hash_b, &s->hash_out);
+}
+static void set_algebra_bench_hash_or(void *state, size_t begin, size_t end) {
+    SetAlgebraBenchState *s = (SetAlgebraBenchState *)state;
+    (void)begin;
+    (void)end;
+    hashset_union(&s->hash_a, &s->hash_b, &s->hash_out);
+}
+static void set_algebra_bench_bits_and(void *state, size_t begin, size_t end) {
+    SetAlgebraBenchState *s = (SetAlgebraBenchState *)state;
+    (void)begin;
+    (void)end;
+    bitset_intersection(&s->bits_a, &s->bits_b, &s->bits_out);
+}
+static void set_algebra_bench_bits_or(void *state, size_t begin, size_t end) {
+    SetAlgebraBenchState *s = (SetAlgebraBenchState *)state;
+    (void)begin;
+    (void)end;
+    bitset_union(&s->bits_a, &s->bits_b, &s->bits_out);
+}
+static void set_algebra_bench_roar_and(void *state, size_t begin, size_t end) {
+    SetAlgebraBenchState *s = (SetAlgebraBenchState *)state;
+    (void)begin;
+    (void)end;
+    roaring_intersection(&s->roar_a, &s->roar_b, &s->roar_out);
+}
+static void set_algebra_bench_roar_or(void *state, size_t begin, size_t end) {
+    SetAlgebraBenchState *s = (SetAlgebraBenchState *)state;
+    (void)begin;
+    (void)end;
+    roaring_union(&s->roar_a, &s->roar_b, &s->roar_out);
+}
+static void set_algebra_bench_reset(void *state) {
+    SetAlgebraBenchState *s = (SetAlgebraBenchState *)state;
+    hashset_clear(&s->hash_out);
+    bitset_clear(&s->bits_out);
+    roaring_clear(&s->roar_out);
+}
+static void set_algebra_bench_free(void *state) {
+    SetAlgebraBenchState *s = (SetAlgebraBenchState *)state;
+    hashset_free(&s->hash_a);
+    hashset_free(&s->hash_b);
+    hashset_free(&s->hash_out);
+    bitset_free(&s->bits_a);
+    bitset_free(&s->bits_b);
+    bitset_free(&s->bits_out);
+    roaring_free(&s->roar_a);
+    roaring_free(&s->roar_b);
+    roaring_free(&s->roar_out);
+    free(s);
+}
+
+// String sets holding "player<i>", probed with "absent<i>" keys that all miss
+typedef struct {
+    size_t size;
+    char (*present)[32];
+    char (*absent)[32];
+    HashSet plain;
+    FilteredHashSet filtered; // Cuckoo filter in front of a HashSet
+    FlatHashTable flat;
+    BloomFilter bloom; // Over the flat table's hashes
+} FilterBenchState;
+
+static void *filter_bench_new(size_t size) {
+    FilterBenchState *s = (FilterBenchState *)malloc(sizeof(FilterBenchState));
+    if (!s || !(s->present = malloc(size * sizeof(*s->present))) || !(s->absent = malloc(size * sizeof(*s->absent)))) {
+        fprintf(stderr, "filter_bench_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    s->size = size;
+    hashset_init_string(&s->plain);
+    filtered_hashset_init_string(&s->filtered, 0.01);
+    flat_hashtable_init_string(&s->flat);
+    bloom_filter_init(&s->bloom, size, 0.01);
+    for (size_t i = 0; i < size; i++) {
+        snprintf(s->present[i], sizeof(s->present[i]), "player%zu", i);
+        snprintf(s->absent[i], sizeof(s->absent[i]), "absent%zu", bench_index(i, size));
+        hashset_add(&s->plain, s->present[i]);
+        filtered_hashset_add(&s->filtered, s->present[i]);
+        flat_hashtable_put(&s->flat, s->present[i], HASHSET_DUMMY_VALUE);
+        bloom_filter_add_hash(&s->bloom, flat_hashtable_hash(&s->flat, s->present[i]));
+    }
+    return s;
+}
+static void filter_bench_hashset_miss(void *state, size_t begin, size_t end) {
+    FilterBenchState *s = (FilterBenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += hashset_contains(&s->plain, s->absent[i]);
+}
+static void filter_bench_cuckoo_miss(void *state, size_t begin, size_t end) {
+    FilterBenchState *s = (FilterBenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += filtered_hashset_contains(&s->filtered, s->absent[i]);
+}
+static void filter_bench_flat_miss(void *state, size_t begin, size_t end) {
+    FilterBenchState *s = (FilterBenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)flat_hashtable_get(&s->flat, s->absent[i]);
+}
+// Hash once, ask the Bloom filter, only probe the table on a maybe
+static void filter_bench_bloom_miss(void *state, size_t begin, size_t end) {
+    FilterBenchState *s = (FilterBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        uint64_t hash = flat_hashtable_hash(&s->flat, s->absent[i]);
+        if (bloom_filter_may_contain_hash(&s->bloom, hash)) {
+            bench_sink += (uintptr_t)flat_hashtable_get_with_hash(&s->flat, s->absent[i], hash);
+        }
+    }
+}
+static void filter_bench_free(void *state) {
+    FilterBenchState *s = (FilterBenchState *)state;
+    hashset_free(&s->plain);
+    filtered_hashset_free(&s->filtered);
+    flat_hashtable_free(&s->flat);
+    bloom_filter_free(&s->bloom);
+    free(s->present);
+    free(s->absent);
+    free(s);
+}
+
+// Sharded table holding keys [0, size); each op is a get, every tenth a put
+typedef struct {
+    ConcurrentHashTable table;
+    int *values;
+    size_t size;
+} CHTBenchState;
+
+// One thread's share of a batch
+typedef struct {
+    CHTBenchState *state;
+    size_t begin, end;
+    uintptr_t found; // Hits, summed into bench_sink after join
+} CHTBenchWorker;
+
+static void *cht_bench_new(size_t size, size_t shards, ConcurrentHashTableMode mode) {
+    CHTBenchState *s = (CHTBenchState *)malloc(sizeof(CHTBenchState));
+    if (!s || !(s->values = (int *)malloc(size * sizeof(int)))) {
+        fprintf(stderr, "cht_bench_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    s->size = size;
+    concurrent_hashtable_init(&s->table, shards, 256, &INT_HASH_FUNC, mode);
+    for (size_t i = 0; i < size; i++) {
+        int key = (int)i;
+        s->values[i] = key;
+        concurrent_hashtable_put(&s->table, &key, &s->values[i]);
+    }
+    return s;
+}
+static void *cht_bench_rwlock_one_shard(size_t size) {
+    return cht_bench_new(size, 1, CONCURRENT_HASHTABLE_RWLOCK);
+}
+static void *cht_bench_rwlock(size_t size) {
+    return cht_bench_new(size, CONCURRENT_HASHTABLE_DEFAULT_SHARDS, CONCURRENT_HASHTABLE_RWLOCK);
+}
+static void *cht_bench_seqlock(size_t size) {
+    return cht_bench_new(size, CONCURRENT_HASHTABLE_DEFAULT_SHARDS, CONCURRENT_HASHTABLE_SEQLOCK);
+}
+static void *cht_bench_worker(void *arg) {
+    CHTBenchWorker *w = (CHTBenchWorker *)arg;
+    for (size_t i = w->begin; i < w->end; i++) {
+        int key = (int)bench_index(i, w->state->size);
+        if (i % 10 == 0) {
+            concurrent_hashtable_put(&w->state->table, &key, &w->state->values[key]);
+        } else {
+            w->found += concurrent_hashtable_get(&w->state->table, &key) != NULL;
+        }
+    }
+    return NULL;
+}
+// Split [begin, end) across threads and wait for all of them
+static void cht_bench_mixed(CHTBenchState *s, size_t begin, size_t end, size_t threads) {
+    CHTBenchWorker workers[16];
+    pthread_t ids[16];
+    for (size_t t = 0; t < threads; t++) {
+        workers[t] = (CHTBenchWorker){s, begin + (end - begin) * t / threads, begin + (end - begin) * (t + 1) / threads, 0};
+        pthread_create(&ids[t], NULL, cht_bench_worker, &workers[t]);
+    }
+    for (size_t t = 0; t < threads; t++) {
+        pthread_join(ids[t], NULL);
+        bench_sink += workers[t].found;
+    }
+}
+static void cht_bench_mixed_1t(void *state, size_t begin, size_t end) {
+    cht_bench_mixed((CHTBenchState *)state, begin, end, 1);
+}
+static void cht_bench_mixed_4t(void *state, size_t begin, size_t end) {
+    cht_bench_mixed((CHTBenchState *)state, begin, end, 4);
+}
+static void cht_bench_mixed_16t(void *state, size_t begin, size_t end) {
+    cht_bench_mixed((CHTBenchState *)state, begin, end, 16);
+}
+// No reader is in flight between repetitions, so retired entries can go
+static void cht_bench_reclaim(void *state) {
+    concurrent_hashtable_reclaim(&((CHTBenchState *)state)->table);
+}
+static void cht_bench_free(void *state) {
+    CHTBenchState *s = (CHTBenchState *)state;
+    concurrent_hashtable_free(&s->table);
+    free(s->values);
+    free(s);
+}
+
+// ==================== HEAPS ====================
+
+static void min_heap_bench_fill(BenchState *s) {
+    min_heap_init(&s->as.min_heap, 0);
+    for (size_t i = 0; i < s->size; i++) min_heap_push(&s->as.min_heap, &s->keys[i]);
+}
+static void *min_heap_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    min_heap_init(&s->as.min_heap, 0);
+    return s;
+}
+static void *min_heap_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    min_heap_bench_fill(s);
+    return s;
+}
+static void min_heap_bench_push(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) min_heap_push(&s->as.min_heap, &s->keys[i]);
+}
+static void min_heap_bench_pop(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)min_heap_pop(&s->as.min_heap);
+}
+static void min_heap_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    min_heap_free(&s->as.min_heap);
+    min_heap_init(&s->as.min_heap, 0);
+}
+static void min_heap_bench_refill(void *state) {
+    BenchState *s = (BenchState *)state;
+    min_heap_free(&s->as.min_heap);
+    min_heap_bench_fill(s);
+}
+static void min_heap_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    min_heap_free(&s->as.min_heap);
+    bench_state_free(s);
+}
+
+static void max_heap_bench_fill(BenchState *s) {
+    max_heap_init(&s->as.max_heap, 0);
+    for (size_t i = 0; i < s->size; i++) max_heap_push(&s->as.max_heap, &s->keys[i]);
+}
+static void *max_heap_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    max_heap_init(&s->as.max_heap, 0);
+    return s;
+}
+static void *max_heap_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    max_heap_bench_fill(s);
+    return s;
+}
+static void max_heap_bench_push(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) max_heap_push(&s->as.max_heap, &s->keys[i]);
+}
+static void max_heap_bench_pop(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)max_heap_pop(&s->as.max_heap);
+}
+static void max_heap_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    max_heap_free(&s->as.max_heap);
+    max_heap_init(&s->as.max_heap, 0);
+}
+static void max_heap_bench_refill(void *state) {
+    BenchState *s = (BenchState *)state;
+    max_heap_free(&s->as.max_heap);
+    max_heap_bench_fill(s);
+}
+static void max_heap_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    max_heap_free(&s->as.max_heap);
+    bench_state_free(s);
+}
+
+// Keys and pointers to them, the void** input the array-based heap APIs take
+typedef struct {
+    size_t size;
+    int *keys;    // bench_key(0..size-1)
+    void **items; // items[i] = &keys[i]
+    MaxHeap heap; // Built from items (top-k cases)
+} TopKBenchState;
+
+static void *top_k_bench_new(size_t size) {
+    TopKBenchState *s = (TopKBenchState *)malloc(sizeof(TopKBenchState));
+    if (!s || !(s->keys = (int *)malloc(size * sizeof(int))) || !(s->items = (void **)malloc(size * sizeof(void *)))) {
+        fprintf(stderr, "top_k_bench_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    s->size = size;
+    for (size_t i = 0; i < size; i++) {
+        s->keys[i] = bench_key(i);
+        s->items[i] = &s->keys[i];
+    }
+    max_heap_init(&s->heap, 0);
+    max_heap_build_from_array(&s->heap, s->items, size);
+    return s;
+}
+static void top_k_bench_select(void *state, size_t begin, size_t end) {
+    TopKBenchState *s = (TopKBenchState *)state;
+    void *best[10];
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += binary_heap_select_top_k(s->items, s->size, 10, heap_int_compare_max, best);
+    }
+}
+static void top_k_bench_walk(void *state, size_t begin, size_t end) {
+    TopKBenchState *s = (TopKBenchState *)state;
+    void *best[10];
+    for (size_t i = begin; i < end; i++) bench_sink += binary_heap_top_k(&s->heap, 10, best);
+}
+// One operation per element: heapify both halves of the input, then merge them
+static void heap_merge_bench_build(void *state, size_t begin, size_t end) {
+    TopKBenchState *s = (TopKBenchState *)state;
+    (void)begin;
+    (void)end;
+    MinHeap first, second;
+    min_heap_init(&first, 0);
+    min_heap_init(&second, 0);
+    min_heap_build_from_array(&first, s->items, s->size / 2);
+    min_heap_build_from_array(&second, s->items + s->size / 2, s->size - s->size / 2);
+    binary_heap_merge(&first, &second);
+    bench_sink += (uintptr_t)min_heap_peek(&first);
+    min_heap_free(&second);
+    min_heap_free(&first);
+}
+static void top_k_bench_free(void *state) {
+    TopKBenchState *s = (TopKBenchState *)state;
+    max_heap_free(&s->heap);
+    free(s->items);
+    free(s->keys);
+    free(s);
+}
+
+static void dary_heap_bench_fill(BenchState *s, unsigned arity) {
+    dary_heap_init(&s->as.dary_heap, arity, heap_int_compare_min, 0);
+    for (size_t i = 0; i < s->size; i++) dary_heap_push(&s->as.dary_heap, &s->keys[i]);
+}
+static unsigned dary_heap_bench_arity(const BenchState *s) {
+    return 1u << s->as.dary_heap.shift;
+}
+static void *dary_heap_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    dary_heap_init(&s->as.dary_heap, 4, heap_int_compare_min, 0);
+    return s;
+}
+static void *dary_heap_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    dary_heap_bench_fill(s, 4);
+    return s;
+}
+static void *dary8_heap_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    dary_heap_init(&s->as.dary_heap, 8, heap_int_compare_min, 0);
+    return s;
+}
+static void *dary8_heap_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    dary_heap_bench_fill(s, 8);
+    return s;
+}
+static void dary_heap_bench_push(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) dary_heap_push(&s->as.dary_heap, &s->keys[i]);
+}
+static void dary_heap_bench_pop(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)dary_heap_pop(&s->as.dary_heap);
+}
+static void dary_heap_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    unsigned arity = dary_heap_bench_arity(s);
+    dary_heap_free(&s->as.dary_heap);
+    dary_heap_init(&s->as.dary_heap, arity, heap_int_compare_min, 0);
+}
+static void dary_heap_bench_refill(void *state) {
+    BenchState *s = (BenchState *)state;
+    unsigned arity = dary_heap_bench_arity(s);
+    dary_heap_free(&s->as.dary_heap);
+    dary_heap_bench_fill(s, arity);
+}
+static void dary_heap_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    dary_heap_free(&s->as.dary_heap);
+    bench_state_free(s);
+}
+
+static void *indexed_heap_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    indexed_heap_init(&s->as.indexed_heap, heap_int_compare_min, 0);
+    return s;
+}
+static void *indexed_heap_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    indexed_heap_init(&s->as.indexed_heap, heap_int_compare_min, 0);
+    for (size_t i = 0; i < size; i++) indexed_heap_push(&s->as.indexed_heap, i, &s->keys[i]);
+    return s;
+}
+static void indexed_heap_bench_push(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) indexed_heap_push(&s->as.indexed_heap, i, &s->keys[i]);
+}
+// Change a random element's key and restore heap order
+static void indexed_heap_bench_update_key(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        size_t handle = bench_index(i, s->size);
+        s->keys[handle] = bench_key(i + s->size);
+        indexed_heap_update_key(&s->as.indexed_heap, handle);
+    }
+}
+static void indexed_heap_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    indexed_heap_free(&s->as.indexed_heap);
+    indexed_heap_init(&s->as.indexed_heap, heap_int_compare_min, 0);
+}
+static void indexed_heap_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    indexed_heap_free(&s->as.indexed_heap);
+    bench_state_free(s);
+}
+
+// ==================== TREES ====================
+
+static void *tree_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    tree_init(&s->as.tree);
+    return s;
+}
+static void *tree_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    tree_init(&s->as.tree);
+    for (size_t i = 0; i < size; i++) tree_insert(&s->as.tree, s->keys[i]);
+    return s;
+}
+static void tree_bench_insert(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) tree_insert(&s->as.tree, s->keys[i]);
+}
+static void tree_bench_search(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += tree_search(&s->as.tree, s->keys[bench_index(i, s->size)]);
+}
+static void tree_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    tree_free(&s->as.tree);
+    tree_init(&s->as.tree);
+}
+static void tree_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    tree_free(&s->as.tree);
+    bench_state_free(s);
+}
+
+static int bench_compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+// Copy of the state's keys in ascending order, for the sorted-array builders
+static int *bench_sorted_keys(const BenchState *s) {
+    int *sorted = (int *)malloc(s->size * sizeof(int));
+    if (!sorted) {
+        fprintf(stderr, "bench_sorted_keys: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(sorted, s->keys, s->size * sizeof(int));
+    qsort(sorted, s->size, sizeof(int), bench_compare_int);
+    return sorted;
+}
+// Pointer tree with the same perfectly balanced shape as the static tree
+static void *tree_bench_balanced(size_t size) {
+    BenchState *s = bench_state_new(size);
+    int *sorted = bench_sorted_keys(s);
+    tree_from_sorted_array(&s->as.tree, sorted, size);
+    free(sorted);
+    return s;
+}
+static void *static_tree_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    int *sorted = bench_sorted_keys(s);
+    static_tree_from_sorted_array(&s->as.static_tree, sorted, size);
+    free(sorted);
+    return s;
+}
+static void static_tree_bench_search(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += static_tree_search(&s->as.static_tree, s->keys[bench_index(i, s->size)]);
+    }
+}
+static void static_tree_bench_search_many(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    int queries[64];
+    bool found[64];
+    for (size_t i = begin; i < end; i += 64) {
+        size_t count = end - i < 64 ? end - i : 64;
+        for (size_t j = 0; j < count; j++) queries[j] = s->keys[bench_index(i + j, s->size)];
+        static_tree_search_many(&s->as.static_tree, queries, count, found);
+        for (size_t j = 0; j < count; j++) bench_sink += found[j];
+    }
+}
+static void static_tree_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    static_tree_free(&s->as.static_tree);
+    bench_state_free(s);
+}
+
+static void *avl_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    avl_init(&s->as.avl);
+    return s;
+}
+static void *avl_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    avl_init(&s->as.avl);
+    for (size_t i = 0; i < size; i++) avl_insert(&s->as.avl, s->keys[i]);
+    return s;
+}
+static void avl_bench_insert(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) avl_insert(&s->as.avl, s->keys[i]);
+}
+static void avl_bench_search(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += avl_search(&s->as.avl, s->keys[bench_index(i, s->size)]);
+}
+static void avl_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    avl_free(&s->as.avl);
+    avl_init(&s->as.avl);
+}
+static void avl_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    avl_free(&s->as.avl);
+    bench_state_free(s);
+}
+
+static void *btree_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    BenchBTree_init(&s->as.btree);
+    return s;
+}
+static void *btree_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    BenchBTree_init(&s->as.btree);
+    for (size_t i = 0; i < size; i++) BenchBTree_insert(&s->as.btree, s->keys[i], (int)i);
+    return s;
+}
+static void btree_bench_insert(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) BenchBTree_insert(&s->as.btree, s->keys[i], (int)i);
+}
+static void btree_bench_search(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += BenchBTree_search(&s->as.btree, s->keys[bench_index(i, s->size)]);
+    }
+}
+// In-order walk of the leaf chain, timed per key
+static void btree_bench_scan(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    (void)begin;
+    (void)end;
+    long long total = 0;
+    for (BenchBTreeIter it = BenchBTree_begin(&s->as.btree); BenchBTree_iter_valid(&it); BenchBTree_iter_next(&it)) {
+        total += *BenchBTree_iter_key(&it);
+    }
+    bench_sink += (uintptr_t)total;
+}
+static void btree_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    BenchBTree_free(&s->as.btree);
+}
+static void btree_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    BenchBTree_free(&s->as.btree);
+    bench_state_free(s);
+}
+
+static void *avl_order_bench_empty(size_t size) {
+    BenchState *s = bench_state_new(size);
+    avl_order_init(&s->as.avl_order, avl_compare_int);
+    return s;
+}
+static void *avl_order_bench_full(size_t size) {
+    BenchState *s = bench_state_new(size);
+    avl_order_init(&s->as.avl_order, avl_compare_int);
+    for (size_t i = 0; i < size; i++) avl_order_insert(&s->as.avl_order, &s->keys[i], &s->keys[i]);
+    return s;
+}
+static void avl_order_bench_insert(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) avl_order_insert(&s->as.avl_order, &s->keys[i], &s->keys[i]);
+}
+static void avl_order_bench_rank(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += avl_rank(&s->as.avl_order, &s->keys[bench_index(i, s->size)]);
+}
+static void avl_order_bench_select(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)avl_select(&s->as.avl_order, bench_index(i, s->size));
+}
+static void avl_order_bench_clear(void *state) {
+    BenchState *s = (BenchState *)state;
+    avl_order_free(&s->as.avl_order);
+    avl_order_init(&s->as.avl_order, avl_compare_int);
+}
+static void avl_order_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    avl_order_free(&s->as.avl_order);
+    bench_state_free(s);
+}
+
+// ==================== TRIE ====================
+
+// Player-style names "<Aa> Player <i>": 676 two-letter prefixes of size / 676 names each
+typedef struct {
+    size_t size;
+    char (*names)[32]; // Borrowed by the trie
+    float *ratings;
+    Trie trie;
+} TrieBenchState;
+
+static void trie_bench_fill(TrieBenchState *s) {
+    trie_init(&s->trie);
+    for (size_t i = 0; i < s->size; i++) trie_insert(&s->trie, s->names[i], s->ratings[i], s->names[i]);
+}
+static void *trie_bench_empty(size_t size) {
+    TrieBenchState *s = (TrieBenchState *)malloc(sizeof(TrieBenchState));
+    if (!s || !(s->names = malloc(size * sizeof(*s->names))) || !(s->ratings = (float *)malloc(size * sizeof(float)))) {
+        fprintf(stderr, "trie_bench_empty: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    s->size = size;
+    for (size_t i = 0; i < size; i++) {
+        snprintf(s->names[i], sizeof(s->names[i]), "%c%c Player %zu", 'A' + (int)(i % 26), 'a' + (int)(i / 26 % 26), i);
+        s->ratings[i] = (float)(bench_key(i) % 100000) / 1000.0f;
+    }
+    trie_init(&s->trie);
+    return s;
+}
+static void *trie_bench_full(size_t size) {
+    TrieBenchState *s = (TrieBenchState *)trie_bench_empty(size);
+    trie_bench_fill(s);
+    return s;
+}
+// Two-letter prefix for operation i
+static void trie_bench_prefix(size_t i, char prefix[3]) {
+    prefix[0] = (char)('A' + i % 26);
+    prefix[1] = (char)('a' + i / 26 % 26);
+    prefix[2] = '\0';
+}
+static void trie_bench_insert(void *state, size_t begin, size_t end) {
+    TrieBenchState *s = (TrieBenchState *)state;
+    for (size_t i = begin; i < end; i++) trie_insert(&s->trie, s->names[i], s->ratings[i], s->names[i]);
+}
+static void trie_bench_get(void *state, size_t begin, size_t end) {
+    TrieBenchState *s = (TrieBenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)trie_get(&s->trie, s->names[bench_index(i, s->size)]);
+}
+static void trie_bench_top_k(void *state, size_t begin, size_t end) {
+    TrieBenchState *s = (TrieBenchState *)state;
+    void *best[5];
+    char prefix[3];
+    for (size_t i = begin; i < end; i++) {
+        trie_bench_prefix(i, prefix);
+        bench_sink += trie_top_k(&s->trie, prefix, 5, best);
+    }
+}
+// Best-rated name for the prefix by checking every name, the baseline for top_k
+static void trie_bench_top_k_scan(void *state, size_t begin, size_t end) {
+    TrieBenchState *s = (TrieBenchState *)state;
+    char prefix[3];
+    for (size_t i = begin; i < end; i++) {
+        trie_bench_prefix(i, prefix);
+        size_t best = s->size;
+        for (size_t j = 0; j < s->size; j++) {
+            if (strncmp(s->names[j], prefix, 2) == 0 && (best == s->size || s->ratings[j] > s->ratings[best])) best = j;
+        }
+        bench_sink += best;
+    }
+}
+static void trie_bench_clear(void *state) {
+    TrieBenchState *s = (TrieBenchState *)state;
+    trie_free(&s->trie);
+    trie_init(&s->trie);
+}
+static void trie_bench_free(void *state) {
+    TrieBenchState *s = (TrieBenchState *)state;
+    trie_free(&s->trie);
+    free(s->names);
+    free(s->ratings);
+    free(s);
+}
+
+// ==================== UNION-FIND ====================
+
+static void *unionfind_bench_new(size_t size) {
+    BenchState *s = bench_state_new(size);
+    unionfind_init(&s->as.unionfind, (unionfind_index_t)size);
+    return s;
+}
+static void *unionfind_bench_joined(size_t size) {
+    BenchState *s = (BenchState *)unionfind_bench_new(size);
+    for (size_t i = 0; i < size; i++) {
+        unionfind_union(&s->as.unionfind, (unionfind_index_t)i, (unionfind_index_t)bench_index(i, size));
+    }
+    return s;
+}
+static void unionfind_bench_union(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += unionfind_union(&s->as.unionfind, (unionfind_index_t)i, (unionfind_index_t)bench_index(i, s->size));
+    }
+}
+static void unionfind_bench_find(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += (uintptr_t)unionfind_find(&s->as.unionfind, (unionfind_index_t)bench_index(i, s->size));
+    }
+}
+static void unionfind_bench_reset(void *state) {
+    unionfind_reset(&((BenchState *)state)->as.unionfind);
+}
+static void unionfind_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    unionfind_free(&s->as.unionfind);
+    bench_state_free(s);
+}
+
+// Random edge list over size vertices, one edge per operation
+typedef struct {
+    UnionFind uf;
+    unionfind_index_t *edges; // 2 * size endpoints
+} UnionEdgesBenchState;
+
+static void *union_edges_bench_new(size_t size) {
+    UnionEdgesBenchState *s = (UnionEdgesBenchState *)malloc(sizeof(UnionEdgesBenchState));
+    if (!s || !(s->edges = (unionfind_index_t *)malloc(2 * size * sizeof(unionfind_index_t)))) {
+        fprintf(stderr, "union_edges_bench_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < 2 * size; i++) s->edges[i] = (unionfind_index_t)bench_index(i, size);
+    unionfind_init(&s->uf, (unionfind_index_t)size);
+    return s;
+}
+static void union_edges_bench_1t(void *state, size_t begin, size_t end) {
+    UnionEdgesBenchState *s = (UnionEdgesBenchState *)state;
+    bench_sink += unionfind_union_edges(&s->uf, s->edges + 2 * begin, end - begin, 1);
+}
+static void union_edges_bench_4t(void *state, size_t begin, size_t end) {
+    UnionEdgesBenchState *s = (UnionEdgesBenchState *)state;
+    bench_sink += unionfind_union_edges(&s->uf, s->edges + 2 * begin, end - begin, 4);
+}
+static void union_edges_bench_reset(void *state) {
+    unionfind_reset(&((UnionEdgesBenchState *)state)->uf);
+}
+static void union_edges_bench_free(void *state) {
+    UnionEdgesBenchState *s = (UnionEdgesBenchState *)state;
+    unionfind_free(&s->uf);
+    free(s->edges);
+    free(s);
+}
+
+// ==================== RANGE QUERIES ====================
+
+DEFINE_SEGTREE(BenchSumTree, long long, SEGTREE_SUM, 0)
+DEFINE_FENWICK(BenchFenwick, long long, SEGTREE_SUM, SEGTREE_SUB, 0)
+
+// Sums over a quarter of the values, starting at a random offset in the first half
+typedef struct {
+    size_t size;
+    long long *values;
+    BenchSumTree tree;
+    BenchFenwick fenwick;
+} RangeBenchState;
+
+static void *range_bench_new(size_t size) {
+    RangeBenchState *s = (RangeBenchState *)malloc(sizeof(RangeBenchState));
+    if (!s || !(s->values = (long long *)malloc(size * sizeof(long long)))) {
+        fprintf(stderr, "range_bench_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    s->size = size;
+    for (size_t i = 0; i < size; i++) s->values[i] = bench_key(i) % 1000;
+    BenchSumTree_build(&s->tree, s->values, size);
+    BenchFenwick_build(&s->fenwick, s->values, size);
+    return s;
+}
+static size_t range_bench_lo(const RangeBenchState *s, size_t i) {
+    return bench_index(i, s->size / 2 + 1);
+}
+static void range_bench_scan(void *state, size_t begin, size_t end) {
+    RangeBenchState *s = (RangeBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        size_t lo = range_bench_lo(s, i), hi = lo + s->size / 4;
+        long long total = 0;
+        for (size_t j = lo; j < hi; j++) total += s->values[j];
+        bench_sink += (uintptr_t)total;
+    }
+}
+static void range_bench_segtree(void *state, size_t begin, size_t end) {
+    RangeBenchState *s = (RangeBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        size_t lo = range_bench_lo(s, i);
+        bench_sink += (uintptr_t)BenchSumTree_query(&s->tree, lo, lo + s->size / 4);
+    }
+}
+static void range_bench_fenwick(void *state, size_t begin, size_t end) {
+    RangeBenchState *s = (RangeBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        size_t lo = range_bench_lo(s, i);
+        bench_sink += (uintptr_t)BenchFenwick_range(&s->fenwick, lo, lo + s->size / 4);
+    }
+}
+static void range_bench_free(void *state) {
+    RangeBenchState *s = (RangeBenchState *)state;
+    BenchSumTree_free(&s->tree);
+    BenchFenwick_free(&s->fenwick);
+    free(s->values);
+    free(s);
+}
+
+// ==================== SEQUENCES ====================
+
+static void *lis_bench_new(size_t size) {
+    BenchState *s = bench_state_new(size);
+    lis_init(&s->as.lis, true, true);
+    return s;
+}
+static void lis_bench_push(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += lis_push(&s->as.lis, s->keys[i]);
+}
+// Batch LIS over the whole key array, timed per element
+static void lis_bench_compute_length(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    (void)begin;
+    (void)end;
+    bench_sink += lis_compute(s->keys, s->size, true, NULL);
+}
+static void *lis_bench_positions(size_t size) {
+    BenchState *s = bench_state_new(size);
+    s->as.positions = (size_t *)malloc(size * sizeof(size_t));
+    if (!s->as.positions) {
+        fprintf(stderr, "lis_bench_positions: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return s;
+}
+static void lis_bench_compute_sequence(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    (void)begin;
+    (void)end;
+    bench_sink += lis_compute(s->keys, s->size, true, s->as.positions);
+}
+static void lis_bench_positions_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    free(s->as.positions);
+    bench_state_free(s);
+}
+static void lis_bench_reset(void *state) {
+    BenchState *s = (BenchState *)state;
+    lis_free(&s->as.lis);
+}
+static void lis_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    lis_free(&s->as.lis);
+    bench_state_free(s);
+}
+
+// ==================== POLYNOMIALS ====================
+
+// Two operands of length size; one operation is one full product
+typedef struct {
+    size_t size;
+    double *x, *y, *out;
+    uint32_t *ux, *uy, *uout; // Coefficients below POLY_NTT_MODULUS
+} PolyBenchState;
+
+static void *poly_bench_new(size_t size) {
+    PolyBenchState *s = (PolyBenchState *)malloc(sizeof(PolyBenchState));
+    if (!s || !(s->x = (double *)malloc(size * sizeof(double))) || !(s->y = (double *)malloc(size * sizeof(double))) ||
+        !(s->out = (double *)malloc(2 * size * sizeof(double))) ||
+        !(s->ux = (uint32_t *)malloc(size * sizeof(uint32_t))) || !(s->uy = (uint32_t *)malloc(size * sizeof(uint32_t))) ||
+        !(s->uout = (uint32_t *)malloc(2 * size * sizeof(uint32_t)))) {
+        fprintf(stderr, "poly_bench_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    s->size = size;
+    for (size_t i = 0; i < size; i++) {
+        s->x[i] = (double)(i % 13);
+        s->y[i] = (double)(i % 7);
+        s->ux[i] = (uint32_t)bench_key(i) % POLY_NTT_MODULUS;
+        s->uy[i] = (uint32_t)bench_key(i + size) % POLY_NTT_MODULUS;
+    }
+    return s;
+}
+static void poly_bench_naive(void *state, size_t begin, size_t end) {
+    PolyBenchState *s = (PolyBenchState *)state;
+    for (size_t i = begin; i < end; i++) poly_multiply_naive(s->x, s->size, s->y, s->size, s->out);
+}
+static void poly_bench_karatsuba(void *state, size_t begin, size_t end) {
+    PolyBenchState *s = (PolyBenchState *)state;
+    for (size_t i = begin; i < end; i++) poly_multiply_karatsuba(s->x, s->size, s->y, s->size, s->out);
+}
+static void poly_bench_fft(void *state, size_t begin, size_t end) {
+    PolyBenchState *s = (PolyBenchState *)state;
+    for (size_t i = begin; i < end; i++) poly_multiply_fft(s->x, s->size, s->y, s->size, s->out);
+}
+static void poly_bench_ntt(void *state, size_t begin, size_t end) {
+    PolyBenchState *s = (PolyBenchState *)state;
+    for (size_t i = begin; i < end; i++) poly_multiply_mod(s->ux, s->size, s->uy, s->size, POLY_NTT_MODULUS, s->uout);
+}
+static void poly_bench_free(void *state) {
+    PolyBenchState *s = (PolyBenchState *)state;
+    free(s->x);
+    free(s->y);
+    free(s->out);
+    free(s->ux);
+    free(s->uy);
+    free(s->uout);
+    free(s);
+}
+
+// ==================== GRAPHS ====================
+
+// Pointer graph with size vertices and no edges
+static void graph_bench_vertices(BenchState *s) {
+    graph_init(&s->as.graph);
+    for (size_t i = 0; i < s->size; i++) graph_new_vertex(&s->as.graph, (int)i);
+}
+static void *graph_bench_new(size_t size) {
+    BenchState *s = bench_state_new(size);
+    graph_bench_vertices(s);
+    return s;
+}
+static void graph_bench_new_edge(void *state, size_t begin, size_t end) {
+    BenchState *s = (BenchState *)state;
+    DynArray *vertices = &s->as.graph.Vertices;
+    for (size_t i = begin; i < end; i++) {
+        V *from = (V *)dynarray_get(vertices, i);
+        V *to = (V *)dynarray_get(vertices, bench_index(i, s->size));
+        graph_new_edge(&s->as.graph, from, to, 1);
+    }
+}
+static void graph_bench_rebuild(void *state) {
+    BenchState *s = (BenchState *)state;
+    graph_destroy(&s->as.graph);
+    graph_bench_vertices(s);
+}
+static void graph_bench_free(void *state) {
+    BenchState *s = (BenchState *)state;
+    graph_destroy(&s->as.graph);
+    bench_state_free(s);
+}
+
+// CSR graph with BENCH_GRAPH_DEGREE random undirected edges per vertex
+typedef struct {
+    CSRGraph graph;
+    uint32_t *distance;
+    int64_t *weighted_distance;
+    uint32_t *component;
+    csr_vertex_t *order;
+    double *rank;
+    size_t threads;  // Workers in pool, 0 for the sequential kernels
+    ThreadPool pool; // Runs the parallel kernels
+} CSRBenchState;
+
+// Edge list behind the CSR cases: BENCH_GRAPH_DEGREE random edges per vertex
+static CSREdge *csr_bench_edges(size_t size) {
+    CSREdge *edges = (CSREdge *)malloc(size * BENCH_GRAPH_DEGREE * sizeof(CSREdge));
+    if (!edges) {
+        fprintf(stderr, "csr_bench_edges: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < size * BENCH_GRAPH_DEGREE; i++) {
+        edges[i].from = (csr_vertex_t)(i % size);
+        edges[i].to = (csr_vertex_t)bench_index(i, size);
+        edges[i].weight = 1 + (int)(i % 97);
+    }
+    return edges;
+}
+static void *csr_bench_with_threads(size_t size, size_t threads) {
+    CSRBenchState *s = (CSRBenchState *)malloc(sizeof(CSRBenchState));
+    if (!s) {
+        fprintf(stderr, "csr_bench_with_threads: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    CSREdge *edges = csr_bench_edges(size);
+    csr_graph_from_edges(&s->graph, size, edges, size * BENCH_GRAPH_DEGREE, true);
+    free(edges);
+    s->distance = (uint32_t *)malloc(size * sizeof(uint32_t));
+    s->weighted_distance = (int64_t *)malloc(size * sizeof(int64_t));
+    s->component = (uint32_t *)malloc(size * sizeof(uint32_t));
+    s->order = (csr_vertex_t *)malloc(size * sizeof(csr_vertex_t));
+    s->rank = (double *)malloc(size * sizeof(double));
+    if (!s->distance || !s->weighted_distance || !s->component || !s->order || !s->rank) {
+        fprintf(stderr, "csr_bench_with_threads: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    s->threads = threads;
+    if (threads) thread_pool_init(&s->pool, threads);
+    return s;
+}
+static void *csr_bench_new(size_t size) { return csr_bench_with_threads(size, 0); }
+// Fixed pool sizes so the parallel cases read as a speedup curve against csr_graph/*
+static void *csr_bench_new_1t(size_t size) { return csr_bench_with_threads(size, 1); }
+static void *csr_bench_new_2t(size_t size) { return csr_bench_with_threads(size, 2); }
+static void *csr_bench_new_4t(size_t size) { return csr_bench_with_threads(size, 4); }
+static void *csr_bench_new_8t(size_t size) { return csr_bench_with_threads(size, 8); }
+static void csr_bench_bfs(void *state, size_t begin, size_t end) {
+    CSRBenchState *s = (CSRBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        csr_vertex_t source = (csr_vertex_t)bench_index(i, s->graph.vertex_count);
+        bench_sink += csr_graph_bfs(&s->graph, source, s->distance, NULL);
+    }
+}
+static void csr_bench_dijkstra(void *state, size_t begin, size_t end) {
+    CSRBenchState *s = (CSRBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        csr_vertex_t source = (csr_vertex_t)bench_index(i, s->graph.vertex_count);
+        bench_sink += csr_graph_dijkstra(&s->graph, source, s->weighted_distance, NULL);
+    }
+}
+static void csr_bench_dfs(void *state, size_t begin, size_t end) {
+    CSRBenchState *s = (CSRBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        csr_vertex_t source = (csr_vertex_t)bench_index(i, s->graph.vertex_count);
+        bench_sink += csr_graph_dfs(&s->graph, source, s->order);
+    }
+}
+static void csr_bench_components(void *state, size_t begin, size_t end) {
+    CSRBenchState *s = (CSRBenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += csr_graph_connected_components(&s->graph, s->component);
+}
+static void csr_bench_parallel_bfs(void *state, size_t begin, size_t end) {
+    CSRBenchState *s = (CSRBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        csr_vertex_t source = (csr_vertex_t)bench_index(i, s->graph.vertex_count);
+        bench_sink += csr_graph_parallel_bfs(&s->graph, NULL, &s->pool, source, s->distance);
+    }
+}
+static void csr_bench_parallel_components(void *state, size_t begin, size_t end) {
+    CSRBenchState *s = (CSRBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += csr_graph_parallel_connected_components(&s->graph, &s->pool, s->component);
+    }
+}
+// Ten power iterations per operation
+static void csr_bench_parallel_pagerank(void *state, size_t begin, size_t end) {
+    CSRBenchState *s = (CSRBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += csr_graph_parallel_pagerank(&s->graph, NULL, &s->pool, PAGERANK_DEFAULT_DAMPING, 0.0, 10, s->rank);
+    }
+}
+static void csr_bench_free(void *state) {
+    CSRBenchState *s = (CSRBenchState *)state;
+    if (s->threads) thread_pool_free(&s->pool);
+    csr_graph_free(&s->graph);
+    free(s->distance);
+    free(s->weighted_distance);
+    free(s->component);
+    free(s->order);
+    free(s->rank);
+    free(s);
+}
+
+// Building the CSR arrays from an edge list, timed per vertex
+typedef struct {
+    size_t size;
+    CSREdge *edges;
+    CSRGraph graph;
+} CSRBuildBenchState;
+
+static void *csr_build_bench_new(size_t size) {
+    CSRBuildBenchState *s = (CSRBuildBenchState *)malloc(sizeof(CSRBuildBenchState));
+    if (!s) {
+        fprintf(stderr, "csr_build_bench_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    s->size = size;
+    s->edges = csr_bench_edges(size);
+    return s;
+}
+static void csr_build_bench_build(void *state, size_t begin, size_t end) {
+    CSRBuildBenchState *s = (CSRBuildBenchState *)state;
+    (void)begin;
+    (void)end;
+    csr_graph_from_edges(&s->graph, s->size, s->edges, s->size * BENCH_GRAPH_DEGREE, true);
+}
+static void csr_build_bench_reset(void *state) {
+    csr_graph_free(&((CSRBuildBenchState *)state)->graph);
+}
+static void csr_build_bench_free(void *state) {
+    CSRBuildBenchState *s = (CSRBuildBenchState *)state;
+    csr_graph_free(&s->graph);
+    free(s->edges);
+    free(s);
+}
+
+// ==================== COLUMNAR ====================
+
+// Player-shaped row, as an array-of-structs store would hold it
+typedef struct {
+    int id;
+    char name[64];
+    char nationality[32];
+    char position[16];
+    int age;
+    float height, weight;
+    int jersey;
+    float skill;
+    int team;
+} ColumnBenchRow;
+
+// The same rows as a row store and as columns; one operation tests one row
+typedef struct {
+    ColumnBenchRow *rows;
+    int32_t *age;
+    float *skill;
+    uint16_t *nationality; // Dictionary code, row string is "N<code>"
+    uint32_t *selection;
+} ColumnBenchState;
+
+static void *column_bench_new(size_t size) {
+    ColumnBenchState *s = (ColumnBenchState *)malloc(sizeof(ColumnBenchState));
+    if (!s || !(s->rows = (ColumnBenchRow *)calloc(size, sizeof(ColumnBenchRow))) ||
+        !(s->age = (int32_t *)malloc(size * sizeof(int32_t))) || !(s->skill = (float *)malloc(size * sizeof(float))) ||
+        !(s->nationality = (uint16_t *)malloc(size * sizeof(uint16_t))) ||
+        !(s->selection = (uint32_t *)malloc(size * sizeof(uint32_t)))) {
+        fprintf(stderr, "column_bench_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < size; i++) {
+        uint64_t h = (uint64_t)bench_key(i);
+        s->age[i] = s->rows[i].age = 18 + (int)(h % 22);
+        s->skill[i] = s->rows[i].skill = (float)(h / 22 % 1000) / 10.0f;
+        s->nationality[i] = (uint16_t)(h / 22000 % 40);
+        snprintf(s->rows[i].nationality, sizeof(s->rows[i].nationality), "N%u", s->nationality[i]);
+    }
+    return s;
+}
+// nationality == N7 && 20 <= age <= 25 && skill >= 80, one row at a time
+static void column_bench_row_scan(void *state, size_t begin, size_t end) {
+    ColumnBenchState *s = (ColumnBenchState *)state;
+    size_t matches = 0;
+    for (size_t i = begin; i < end; i++) {
+        const ColumnBenchRow *row = &s->rows[i];
+        if (strcmp(row->nationality, "N7") == 0 && row->age >= 20 && row->age <= 25 && row->skill >= 80.0f) {
+            s->selection[matches++] = (uint32_t)i;
+        }
+    }
+    bench_sink += matches;
+}
+// Same predicates, column at a time
+static void column_bench_filter(void *state, size_t begin, size_t end) {
+    ColumnBenchState *s = (ColumnBenchState *)state;
+    ColumnPredicate predicates[3] = {
+        column_predicate_code_equals(s->nationality + begin, 7),
+        column_predicate_int_range(s->age + begin, 20, 25),
+        column_predicate_float_range(s->skill + begin, 80.0f, 100.0f)
+    };
+    bench_sink += column_filter(predicates, 3, end - begin, s->selection);
+}
+static void column_bench_free(void *state) {
+    ColumnBenchState *s = (ColumnBenchState *)state;
+    free(s->rows);
+    free(s->age);
+    free(s->skill);
+    free(s->nationality);
+    free(s->selection);
+    free(s);
+}
+
+// ==================== BASKETBALL SYSTEM ====================
+
+static const char *const bench_nationalities[] = {
+    "USA", "Canada", "France", "Spain", "Serbia", "Greece", "Slovenia", "Germany",
+    "Australia", "Argentina", "Lithuania", "Nigeria", "Japan", "Brazil", "Turkey", "Italy"};
+static const char *const bench_positions[] = {"PG", "SG", "SF", "PF", "C"};
+
+// System of `size` generated players, kept across cases at the same scale
+typedef struct {
+    BasketballSystem system;
+    size_t size;
+    char (*names)[32]; // Names of the first BENCH_LOOKUP_NAMES players
+    char (*missing)[32]; // As many names that match no player
+    size_t name_count;
+    uint32_t *selection;
+    PlayerFilter filter;
+} SystemBenchState;
+
+static SystemBenchState *bench_system_cache;
+
+// Fill a Player record for generated player i (id assigned by add_players_bulk)
+static void bench_player_record(Player *player, size_t i) {
+    uint32_t r = (uint32_t)bench_key(i);
+    memset(player, 0, sizeof(Player));
+    snprintf(player->name, sizeof(player->name), "Player %zu", i);
+    strcpy(player->nationality, bench_nationalities[r % 16]);
+    strcpy(player->position, bench_positions[(r >> 4) % 5]);
+    player->age = 19 + (int)((r >> 8) % 22);
+    player->height = 1.75f + (float)((r >> 12) % 50) / 100.0f;
+    player->weight = 75.0f + (float)((r >> 16) % 60);
+    player->jersey_number = (int)(r % 100);
+    player->skill_rating = (float)((r >> 6) % 1000) / 10.0f;
+    player->team_id = -1;
+}
+
+// Add generated players [first, first + count) in chunks
+static void bench_add_players(BasketballSystem *system, size_t first, size_t count) {
+    Player *records = (Player *)malloc(BENCH_PLAYER_CHUNK * sizeof(Player));
+    if (!records) {
+        fprintf(stderr, "bench_add_players: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t done = 0; done < count;) {
+        size_t chunk = count - done < BENCH_PLAYER_CHUNK ? count - done : BENCH_PLAYER_CHUNK;
+        for (size_t i = 0; i < chunk; i++) bench_player_record(&records[i], first + done + i);
+        add_players_bulk(system, records, chunk);
+        done += chunk;
+    }
+    free(records);
+}
+
+static void bench_system_release(void) {
+    SystemBenchState *s = bench_system_cache;
+    if (!s) return;
+    basketball_system_free(&s->system);
+    free(s->names);
+    free(s->missing);
+    free(s->selection);
+    free(s);
+    bench_system_cache = NULL;
+}
+
+static void *system_bench_shared(size_t size) {
+    if (bench_system_cache && bench_system_cache->size == size) return bench_system_cache;
+    bench_system_release();
+
+    SystemBenchState *s = (SystemBenchState *)malloc(sizeof(SystemBenchState));
+    if (!s) {
+        fprintf(stderr, "system_bench_shared: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    s->size = size;
+    s->name_count = size < BENCH_LOOKUP_NAMES ? size : BENCH_LOOKUP_NAMES;
+    s->names = malloc(s->name_count * sizeof(*s->names));
+    s->missing = malloc(s->name_count * sizeof(*s->missing));
+    s->selection = (uint32_t *)malloc(size * sizeof(uint32_t));
+    if (!s->names || !s->missing || !s->selection) {
+        fprintf(stderr, "system_bench_shared: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < s->name_count; i++) {
+        snprintf(s->names[i], sizeof(s->names[i]), "Player %zu", bench_index(i, size));
+        snprintf(s->missing[i], sizeof(s->missing[i]), "Player %zu", size + bench_index(i, size));
+    }
+    basketball_system_init(&s->system);
+    bench_add_players(&s->system, 0, size);
+
+    // About 1.5% of players: one nationality and position, a skill band and an age band
+    player_filter_init(&s->filter);
+    s->filter.nationality = "France";
+    s->filter.position = "C";
+    s->filter.min_skill = 50.0f;
+    s->filter.max_age = 30;
+    bench_system_cache = s;
+    return s;
+}
+static void system_bench_keep(void *state) {
+    (void)state; // Freed by bench_system_release when the scale changes
+}
+
+static void system_bench_find_by_id(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += (uintptr_t)find_player_by_id(&s->system, 1 + (int)bench_index(i, s->size));
+    }
+}
+static void system_bench_find_by_name(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += (uintptr_t)find_player_by_name(&s->system, s->names[i % s->name_count]);
+    }
+}
+static void system_bench_find_by_name_miss(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += (uintptr_t)find_player_by_name(&s->system, s->missing[i % s->name_count]);
+    }
+}
+static void system_bench_name_completion(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    Player *best[5];
+    char prefix[10];
+    for (size_t i = begin; i < end; i++) {
+        // "Player 12" style prefixes: a fan-out of subtrees, not a single match
+        snprintf(prefix, sizeof(prefix), "%s", s->names[i % s->name_count]);
+        bench_sink += get_top_players_by_name_prefix(&s->system, prefix, 5, best);
+    }
+}
+static void system_bench_by_nationality(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += (uintptr_t)get_players_by_nationality(&s->system, bench_nationalities[i % 16]);
+    }
+}
+static void system_bench_most_skilled(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += (uintptr_t)get_most_skilled_player(&s->system);
+}
+static void system_bench_skill_rank(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        bench_sink += (uintptr_t)get_player_by_skill_rank(&s->system, bench_index(i, s->size));
+    }
+}
+static void system_bench_count_age_range(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        int lo = 19 + (int)(i % 15);
+        bench_sink += count_players_in_age_range(&s->system, lo, lo + 5);
+    }
+}
+static void system_bench_count_matching(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += count_players_matching(&s->system, &s->filter);
+}
+static void system_bench_select(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    for (size_t i = begin; i < end; i++) bench_sink += select_players(&s->system, &s->filter, s->selection);
+}
+// Re-rate a random player: heap, ordered index and column updates
+static void system_bench_update_skill(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        int id = 1 + (int)bench_index(i, s->size);
+        bench_sink += update_player_skill(&s->system, id, (float)(i % 1000) / 10.0f);
+    }
+}
+
+// Queue trades of random players and apply them in batches of a full trade queue
+static void system_bench_trades(void *state, size_t begin, size_t end) {
+    SystemBenchState *s = (SystemBenchState *)state;
+    for (size_t i = begin; i < end; i++) {
+        int id = 1 + (int)bench_index(i, s->size);
+        request_trade(&s->system, -1, 1 + (int)(i % 30), id);
+        if ((i + 1 - begin) % TRADE_QUEUE_CAPACITY == 0 || i + 1 == end) {
+            bench_sink += process_all_trades(&s->system);
+        }
+    }
+}
+
+// Bulk load into an empty system (own state: the load is what is timed)
+typedef struct {
+    BasketballSystem system;
+    Player *records;
+} BulkBenchState;
+
+static void *system_bench_bulk_new(size_t size) {
+    BulkBenchState *s = (BulkBenchState *)malloc(sizeof(BulkBenchState));
+    if (!s || !(s->records = (Player *)malloc(size * sizeof(Player)))) {
+        fprintf(stderr, "system_bench_bulk_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < size; i++) bench_player_record(&s->records[i], i);
+    basketball_system_init(&s->system);
+    return s;
+}
+static void system_bench_bulk_load(void *state, size_t begin, size_t end) {
+    BulkBenchState *s = (BulkBenchState *)state;
+    add_players_bulk(&s->system, s->records + begin, end - begin);
+}
+static void system_bench_bulk_reset(void *state) {
+    BulkBenchState *s = (BulkBenchState *)state;
+    basketball_system_free(&s->system);
+    basketball_system_init(&s->system);
+}
+static void system_bench_bulk_free(void *state) {
+    BulkBenchState *s = (BulkBenchState *)state;
+    basketball_system_free(&s->system);
+    free(s->records);
+    free(s);
+}
+
+// Streaming ingest of a CSV feed of the same generated players into an empty system
+typedef struct {
+    BasketballSystem system;
+    char path[32];
+} IngestBenchState;
+
+static void *system_bench_ingest_new(size_t size) {
+    IngestBenchState *s = (IngestBenchState *)malloc(sizeof(IngestBenchState));
+    if (!s) {
+        fprintf(stderr, "system_bench_ingest_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    strcpy(s->path, "/tmp/bench_feed_XXXXXX");
+    int fd = mkstemp(s->path);
+    FILE *feed = fd >= 0 ? fdopen(fd, "w") : NULL;
+    if (!feed) {
+        fprintf(stderr, "system_bench_ingest_new: cannot create %s\n", s->path);
+        exit(EXIT_FAILURE);
+    }
+    Player player;
+    for (size_t i = 0; i < size; i++) {
+        bench_player_record(&player, i);
+        fprintf(feed, "%s,%s,%s,%d,%.2f,%.1f,%d,%.1f,%d\n", player.name, player.nationality, player.position,
+                player.age, (double)player.height, (double)player.weight, player.jersey_number,
+                (double)player.skill_rating, player.team_id);
+    }
+    fclose(feed);
+    basketball_system_init(&s->system);
+    return s;
+}
+static void system_bench_ingest(void *state, size_t begin, size_t end) {
+    IngestBenchState *s = (IngestBenchState *)state;
+    IngestReport report;
+    basketball_system_ingest(&s->system, s->path, NULL, &report);
+    if (report.records != end - begin) fprintf(stderr, "basketball/ingest_csv: %zu records read\n", report.records);
+}
+static void system_bench_ingest_reset(void *state) {
+    IngestBenchState *s = (IngestBenchState *)state;
+    basketball_system_free(&s->system);
+    basketball_system_init(&s->system);
+}
+static void system_bench_ingest_free(void *state) {
+    IngestBenchState *s = (IngestBenchState *)state;
+    basketball_system_free(&s->system);
+    remove(s->path);
+    free(s);
+}
+
+// Snapshot of a bulk-loaded system: save it, or mmap it back into a second system
+typedef struct {
+    BasketballSystem system;
+    BasketballSystem loaded; // Valid only between a load and the next reset/teardown
+    char path[32];
+} SnapshotBenchState;
+
+static void *snapshot_bench_new(size_t size) {
+    SnapshotBenchState *s = (SnapshotBenchState *)malloc(sizeof(SnapshotBenchState));
+    if (!s) {
+        fprintf(stderr, "snapshot_bench_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    strcpy(s->path, "/tmp/bench_snapshot_XXXXXX");
+    int fd = mkstemp(s->path);
+    if (fd >= 0) close(fd);
+    basketball_system_init(&s->system);
+    bench_add_players(&s->system, 0, size);
+    if (fd < 0 || !basketball_system_save(&s->system, s->path)) {
+        fprintf(stderr, "snapshot_bench_new: cannot write %s\n", s->path);
+        exit(EXIT_FAILURE);
+    }
+    return s;
+}
+static void snapshot_bench_save(void *state, size_t begin, size_t end) {
+    SnapshotBenchState *s = (SnapshotBenchState *)state;
+    (void)begin;
+    (void)end;
+    bench_sink += basketball_system_save(&s->system, s->path);
+}
+static void snapshot_bench_load(void *state, size_t begin, size_t end) {
+    SnapshotBenchState *s = (SnapshotBenchState *)state;
+    bench_sink += basketball_system_load_mmap(&s->loaded, s->path);
+    if (s->loaded.players.size != end - begin) {
+        fprintf(stderr, "snapshot/load: %zu players loaded\n", s->loaded.players.size);
+    }
+}
+static void snapshot_bench_unload(void *state) {
+    basketball_system_free(&((SnapshotBenchState *)state)->loaded);
+}
+static void snapshot_bench_free(void *state) {
+    SnapshotBenchState *s = (SnapshotBenchState *)state;
+    basketball_system_free(&s->system);
+    remove(s->path);
+    free(s);
+}
+static void snapshot_bench_load_free(void *state) {
+    snapshot_bench_unload(state);
+    snapshot_bench_free(state);
+}
+
+// ==================== CASE TABLE ====================
+
+static const BenchCase bench_cases[] = {
+    {"dynarray/push", dynarray_bench_empty, dynarray_bench_push, dynarray_bench_clear, dynarray_bench_free, 0, 0, false},
+    {"dynarray/get", dynarray_bench_full, dynarray_bench_get, NULL, dynarray_bench_free, 0, 0, false},
+    {"dynarray/sort_qsort", sort_bench_new, sort_bench_qsort, sort_bench_reset, sort_bench_free, 0, 0, true},
+    {"dynarray/sort", sort_bench_new, sort_bench_sort, sort_bench_reset, sort_bench_free, 0, 0, true},
+    {"dynarray/sort_stable", sort_bench_new, sort_bench_stable, sort_bench_reset, sort_bench_free, 0, 0, true},
+    {"dynarray/sort_by_key", sort_bench_new, sort_bench_by_key, sort_bench_reset, sort_bench_free, 0, 0, true},
+    {"dynarray/sort_parallel", sort_bench_new, sort_bench_parallel, sort_bench_reset, sort_bench_free, 0, 0, true},
+    {"int_array/qsort", int_sort_bench_new, int_sort_bench_qsort, int_sort_bench_reset, int_sort_bench_free, 0, 0, true},
+    {"int_array/sort", int_sort_bench_new, int_sort_bench_sort, int_sort_bench_reset, int_sort_bench_free, 0, 0, true},
+    {"stack/push", stack_bench_empty, stack_bench_push, stack_bench_clear, stack_bench_free, 0, 0, false},
+    {"stack/pop", stack_bench_full, stack_bench_pop, stack_bench_refill, stack_bench_free, 0, 0, false},
+    {"queue/enqueue", queue_bench_empty, queue_bench_enqueue, queue_bench_clear, queue_bench_free, 0, 0, false},
+    {"queue/dequeue", queue_bench_full, queue_bench_dequeue, queue_bench_refill, queue_bench_free, 0, 0, false},
+    {"deque/push_back", deque_bench_empty, deque_bench_push_back, deque_bench_clear, deque_bench_free, 0, 0, false},
+    {"deque/push_front", deque_bench_empty, deque_bench_push_front, deque_bench_clear, deque_bench_free, 0, 0, false},
+    {"deque/pop_front", deque_bench_full, deque_bench_pop_front, deque_bench_refill, deque_bench_free, 0, 0, false},
+    {"deque/get_at", deque_bench_full, deque_bench_get_at, NULL, deque_bench_free, 0, 0, false},
+    {"singly_list/push_front", singly_bench_empty, singly_bench_push_front, singly_bench_clear, singly_bench_free, 0, 0, false},
+    {"singly_list/pop_front", singly_bench_full, singly_bench_pop_front, singly_bench_refill, singly_bench_free, 0, 0, false},
+    {"doubly_list/push_back", doubly_bench_empty, doubly_bench_push_back, doubly_bench_clear, doubly_bench_free, 0, 0, false},
+    {"doubly_list/pop_front", doubly_bench_full, doubly_bench_pop_front, doubly_bench_refill, doubly_bench_free, 0, 0, false},
+    {"doubly_list/get_at", doubly_bench_full, doubly_bench_get_at, NULL, doubly_bench_free, 2000, 0, false},
+    {"circular_list/push_back", circular_bench_empty, circular_bench_push_back, circular_bench_clear, circular_bench_free, 0, 0, false},
+    {"circular_list/pop_front", circular_bench_full, circular_bench_pop_front, circular_bench_refill, circular_bench_free, 0, 0, false},
+    {"hashtable/put", hashtable_bench_empty, hashtable_bench_put, hashtable_bench_clear, hashtable_bench_free, 0, 0, false},
+    {"hashtable/get", hashtable_bench_full, hashtable_bench_get, NULL, hashtable_bench_free, 0, 0, false},
+    {"hashtable/remove", hashtable_bench_full, hashtable_bench_remove, hashtable_bench_refill, hashtable_bench_free, 0, 0, false},
+    {"flat_hashtable/put", flat_bench_empty, flat_bench_put, flat_bench_clear, flat_bench_free, 0, 0, false},
+    {"flat_hashtable/get", flat_bench_full, flat_bench_get, NULL, flat_bench_free, 0, 0, false},
+    {"hashset/add", hashset_bench_empty, hashset_bench_add, hashset_bench_clear, hashset_bench_free, 0, 0, false},
+    {"hashset/contains", hashset_bench_full, hashset_bench_contains, NULL, hashset_bench_free, 0, 0, false},
+    {"bitset/add", bitset_bench_empty, bitset_bench_add, bitset_bench_clear, bitset_bench_free, 0, 0, false},
+    {"bitset/contains", bitset_bench_full, bitset_bench_contains, NULL, bitset_bench_free, 0, 0, false},
+    {"roaring/add", roaring_bench_empty, roaring_bench_add, roaring_bench_clear, roaring_bench_free, 0, 0, false},
+    {"roaring/contains", roaring_bench_full, roaring_bench_contains, NULL, roaring_bench_free, 0, 0, false},
+    {"hashset/intersection", set_algebra_bench_new, set_algebra_bench_hash_and, set_algebra_bench_reset, set_algebra_bench_free, 0, 0, true},
+    {"hashset/union", set_algebra_bench_new, set_algebra_bench_hash_or, set_algebra_bench_reset, set_algebra_bench_free, 0, 0, true},
+    {"bitset/intersection", set_algebra_bench_new, set_algebra_bench_bits_and, set_algebra_bench_reset, set_algebra_bench_free, 0, 0, true},
+    {"bitset/union", set_algebra_bench_new, set_algebra_bench_bits_or, set_algebra_bench_reset, set_algebra_bench_free, 0, 0, true},
+    {"roaring/intersection", set_algebra_bench_new, set_algebra_bench_roar_and, set_algebra_bench_reset, set_algebra_bench_free, 0, 0, true},
+    {"roaring/union", set_algebra_bench_new, set_algebra_bench_roar_or, set_algebra_bench_reset, set_algebra_bench_free, 0, 0, true},
+    {"hashset/contains_miss", filter_bench_new, filter_bench_hashset_miss, NULL, filter_bench_free, 0, 0, false},
+    {"filtered_hashset/contains_miss", filter_bench_new, filter_bench_cuckoo_miss, NULL, filter_bench_free, 0, 0, false},
+    {"flat_hashtable/get_miss", filter_bench_new, filter_bench_flat_miss, NULL, filter_bench_free, 0, 0, false},
+    {"flat_hashtable/get_miss_bloom", filter_bench_new, filter_bench_bloom_miss, NULL, filter_bench_free, 0, 0, false},
+    {"concurrent_hashtable/rwlock_1_shard_1t", cht_bench_rwlock_one_shard, cht_bench_mixed_1t, cht_bench_reclaim, cht_bench_free, 0, 0, true},
+    {"concurrent_hashtable/rwlock_1_shard_4t", cht_bench_rwlock_one_shard, cht_bench_mixed_4t, cht_bench_reclaim, cht_bench_free, 0, 0, true},
+    {"concurrent_hashtable/rwlock_1_shard_16t", cht_bench_rwlock_one_shard, cht_bench_mixed_16t, cht_bench_reclaim, cht_bench_free, 0, 0, true},
+    {"concurrent_hashtable/rwlock_1t", cht_bench_rwlock, cht_bench_mixed_1t, cht_bench_reclaim, cht_bench_free, 0, 0, true},
+    {"concurrent_hashtable/rwlock_4t", cht_bench_rwlock, cht_bench_mixed_4t, cht_bench_reclaim, cht_bench_free, 0, 0, true},
+    {"concurrent_hashtable/rwlock_16t", cht_bench_rwlock, cht_bench_mixed_16t, cht_bench_reclaim, cht_bench_free, 0, 0, true},
+    {"concurrent_hashtable/seqlock_1t", cht_bench_seqlock, cht_bench_mixed_1t, cht_bench_reclaim, cht_bench_free, 0, 0, true},
+    {"concurrent_hashtable/seqlock_4t", cht_bench_seqlock, cht_bench_mixed_4t, cht_bench_reclaim, cht_bench_free, 0, 0, true},
+    {"concurrent_hashtable/seqlock_16t", cht_bench_seqlock, cht_bench_mixed_16t, cht_bench_reclaim, cht_bench_free, 0, 0, true},
+    {"min_heap/push", min_heap_bench_empty, min_heap_bench_push, min_heap_bench_clear, min_heap_bench_free, 0, 0, false},
+    {"min_heap/pop", min_heap_bench_full, min_heap_bench_pop, min_heap_bench_refill, min_heap_bench_free, 0, 0, false},
+    {"min_heap/build_merge", top_k_bench_new, heap_merge_bench_build, NULL, top_k_bench_free, 0, 0, true},
+    {"max_heap/push", max_heap_bench_empty, max_heap_bench_push, max_heap_bench_clear, max_heap_bench_free, 0, 0, false},
+    {"max_heap/pop", max_heap_bench_full, max_heap_bench_pop, max_heap_bench_refill, max_heap_bench_free, 0, 0, false},
+    {"max_heap/select_top_k", top_k_bench_new, top_k_bench_select, NULL, top_k_bench_free, 4, 0, false},
+    {"max_heap/top_k", top_k_bench_new, top_k_bench_walk, NULL, top_k_bench_free, 0, 0, false},
+    {"dary_heap/push", dary_heap_bench_empty, dary_heap_bench_push, dary_heap_bench_clear, dary_heap_bench_free, 0, 0, false},
+    {"dary_heap/pop", dary_heap_bench_full, dary_heap_bench_pop, dary_heap_bench_refill, dary_heap_bench_free, 0, 0, false},
+    {"dary_heap/push_8ary", dary8_heap_bench_empty, dary_heap_bench_push, dary_heap_bench_clear, dary_heap_bench_free, 0, 0, false},
+    {"dary_heap/pop_8ary", dary8_heap_bench_full, dary_heap_bench_pop, dary_heap_bench_refill, dary_heap_bench_free, 0, 0, false},
+    {"indexed_heap/push", indexed_heap_bench_empty, indexed_heap_bench_push, indexed_heap_bench_clear, indexed_heap_bench_free, 0, 0, false},
+    {"indexed_heap/update_key", indexed_heap_bench_full, indexed_heap_bench_update_key, NULL, indexed_heap_bench_free, 0, 0, false},
+    {"tree/insert", tree_bench_empty, tree_bench_insert, tree_bench_clear, tree_bench_free, 0, 0, false},
+    {"tree/search", tree_bench_full, tree_bench_search, NULL, tree_bench_free, 0, 0, false},
+    {"tree/search_balanced", tree_bench_balanced, tree_bench_search, NULL, tree_bench_free, 0, 0, false},
+    {"static_tree/search", static_tree_bench_full, static_tree_bench_search, NULL, static_tree_bench_free, 0, 0, false},
+    {"static_tree/search_many", static_tree_bench_full, static_tree_bench_search_many, NULL, static_tree_bench_free, 0, 0, false},
+    {"avl/insert", avl_bench_empty, avl_bench_insert, avl_bench_clear, avl_bench_free, 0, 0, false},
+    {"avl/search", avl_bench_full, avl_bench_search, NULL, avl_bench_free, 0, 0, false},
+    {"btree/insert", btree_bench_empty, btree_bench_insert, btree_bench_clear, btree_bench_free, 0, 0, false},
+    {"btree/search", btree_bench_full, btree_bench_search, NULL, btree_bench_free, 0, 0, false},
+    {"btree/scan", btree_bench_full, btree_bench_scan, NULL, btree_bench_free, 0, 0, true},
+    {"avl_order/insert", avl_order_bench_empty, avl_order_bench_insert, avl_order_bench_clear, avl_order_bench_free, 0, 0, false},
+    {"avl_order/rank", avl_order_bench_full, avl_order_bench_rank, NULL, avl_order_bench_free, 0, 0, false},
+    {"avl_order/select", avl_order_bench_full, avl_order_bench_select, NULL, avl_order_bench_free, 0, 0, false},
+    {"trie/insert", trie_bench_empty, trie_bench_insert, trie_bench_clear, trie_bench_free, 0, 0, false},
+    {"trie/get", trie_bench_full, trie_bench_get, NULL, trie_bench_free, 0, 0, false},
+    {"trie/top_k", trie_bench_full, trie_bench_top_k, NULL, trie_bench_free, 0, 0, false},
+    {"trie/top_k_scan", trie_bench_full, trie_bench_top_k_scan, NULL, trie_bench_free, 10, 0, false},
+    {"unionfind/union", unionfind_bench_new, unionfind_bench_union, unionfind_bench_reset, unionfind_bench_free, 0, 0, false},
+    {"unionfind/find", unionfind_bench_joined, unionfind_bench_find, NULL, unionfind_bench_free, 0, 0, false},
+    {"unionfind/union_edges_1t", union_edges_bench_new, union_edges_bench_1t, union_edges_bench_reset, union_edges_bench_free, 0, 0, true},
+    {"unionfind/union_edges_4t", union_edges_bench_new, union_edges_bench_4t, union_edges_bench_reset, union_edges_bench_free, 0, 0, true},
+    {"range_sum/scan", range_bench_new, range_bench_scan, NULL, range_bench_free, 200, 0, false},
+    {"range_sum/segtree", range_bench_new, range_bench_segtree, NULL, range_bench_free, 0, 0, false},
+    {"range_sum/fenwick", range_bench_new, range_bench_fenwick, NULL, range_bench_free, 0, 0, false},
+    {"lis/compute_length", lis_bench_positions, lis_bench_compute_length, NULL, lis_bench_positions_free, 0, 0, true},
+    {"lis/compute_sequence", lis_bench_positions, lis_bench_compute_sequence, NULL, lis_bench_positions_free, 0, 0, true},
+    {"lis/push", lis_bench_new, lis_bench_push, lis_bench_reset, lis_bench_free, 0, 0, false},
+    {"poly/naive", poly_bench_new, poly_bench_naive, NULL, poly_bench_free, 1, 16384, false},
+    {"poly/karatsuba", poly_bench_new, poly_bench_karatsuba, NULL, poly_bench_free, 1, 131072, false},
+    {"poly/fft", poly_bench_new, poly_bench_fft, NULL, poly_bench_free, 1, 0, false},
+    {"poly/ntt", poly_bench_new, poly_bench_ntt, NULL, poly_bench_free, 1, 0, false},
+    {"graph/new_edge", graph_bench_new, graph_bench_new_edge, graph_bench_rebuild, graph_bench_free, 0, 0, false},
+    {"csr_graph/build", csr_build_bench_new, csr_build_bench_build, csr_build_bench_reset, csr_build_bench_free, 0, 0, true},
+    {"csr_graph/bfs", csr_bench_new, csr_bench_bfs, NULL, csr_bench_free, 4, 0, false},
+    {"csr_graph/dfs", csr_bench_new, csr_bench_dfs, NULL, csr_bench_free, 4, 0, false},
+    {"csr_graph/dijkstra", csr_bench_new, csr_bench_dijkstra, NULL, csr_bench_free, 4, 0, false},
+    {"csr_graph/connected_components", csr_bench_new, csr_bench_components, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/bfs_1t", csr_bench_new_1t, csr_bench_parallel_bfs, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/bfs_2t", csr_bench_new_2t, csr_bench_parallel_bfs, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/bfs_4t", csr_bench_new_4t, csr_bench_parallel_bfs, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/bfs_8t", csr_bench_new_8t, csr_bench_parallel_bfs, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/connected_components_1t", csr_bench_new_1t, csr_bench_parallel_components, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/connected_components_2t", csr_bench_new_2t, csr_bench_parallel_components, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/connected_components_4t", csr_bench_new_4t, csr_bench_parallel_components, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/connected_components_8t", csr_bench_new_8t, csr_bench_parallel_components, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/pagerank_1t", csr_bench_new_1t, csr_bench_parallel_pagerank, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/pagerank_2t", csr_bench_new_2t, csr_bench_parallel_pagerank, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/pagerank_4t", csr_bench_new_4t, csr_bench_parallel_pagerank, NULL, csr_bench_free, 4, 0, false},
+    {"parallel_graph/pagerank_8t", csr_bench_new_8t, csr_bench_parallel_pagerank, NULL, csr_bench_free, 4, 0, false},
+    {"column_filter/row_scan", column_bench_new, column_bench_row_scan, NULL, column_bench_free, 0, 0, false},
+    {"column_filter/filter", column_bench_new, column_bench_filter, NULL, column_bench_free, 0, 0, false},
+    {"basketball/add_players_bulk", system_bench_bulk_new, system_bench_bulk_load, system_bench_bulk_reset, system_bench_bulk_free, 0, 1000000, true},
+    {"basketball/ingest_csv", system_bench_ingest_new, system_bench_ingest, system_bench_ingest_reset, system_bench_ingest_free, 0, 1000000, true},
+    {"snapshot/save", snapshot_bench_new, snapshot_bench_save, NULL, snapshot_bench_free, 0, 1000000, true},
+    {"snapshot/load", snapshot_bench_new, snapshot_bench_load, snapshot_bench_unload, snapshot_bench_load_free, 0, 1000000, true},
+    {"basketball/find_player_by_id", system_bench_shared, system_bench_find_by_id, NULL, system_bench_keep, 0, 0, false},
+    {"basketball/find_player_by_name", system_bench_shared, system_bench_find_by_name, NULL, system_bench_keep, 0, 0, false},
+    {"basketball/find_player_by_name_miss", system_bench_shared, system_bench_find_by_name_miss, NULL, system_bench_keep, 0, 0, false},
+    {"basketball/get_top_players_by_name_prefix", system_bench_shared, system_bench_name_completion, NULL, system_bench_keep, 0, 0, false},
+    {"basketball/get_players_by_nationality", system_bench_shared, system_bench_by_nationality, NULL, system_bench_keep, 0, 0, false},
+    {"basketball/get_most_skilled_player", system_bench_shared, system_bench_most_skilled, NULL, system_bench_keep, 0, 0, false},
+    {"basketball/get_player_by_skill_rank", system_bench_shared, system_bench_skill_rank, NULL, system_bench_keep, 0, 0, false},
+    {"basketball/count_players_in_age_range", system_bench_shared, system_bench_count_age_range, NULL, system_bench_keep, 0, 0, false},
+    {"basketball/count_players_matching", system_bench_shared, system_bench_count_matching, NULL, system_bench_keep, 20, 0, false},
+    {"basketball/select_players", system_bench_shared, system_bench_select, NULL, system_bench_keep, 20, 0, false},
+    {"basketball/update_player_skill", system_bench_shared, system_bench_update_skill, NULL, system_bench_keep, 0, 0, false},
+    {"basketball/process_all_trades", system_bench_shared, system_bench_trades, NULL, system_bench_keep, 65536, 0, false},
+};
+
+#define BENCH_CASE_COUNT (sizeof(bench_cases) / sizeof(bench_cases[0]))
+
+// ==================== OUTPUT ====================
+
+// Write results as JSON, one result object per line
+static bool bench_write_json(const char *path, const BenchOptions *options, const BenchResult *results, size_t count) {
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+    fprintf(file, "{\n  \"suite\": \"data_structures\",\n  \"format\": 1,\n");
+    fprintf(file, "  \"repetitions\": %d,\n  \"warmup\": %d,\n  \"batches\": %d,\n", options->repetitions,
+            options->warmup, BENCH_BATCHES);
+    fprintf(file, "  \"allocation_counting\": %s,\n  \"scales\": [", BENCH_COUNTING ? "true" : "false");
+    for (size_t i = 0; i < options->scale_count; i++) fprintf(file, "%s%zu", i ? ", " : "", options->scales[i]);
+    fprintf(file, "],\n  \"results\": [\n");
+    for (size_t i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(file,
+                "    {\"name\": \"%s\", \"size\": %zu, \"ops\": %zu, \"samples\": %zu, "
+                "\"ns_per_op\": {\"min\": %.2f, \"median\": %.2f, \"p99\": %.2f, \"mean\": %.2f}, ",
+                r->name, r->size, r->ops, r->samples, r->min_ns, r->median_ns, r->p99_ns, r->mean_ns);
+        if (BENCH_COUNTING) {
+            fprintf(file, "\"allocs_per_op\": %.3f}%s\n", r->allocs_per_op, i + 1 < count ? "," : "");
+        } else {
+            fprintf(file, "\"allocs_per_op\": null}%s\n", i + 1 < count ? "," : "");
+        }
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+// Compare medians against a file written by bench_write_json
+// Returns the number of results slower than the threshold, or -1 if the file cannot be read
+static int bench_compare_baseline(const char *path, double threshold, const BenchResult *results, size_t count) {
+    FILE *file = fopen(path, "r");
+    if (!file) return -1;
+
+    int regressions = 0;
+    size_t matched = 0;
+    char line[512];
+    printf("\nComparison with %s (median ns/op, threshold %.1f%%):\n", path, threshold);
+    while (fgets(line, sizeof(line), file)) {
+        char name[128];
+        size_t size;
+        const char *median = strstr(line, "\"median\": ");
+        if (!median || sscanf(line, " {\"name\": \"%127[^\"]\", \"size\": %zu", name, &size) != 2) continue;
+        double before = strtod(median + strlen("\"median\": "), NULL);
+        for (size_t i = 0; i < count; i++) {
+            if (results[i].size != size || strcmp(results[i].name, name) != 0) continue;
+            double change = before > 0.0 ? (results[i].median_ns - before) / before * 100.0 : 0.0;
+            matched++;
+            if (change > threshold) {
+                printf("  REGRESSION %-40s %9zu  %10.2f -> %10.2f  (%+.1f%%)\n", name, size, before,
+                       results[i].median_ns, change);
+                regressions++;
+            } else if (change < -threshold) {
+                printf("  improved   %-40s %9zu  %10.2f -> %10.2f  (%+.1f%%)\n", name, size, before,
+                       results[i].median_ns, change);
+            }
+            break;
+        }
+    }
+    fclose(file);
+    printf("%zu results compared, %d regressions\n", matched, regressions);
+    return regressions;
+}
+
+// ==================== MAIN ====================
+
+static bool bench_parse_scales(const char *text, BenchOptions *options) {
+    options->scale_count = 0;
+    while (*text) {
+        char *end;
+        unsigned long long scale = strtoull(text, &end, 10);
+        if (end == text || scale == 0 || options->scale_count == BENCH_MAX_SCALES) return false;
+        options->scales[options->scale_count++] = (size_t)scale;
+        text = (*end == ',') ? end + 1 : end;
+        if (*end && *end != ',') return false;
+    }
+    return options->scale_count > 0;
+}
+
+static void bench_usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [--scales N[,N...]] [--reps N] [--warmup N] [--filter TEXT]\n"
+            "          [--output FILE] [--baseline FILE] [--threshold PERCENT]\n",
+            program);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions options = {{10000, 1000000}, 2, BENCH_DEFAULT_REPETITIONS, BENCH_DEFAULT_WARMUP,
+                            NULL, "bench_results.json", NULL, BENCH_DEFAULT_THRESHOLD};
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        bool ok = value != NULL;
+        if (strcmp(arg, "--scales") == 0 && value) {
+            ok = bench_parse_scales(value, &options);
+        } else if (strcmp(arg, "--reps") == 0 && value) {
+            options.repetitions = atoi(value);
+            ok = options.repetitions > 0;
+        } else if (strcmp(arg, "--warmup") == 0 && value) {
+            options.warmup = atoi(value);
+            ok = options.warmup >= 0;
+        } else if (strcmp(arg, "--filter") == 0 && value) {
+            options.filter = value;
+        } else if (strcmp(arg, "--output") == 0 && value) {
+            options.output = value;
+        } else if (strcmp(arg, "--baseline") == 0 && value) {
+            options.baseline = value;
+        } else if (strcmp(arg, "--threshold") == 0 && value) {
+            options.threshold = atof(value);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            bench_usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+
+    BenchResult *results = (BenchResult *)malloc(BENCH_CASE_COUNT * options.scale_count * sizeof(BenchResult));
+    if (!results) {
+        fprintf(stderr, "benchmark: allocation failed\n");
+        return 1;
+    }
+    size_t result_count = 0;
+
+    printf("%-40s %10s %10s %10s %10s %10s\n", "benchmark", "size", "median ns", "p99 ns", "mean ns", "allocs/op");
+    for (size_t s = 0; s < options.scale_count; s++) {
+        size_t size = options.scales[s];
+        for (size_t c = 0; c < BENCH_CASE_COUNT; c++) {
+            const BenchCase *bench = &bench_cases[c];
+            if (options.filter && !strstr(bench->name, options.filter)) continue;
+            if (bench->max_size && size > bench->max_size) continue;
+            BenchResult *r = &results[result_count++];
+            bench_run_case(bench, size, &options, r);
+            printf("%-40s %10zu %10.2f %10.2f %10.2f %10.3f\n", r->name, r->size, r->median_ns, r->p99_ns,
+                   r->mean_ns, r->allocs_per_op);
+        }
+        bench_system_release();
+    }
+
+    if (!bench_write_json(options.output, &options, results, result_count)) {
+        fprintf(stderr, "benchmark: cannot write %s\n", options.output);
+        free(results);
+        return 1;
+    }
+    printf("\nWrote %zu results to %s\n", result_count, options.output);
+
+    int status = 0;
+    if (options.baseline) {
+        int regressions = bench_compare_baseline(options.baseline, options.threshold, results, result_count);
+        if (regressions < 0) {
+            fprintf(stderr, "benchmark: cannot read %s\n", options.baseline);
+            status = 1;
+        } else if (regressions > 0) {
+            status = 3;
+        }
+    }
+    free(results);
+    return status;
+}
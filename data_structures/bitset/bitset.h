@@ -0,0 +1,483 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * BITSET INTEGER SET
+ *
+ * Set of small non-negative integers stored as one bit per possible value.
+ * Mirrors the hash/hashset.h API (add / remove / contains / union /
+ * intersection / difference / subset / equals / copy) so dense id sets can
+ * switch over, but elements are unboxed and the set algebra runs a word
+ * (or, with AVX2, four words) at a time instead of probing per element.
+ *
+ * The bit array grows to the largest value added, so memory is
+ * max_value / 8 bytes whatever the cardinality; use bitset/roaring.h when
+ * values are sparse over a wide range. The cardinality is kept exact by
+ * add/remove and recounted with popcount after set operations, on the next
+ * bitset_size call.
+ *
+ * SIMD paths: AVX2 word kernels and a nibble-table popcount, scalar fallback
+ * (define BITSET_NO_SIMD to force it). Both paths give identical results.
+ *
+ * Time Complexities:
+ * - Add / remove / contains: O(1) (add amortized when the array grows)
+ * - Union / intersection / difference / subset / equals: O(max_value / 64)
+ * - Size: O(1), O(max_value / 64) right after a set operation
+ *
+ * Space Complexity: O(max_value / 64) words
+ */
+
+#if !defined(BITSET_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define BITSET_AVX2 1
+#endif
+
+#define BITSET_DEFAULT_WORDS 4
+#define BITSET_SIZE_UNKNOWN SIZE_MAX
+
+// Bitset structure
+typedef struct BitSet {
+    uint64_t *words;    // Bit v of words[v / 64] is set when v is in the set
+    size_t word_count;  // Words allocated, all beyond the largest value zero
+    size_t cardinality; // Elements, or BITSET_SIZE_UNKNOWN until recounted
+} BitSet;
+
+// Iterator over set values in ascending order
+typedef struct BitSetIterator {
+    const BitSet *set;
+    size_t word;   // Index of the word in bits
+    uint64_t bits; // Not yet visited bits of that word
+} BitSetIterator;
+
+// ==================== WORD KERNELS ====================
+
+/**
+ * dst = a | b over n words (dst may alias a or b)
+ * @param dst: Output words
+ * @param a: First operand
+ * @param b: Second operand
+ * @param n: Word count
+ */
+static inline void bitset_words_or(uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t n) {
+    size_t i = 0;
+#ifdef BITSET_AVX2
+    for (; i < (n & ~(size_t)3); i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_or_si256(x, y));
+    }
+#endif
+    for (; i < n; i++) dst[i] = a[i] | b[i];
+}
+
+/**
+ * dst = a & b over n words (dst may alias a or b)
+ * @param dst: Output words
+ * @param a: First operand
+ * @param b: Second operand
+ * @param n: Word count
+ */
+static inline void bitset_words_and(uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t n) {
+    size_t i = 0;
+#ifdef BITSET_AVX2
+    for (; i < (n & ~(size_t)3); i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_and_si256(x, y));
+    }
+#endif
+    for (; i < n; i++) dst[i] = a[i] & b[i];
+}
+
+/**
+ * dst = a & ~b over n words (dst may alias a or b)
+ * @param dst: Output words
+ * @param a: Words to keep from
+ * @param b: Words to clear
+ * @param n: Word count
+ */
+static inline void bitset_words_andnot(uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t n) {
+    size_t i = 0;
+#ifdef BITSET_AVX2
+    for (; i < (n & ~(size_t)3); i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_andnot_si256(y, x));
+    }
+#endif
+    for (; i < n; i++) dst[i] = a[i] & ~b[i];
+}
+
+/**
+ * Number of set bits in n words
+ * @param words: Words to count
+ * @param n: Word count
+ * @return: Population count
+ */
+static inline size_t bitset_words_count(const uint64_t *words, size_t n) {
+    size_t i = 0, count = 0;
+#ifdef BITSET_AVX2
+    // Per-nibble counts from a shuffle table, summed per 64-bit lane by SAD
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+    for (; i < (n & ~(size_t)3); i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(words + i));
+        __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+        __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+    count = (size_t)(_mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1) +
+                     _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3));
+#endif
+    for (; i < n; i++) count += (size_t)__builtin_popcountll(words[i]);
+    return count;
+}
+
+/**
+ * Check that no bit of a is missing from b over n words
+ * @param a: Candidate subset words
+ * @param b: Candidate superset words
+ * @param n: Word count
+ * @return: true if a & ~b is zero
+ */
+static inline bool bitset_words_subset(const uint64_t *a, const uint64_t *b, size_t n) {
+    size_t i = 0;
+#ifdef BITSET_AVX2
+    for (; i < (n & ~(size_t)3); i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + i));
+        if (!_mm256_testc_si256(y, x)) return false;
+    }
+#endif
+    for (; i < n; i++) {
+        if (a[i] & ~b[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * Check that n words are all zero (internal helper)
+ * @param words: Words to check
+ * @param n: Word count
+ * @return: true if no bit is set
+ */
+static inline bool bitset_words_empty(const uint64_t *words, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (words[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * Name of the compiled word-kernel path, for benchmark labels
+ * @return: "avx2" or "scalar"
+ */
+static inline const char *bitset_simd_path(void) {
+#ifdef BITSET_AVX2
+    return "avx2";
+#else
+    return "scalar";
+#endif
+}
+
+// ==================== CORE OPERATIONS ====================
+
+/**
+ * Initialize empty bitset
+ * @param set: Set to initialize
+ * @param initial_range: Values expected below this bound (0 uses default)
+ */
+static inline void bitset_init(BitSet *set, size_t initial_range) {
+    set->word_count = initial_range > 0 ? (initial_range + 63) / 64 : BITSET_DEFAULT_WORDS;
+    set->words = (uint64_t *)calloc(set->word_count, sizeof(uint64_t));
+    if (!set->words) {
+        fprintf(stderr, "bitset_init: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    set->cardinality = 0;
+}
+
+/**
+ * Grow the bit array to at least word_count words (internal helper)
+ * @param set: Target set
+ * @param word_count: Words needed
+ */
+static inline void bitset_reserve_words(BitSet *set, size_t word_count) {
+    if (word_count <= set->word_count) return;
+    size_t grown = set->word_count * 2;
+    if (grown < word_count) grown = word_count;
+    uint64_t *words = (uint64_t *)realloc(set->words, grown * sizeof(uint64_t));
+    if (!words) {
+        fprintf(stderr, "bitset_reserve_words: reallocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(words + set->word_count, 0, (grown - set->word_count) * sizeof(uint64_t));
+    set->words = words;
+    set->word_count = grown;
+}
+
+/**
+ * Add value to set
+ * @param set: Target set
+ * @param value: Value to add
+ * @return: true if added (false if already exists)
+ */
+static inline bool bitset_add(BitSet *set, uint32_t value) {
+    size_t word = value / 64;
+    uint64_t bit = 1ULL << (value % 64);
+    bitset_reserve_words(set, word + 1);
+    if (set->words[word] & bit) return false;
+    set->words[word] |= bit;
+    if (set->cardinality != BITSET_SIZE_UNKNOWN) set->cardinality++;
+    return true;
+}
+
+/**
+ * Remove value from set
+ * @param set: Target set
+ * @param value: Value to remove
+ * @return: true if removed (false if didn't exist)
+ */
+static inline bool bitset_remove(BitSet *set, uint32_t value) {
+    size_t word = value / 64;
+    uint64_t bit = 1ULL << (value % 64);
+    if (word >= set->word_count || !(set->words[word] & bit)) return false;
+    set->words[word] &= ~bit;
+    if (set->cardinality != BITSET_SIZE_UNKNOWN) set->cardinality--;
+    return true;
+}
+
+/**
+ * Check if value exists in set
+ * @param set: Target set
+ * @param value: Value to check
+ * @return: true if value exists
+ */
+static inline bool bitset_contains(const BitSet *set, uint32_t value) {
+    size_t word = value / 64;
+    return word < set->word_count && (set->words[word] >> (value % 64) & 1);
+}
+
+/**
+ * Get set size (recounts once after a set operation)
+ * @param set: Target set
+ * @return: Number of elements
+ */
+static inline size_t bitset_size(BitSet *set) {
+    if (set->cardinality == BITSET_SIZE_UNKNOWN) {
+        set->cardinality = bitset_words_count(set->words, set->word_count);
+    }
+    return set->cardinality;
+}
+
+/**
+ * Check if set is empty
+ * @param set: Target set
+ * @return: true if empty
+ */
+static inline bool bitset_is_empty(const BitSet *set) {
+    if (set->cardinality != BITSET_SIZE_UNKNOWN) return set->cardinality == 0;
+    return bitset_words_empty(set->words, set->word_count);
+}
+
+/**
+ * Remove all elements (keeps the bit array)
+ * @param set: Target set
+ */
+static inline void bitset_clear(BitSet *set) {
+    memset(set->words, 0, set->word_count * sizeof(uint64_t));
+    set->cardinality = 0;
+}
+
+/**
+ * Free set memory
+ * @param set: Set to free
+ */
+static inline void bitset_free(BitSet *set) {
+    free(set->words);
+    set->words = NULL;
+    set->word_count = 0;
+    set->cardinality = 0;
+}
+
+// ==================== SET OPERATIONS ====================
+
+/**
+ * Union of two sets (result = set1 ∪ set2)
+ * @param set1: First set
+ * @param set2: Second set
+ * @param result: Resulting union set (should be initialized; its contents are
+ *                replaced, and it may be set1 or set2)
+ */
+static inline void bitset_union(BitSet *set1, BitSet *set2, BitSet *result) {
+    size_t n1 = set1->word_count, n2 = set2->word_count;
+    size_t common = n1 < n2 ? n1 : n2, total = n1 > n2 ? n1 : n2;
+    const BitSet *longer = n1 >= n2 ? set1 : set2;
+    bitset_reserve_words(result, total);
+    bitset_words_or(result->words, set1->words, set2->words, common);
+    if (longer != result) {
+        memcpy(result->words + common, longer->words + common, (total - common) * sizeof(uint64_t));
+    }
+    memset(result->words + total, 0, (result->word_count - total) * sizeof(uint64_t));
+    result->cardinality = BITSET_SIZE_UNKNOWN;
+}
+
+/**
+ * Intersection of two sets (result = set1 ∩ set2)
+ * @param set1: First set
+ * @param set2: Second set
+ * @param result: Resulting intersection set (should be initialized; its contents
+ *                are replaced, and it may be set1 or set2)
+ */
+static inline void bitset_intersection(BitSet *set1, BitSet *set2, BitSet *result) {
+    size_t common = set1->word_count < set2->word_count ? set1->word_count : set2->word_count;
+    bitset_reserve_words(result, common);
+    bitset_words_and(result->words, set1->words, set2->words, common);
+    memset(result->words + common, 0, (result->word_count - common) * sizeof(uint64_t));
+    result->cardinality = BITSET_SIZE_UNKNOWN;
+}
+
+/**
+ * Difference of two sets (result = set1 - set2)
+ * @param set1: First set
+ * @param set2: Second set
+ * @param result: Resulting difference set (should be initialized; its contents
+ *                are replaced, and it may be set1 or set2)
+ */
+static inline void bitset_difference(BitSet *set1, BitSet *set2, BitSet *result) {
+    size_t n1 = set1->word_count;
+    size_t common = n1 < set2->word_count ? n1 : set2->word_count;
+    bitset_reserve_words(result, n1);
+    bitset_words_andnot(result->words, set1->words, set2->words, common);
+    if (set1 != result) {
+        memcpy(result->words + common, set1->words + common, (n1 - common) * sizeof(uint64_t));
+    }
+    memset(result->words + n1, 0, (result->word_count - n1) * sizeof(uint64_t));
+    result->cardinality = BITSET_SIZE_UNKNOWN;
+}
+
+/**
+ * Check if set1 is subset of set2
+ * @param set1: Potential subset
+ * @param set2: Potential superset
+ * @return: true if set1 ⊆ set2
+ */
+static inline bool bitset_is_subset(const BitSet *set1, const BitSet *set2) {
+    size_t common = set1->word_count < set2->word_count ? set1->word_count : set2->word_count;
+    return bitset_words_subset(set1->words, set2->words, common) &&
+           bitset_words_empty(set1->words + common, set1->word_count - common);
+}
+
+/**
+ * Check if two sets are equal
+ * @param set1: First set
+ * @param set2: Second set
+ * @return: true if sets are equal
+ */
+static inline bool bitset_equals(const BitSet *set1, const BitSet *set2) {
+    const BitSet *shorter = set1->word_count <= set2->word_count ? set1 : set2;
+    const BitSet *longer = shorter == set1 ? set2 : set1;
+    return memcmp(set1->words, set2->words, shorter->word_count * sizeof(uint64_t)) == 0 &&
+           bitset_words_empty(longer->words + shorter->word_count, longer->word_count - shorter->word_count);
+}
+
+// ==================== ITERATION ====================
+
+/**
+ * Start iterating a set in ascending order
+ * @param it: Iterator to initialize
+ * @param set: Set to visit (must not change during iteration)
+ */
+static inline void bitset_iter_init(BitSetIterator *it, const BitSet *set) {
+    it->set = set;
+    it->word = 0;
+    it->bits = set->word_count > 0 ? set->words[0] : 0;
+}
+
+/**
+ * Advance to the next value
+ * @param it: Iterator
+ * @param value: Receives the value
+ * @return: true if a value was produced, false at the end
+ */
+static inline bool bitset_iter_next(BitSetIterator *it, uint32_t *value) {
+    while (it->bits == 0) {
+        if (++it->word >= it->set->word_count) return false;
+        it->bits = it->set->words[it->word];
+    }
+    *value = (uint32_t)(it->word * 64 + (size_t)__builtin_ctzll(it->bits));
+    it->bits &= it->bits - 1;
+    return true;
+}
+
+/**
+ * Write the values in ascending order
+ * @param set: Source set
+ * @param out: Receives bitset_size(set) values
+ * @return: Number of values written
+ */
+static inline size_t bitset_to_array(const BitSet *set, uint32_t *out) {
+    size_t count = 0;
+    for (size_t w = 0; w < set->word_count; w++) {
+        for (uint64_t bits = set->words[w]; bits; bits &= bits - 1) {
+            out[count++] = (uint32_t)(w * 64 + (size_t)__builtin_ctzll(bits));
+        }
+    }
+    return count;
+}
+
+// ==================== CONVENIENCE FUNCTIONS ====================
+
+/**
+ * Add integer to set
+ * @param set: Integer set
+ * @param value: Integer to add (negative values are rejected)
+ * @return: true if added
+ */
+static inline bool bitset_add_int(BitSet *set, int value) {
+    return value >= 0 && bitset_add(set, (uint32_t)value);
+}
+
+/**
+ * Remove integer from set
+ * @param set: Integer set
+ * @param value: Integer to remove
+ * @return: true if removed
+ */
+static inline bool bitset_remove_int(BitSet *set, int value) {
+    return value >= 0 && bitset_remove(set, (uint32_t)value);
+}
+
+/**
+ * Check if integer exists in set
+ * @param set: Integer set
+ * @param value: Integer to check
+ * @return: true if exists
+ */
+static inline bool bitset_contains_int(const BitSet *set, int value) {
+    return value >= 0 && bitset_contains(set, (uint32_t)value);
+}
+
+// ==================== UTILITY FUNCTIONS ====================
+
+/**
+ * Create copy of set
+ * @param source: Source set
+ * @param dest: Destination set (should be uninitialized)
+ */
+static inline void bitset_copy(const BitSet *source, BitSet *dest) {
+    bitset_init(dest, source->word_count * 64);
+    memcpy(dest->words, source->words, source->word_count * sizeof(uint64_t));
+    dest->cardinality = source->cardinality;
+}
+
+#endif // BITSET_H
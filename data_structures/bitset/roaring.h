@@ -0,0 +1,793 @@
+#ifndef ROARING_H
+#define ROARING_H
+
+#include "bitset.h"
+
+/**
+ * ROARING-STYLE COMPRESSED INTEGER SET
+ *
+ * Set of 32-bit unsigned integers split by their high 16 bits into chunks of
+ * 65536 values. Each non-empty chunk is one container, kept sorted by key:
+ * - array container: sorted uint16_t low halves, while it holds at most
+ *   ROARING_ARRAY_MAX values (8 KB at most)
+ * - bitmap container: 1024 words (8 KB) once it holds more
+ * So a sparse range costs two bytes per value and a dense one an eighth of a
+ * byte, and an empty range costs nothing. Containers convert both ways as
+ * they cross ROARING_ARRAY_MAX.
+ *
+ * The API parallels hash/hashset.h and bitset/bitset.h. Set operations merge
+ * the two container lists by key: bitmap pairs go through the bitset word
+ * kernels (AVX2 when built with it), pairs involving an array merge or probe
+ * per element. Run-length containers are not implemented.
+ *
+ * Time Complexities (C = containers, n = values in the touched container):
+ * - Add / remove: O(log C + n) for arrays, O(log C) for bitmaps
+ * - Contains: O(log C + log n)
+ * - Union / intersection / difference: O(C) container merges, each O(1024)
+ *   words for bitmaps or O(n) for arrays
+ * - Size: O(1)
+ *
+ * Space Complexity: O(n) values, at most 8 KB per 65536-value chunk
+ */
+
+#define ROARING_ARRAY_MAX 4096    // Past this a bitmap is smaller than the array
+#define ROARING_BITMAP_WORDS 1024 // 65536 bits
+#define ROARING_DEFAULT_CONTAINERS 4
+
+// One chunk of 65536 values sharing their high 16 bits
+typedef struct RoaringContainer {
+    uint16_t key;         // High 16 bits of the values
+    bool is_bitmap;
+    uint32_t cardinality; // Values held (1..65536)
+    uint32_t capacity;    // Array slots allocated (array containers)
+    union {
+        uint16_t *values; // Sorted low halves (array container)
+        uint64_t *words;  // ROARING_BITMAP_WORDS words (bitmap container)
+    };
+} RoaringContainer;
+
+// Roaring set structure
+typedef struct RoaringSet {
+    RoaringContainer *containers; // Sorted by key, none empty
+    size_t count;
+    size_t capacity;
+    size_t cardinality;
+} RoaringSet;
+
+// Iterator over set values in ascending order
+typedef struct RoaringIterator {
+    const RoaringSet *set;
+    size_t container;
+    size_t position; // Array index, or bitmap word index
+    uint64_t bits;   // Not yet visited bits of the current bitmap word
+} RoaringIterator;
+
+// ==================== CONTAINERS ====================
+
+/**
+ * Allocate or die (internal helper)
+ * @param pointer: Block to resize (NULL to allocate)
+ * @param bytes: New size
+ * @param caller: Name for the failure message
+ * @return: Resized block
+ */
+static inline void *roaring_realloc(void *pointer, size_t bytes, const char *caller) {
+    void *block = realloc(pointer, bytes);
+    if (!block) {
+        fprintf(stderr, "%s: allocation failed\n", caller);
+        exit(EXIT_FAILURE);
+    }
+    return block;
+}
+
+/**
+ * Make an empty array container with room for capacity values (internal helper)
+ * @param container: Container to initialize
+ * @param key: High 16 bits
+ * @param capacity: Slots to allocate
+ */
+static inline void roaring_container_init_array(RoaringContainer *container, uint16_t key, uint32_t capacity) {
+    container->key = key;
+    container->is_bitmap = false;
+    container->cardinality = 0;
+    container->capacity = capacity > 0 ? capacity : 4;
+    container->values = (uint16_t *)roaring_realloc(NULL, container->capacity * sizeof(uint16_t),
+                                                    "roaring_container_init_array");
+}
+
+/**
+ * Make an empty bitmap container (internal helper)
+ * @param container: Container to initialize
+ * @param key: High 16 bits
+ */
+static inline void roaring_container_init_bitmap(RoaringContainer *container, uint16_t key) {
+    container->key = key;
+    container->is_bitmap = true;
+    container->cardinality = 0;
+    container->capacity = 0;
+    container->words = (uint64_t *)calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t));
+    if (!container->words) {
+        fprintf(stderr, "roaring_container_init_bitmap: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Free container storage (internal helper)
+ * @param container: Container to free
+ */
+static inline void roaring_container_free(RoaringContainer *container) {
+    if (container->is_bitmap) free(container->words);
+    else free(container->values);
+    container->values = NULL;
+}
+
+/**
+ * Deep copy a container (internal helper)
+ * @param dest: Destination (uninitialized)
+ * @param source: Container to copy
+ */
+static inline void roaring_container_copy(RoaringContainer *dest, const RoaringContainer *source) {
+    if (source->is_bitmap) {
+        roaring_container_init_bitmap(dest, source->key);
+        memcpy(dest->words, source->words, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    } else {
+        roaring_container_init_array(dest, source->key, source->cardinality);
+        memcpy(dest->values, source->values, source->cardinality * sizeof(uint16_t));
+    }
+    dest->cardinality = source->cardinality;
+}
+
+/**
+ * First array position whose value is >= low (internal helper)
+ * @param container: Array container
+ * @param low: Low 16 bits to look for
+ * @return: Insertion position
+ */
+static inline uint32_t roaring_array_lower_bound(const RoaringContainer *container, uint16_t low) {
+    uint32_t begin = 0, end = container->cardinality;
+    while (begin < end) {
+        uint32_t mid = begin + (end - begin) / 2;
+        if (container->values[mid] < low) begin = mid + 1;
+        else end = mid;
+    }
+    return begin;
+}
+
+/**
+ * Switch an array container to a bitmap (internal helper)
+ * @param container: Array container
+ */
+static inline void roaring_container_to_bitmap(RoaringContainer *container) {
+    uint64_t *words = (uint64_t *)calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t));
+    if (!words) {
+        fprintf(stderr, "roaring_container_to_bitmap: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t i = 0; i < container->cardinality; i++) {
+        words[container->values[i] / 64] |= 1ULL << (container->values[i] % 64);
+    }
+    free(container->values);
+    container->words = words;
+    container->is_bitmap = true;
+    container->capacity = 0;
+}
+
+/**
+ * Switch a bitmap container to an array (internal helper)
+ * @param container: Bitmap container holding at most ROARING_ARRAY_MAX values
+ */
+static inline void roaring_container_to_array(RoaringContainer *container) {
+    uint16_t *values = (uint16_t *)roaring_realloc(NULL, (container->cardinality > 0 ? container->cardinality : 1) *
+                                                   sizeof(uint16_t), "roaring_container_to_array");
+    uint32_t count = 0;
+    for (uint32_t w = 0; w < ROARING_BITMAP_WORDS; w++) {
+        for (uint64_t bits = container->words[w]; bits; bits &= bits - 1) {
+            values[count++] = (uint16_t)(w * 64 + (uint32_t)__builtin_ctzll(bits));
+        }
+    }
+    free(container->words);
+    container->values = values;
+    container->is_bitmap = false;
+    container->capacity = container->cardinality > 0 ? container->cardinality : 1;
+}
+
+/**
+ * Restore the array/bitmap choice after a bulk change (internal helper)
+ * @param container: Container whose cardinality is current
+ */
+static inline void roaring_container_settle(RoaringContainer *container) {
+    if (container->is_bitmap && container->cardinality <= ROARING_ARRAY_MAX) {
+        roaring_container_to_array(container);
+    } else if (!container->is_bitmap && container->cardinality > ROARING_ARRAY_MAX) {
+        roaring_container_to_bitmap(container);
+    }
+}
+
+/**
+ * Add a low half to a container (internal helper)
+ * @param container: Target container
+ * @param low: Low 16 bits of the value
+ * @return: true if added
+ */
+static inline bool roaring_container_add(RoaringContainer *container, uint16_t low) {
+    if (container->is_bitmap) {
+        uint64_t bit = 1ULL << (low % 64);
+        if (container->words[low / 64] & bit) return false;
+        container->words[low / 64] |= bit;
+        container->cardinality++;
+        return true;
+    }
+    uint32_t pos = roaring_array_lower_bound(container, low);
+    if (pos < container->cardinality && container->values[pos] == low) return false;
+    if (container->cardinality == ROARING_ARRAY_MAX) {
+        roaring_container_to_bitmap(container);
+        return roaring_container_add(container, low);
+    }
+    if (container->cardinality == container->capacity) {
+        uint32_t grown = container->capacity * 2 < ROARING_ARRAY_MAX ? container->capacity * 2 : ROARING_ARRAY_MAX;
+        container->values = (uint16_t *)roaring_realloc(container->values, grown * sizeof(uint16_t),
+                                                        "roaring_container_add");
+        container->capacity = grown;
+    }
+    memmove(container->values + pos + 1, container->values + pos, (container->cardinality - pos) * sizeof(uint16_t));
+    container->values[pos] = low;
+    container->cardinality++;
+    return true;
+}
+
+/**
+ * Remove a low half from a container (internal helper)
+ * @param container: Target container
+ * @param low: Low 16 bits of the value
+ * @return: true if removed
+ */
+static inline bool roaring_container_remove(RoaringContainer *container, uint16_t low) {
+    if (container->is_bitmap) {
+        uint64_t bit = 1ULL << (low % 64);
+        if (!(container->words[low / 64] & bit)) return false;
+        container->words[low / 64] &= ~bit;
+        container->cardinality--;
+        if (container->cardinality == ROARING_ARRAY_MAX) roaring_container_to_array(container);
+        return true;
+    }
+    uint32_t pos = roaring_array_lower_bound(container, low);
+    if (pos >= container->cardinality || container->values[pos] != low) return false;
+    memmove(container->values + pos, container->values + pos + 1, (container->cardinality - pos - 1) * sizeof(uint16_t));
+    container->cardinality--;
+    return true;
+}
+
+/**
+ * Check a low half in a container (internal helper)
+ * @param container: Container to search
+ * @param low: Low 16 bits of the value
+ * @return: true if present
+ */
+static inline bool roaring_container_contains(const RoaringContainer *container, uint16_t low) {
+    if (container->is_bitmap) return container->words[low / 64] >> (low % 64) & 1;
+    uint32_t pos = roaring_array_lower_bound(container, low);
+    return pos < container->cardinality && container->values[pos] == low;
+}
+
+// ==================== CONTAINER SET OPERATIONS ====================
+
+/**
+ * out = a ∪ b for containers with the same key (internal helper)
+ * @param a: First container
+ * @param b: Second container
+ * @param out: Result (uninitialized)
+ */
+static inline void roaring_container_union(const RoaringContainer *a, const RoaringContainer *b, RoaringContainer *out) {
+    if (!a->is_bitmap && !b->is_bitmap && a->cardinality + b->cardinality <= ROARING_ARRAY_MAX) {
+        roaring_container_init_array(out, a->key, a->cardinality + b->cardinality);
+        uint32_t i = 0, j = 0, n = 0;
+        while (i < a->cardinality && j < b->cardinality) {
+            uint16_t x = a->values[i], y = b->values[j];
+            out->values[n++] = x <= y ? x : y;
+            i += x <= y;
+            j += y <= x;
+        }
+        while (i < a->cardinality) out->values[n++] = a->values[i++];
+        while (j < b->cardinality) out->values[n++] = b->values[j++];
+        out->cardinality = n;
+        return;
+    }
+    if (a->is_bitmap && b->is_bitmap) {
+        roaring_container_init_bitmap(out, a->key);
+        bitset_words_or(out->words, a->words, b->words, ROARING_BITMAP_WORDS);
+    } else {
+        // Start from the bitmap operand (or the first array) and set the other's values
+        const RoaringContainer *base = a->is_bitmap || !b->is_bitmap ? a : b;
+        const RoaringContainer *other = base == a ? b : a;
+        roaring_container_init_bitmap(out, a->key);
+        if (base->is_bitmap) {
+            memcpy(out->words, base->words, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+        } else {
+            for (uint32_t i = 0; i < base->cardinality; i++) out->words[base->values[i] / 64] |= 1ULL << (base->values[i] % 64);
+        }
+        for (uint32_t i = 0; i < other->cardinality; i++) out->words[other->values[i] / 64] |= 1ULL << (other->values[i] % 64);
+    }
+    out->cardinality = (uint32_t)bitset_words_count(out->words, ROARING_BITMAP_WORDS);
+    roaring_container_settle(out);
+}
+
+/**
+ * out = a ∩ b for containers with the same key (internal helper)
+ * @param a: First container
+ * @param b: Second container
+ * @param out: Result (uninitialized); may come out empty
+ */
+static inline void roaring_container_intersection(const RoaringContainer *a, const RoaringContainer *b,
+                                                  RoaringContainer *out) {
+    if (a->is_bitmap && b->is_bitmap) {
+        roaring_container_init_bitmap(out, a->key);
+        bitset_words_and(out->words, a->words, b->words, ROARING_BITMAP_WORDS);
+        out->cardinality = (uint32_t)bitset_words_count(out->words, ROARING_BITMAP_WORDS);
+        roaring_container_settle(out);
+        return;
+    }
+    if (a->is_bitmap || b->is_bitmap) {
+        // Keep the array values whose bit is set in the bitmap
+        const RoaringContainer *array = a->is_bitmap ? b : a;
+        const RoaringContainer *bitmap = array == a ? b : a;
+        roaring_container_init_array(out, a->key, array->cardinality);
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < array->cardinality; i++) {
+            uint16_t v = array->values[i];
+            out->values[n] = v;
+            n += (uint32_t)(bitmap->words[v / 64] >> (v % 64) & 1);
+        }
+        out->cardinality = n;
+        return;
+    }
+    roaring_container_init_array(out, a->key, a->cardinality < b->cardinality ? a->cardinality : b->cardinality);
+    uint32_t i = 0, j = 0, n = 0;
+    while (i < a->cardinality && j < b->cardinality) {
+        uint16_t x = a->values[i], y = b->values[j];
+        out->values[n] = x;
+        n += x == y;
+        i += x <= y;
+        j += y <= x;
+    }
+    out->cardinality = n;
+}
+
+/**
+ * out = a - b for containers with the same key (internal helper)
+ * @param a: Container to keep values from
+ * @param b: Container of values to drop
+ * @param out: Result (uninitialized); may come out empty
+ */
+static inline void roaring_container_difference(const RoaringContainer *a, const RoaringContainer *b,
+                                                RoaringContainer *out) {
+    if (a->is_bitmap) {
+        roaring_container_init_bitmap(out, a->key);
+        if (b->is_bitmap) {
+            bitset_words_andnot(out->words, a->words, b->words, ROARING_BITMAP_WORDS);
+        } else {
+            memcpy(out->words, a->words, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+            for (uint32_t i = 0; i < b->cardinality; i++) out->words[b->values[i] / 64] &= ~(1ULL << (b->values[i] % 64));
+        }
+        out->cardinality = (uint32_t)bitset_words_count(out->words, ROARING_BITMAP_WORDS);
+        roaring_container_settle(out);
+        return;
+    }
+    roaring_container_init_array(out, a->key, a->cardinality);
+    uint32_t n = 0;
+    if (b->is_bitmap) {
+        for (uint32_t i = 0; i < a->cardinality; i++) {
+            uint16_t v = a->values[i];
+            out->values[n] = v;
+            n += (uint32_t)(~b->words[v / 64] >> (v % 64) & 1);
+        }
+    } else {
+        uint32_t j = 0;
+        for (uint32_t i = 0; i < a->cardinality; i++) {
+            uint16_t v = a->values[i];
+            while (j < b->cardinality && b->values[j] < v) j++;
+            out->values[n] = v;
+            n += j == b->cardinality || b->values[j] != v;
+        }
+    }
+    out->cardinality = n;
+}
+
+/**
+ * Check a ⊆ b for containers with the same key (internal helper)
+ * @param a: Potential subset
+ * @param b: Potential superset
+ * @return: true if every value of a is in b
+ */
+static inline bool roaring_container_is_subset(const RoaringContainer *a, const RoaringContainer *b) {
+    if (a->cardinality > b->cardinality) return false;
+    if (a->is_bitmap && b->is_bitmap) return bitset_words_subset(a->words, b->words, ROARING_BITMAP_WORDS);
+    if (a->is_bitmap) {
+        for (uint32_t w = 0; w < ROARING_BITMAP_WORDS; w++) {
+            for (uint64_t bits = a->words[w]; bits; bits &= bits - 1) {
+                if (!roaring_container_contains(b, (uint16_t)(w * 64 + (uint32_t)__builtin_ctzll(bits)))) return false;
+            }
+        }
+        return true;
+    }
+    if (b->is_bitmap) {
+        for (uint32_t i = 0; i < a->cardinality; i++) {
+            if (!(b->words[a->values[i] / 64] >> (a->values[i] % 64) & 1)) return false;
+        }
+        return true;
+    }
+    uint32_t j = 0;
+    for (uint32_t i = 0; i < a->cardinality; i++) {
+        while (j < b->cardinality && b->values[j] < a->values[i]) j++;
+        if (j == b->cardinality || b->values[j] != a->values[i]) return false;
+    }
+    return true;
+}
+
+// ==================== CORE OPERATIONS ====================
+
+/**
+ * Initialize empty roaring set
+ * @param set: Set to initialize
+ */
+static inline void roaring_init(RoaringSet *set) {
+    set->count = 0;
+    set->capacity = ROARING_DEFAULT_CONTAINERS;
+    set->containers = (RoaringContainer *)roaring_realloc(NULL, set->capacity * sizeof(RoaringContainer),
+                                                          "roaring_init");
+    set->cardinality = 0;
+}
+
+/**
+ * First container position whose key is >= key (internal helper)
+ * @param set: Set to search
+ * @param key: High 16 bits
+ * @return: Insertion position
+ */
+static inline size_t roaring_lower_bound(const RoaringSet *set, uint16_t key) {
+    size_t begin = 0, end = set->count;
+    while (begin < end) {
+        size_t mid = begin + (end - begin) / 2;
+        if (set->containers[mid].key < key) begin = mid + 1;
+        else end = mid;
+    }
+    return begin;
+}
+
+/**
+ * Append a container, taking ownership of its storage (internal helper)
+ * @param set: Target set (the container's key must sort last)
+ * @param container: Container to append; dropped if empty
+ */
+static inline void roaring_append_container(RoaringSet *set, RoaringContainer *container) {
+    if (container->cardinality == 0) {
+        roaring_container_free(container);
+        return;
+    }
+    if (set->count == set->capacity) {
+        set->capacity *= 2;
+        set->containers = (RoaringContainer *)roaring_realloc(set->containers, set->capacity * sizeof(RoaringContainer),
+                                                              "roaring_append_container");
+    }
+    set->containers[set->count++] = *container;
+    set->cardinality += container->cardinality;
+}
+
+/**
+ * Add value to set
+ * @param set: Target set
+ * @param value: Value to add
+ * @return: true if added (false if already exists)
+ */
+static inline bool roaring_add(RoaringSet *set, uint32_t value) {
+    uint16_t key = (uint16_t)(value >> 16);
+    size_t pos = roaring_lower_bound(set, key);
+    if (pos == set->count || set->containers[pos].key != key) {
+        if (set->count == set->capacity) {
+            set->capacity *= 2;
+            set->containers = (RoaringContainer *)roaring_realloc(set->containers, set->capacity * sizeof(RoaringContainer),
+                                                                  "roaring_add");
+        }
+        memmove(set->containers + pos + 1, set->containers + pos, (set->count - pos) * sizeof(RoaringContainer));
+        roaring_container_init_array(&set->containers[pos], key, 0);
+        set->count++;
+    }
+    if (!roaring_container_add(&set->containers[pos], (uint16_t)value)) return false;
+    set->cardinality++;
+    return true;
+}
+
+/**
+ * Remove value from set
+ * @param set: Target set
+ * @param value: Value to remove
+ * @return: true if removed (false if didn't exist)
+ */
+static inline bool roaring_remove(RoaringSet *set, uint32_t value) {
+    uint16_t key = (uint16_t)(value >> 16);
+    size_t pos = roaring_lower_bound(set, key);
+    if (pos == set->count || set->containers[pos].key != key) return false;
+    RoaringContainer *container = &set->containers[pos];
+    if (!roaring_container_remove(container, (uint16_t)value)) return false;
+    set->cardinality--;
+    if (container->cardinality == 0) {
+        roaring_container_free(container);
+        memmove(set->containers + pos, set->containers + pos + 1, (set->count - pos - 1) * sizeof(RoaringContainer));
+        set->count--;
+    }
+    return true;
+}
+
+/**
+ * Check if value exists in set
+ * @param set: Target set
+ * @param value: Value to check
+ * @return: true if value exists
+ */
+static inline bool roaring_contains(const RoaringSet *set, uint32_t value) {
+    uint16_t key = (uint16_t)(value >> 16);
+    size_t pos = roaring_lower_bound(set, key);
+    return pos < set->count && set->containers[pos].key == key &&
+           roaring_container_contains(&set->containers[pos], (uint16_t)value);
+}
+
+/**
+ * Get set size
+ * @param set: Target set
+ * @return: Number of elements
+ */
+static inline size_t roaring_size(const RoaringSet *set) {
+    return set->cardinality;
+}
+
+/**
+ * Check if set is empty
+ * @param set: Target set
+ * @return: true if empty
+ */
+static inline bool roaring_is_empty(const RoaringSet *set) {
+    return set->cardinality == 0;
+}
+
+/**
+ * Remove all elements
+ * @param set: Target set
+ */
+static inline void roaring_clear(RoaringSet *set) {
+    for (size_t i = 0; i < set->count; i++) roaring_container_free(&set->containers[i]);
+    set->count = 0;
+    set->cardinality = 0;
+}
+
+/**
+ * Free set memory
+ * @param set: Set to free
+ */
+static inline void roaring_free(RoaringSet *set) {
+    roaring_clear(set);
+    free(set->containers);
+    set->containers = NULL;
+    set->capacity = 0;
+}
+
+/**
+ * Bytes held by the containers and the container list
+ * @param set: Set to measure
+ * @return: Heap bytes in use
+ */
+static inline size_t roaring_bytes(const RoaringSet *set) {
+    size_t bytes = set->capacity * sizeof(RoaringContainer);
+    for (size_t i = 0; i < set->count; i++) {
+        const RoaringContainer *container = &set->containers[i];
+        bytes += container->is_bitmap ? ROARING_BITMAP_WORDS * sizeof(uint64_t) : container->capacity * sizeof(uint16_t);
+    }
+    return bytes;
+}
+
+// ==================== SET OPERATIONS ====================
+
+enum { ROARING_UNION, ROARING_INTERSECTION, ROARING_DIFFERENCE };
+
+/**
+ * Merge two container lists by key into result (internal helper)
+ * @param set1: First set
+ * @param set2: Second set
+ * @param result: Resulting set (initialized; replaced, may alias either input)
+ * @param op: ROARING_UNION, ROARING_INTERSECTION or ROARING_DIFFERENCE
+ */
+static inline void roaring_combine(const RoaringSet *set1, const RoaringSet *set2, RoaringSet *result, int op) {
+    RoaringSet out;
+    roaring_init(&out);
+    size_t i = 0, j = 0;
+    while (i < set1->count || j < set2->count) {
+        const RoaringContainer *a = i < set1->count ? &set1->containers[i] : NULL;
+        const RoaringContainer *b = j < set2->count ? &set2->containers[j] : NULL;
+        RoaringContainer container;
+        if (a && b && a->key == b->key) {
+            if (op == ROARING_UNION) roaring_container_union(a, b, &container);
+            else if (op == ROARING_INTERSECTION) roaring_container_intersection(a, b, &container);
+            else roaring_container_difference(a, b, &container);
+            roaring_append_container(&out, &container);
+            i++;
+            j++;
+        } else if (a && (!b || a->key < b->key)) {
+            // Only in set1: kept by union and difference
+            if (op != ROARING_INTERSECTION) {
+                roaring_container_copy(&container, a);
+                roaring_append_container(&out, &container);
+            } else if (!b) {
+                break;
+            }
+            i++;
+        } else {
+            // Only in set2: kept by union
+            if (op == ROARING_UNION) {
+                roaring_container_copy(&container, b);
+                roaring_append_container(&out, &container);
+            } else if (!a) {
+                break;
+            }
+            j++;
+        }
+    }
+    roaring_free(result);
+    *result = out;
+}
+
+/**
+ * Union of two sets (result = set1 ∪ set2)
+ * @param set1: First set
+ * @param set2: Second set
+ * @param result: Resulting union set (should be initialized; its contents are
+ *                replaced, and it may be set1 or set2)
+ */
+static inline void roaring_union(RoaringSet *set1, RoaringSet *set2, RoaringSet *result) {
+    roaring_combine(set1, set2, result, ROARING_UNION);
+}
+
+/**
+ * Intersection of two sets (result = set1 ∩ set2)
+ * @param set1: First set
+ * @param set2: Second set
+ * @param result: Resulting intersection set (should be initialized; its contents
+ *                are replaced, and it may be set1 or set2)
+ */
+static inline void roaring_intersection(RoaringSet *set1, RoaringSet *set2, RoaringSet *result) {
+    roaring_combine(set1, set2, result, ROARING_INTERSECTION);
+}
+
+/**
+ * Difference of two sets (result = set1 - set2)
+ * @param set1: First set
+ * @param set2: Second set
+ * @param result: Resulting difference set (should be initialized; its contents
+ *                are replaced, and it may be set1 or set2)
+ */
+static inline void roaring_difference(RoaringSet *set1, RoaringSet *set2, RoaringSet *result) {
+    roaring_combine(set1, set2, result, ROARING_DIFFERENCE);
+}
+
+/**
+ * Check if set1 is subset of set2
+ * @param set1: Potential subset
+ * @param set2: Potential superset
+ * @return: true if set1 ⊆ set2
+ */
+static inline bool roaring_is_subset(const RoaringSet *set1, const RoaringSet *set2) {
+    if (set1->cardinality > set2->cardinality) return false;
+    size_t j = 0;
+    for (size_t i = 0; i < set1->count; i++) {
+        const RoaringContainer *a = &set1->containers[i];
+        while (j < set2->count && set2->containers[j].key < a->key) j++;
+        if (j == set2->count || set2->containers[j].key != a->key) return false;
+        if (!roaring_container_is_subset(a, &set2->containers[j])) return false;
+    }
+    return true;
+}
+
+/**
+ * Check if two sets are equal
+ * @param set1: First set
+ * @param set2: Second set
+ * @return: true if sets are equal
+ */
+static inline bool roaring_equals(const RoaringSet *set1, const RoaringSet *set2) {
+    return set1->cardinality == set2->cardinality && set1->count == set2->count && roaring_is_subset(set1, set2);
+}
+
+// ==================== ITERATION ====================
+
+/**
+ * Start iterating a set in ascending order
+ * @param it: Iterator to initialize
+ * @param set: Set to visit (must not change during iteration)
+ */
+static inline void roaring_iter_init(RoaringIterator *it, const RoaringSet *set) {
+    it->set = set;
+    it->container = 0;
+    it->position = 0;
+    it->bits = set->count > 0 && set->containers[0].is_bitmap ? set->containers[0].words[0] : 0;
+}
+
+/**
+ * Advance to the next value
+ * @param it: Iterator
+ * @param value: Receives the value
+ * @return: true if a value was produced, false at the end
+ */
+static inline bool roaring_iter_next(RoaringIterator *it, uint32_t *value) {
+    while (it->container < it->set->count) {
+        const RoaringContainer *container = &it->set->containers[it->container];
+        uint32_t high = (uint32_t)container->key << 16;
+        if (!container->is_bitmap) {
+            if (it->position < container->cardinality) {
+                *value = high | container->values[it->position++];
+                return true;
+            }
+        } else {
+            while (it->bits == 0 && ++it->position < ROARING_BITMAP_WORDS) it->bits = container->words[it->position];
+            if (it->bits != 0) {
+                *value = high | (uint32_t)(it->position * 64 + (size_t)__builtin_ctzll(it->bits));
+                it->bits &= it->bits - 1;
+                return true;
+            }
+        }
+        // Next container
+        it->container++;
+        it->position = 0;
+        if (it->container < it->set->count && it->set->containers[it->container].is_bitmap) {
+            it->bits = it->set->containers[it->container].words[0];
+        }
+    }
+    return false;
+}
+
+// ==================== CONVENIENCE FUNCTIONS ====================
+
+/**
+ * Add integer to set
+ * @param set: Integer set
+ * @param value: Integer to add (negative values are rejected)
+ * @return: true if added
+ */
+static inline bool roaring_add_int(RoaringSet *set, int value) {
+    return value >= 0 && roaring_add(set, (uint32_t)value);
+}
+
+/**
+ * Remove integer from set
+ * @param set: Integer set
+ * @param value: Integer to remove
+ * @return: true if removed
+ */
+static inline bool roaring_remove_int(RoaringSet *set, int value) {
+    return value >= 0 && roaring_remove(set, (uint32_t)value);
+}
+
+/**
+ * Check if integer exists in set
+ * @param set: Integer set
+ * @param value: Integer to check
+ * @return: true if exists
+ */
+static inline bool roaring_contains_int(const RoaringSet *set, int value) {
+    return value >= 0 && roaring_contains(set, (uint32_t)value);
+}
+
+// ==================== UTILITY FUNCTIONS ====================
+
+/**
+ * Create copy of set
+ * @param source: Source set
+ * @param dest: Destination set (should be uninitialized)
+ */
+static inline void roaring_copy(const RoaringSet *source, RoaringSet *dest) {
+    roaring_init(dest);
+    for (size_t i = 0; i < source->count; i++) {
+        RoaringContainer container;
+        roaring_container_copy(&container, &source->containers[i]);
+        roaring_append_container(dest, &container);
+    }
+}
+
+#endif // ROARING_H
@@ -0,0 +1,297 @@
+#ifndef COLUMN_FILTER_H
+#define COLUMN_FILTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * COLUMNAR FILTER KERNELS
+ *
+ * Conjunctive predicates over plain column arrays (struct-of-arrays layout),
+ * producing a selection vector: the ascending row numbers that satisfy every
+ * predicate. Rows are processed in blocks of COLUMN_FILTER_BLOCK; each
+ * predicate turns a block into a bit mask with vector compares, the masks are
+ * ANDed, and set bits are appended to the selection. A block whose mask
+ * becomes zero skips the remaining predicates, so put the most selective
+ * predicate first.
+ *
+ * Predicate kinds:
+ * - int32 range  lo <= x <= hi
+ * - float range  lo <= x <= hi (NaN never matches)
+ * - uint16 equality, for dictionary-encoded strings
+ *
+ * SIMD paths: AVX2 (8 lanes), SSE2 (4 lanes), scalar fallback (define
+ * COLUMN_FILTER_NO_SIMD to force it). All paths return identical selections.
+ *
+ * Time Complexities:
+ * - Filter: O(rows * predicates / lanes) compares plus O(matches)
+ * - Refine an existing selection: O(selected) per predicate
+ *
+ * Space Complexity: O(1) beyond the caller's selection vector
+ */
+
+#if !defined(COLUMN_FILTER_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define COLUMN_FILTER_AVX2 1
+#define COLUMN_FILTER_SSE2 1
+#elif !defined(COLUMN_FILTER_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define COLUMN_FILTER_SSE2 1
+#endif
+
+// Rows evaluated per mask
+#define COLUMN_FILTER_BLOCK 16
+
+// Predicate kinds
+typedef enum {
+    COLUMN_PREDICATE_INT_RANGE,   // int32_t column, int_lo <= x <= int_hi
+    COLUMN_PREDICATE_FLOAT_RANGE, // float column, float_lo <= x <= float_hi
+    COLUMN_PREDICATE_CODE_EQUALS  // uint16_t column, x == code
+} ColumnPredicateType;
+
+// One predicate over one column
+typedef struct ColumnPredicate {
+    ColumnPredicateType type;
+    const void *column; // Array of at least `rows` values of the matching type
+    int32_t int_lo;
+    int32_t int_hi;
+    float float_lo;
+    float float_hi;
+    uint16_t code;
+} ColumnPredicate;
+
+// ==================== PREDICATE CONSTRUCTORS ====================
+
+/**
+ * Predicate lo <= column[row] <= hi over an int32 column
+ * @param column: Column values
+ * @param lo: Lower bound (inclusive)
+ * @param hi: Upper bound (inclusive)
+ * @return: Predicate
+ */
+static inline ColumnPredicate column_predicate_int_range(const int32_t *column, int32_t lo, int32_t hi) {
+    ColumnPredicate predicate = {COLUMN_PREDICATE_INT_RANGE, column, lo, hi, 0.0f, 0.0f, 0};
+    return predicate;
+}
+
+/**
+ * Predicate lo <= column[row] <= hi over a float column
+ * @param column: Column values
+ * @param lo: Lower bound (inclusive)
+ * @param hi: Upper bound (inclusive)
+ * @return: Predicate
+ */
+static inline ColumnPredicate column_predicate_float_range(const float *column, float lo, float hi) {
+    ColumnPredicate predicate = {COLUMN_PREDICATE_FLOAT_RANGE, column, 0, 0, lo, hi, 0};
+    return predicate;
+}
+
+/**
+ * Predicate column[row] == code over a dictionary-code column
+ * @param column: Column codes
+ * @param code: Code to match
+ * @return: Predicate
+ */
+static inline ColumnPredicate column_predicate_code_equals(const uint16_t *column, uint16_t code) {
+    ColumnPredicate predicate = {COLUMN_PREDICATE_CODE_EQUALS, column, 0, 0, 0.0f, 0.0f, code};
+    return predicate;
+}
+
+// ==================== MASK KERNELS ====================
+
+/**
+ * Evaluate predicate on one row (internal helper)
+ * @param predicate: Predicate
+ * @param row: Row number
+ * @return: true if the row matches
+ */
+static inline bool column_predicate_test(const ColumnPredicate *predicate, size_t row) {
+    switch (predicate->type) {
+    case COLUMN_PREDICATE_INT_RANGE: {
+        int32_t x = ((const int32_t *)predicate->column)[row];
+        return x >= predicate->int_lo && x <= predicate->int_hi;
+    }
+    case COLUMN_PREDICATE_FLOAT_RANGE: {
+        float x = ((const float *)predicate->column)[row];
+        return x >= predicate->float_lo && x <= predicate->float_hi;
+    }
+    default:
+        return ((const uint16_t *)predicate->column)[row] == predicate->code;
+    }
+}
+
+/**
+ * Evaluate predicate on COLUMN_FILTER_BLOCK rows starting at base (internal helper)
+ * @param predicate: Predicate
+ * @param base: First row of the block
+ * @return: Bit i set when row base + i matches
+ */
+static inline uint32_t column_predicate_mask(const ColumnPredicate *predicate, size_t base) {
+    uint32_t mask = 0;
+    switch (predicate->type) {
+    case COLUMN_PREDICATE_INT_RANGE: {
+        const int32_t *x = (const int32_t *)predicate->column + base;
+#if defined(COLUMN_FILTER_AVX2)
+        __m256i lo = _mm256_set1_epi32(predicate->int_lo), hi = _mm256_set1_epi32(predicate->int_hi);
+        for (int i = 0; i < COLUMN_FILTER_BLOCK; i += 8) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)(x + i));
+            __m256i out = _mm256_or_si256(_mm256_cmpgt_epi32(lo, v), _mm256_cmpgt_epi32(v, hi));
+            mask |= (uint32_t)(~_mm256_movemask_ps(_mm256_castsi256_ps(out)) & 0xFF) << i;
+        }
+#elif defined(COLUMN_FILTER_SSE2)
+        __m128i lo = _mm_set1_epi32(predicate->int_lo), hi = _mm_set1_epi32(predicate->int_hi);
+        for (int i = 0; i < COLUMN_FILTER_BLOCK; i += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(const void *)(x + i));
+            __m128i out = _mm_or_si128(_mm_cmplt_epi32(v, lo), _mm_cmpgt_epi32(v, hi));
+            mask |= (uint32_t)(~_mm_movemask_ps(_mm_castsi128_ps(out)) & 0xF) << i;
+        }
+#else
+        for (int i = 0; i < COLUMN_FILTER_BLOCK; i++) {
+            mask |= (uint32_t)(x[i] >= predicate->int_lo && x[i] <= predicate->int_hi) << i;
+        }
+#endif
+        break;
+    }
+    case COLUMN_PREDICATE_FLOAT_RANGE: {
+        const float *x = (const float *)predicate->column + base;
+#if defined(COLUMN_FILTER_AVX2)
+        __m256 lo = _mm256_set1_ps(predicate->float_lo), hi = _mm256_set1_ps(predicate->float_hi);
+        for (int i = 0; i < COLUMN_FILTER_BLOCK; i += 8) {
+            __m256 v = _mm256_loadu_ps(x + i);
+            __m256 in = _mm256_and_ps(_mm256_cmp_ps(v, lo, _CMP_GE_OQ), _mm256_cmp_ps(v, hi, _CMP_LE_OQ));
+            mask |= (uint32_t)_mm256_movemask_ps(in) << i;
+        }
+#elif defined(COLUMN_FILTER_SSE2)
+        __m128 lo = _mm_set1_ps(predicate->float_lo), hi = _mm_set1_ps(predicate->float_hi);
+        for (int i = 0; i < COLUMN_FILTER_BLOCK; i += 4) {
+            __m128 v = _mm_loadu_ps(x + i);
+            __m128 in = _mm_and_ps(_mm_cmpge_ps(v, lo), _mm_cmple_ps(v, hi));
+            mask |= (uint32_t)_mm_movemask_ps(in) << i;
+        }
+#else
+        for (int i = 0; i < COLUMN_FILTER_BLOCK; i++) {
+            mask |= (uint32_t)(x[i] >= predicate->float_lo && x[i] <= predicate->float_hi) << i;
+        }
+#endif
+        break;
+    }
+    default: {
+        const uint16_t *x = (const uint16_t *)predicate->column + base;
+#if defined(COLUMN_FILTER_SSE2)
+        // Two 8-lane compares narrowed to one byte per row
+        __m128i code = _mm_set1_epi16((short)predicate->code);
+        __m128i a = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)(const void *)x), code);
+        __m128i b = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)(const void *)(x + 8)), code);
+        mask = (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(a, b));
+#else
+        for (int i = 0; i < COLUMN_FILTER_BLOCK; i++) {
+            mask |= (uint32_t)(x[i] == predicate->code) << i;
+        }
+#endif
+        break;
+    }
+    }
+    return mask;
+}
+
+/**
+ * Index of lowest set bit (internal helper)
+ * @param mask: Non-zero mask
+ * @return: Bit index
+ */
+static inline unsigned column_filter_lowest_bit(uint32_t mask) {
+#if defined(__GNUC__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned bit = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// ==================== FILTERS ====================
+
+/**
+ * Select rows matching every predicate
+ * @param predicates: Conjunction to evaluate (most selective first)
+ * @param predicate_count: Number of predicates (0 selects every row)
+ * @param rows: Number of rows in each column
+ * @param selection: Receives matching row numbers ascending (room for rows entries)
+ * @return: Number of matching rows
+ */
+static inline size_t column_filter(const ColumnPredicate *predicates, size_t predicate_count, size_t rows,
+                                   uint32_t *selection) {
+    size_t count = 0;
+    size_t base = 0;
+    for (; base + COLUMN_FILTER_BLOCK <= rows; base += COLUMN_FILTER_BLOCK) {
+        uint32_t mask = (1u << COLUMN_FILTER_BLOCK) - 1;
+        for (size_t p = 0; p < predicate_count && mask; p++) {
+            mask &= column_predicate_mask(&predicates[p], base);
+        }
+        while (mask) {
+            selection[count++] = (uint32_t)(base + column_filter_lowest_bit(mask));
+            mask &= mask - 1;
+        }
+    }
+
+    // Tail shorter than a block
+    for (; base < rows; base++) {
+        bool match = true;
+        for (size_t p = 0; p < predicate_count && match; p++) {
+            match = column_predicate_test(&predicates[p], base);
+        }
+        selection[count] = (uint32_t)base;
+        count += match;
+    }
+    return count;
+}
+
+/**
+ * Keep only selected rows that also match predicate (branch-free compaction)
+ * @param predicate: Additional predicate
+ * @param selection: Selection vector, filtered in place
+ * @param count: Entries in selection
+ * @return: Entries left
+ */
+static inline size_t column_refine(const ColumnPredicate *predicate, uint32_t *selection, size_t count) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t row = selection[i];
+        selection[kept] = row;
+        kept += column_predicate_test(predicate, row);
+    }
+    return kept;
+}
+
+/**
+ * Count rows matching every predicate without storing them
+ * @param predicates: Conjunction to evaluate
+ * @param predicate_count: Number of predicates
+ * @param rows: Number of rows in each column
+ * @return: Number of matching rows
+ */
+static inline size_t column_count(const ColumnPredicate *predicates, size_t predicate_count, size_t rows) {
+    size_t count = 0;
+    size_t base = 0;
+    for (; base + COLUMN_FILTER_BLOCK <= rows; base += COLUMN_FILTER_BLOCK) {
+        uint32_t mask = (1u << COLUMN_FILTER_BLOCK) - 1;
+        for (size_t p = 0; p < predicate_count && mask; p++) {
+            mask &= column_predicate_mask(&predicates[p], base);
+        }
+        for (; mask; mask &= mask - 1) count++;
+    }
+    for (; base < rows; base++) {
+        bool match = true;
+        for (size_t p = 0; p < predicate_count && match; p++) {
+            match = column_predicate_test(&predicates[p], base);
+        }
+        count += match;
+    }
+    return count;
+}
+
+#endif // COLUMN_FILTER_H
@@ -3,6 +3,8 @@
 #include <string.h>
 #include <assert.h>
 #include <time.h>
+#include <limits.h>
+#include <pthread.h>
 
 // Include all data structure headers
 #include "dynarray/dynarray.h"
@@ -12,10 +14,38 @@
 #include "containers/stack.h"
 #include "containers/queue.h"
 #include "containers/deque.h"
+#include "containers/concurrent_queue.h"
 #include "heap/min_heap.h"
 #include "heap/max_heap.h"
+#include "heap/indexed_heap.h"
+#include "heap/dary_heap.h"
 #include "hash/hashtable.h"
 #include "hash/hashset.h"
+#include "hash/flat_hashtable.h"
+#include "hash/concurrent_hashtable.h"
+#include "hash/string_interner.h"
+#include "hash/filter.h"
+#include "bitset/bitset.h"
+#include "bitset/roaring.h"
+#include "stats/ds_stats.h"
+#include "dynarray/typed_dynarray.h"
+#include "dynarray/dynarray_sort.h"
+#include "heap/typed_heap.h"
+#include "hash/typed_hashmap.h"
+#include "containers/typed_deque.h"
+#include "allocator/pool.h"
+#include "allocator/arena.h"
+#include "tree/avl.h"
+#include "tree/btree.h"
+#include "graph/graph.h"
+#include "graph/csr_graph.h"
+#include "graph/parallel_graph.h"
+#include "unionfind/unionfind.h"
+#include "columnar/column_filter.h"
+#include "poly/polynomial.h"
+#include "sequence/lis.h"
+#include "segtree/segtree.h"
+#include "trie/trie.h"
 
 // Test results structure
 typedef struct {
@@ -98,6 +128,12 @@ void test_dynarray() {
     dynarray_set(&arr, 1, &new_val);
     TEST_ASSERT(*(int*)dynarray_get(&arr, 1) == 99, "Set operation works");
     
+    // Test swap remove: the last element fills the hole
+    int *removed = (int*)dynarray_swap_remove(&arr, 0);
+    TEST_ASSERT(*removed == 10 && dynarray_size(&arr) == 3, "Swap remove returns element");
+    TEST_ASSERT(*(int*)dynarray_get(&arr, 0) == 40, "Last element moved into hole");
+    TEST_ASSERT(dynarray_swap_remove(&arr, 3) == NULL, "Swap remove out of bounds");
+    
     dynarray_free(&arr);
     printf("Dynamic Array tests completed\n");
 }
@@ -283,6 +319,49 @@ void test_deque() {
     TEST_ASSERT(*popped_back == 40, "Pop back correct");
     TEST_ASSERT(deque_size(&deque) == 2, "Size after pops");
     
+    // Ring buffer wraps and grows while keeping logical order
+    int ring[40];
+    deque_clear(&deque);
+    for (int i = 0; i < 40; i++) ring[i] = i;
+    for (int i = 20; i < 40; i++) deque_push_back(&deque, &ring[i]);
+    for (int i = 19; i >= 0; i--) deque_push_front(&deque, &ring[i]);
+    bool ordered = true;
+    for (int i = 0; i < 40; i++) {
+        if (*(int*)deque_get_at(&deque, i) != i) ordered = false;
+    }
+    TEST_ASSERT(ordered, "Random access correct after wrap and growth");
+    TEST_ASSERT(deque_get_at(&deque, 40) == NULL, "Out of bounds access returns NULL");
+    
+    // Insert/remove in the middle shift the shorter side
+    int extra = 99;
+    deque_insert_at(&deque, 5, &extra);
+    deque_insert_at(&deque, 35, &extra);
+    TEST_ASSERT(*(int*)deque_get_at(&deque, 5) == 99 && *(int*)deque_get_at(&deque, 6) == 5, "Insert near front");
+    TEST_ASSERT(*(int*)deque_get_at(&deque, 35) == 99 && *(int*)deque_get_at(&deque, 36) == 34, "Insert near back");
+    deque_remove_at(&deque, 35);
+    TEST_ASSERT(deque_remove_at(&deque, 5) == &extra, "Remove returns element");
+    ordered = true;
+    for (int i = 0; i < 40; i++) {
+        if (*(int*)deque_get_at(&deque, i) != i) ordered = false;
+    }
+    TEST_ASSERT(ordered && deque_size(&deque) == 40, "Order restored after removals");
+    
+    // Rotation and reversal
+    deque_rotate_left(&deque, 3);
+    TEST_ASSERT(*(int*)deque_peek_front(&deque) == 3 && *(int*)deque_peek_back(&deque) == 2, "Rotate left");
+    deque_rotate_right(&deque, 3);
+    TEST_ASSERT(*(int*)deque_peek_front(&deque) == 0, "Rotate right undoes rotate left");
+    deque_reverse(&deque);
+    TEST_ASSERT(*(int*)deque_peek_front(&deque) == 39 && *(int*)deque_get_at(&deque, 39) == 0, "Reverse");
+    
+    // Polymorphic use through DequeInterface
+    deque_free(&deque);
+    deque_init_with_interface(&deque);
+    deque.vtable->push_back(&deque, &ring[1]);
+    deque.vtable->push_front(&deque, &ring[0]);
+    TEST_ASSERT(deque.vtable->pop_back(&deque) == &ring[1], "Interface pop_back");
+    TEST_ASSERT(deque.vtable->base.size(&deque) == 1, "Interface size");
+    
     deque_free(&deque);
     printf("Deque tests completed\n");
 }
@@ -361,6 +440,187 @@ void test_max_heap() {
     printf("Max Heap tests completed\n");
 }
 
+// Test top-k selection
+void test_heap_top_k() {
+    TEST_START("HEAP TOP-K");
+    
+    int values[100];
+    void *ptrs[100];
+    for (int i = 0; i < 100; i++) {
+        values[i] = (i * 37) % 100; // Permutation of 0..99
+        ptrs[i] = &values[i];
+    }
+    
+    // Non-destructive walk of an existing heap
+    MaxHeap heap;
+    max_heap_init(&heap, 0);
+    max_heap_build_from_array(&heap, ptrs, 100);
+    void *out[100];
+    size_t n = binary_heap_top_k(&heap, 10, out);
+    bool descending = n == 10;
+    for (size_t i = 0; i < n; i++) descending = descending && *(int*)out[i] == 99 - (int)i;
+    TEST_ASSERT(descending, "Heap walk returns 10 largest in order");
+    TEST_ASSERT(max_heap_size(&heap) == 100 && max_heap_is_valid(&heap), "Heap unchanged by walk");
+    TEST_ASSERT(binary_heap_top_k(&heap, 500, out) == 100 && *(int*)out[99] == 0, "k larger than heap returns all");
+    TEST_ASSERT(binary_heap_top_k(&heap, 0, out) == 0, "k of zero returns nothing");
+    max_heap_free(&heap);
+    
+    // Streaming selection over an unordered array
+    n = binary_heap_select_top_k(ptrs, 100, 5, heap_int_compare_min, out);
+    bool smallest = n == 5;
+    for (size_t i = 0; i < n; i++) smallest = smallest && *(int*)out[i] == (int)i;
+    TEST_ASSERT(smallest, "Bounded heap selects 5 smallest best-first");
+    TEST_ASSERT(binary_heap_select_top_k(ptrs, 3, 10, heap_int_compare_max, out) == 3, "Short source returns all");
+    
+    HeapTopK top;
+    heap_top_k_init(&top, 3, heap_int_compare_max);
+    int stream[] = {5, 1, 9, 7, 3, 9};
+    int kept = 0;
+    for (int i = 0; i < 6; i++) kept += heap_top_k_offer(&top, &stream[i]);
+    TEST_ASSERT(kept == 5, "Offer rejects elements below the current k-th");
+    n = heap_top_k_finish(&top, out);
+    TEST_ASSERT(n == 3 && *(int*)out[0] == 9 && *(int*)out[1] == 9 && *(int*)out[2] == 7, "Finish returns best-first");
+    heap_top_k_free(&top);
+    
+    printf("Heap top-k tests completed\n");
+}
+
+// Test d-ary heap and bulk heap operations
+void test_dary_heap() {
+    TEST_START("D-ARY HEAP");
+    
+    int values[200];
+    void *ptrs[200];
+    for (int i = 0; i < 200; i++) {
+        values[i] = (i * 73) % 200; // Permutation of 0..199
+        ptrs[i] = &values[i];
+    }
+    
+    unsigned arities[] = {2, 4, 8, 16};
+    for (int a = 0; a < 4; a++) {
+        DaryHeap heap;
+        dary_heap_init(&heap, arities[a], heap_int_compare_min, 4);
+        for (int i = 0; i < 200; i++) dary_heap_push(&heap, ptrs[i]);
+        bool ordered = dary_heap_is_valid(&heap) && dary_heap_size(&heap) == 200;
+        for (int i = 0; i < 200; i++) ordered = ordered && *(int*)dary_heap_pop(&heap) == i;
+        char message[64];
+        snprintf(message, sizeof message, "%u-ary heap pops in order", dary_heap_arity(&heap));
+        TEST_ASSERT(ordered && dary_heap_is_empty(&heap), message);
+        dary_heap_free(&heap);
+    }
+    
+    DaryHeap heap, other;
+    dary_heap_init(&heap, 8, heap_int_compare_max, 0);
+    TEST_ASSERT(((uintptr_t)(heap.data + 1) % DARY_HEAP_CACHE_LINE) == 0, "Child blocks start on a cache line");
+    TEST_ASSERT(dary_heap_pop(&heap) == NULL && dary_heap_peek(&heap) == NULL, "Empty heap returns NULL");
+    dary_heap_build_from_array(&heap, ptrs, 100);
+    TEST_ASSERT(dary_heap_is_valid(&heap) && *(int*)dary_heap_peek(&heap) == 199, "Build from array heapifies");
+    
+    dary_heap_init(&other, 8, heap_int_compare_max, 0);
+    dary_heap_push_many(&other, ptrs + 100, 100);
+    dary_heap_merge(&heap, &other);
+    TEST_ASSERT(dary_heap_size(&heap) == 200 && dary_heap_is_empty(&other), "Merge moves all elements");
+    TEST_ASSERT(dary_heap_is_valid(&heap) && *(int*)dary_heap_peek(&heap) == 199, "Merged heap is valid");
+    
+    void *out[200];
+    size_t n = dary_heap_pop_many(&heap, out, 5);
+    TEST_ASSERT(n == 5 && *(int*)out[0] == 199 && *(int*)out[4] == 195, "Pop many returns best-first");
+    int *old_root = (int*)dary_heap_replace(&heap, &values[0]);
+    TEST_ASSERT(*old_root == 194 && dary_heap_is_valid(&heap), "Replace swaps root");
+    dary_heap_free(&other);
+    dary_heap_free(&heap);
+    
+    // Binary heap bulk operations
+    MinHeap min_heap, min_other;
+    min_heap_init(&min_heap, 0);
+    min_heap_init(&min_other, 0);
+    binary_heap_push_many(&min_heap, ptrs, 150);
+    binary_heap_push_many(&min_heap, ptrs + 150, 3); // Small batch sifts up
+    TEST_ASSERT(min_heap_size(&min_heap) == 153 && min_heap_is_valid(&min_heap), "Binary push many keeps heap valid");
+    binary_heap_push_many(&min_other, ptrs + 153, 47);
+    binary_heap_merge(&min_heap, &min_other);
+    TEST_ASSERT(min_heap_size(&min_heap) == 200 && min_heap_is_empty(&min_other), "Binary merge empties source");
+    n = binary_heap_pop_many(&min_heap, out, 200);
+    bool ascending = n == 200;
+    for (size_t i = 0; i < n; i++) ascending = ascending && *(int*)out[i] == (int)i;
+    TEST_ASSERT(ascending && min_heap_is_empty(&min_heap), "Binary pop many drains in order");
+    TEST_ASSERT(binary_heap_pop_many(&min_heap, out, 10) == 0, "Pop many on empty heap returns 0");
+    min_heap_free(&min_other);
+    min_heap_free(&min_heap);
+    
+    printf("D-ary heap tests completed\n");
+}
+
+// Test indexed heap
+void test_indexed_heap() {
+    TEST_START("INDEXED HEAP");
+    
+    int keys[50];
+    IndexedHeap heap;
+    indexed_heap_init(&heap, heap_int_compare_min, 4);
+    for (int i = 0; i < 50; i++) {
+        keys[i] = (i * 17) % 50 + 100;
+        indexed_heap_push(&heap, (size_t)i, &keys[i]);
+    }
+    TEST_ASSERT(indexed_heap_size(&heap) == 50 && indexed_heap_is_valid(&heap), "Push grows heap and handle map");
+    TEST_ASSERT(*(int*)indexed_heap_peek(&heap) == 100 && indexed_heap_peek_handle(&heap) == 0, "Peek returns minimum and its handle");
+    TEST_ASSERT(indexed_heap_get(&heap, 7) == &keys[7] && indexed_heap_contains(&heap, 49), "Lookup by handle");
+    
+    // Key changed in place: move it to the root, then to the bottom
+    keys[31] = 1;
+    TEST_ASSERT(indexed_heap_decrease_key(&heap, 31), "Decrease key");
+    TEST_ASSERT(indexed_heap_peek_handle(&heap) == 31 && indexed_heap_is_valid(&heap), "Decreased element becomes root");
+    keys[31] = 1000;
+    indexed_heap_update_key(&heap, 31);
+    TEST_ASSERT(indexed_heap_peek_handle(&heap) == 0 && indexed_heap_is_valid(&heap), "Increased element sinks");
+    
+    // Arbitrary removal
+    TEST_ASSERT(indexed_heap_remove(&heap, 20) == &keys[20], "Remove by handle returns element");
+    TEST_ASSERT(!indexed_heap_contains(&heap, 20) && indexed_heap_remove(&heap, 20) == NULL, "Removed handle is gone");
+    TEST_ASSERT(indexed_heap_remove(&heap, 5000) == NULL, "Unknown handle ignored");
+    TEST_ASSERT(indexed_heap_size(&heap) == 49 && indexed_heap_is_valid(&heap), "Heap valid after removal");
+    
+    // Non-destructive top-k, then drain in order
+    void *top[3];
+    TEST_ASSERT(indexed_heap_top_k(&heap, 3, top) == 3 && *(int*)top[0] == 100 && *(int*)top[2] == 102, "Top-k walk");
+    int previous = -1;
+    bool ordered = true;
+    size_t handle, drained = 0;
+    while (!indexed_heap_is_empty(&heap)) {
+        int value = *(int*)indexed_heap_pop(&heap, &handle);
+        if (value < previous || keys[handle] != value) ordered = false;
+        previous = value;
+        drained++;
+    }
+    TEST_ASSERT(ordered && drained == 49 && previous == 1000, "Pop drains in order with handles");
+    
+    // Re-pushing a handle replaces its element
+    indexed_heap_push(&heap, 3, &keys[3]);
+    indexed_heap_push(&heap, 3, &keys[4]);
+    TEST_ASSERT(indexed_heap_size(&heap) == 1 && indexed_heap_get(&heap, 3) == &keys[4], "Push on existing handle replaces");
+    indexed_heap_clear(&heap);
+    TEST_ASSERT(indexed_heap_is_empty(&heap) && !indexed_heap_contains(&heap, 3), "Clear empties heap");
+    
+    // Bulk push: heapify path for a large batch, sift path for a small one
+    size_t handles[50];
+    void *elements[50];
+    for (int i = 0; i < 50; i++) {
+        keys[i] = (i * 17) % 50 + 100;
+        handles[i] = (size_t)i;
+        elements[i] = &keys[i];
+    }
+    indexed_heap_push_many(&heap, handles, elements, 40);
+    TEST_ASSERT(indexed_heap_size(&heap) == 40 && indexed_heap_is_valid(&heap), "Bulk push heapifies");
+    indexed_heap_push_many(&heap, handles + 40, elements + 40, 2);
+    TEST_ASSERT(indexed_heap_size(&heap) == 42 && indexed_heap_is_valid(&heap) && indexed_heap_get(&heap, 41) == &keys[41], "Small bulk push sifts up");
+    indexed_heap_push_many(&heap, handles, elements + 49, 1);
+    TEST_ASSERT(indexed_heap_size(&heap) == 42 && indexed_heap_get(&heap, 0) == &keys[49] && indexed_heap_is_valid(&heap), "Bulk push replaces existing handle");
+    TEST_ASSERT(*(int*)indexed_heap_peek(&heap) == 101, "Bulk-built heap root is minimum");
+    indexed_heap_free(&heap);
+    
+    printf("Indexed heap tests completed\n");
+}
+
 // Test Hash Table
 void test_hashtable() {
     TEST_START("HASH TABLE");
@@ -408,11 +668,299 @@ void test_hashtable() {
     TEST_ASSERT(removed, "Remove existing key");
     TEST_ASSERT(!hashtable_contains(&table, "banana"), "Key no longer exists");
     TEST_ASSERT(hashtable_size(&table) == 3, "Size decremented after remove");
-    
+
+    // Refill a second table from the cached hashes alone
+    HashTable restored;
+    hashtable_init(&restored, table.capacity, table.hash_func);
+    HashTableIterator it;
+    HashEntry *entry;
+    hashtable_iter_init(&it, &table);
+    while ((entry = hashtable_iter_next(&it))) {
+        hashtable_insert_hashed(&restored, entry->key, entry->value, entry->hash);
+    }
+    TEST_ASSERT(hashtable_size(&restored) == 3, "Hashed insert restores size");
+    TEST_ASSERT(hashtable_get(&restored, "apple") == &new_value && hashtable_get(&restored, "date") == &values[3] &&
+                !hashtable_contains(&restored, "banana"), "Hashed insert restores lookups");
+    hashtable_free(&restored);
+
     hashtable_free(&table);
     printf("Hash Table tests completed\n");
 }
 
+// Test Hash Table incremental rehashing
+void test_hashtable_incremental() {
+    TEST_START("HASH TABLE INCREMENTAL REHASH");
+    
+    HashTable table;
+    hashtable_init_incremental(&table, 8, &INT_HASH_FUNC);
+    
+    const int N = 2000;
+    int *values = malloc(N * sizeof(int));
+    bool saw_rehashing = false;
+    bool lookups_ok = true;
+    
+    for (int i = 0; i < N; i++) {
+        values[i] = i;
+        hashtable_put(&table, &i, &values[i]);
+        if (hashtable_is_rehashing(&table)) {
+            saw_rehashing = true;
+            // Keys must stay reachable while split across both arrays
+            int probe = i / 2;
+            int *v = (int*)hashtable_get(&table, &probe);
+            if (!v || *v != probe) lookups_ok = false;
+        }
+    }
+    
+    TEST_ASSERT(saw_rehashing, "Migration spans multiple operations");
+    TEST_ASSERT(lookups_ok, "Lookups succeed mid-migration");
+    TEST_ASSERT(hashtable_size(&table) == (size_t)N, "Size correct with incremental resize");
+    
+    // Iterator covers both arrays exactly once
+    size_t iterated = 0;
+    HashTableIterator it;
+    hashtable_iter_init(&it, &table);
+    while (hashtable_iter_next(&it)) iterated++;
+    TEST_ASSERT(iterated == (size_t)N, "Iterator visits every entry once");
+    
+    // Removals work regardless of which array holds the key
+    bool removed_all = true;
+    for (int i = 0; i < N; i += 2) {
+        if (!hashtable_remove(&table, &i)) removed_all = false;
+    }
+    TEST_ASSERT(removed_all, "Remove finds keys in old or new buckets");
+    TEST_ASSERT(hashtable_size(&table) == (size_t)(N / 2), "Size after removals");
+    
+    hashtable_rehash_complete(&table);
+    TEST_ASSERT(!hashtable_is_rehashing(&table), "Rehash completes on demand");
+    int odd = 1999;
+    TEST_ASSERT(hashtable_get(&table, &odd) == &values[1999], "Entry intact after migration");
+    
+    // Set algebra over a set that is mid-migration
+    HashSet a, b, inter;
+    hashset_init(&a, 8, &INT_HASH_FUNC);
+    a.incremental = true;
+    hashset_init_int(&b);
+    hashset_init_int(&inter);
+    for (int i = 0; i < 100; i++) hashset_add_int(&a, i);
+    for (int i = 50; i < 150; i++) hashset_add_int(&b, i);
+    hashset_intersection(&a, &b, &inter);
+    TEST_ASSERT(hashset_size(&inter) == 50, "Set intersection covers rehashing set");
+    hashset_free(&a);
+    hashset_free(&b);
+    hashset_free(&inter);
+    
+    hashtable_free(&table);
+    free(values);
+    printf("Hash Table incremental rehash tests completed\n");
+}
+
+// Test Flat Hash Table
+void test_flat_hashtable() {
+    TEST_START("FLAT HASH TABLE");
+    
+    FlatHashTable table;
+    flat_hashtable_init_string(&table);
+    
+    TEST_ASSERT(flat_hashtable_size(&table) == 0, "Initial size is 0");
+    TEST_ASSERT(flat_hashtable_is_empty(&table), "Initially empty");
+    
+    // String keys are borrowed, so they must outlive the entries
+    const char* keys[] = {"apple", "banana", "cherry", "date"};
+    int values[] = {100, 200, 300, 400};
+    
+    for (int i = 0; i < 4; i++) {
+        flat_hashtable_put(&table, keys[i], &values[i]);
+    }
+    
+    TEST_ASSERT(flat_hashtable_size(&table) == 4, "Size after puts");
+    
+    bool all_found = true;
+    for (int i = 0; i < 4; i++) {
+        int *retrieved = (int*)flat_hashtable_get(&table, keys[i]);
+        if (!retrieved || *retrieved != values[i]) all_found = false;
+    }
+    TEST_ASSERT(all_found, "All string keys retrieved");
+    TEST_ASSERT(!flat_hashtable_contains(&table, "grape"), "Doesn't contain non-existing key");
+    
+    int new_value = 999;
+    flat_hashtable_put(&table, "apple", &new_value);
+    TEST_ASSERT(*(int*)flat_hashtable_get(&table, "apple") == 999, "Update works");
+    TEST_ASSERT(flat_hashtable_size(&table) == 4, "Size unchanged after update");
+    
+    TEST_ASSERT(flat_hashtable_remove(&table, "banana"), "Remove existing key");
+    TEST_ASSERT(!flat_hashtable_contains(&table, "banana"), "Key no longer exists");
+    TEST_ASSERT(!flat_hashtable_remove(&table, "banana"), "Second remove fails");
+    TEST_ASSERT(flat_hashtable_size(&table) == 3, "Size decremented after remove");
+    flat_hashtable_free(&table);
+    
+    // Integer keys stored inline, through several resizes
+    const int N = 5000;
+    int *ints = malloc(N * sizeof(int));
+    flat_hashtable_init_int(&table);
+    for (int i = 0; i < N; i++) {
+        ints[i] = i * 7;
+        flat_hashtable_put_int(&table, i * 7, &ints[i]);
+    }
+    TEST_ASSERT(flat_hashtable_size(&table) == (size_t)N, "Size after many inserts");
+    TEST_ASSERT(flat_hashtable_is_valid(&table), "Robin Hood invariants hold after resizes");
+    
+    bool ints_found = true;
+    for (int i = 0; i < N; i++) {
+        int *v = (int*)flat_hashtable_get_int(&table, i * 7);
+        if (!v || *v != i * 7) ints_found = false;
+    }
+    TEST_ASSERT(ints_found, "All integer keys retrieved");
+    TEST_ASSERT(flat_hashtable_get_int(&table, 3) == NULL, "Missing integer key returns NULL");
+    
+    // Remove every other key, check backward-shift deletion keeps the rest reachable
+    for (int i = 0; i < N; i += 2) {
+        flat_hashtable_remove_int(&table, i * 7);
+    }
+    bool remaining_ok = true;
+    for (int i = 0; i < N; i++) {
+        bool present = flat_hashtable_get_int(&table, i * 7) != NULL;
+        if (present != (i % 2 == 1)) remaining_ok = false;
+    }
+    TEST_ASSERT(remaining_ok, "Only odd entries remain after removals");
+    TEST_ASSERT(flat_hashtable_is_valid(&table), "Invariants hold after removals");
+    TEST_ASSERT(flat_hashtable_load_factor(&table) <= 0.875, "Load factor within threshold");
+    
+    flat_hashtable_clear(&table);
+    TEST_ASSERT(flat_hashtable_is_empty(&table), "Clear empties table");
+    
+    // Reserved table holds the requested entries without growing
+    flat_hashtable_free(&table);
+    flat_hashtable_init_int(&table);
+    flat_hashtable_reserve(&table, N);
+    size_t reserved = table.capacity;
+    for (int i = 0; i < N; i++) flat_hashtable_put_int(&table, i, &ints[i]);
+    TEST_ASSERT(table.capacity == reserved && flat_hashtable_size(&table) == (size_t)N, "Reserve avoids resizing");
+    flat_hashtable_free(&table);
+    free(ints);
+    
+    printf("Flat Hash Table tests completed\n");
+}
+
+// Counting hash wrapper used to check that resizes reuse cached hashes
+static size_t counted_hash_calls = 0;
+static size_t counted_hash_int(const void *key, size_t capacity) {
+    counted_hash_calls++;
+    return hash_int(key, capacity);
+}
+
+// Test fast string hashing and cached entry hashes
+void test_fast_hash() {
+    TEST_START("FAST HASH");
+    
+    printf("SIMD path: %s\n", fast_hash_simd_path());
+    
+    unsigned char buf[512];
+    for (int i = 0; i < 512; i++) buf[i] = (unsigned char)(i * 31 + 7);
+    
+    // Vector stripe accumulator must match the scalar reference exactly
+    uint64_t acc_simd[8], acc_scalar[8];
+    for (int i = 0; i < 8; i++) acc_simd[i] = acc_scalar[i] = FAST_HASH_P0 * (uint64_t)(i + 1);
+    fast_hash_accumulate(acc_simd, buf, 512 / FAST_HASH_STRIPE_LEN);
+    fast_hash_accumulate_scalar(acc_scalar, buf, 512 / FAST_HASH_STRIPE_LEN);
+    TEST_ASSERT(memcmp(acc_simd, acc_scalar, sizeof(acc_simd)) == 0, "SIMD accumulator matches scalar");
+    
+    // Every prefix length hashes deterministically and distinctly
+    bool deterministic = true, distinct = true;
+    uint64_t seen[201];
+    for (size_t len = 0; len <= 200; len++) {
+        seen[len] = fast_hash_bytes(buf, len, FAST_HASH_SEED);
+        if (seen[len] != fast_hash_bytes(buf, len, FAST_HASH_SEED)) deterministic = false;
+        for (size_t k = 0; k < len; k++) {
+            if (seen[k] == seen[len]) distinct = false;
+        }
+    }
+    TEST_ASSERT(deterministic, "Hash is deterministic for lengths 0-200");
+    TEST_ASSERT(distinct, "Prefixes of different lengths hash differently");
+    TEST_ASSERT(fast_hash_bytes(buf, 100, 1) != fast_hash_bytes(buf, 100, 2), "Seed changes hash");
+    TEST_ASSERT(fast_hash_string("player") == fast_hash_bytes("player", 6, FAST_HASH_SEED), "String hash matches byte hash");
+    
+    // String table on the new default hash, with long keys
+    HashTable table;
+    hashtable_init(&table, 4, &STRING_HASH_FUNC);
+    char key[128];
+    int values[300];
+    for (int i = 0; i < 300; i++) {
+        values[i] = i;
+        snprintf(key, sizeof(key), "a-rather-long-player-name-that-crosses-a-stripe-boundary-%d", i);
+        hashtable_put(&table, key, &values[i]);
+    }
+    bool strings_ok = true;
+    for (int i = 0; i < 300; i++) {
+        snprintf(key, sizeof(key), "a-rather-long-player-name-that-crosses-a-stripe-boundary-%d", i);
+        int *v = (int*)hashtable_get(&table, key);
+        if (!v || *v != i) strings_ok = false;
+    }
+    TEST_ASSERT(strings_ok, "Long string keys retrieved after resizes");
+    hashtable_free(&table);
+    
+    // Resizes reuse cached hashes: one hash call per operation
+    static const HashFunction counted = {
+        .hash = counted_hash_int,
+        .key_equals = hash_int_equals,
+        .key_copy = hash_int_copy,
+        .key_free = hash_int_free
+    };
+    counted_hash_calls = 0;
+    hashtable_init(&table, 4, &counted);
+    for (int i = 0; i < 1000; i++) hashtable_put(&table, &i, &values[i % 300]);
+    TEST_ASSERT(table.capacity > 4, "Table resized");
+    TEST_ASSERT(counted_hash_calls == 1000, "Resize does not re-hash keys");
+    hashtable_free(&table);
+    
+    printf("Fast hash tests completed\n");
+}
+
+// Test string interner
+void test_string_interner() {
+    TEST_START("STRING INTERNER");
+    
+    StringInterner interner;
+    string_interner_init(&interner);
+    TEST_ASSERT(string_interner_count(&interner) == 0, "Initially empty");
+    TEST_ASSERT(string_interner_lookup(&interner, "USA") == STRING_INTERNER_NONE, "Lookup of unknown string");
+    
+    // Ids are dense in order of first use; repeats return the same id
+    uint32_t usa = string_interner_intern(&interner, "USA");
+    uint32_t spain = string_interner_intern(&interner, "Spain");
+    TEST_ASSERT(usa == 0 && spain == 1, "Ids assigned densely");
+    TEST_ASSERT(string_interner_intern(&interner, "USA") == usa, "Repeat intern returns same id");
+    TEST_ASSERT(string_interner_count(&interner) == 2, "Repeats not counted");
+    
+    // Input buffer is copied, not retained
+    char buffer[32];
+    strcpy(buffer, "France");
+    uint32_t france = string_interner_intern(&interner, buffer);
+    strcpy(buffer, "Greece");
+    TEST_ASSERT(strcmp(string_interner_string(&interner, france), "France") == 0, "String copied on intern");
+    TEST_ASSERT(string_interner_lookup(&interner, "France") == france, "Lookup finds interned string");
+    TEST_ASSERT(string_interner_lookup(&interner, buffer) == STRING_INTERNER_NONE, "Lookup does not intern");
+    TEST_ASSERT(string_interner_string(&interner, 99) == NULL, "Out-of-range id");
+    
+    // Many strings survive table and id array growth
+    char key[32];
+    for (int i = 0; i < 1000; i++) {
+        snprintf(key, sizeof(key), "name-%d", i);
+        string_interner_intern(&interner, key);
+    }
+    bool ids_ok = string_interner_count(&interner) == 1003;
+    for (int i = 0; i < 1000 && ids_ok; i++) {
+        snprintf(key, sizeof(key), "name-%d", i);
+        uint32_t id = string_interner_lookup(&interner, key);
+        ids_ok = id == (uint32_t)(i + 3) && strcmp(string_interner_string(&interner, id), key) == 0;
+    }
+    TEST_ASSERT(ids_ok, "Ids and strings stable after growth");
+    TEST_ASSERT(strcmp(string_interner_string(&interner, usa), "USA") == 0, "Early strings intact after growth");
+    
+    string_interner_free(&interner);
+    TEST_ASSERT(string_interner_count(&interner) == 0, "Empty after free");
+    printf("String interner tests completed\n");
+}
+
 // Test Hash Set
 void test_hashset() {
     TEST_START("HASH SET");
@@ -449,7 +997,1996 @@ void test_hashset() {
     printf("Hash Set tests completed\n");
 }
 
+// Test union-find
+void test_unionfind() {
+    TEST_START("UNION-FIND");
+    
+    UnionFind uf;
+    unionfind_init(&uf, 10);
+    TEST_ASSERT(unionfind_components(&uf) == 10 && unionfind_size_of(&uf, 3) == 1, "Initially all singletons");
+    TEST_ASSERT(unionfind_union(&uf, 0, 1) && unionfind_union(&uf, 2, 3) && unionfind_union(&uf, 1, 3), "Unions of distinct sets succeed");
+    TEST_ASSERT(!unionfind_union(&uf, 0, 2), "Union within a set is rejected");
+    TEST_ASSERT(unionfind_connected(&uf, 0, 3) && !unionfind_connected(&uf, 0, 4), "Connectivity follows unions");
+    TEST_ASSERT(unionfind_size_of(&uf, 2) == 4 && unionfind_max_component_size(&uf) == 4, "Sizes kept at roots");
+    TEST_ASSERT(unionfind_find(&uf, 10) == -1 && unionfind_size_of(&uf, -1) == -1, "Invalid elements rejected");
+    unionfind_index_t members[] = {5, 6, 7};
+    TEST_ASSERT(unionfind_union_all(&uf, members, 3) == 2 && unionfind_components(&uf) == 5, "Union all merges list");
+    TEST_ASSERT(unionfind_validate(&uf), "Structure valid");
+    unionfind_free(&uf);
+    
+    // Deep chain built by hand: find must not recurse
+    const unionfind_index_t CHAIN = 1000000;
+    unionfind_init(&uf, CHAIN);
+    for (unionfind_index_t i = 0; i + 1 < CHAIN; i++) uf.parent[i] = i + 1;
+    uf.parent[CHAIN - 1] = -CHAIN;
+    uf.components = 1;
+    TEST_ASSERT(unionfind_find(&uf, 0) == CHAIN - 1 && unionfind_validate(&uf), "Find on million-deep chain");
+    unionfind_free(&uf);
+    
+    // Parallel edge union agrees with sequential
+    const unionfind_index_t N = 50000;
+    const size_t M = 40000;
+    unionfind_index_t *edges = (unionfind_index_t *)malloc(2 * M * sizeof(unionfind_index_t));
+    for (size_t i = 0; i < 2 * M; i++) edges[i] = (unionfind_index_t)((i * 2654435761u) % (unsigned)N);
+    UnionFind seq, par;
+    unionfind_init(&seq, N);
+    unionfind_init(&par, N);
+    size_t seq_unions = unionfind_union_edges(&seq, edges, M, 1);
+    size_t par_unions = unionfind_union_edges(&par, edges, M, 4);
+    TEST_ASSERT(seq_unions == par_unions && unionfind_components(&seq) == unionfind_components(&par),
+                "Parallel union matches sequential component count");
+    bool same = true;
+    for (unionfind_index_t i = 0; i < N; i++) {
+        same = same && unionfind_size_of(&seq, i) == unionfind_size_of(&par, i);
+        same = same && unionfind_connected(&par, i, edges[2 * (i % M)]) == unionfind_connected(&seq, i, edges[2 * (i % M)]);
+    }
+    TEST_ASSERT(same && unionfind_validate(&par), "Parallel union matches sequential sets and sizes");
+    unionfind_free(&seq);
+    unionfind_free(&par);
+    free(edges);
+    
+    printf("Union-find tests completed\n");
+}
+
+// Test CSR graph and its kernels
+void test_csr_graph() {
+    TEST_START("CSR GRAPH");
+    
+    // Two components: weighted square 0-1-2-3 with chord 0-2, and edge 4-5; 6 isolated
+    CSREdge edges[] = {{0, 1, 1}, {1, 2, 2}, {2, 3, 1}, {3, 0, 7}, {0, 2, 5}, {4, 5, 3}};
+    CSRGraph graph;
+    bool built = csr_graph_from_edges(&graph, 7, edges, 6, true);
+    TEST_ASSERT(built, "Build from edge list");
+    if (!built) return; // Nothing below can run without the graph
+    TEST_ASSERT(graph.edge_count == 12 && csr_graph_degree(&graph, 0) == 3 && csr_graph_degree(&graph, 6) == 0,
+                "Undirected edges stored both ways");
+    size_t count;
+    const csr_vertex_t *neighbors = csr_graph_neighbors(&graph, 1, &count);
+    const int *weights = csr_graph_edge_weights(&graph, 1);
+    TEST_ASSERT(count == 2 && neighbors[0] == 0 && weights[0] == 1 && neighbors[1] == 2 && weights[1] == 2,
+                "Neighbor block is contiguous with weights");
+    
+    uint32_t hops[7];
+    csr_vertex_t parent[7];
+    TEST_ASSERT(csr_graph_bfs(&graph, 0, hops, parent) == 4, "BFS reaches own component");
+    TEST_ASSERT(hops[2] == 1 && hops[3] == 1 && hops[4] == CSR_GRAPH_UNREACHED && parent[0] == 0, "BFS hop counts");
+    
+    csr_vertex_t order[7];
+    size_t visited = csr_graph_dfs(&graph, 0, order);
+    TEST_ASSERT(visited == 4 && order[0] == 0 && order[1] == 1 && order[2] == 2 && order[3] == 3, "DFS preorder");
+    
+    int64_t dist[7];
+    TEST_ASSERT(csr_graph_dijkstra(&graph, 0, dist, parent) == 4, "Dijkstra reaches own component");
+    TEST_ASSERT(dist[1] == 1 && dist[2] == 3 && dist[3] == 4 && parent[3] == 2 && dist[5] == CSR_GRAPH_INFINITY,
+                "Dijkstra shortest distances");
+    
+    uint32_t component[7];
+    TEST_ASSERT(csr_graph_connected_components(&graph, component) == 3, "Three components");
+    TEST_ASSERT(component[0] == 0 && component[3] == 0 && component[4] == 1 && component[5] == 1 && component[6] == 2,
+                "Component labels dense in vertex order");
+    csr_graph_free(&graph);
+    
+    CSREdge bad[] = {{0, 9, 1}};
+    TEST_ASSERT(!csr_graph_from_edges(&graph, 3, bad, 1, false), "Out-of-range endpoint rejected");
+    
+    // Conversion from pointer graph keeps ids and directions
+    G pointer_graph;
+    graph_init(&pointer_graph);
+    V *a = graph_new_vertex(&pointer_graph, 100);
+    V *b = graph_new_vertex(&pointer_graph, 200);
+    V *c = graph_new_vertex(&pointer_graph, 300);
+    graph_new_edge(&pointer_graph, a, b, 4);
+    graph_new_edge(&pointer_graph, b, c, 6);
+    csr_graph_from_graph(&graph, &pointer_graph, false);
+    TEST_ASSERT(graph.vertex_count == 3 && graph.edge_count == 2 && graph.vertex_ids[2] == 300, "Built from G");
+    TEST_ASSERT(csr_graph_dijkstra(&graph, 0, dist, NULL) == 3 && dist[2] == 10, "Directed distances from G");
+    TEST_ASSERT(csr_graph_bfs(&graph, 2, hops, NULL) == 1, "Direction respected");
+    csr_graph_free(&graph);
+    graph_destroy(&pointer_graph);
+    
+    printf("CSR graph tests completed\n");
+}
+
+// Range task for the thread pool test: counts items and which workers ran
+static void pool_count_task(void *ctx, size_t begin, size_t end, size_t worker) {
+    atomic_size_t *counters = (atomic_size_t *)ctx;
+    atomic_fetch_add(&counters[0], end - begin);
+    atomic_fetch_add(&counters[1 + worker], 1);
+}
+
+// Test thread pool and parallel graph kernels
+void test_parallel_graph() {
+    TEST_START("PARALLEL GRAPH");
+    
+    ThreadPool pool;
+    thread_pool_init(&pool, 4);
+    atomic_size_t counters[5];
+    for (int i = 0; i < 5; i++) atomic_init(&counters[i], 0);
+    thread_pool_parallel_for(&pool, 0, 100000, 0, pool_count_task, counters);
+    size_t tasks = 0;
+    for (int i = 1; i < 5; i++) tasks += atomic_load(&counters[i]);
+    TEST_ASSERT(atomic_load(&counters[0]) == 100000 && tasks == 32, "Parallel for covers range in 32 chunks");
+    for (int i = 0; i < 200; i++) thread_pool_submit(&pool, pool_count_task, counters, 0, 1);
+    thread_pool_wait(&pool);
+    TEST_ASSERT(atomic_load(&counters[0]) == 100200, "Submitted tasks all run before wait returns");
+    
+    // Random undirected graph: a dense core plus a sparse tail and isolated vertices
+    const size_t N = 20000, M = 30000;
+    CSREdge *edges = (CSREdge *)malloc(M * sizeof(CSREdge));
+    for (size_t i = 0; i < M; i++) {
+        uint64_t h = (uint64_t)(i + 7) * 11400714819323198485ull;
+        size_t span = i < M / 2 ? 2000 : N - 100;
+        edges[i].from = (csr_vertex_t)((h >> 8) % span);
+        edges[i].to = (csr_vertex_t)((h >> 40) % span);
+        edges[i].weight = 1;
+    }
+    CSRGraph graph, directed, transpose;
+    csr_graph_from_edges(&graph, N, edges, M, true);
+    csr_graph_from_edges(&directed, N, edges, M, false);
+    csr_graph_transpose(&transpose, &directed);
+    
+    uint32_t *expected = (uint32_t *)malloc(N * sizeof(uint32_t));
+    uint32_t *actual = (uint32_t *)malloc(N * sizeof(uint32_t));
+    size_t serial_reached = csr_graph_bfs(&graph, 0, expected, NULL);
+    size_t parallel_reached = csr_graph_parallel_bfs(&graph, NULL, &pool, 0, actual);
+    TEST_ASSERT(serial_reached == parallel_reached && memcmp(expected, actual, N * sizeof(uint32_t)) == 0,
+                "Direction-optimizing BFS matches serial BFS");
+    serial_reached = csr_graph_bfs(&directed, 0, expected, NULL);
+    parallel_reached = csr_graph_parallel_bfs(&directed, &transpose, &pool, 0, actual);
+    bool directed_same = serial_reached == parallel_reached && memcmp(expected, actual, N * sizeof(uint32_t)) == 0;
+    parallel_reached = csr_graph_parallel_bfs(&directed, NULL, &pool, 0, actual);
+    directed_same = directed_same && serial_reached == parallel_reached && memcmp(expected, actual, N * sizeof(uint32_t)) == 0;
+    TEST_ASSERT(directed_same, "Directed BFS matches with and without transpose");
+    
+    size_t serial_components = csr_graph_connected_components(&graph, expected);
+    size_t parallel_components = csr_graph_parallel_connected_components(&graph, &pool, actual);
+    TEST_ASSERT(serial_components == parallel_components && memcmp(expected, actual, N * sizeof(uint32_t)) == 0,
+                "Afforest components match serial labels");
+    serial_components = csr_graph_connected_components(&directed, expected);
+    parallel_components = csr_graph_parallel_connected_components(&directed, &pool, actual);
+    TEST_ASSERT(serial_components == parallel_components && memcmp(expected, actual, N * sizeof(uint32_t)) == 0,
+                "Weak components of directed graph match");
+    
+    double *rank = (double *)malloc(N * sizeof(double));
+    double *rank_single = (double *)malloc(N * sizeof(double));
+    ThreadPool single;
+    thread_pool_init(&single, 1);
+    size_t iterations = csr_graph_parallel_pagerank(&directed, &transpose, &pool, PAGERANK_DEFAULT_DAMPING,
+                                                    PAGERANK_DEFAULT_TOLERANCE, PAGERANK_DEFAULT_MAX_ITERATIONS, rank);
+    csr_graph_parallel_pagerank(&directed, NULL, &single, PAGERANK_DEFAULT_DAMPING,
+                                PAGERANK_DEFAULT_TOLERANCE, PAGERANK_DEFAULT_MAX_ITERATIONS, rank_single);
+    double total = 0.0, max_diff = 0.0;
+    for (size_t v = 0; v < N; v++) {
+        total += rank[v];
+        double d = rank[v] - rank_single[v];
+        if (d < 0) d = -d;
+        if (d > max_diff) max_diff = d;
+    }
+    TEST_ASSERT(iterations > 1 && iterations < PAGERANK_DEFAULT_MAX_ITERATIONS, "PageRank converges");
+    TEST_ASSERT(total > 0.999999 && total < 1.000001 && max_diff < 1e-9, "PageRank sums to 1 and is thread-count independent");
+    
+    // Ring: every vertex ranks equally
+    CSREdge ring[8];
+    for (csr_vertex_t i = 0; i < 8; i++) ring[i] = (CSREdge){i, (i + 1) % 8, 1};
+    CSRGraph ring_graph;
+    csr_graph_from_edges(&ring_graph, 8, ring, 8, false);
+    csr_graph_parallel_pagerank(&ring_graph, NULL, &pool, 0.85, 1e-12, 100, rank);
+    TEST_ASSERT(rank[0] > 0.1249 && rank[0] < 0.1251 && rank[5] > 0.1249 && rank[5] < 0.1251, "Ring ranks are uniform");
+    csr_graph_free(&ring_graph);
+    
+    thread_pool_free(&single);
+    thread_pool_free(&pool);
+    free(rank_single);
+    free(rank);
+    free(actual);
+    free(expected);
+    csr_graph_free(&transpose);
+    csr_graph_free(&directed);
+    csr_graph_free(&graph);
+    free(edges);
+    
+    printf("Parallel graph tests completed\n");
+}
+
+// Test columnar filter kernels against a row-at-a-time reference
+void test_column_filter() {
+    TEST_START("COLUMN FILTER");
+    
+    const size_t rows = 1000 + 7; // Not a multiple of the block size
+    int32_t *ages = malloc(rows * sizeof(int32_t));
+    float *skills = malloc(rows * sizeof(float));
+    uint16_t *codes = malloc(rows * sizeof(uint16_t));
+    uint32_t *selection = malloc(rows * sizeof(uint32_t));
+    for (size_t i = 0; i < rows; i++) {
+        ages[i] = (int32_t)(i * 7 % 23) + 18 - (i == 5 ? 100 : 0); // One negative value
+        skills[i] = (float)(i * 37 % 1000) / 10.0f;
+        codes[i] = (uint16_t)(i * 11 % 6);
+    }
+    
+    ColumnPredicate predicates[3] = {
+        column_predicate_code_equals(codes, 3),
+        column_predicate_int_range(ages, 20, 30),
+        column_predicate_float_range(skills, 50.0f, 90.0f)
+    };
+    size_t count = column_filter(predicates, 3, rows, selection);
+    size_t expected = 0;
+    bool rows_match = true;
+    for (size_t i = 0; i < rows; i++) {
+        if (codes[i] == 3 && ages[i] >= 20 && ages[i] <= 30 && skills[i] >= 50.0f && skills[i] <= 90.0f) {
+            if (expected >= count || selection[expected] != i) rows_match = false;
+            expected++;
+        }
+    }
+    TEST_ASSERT(count == expected && rows_match && count > 0, "Three-predicate filter matches reference");
+    TEST_ASSERT(column_count(predicates, 3, rows) == expected, "Count agrees with filter");
+    
+    // Filtering by one predicate then refining gives the same selection
+    size_t refined = column_filter(predicates, 1, rows, selection);
+    refined = column_refine(&predicates[1], selection, refined);
+    refined = column_refine(&predicates[2], selection, refined);
+    TEST_ASSERT(refined == expected, "Filter plus refine equals conjunctive filter");
+    
+    ColumnPredicate negative = column_predicate_int_range(ages, -200, 0);
+    TEST_ASSERT(column_filter(&negative, 1, rows, selection) == 1 && selection[0] == 5, "Signed range bounds");
+    TEST_ASSERT(column_filter(NULL, 0, rows, selection) == rows && selection[rows - 1] == rows - 1, "No predicates selects all rows");
+    ColumnPredicate empty = column_predicate_float_range(skills, 2.0f, 1.0f);
+    TEST_ASSERT(column_count(&empty, 1, rows) == 0, "Inverted range selects nothing");
+    TEST_ASSERT(column_count(predicates, 3, 9) == (size_t)(codes[3] == 3 && ages[3] >= 20 && ages[3] <= 30 && skills[3] >= 50.0f && skills[3] <= 90.0f), "Short input uses tail path");
+    
+    free(ages);
+    free(skills);
+    free(codes);
+    free(selection);
+    
+    printf("Column filter tests completed\n");
+}
+
+// Test Polynomial Multiplication
+void test_polynomial() {
+    TEST_START("POLYNOMIAL MULTIPLICATION");
+    
+    // (3 + 2x + 5x^2)(5 + x + 2x^2 + 3x^3), the example from poly_fft.py
+    double a[3] = {3, 2, 5}, b[4] = {5, 1, 2, 3}, expected[6] = {15, 13, 33, 18, 16, 15};
+    double naive[6], karatsuba[6], fft[6];
+    poly_multiply_naive(a, 3, b, 4, naive);
+    poly_multiply_karatsuba(a, 3, b, 4, karatsuba);
+    poly_multiply_fft(a, 3, b, 4, fft);
+    bool small_ok = true;
+    for (int i = 0; i < 6; i++) {
+        double error = fft[i] - expected[i];
+        if (naive[i] != expected[i] || karatsuba[i] != expected[i] || error > 1e-9 || error < -1e-9) small_ok = false;
+    }
+    TEST_ASSERT(small_ok, "Naive, Karatsuba and FFT agree on small example");
+    
+    // Random operands of odd and unbalanced lengths, across every dispatch range
+    const size_t sizes[][2] = {{1, 1}, {40, 57}, {100, 37}, {300, 257}, {1000, 1001}, {3000, 90}};
+    unsigned seed = 2024;
+    bool karatsuba_ok = true, fft_ok = true, dispatch_ok = true, exact_ok = true, mod_ok = true, ntt_ok = true;
+    for (size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+        size_t na = sizes[t][0], nb = sizes[t][1], need = na + nb - 1;
+        double *x = malloc(na * sizeof(double)), *y = malloc(nb * sizeof(double));
+        double *reference = malloc(need * sizeof(double)), *result = malloc(need * sizeof(double));
+        int64_t *ix = malloc(na * sizeof(int64_t)), *iy = malloc(nb * sizeof(int64_t));
+        int64_t *iref = malloc(need * sizeof(int64_t)), *ires = malloc(need * sizeof(int64_t));
+        uint32_t *ux = malloc(na * sizeof(uint32_t)), *uy = malloc(nb * sizeof(uint32_t));
+        uint32_t *uref = malloc(need * sizeof(uint32_t)), *ures = malloc(need * sizeof(uint32_t));
+        for (size_t i = 0; i < na; i++) {
+            seed = seed * 1103515245u + 12345u;
+            x[i] = (double)((int)(seed >> 16) % 201 - 100);
+            ix[i] = (int64_t)(seed >> 8) - 8000000; // Negative and positive
+            ux[i] = seed % 2147483647u;
+        }
+        for (size_t i = 0; i < nb; i++) {
+            seed = seed * 1103515245u + 12345u;
+            y[i] = (double)((int)(seed >> 16) % 201 - 100);
+            iy[i] = (int64_t)(seed >> 4) - 100000000;
+            uy[i] = seed % 2147483647u;
+        }
+        
+        poly_multiply_naive(x, na, y, nb, reference);
+        poly_multiply_karatsuba(x, na, y, nb, result);
+        for (size_t i = 0; i < need; i++) karatsuba_ok &= result[i] == reference[i];
+        poly_multiply_fft(x, na, y, nb, result);
+        for (size_t i = 0; i < need; i++) fft_ok &= result[i] - reference[i] < 1e-6 && reference[i] - result[i] < 1e-6;
+        poly_multiply(x, na, y, nb, result);
+        for (size_t i = 0; i < need; i++) dispatch_ok &= result[i] - reference[i] < 1e-6 && reference[i] - result[i] < 1e-6;
+        
+        // Exact integers: sums of products near 1e15 exceed double precision
+        memset(iref, 0, need * sizeof(int64_t));
+        for (size_t i = 0; i < na; i++) {
+            for (size_t j = 0; j < nb; j++) iref[i + j] += ix[i] * iy[j];
+        }
+        poly_multiply_exact(ix, na, iy, nb, ires);
+        for (size_t i = 0; i < need; i++) exact_ok &= ires[i] == iref[i];
+        
+        // Three-prime CRT for a modulus that is not NTT-friendly
+        const uint32_t modulus = 2147483647u;
+        memset(uref, 0, need * sizeof(uint32_t));
+        for (size_t i = 0; i < na; i++) {
+            for (size_t j = 0; j < nb; j++) uref[i + j] = (uint32_t)((uref[i + j] + (uint64_t)ux[i] * uy[j]) % modulus);
+        }
+        poly_multiply_mod(ux, na, uy, nb, modulus, ures);
+        for (size_t i = 0; i < need; i++) mod_ok &= ures[i] == uref[i];
+        
+        // Single NTT for its own prime
+        for (size_t i = 0; i < na; i++) ux[i] %= POLY_NTT_MODULUS;
+        for (size_t i = 0; i < nb; i++) uy[i] %= POLY_NTT_MODULUS;
+        memset(uref, 0, need * sizeof(uint32_t));
+        for (size_t i = 0; i < na; i++) {
+            for (size_t j = 0; j < nb; j++) uref[i + j] = (uint32_t)((uref[i + j] + (uint64_t)ux[i] * uy[j]) % POLY_NTT_MODULUS);
+        }
+        poly_multiply_mod(ux, na, uy, nb, POLY_NTT_MODULUS, ures);
+        for (size_t i = 0; i < need; i++) ntt_ok &= ures[i] == uref[i];
+        
+        free(x); free(y); free(reference); free(result);
+        free(ix); free(iy); free(iref); free(ires);
+        free(ux); free(uy); free(uref); free(ures);
+    }
+    TEST_ASSERT(karatsuba_ok, "Karatsuba matches naive (unbalanced, odd lengths)");
+    TEST_ASSERT(fft_ok, "FFT matches naive");
+    TEST_ASSERT(dispatch_ok, "Size dispatch matches naive");
+    TEST_ASSERT(exact_ok, "Exact int64 product with negative coefficients");
+    TEST_ASSERT(mod_ok, "Product modulo 2^31 - 1 via CRT");
+    TEST_ASSERT(ntt_ok, "Product modulo 998244353 via single NTT");
+    
+    // Forward then inverse transform restores the input
+    PolyFFTPlan plan;
+    poly_fft_plan_init(&plan, 1000);
+    PolyComplex *data = malloc(plan.size * sizeof(PolyComplex));
+    for (size_t i = 0; i < plan.size; i++) {
+        data[i].re = (double)(i % 17);
+        data[i].im = -(double)(i % 5);
+    }
+    poly_fft_forward(&plan, data);
+    double dc = data[0].re;
+    poly_fft_inverse(&plan, data);
+    bool round_trip = plan.size == 1024;
+    for (size_t i = 0; i < plan.size; i++) {
+        double dr = data[i].re - (double)(i % 17), di = data[i].im + (double)(i % 5);
+        if (dr > 1e-9 || dr < -1e-9 || di > 1e-9 || di < -1e-9) round_trip = false;
+    }
+    double expected_dc = 0;
+    for (size_t i = 0; i < 1024; i++) expected_dc += (double)(i % 17);
+    TEST_ASSERT(dc - expected_dc < 1e-6 && expected_dc - dc < 1e-6, "Forward transform DC term is the sum");
+    TEST_ASSERT(round_trip, "Plan size rounds up and inverse restores input");
+    free(data);
+    poly_fft_plan_free(&plan);
+    
+    printf("Polynomial multiplication tests completed\n");
+}
+
+// Check that positions form an increasing subsequence of the given length (test helper)
+static bool lis_is_valid(const int *values, const size_t *indices, size_t length, bool strict) {
+    for (size_t k = 1; k < length; k++) {
+        if (indices[k] <= indices[k - 1]) return false;
+        int prev = values[indices[k - 1]], next = values[indices[k]];
+        if (strict ? prev >= next : prev > next) return false;
+    }
+    return true;
+}
+
+// Test Longest Increasing Subsequence
+void test_lis() {
+    TEST_START("LONGEST INCREASING SUBSEQUENCE");
+    
+    int example[] = {10, 9, 2, 5, 3, 57, 101, 18};
+    size_t indices[64];
+    size_t length = lis_compute(example, 8, true, indices);
+    TEST_ASSERT(length == 4 && lis_is_valid(example, indices, length, true), "LIS.c example has length 4");
+    TEST_ASSERT(lis_compute(example, 0, true, NULL) == 0, "Empty input has length 0");
+    
+    // Equal elements: LIS.c left this case undefined
+    int repeats[] = {3, 3, 3, 1, 3, 2, 2, 4};
+    TEST_ASSERT(lis_compute(repeats, 8, true, NULL) == 3, "Strict variant skips equal elements");
+    length = lis_compute(repeats, 8, false, indices);
+    TEST_ASSERT(length == 5 && lis_is_valid(repeats, indices, length, false), "Non-strict variant keeps equal elements");
+    
+    // Random inputs against the O(n^2) recurrence
+    int values[40];
+    unsigned seed = 77;
+    bool matches = true;
+    for (int round = 0; round < 200; round++) {
+        for (int i = 0; i < 40; i++) {
+            seed = seed * 1103515245u + 12345u;
+            values[i] = (int)(seed >> 16) % 15 - 7;
+        }
+        for (int strict = 0; strict <= 1; strict++) {
+            size_t best[40], expected = 0;
+            for (int i = 0; i < 40; i++) {
+                best[i] = 1;
+                for (int j = 0; j < i; j++) {
+                    bool extends = strict ? values[j] < values[i] : values[j] <= values[i];
+                    if (extends && best[j] + 1 > best[i]) best[i] = best[j] + 1;
+                }
+                if (best[i] > expected) expected = best[i];
+            }
+            length = lis_compute(values, 40, strict, indices);
+            if (length != expected || !lis_is_valid(values, indices, length, strict)) matches = false;
+        }
+    }
+    TEST_ASSERT(matches, "Batch LIS matches quadratic reference on 40 elements");
+    
+    // Streaming: length after every push, then reconstruction
+    LISState stream;
+    lis_init(&stream, true, true);
+    bool prefix_ok = true;
+    for (int i = 0; i < 40; i++) {
+        size_t current = lis_push(&stream, values[i]);
+        if (current != lis_compute(values, (size_t)i + 1, true, NULL)) prefix_ok = false;
+    }
+    TEST_ASSERT(prefix_ok, "Streaming length matches batch on every prefix");
+    int sequence[40];
+    length = lis_indices(&stream, indices);
+    TEST_ASSERT(length == lis_length(&stream) && lis_is_valid(values, indices, length, true), "Streaming reconstruction is increasing");
+    bool same_values = lis_values(&stream, sequence) == length;
+    for (size_t k = 0; k < length; k++) same_values &= sequence[k] == values[indices[k]];
+    TEST_ASSERT(same_values && lis_tail(&stream) <= sequence[length - 1], "Values follow reconstructed positions");
+    lis_free(&stream);
+    
+    // Length-only streaming keeps just the piles
+    lis_init(&stream, false, false);
+    for (int i = 0; i < 100000; i++) lis_push(&stream, i % 1000);
+    TEST_ASSERT(lis_length(&stream) == 1000 + 99 && stream.parent == NULL, "Length-only stream over a sawtooth");
+    TEST_ASSERT(lis_indices(&stream, indices) == 0, "No reconstruction without tracking");
+    lis_free(&stream);
+    
+    // Every mode agrees on a larger random input
+    const size_t random_n = 100000;
+    int *random_values = malloc(random_n * sizeof(int));
+    size_t *random_positions = malloc(random_n * sizeof(size_t));
+    for (size_t i = 0; i < random_n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        random_values[i] = (int)(seed >> 1);
+    }
+    size_t length_only = lis_compute(random_values, random_n, true, NULL);
+    length = lis_compute(random_values, random_n, true, random_positions);
+    lis_init(&stream, true, true);
+    for (size_t i = 0; i < random_n; i++) lis_push(&stream, random_values[i]);
+    TEST_ASSERT(length == length_only && lis_is_valid(random_values, random_positions, length, true) &&
+                lis_length(&stream) == length, "Length-only, reconstructing and streaming LIS agree on 100000 ints");
+    lis_free(&stream);
+    free(random_values);
+    free(random_positions);
+    
+    printf("LIS tests completed\n");
+}
+
+// Segment tree instantiations used by the tests below
+typedef struct { long long a, b; } AffineMap; // x -> a * x + b, composition is not commutative
+typedef struct { long long sum, count; } SumCount;
+static inline AffineMap affine_then(AffineMap first, AffineMap second) {
+    AffineMap composed = {first.a * second.a, first.b * second.a + second.b};
+    return composed;
+}
+static inline SumCount sum_count_combine(SumCount x, SumCount y) {
+    SumCount combined = {x.sum + y.sum, x.count + y.count};
+    return combined;
+}
+#define RANGE_ADD_APPLY(tag, v) ((SumCount){(v).sum + (tag) * (v).count, (v).count})
+#define RANGE_ADD_COMPOSE(outer, inner) ((outer) + (inner))
+DEFINE_SEGTREE(IntSumTree, long long, SEGTREE_SUM, 0)
+DEFINE_SEGTREE(IntMaxTree, int, SEGTREE_MAX, INT_MIN)
+DEFINE_SEGTREE(AffineTree, AffineMap, affine_then, ((AffineMap){1, 0}))
+DEFINE_LAZY_SEGTREE(RangeAddTree, SumCount, sum_count_combine, ((SumCount){0, 0}), long long,
+                    RANGE_ADD_APPLY, RANGE_ADD_COMPOSE, 0)
+DEFINE_FENWICK(IntFenwick, long long, SEGTREE_SUM, SEGTREE_SUB, 0)
+
+// Test Segment Trees and Fenwick Tree
+void test_segtree() {
+    TEST_START("SEGMENT TREE / FENWICK");
+    
+    enum { N = 1000 };
+    static long long reference[N];
+    static int maxima[N];
+    static AffineMap maps[N];
+    static SumCount leaves[N];
+    unsigned seed = 99;
+    for (int i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        reference[i] = (long long)(seed >> 16) % 1000 - 500;
+        maxima[i] = (int)(seed >> 8) % 100000;
+        maps[i] = (AffineMap){(long long)(seed % 3) + 1, (long long)(seed >> 20) % 7};
+        leaves[i] = (SumCount){reference[i], 1};
+    }
+    
+    IntSumTree sums;
+    IntMaxTree maxes;
+    AffineTree affine;
+    RangeAddTree lazy;
+    IntFenwick fenwick;
+    IntSumTree_build(&sums, reference, N);
+    IntMaxTree_build(&maxes, maxima, N);
+    AffineTree_build(&affine, maps, 20); // Short: products stay in range
+    RangeAddTree_build(&lazy, leaves, N);
+    IntFenwick_build(&fenwick, reference, N);
+    TEST_ASSERT(sums.size == 1024 && IntSumTree_all(&sums) == IntSumTree_query(&sums, 0, N), "Leaves padded to a power of two");
+    
+    // Random point updates and range queries against a plain array
+    bool sum_ok = true, max_ok = true, lazy_ok = true, fenwick_ok = true;
+    for (int round = 0; round < 2000; round++) {
+        seed = seed * 1103515245u + 12345u;
+        size_t lo = (seed >> 8) % N, hi = (seed >> 18) % (N + 1);
+        if (lo > hi) { size_t swap = lo; lo = hi; hi = swap; }
+        long long delta = (long long)(seed % 41) - 20;
+        if (round % 3 == 0) {
+            // Point update in every structure
+            reference[lo] += delta;
+            maxima[lo] = (int)(seed >> 4) % 100000;
+            IntSumTree_set(&sums, lo, reference[lo]);
+            IntMaxTree_set(&maxes, lo, maxima[lo]);
+            RangeAddTree_set(&lazy, lo, (SumCount){reference[lo], 1});
+            IntFenwick_add(&fenwick, lo, delta);
+        } else if (round % 3 == 1) {
+            // Range add only the lazy tree supports; mirror it into the others point by point
+            RangeAddTree_apply(&lazy, lo, hi, delta);
+            for (size_t i = lo; i < hi; i++) {
+                reference[i] += delta;
+                IntSumTree_set(&sums, i, reference[i]);
+                IntFenwick_add(&fenwick, i, delta);
+            }
+        }
+        long long expected = 0;
+        int expected_max = INT_MIN;
+        for (size_t i = lo; i < hi; i++) {
+            expected += reference[i];
+            if (maxima[i] > expected_max) expected_max = maxima[i];
+        }
+        sum_ok &= IntSumTree_query(&sums, lo, hi) == expected;
+        max_ok &= IntMaxTree_query(&maxes, lo, hi) == expected_max;
+        SumCount got = RangeAddTree_query(&lazy, lo, hi);
+        lazy_ok &= got.sum == expected && got.count == (long long)(hi - lo);
+        fenwick_ok &= IntFenwick_range(&fenwick, lo, hi) == expected;
+    }
+    TEST_ASSERT(sum_ok, "Sum tree matches brute force under point updates");
+    TEST_ASSERT(max_ok, "Max tree matches brute force (empty range gives identity)");
+    TEST_ASSERT(lazy_ok, "Lazy range add + range sum matches brute force");
+    TEST_ASSERT(fenwick_ok, "Fenwick range sums match brute force");
+    bool points_ok = true;
+    for (size_t i = 0; i < N; i++) points_ok &= RangeAddTree_get(&lazy, i).sum == reference[i];
+    TEST_ASSERT(points_ok && RangeAddTree_all(&lazy).sum == IntFenwick_prefix(&fenwick, N), "Lazy point reads see pushed tags");
+    
+    // Non-commutative monoid: queries compose maps in index order
+    bool order_ok = true;
+    for (size_t lo = 0; lo < 20; lo++) {
+        for (size_t hi = lo; hi <= 20; hi++) {
+            AffineMap expected = {1, 0};
+            for (size_t i = lo; i < hi; i++) expected = affine_then(expected, maps[i]);
+            AffineMap got = AffineTree_query(&affine, lo, hi);
+            order_ok &= got.a == expected.a && got.b == expected.b;
+        }
+    }
+    TEST_ASSERT(order_ok, "Non-commutative combine keeps index order");
+    
+    // Growing keeps existing elements and pads with the identity
+    IntSumTree_resize(&sums, 5000);
+    IntSumTree_set(&sums, 4999, 7);
+    TEST_ASSERT(sums.n == 5000 && IntSumTree_query(&sums, 0, N) == IntFenwick_prefix(&fenwick, N) &&
+                IntSumTree_query(&sums, N, 5000) == 7, "Resize preserves elements");
+    
+    IntSumTree_free(&sums);
+    IntMaxTree_free(&maxes);
+    AffineTree_free(&affine);
+    RangeAddTree_free(&lazy);
+    IntFenwick_free(&fenwick);
+    
+    printf("Segment tree tests completed\n");
+}
+
+// B+-tree instantiations: int map and a (skill, id) composite key like the ordered indices
+typedef struct { float skill; int id; } SkillKey;
+#define SKILL_KEY_CMP(a, b) ((a).skill != (b).skill ? BTREE_CMP((a).skill, (b).skill) : BTREE_CMP((a).id, (b).id))
+DEFINE_BTREE(IntBTree, int, int, BTREE_CMP)
+DEFINE_BTREE(SkillBTree, SkillKey, int, SKILL_KEY_CMP)
+
+static bool btree_sum_skill_ids(const SkillKey *key, int *value, void *ctx) {
+    (void)value;
+    *(long long*)ctx += key->id;
+    return true;
+}
+
+// Test B+-tree
+// Distinct 64-bit key hashes for the filter tests
+static uint64_t filter_test_hash(uint64_t key) {
+    return fast_hash_bytes(&key, sizeof(key), 0);
+}
+
+void test_filters() {
+    TEST_START("MEMBERSHIP FILTERS");
+    
+    // Blocked Bloom filter: no false negatives, false positives near the target
+    enum { KEYS = 50000 };
+    BloomFilter bloom;
+    bloom_filter_init(&bloom, KEYS, 0.01);
+    for (uint64_t i = 0; i < KEYS; i++) bloom_filter_add_hash(&bloom, filter_test_hash(i));
+    bool bloom_hits = true;
+    size_t bloom_false = 0;
+    for (uint64_t i = 0; i < KEYS; i++) {
+        bloom_hits &= bloom_filter_may_contain_hash(&bloom, filter_test_hash(i));
+        bloom_false += bloom_filter_may_contain_hash(&bloom, filter_test_hash(i + KEYS));
+    }
+    TEST_ASSERT(bloom_hits, "Bloom filter has no false negatives");
+    TEST_ASSERT(bloom_false < KEYS / 50, "Bloom false-positive rate stays near 1%");
+    bloom_filter_add_string(&bloom, "Curry");
+    TEST_ASSERT(bloom_filter_may_contain_string(&bloom, "Curry"), "Bloom filter takes string keys");
+    bloom_filter_clear(&bloom);
+    TEST_ASSERT(!bloom_filter_may_contain_string(&bloom, "Curry") && bloom.count == 0, "Cleared Bloom filter is empty");
+    bloom_filter_free(&bloom);
+    
+    // Cuckoo filter: deletions and an explicit full signal
+    CuckooFilter cuckoo;
+    cuckoo_filter_init(&cuckoo, KEYS, 0.01);
+    bool cuckoo_added = true, cuckoo_hits = true;
+    for (uint64_t i = 0; i < KEYS; i++) cuckoo_added &= cuckoo_filter_add_hash(&cuckoo, filter_test_hash(i));
+    size_t cuckoo_false = 0;
+    for (uint64_t i = 0; i < KEYS; i++) {
+        cuckoo_hits &= cuckoo_filter_may_contain_hash(&cuckoo, filter_test_hash(i));
+        cuckoo_false += cuckoo_filter_may_contain_hash(&cuckoo, filter_test_hash(i + KEYS));
+    }
+    TEST_ASSERT(cuckoo_added && cuckoo_hits && cuckoo_filter_size(&cuckoo) == KEYS, "Cuckoo filter holds every key");
+    TEST_ASSERT(cuckoo_false < KEYS / 50, "Cuckoo false-positive rate stays near 1%");
+    bool removed_ok = true;
+    for (uint64_t i = 0; i < KEYS; i += 2) removed_ok &= cuckoo_filter_remove_hash(&cuckoo, filter_test_hash(i));
+    for (uint64_t i = 1; i < KEYS; i += 2) removed_ok &= cuckoo_filter_may_contain_hash(&cuckoo, filter_test_hash(i));
+    TEST_ASSERT(removed_ok && cuckoo_filter_size(&cuckoo) == KEYS / 2, "Removals keep the other keys");
+    uint64_t next = 2 * KEYS;
+    while (cuckoo_filter_add_hash(&cuckoo, filter_test_hash(next))) next++;
+    size_t slots = cuckoo.bucket_count * CUCKOO_FILTER_BUCKET_SLOTS;
+    TEST_ASSERT(cuckoo_filter_size(&cuckoo) * 100 >= slots * 90, "Cuckoo filter fills past 90% before failing");
+    bool full_hits = cuckoo.has_victim;
+    for (uint64_t i = 2 * KEYS; i < next; i++) full_hits &= cuckoo_filter_may_contain_hash(&cuckoo, filter_test_hash(i));
+    TEST_ASSERT(full_hits, "Keys accepted up to the full signal are all kept");
+    cuckoo_filter_free(&cuckoo);
+    
+    // Filtered set against a plain set, through filter growth and removals
+    FilteredHashSet filtered;
+    HashSet plain;
+    filtered_hashset_init_string(&filtered, 0.01);
+    hashset_init_string(&plain);
+    char key[32];
+    bool agree = true;
+    unsigned seed = 7;
+    for (int round = 0; round < 30000; round++) {
+        seed = seed * 1103515245u + 12345u;
+        snprintf(key, sizeof(key), "key%u", (seed >> 8) % 8000);
+        if ((seed >> 4) % 4) agree &= filtered_hashset_add(&filtered, key) == hashset_add(&plain, key);
+        else agree &= filtered_hashset_remove(&filtered, key) == hashset_remove(&plain, key);
+    }
+    for (int i = 0; i < 16000; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        agree &= filtered_hashset_contains_string(&filtered, key) == hashset_contains_string(&plain, key);
+    }
+    TEST_ASSERT(agree && filtered_hashtable_size(&filtered) == hashset_size(&plain), "Filtered set matches a plain set");
+    TEST_ASSERT(cuckoo_filter_size(&filtered.filter) == hashset_size(&plain), "Filter tracks exactly the stored keys");
+    filtered_hashset_free(&filtered);
+    hashset_free(&plain);
+}
+
+void test_bitsets() {
+    TEST_START("BITSET AND ROARING SETS");
+    
+    // Dense bitset against a presence array
+    enum { RANGE = 20000 };
+    static bool ref_a[RANGE], ref_b[RANGE];
+    BitSet a, b, result;
+    bitset_init(&a, 0);
+    bitset_init(&b, 0);
+    bitset_init(&result, 0);
+    bool ops_ok = true;
+    unsigned seed = 5;
+    for (int round = 0; round < 40000; round++) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t value = (seed >> 8) % ((seed & 1) ? RANGE : RANGE / 4);
+        bool *ref = (seed >> 4) & 1 ? ref_a : ref_b;
+        BitSet *set = ref == ref_a ? &a : &b;
+        if ((seed >> 5) % 4) {
+            ops_ok &= bitset_add(set, value) == !ref[value];
+            ref[value] = true;
+        } else {
+            ops_ok &= bitset_remove(set, value) == ref[value];
+            ref[value] = false;
+        }
+    }
+    size_t count_a = 0, count_b = 0, count_or = 0, count_and = 0, count_diff = 0;
+    for (int v = 0; v < RANGE; v++) {
+        ops_ok &= bitset_contains(&a, (uint32_t)v) == ref_a[v] && bitset_contains_int(&b, v) == ref_b[v];
+        count_a += ref_a[v];
+        count_b += ref_b[v];
+        count_or += ref_a[v] || ref_b[v];
+        count_and += ref_a[v] && ref_b[v];
+        count_diff += ref_a[v] && !ref_b[v];
+    }
+    TEST_ASSERT(ops_ok && bitset_size(&a) == count_a && bitset_size(&b) == count_b, "Bitset add/remove/contains match reference");
+    TEST_ASSERT(!bitset_add_int(&a, -1) && !bitset_contains_int(&a, -1) && !bitset_contains(&a, 1u << 30),
+                "Negative and out-of-range values are absent");
+    
+    bitset_union(&a, &b, &result);
+    bool algebra_ok = bitset_size(&result) == count_or;
+    bitset_intersection(&a, &b, &result);
+    algebra_ok &= bitset_size(&result) == count_and && bitset_is_subset(&result, &a) && bitset_is_subset(&result, &b);
+    bitset_difference(&a, &b, &result);
+    algebra_ok &= bitset_size(&result) == count_diff;
+    for (int v = 0; v < RANGE; v++) algebra_ok &= bitset_contains(&result, (uint32_t)v) == (ref_a[v] && !ref_b[v]);
+    TEST_ASSERT(algebra_ok, "Bitset union/intersection/difference match reference");
+    
+    BitSet copy;
+    bitset_copy(&a, &copy);
+    bitset_union(&copy, &b, &copy);
+    TEST_ASSERT(bitset_size(&copy) == count_or && bitset_is_subset(&b, &copy) && !bitset_equals(&copy, &a) == (count_or != count_a),
+                "Set operations may write into an operand");
+    bitset_difference(&copy, &copy, &copy);
+    TEST_ASSERT(bitset_is_empty(&copy) && bitset_size(&copy) == 0, "Self-difference is empty");
+    
+    uint32_t previous = 0, value;
+    size_t visited = 0;
+    bool order_ok = true;
+    BitSetIterator bit_it;
+    bitset_iter_init(&bit_it, &a);
+    while (bitset_iter_next(&bit_it, &value)) {
+        order_ok &= ref_a[value] && (visited == 0 || value > previous);
+        previous = value;
+        visited++;
+    }
+    TEST_ASSERT(order_ok && visited == count_a, "Bitset iterates in ascending order");
+    bitset_free(&copy);
+    
+    // Roaring set: same operations across sparse, array and bitmap chunks
+    RoaringSet ra, rb, rresult;
+    roaring_init(&ra);
+    roaring_init(&rb);
+    roaring_init(&rresult);
+    bitset_clear(&a);
+    bitset_clear(&b);
+    bool roaring_ok = true;
+    for (int round = 0; round < 120000; round++) {
+        seed = seed * 1103515245u + 12345u;
+        // Chunk 0 dense (bitmap), chunk 1 around the array limit, chunks 14 and 21 sparse (arrays)
+        uint32_t pick = (seed >> 27) % 16;
+        uint32_t chunk = pick < 8 ? 0 : pick < 15 ? 1 : 14 + 7 * ((seed >> 2) & 1);
+        uint32_t low = chunk == 0 ? (seed >> 6) % 20000 : chunk == 1 ? (seed >> 6) % 6000 : (seed >> 6) % 65536;
+        uint32_t roaring_value = (chunk << 16) | low;
+        bool first = (seed >> 3) & 1;
+        RoaringSet *rset = first ? &ra : &rb;
+        BitSet *mirror = first ? &a : &b;
+        if ((seed >> 4) % 5) roaring_ok &= roaring_add(rset, roaring_value) == bitset_add(mirror, roaring_value);
+        else roaring_ok &= roaring_remove(rset, roaring_value) == bitset_remove(mirror, roaring_value);
+    }
+    TEST_ASSERT(roaring_ok && roaring_size(&ra) == bitset_size(&a) && roaring_size(&rb) == bitset_size(&b),
+                "Roaring add/remove match a bitset");
+    bool has_array = false, has_bitmap = false;
+    for (size_t i = 0; i < ra.count; i++) {
+        has_bitmap |= ra.containers[i].is_bitmap;
+        has_array |= !ra.containers[i].is_bitmap;
+    }
+    TEST_ASSERT(has_array && has_bitmap, "Sparse chunks use arrays and dense chunks bitmaps");
+    
+    RoaringIterator roaring_it;
+    bool same_values = true;
+    roaring_iter_init(&roaring_it, &ra);
+    bitset_iter_init(&bit_it, &a);
+    uint32_t expected;
+    while (bitset_iter_next(&bit_it, &expected)) same_values &= roaring_iter_next(&roaring_it, &value) && value == expected;
+    same_values &= !roaring_iter_next(&roaring_it, &value);
+    TEST_ASSERT(same_values, "Roaring iterates the same values in order");
+    
+    bool roaring_algebra = true;
+    void (*const roaring_ops[3])(RoaringSet *, RoaringSet *, RoaringSet *) = {roaring_union, roaring_intersection, roaring_difference};
+    void (*const bitset_ops[3])(BitSet *, BitSet *, BitSet *) = {bitset_union, bitset_intersection, bitset_difference};
+    for (int op = 0; op < 3; op++) {
+        roaring_ops[op](&ra, &rb, &rresult);
+        bitset_ops[op](&a, &b, &result);
+        bool match = roaring_size(&rresult) == bitset_size(&result);
+        roaring_iter_init(&roaring_it, &rresult);
+        bitset_iter_init(&bit_it, &result);
+        while (bitset_iter_next(&bit_it, &expected)) match &= roaring_iter_next(&roaring_it, &value) && value == expected;
+        for (size_t i = 0; i < rresult.count; i++) {
+            const RoaringContainer *c = &rresult.containers[i];
+            match &= c->cardinality > 0 && c->is_bitmap == (c->cardinality > ROARING_ARRAY_MAX);
+        }
+        roaring_algebra &= match;
+    }
+    TEST_ASSERT(roaring_algebra, "Roaring union/intersection/difference match a bitset");
+    roaring_intersection(&ra, &rb, &rresult);
+    TEST_ASSERT(roaring_is_subset(&rresult, &ra) && roaring_is_subset(&rresult, &rb) &&
+                roaring_is_subset(&ra, &rb) == bitset_is_subset(&a, &b), "Roaring subset checks");
+    
+    RoaringSet rcopy;
+    roaring_copy(&ra, &rcopy);
+    TEST_ASSERT(roaring_equals(&rcopy, &ra) && !roaring_equals(&rcopy, &rb), "Roaring copy equals its source");
+    roaring_union(&rcopy, &rb, &rcopy);
+    roaring_difference(&rcopy, &rb, &rcopy);
+    bitset_difference(&a, &b, &result);
+    TEST_ASSERT(roaring_size(&rcopy) == bitset_size(&result), "Roaring operations may write into an operand");
+    roaring_ok = true;
+    for (int v = 0; v < 30000; v++) roaring_ok &= roaring_remove_int(&rcopy, v) == bitset_remove_int(&result, v);
+    TEST_ASSERT(roaring_ok && roaring_size(&rcopy) == bitset_size(&result) && !roaring_contains_int(&rcopy, 5),
+                "Bitmap chunks shrink back to arrays on removal");
+    roaring_clear(&rcopy);
+    TEST_ASSERT(roaring_is_empty(&rcopy) && rcopy.count == 0, "Cleared roaring set is empty");
+    roaring_free(&rcopy);
+    
+    roaring_free(&ra);
+    roaring_free(&rb);
+    roaring_free(&rresult);
+    bitset_free(&a);
+    bitset_free(&b);
+    bitset_free(&result);
+}
+
+void test_stats() {
+    TEST_START("DS_STATS INSTRUMENTATION");
+    
+    ds_stats_reset();
+    int values[512];
+    for (int i = 0; i < 512; i++) values[i] = (i * 131) % 512;
+    
+    HashTable chained;
+    hashtable_init_int(&chained);
+    FlatHashTable flat;
+    flat_hashtable_init_int(&flat);
+    for (int i = 0; i < 512; i++) {
+        hashtable_put_int(&chained, i, &values[i]);
+        flat_hashtable_put_int(&flat, i, &values[i]);
+    }
+    bool found = true;
+    for (int i = 0; i < 512; i++) {
+        found &= hashtable_get_int(&chained, i) == &values[i];
+        found &= flat_hashtable_get_int(&flat, i) == &values[i];
+    }
+    TEST_ASSERT(found, "Instrumented tables still find every key");
+    
+    DynArray arr;
+    dynarray_init(&arr, 1);
+    for (int i = 0; i < 512; i++) dynarray_push(&arr, &values[i]);
+    
+    MinHeap heap;
+    min_heap_init(&heap, 4);
+    DaryHeap dary;
+    dary_heap_init(&dary, 4, heap_int_compare_min, 4);
+    IndexedHeap indexed;
+    indexed_heap_init(&indexed, heap_int_compare_min, 4);
+    for (int i = 0; i < 512; i++) {
+        min_heap_push(&heap, &values[i]);
+        dary_heap_push(&dary, &values[i]);
+        indexed_heap_push(&indexed, (size_t)i, &values[i]);
+    }
+    bool ordered = true;
+    for (int i = 0; i < 512; i++) {
+        ordered &= *(int*)min_heap_pop(&heap) == i;
+        ordered &= *(int*)dary_heap_pop(&dary) == i;
+        ordered &= *(int*)indexed_heap_pop(&indexed, NULL) == i;
+    }
+    TEST_ASSERT(ordered, "Instrumented heaps still pop in order");
+    
+    DSStatsSnapshot snap[DS_STATS_KIND_COUNT];
+    for (int kind = 0; kind < DS_STATS_KIND_COUNT; kind++) ds_stats_snapshot((DSStatsKind)kind, &snap[kind]);
+    
+#ifdef DS_STATS
+    TEST_ASSERT(ds_stats_enabled(), "Counters report as compiled in");
+    TEST_ASSERT(snap[DS_STATS_HASHTABLE].lookups >= 512 && snap[DS_STATS_FLAT_HASHTABLE].lookups >= 512,
+                "Every get records a probe length");
+    uint64_t histogram_total = 0;
+    for (unsigned b = 0; b < DS_STATS_HISTOGRAM_BUCKETS; b++) {
+        histogram_total += snap[DS_STATS_FLAT_HASHTABLE].probe_histogram[b];
+    }
+    TEST_ASSERT(histogram_total == snap[DS_STATS_FLAT_HASHTABLE].lookups &&
+                snap[DS_STATS_FLAT_HASHTABLE].probe_max >= 1 &&
+                snap[DS_STATS_FLAT_HASHTABLE].probe_steps >= snap[DS_STATS_FLAT_HASHTABLE].lookups,
+                "Probe histogram covers every lookup");
+    TEST_ASSERT(snap[DS_STATS_HASHTABLE].resizes > 0 && snap[DS_STATS_FLAT_HASHTABLE].resizes > 0 &&
+                snap[DS_STATS_DYNARRAY].resizes >= 9, "Growth records resize events");
+    TEST_ASSERT(snap[DS_STATS_BINARY_HEAP].sifts >= 1000 && snap[DS_STATS_DARY_HEAP].sifts >= 1000 &&
+                snap[DS_STATS_INDEXED_HEAP].sifts >= 1000, "Push and pop record sift depths");
+    TEST_ASSERT(snap[DS_STATS_BINARY_HEAP].sift_max >= 8 && snap[DS_STATS_BINARY_HEAP].sift_max <= 9 &&
+                snap[DS_STATS_DARY_HEAP].sift_max <= snap[DS_STATS_BINARY_HEAP].sift_max,
+                "Sift depth is bounded by tree height");
+    bool allocated = true;
+    for (int kind = 0; kind < DS_STATS_KIND_COUNT; kind++) {
+        if (kind == DS_STATS_BINARY_HEAP) continue; // Storage is a DynArray, counted there
+        allocated &= snap[kind].allocations > 0 && snap[kind].allocated_bytes > 0;
+    }
+    TEST_ASSERT(allocated, "Every container that owns storage records allocations");
+    ds_stats_reset();
+    DSStatsSnapshot cleared;
+    ds_stats_snapshot(DS_STATS_HASHTABLE, &cleared);
+    TEST_ASSERT(cleared.lookups == 0 && cleared.allocations == 0, "Reset zeroes the registry");
+#else
+    TEST_ASSERT(!ds_stats_enabled(), "Counters report as compiled out");
+    bool zero = true;
+    for (int kind = 0; kind < DS_STATS_KIND_COUNT; kind++) {
+        zero &= snap[kind].lookups == 0 && snap[kind].resizes == 0 && snap[kind].sifts == 0 &&
+                snap[kind].allocations == 0;
+    }
+    TEST_ASSERT(zero, "Disabled build reports zero counters");
+#endif
+    
+    FILE *out = tmpfile();
+    TEST_ASSERT(out != NULL, "Opened scratch file for exports");
+    if (out) {
+        char buffer[16384];
+        ds_stats_write_json(out);
+        rewind(out);
+        size_t n = fread(buffer, 1, sizeof(buffer) - 1, out);
+        buffer[n] = '\0';
+        TEST_ASSERT(strstr(buffer, "\"enabled\"") && strstr(buffer, "\"flat_hashtable\"") &&
+                    strstr(buffer, "\"+Inf\""), "JSON export lists every container");
+        
+        rewind(out);
+        ds_stats_write_prometheus(out);
+        long end = ftell(out);
+        rewind(out);
+        n = fread(buffer, 1, sizeof(buffer) - 1, out);
+        buffer[n] = '\0';
+        TEST_ASSERT(end > 0 && (size_t)end == n && strstr(buffer, "ds_probe_length_bucket{container=\"hashtable\",le=\"+Inf\"}") &&
+                    strstr(buffer, "# TYPE ds_resizes_total counter"), "Prometheus export uses text exposition format");
+        fclose(out);
+    }
+    
+    indexed_heap_free(&indexed);
+    dary_heap_free(&dary);
+    min_heap_free(&heap);
+    dynarray_free(&arr);
+    flat_hashtable_free(&flat);
+    hashtable_free(&chained);
+}
+
+void test_btree() {
+    TEST_START("B+-TREE");
+    
+    // Random inserts, replacements and deletes against a presence array
+    enum { KEYS = 20000 };
+    static int reference[KEYS];
+    static bool present[KEYS];
+    IntBTree map;
+    IntBTree_init(&map);
+    bool results_ok = true, values_ok = true;
+    size_t live = 0;
+    unsigned seed = 31;
+    for (int round = 0; round < 200000; round++) {
+        seed = seed * 1103515245u + 12345u;
+        int key = (int)((seed >> 8) % KEYS);
+        if ((seed >> 4) % 3) {
+            bool inserted = IntBTree_insert(&map, key, round);
+            results_ok &= inserted == !present[key];
+            live += !present[key];
+            present[key] = true;
+            reference[key] = round;
+        } else {
+            results_ok &= IntBTree_delete(&map, key) == present[key];
+            live -= present[key];
+            present[key] = false;
+        }
+        if (round % 50000 == 0) results_ok &= IntBTree_is_valid(&map);
+    }
+    for (int key = 0; key < KEYS; key++) {
+        int *value = IntBTree_get(&map, key);
+        values_ok &= present[key] ? value && *value == reference[key] : !value && !IntBTree_search(&map, key);
+    }
+    TEST_ASSERT(results_ok && IntBTree_is_valid(&map) && IntBTree_size(&map) == live, "Inserts/deletes keep the invariants");
+    TEST_ASSERT(values_ok, "Lookups match the reference");
+    TEST_ASSERT(map.height >= 2, "Tree grew several levels");
+    
+    // In-order iteration over the leaf chain and lower bound
+    bool order_ok = true;
+    int expected = -1;
+    size_t seen = 0;
+    for (IntBTreeIter it = IntBTree_begin(&map); IntBTree_iter_valid(&it); IntBTree_iter_next(&it)) {
+        do expected++; while (!present[expected]);
+        order_ok &= *IntBTree_iter_key(&it) == expected && *IntBTree_iter_value(&it) == reference[expected];
+        seen++;
+    }
+    TEST_ASSERT(order_ok && seen == live, "Leaf chain visits keys in order");
+    int next = 12345;
+    while (next < KEYS && !present[next]) next++;
+    IntBTreeIter probe = IntBTree_lower_bound(&map, 12345);
+    TEST_ASSERT(next < KEYS ? IntBTree_iter_valid(&probe) && *IntBTree_iter_key(&probe) == next : !IntBTree_iter_valid(&probe),
+                "Lower bound finds the next present key");
+    probe = IntBTree_lower_bound(&map, KEYS);
+    TEST_ASSERT(!IntBTree_iter_valid(&probe), "Lower bound past the end is invalid");
+    
+    // Delete everything: the tree shrinks back to empty
+    for (int key = 0; key < KEYS; key++) IntBTree_delete(&map, key);
+    TEST_ASSERT(IntBTree_size(&map) == 0 && map.root == NULL && IntBTree_is_valid(&map), "Tree empties completely");
+    
+    // Bulk load sorted input, then keep mutating it
+    static int sorted[KEYS], payload[KEYS];
+    for (int i = 0; i < KEYS; i++) {
+        sorted[i] = 2 * i;
+        payload[i] = -i;
+    }
+    IntBTree_build(&map, sorted, payload, KEYS);
+    TEST_ASSERT(IntBTree_is_valid(&map) && IntBTree_size(&map) == KEYS && *IntBTree_get(&map, 19998) == -9999,
+                "Bulk load builds a valid tree");
+    bool bulk_ok = true;
+    for (int i = 0; i < KEYS; i += 3) bulk_ok &= IntBTree_delete(&map, 2 * i) && IntBTree_insert(&map, 2 * i + 1, i);
+    TEST_ASSERT(bulk_ok && IntBTree_is_valid(&map) && IntBTree_size(&map) == KEYS, "Bulk-loaded tree accepts updates");
+    IntBTree_free(&map);
+    
+    // Composite keys from a pool, range query by skill
+    Pool nodes;
+    pool_init(&nodes, SkillBTree_NODE_SIZE, 0);
+    SkillBTree skills;
+    SkillBTree_init_with_allocator(&skills, pool_allocator(&nodes));
+    long long expected_ids = 0;
+    for (int id = 1; id <= 5000; id++) {
+        SkillKey key = {(float)(id % 100), id};
+        SkillBTree_insert(&skills, key, id);
+        if (id % 100 >= 90) expected_ids += id;
+    }
+    long long range_ids = 0;
+    SkillKey lo = {90.0f, INT_MIN}, hi = {99.0f, INT_MAX};
+    SkillBTree_range(&skills, lo, hi, btree_sum_skill_ids, &range_ids);
+    TEST_ASSERT(SkillBTree_is_valid(&skills) && range_ids == expected_ids, "Range over composite keys");
+    SkillBTree_free(&skills);
+    pool_destroy(&nodes);
+    
+    printf("B+-tree tests completed\n");
+}
+
+// Test Static (Eytzinger) Tree
+void test_static_tree() {
+    TEST_START("STATIC TREE");
+    
+    // Every size up to a few levels, queries on and between keys (even values, some repeated)
+    bool lower_ok = true, search_ok = true, many_ok = true;
+    int sorted[200], queries[450];
+    bool found[450];
+    for (size_t n = 0; n <= 200; n++) {
+        for (size_t i = 0; i < n; i++) sorted[i] = (int)(i - i % 3) * 2 - 100;
+        StaticTree frozen;
+        static_tree_from_sorted_array(&frozen, sorted, n);
+        size_t count = 0;
+        for (int q = -110; q < 340; q++) {
+            size_t expected = 0;
+            while (expected < n && sorted[expected] < q) expected++;
+            size_t slot = static_tree_lower_bound(&frozen, q);
+            lower_ok &= expected == n ? slot == 0 : slot != 0 && static_tree_key(&frozen, slot) == sorted[expected];
+            bool present = expected < n && sorted[expected] == q;
+            search_ok &= static_tree_search(&frozen, q) == present;
+            queries[count++] = q;
+        }
+        static_tree_search_many(&frozen, queries, count, found);
+        for (size_t i = 0; i < count; i++) many_ok &= found[i] == static_tree_search(&frozen, queries[i]);
+        static_tree_free(&frozen);
+    }
+    TEST_ASSERT(lower_ok, "Lower bound matches linear scan for sizes 0-200");
+    TEST_ASSERT(search_ok, "Search finds exactly the stored keys");
+    TEST_ASSERT(many_ok, "Batched search agrees with single lookups");
+    
+    // Freezing a pointer tree keeps its keys and works on the aligned layout
+    Tree tree;
+    int values[] = {50, 20, 80, 10, 30, 70, 90, 60};
+    tree_init(&tree);
+    tree_insert_array(&tree, values, 8);
+    tree_insert(&tree, 30);
+    TEST_ASSERT(tree_size(&tree) == 8, "Tree size counts distinct inserts");
+    StaticTree frozen;
+    tree_freeze(&tree, &frozen);
+    TEST_ASSERT(static_tree_size(&frozen) == 8 && static_tree_search(&frozen, 60) && !static_tree_search(&frozen, 65) &&
+                static_tree_key(&frozen, static_tree_lower_bound(&frozen, 65)) == 70 &&
+                static_tree_lower_bound(&frozen, 91) == 0, "Frozen tree answers like the original");
+    TEST_ASSERT(((uintptr_t)frozen.keys % STATIC_TREE_CACHE_LINE) == 0, "Layout is cache-line aligned");
+    static_tree_free(&frozen);
+    tree_free(&tree);
+    
+    printf("Static tree tests completed\n");
+}
+
+// Test Adaptive Radix Trie
+typedef struct {
+    const char *prefix;
+    const char *last;
+    size_t count;
+    bool ordered;
+} TriePrefixCheck;
+
+static bool trie_check_visit(const char *key, void *value, void *ctx) {
+    (void)value;
+    TriePrefixCheck *check = (TriePrefixCheck*)ctx;
+    check->ordered &= strncmp(key, check->prefix, strlen(check->prefix)) == 0 &&
+                      (!check->last || strcmp(check->last, key) < 0);
+    check->last = key;
+    check->count++;
+    return true;
+}
+
+static bool trie_stop_after_two(const char *key, void *value, void *ctx) {
+    (void)key;
+    (void)value;
+    return ++*(size_t*)ctx < 2;
+}
+
+// Highest score among live keys with prefix, below the given bound (brute force)
+static int trie_best_below(char (*keys)[40], const float *scores, const bool *live, int n,
+                           const char *prefix, float bound) {
+    int best = -1;
+    for (int i = 0; i < n; i++) {
+        if (!live[i] || strncmp(keys[i], prefix, strlen(prefix)) != 0 || scores[i] >= bound) continue;
+        if (best < 0 || scores[i] > scores[best]) best = i;
+    }
+    return best;
+}
+
+void test_trie() {
+    TEST_START("ADAPTIVE RADIX TRIE");
+    
+    // Mix of shared prefixes (node4/16, long compressed paths) and wide fan-out (node48/256)
+    enum { N = 3000 };
+    static char keys[N][40];
+    static float scores[N];
+    static bool live[N];
+    unsigned seed = 7;
+    for (int i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        if (i % 3 == 0) {
+            snprintf(keys[i], sizeof(keys[i]), "Player %d", i);
+        } else if (i % 3 == 1) {
+            snprintf(keys[i], sizeof(keys[i]), "a-very-long-shared-team-prefix/%d", i);
+        } else {
+            keys[i][0] = (char)(1 + (seed >> 8) % 255);
+            snprintf(keys[i] + 1, sizeof(keys[i]) - 1, "%u", seed % 97 + (unsigned)i * 100);
+        }
+        scores[i] = (float)((i * 7919) % N); // Distinct
+        live[i] = true;
+    }
+    
+    Trie trie;
+    trie_init(&trie);
+    bool inserted = true;
+    for (int i = 0; i < N; i++) inserted &= trie_insert(&trie, keys[i], scores[i], keys[i]);
+    TEST_ASSERT(inserted && trie_size(&trie) == N, "All distinct keys inserted");
+    bool found = true;
+    for (int i = 0; i < N; i++) found &= trie_get(&trie, keys[i]) == keys[i];
+    TEST_ASSERT(found, "Every key found");
+    TEST_ASSERT(!trie_get(&trie, "Player") && !trie_get(&trie, "Player 30000") &&
+                !trie_get(&trie, "a-very-long-shared-team-prefix/") &&
+                !trie_get(&trie, "a-very-long-shared-team-prefiX/1") && !trie_get(&trie, ""),
+                "Prefixes and near misses are not keys");
+    TEST_ASSERT(!trie_insert(&trie, keys[0], scores[0], keys[1]) && trie_get(&trie, keys[0]) == keys[1] &&
+                trie_size(&trie) == N, "Inserting an existing key replaces its value");
+    trie_insert(&trie, keys[0], scores[0], keys[0]);
+    
+    // Prefix iteration: sorted, complete and early-stoppable
+    const char *prefixes[] = {"", "Player ", "Player 1", "Player 12", "a-very-long", "a-very-long-shared-team-prefix/2",
+                              "a-very-long-shared-team-prefix/29", "Player 9999", "b", "a-very-long-shared-tean"};
+    bool prefix_ok = true;
+    for (size_t p = 0; p < sizeof(prefixes) / sizeof(prefixes[0]); p++) {
+        size_t expected = 0;
+        for (int i = 0; i < N; i++) expected += strncmp(keys[i], prefixes[p], strlen(prefixes[p])) == 0;
+        TriePrefixCheck check = {prefixes[p], NULL, 0, true};
+        size_t visited = trie_prefix_iterate(&trie, prefixes[p], trie_check_visit, &check);
+        prefix_ok &= check.ordered && check.count == expected && visited == expected;
+    }
+    TEST_ASSERT(prefix_ok, "Prefix iteration visits exactly the matches in order");
+    size_t stopped = 0;
+    TEST_ASSERT(trie_prefix_iterate(&trie, "Player", trie_stop_after_two, &stopped) == 2 && stopped == 2,
+                "Callback can stop iteration");
+    
+    // Top-k completion against brute force, then after score changes and removals
+    bool top_ok = true;
+    void *top[10];
+    for (int round = 0; round < 3; round++) {
+        for (size_t p = 0; p < sizeof(prefixes) / sizeof(prefixes[0]); p++) {
+            size_t got = trie_top_k(&trie, prefixes[p], 10, top);
+            float bound = 1e9f;
+            for (size_t r = 0; r < 10; r++) {
+                int best = trie_best_below(keys, scores, live, N, prefixes[p], bound);
+                if (best < 0) {
+                    top_ok &= got == r;
+                    break;
+                }
+                top_ok &= r < got && top[r] == keys[best];
+                bound = scores[best];
+            }
+        }
+        if (round == 0) {
+            // Raise and lower scores: cached maxima must follow both ways
+            for (int i = 0; i < N; i += 5) {
+                scores[i] = i % 2 ? scores[i] + N : scores[i] - N;
+                trie_update_score(&trie, keys[i], scores[i]);
+            }
+        } else if (round == 1) {
+            for (int i = 0; i < N; i += 2) {
+                live[i] = false;
+                top_ok &= trie_remove(&trie, keys[i]) == keys[i];
+            }
+        }
+    }
+    TEST_ASSERT(top_ok, "Top-k matches brute force across updates and removals");
+    
+    bool removed_ok = trie_size(&trie) == N / 2 && !trie_remove(&trie, keys[0]) && !trie_update_score(&trie, keys[0], 1.0f);
+    for (int i = 0; i < N; i++) removed_ok &= (trie_get(&trie, keys[i]) != NULL) == live[i];
+    TEST_ASSERT(removed_ok, "Removed keys are gone, others remain");
+    
+    // Remove everything (nodes shrink back down), then reuse the pools
+    for (int i = 1; i < N; i += 2) trie_remove(&trie, keys[i]);
+    TEST_ASSERT(trie_size(&trie) == 0 && trie.root == NULL && trie_top_k(&trie, "", 10, top) == 0, "Trie empties completely");
+    trie_insert(&trie, keys[1], 1.0f, keys[1]);
+    TEST_ASSERT(trie_get(&trie, keys[1]) == keys[1] && trie_top_k(&trie, "a", 10, top) == 1, "Single-leaf trie");
+    trie_free(&trie);
+    
+    printf("Trie tests completed\n");
+}
+
 // Test Circular Linked List
+// Typed container instantiations used by the tests below
+typedef struct { int id; int skill; } TypedPlayer;
+#define TYPED_PLAYER_BY_SKILL(a, b) ((b).skill - (a).skill) // Max skill at root
+DEFINE_DYNARRAY(IntArray, int)
+DEFINE_HEAP(IntMinHeap, int, TYPED_HEAP_MIN_CMP)
+DEFINE_HEAP(SkillHeap, TypedPlayer, TYPED_PLAYER_BY_SKILL)
+DEFINE_HASHMAP(IntIntMap, int, int, TYPED_HASH_INT, TYPED_EQ)
+DEFINE_HASHMAP(StrIntMap, const char *, int, TYPED_HASH_STR, TYPED_STR_EQ)
+DEFINE_DEQUE(IntDeque, int)
+
+// Test Typed Containers
+void test_typed_containers() {
+    TEST_START("TYPED CONTAINERS");
+    
+    // Dynamic array stores ints by value
+    IntArray arr;
+    IntArray_init(&arr, 2);
+    for (int i = 0; i < 100; i++) IntArray_push(&arr, i * 3);
+    TEST_ASSERT(IntArray_size(&arr) == 100, "Typed array size after pushes");
+    TEST_ASSERT(*IntArray_at(&arr, 42) == 126, "Typed array access by value");
+    TEST_ASSERT(IntArray_at(&arr, 100) == NULL, "Out of bounds access returns NULL");
+    IntArray_insert(&arr, 0, -1);
+    int removed = 0;
+    TEST_ASSERT(IntArray_remove(&arr, 0, &removed) && removed == -1, "Insert/remove at front");
+    IntArray_swap_remove(&arr, 0, &removed);
+    TEST_ASSERT(removed == 0 && *IntArray_at(&arr, 0) == 297, "Swap-remove moves last into hole");
+    int last = 0;
+    TEST_ASSERT(IntArray_pop(&arr, &last) && last == 294, "Pop returns last value");
+    IntArray_free(&arr);
+    
+    // Heap with compile-time comparator
+    IntMinHeap heap;
+    IntMinHeap_init(&heap, 0);
+    int input[] = {9, 4, 7, 1, 8, 2, 6, 3, 5, 0};
+    for (int i = 0; i < 10; i++) IntMinHeap_push(&heap, input[i]);
+    TEST_ASSERT(IntMinHeap_is_valid(&heap), "Typed heap property holds");
+    bool sorted = true;
+    for (int i = 0; i < 10; i++) {
+        int v;
+        if (!IntMinHeap_pop(&heap, &v) || v != i) sorted = false;
+    }
+    TEST_ASSERT(sorted, "Typed min heap pops in order");
+    TEST_ASSERT(!IntMinHeap_pop(&heap, NULL), "Pop from empty heap fails");
+    IntMinHeap_build_from_array(&heap, input, 10);
+    TEST_ASSERT(IntMinHeap_is_valid(&heap) && *IntMinHeap_peek(&heap) == 0, "Build from array heapifies");
+    IntMinHeap_free(&heap);
+    
+    SkillHeap skills;
+    SkillHeap_init(&skills, 0);
+    for (int i = 0; i < 20; i++) {
+        TypedPlayer p = {i, (i * 37) % 20}; // Permutation of 0..19
+        SkillHeap_push(&skills, p);
+    }
+    TypedPlayer best;
+    SkillHeap_pop(&skills, &best);
+    TEST_ASSERT(best.skill == 19 && best.id == 7, "Struct heap orders by inlined comparator");
+    SkillHeap_free(&skills);
+    
+    // Hash map with keys and values inline
+    IntIntMap map;
+    IntIntMap_init(&map, 0);
+    const int N = 5000;
+    for (int i = 0; i < N; i++) IntIntMap_put(&map, i, i * 2);
+    TEST_ASSERT(IntIntMap_size(&map) == (size_t)N, "Typed map size after puts");
+    bool all_found = true;
+    for (int i = 0; i < N; i++) {
+        int *v = IntIntMap_get(&map, i);
+        if (!v || *v != i * 2) all_found = false;
+    }
+    TEST_ASSERT(all_found, "Typed map retrieves all values");
+    TEST_ASSERT(!IntIntMap_put(&map, 7, 70) && *IntIntMap_get(&map, 7) == 70, "Put updates existing key");
+    for (int i = 0; i < N; i += 2) IntIntMap_remove(&map, i, NULL);
+    bool parity_ok = true;
+    for (int i = 0; i < N; i++) {
+        if (IntIntMap_contains(&map, i) != (i % 2 == 1)) parity_ok = false;
+    }
+    TEST_ASSERT(parity_ok, "Backward-shift removal keeps remaining keys reachable");
+    size_t pos = 0, iterated = 0;
+    int key, value;
+    while (IntIntMap_next(&map, &pos, &key, &value)) iterated++;
+    TEST_ASSERT(iterated == IntIntMap_size(&map), "Iteration visits every entry");
+    IntIntMap_free(&map);
+    
+    StrIntMap names;
+    StrIntMap_init(&names, 4);
+    StrIntMap_put(&names, "LeBron", 23);
+    StrIntMap_put(&names, "Curry", 30);
+    TEST_ASSERT(*StrIntMap_get(&names, "Curry") == 30, "String-keyed typed map lookup");
+    TEST_ASSERT(StrIntMap_get(&names, "Jordan") == NULL, "Missing string key returns NULL");
+    StrIntMap_free(&names);
+    
+    // Ring-buffer deque wraps and grows
+    IntDeque dq;
+    IntDeque_init(&dq, 0);
+    for (int i = 0; i < 6; i++) IntDeque_push_back(&dq, i);
+    for (int i = 1; i <= 6; i++) IntDeque_push_front(&dq, -i);
+    TEST_ASSERT(IntDeque_size(&dq) == 12, "Typed deque size after wrap and grow");
+    TEST_ASSERT(*IntDeque_front(&dq) == -6 && *IntDeque_back(&dq) == 5, "Front and back correct");
+    bool order_ok = true;
+    for (int i = 0; i < 12; i++) {
+        if (*IntDeque_at(&dq, i) != i - 6) order_ok = false;
+    }
+    TEST_ASSERT(order_ok, "Logical order preserved across growth");
+    int front, back;
+    IntDeque_pop_front(&dq, &front);
+    IntDeque_pop_back(&dq, &back);
+    TEST_ASSERT(front == -6 && back == 5, "Pop from both ends");
+    IntDeque_free(&dq);
+    
+    printf("Typed containers tests completed\n");
+}
+
+// Sort instantiations: typed array with an inlined comparator, records ordered by a field
+DEFINE_DYNARRAY_SORT(IntArray, int, SORT_CMP)
+#define TYPED_PLAYER_SKILL_DESC(a, b) SORT_CMP((b).skill, (a).skill)
+DEFINE_SORT(TypedPlayerSort, TypedPlayer, TYPED_PLAYER_SKILL_DESC)
+
+static int sort_compare_int_elements(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t sort_key_typed_player(const void *element, const void *ctx) {
+    (void)ctx;
+    return sort_key_from_int(((const TypedPlayer*)element)->skill);
+}
+
+void test_sorting() {
+    TEST_START("SORTING");
+    
+    // Introsort against qsort on shapes that break naive quicksort
+    enum { N = 5000 };
+    static int expected[N];
+    const char *shapes[] = {"random", "few distinct", "sorted", "reversed", "organ pipe"};
+    unsigned seed = 17;
+    for (int shape = 0; shape < 5; shape++) {
+        IntArray arr;
+        IntArray_init(&arr, N);
+        for (int i = 0; i < N; i++) {
+            seed = seed * 1103515245u + 12345u;
+            int value = shape == 0 ? (int)(seed >> 1) - (1 << 30)
+                      : shape == 1 ? (int)((seed >> 16) % 5)
+                      : shape == 2 ? i
+                      : shape == 3 ? N - i
+                      : (i < N / 2 ? i : N - i);
+            IntArray_push(&arr, value);
+            expected[i] = value;
+        }
+        qsort(expected, N, sizeof(int), sort_compare_int_elements); // int* either way
+        IntArray_sort(&arr);
+        char message[64];
+        snprintf(message, sizeof(message), "Introsort matches qsort (%s)", shapes[shape]);
+        TEST_ASSERT(memcmp(arr.data, expected, sizeof(expected)) == 0, message);
+        IntArray_free(&arr);
+    }
+    
+    int tiny[] = {3, 1, 2};
+    IntArray_elements_sort(tiny, 0);
+    IntArray_elements_sort(tiny, 1);
+    TEST_ASSERT(tiny[0] == 3 && tiny[1] == 1, "Empty and single-element ranges are untouched");
+    
+    // Struct elements with a field comparator
+    TypedPlayer players[300];
+    for (int i = 0; i < 300; i++) players[i] = (TypedPlayer){i, (i * 37) % 101};
+    TypedPlayerSort_sort(players, 300);
+    bool descending = true;
+    for (int i = 1; i < 300; i++) descending &= players[i - 1].skill >= players[i].skill;
+    TEST_ASSERT(descending && players[0].skill == 100, "Struct sort orders by field");
+    for (int i = 0; i < 300; i++) players[i] = (TypedPlayer){i, (i * 37) % 7};
+    TypedPlayerSort_merge_sort(players, 300);
+    bool stable = true;
+    for (int i = 1; i < 300; i++) {
+        stable &= players[i - 1].skill > players[i].skill ||
+                  (players[i - 1].skill == players[i].skill && players[i - 1].id < players[i].id);
+    }
+    TEST_ASSERT(stable, "Merge sort keeps equal elements in order");
+    
+    // Untyped DynArray through a comparator
+    int values[1000];
+    DynArray arr;
+    dynarray_init(&arr, 0);
+    for (int i = 0; i < 1000; i++) {
+        values[i] = (i * 7919) % 1000 - 500;
+        dynarray_push(&arr, &values[i]);
+    }
+    dynarray_sort(&arr, sort_compare_int_elements);
+    bool ordered = true;
+    for (size_t i = 0; i < arr.size; i++) ordered &= *(int*)arr.data[i] == (int)i - 500;
+    TEST_ASSERT(ordered, "dynarray_sort orders elements, not slot addresses");
+    for (int i = 0; i < 1000; i++) arr.data[i] = &values[999 - i];
+    dynarray_sort_stable(&arr, sort_compare_int_elements);
+    ordered = true;
+    for (size_t i = 0; i < arr.size; i++) ordered &= *(int*)arr.data[i] == (int)i - 500;
+    TEST_ASSERT(ordered, "dynarray_sort_stable orders elements");
+    
+    // Radix sort by key: stable, so equal skills keep insertion order
+    TypedPlayer keyed[2000];
+    dynarray_clear(&arr);
+    for (int i = 0; i < 2000; i++) {
+        keyed[i] = (TypedPlayer){i, (i * 13) % 50 - 25};
+        dynarray_push(&arr, &keyed[i]);
+    }
+    dynarray_sort_by_key(&arr, sort_key_typed_player, NULL);
+    stable = true;
+    for (size_t i = 1; i < arr.size; i++) {
+        const TypedPlayer *prev = arr.data[i - 1], *cur = arr.data[i];
+        stable &= prev->skill < cur->skill || (prev->skill == cur->skill && prev->id < cur->id);
+    }
+    TEST_ASSERT(stable && ((TypedPlayer*)arr.data[0])->skill == -25, "Radix sort is ordered and stable");
+    dynarray_clear(&arr);
+    for (int i = 0; i < 10; i++) dynarray_push(&arr, &keyed[9 - i]);
+    dynarray_sort_by_key(&arr, sort_key_typed_player, NULL);
+    stable = true;
+    for (size_t i = 1; i < arr.size; i++) {
+        stable &= ((TypedPlayer*)arr.data[i - 1])->skill <= ((TypedPlayer*)arr.data[i])->skill;
+    }
+    TEST_ASSERT(stable, "Short inputs take the insertion path");
+    
+    float floats[] = {3.5f, -0.0f, -2.25f, 0.0f, 1e-30f, -1e30f, 7.0f};
+    bool monotone = true;
+    for (int i = 0; i < 7; i++) {
+        for (int j = 0; j < 7; j++) {
+            if (floats[i] < floats[j]) monotone &= sort_key_from_float(floats[i]) < sort_key_from_float(floats[j]);
+        }
+    }
+    TEST_ASSERT(monotone && sort_key_from_float(-0.0f) < sort_key_from_float(0.0f),
+                "Float keys keep numeric order");
+    TEST_ASSERT(sort_key_from_int(INT32_MIN) == 0 && sort_key_from_int(-1) < sort_key_from_int(0) &&
+                sort_key_from_int(INT32_MAX) == UINT32_MAX, "Int keys keep numeric order");
+    dynarray_free(&arr);
+    
+    // Parallel merge sort: more chunks than threads, uneven chunk sizes, heavy duplicates
+    size_t big = SORT_PARALLEL_THRESHOLD * 2 + 13;
+    IntArray par, seq;
+    IntArray_init(&par, big);
+    IntArray_init(&seq, big);
+    for (size_t i = 0; i < big; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int value = (int)((seed >> 8) % 1000);
+        IntArray_push(&par, value);
+        IntArray_push(&seq, value);
+    }
+    ThreadPool pool;
+    thread_pool_init(&pool, 3);
+    IntArray_parallel_sort(&par, &pool);
+    IntArray_stable_sort(&seq);
+    TEST_ASSERT(memcmp(par.data, seq.data, big * sizeof(int)) == 0, "Parallel merge sort matches introsort");
+    IntArray_parallel_sort(&par, &pool);
+    TEST_ASSERT(memcmp(par.data, seq.data, big * sizeof(int)) == 0, "Parallel sort of sorted input is a no-op");
+    IntArray_parallel_sort(&par, NULL);
+    TEST_ASSERT(memcmp(par.data, seq.data, big * sizeof(int)) == 0, "NULL pool falls back to introsort");
+    
+    DynArray boxed;
+    dynarray_init(&boxed, big);
+    for (size_t i = 0; i < big; i++) dynarray_push(&boxed, &seq.data[big - 1 - i]);
+    dynarray_sort_parallel(&boxed, sort_compare_int_elements, &pool);
+    ordered = true;
+    for (size_t i = 0; i < big; i++) ordered &= *(int*)boxed.data[i] == seq.data[i];
+    TEST_ASSERT(ordered, "dynarray_sort_parallel orders boxed elements");
+    
+    static TypedPlayer many[SORT_PARALLEL_THRESHOLD + 999];
+    size_t many_n = sizeof(many) / sizeof(many[0]);
+    for (size_t i = 0; i < many_n; i++) many[i] = (TypedPlayer){(int)i, (int)((i * 2654435761u) % 97)};
+    TypedPlayerSort_parallel_sort(many, many_n, &pool);
+    stable = true;
+    for (size_t i = 1; i < many_n; i++) {
+        stable &= many[i - 1].skill > many[i].skill ||
+                  (many[i - 1].skill == many[i].skill && many[i - 1].id < many[i].id);
+    }
+    TEST_ASSERT(stable, "Parallel merge sort is stable across chunk boundaries");
+    thread_pool_free(&pool);
+    dynarray_free(&boxed);
+    IntArray_free(&par);
+    IntArray_free(&seq);
+}
+
+// Test Pool/Arena allocators and containers built on them
+void test_allocators() {
+    TEST_START("ALLOCATORS");
+    
+    // Pool recycles freed objects before carving new ones
+    Pool pool;
+    pool_init(&pool, 24, 4);
+    void *a = pool_alloc(&pool);
+    void *b = pool_alloc(&pool);
+    TEST_ASSERT(a && b && a != b, "Pool hands out distinct objects");
+    TEST_ASSERT(((uintptr_t)a % POOL_ALIGNMENT) == 0, "Pool objects are aligned");
+    pool_free(&pool, a);
+    TEST_ASSERT(pool_alloc(&pool) == a, "Freed object is reused first");
+    for (int i = 0; i < 10; i++) pool_alloc(&pool);
+    TEST_ASSERT(pool_live_count(&pool) == 12, "Pool grows across blocks");
+    TEST_ASSERT(allocator_alloc(pool_allocator(&pool), 64) == NULL, "Oversized request rejected");
+    pool_reset(&pool);
+    TEST_ASSERT(pool_live_count(&pool) == 0, "Reset releases every object");
+    
+    // Arena bumps, aligns and rewinds
+    Arena arena;
+    arena_init(&arena, 256);
+    char *c1 = arena_alloc(&arena, 3);
+    char *c2 = arena_alloc(&arena, 5);
+    TEST_ASSERT(c2 - c1 == ARENA_ALIGNMENT, "Arena allocations are contiguous and aligned");
+    void *big = arena_alloc(&arena, 1000);
+    TEST_ASSERT(big != NULL, "Oversized request gets its own chunk");
+    arena_reset(&arena);
+    TEST_ASSERT(arena_used(&arena) == 0, "Arena reset rewinds");
+    arena_destroy(&arena);
+    
+    // Tree nodes from a pool, torn down by destroying the pool
+    pool_init(&pool, sizeof(TreeNode), 64);
+    AVLTree tree;
+    avl_init_with_allocator(&tree, pool_allocator(&pool));
+    for (int i = 0; i < 100; i++) avl_insert(&tree, i);
+    TEST_ASSERT(pool_live_count(&pool) == 100, "AVL nodes come from pool");
+    avl_delete(&tree, 50);
+    TEST_ASSERT(pool_live_count(&pool) == 99, "Deleted node returned to pool");
+    TEST_ASSERT(avl_is_valid(&tree) && !avl_search(&tree, 50), "Pooled AVL stays valid");
+    avl_free(&tree);
+    pool_destroy(&pool);
+    
+    // Doubly linked list nodes from a pool
+    pool_init(&pool, sizeof(DoublyListNode), 0);
+    DoublyLinkedList list;
+    doubly_init_with_allocator(&list, pool_allocator(&pool));
+    int vals[50];
+    for (int i = 0; i < 50; i++) {
+        vals[i] = i;
+        doubly_push_back(&list, &vals[i]);
+    }
+    doubly_pop_front(&list);
+    TEST_ASSERT(pool_live_count(&pool) == 49, "List nodes recycled through pool");
+    TEST_ASSERT(*(int*)doubly_get_at(&list, 0) == 1, "Pooled list keeps order");
+    doubly_free(&list);
+    pool_destroy(&pool);
+    
+    // Hash entries from a pool
+    pool_init(&pool, sizeof(HashEntry), 0);
+    HashTable table;
+    hashtable_init_with_allocator(&table, 8, &INT_HASH_FUNC, pool_allocator(&pool));
+    for (int i = 0; i < 200; i++) hashtable_put(&table, &i, &vals[i % 50]);
+    hashtable_remove(&table, &vals[3]);
+    TEST_ASSERT(pool_live_count(&pool) == 199, "Hash entries come from pool");
+    int key = 150;
+    TEST_ASSERT(hashtable_get(&table, &key) == &vals[0], "Pooled table lookups work");
+    hashtable_free(&table);
+    pool_destroy(&pool);
+    
+    // Graph vertices/edges from an arena, torn down without per-node frees
+    arena_init(&arena, 0);
+    G graph;
+    graph_init_with_allocator(&graph, arena_allocator(&arena));
+    V *prev = graph_new_vertex(&graph, 0);
+    for (int i = 1; i < 20; i++) {
+        V *next = graph_new_vertex(&graph, i);
+        graph_new_edge(&graph, prev, next, i);
+        prev = next;
+    }
+    TEST_ASSERT(dynarray_size(&graph.Vertices) == 20 && dynarray_size(&graph.Edges) == 19, "Graph built from arena");
+    TEST_ASSERT(arena_used(&arena) >= 20 * sizeof(V) + 19 * sizeof(E), "Arena holds vertices and edges");
+    graph_destroy(&graph);
+    arena_destroy(&arena);
+    
+    printf("Allocator tests completed\n");
+}
+
+// Visitor collecting range results into an int buffer
+typedef struct {
+    int keys[64];
+    int count;
+    int limit; // Stop after this many (0 = no limit)
+} AVLCollect;
+
+static bool avl_collect_visit(const void *key, void *value, void *ctx) {
+    (void)value;
+    AVLCollect *c = (AVLCollect *)ctx;
+    c->keys[c->count++] = *(const int *)key;
+    return c->limit == 0 || c->count < c->limit;
+}
+
+void test_avl_order_statistics() {
+    TEST_START("ORDER-STATISTIC AVL");
+    
+    // Keys 0..199 with duplicates: key = i / 2, each pair has its own value slot
+    int keys[200];
+    int slots[200];
+    AVLOrderTree tree;
+    avl_order_init(&tree, avl_compare_int);
+    int inserted = 0;
+    for (int i = 0; i < 200; i++) {
+        keys[i] = (i * 37) % 200 / 2;
+        inserted += avl_order_insert(&tree, &keys[i], &slots[i]);
+    }
+    TEST_ASSERT(inserted == 200, "Every distinct pair inserted");
+    TEST_ASSERT(!avl_order_insert(&tree, &keys[5], &slots[5]), "Exact pair is not inserted twice");
+    TEST_ASSERT(avl_order_size(&tree) == 200, "Size counts duplicate keys");
+    TEST_ASSERT(avl_order_is_valid(&tree), "Heights, sizes and order valid after inserts");
+    
+    int probe = 10;
+    TEST_ASSERT(avl_rank(&tree, &probe) == 20, "Rank counts keys strictly below");
+    const AVLOrderNode *node = avl_select(&tree, 21);
+    TEST_ASSERT(node && *(const int *)node->key == 10, "Select returns key at sorted position");
+    TEST_ASSERT(avl_select(&tree, 200) == NULL, "Select past the end returns NULL");
+    
+    int lo = 30, hi = 33;
+    AVLCollect got = {{0}, 0, 0};
+    avl_range(&tree, &lo, &hi, avl_collect_visit, &got);
+    bool sorted = got.count == 8;
+    for (int i = 1; i < got.count; i++) sorted = sorted && got.keys[i - 1] <= got.keys[i];
+    TEST_ASSERT(sorted && got.keys[0] == 30 && got.keys[7] == 33, "Range reports every pair in order");
+    TEST_ASSERT(avl_count_range(&tree, &lo, &hi) == 8, "Count range without walking");
+    TEST_ASSERT(avl_count_range(&tree, &hi, &lo) == 0, "Inverted range is empty");
+    
+    AVLCollect top = {{0}, 0, 3};
+    avl_order_visit_desc(&tree, avl_collect_visit, &top);
+    TEST_ASSERT(top.count == 3 && top.keys[0] == 99 && top.keys[2] == 98, "Descending walk stops early");
+    
+    // Remove one of two equal keys, then every even slot
+    int dup_key = keys[0];
+    TEST_ASSERT(avl_order_remove(&tree, &keys[0], &slots[0]), "Remove exact pair");
+    TEST_ASSERT(avl_count_range(&tree, &dup_key, &dup_key) == 1, "Other pair with same key kept");
+    TEST_ASSERT(!avl_order_remove(&tree, &keys[0], &slots[0]), "Second remove fails");
+    for (int i = 2; i < 200; i += 2) avl_order_remove(&tree, &keys[i], &slots[i]);
+    TEST_ASSERT(avl_order_size(&tree) == 100 && avl_order_is_valid(&tree), "Tree valid after removals");
+    avl_order_free(&tree);
+    
+    // Float keys through a pool, as the basketball indexes use
+    Pool pool;
+    pool_init(&pool, sizeof(AVLOrderNode), 0);
+    AVLOrderTree heights;
+    avl_order_init_with_allocator(&heights, avl_compare_float, pool_allocator(&pool));
+    float h[5] = {2.01f, 1.88f, 2.11f, 1.96f, 2.11f};
+    for (int i = 0; i < 5; i++) avl_order_insert(&heights, &h[i], &slots[i]);
+    float min_h = 2.0f, max_h = 2.2f;
+    TEST_ASSERT(avl_count_range(&heights, &min_h, &max_h) == 3, "Float range count");
+    TEST_ASSERT(*(const float *)avl_select(&heights, 0)->key == 1.88f, "Float select minimum");
+    avl_order_free(&heights);
+    pool_destroy(&pool);
+    
+    // Bulk insert: balanced rebuild into an empty tree, then a merge with duplicates
+    const void *bulk_keys[200];
+    void *bulk_values[200];
+    for (int i = 0; i < 200; i++) {
+        bulk_keys[i] = &keys[i];
+        bulk_values[i] = &slots[i];
+    }
+    AVLOrderTree bulk;
+    avl_order_init(&bulk, avl_compare_int);
+    TEST_ASSERT(avl_order_insert_many(&bulk, bulk_keys, bulk_values, 120) == 120, "Bulk insert into empty tree");
+    TEST_ASSERT(avl_order_size(&bulk) == 120 && avl_order_is_valid(&bulk), "Bulk-built tree is balanced");
+    TEST_ASSERT(avl_order_insert_many(&bulk, bulk_keys + 100, bulk_values + 100, 100) == 80, "Bulk merge skips existing pairs");
+    TEST_ASSERT(avl_order_size(&bulk) == 200 && avl_order_is_valid(&bulk), "Bulk merge keeps invariants");
+    TEST_ASSERT(*(const int *)avl_select(&bulk, 0)->key == 0 && *(const int *)avl_select(&bulk, 199)->key == 99, "Bulk merge keeps order");
+    TEST_ASSERT(avl_order_insert_many(&bulk, bulk_keys + 7, bulk_values + 7, 1) == 0 && avl_order_is_valid(&bulk), "Small batch of duplicates ignored");
+    avl_order_free(&bulk);
+    
+    printf("Order-statistic AVL tests completed\n");
+}
+
+// Worker state for the concurrent queue tests
+#define CQ_TEST_PRODUCERS 4
+#define CQ_TEST_CONSUMERS 2
+#define CQ_TEST_ITEMS_PER_PRODUCER 20000
+
+typedef struct {
+    void *queue;
+    size_t first;            // First value (1-based, NULL is reserved)
+    size_t count;            // Values to produce
+    atomic_size_t *consumed; // Shared count of dequeued values
+    size_t total;            // Values expected across all producers
+    unsigned long long sum;  // Consumer: sum of dequeued values
+    bool ordered;            // SPSC consumer: values arrived in FIFO order
+    size_t refused;          // Batch producer: enqueues that returned 0 while slots were free
+} CQWorker;
+
+static void *spsc_producer(void *arg) {
+    CQWorker *w = (CQWorker *)arg;
+    for (size_t v = w->first; v < w->first + w->count; v++) {
+        while (!spsc_queue_try_enqueue((SPSCQueue *)w->queue, (void *)(uintptr_t)v)) {
+            concurrent_queue_cpu_relax();
+        }
+    }
+    return NULL;
+}
+
+static void *spsc_consumer(void *arg) {
+    CQWorker *w = (CQWorker *)arg;
+    void *batch[32];
+    size_t expected = w->first;
+    w->ordered = true;
+    while (expected < w->first + w->count) {
+        size_t n = spsc_queue_dequeue_batch((SPSCQueue *)w->queue, batch, 32);
+        for (size_t i = 0; i < n; i++) {
+            if ((uintptr_t)batch[i] != expected) w->ordered = false;
+            expected++;
+        }
+    }
+    return NULL;
+}
+
+static void *mpmc_producer(void *arg) {
+    CQWorker *w = (CQWorker *)arg;
+    size_t v = w->first;
+    size_t end = w->first + w->count;
+    while (v < end) {
+        if ((v & 1) == 0) {
+            // Alternate single and batch enqueues to exercise both paths
+            void *batch[8];
+            size_t n = end - v < 8 ? end - v : 8;
+            for (size_t i = 0; i < n; i++) batch[i] = (void *)(uintptr_t)(v + i);
+            v += mpmc_queue_enqueue_batch((MPMCQueue *)w->queue, batch, n);
+        } else if (mpmc_queue_try_enqueue((MPMCQueue *)w->queue, (void *)(uintptr_t)v)) {
+            v++;
+        }
+    }
+    return NULL;
+}
+
+// Batch-only producer on a queue sized to never fill: every 0 return is spurious
+static void *mpmc_batch_producer(void *arg) {
+    CQWorker *w = (CQWorker *)arg;
+    size_t v = w->first;
+    size_t end = w->first + w->count;
+    w->refused = 0;
+    while (v < end) {
+        void *batch[8];
+        size_t n = end - v < 8 ? end - v : 8;
+        for (size_t i = 0; i < n; i++) batch[i] = (void *)(uintptr_t)(v + i);
+        size_t added = mpmc_queue_enqueue_batch((MPMCQueue *)w->queue, batch, n);
+        if (added == 0) w->refused++;
+        v += added;
+    }
+    return NULL;
+}
+
+static void *mpmc_consumer(void *arg) {
+    CQWorker *w = (CQWorker *)arg;
+    void *batch[16];
+    w->sum = 0;
+    while (atomic_load(w->consumed) < w->total) {
+        size_t n = mpmc_queue_dequeue_batch((MPMCQueue *)w->queue, batch, 16);
+        if (n == 0) {
+            void *single = mpmc_queue_try_dequeue((MPMCQueue *)w->queue);
+            if (!single) {
+                concurrent_queue_cpu_relax();
+                continue;
+            }
+            batch[0] = single;
+            n = 1;
+        }
+        for (size_t i = 0; i < n; i++) w->sum += (uintptr_t)batch[i];
+        atomic_fetch_add(w->consumed, n);
+    }
+    return NULL;
+}
+
+void test_concurrent_queue() {
+    TEST_START("CONCURRENT QUEUE");
+    
+    // SPSC semantics on one thread
+    SPSCQueue spsc;
+    spsc_queue_init(&spsc, 5);
+    TEST_ASSERT(spsc_queue_capacity(&spsc) == 8, "SPSC capacity rounds up to power of two");
+    int vals[16];
+    for (int i = 0; i < 8; i++) spsc_queue_try_enqueue(&spsc, &vals[i]);
+    TEST_ASSERT(!spsc_queue_try_enqueue(&spsc, &vals[8]), "SPSC rejects enqueue when full");
+    TEST_ASSERT(spsc_queue_try_dequeue(&spsc) == &vals[0], "SPSC dequeues in FIFO order");
+    void *out[8];
+    TEST_ASSERT(spsc_queue_dequeue_batch(&spsc, out, 8) == 7 && out[6] == &vals[7], "SPSC batch dequeue drains the rest");
+    TEST_ASSERT(spsc_queue_try_dequeue(&spsc) == NULL, "SPSC empty returns NULL");
+    void *many[10];
+    for (int i = 0; i < 10; i++) many[i] = &vals[i];
+    TEST_ASSERT(spsc_queue_enqueue_batch(&spsc, many, 10) == 8, "SPSC batch enqueue stops at capacity");
+    TEST_ASSERT(spsc_queue_size(&spsc) == 8, "SPSC size after wrap-around");
+    spsc_queue_free(&spsc);
+    
+    // MPMC semantics on one thread
+    MPMCQueue mpmc;
+    mpmc_queue_init(&mpmc, 4);
+    TEST_ASSERT(mpmc_queue_is_empty(&mpmc) && mpmc_queue_try_dequeue(&mpmc) == NULL, "MPMC starts empty");
+    TEST_ASSERT(mpmc_queue_enqueue_batch(&mpmc, many, 3) == 3, "MPMC batch enqueue");
+    TEST_ASSERT(mpmc_queue_try_enqueue(&mpmc, &vals[3]), "MPMC single enqueue fills last slot");
+    TEST_ASSERT(!mpmc_queue_try_enqueue(&mpmc, &vals[4]), "MPMC rejects enqueue when full");
+    TEST_ASSERT(mpmc_queue_enqueue_batch(&mpmc, many, 2) == 0, "MPMC batch enqueue on full queue");
+    TEST_ASSERT(mpmc_queue_try_dequeue(&mpmc) == &vals[0], "MPMC dequeues in FIFO order");
+    TEST_ASSERT(mpmc_queue_dequeue_batch(&mpmc, out, 8) == 3 && out[2] == &vals[3], "MPMC batch dequeue drains the rest");
+    for (int lap = 0; lap < 5; lap++) {
+        mpmc_queue_try_enqueue(&mpmc, &vals[lap]);
+        mpmc_queue_try_enqueue(&mpmc, &vals[lap + 1]);
+        mpmc_queue_try_dequeue(&mpmc);
+        mpmc_queue_try_dequeue(&mpmc);
+    }
+    TEST_ASSERT(mpmc_queue_size(&mpmc) == 0, "MPMC sequence numbers survive several laps");
+    mpmc_queue_free(&mpmc);
+    
+    // SPSC across two threads keeps FIFO order
+    spsc_queue_init(&spsc, 64);
+    CQWorker sp = {&spsc, 1, CQ_TEST_ITEMS_PER_PRODUCER, NULL, 0, 0, false, 0};
+    CQWorker sc = sp;
+    pthread_t producer, consumer;
+    pthread_create(&consumer, NULL, spsc_consumer, &sc);
+    pthread_create(&producer, NULL, spsc_producer, &sp);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+    TEST_ASSERT(sc.ordered, "SPSC cross-thread hand-off preserves order");
+    spsc_queue_free(&spsc);
+    
+    // MPMC with several producers and consumers loses and duplicates nothing
+    mpmc_queue_init(&mpmc, 128);
+    atomic_size_t consumed;
+    atomic_init(&consumed, 0);
+    size_t total = (size_t)CQ_TEST_PRODUCERS * CQ_TEST_ITEMS_PER_PRODUCER;
+    CQWorker producers[CQ_TEST_PRODUCERS], consumers[CQ_TEST_CONSUMERS];
+    pthread_t ptids[CQ_TEST_PRODUCERS], ctids[CQ_TEST_CONSUMERS];
+    for (int i = 0; i < CQ_TEST_CONSUMERS; i++) {
+        consumers[i] = (CQWorker){&mpmc, 0, 0, &consumed, total, 0, false, 0};
+        pthread_create(&ctids[i], NULL, mpmc_consumer, &consumers[i]);
+    }
+    for (int i = 0; i < CQ_TEST_PRODUCERS; i++) {
+        producers[i] = (CQWorker){&mpmc, 1 + (size_t)i * CQ_TEST_ITEMS_PER_PRODUCER,
+                                  CQ_TEST_ITEMS_PER_PRODUCER, &consumed, total, 0, false, 0};
+        pthread_create(&ptids[i], NULL, mpmc_producer, &producers[i]);
+    }
+    for (int i = 0; i < CQ_TEST_PRODUCERS; i++) pthread_join(ptids[i], NULL);
+    for (int i = 0; i < CQ_TEST_CONSUMERS; i++) pthread_join(ctids[i], NULL);
+    unsigned long long sum = 0;
+    for (int i = 0; i < CQ_TEST_CONSUMERS; i++) sum += consumers[i].sum;
+    TEST_ASSERT(atomic_load(&consumed) == total, "MPMC consumers received every element");
+    TEST_ASSERT(sum == (unsigned long long)total * (total + 1) / 2, "MPMC elements delivered exactly once");
+    TEST_ASSERT(mpmc_queue_is_empty(&mpmc), "MPMC empty after drain");
+    mpmc_queue_free(&mpmc);
+    
+    // Batch producers racing batch consumers never see a non-full queue as full
+    mpmc_queue_init(&mpmc, total);
+    atomic_store(&consumed, 0);
+    for (int i = 0; i < CQ_TEST_CONSUMERS; i++) {
+        consumers[i] = (CQWorker){&mpmc, 0, 0, &consumed, total, 0, false, 0};
+        pthread_create(&ctids[i], NULL, mpmc_consumer, &consumers[i]);
+    }
+    for (int i = 0; i < CQ_TEST_PRODUCERS; i++) {
+        producers[i] = (CQWorker){&mpmc, 1 + (size_t)i * CQ_TEST_ITEMS_PER_PRODUCER,
+                                  CQ_TEST_ITEMS_PER_PRODUCER, &consumed, total, 0, false, 0};
+        pthread_create(&ptids[i], NULL, mpmc_batch_producer, &producers[i]);
+    }
+    for (int i = 0; i < CQ_TEST_PRODUCERS; i++) pthread_join(ptids[i], NULL);
+    for (int i = 0; i < CQ_TEST_CONSUMERS; i++) pthread_join(ctids[i], NULL);
+    size_t refused = 0;
+    sum = 0;
+    for (int i = 0; i < CQ_TEST_PRODUCERS; i++) refused += producers[i].refused;
+    for (int i = 0; i < CQ_TEST_CONSUMERS; i++) sum += consumers[i].sum;
+    TEST_ASSERT(refused == 0, "MPMC batch enqueue only fails on a full queue");
+    TEST_ASSERT(sum == (unsigned long long)total * (total + 1) / 2, "MPMC batch race delivers every element once");
+    mpmc_queue_free(&mpmc);
+    
+    printf("Concurrent queue tests completed\n");
+}
+
+// Worker state for the concurrent hash table tests
+typedef struct {
+    ConcurrentHashTable *table;
+    int first_key;       // Writers: first key of a private range
+    int key_count;       // Keys touched
+    int *values;         // Stable values readers must observe
+    bool ok;             // Readers: every stable lookup matched
+} CHTWorker;
+
+static void *cht_writer(void *arg) {
+    CHTWorker *w = (CHTWorker *)arg;
+    for (int round = 0; round < 3; round++) {
+        for (int k = w->first_key; k < w->first_key + w->key_count; k++) {
+            concurrent_hashtable_put(w->table, &k, w->values);
+        }
+        for (int k = w->first_key; k < w->first_key + w->key_count; k += 2) {
+            concurrent_hashtable_remove(w->table, &k);
+        }
+    }
+    return NULL;
+}
+
+static void *cht_reader(void *arg) {
+    CHTWorker *w = (CHTWorker *)arg;
+    w->ok = true;
+    for (int pass = 0; pass < 20; pass++) {
+        for (int k = 0; k < w->key_count; k++) {
+            if (concurrent_hashtable_get(w->table, &k) != &w->values[k]) w->ok = false;
+        }
+    }
+    return NULL;
+}
+
+void test_concurrent_hashtable() {
+    TEST_START("CONCURRENT HASH TABLE");
+    
+    ConcurrentHashTableMode modes[] = {CONCURRENT_HASHTABLE_RWLOCK, CONCURRENT_HASHTABLE_SEQLOCK};
+    int values[512];
+    char name[32];
+    
+    for (int m = 0; m < 2; m++) {
+        ConcurrentHashTable table;
+        concurrent_hashtable_init(&table, 6, 4, &STRING_HASH_FUNC, modes[m]);
+        TEST_ASSERT(table.shard_count == 8, "Shard count rounds up to power of two");
+        for (int i = 0; i < 500; i++) {
+            sprintf(name, "player_%d", i);
+            concurrent_hashtable_put(&table, name, &values[i]);
+        }
+        TEST_ASSERT(concurrent_hashtable_size(&table) == 500, "Size counts every shard");
+        bool all_found = true;
+        for (int i = 0; i < 500; i++) {
+            sprintf(name, "player_%d", i);
+            if (concurrent_hashtable_get(&table, name) != &values[i]) all_found = false;
+        }
+        TEST_ASSERT(all_found, "All keys found across shards after growth");
+        concurrent_hashtable_put(&table, "player_7", &values[0]);
+        TEST_ASSERT(concurrent_hashtable_get(&table, "player_7") == &values[0], "Put updates existing key");
+        TEST_ASSERT(concurrent_hashtable_remove(&table, "player_7"), "Remove existing key");
+        TEST_ASSERT(!concurrent_hashtable_remove(&table, "player_7"), "Second remove fails");
+        TEST_ASSERT(!concurrent_hashtable_contains(&table, "player_7"), "Removed key is gone");
+        size_t busiest = 0;
+        for (size_t s = 0; s < table.shard_count; s++) {
+            if (table.shards[s].table.size > busiest) busiest = table.shards[s].table.size;
+        }
+        TEST_ASSERT(busiest < 120, "Keys spread over shards");
+        size_t expected_reclaimed = modes[m] == CONCURRENT_HASHTABLE_SEQLOCK ? 1 : 0;
+        TEST_ASSERT(concurrent_hashtable_reclaim(&table) == expected_reclaimed, "Only seqlock mode retires entries");
+        concurrent_hashtable_free(&table);
+    }
+    
+    // Integer keys from small ids still spread (shard uses mixed high bits)
+    ConcurrentHashTable ints;
+    concurrent_hashtable_init(&ints, 16, 16, &INT_HASH_FUNC, CONCURRENT_HASHTABLE_RWLOCK);
+    for (int i = 1; i <= 256; i++) concurrent_hashtable_put(&ints, &i, &values[i]);
+    size_t used_shards = 0;
+    for (size_t s = 0; s < ints.shard_count; s++) used_shards += ints.shards[s].table.size > 0;
+    TEST_ASSERT(used_shards == ints.shard_count, "Sequential int keys reach every shard");
+    concurrent_hashtable_free(&ints);
+    
+    // Lock-free readers see stable keys while writers churn other keys
+    for (int m = 0; m < 2; m++) {
+        ConcurrentHashTable table;
+        concurrent_hashtable_init(&table, 4, 8, &INT_HASH_FUNC, modes[m]);
+        for (int k = 0; k < 256; k++) concurrent_hashtable_put(&table, &k, &values[k]);
+        CHTWorker writers[2], readers[2];
+        pthread_t wt[2], rt[2];
+        for (int i = 0; i < 2; i++) {
+            writers[i] = (CHTWorker){&table, 1000 + i * 2000, 2000, values, true};
+            readers[i] = (CHTWorker){&table, 0, 256, values, true};
+            pthread_create(&wt[i], NULL, cht_writer, &writers[i]);
+            pthread_create(&rt[i], NULL, cht_reader, &readers[i]);
+        }
+        for (int i = 0; i < 2; i++) {
+            pthread_join(wt[i], NULL);
+            pthread_join(rt[i], NULL);
+        }
+        TEST_ASSERT(readers[0].ok && readers[1].ok, "Readers never miss a stable key during writes");
+        TEST_ASSERT(concurrent_hashtable_size(&table) == 256 + 2 * 1000, "Concurrent writers leave exact size");
+        concurrent_hashtable_free(&table);
+    }
+    
+    printf("Concurrent hash table tests completed\n");
+}
+
 void test_circular_linked_list() {
     TEST_START("CIRCULAR LINKED LIST");
     
@@ -505,6 +3042,18 @@ void benchmark_performance() {
            ((double)(end - start) / CLOCKS_PER_SEC) * 1000);
     dynarray_free(&arr);
     
+    // Benchmark Typed Dynamic Array (values stored inline)
+    start = clock();
+    IntArray typed_arr;
+    IntArray_init(&typed_arr, 1);
+    for (int i = 0; i < N; i++) {
+        IntArray_push(&typed_arr, i);
+    }
+    end = clock();
+    printf("Typed Array %d pushes: %.2fms\n", N, 
+           ((double)(end - start) / CLOCKS_PER_SEC) * 1000);
+    IntArray_free(&typed_arr);
+    
     // Benchmark Stack
     start = clock();
     Stack stack;
@@ -529,6 +3078,18 @@ void benchmark_performance() {
            ((double)(end - start) / CLOCKS_PER_SEC) * 1000);
     hashtable_free(&table);
     
+    // Benchmark Typed Hash Map (no per-entry allocation)
+    start = clock();
+    IntIntMap typed_map;
+    IntIntMap_init(&typed_map, 0);
+    for (int i = 0; i < N; i++) {
+        IntIntMap_put(&typed_map, i, i);
+    }
+    end = clock();
+    printf("Typed Hash Map %d insertions: %.2fms\n", N, 
+           ((double)(end - start) / CLOCKS_PER_SEC) * 1000);
+    IntIntMap_free(&typed_map);
+    
     printf("Performance benchmark completed\n");
 }
 
@@ -585,8 +3146,34 @@ int main() {
     test_deque();
     test_min_heap();
     test_max_heap();
+    test_heap_top_k();
+    test_dary_heap();
+    test_indexed_heap();
     test_hashtable();
+    test_hashtable_incremental();
+    test_flat_hashtable();
+    test_fast_hash();
     test_hashset();
+    test_string_interner();
+    test_typed_containers();
+    test_sorting();
+    test_allocators();
+    test_avl_order_statistics();
+    test_concurrent_queue();
+    test_concurrent_hashtable();
+    test_unionfind();
+    test_csr_graph();
+    test_parallel_graph();
+    test_column_filter();
+    test_polynomial();
+    test_lis();
+    test_segtree();
+    test_trie();
+    test_static_tree();
+    test_btree();
+    test_filters();
+    test_bitsets();
+    test_stats();
     test_memory_safety();
     benchmark_performance();
     
@@ -0,0 +1,415 @@
+#ifndef CONCURRENT_QUEUE_H
+#define CONCURRENT_QUEUE_H
+
+#include <stdatomic.h>
+#include <stdalign.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * BOUNDED LOCK-FREE QUEUES (C11 ATOMICS)
+ *
+ * Two fixed-capacity FIFO rings of element pointers for cross-thread hand-off:
+ *
+ * - SPSCQueue: exactly one producer thread and one consumer thread. Wait-free;
+ *   each side keeps a cached copy of the other side's index so the shared
+ *   cache line is only touched when the cached view says full/empty.
+ * - MPMCQueue: any number of producers and consumers (Dmitry Vyukov's bounded
+ *   MPMC design). Every cell carries a sequence number; a thread claims a slot
+ *   with one CAS on the shared position and publishes it with a release store.
+ *
+ * Producer and consumer indices live on separate cache lines to avoid false
+ * sharing. NULL cannot be stored (it signals empty on dequeue). Capacity is
+ * rounded up to a power of two. Only init/free are not thread-safe.
+ *
+ * Batch operations claim a whole range with a single atomic update and then
+ * copy, which amortizes the contended CAS; an MPMC batch may briefly spin on
+ * a peer that has claimed a slot in its range but not yet published it.
+ *
+ * Time Complexities:
+ * - Enqueue / Dequeue: O(1) (MPMC: O(1) expected, CAS retry under contention)
+ * - Batch of k: O(k)
+ *
+ * Space Complexity: O(capacity)
+ */
+
+// Configuration constants
+#define CONCURRENT_QUEUE_CACHE_LINE 64
+#define CONCURRENT_QUEUE_MIN_CAPACITY 2
+
+/**
+ * Hint to the CPU that we are spinning (internal helper)
+ */
+static inline void concurrent_queue_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * Round capacity up to a power of two (internal helper)
+ * @param capacity: Requested capacity
+ * @return: Power-of-two capacity >= CONCURRENT_QUEUE_MIN_CAPACITY
+ */
+static inline size_t concurrent_queue_round_capacity(size_t capacity) {
+    size_t cap = CONCURRENT_QUEUE_MIN_CAPACITY;
+    while (cap < capacity) cap <<= 1;
+    return cap;
+}
+
+// ==================== SPSC QUEUE ====================
+
+// Single-producer single-consumer ring
+typedef struct SPSCQueue {
+    alignas(CONCURRENT_QUEUE_CACHE_LINE) atomic_size_t head; // Next slot to read (consumer writes)
+    size_t cached_tail;                                       // Consumer's view of tail
+    alignas(CONCURRENT_QUEUE_CACHE_LINE) atomic_size_t tail; // Next slot to write (producer writes)
+    size_t cached_head;                                       // Producer's view of head
+    alignas(CONCURRENT_QUEUE_CACHE_LINE) void **buffer;      // Ring of element pointers
+    size_t mask;                                              // capacity - 1
+} SPSCQueue;
+
+/**
+ * Initialize SPSC queue
+ * @param queue: Queue to initialize
+ * @param capacity: Maximum elements (rounded up to a power of two)
+ */
+static inline void spsc_queue_init(SPSCQueue *queue, size_t capacity) {
+    capacity = concurrent_queue_round_capacity(capacity);
+    queue->buffer = (void **)calloc(capacity, sizeof(void *));
+    if (!queue->buffer) {
+        fprintf(stderr, "spsc_queue_init: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    queue->mask = capacity - 1;
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    queue->cached_head = 0;
+    queue->cached_tail = 0;
+}
+
+/**
+ * Enqueue one element (producer thread only)
+ * @param queue: Target queue
+ * @param data: Non-NULL element
+ * @return: false if full
+ */
+static inline bool spsc_queue_try_enqueue(SPSCQueue *queue, void *data) {
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    if (tail - queue->cached_head > queue->mask) {
+        queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);
+        if (tail - queue->cached_head > queue->mask) return false;
+    }
+    queue->buffer[tail & queue->mask] = data;
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * Dequeue one element (consumer thread only)
+ * @param queue: Target queue
+ * @return: Front element, NULL if empty
+ */
+static inline void *spsc_queue_try_dequeue(SPSCQueue *queue) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    if (head == queue->cached_tail) {
+        queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        if (head == queue->cached_tail) return NULL;
+    }
+    void *data = queue->buffer[head & queue->mask];
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return data;
+}
+
+/**
+ * Enqueue up to count elements with one publish (producer thread only)
+ * @param queue: Target queue
+ * @param items: Non-NULL elements
+ * @param count: Number of elements
+ * @return: Number enqueued (prefix of items)
+ */
+static inline size_t spsc_queue_enqueue_batch(SPSCQueue *queue, void *const *items, size_t count) {
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    size_t capacity = queue->mask + 1;
+    if (capacity - (tail - queue->cached_head) < count) {
+        queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    }
+    size_t free_slots = capacity - (tail - queue->cached_head);
+    if (count > free_slots) count = free_slots;
+
+    for (size_t i = 0; i < count; i++) {
+        queue->buffer[(tail + i) & queue->mask] = items[i];
+    }
+    atomic_store_explicit(&queue->tail, tail + count, memory_order_release);
+    return count;
+}
+
+/**
+ * Dequeue up to max elements with one publish (consumer thread only)
+ * @param queue: Target queue
+ * @param out: Destination array
+ * @param max: Capacity of out
+ * @return: Number dequeued
+ */
+static inline size_t spsc_queue_dequeue_batch(SPSCQueue *queue, void **out, size_t max) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    if (queue->cached_tail - head < max) {
+        queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    }
+    size_t available = queue->cached_tail - head;
+    if (max > available) max = available;
+
+    for (size_t i = 0; i < max; i++) {
+        out[i] = queue->buffer[(head + i) & queue->mask];
+    }
+    atomic_store_explicit(&queue->head, head + max, memory_order_release);
+    return max;
+}
+
+/**
+ * Get approximate size (exact when no operation is in flight)
+ * @param queue: Target queue
+ * @return: Number of elements
+ */
+static inline size_t spsc_queue_size(SPSCQueue *queue) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    return tail - head;
+}
+
+/**
+ * Get capacity
+ * @param queue: Target queue
+ * @return: Maximum number of elements
+ */
+static inline size_t spsc_queue_capacity(const SPSCQueue *queue) {
+    return queue->mask + 1;
+}
+
+/**
+ * Free queue memory (no other thread may be using it)
+ * @param queue: Target queue
+ */
+static inline void spsc_queue_free(SPSCQueue *queue) {
+    free(queue->buffer);
+    queue->buffer = NULL;
+    queue->mask = 0;
+}
+
+// ==================== MPMC QUEUE ====================
+
+// Ring cell: sequence number says whose turn it is
+typedef struct MPMCCell {
+    atomic_size_t sequence; // == pos: free for producer, == pos + 1: full for consumer
+    void *data;             // Element pointer
+} MPMCCell;
+
+// Multi-producer multi-consumer ring
+typedef struct MPMCQueue {
+    alignas(CONCURRENT_QUEUE_CACHE_LINE) atomic_size_t enqueue_pos; // Next position to claim for writing
+    alignas(CONCURRENT_QUEUE_CACHE_LINE) atomic_size_t dequeue_pos; // Next position to claim for reading
+    alignas(CONCURRENT_QUEUE_CACHE_LINE) MPMCCell *cells;          // Ring of cells
+    size_t mask;                                                    // capacity - 1
+} MPMCQueue;
+
+/**
+ * Initialize MPMC queue
+ * @param queue: Queue to initialize
+ * @param capacity: Maximum elements (rounded up to a power of two)
+ */
+static inline void mpmc_queue_init(MPMCQueue *queue, size_t capacity) {
+    capacity = concurrent_queue_round_capacity(capacity);
+    queue->cells = (MPMCCell *)malloc(capacity * sizeof(MPMCCell));
+    if (!queue->cells) {
+        fprintf(stderr, "mpmc_queue_init: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&queue->cells[i].sequence, i);
+        queue->cells[i].data = NULL;
+    }
+    queue->mask = capacity - 1;
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+}
+
+/**
+ * Enqueue one element (any thread)
+ * @param queue: Target queue
+ * @param data: Non-NULL element
+ * @return: false if full
+ */
+static inline bool mpmc_queue_try_enqueue(MPMCQueue *queue, void *data) {
+    size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    MPMCCell *cell;
+
+    while (true) {
+        cell = &queue->cells[pos & queue->mask];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break; // Slot claimed
+            }
+            // pos reloaded by failed CAS
+        } else if (diff < 0) {
+            return false; // Cell still holds an unconsumed element from one lap ago
+        } else {
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    cell->data = data;
+    atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * Dequeue one element (any thread)
+ * @param queue: Target queue
+ * @return: Front element, NULL if empty
+ */
+static inline void *mpmc_queue_try_dequeue(MPMCQueue *queue) {
+    size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    MPMCCell *cell;
+
+    while (true) {
+        cell = &queue->cells[pos & queue->mask];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return NULL; // Not yet written
+        } else {
+            pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+        }
+    }
+
+    void *data = cell->data;
+    atomic_store_explicit(&cell->sequence, pos + queue->mask + 1, memory_order_release);
+    return data;
+}
+
+/**
+ * Enqueue up to count elements, claiming the range with one CAS (any thread)
+ * @param queue: Target queue
+ * @param items: Non-NULL elements
+ * @param count: Number of elements
+ * @return: Number enqueued (prefix of items)
+ */
+static inline size_t mpmc_queue_enqueue_batch(MPMCQueue *queue, void *const *items, size_t count) {
+    size_t capacity = queue->mask + 1;
+    size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    size_t claimed;
+
+    while (true) {
+        size_t head = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+        if (head > pos) {
+            // pos is stale: consumers moved past it, so pos - head would wrap
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+            continue;
+        }
+        size_t used = pos - head;
+        size_t free_slots = used < capacity ? capacity - used : 0;
+        claimed = count < free_slots ? count : free_slots;
+        if (claimed == 0) return 0;
+        if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + claimed,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < claimed; i++) {
+        MPMCCell *cell = &queue->cells[(pos + i) & queue->mask];
+        // A consumer that already claimed this cell may still be reading it
+        while (atomic_load_explicit(&cell->sequence, memory_order_acquire) != pos + i) {
+            concurrent_queue_cpu_relax();
+        }
+        cell->data = items[i];
+        atomic_store_explicit(&cell->sequence, pos + i + 1, memory_order_release);
+    }
+    return claimed;
+}
+
+/**
+ * Dequeue up to max elements, claiming the range with one CAS (any thread)
+ * @param queue: Target queue
+ * @param out: Destination array
+ * @param max: Capacity of out
+ * @return: Number dequeued
+ */
+static inline size_t mpmc_queue_dequeue_batch(MPMCQueue *queue, void **out, size_t max) {
+    size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    size_t claimed;
+
+    do {
+        size_t tail = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+        size_t available = tail > pos ? tail - pos : 0;
+        claimed = max < available ? max : available;
+        if (claimed == 0) return 0;
+    } while (!atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + claimed,
+                                                    memory_order_relaxed, memory_order_relaxed));
+
+    for (size_t i = 0; i < claimed; i++) {
+        MPMCCell *cell = &queue->cells[(pos + i) & queue->mask];
+        // A producer that already claimed this cell may still be writing it
+        while (atomic_load_explicit(&cell->sequence, memory_order_acquire) != pos + i + 1) {
+            concurrent_queue_cpu_relax();
+        }
+        out[i] = cell->data;
+        atomic_store_explicit(&cell->sequence, pos + i + queue->mask + 1, memory_order_release);
+    }
+    return claimed;
+}
+
+/**
+ * Get approximate size (exact when no operation is in flight)
+ * @param queue: Target queue
+ * @return: Number of elements
+ */
+static inline size_t mpmc_queue_size(MPMCQueue *queue) {
+    size_t head = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
+
+/**
+ * Check if empty (snapshot)
+ * @param queue: Target queue
+ * @return: true if no elements
+ */
+static inline bool mpmc_queue_is_empty(MPMCQueue *queue) {
+    return mpmc_queue_size(queue) == 0;
+}
+
+/**
+ * Get capacity
+ * @param queue: Target queue
+ * @return: Maximum number of elements
+ */
+static inline size_t mpmc_queue_capacity(const MPMCQueue *queue) {
+    return queue->mask + 1;
+}
+
+/**
+ * Free queue memory (no other thread may be using it)
+ * @param queue: Target queue
+ */
+static inline void mpmc_queue_free(MPMCQueue *queue) {
+    free(queue->cells);
+    queue->cells = NULL;
+    queue->mask = 0;
+}
+
+#endif // CONCURRENT_QUEUE_H
@@ -1,9 +1,10 @@
 #ifndef DEQUE_H
 #define DEQUE_H
 
-#include "../linkedlist/doubly_linked_list.h"
 #include "container_interface.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -12,13 +13,16 @@
  * DEQUE IMPLEMENTATION - DOUBLE-ENDED QUEUE
  *
  * Double-ended queue supporting efficient operations at both ends.
- * Built on doubly linked list for O(1) front and back operations.
+ * Built on a power-of-two ring buffer of element pointers: no allocation per
+ * element, contiguous storage and O(1) random access (index masked by capacity).
  *
  * Time Complexities:
- * - Push front/back: O(1)
+ * - Push front/back: O(1) amortized
  * - Pop front/back: O(1)
  * - Peek front/back: O(1)
- * - Random access: O(n/2) optimized
+ * - Random access: O(1)
+ * - Insert/remove at index: O(min(i, n - i))
+ * - Rotate by k: O(min(k, n - k)), O(1) when full
  *
  * Space Complexity: O(n)
  *
@@ -30,23 +34,116 @@
  * - Undo/Redo with both ends accessible
  */
 
+// Configuration constants
+#define DEQUE_DEFAULT_CAPACITY 8
+
 // Deque structure
 typedef struct Deque
 {
-    DoublyLinkedList list;        // Underlying storage
+    void **data;                  // Ring buffer of element pointers
+    size_t head;                  // Slot of front element
+    size_t size;                  // Element count
+    size_t capacity;              // Slot count (power of two, 0 after free)
     const DequeInterface *vtable; // Interface for polymorphism
 } Deque;
 
+// ==================== HELPER FUNCTIONS ====================
+
+/**
+ * Map logical index to buffer slot (internal helper)
+ * @param deque: Target deque
+ * @param index: Logical index (0 = front)
+ * @return: Slot in data
+ */
+static inline size_t deque_slot(const Deque *deque, size_t index)
+{
+    return (deque->head + index) & (deque->capacity - 1);
+}
+
+/**
+ * Resize buffer to new_capacity, unwrapping elements to slot 0 (internal helper)
+ * @param deque: Target deque
+ * @param new_capacity: New capacity (power of two, >= size)
+ */
+static inline void deque_resize(Deque *deque, size_t new_capacity)
+{
+    void **new_data = (void **)malloc(new_capacity * sizeof(void *));
+    if (!new_data)
+    {
+        fprintf(stderr, "deque_resize: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (deque->size > 0)
+    {
+        size_t first = deque->capacity - deque->head;
+        if (first > deque->size)
+            first = deque->size;
+        memcpy(new_data, deque->data + deque->head, first * sizeof(void *));
+        memcpy(new_data + first, deque->data, (deque->size - first) * sizeof(void *));
+    }
+
+    free(deque->data);
+    deque->data = new_data;
+    deque->head = 0;
+    deque->capacity = new_capacity;
+}
+
+/**
+ * Ensure room for one more element (internal helper)
+ * @param deque: Target deque
+ */
+static inline void deque_ensure_capacity(Deque *deque)
+{
+    if (deque->size == deque->capacity)
+    {
+        deque_resize(deque, deque->capacity ? deque->capacity * 2 : DEQUE_DEFAULT_CAPACITY);
+    }
+}
+
 // ==================== CORE OPERATIONS ====================
 
+/**
+ * Initialize empty deque with room for at least initial_capacity elements
+ * @param deque: Deque to initialize
+ * @param initial_capacity: Starting capacity (rounded up to a power of two)
+ */
+static inline void deque_init_with_capacity(Deque *deque, size_t initial_capacity)
+{
+    size_t capacity = DEQUE_DEFAULT_CAPACITY;
+    while (capacity < initial_capacity)
+        capacity <<= 1;
+
+    deque->data = NULL;
+    deque->head = 0;
+    deque->size = 0;
+    deque->capacity = 0;
+    deque->vtable = NULL;
+    deque_resize(deque, capacity);
+}
+
 /**
  * Initialize empty deque
  * @param deque: Deque to initialize
  */
 static inline void deque_init(Deque *deque)
 {
-    doubly_init(&deque->list);
-    deque->vtable = NULL;
+    deque_init_with_capacity(deque, DEQUE_DEFAULT_CAPACITY);
+}
+
+/**
+ * Reserve capacity for at least min_capacity elements
+ * @param deque: Target deque
+ * @param min_capacity: Minimum capacity needed
+ */
+static inline void deque_reserve(Deque *deque, size_t min_capacity)
+{
+    if (min_capacity <= deque->capacity)
+        return;
+    size_t capacity = deque->capacity ? deque->capacity : DEQUE_DEFAULT_CAPACITY;
+    while (capacity < min_capacity)
+        capacity <<= 1;
+    deque_resize(deque, capacity);
 }
 
 /**
@@ -56,7 +153,10 @@ static inline void deque_init(Deque *deque)
  */
 static inline void deque_push_front(Deque *deque, void *data)
 {
-    doubly_push_front(&deque->list, data);
+    deque_ensure_capacity(deque);
+    deque->head = (deque->head - 1) & (deque->capacity - 1);
+    deque->data[deque->head] = data;
+    deque->size++;
 }
 
 /**
@@ -66,7 +166,9 @@ static inline void deque_push_front(Deque *deque, void *data)
  */
 static inline void deque_push_back(Deque *deque, void *data)
 {
-    doubly_push_back(&deque->list, data);
+    deque_ensure_capacity(deque);
+    deque->data[deque_slot(deque, deque->size)] = data;
+    deque->size++;
 }
 
 /**
@@ -76,7 +178,13 @@ static inline void deque_push_back(Deque *deque, void *data)
  */
 static inline void *deque_pop_front(Deque *deque)
 {
-    return doubly_pop_front(&deque->list);
+    if (deque->size == 0)
+        return NULL;
+
+    void *data = deque->data[deque->head];
+    deque->head = (deque->head + 1) & (deque->capacity - 1);
+    deque->size--;
+    return data;
 }
 
 /**
@@ -86,7 +194,11 @@ static inline void *deque_pop_front(Deque *deque)
  */
 static inline void *deque_pop_back(Deque *deque)
 {
-    return doubly_pop_back(&deque->list);
+    if (deque->size == 0)
+        return NULL;
+
+    deque->size--;
+    return deque->data[deque_slot(deque, deque->size)];
 }
 
 /**
@@ -96,7 +208,7 @@ static inline void *deque_pop_back(Deque *deque)
  */
 static inline void *deque_peek_front(Deque *deque)
 {
-    return doubly_get_at(&deque->list, 0);
+    return deque->size > 0 ? deque->data[deque->head] : NULL;
 }
 
 /**
@@ -106,8 +218,7 @@ static inline void *deque_peek_front(Deque *deque)
  */
 static inline void *deque_peek_back(Deque *deque)
 {
-    size_t size = doubly_size(&deque->list);
-    return size > 0 ? doubly_get_at(&deque->list, size - 1) : NULL;
+    return deque->size > 0 ? deque->data[deque_slot(deque, deque->size - 1)] : NULL;
 }
 
 /**
@@ -117,7 +228,7 @@ static inline void *deque_peek_back(Deque *deque)
  */
 static inline size_t deque_size(Deque *deque)
 {
-    return doubly_size(&deque->list);
+    return deque->size;
 }
 
 /**
@@ -127,25 +238,30 @@ static inline size_t deque_size(Deque *deque)
  */
 static inline bool deque_is_empty(Deque *deque)
 {
-    return doubly_is_empty(&deque->list);
+    return deque->size == 0;
 }
 
 /**
- * Clear all elements
+ * Clear all elements (keeps capacity)
  * @param deque: Target deque
  */
 static inline void deque_clear(Deque *deque)
 {
-    doubly_clear(&deque->list);
+    deque->head = 0;
+    deque->size = 0;
 }
 
 /**
- * Free deque memory
+ * Free deque memory (deque stays usable, next push reallocates)
  * @param deque: Target deque
  */
 static inline void deque_free(Deque *deque)
 {
-    doubly_free(&deque->list);
+    free(deque->data);
+    deque->data = NULL;
+    deque->head = 0;
+    deque->size = 0;
+    deque->capacity = 0;
     deque->vtable = NULL;
 }
 
@@ -159,7 +275,7 @@ static inline void deque_free(Deque *deque)
  */
 static inline void *deque_get_at(Deque *deque, size_t index)
 {
-    return doubly_get_at(&deque->list, index);
+    return index < deque->size ? deque->data[deque_slot(deque, index)] : NULL;
 }
 
 /**
@@ -171,14 +287,14 @@ static inline void *deque_get_at(Deque *deque, size_t index)
  */
 static inline bool deque_set_at(Deque *deque, size_t index, void *data)
 {
-    if (index >= deque_size(deque))
+    if (index >= deque->size)
         return false;
-    doubly_set_at(&deque->list, index, data);
+    deque->data[deque_slot(deque, index)] = data;
     return true;
 }
 
 /**
- * Insert element at index
+ * Insert element at index, shifting whichever side is shorter
  * @param deque: Target deque
  * @param index: Insertion index
  * @param data: Data to insert
@@ -186,21 +302,62 @@ static inline bool deque_set_at(Deque *deque, size_t index, void *data)
  */
 static inline bool deque_insert_at(Deque *deque, size_t index, void *data)
 {
-    if (index > deque_size(deque))
+    if (index > deque->size)
         return false;
-    doubly_insert_at(&deque->list, index, data);
+
+    deque_ensure_capacity(deque);
+    if (index < deque->size / 2)
+    {
+        // Open a slot before the front and shift the first 'index' elements left
+        deque->head = (deque->head - 1) & (deque->capacity - 1);
+        deque->size++;
+        for (size_t i = 0; i < index; i++)
+        {
+            deque->data[deque_slot(deque, i)] = deque->data[deque_slot(deque, i + 1)];
+        }
+    }
+    else
+    {
+        // Shift the tail right by one
+        for (size_t i = deque->size; i > index; i--)
+        {
+            deque->data[deque_slot(deque, i)] = deque->data[deque_slot(deque, i - 1)];
+        }
+        deque->size++;
+    }
+    deque->data[deque_slot(deque, index)] = data;
     return true;
 }
 
 /**
- * Remove element at index
+ * Remove element at index, shifting whichever side is shorter
  * @param deque: Target deque
  * @param index: Index to remove
  * @return: Removed element, NULL if out of bounds
  */
 static inline void *deque_remove_at(Deque *deque, size_t index)
 {
-    return doubly_remove_at(&deque->list, index);
+    if (index >= deque->size)
+        return NULL;
+
+    void *data = deque->data[deque_slot(deque, index)];
+    if (index < deque->size / 2)
+    {
+        for (size_t i = index; i > 0; i--)
+        {
+            deque->data[deque_slot(deque, i)] = deque->data[deque_slot(deque, i - 1)];
+        }
+        deque->head = (deque->head + 1) & (deque->capacity - 1);
+    }
+    else
+    {
+        for (size_t i = index; i + 1 < deque->size; i++)
+        {
+            deque->data[deque_slot(deque, i)] = deque->data[deque_slot(deque, i + 1)];
+        }
+    }
+    deque->size--;
+    return data;
 }
 
 // ==================== SEARCH AND UTILITY OPERATIONS ====================
@@ -213,7 +370,12 @@ static inline void *deque_remove_at(Deque *deque, size_t index)
  */
 static inline bool deque_contains(Deque *deque, void *data)
 {
-    return doubly_contains(&deque->list, data);
+    for (size_t i = 0; i < deque->size; i++)
+    {
+        if (deque->data[deque_slot(deque, i)] == data)
+            return true;
+    }
+    return false;
 }
 
 /**
@@ -241,7 +403,17 @@ static inline size_t deque_find(Deque *deque, void *data)
  */
 static inline void deque_reverse(Deque *deque)
 {
-    doubly_reverse(&deque->list);
+    if (deque->size <= 1)
+        return;
+
+    for (size_t i = 0, j = deque->size - 1; i < j; i++, j--)
+    {
+        size_t a = deque_slot(deque, i);
+        size_t b = deque_slot(deque, j);
+        void *temp = deque->data[a];
+        deque->data[a] = deque->data[b];
+        deque->data[b] = temp;
+    }
 }
 
 // ==================== ROTATION OPERATIONS ====================
@@ -261,11 +433,29 @@ static inline void deque_rotate_left(Deque *deque, size_t steps)
     if (steps == 0)
         return;
 
-    // Move 'steps' elements from front to back
-    for (size_t i = 0; i < steps; i++)
+    // A full ring rotates by moving head only
+    if (size == deque->capacity)
+    {
+        deque->head = deque_slot(deque, steps);
+        return;
+    }
+
+    // Move whichever side is shorter
+    if (steps <= size / 2)
+    {
+        for (size_t i = 0; i < steps; i++)
+        {
+            void *data = deque_pop_front(deque);
+            deque_push_back(deque, data);
+        }
+    }
+    else
     {
-        void *data = deque_pop_front(deque);
-        deque_push_back(deque, data);
+        for (size_t i = 0; i < size - steps; i++)
+        {
+            void *data = deque_pop_back(deque);
+            deque_push_front(deque, data);
+        }
     }
 }
 
@@ -284,12 +474,7 @@ static inline void deque_rotate_right(Deque *deque, size_t steps)
     if (steps == 0)
         return;
 
-    // Move 'steps' elements from back to front
-    for (size_t i = 0; i < steps; i++)
-    {
-        void *data = deque_pop_back(deque);
-        deque_push_front(deque, data);
-    }
+    deque_rotate_left(deque, size - steps);
 }
 
 // ==================== MERGE OPERATIONS ====================
@@ -301,6 +486,7 @@ static inline void deque_rotate_right(Deque *deque, size_t steps)
  */
 static inline void deque_merge_back(Deque *dest, Deque *source)
 {
+    deque_reserve(dest, dest->size + source->size);
     while (!deque_is_empty(source))
     {
         void *data = deque_pop_front(source);
@@ -315,6 +501,7 @@ static inline void deque_merge_back(Deque *dest, Deque *source)
  */
 static inline void deque_merge_front(Deque *dest, Deque *source)
 {
+    deque_reserve(dest, dest->size + source->size);
     while (!deque_is_empty(source))
     {
         void *data = deque_pop_back(source);
@@ -329,7 +516,7 @@ static inline void deque_merge_front(Deque *dest, Deque *source)
  */
 static inline void deque_copy(Deque *source, Deque *dest)
 {
-    deque_init(dest);
+    deque_init_with_capacity(dest, source->size);
     size_t size = deque_size(source);
 
     // Copy all elements maintaining order
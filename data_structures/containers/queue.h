@@ -1,7 +1,7 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
-#include "../linkedlist/doubly_linked_list.h"
+#include "deque.h"
 #include "container_interface.h"
 #include <stdio.h>
 #include <stdbool.h>
@@ -9,11 +9,11 @@
 /**
  * QUEUE IMPLEMENTATION - FIFO CONTAINER
  *
- * First-In-First-Out data structure using doubly linked list.
- * Provides O(1) operations at both ends without the complexity of circular buffers.
+ * First-In-First-Out data structure on top of the ring-buffer Deque.
+ * Elements are stored contiguously, so enqueue never allocates a node.
  *
  * Time Complexities:
- * - Enqueue: O(1)
+ * - Enqueue: O(1) amortized
  * - Dequeue: O(1)
  * - Peek: O(1)
  * - Size: O(1)
@@ -31,7 +31,7 @@
 // Queue structure
 typedef struct Queue
 {
-    DoublyLinkedList list;            // Underlying storage
+    Deque deque;                      // Underlying storage
     const ContainerInterface *vtable; // Interface for polymorphism
 } Queue;
 
@@ -43,7 +43,7 @@ typedef struct Queue
  */
 static inline void queue_init(Queue *queue)
 {
-    doubly_init(&queue->list);
+    deque_init(&queue->deque);
     queue->vtable = NULL;
 }
 
@@ -54,7 +54,7 @@ static inline void queue_init(Queue *queue)
  */
 static inline void queue_enqueue(Queue *queue, void *data)
 {
-    doubly_push_back(&queue->list, data);
+    deque_push_back(&queue->deque, data);
 }
 
 /**
@@ -64,7 +64,7 @@ static inline void queue_enqueue(Queue *queue, void *data)
  */
 static inline void *queue_dequeue(Queue *queue)
 {
-    return doubly_pop_front(&queue->list);
+    return deque_pop_front(&queue->deque);
 }
 
 /**
@@ -74,7 +74,7 @@ static inline void *queue_dequeue(Queue *queue)
  */
 static inline void *queue_peek(Queue *queue)
 {
-    return doubly_get_at(&queue->list, 0);
+    return deque_peek_front(&queue->deque);
 }
 
 /**
@@ -84,8 +84,7 @@ static inline void *queue_peek(Queue *queue)
  */
 static inline void *queue_peek_rear(Queue *queue)
 {
-    size_t size = doubly_size(&queue->list);
-    return size > 0 ? doubly_get_at(&queue->list, size - 1) : NULL;
+    return deque_peek_back(&queue->deque);
 }
 
 /**
@@ -95,7 +94,7 @@ static inline void *queue_peek_rear(Queue *queue)
  */
 static inline size_t queue_size(Queue *queue)
 {
-    return doubly_size(&queue->list);
+    return deque_size(&queue->deque);
 }
 
 /**
@@ -105,7 +104,7 @@ static inline size_t queue_size(Queue *queue)
  */
 static inline bool queue_is_empty(Queue *queue)
 {
-    return doubly_is_empty(&queue->list);
+    return deque_is_empty(&queue->deque);
 }
 
 /**
@@ -114,7 +113,7 @@ static inline bool queue_is_empty(Queue *queue)
  */
 static inline void queue_clear(Queue *queue)
 {
-    doubly_clear(&queue->list);
+    deque_clear(&queue->deque);
 }
 
 /**
@@ -123,7 +122,7 @@ static inline void queue_clear(Queue *queue)
  */
 static inline void queue_free(Queue *queue)
 {
-    doubly_free(&queue->list);
+    deque_free(&queue->deque);
     queue->vtable = NULL;
 }
 
@@ -137,7 +136,7 @@ static inline void queue_free(Queue *queue)
  */
 static inline void *queue_get_at(Queue *queue, size_t index)
 {
-    return doubly_get_at(&queue->list, index);
+    return deque_get_at(&queue->deque, index);
 }
 
 /**
@@ -148,7 +147,7 @@ static inline void *queue_get_at(Queue *queue, size_t index)
  */
 static inline bool queue_contains(Queue *queue, void *data)
 {
-    return doubly_contains(&queue->list, data);
+    return deque_contains(&queue->deque, data);
 }
 
 /**
@@ -160,6 +159,7 @@ static inline void queue_copy(Queue *source, Queue *dest)
 {
     queue_init(dest);
     size_t size = queue_size(source);
+    deque_reserve(&dest->deque, size);
 
     // Copy all elements maintaining FIFO order
     for (size_t i = 0; i < size; i++)
@@ -175,7 +175,7 @@ static inline void queue_copy(Queue *source, Queue *dest)
  */
 static inline void queue_reverse(Queue *queue)
 {
-    doubly_reverse(&queue->list);
+    deque_reverse(&queue->deque);
 }
 
 // ==================== UTILITY FUNCTIONS ====================
@@ -0,0 +1,122 @@
+#ifndef TYPED_DEQUE_H
+#define TYPED_DEQUE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * TYPED DEQUE (MACRO-GENERATED)
+ *
+ * DEFINE_DEQUE(Name, T) generates a double-ended queue `Name` storing elements
+ * of type T by value in a power-of-two ring buffer. Replaces the boxing
+ * DEQUE_PUSH_BACK_INT style helpers: no allocation per element, no list nodes.
+ *
+ * Usage:
+ *   DEFINE_DEQUE(IntDeque, int)
+ *   IntDeque d; IntDeque_init(&d, 0); IntDeque_push_back(&d, 1);
+ *
+ * Time Complexities:
+ * - Push/Pop front/back: O(1) amortized
+ * - Random access: O(1)
+ *
+ * Space Complexity: O(n * sizeof(T))
+ */
+
+#define TYPED_DEQUE_DEFAULT_CAPACITY 8
+
+#define DEFINE_DEQUE(Name, T)                                                    \
+                                                                                 \
+typedef struct Name {                                                            \
+    T *data;         /* Ring buffer */                                           \
+    size_t head;     /* Index of front element */                                \
+    size_t size;     /* Number of elements */                                    \
+    size_t capacity; /* Buffer length (power of two) */                          \
+} Name;                                                                          \
+                                                                                 \
+/* Initialize deque (capacity rounded up to a power of two) */                   \
+static inline void Name##_init(Name *dq, size_t initial_capacity) {              \
+    size_t cap = TYPED_DEQUE_DEFAULT_CAPACITY;                                   \
+    while (cap < initial_capacity) cap <<= 1;                                    \
+    dq->data = (T *)malloc(cap * sizeof(T));                                     \
+    if (!dq->data) {                                                             \
+        fprintf(stderr, #Name "_init: allocation failed\n");                     \
+        exit(EXIT_FAILURE);                                                      \
+    }                                                                            \
+    dq->head = 0;                                                                \
+    dq->size = 0;                                                                \
+    dq->capacity = cap;                                                          \
+}                                                                                \
+                                                                                 \
+/* Double capacity, unwrapping the ring (internal helper) */                     \
+static inline void Name##_grow(Name *dq) {                                       \
+    size_t new_capacity = dq->capacity * 2;                                      \
+    T *new_data = (T *)malloc(new_capacity * sizeof(T));                         \
+    if (!new_data) {                                                             \
+        fprintf(stderr, #Name "_grow: allocation failed\n");                     \
+        exit(EXIT_FAILURE);                                                      \
+    }                                                                            \
+    size_t first = dq->capacity - dq->head;                                      \
+    if (first > dq->size) first = dq->size;                                      \
+    memcpy(new_data, dq->data + dq->head, first * sizeof(T));                    \
+    memcpy(new_data + first, dq->data, (dq->size - first) * sizeof(T));          \
+    free(dq->data);                                                              \
+    dq->data = new_data;                                                         \
+    dq->head = 0;                                                                \
+    dq->capacity = new_capacity;                                                 \
+}                                                                                \
+                                                                                 \
+static inline void Name##_push_back(Name *dq, T value) {                         \
+    if (dq->size == dq->capacity) Name##_grow(dq);                               \
+    dq->data[(dq->head + dq->size++) & (dq->capacity - 1)] = value;              \
+}                                                                                \
+                                                                                 \
+static inline void Name##_push_front(Name *dq, T value) {                        \
+    if (dq->size == dq->capacity) Name##_grow(dq);                               \
+    dq->head = (dq->head - 1) & (dq->capacity - 1);                              \
+    dq->data[dq->head] = value;                                                  \
+    dq->size++;                                                                  \
+}                                                                                \
+                                                                                 \
+/* Remove front into *out (may be NULL), false if empty */                       \
+static inline bool Name##_pop_front(Name *dq, T *out) {                          \
+    if (dq->size == 0) return false;                                             \
+    if (out) *out = dq->data[dq->head];                                          \
+    dq->head = (dq->head + 1) & (dq->capacity - 1);                              \
+    dq->size--;                                                                  \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Remove back into *out (may be NULL), false if empty */                        \
+static inline bool Name##_pop_back(Name *dq, T *out) {                           \
+    if (dq->size == 0) return false;                                             \
+    dq->size--;                                                                  \
+    if (out) *out = dq->data[(dq->head + dq->size) & (dq->capacity - 1)];        \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Pointer to element at logical index, NULL if out of bounds */                 \
+static inline T *Name##_at(const Name *dq, size_t index) {                       \
+    if (index >= dq->size) return NULL;                                          \
+    return &dq->data[(dq->head + index) & (dq->capacity - 1)];                   \
+}                                                                                \
+                                                                                 \
+static inline T *Name##_front(const Name *dq) { return Name##_at(dq, 0); }       \
+static inline T *Name##_back(const Name *dq) {                                   \
+    return dq->size ? Name##_at(dq, dq->size - 1) : NULL;                        \
+}                                                                                \
+static inline size_t Name##_size(const Name *dq) { return dq->size; }            \
+static inline bool Name##_is_empty(const Name *dq) { return dq->size == 0; }     \
+static inline void Name##_clear(Name *dq) { dq->head = 0; dq->size = 0; }        \
+                                                                                 \
+/* Free deque memory */                                                          \
+static inline void Name##_free(Name *dq) {                                       \
+    free(dq->data);                                                              \
+    dq->data = NULL;                                                             \
+    dq->head = 0;                                                                \
+    dq->size = 0;                                                                \
+    dq->capacity = 0;                                                            \
+}
+
+#endif // TYPED_DEQUE_H
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include "../stats/ds_stats.h"
 
 /**
  * DYNAMIC ARRAY IMPLEMENTATION
@@ -15,7 +16,7 @@
  * - Access: O(1)
  * - Append: O(1) amortized
  * - Insert: O(n) worst case
- * - Remove: O(n) worst case
+ * - Remove: O(n) worst case, O(1) when order may change (swap remove)
  * 
  * Space Complexity: O(n)
  */
@@ -49,6 +50,7 @@ static inline void dynarray_init(DynArray *arr, size_t initial_capacity) {
         fprintf(stderr, "dynarray_init: allocation failed\n");
         exit(EXIT_FAILURE);
     }
+    DS_STATS_ALLOC(DS_STATS_DYNARRAY, arr->capacity * sizeof(void *));
 }
 
 /**
@@ -60,6 +62,7 @@ static inline void dynarray_init(DynArray *arr, size_t initial_capacity) {
 static inline void dynarray_resize(DynArray *arr, size_t new_capacity) {
     if (new_capacity < arr->size) return; // Cannot shrink below current size
     
+    DS_STATS_TIMER(started);
     void **new_data = (void **)realloc(arr->data, new_capacity * sizeof(void *));
     if (!new_data) {
         fprintf(stderr, "dynarray_resize: reallocation failed\n");
@@ -68,6 +71,8 @@ static inline void dynarray_resize(DynArray *arr, size_t new_capacity) {
     
     arr->data = new_data;
     arr->capacity = new_capacity;
+    DS_STATS_ALLOC(DS_STATS_DYNARRAY, new_capacity * sizeof(void *));
+    DS_STATS_RESIZE(DS_STATS_DYNARRAY, started);
 }
 
 /**
@@ -183,6 +188,22 @@ static inline void *dynarray_remove(DynArray *arr, size_t index) {
     return element;
 }
 
+/**
+ * Remove element at specific index by moving the last element into its place
+ * (element order is not preserved)
+ * @param arr: Target array
+ * @param index: Index to remove
+ * @return: Removed element, NULL if out of bounds
+ * Time Complexity: O(1)
+ */
+static inline void *dynarray_swap_remove(DynArray *arr, size_t index) {
+    if (index >= arr->size) return NULL;
+    
+    void *element = arr->data[index];
+    arr->data[index] = arr->data[--arr->size];
+    return element;
+}
+
 /**
  * Get current size
  * @param arr: Target array
@@ -0,0 +1,108 @@
+#ifndef DYNARRAY_SORT_H
+#define DYNARRAY_SORT_H
+
+#include "dynarray.h"
+#include "../sort/sort.h"
+
+/**
+ * DYNAMIC ARRAY SORTING
+ *
+ * Sorts for DynArray and for DEFINE_DYNARRAY arrays, built on sort/sort.h.
+ * - dynarray_sort (introsort, in place), dynarray_sort_stable (merge sort)
+ *   and dynarray_sort_parallel (stable) order the element pointers with a
+ *   comparator that receives the elements themselves (as heap_compare_fn
+ *   does), not pointers to the slots as qsort's does. Elements allocated in
+ *   push order favour the merge sorts, see sort/sort.h
+ * - dynarray_sort_by_key is a stable LSD radix sort on a 64-bit key per
+ *   element; build keys from int/float fields with sort_key_from_int /
+ *   sort_key_from_float, put a tie-break in the low 32 bits, and invert the
+ *   field key (~key) for descending order
+ * - DEFINE_DYNARRAY_SORT(Name, T, COMPARE) adds Name_sort, Name_stable_sort
+ *   and Name_parallel_sort to a typed array, with COMPARE(a, b) on two T
+ *   values expanded inline
+ *
+ * Usage:
+ *   DEFINE_DYNARRAY(IntArray, int)
+ *   DEFINE_DYNARRAY_SORT(IntArray, int, SORT_CMP)
+ *   IntArray_sort(&a);
+ *
+ * Time Complexities:
+ * - Sort: O(n log n) worst case, not stable
+ * - Stable / parallel sort: O(n log n), stable
+ * - Sort by key: O(n * varying key bytes), stable
+ *
+ * Space Complexity: O(log n) sort, O(n) for the others
+ */
+
+// Element comparator: <0, 0, >0 like qsort, called with two stored elements
+typedef int (*dynarray_compare_fn)(const void *a, const void *b);
+
+// Run-time comparator passed through DEFINE_SORT_WITH as its context (internal helper)
+#define DYNARRAY_SORT_COMPARE(compare, a, b) ((compare)((a), (b)))
+
+DEFINE_SORT_WITH(dynarray_elements, void *, dynarray_compare_fn, DYNARRAY_SORT_COMPARE)
+
+/**
+ * Sort elements in place with introsort
+ * @param arr: Array to sort
+ * @param compare: Element comparator
+ * Time Complexity: O(n log n)
+ */
+static inline void dynarray_sort(DynArray *arr, dynarray_compare_fn compare) {
+    dynarray_elements_sort(arr->data, arr->size, compare);
+}
+
+/**
+ * Sort elements with merge sort, keeping equal elements in order
+ * @param arr: Array to sort
+ * @param compare: Element comparator
+ * Time Complexity: O(n log n)
+ */
+static inline void dynarray_sort_stable(DynArray *arr, dynarray_compare_fn compare) {
+    dynarray_elements_merge_sort(arr->data, arr->size, compare);
+}
+
+/**
+ * Sort elements with parallel merge sort on the workers of pool, keeping equal elements in order
+ * Falls back to dynarray_sort_stable below SORT_PARALLEL_THRESHOLD or without a pool.
+ * @param arr: Array to sort
+ * @param compare: Element comparator, called from several threads at once
+ * @param pool: Worker pool (may be NULL)
+ * Time Complexity: O((n log n) / p) per worker
+ */
+static inline void dynarray_sort_parallel(DynArray *arr, dynarray_compare_fn compare, ThreadPool *pool) {
+    dynarray_elements_parallel_sort(arr->data, arr->size, compare, pool);
+}
+
+/**
+ * Sort elements by an unsigned 64-bit key, keeping equal keys in order
+ * @param arr: Array to sort
+ * @param key: Key of an element, called once per element
+ * @param ctx: Passed to key
+ * Time Complexity: O(n) per varying key byte
+ */
+static inline void dynarray_sort_by_key(DynArray *arr, SortKeyFn key, const void *ctx) {
+    sort_radix_by_key(arr->data, arr->size, key, ctx);
+}
+
+// Typed arrays: Name_sort, Name_stable_sort and Name_parallel_sort with COMPARE inlined
+#define DEFINE_DYNARRAY_SORT(Name, T, COMPARE)                                              \
+                                                                                            \
+DEFINE_SORT(Name##_elements, T, COMPARE)                                                    \
+                                                                                            \
+/* Sort elements in place with introsort */                                                 \
+static inline void Name##_sort(Name *arr) {                                                 \
+    Name##_elements_sort(arr->data, arr->size);                                             \
+}                                                                                           \
+                                                                                            \
+/* Stable merge sort of the elements */                                                     \
+static inline void Name##_stable_sort(Name *arr) {                                          \
+    Name##_elements_merge_sort(arr->data, arr->size);                                       \
+}                                                                                           \
+                                                                                            \
+/* Stable sort on the workers of pool (NULL sorts on the caller) */                         \
+static inline void Name##_parallel_sort(Name *arr, ThreadPool *pool) {                      \
+    Name##_elements_parallel_sort(arr->data, arr->size, pool);                              \
+}
+
+#endif // DYNARRAY_SORT_H
@@ -0,0 +1,155 @@
+#ifndef TYPED_DYNARRAY_H
+#define TYPED_DYNARRAY_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * TYPED DYNAMIC ARRAY (MACRO-GENERATED)
+ *
+ * DEFINE_DYNARRAY(Name, T) generates a dynamic array type `Name` that stores
+ * elements of type T by value in one contiguous buffer, plus `Name_xxx`
+ * functions mirroring dynarray.h. No per-element allocation, no void* boxing,
+ * and element size is a compile-time constant.
+ *
+ * Usage:
+ *   DEFINE_DYNARRAY(IntArray, int)
+ *   IntArray a; IntArray_init(&a, 0); IntArray_push(&a, 42);
+ *   int x = *IntArray_at(&a, 0);
+ *
+ * Time Complexities:
+ * - Access: O(1)
+ * - Append: O(1) amortized
+ * - Insert / Remove: O(n)
+ * - Swap-remove: O(1)
+ *
+ * Space Complexity: O(n * sizeof(T))
+ */
+
+#define TYPED_DYNARRAY_DEFAULT_CAPACITY 8
+
+#define DEFINE_DYNARRAY(Name, T)                                                 \
+                                                                                 \
+typedef struct Name {                                                            \
+    T *data;         /* Elements stored by value */                              \
+    size_t size;     /* Number of elements used */                               \
+    size_t capacity; /* Total allocated capacity */                              \
+} Name;                                                                          \
+                                                                                 \
+/* Initialize with capacity (0 uses default) */                                  \
+static inline void Name##_init(Name *arr, size_t initial_capacity) {             \
+    arr->size = 0;                                                               \
+    arr->capacity = initial_capacity > 0 ? initial_capacity                     \
+                                         : TYPED_DYNARRAY_DEFAULT_CAPACITY;      \
+    arr->data = (T *)malloc(arr->capacity * sizeof(T));                          \
+    if (!arr->data) {                                                            \
+        fprintf(stderr, #Name "_init: allocation failed\n");                     \
+        exit(EXIT_FAILURE);                                                      \
+    }                                                                            \
+}                                                                                \
+                                                                                 \
+/* Reserve minimum capacity */                                                   \
+static inline void Name##_reserve(Name *arr, size_t min_capacity) {              \
+    if (min_capacity <= arr->capacity) return;                                   \
+    T *new_data = (T *)realloc(arr->data, min_capacity * sizeof(T));             \
+    if (!new_data) {                                                             \
+        fprintf(stderr, #Name "_reserve: reallocation failed\n");                \
+        exit(EXIT_FAILURE);                                                      \
+    }                                                                            \
+    arr->data = new_data;                                                        \
+    arr->capacity = min_capacity;                                                \
+}                                                                                \
+                                                                                 \
+/* Append element by value, O(1) amortized */                                    \
+static inline void Name##_push(Name *arr, T value) {                             \
+    if (arr->size >= arr->capacity) {                                            \
+        Name##_reserve(arr, arr->capacity ? arr->capacity * 2                    \
+                                          : TYPED_DYNARRAY_DEFAULT_CAPACITY);    \
+    }                                                                            \
+    arr->data[arr->size++] = value;                                              \
+}                                                                                \
+                                                                                 \
+/* Append count elements at once */                                              \
+static inline void Name##_push_many(Name *arr, const T *values, size_t count) {  \
+    if (arr->size + count > arr->capacity) {                                     \
+        size_t cap = arr->capacity ? arr->capacity                               \
+                                   : TYPED_DYNARRAY_DEFAULT_CAPACITY;            \
+        while (cap < arr->size + count) cap *= 2;                                \
+        Name##_reserve(arr, cap);                                                \
+    }                                                                            \
+    if (count) memcpy(arr->data + arr->size, values, count * sizeof(T));         \
+    arr->size += count;                                                          \
+}                                                                                \
+                                                                                 \
+/* Remove last element into *out (may be NULL), false if empty */                \
+static inline bool Name##_pop(Name *arr, T *out) {                               \
+    if (arr->size == 0) return false;                                            \
+    arr->size--;                                                                 \
+    if (out) *out = arr->data[arr->size];                                        \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Pointer to element at index, NULL if out of bounds */                         \
+static inline T *Name##_at(const Name *arr, size_t index) {                      \
+    return index < arr->size ? &arr->data[index] : NULL;                         \
+}                                                                                \
+                                                                                 \
+/* Copy element at index into *out, false if out of bounds */                    \
+static inline bool Name##_get(const Name *arr, size_t index, T *out) {           \
+    if (index >= arr->size) return false;                                        \
+    *out = arr->data[index];                                                     \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Overwrite element at index, false if out of bounds */                         \
+static inline bool Name##_set(Name *arr, size_t index, T value) {                \
+    if (index >= arr->size) return false;                                        \
+    arr->data[index] = value;                                                    \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Insert at index shifting the tail right, false if out of bounds */            \
+static inline bool Name##_insert(Name *arr, size_t index, T value) {             \
+    if (index > arr->size) return false;                                         \
+    if (arr->size >= arr->capacity) Name##_reserve(arr, arr->capacity * 2);      \
+    memmove(arr->data + index + 1, arr->data + index,                            \
+            (arr->size - index) * sizeof(T));                                    \
+    arr->data[index] = value;                                                    \
+    arr->size++;                                                                 \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Remove at index preserving order, removed value into *out (may be NULL) */    \
+static inline bool Name##_remove(Name *arr, size_t index, T *out) {              \
+    if (index >= arr->size) return false;                                        \
+    if (out) *out = arr->data[index];                                            \
+    memmove(arr->data + index, arr->data + index + 1,                            \
+            (arr->size - index - 1) * sizeof(T));                                \
+    arr->size--;                                                                 \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Remove at index in O(1) by moving the last element into the hole */           \
+static inline bool Name##_swap_remove(Name *arr, size_t index, T *out) {         \
+    if (index >= arr->size) return false;                                        \
+    if (out) *out = arr->data[index];                                            \
+    arr->data[index] = arr->data[--arr->size];                                   \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+static inline size_t Name##_size(const Name *arr) { return arr->size; }          \
+static inline size_t Name##_capacity(const Name *arr) { return arr->capacity; }  \
+static inline bool Name##_is_empty(const Name *arr) { return arr->size == 0; }   \
+static inline void Name##_clear(Name *arr) { arr->size = 0; }                    \
+                                                                                 \
+/* Free all memory */                                                            \
+static inline void Name##_free(Name *arr) {                                      \
+    free(arr->data);                                                             \
+    arr->data = NULL;                                                            \
+    arr->size = 0;                                                               \
+    arr->capacity = 0;                                                           \
+}
+
+#endif // TYPED_DYNARRAY_H
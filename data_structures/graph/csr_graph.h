@@ -0,0 +1,560 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "graph.h"
+#include "../heap/indexed_heap.h"
+#include "../unionfind/unionfind.h"
+
+/**
+ * CSR (COMPRESSED SPARSE ROW) GRAPH
+ *
+ * Immutable adjacency structure for traversal-heavy workloads. Vertices are
+ * dense indices 0..n-1; the out-edges of v are targets[offsets[v]] up to
+ * targets[offsets[v + 1]], with weights in the parallel weights array. A
+ * traversal reads three flat arrays instead of chasing V/E pointers.
+ *
+ * Built either straight from an edge list (counting sort, O(n + m)) or from a
+ * pointer-based G, whose vertices are numbered in G->Vertices order and whose
+ * edges come from G->Edges.
+ *
+ * Time Complexities:
+ * - Build: O(n + m)
+ * - Degree / Neighbors: O(1)
+ * - BFS / DFS: O(n + m)
+ * - Dijkstra: O((n + m) log n) via IndexedHeap decrease-key
+ * - Connected components: O(m α(n)) via UnionFind
+ *
+ * Space Complexity: O(n + m)
+ */
+
+// Vertex index type (edge offsets are 64-bit)
+typedef uint32_t csr_vertex_t;
+
+// Marks an unreached vertex in BFS/Dijkstra output
+#define CSR_GRAPH_UNREACHED UINT32_MAX
+#define CSR_GRAPH_INFINITY INT64_MAX
+
+// Edge list entry for csr_graph_from_edges
+typedef struct CSREdge
+{
+    csr_vertex_t from;
+    csr_vertex_t to;
+    int weight;
+} CSREdge;
+
+// CSR graph structure
+typedef struct CSRGraph
+{
+    size_t vertex_count;   // Number of vertices
+    size_t edge_count;     // Number of stored (directed) edges
+    size_t *offsets;       // vertex_count + 1 edge offsets
+    csr_vertex_t *targets; // Edge targets grouped by source
+    int *weights;          // Edge weights, parallel to targets
+    int *vertex_ids;       // Dense index -> V.id when built from G, NULL otherwise
+    bool undirected;       // Every edge is stored in both directions
+} CSRGraph;
+
+// ==================== HELPER FUNCTIONS ====================
+
+/**
+ * Allocate or exit (internal helper)
+ * @param bytes: Size to allocate
+ * @param where: Caller name for the error message
+ * @return: New memory
+ */
+static inline void *csr_graph_alloc(size_t bytes, const char *where)
+{
+    void *memory = malloc(bytes > 0 ? bytes : 1);
+    if (!memory)
+    {
+        fprintf(stderr, "%s: allocation failed\n", where);
+        exit(EXIT_FAILURE);
+    }
+    return memory;
+}
+
+/**
+ * Allocate arrays for a graph of known shape (internal helper)
+ * @param graph: Graph to set up
+ * @param vertex_count: Number of vertices
+ * @param edge_count: Number of stored edges
+ */
+static inline void csr_graph_allocate(CSRGraph *graph, size_t vertex_count, size_t edge_count)
+{
+    graph->vertex_count = vertex_count;
+    graph->edge_count = edge_count;
+    graph->offsets = (size_t *)csr_graph_alloc((vertex_count + 1) * sizeof(size_t), "csr_graph_allocate");
+    graph->targets = (csr_vertex_t *)csr_graph_alloc(edge_count * sizeof(csr_vertex_t), "csr_graph_allocate");
+    graph->weights = (int *)csr_graph_alloc(edge_count * sizeof(int), "csr_graph_allocate");
+    graph->vertex_ids = NULL;
+    graph->undirected = false;
+}
+
+/**
+ * Turn per-vertex degrees in offsets[1..n] into start offsets (internal helper)
+ * @param graph: Graph whose offsets hold degrees shifted by one
+ */
+static inline void csr_graph_prefix_offsets(CSRGraph *graph)
+{
+    graph->offsets[0] = 0;
+    for (size_t v = 0; v < graph->vertex_count; v++)
+    {
+        graph->offsets[v + 1] += graph->offsets[v];
+    }
+}
+
+/**
+ * Append edge to its source block during construction (internal helper)
+ * @param graph: Graph under construction
+ * @param cursor: Next free slot per vertex
+ * @param from: Source vertex
+ * @param to: Target vertex
+ * @param weight: Edge weight
+ */
+static inline void csr_graph_scatter(CSRGraph *graph, size_t *cursor, csr_vertex_t from, csr_vertex_t to, int weight)
+{
+    size_t slot = cursor[from]++;
+    graph->targets[slot] = to;
+    graph->weights[slot] = weight;
+}
+
+// V* -> dense index pair used while converting a G (internal helper)
+typedef struct CSRVertexSlot
+{
+    const V *vertex;
+    csr_vertex_t index;
+} CSRVertexSlot;
+
+// Orders slots by vertex address for binary search (internal helper)
+static inline int csr_vertex_slot_compare(const void *a, const void *b)
+{
+    uintptr_t x = (uintptr_t)((const CSRVertexSlot *)a)->vertex;
+    uintptr_t y = (uintptr_t)((const CSRVertexSlot *)b)->vertex;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Look up dense index of a G vertex (internal helper)
+ * @param slots: Slots sorted by vertex pointer
+ * @param count: Number of slots
+ * @param vertex: Vertex to find
+ * @return: Dense index, CSR_GRAPH_UNREACHED if vertex is not in the graph
+ */
+static inline csr_vertex_t csr_graph_lookup_vertex(const CSRVertexSlot *slots, size_t count, const V *vertex)
+{
+    size_t lo = 0, hi = count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if ((uintptr_t)slots[mid].vertex < (uintptr_t)vertex)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return (lo < count && slots[lo].vertex == vertex) ? slots[lo].index : CSR_GRAPH_UNREACHED;
+}
+
+// ==================== CONSTRUCTION ====================
+
+/**
+ * Build CSR graph from an edge list
+ * @param graph: Graph to build
+ * @param vertex_count: Number of vertices (endpoints must be < vertex_count)
+ * @param edges: Edge list
+ * @param edge_count: Number of edges
+ * @param undirected: Store each edge in both directions
+ * @return: false if an endpoint is out of range (graph left unbuilt)
+ */
+static inline bool csr_graph_from_edges(CSRGraph *graph, size_t vertex_count, const CSREdge *edges,
+                                        size_t edge_count, bool undirected)
+{
+    for (size_t i = 0; i < edge_count; i++)
+    {
+        if (edges[i].from >= vertex_count || edges[i].to >= vertex_count)
+            return false;
+    }
+
+    csr_graph_allocate(graph, vertex_count, undirected ? 2 * edge_count : edge_count);
+    memset(graph->offsets, 0, (vertex_count + 1) * sizeof(size_t));
+    for (size_t i = 0; i < edge_count; i++)
+    {
+        graph->offsets[edges[i].from + 1]++;
+        if (undirected)
+            graph->offsets[edges[i].to + 1]++;
+    }
+    csr_graph_prefix_offsets(graph);
+
+    size_t *cursor = (size_t *)csr_graph_alloc(vertex_count * sizeof(size_t), "csr_graph_from_edges");
+    memcpy(cursor, graph->offsets, vertex_count * sizeof(size_t));
+    for (size_t i = 0; i < edge_count; i++)
+    {
+        csr_graph_scatter(graph, cursor, edges[i].from, edges[i].to, edges[i].weight);
+        if (undirected)
+            csr_graph_scatter(graph, cursor, edges[i].to, edges[i].from, edges[i].weight);
+    }
+    free(cursor);
+    graph->undirected = undirected;
+    return true;
+}
+
+/**
+ * Build the transpose (every edge reversed, weights kept)
+ * Pull-style kernels read in-edges from it; an undirected graph is its own transpose.
+ * @param transpose: Graph to build
+ * @param graph: Source graph (unchanged)
+ */
+static inline void csr_graph_transpose(CSRGraph *transpose, const CSRGraph *graph)
+{
+    size_t n = graph->vertex_count;
+    csr_graph_allocate(transpose, n, graph->edge_count);
+    memset(transpose->offsets, 0, (n + 1) * sizeof(size_t));
+    for (size_t e = 0; e < graph->edge_count; e++)
+    {
+        transpose->offsets[graph->targets[e] + 1]++;
+    }
+    csr_graph_prefix_offsets(transpose);
+
+    size_t *cursor = (size_t *)csr_graph_alloc(n * sizeof(size_t), "csr_graph_transpose");
+    memcpy(cursor, transpose->offsets, n * sizeof(size_t));
+    for (size_t u = 0; u < n; u++)
+    {
+        for (size_t e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+        {
+            csr_graph_scatter(transpose, cursor, graph->targets[e], (csr_vertex_t)u, graph->weights[e]);
+        }
+    }
+    free(cursor);
+    transpose->undirected = graph->undirected;
+}
+
+/**
+ * Build CSR graph from a pointer-based graph
+ * Vertex i is G->Vertices[i]; its V.id is kept in vertex_ids. Edges whose
+ * endpoints are not in G->Vertices are skipped.
+ * @param graph: Graph to build
+ * @param source: Graph to convert (unchanged)
+ * @param undirected: Store each edge in both directions
+ */
+static inline void csr_graph_from_graph(CSRGraph *graph, const G *source, bool undirected)
+{
+    size_t vertex_count = source->Vertices.size;
+    size_t edge_count = source->Edges.size;
+
+    CSRVertexSlot *slots = (CSRVertexSlot *)csr_graph_alloc(vertex_count * sizeof(CSRVertexSlot), "csr_graph_from_graph");
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        slots[i].vertex = (const V *)source->Vertices.data[i];
+        slots[i].index = (csr_vertex_t)i;
+    }
+    qsort(slots, vertex_count, sizeof(CSRVertexSlot), csr_vertex_slot_compare);
+
+    CSREdge *edges = (CSREdge *)csr_graph_alloc(edge_count * sizeof(CSREdge), "csr_graph_from_graph");
+    size_t kept = 0;
+    for (size_t i = 0; i < edge_count; i++)
+    {
+        const E *edge = (const E *)source->Edges.data[i];
+        csr_vertex_t from = csr_graph_lookup_vertex(slots, vertex_count, edge->eVertices[0]);
+        csr_vertex_t to = csr_graph_lookup_vertex(slots, vertex_count, edge->eVertices[1]);
+        if (from == CSR_GRAPH_UNREACHED || to == CSR_GRAPH_UNREACHED)
+            continue;
+        edges[kept].from = from;
+        edges[kept].to = to;
+        edges[kept].weight = edge->weight;
+        kept++;
+    }
+    free(slots);
+
+    csr_graph_from_edges(graph, vertex_count, edges, kept, undirected);
+    free(edges);
+
+    graph->vertex_ids = (int *)csr_graph_alloc(vertex_count * sizeof(int), "csr_graph_from_graph");
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        graph->vertex_ids[i] = ((const V *)source->Vertices.data[i])->id;
+    }
+}
+
+/**
+ * Free CSR graph memory
+ * @param graph: Target graph
+ */
+static inline void csr_graph_free(CSRGraph *graph)
+{
+    free(graph->offsets);
+    free(graph->targets);
+    free(graph->weights);
+    free(graph->vertex_ids);
+    graph->offsets = NULL;
+    graph->targets = NULL;
+    graph->weights = NULL;
+    graph->vertex_ids = NULL;
+    graph->vertex_count = 0;
+    graph->edge_count = 0;
+}
+
+// ==================== ACCESSORS ====================
+
+/**
+ * Get out-degree of a vertex
+ * @param graph: Target graph
+ * @param v: Vertex
+ * @return: Number of out-edges
+ */
+static inline size_t csr_graph_degree(const CSRGraph *graph, csr_vertex_t v)
+{
+    return graph->offsets[v + 1] - graph->offsets[v];
+}
+
+/**
+ * Get out-neighbors of a vertex
+ * @param graph: Target graph
+ * @param v: Vertex
+ * @param count: Receives the number of neighbors
+ * @return: Contiguous neighbor array (weights at the same positions of csr_graph_edge_weights)
+ */
+static inline const csr_vertex_t *csr_graph_neighbors(const CSRGraph *graph, csr_vertex_t v, size_t *count)
+{
+    *count = graph->offsets[v + 1] - graph->offsets[v];
+    return graph->targets + graph->offsets[v];
+}
+
+/**
+ * Get out-edge weights of a vertex
+ * @param graph: Target graph
+ * @param v: Vertex
+ * @return: Weights parallel to csr_graph_neighbors
+ */
+static inline const int *csr_graph_edge_weights(const CSRGraph *graph, csr_vertex_t v)
+{
+    return graph->weights + graph->offsets[v];
+}
+
+// ==================== ALGORITHMS ====================
+
+/**
+ * Breadth-first search from a source vertex
+ * @param graph: Target graph
+ * @param source: Start vertex
+ * @param distance: Receives hop count per vertex, CSR_GRAPH_UNREACHED if unreachable
+ * @param parent: Receives BFS tree parent per vertex (source is its own parent), or NULL
+ * @return: Number of vertices reached
+ */
+static inline size_t csr_graph_bfs(const CSRGraph *graph, csr_vertex_t source, uint32_t *distance,
+                                   csr_vertex_t *parent)
+{
+    size_t n = graph->vertex_count;
+    for (size_t v = 0; v < n; v++)
+        distance[v] = CSR_GRAPH_UNREACHED;
+    if (parent)
+    {
+        for (size_t v = 0; v < n; v++)
+            parent[v] = CSR_GRAPH_UNREACHED;
+    }
+    if (source >= n)
+        return 0;
+
+    // Each vertex enters the queue once, so a flat array is the whole queue
+    csr_vertex_t *queue = (csr_vertex_t *)csr_graph_alloc(n * sizeof(csr_vertex_t), "csr_graph_bfs");
+    size_t head = 0, tail = 0;
+    queue[tail++] = source;
+    distance[source] = 0;
+    if (parent)
+        parent[source] = source;
+
+    while (head < tail)
+    {
+        csr_vertex_t u = queue[head++];
+        uint32_t next = distance[u] + 1;
+        for (size_t e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+        {
+            csr_vertex_t v = graph->targets[e];
+            if (distance[v] != CSR_GRAPH_UNREACHED)
+                continue;
+            distance[v] = next;
+            if (parent)
+                parent[v] = u;
+            queue[tail++] = v;
+        }
+    }
+
+    free(queue);
+    return tail;
+}
+
+/**
+ * Depth-first search from a source vertex (iterative)
+ * Visits neighbors in stored order, matching the recursive preorder.
+ * @param graph: Target graph
+ * @param source: Start vertex
+ * @param order: Receives vertices in preorder (capacity vertex_count)
+ * @return: Number of vertices visited
+ */
+static inline size_t csr_graph_dfs(const CSRGraph *graph, csr_vertex_t source, csr_vertex_t *order)
+{
+    size_t n = graph->vertex_count;
+    if (source >= n)
+        return 0;
+
+    unsigned char *visited = (unsigned char *)calloc(n, 1);
+    csr_vertex_t *stack = (csr_vertex_t *)csr_graph_alloc(n * sizeof(csr_vertex_t), "csr_graph_dfs");
+    size_t *cursor = (size_t *)csr_graph_alloc(n * sizeof(size_t), "csr_graph_dfs");
+    if (!visited)
+    {
+        fprintf(stderr, "csr_graph_dfs: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t count = 0, depth = 0;
+    visited[source] = 1;
+    order[count++] = source;
+    stack[depth] = source;
+    cursor[depth++] = graph->offsets[source];
+
+    while (depth > 0)
+    {
+        csr_vertex_t u = stack[depth - 1];
+        size_t end = graph->offsets[u + 1];
+        size_t e = cursor[depth - 1];
+        while (e < end && visited[graph->targets[e]])
+            e++;
+        if (e == end)
+        {
+            depth--;
+            continue;
+        }
+        cursor[depth - 1] = e + 1;
+
+        csr_vertex_t v = graph->targets[e];
+        visited[v] = 1;
+        order[count++] = v;
+        stack[depth] = v;
+        cursor[depth++] = graph->offsets[v];
+    }
+
+    free(cursor);
+    free(stack);
+    free(visited);
+    return count;
+}
+
+// Orders IndexedHeap entries (pointers into the distance array) by distance
+static inline int csr_graph_distance_compare(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Single-source shortest paths (Dijkstra, non-negative weights)
+ * Each vertex sits in an IndexedHeap under its own index, so a relaxed
+ * vertex is moved with decrease-key instead of being pushed again.
+ * @param graph: Target graph
+ * @param source: Start vertex
+ * @param distance: Receives path length per vertex, CSR_GRAPH_INFINITY if unreachable
+ * @param parent: Receives shortest-path tree parent per vertex, or NULL
+ * @return: Number of vertices reached
+ */
+static inline size_t csr_graph_dijkstra(const CSRGraph *graph, csr_vertex_t source, int64_t *distance,
+                                        csr_vertex_t *parent)
+{
+    size_t n = graph->vertex_count;
+    for (size_t v = 0; v < n; v++)
+        distance[v] = CSR_GRAPH_INFINITY;
+    if (parent)
+    {
+        for (size_t v = 0; v < n; v++)
+            parent[v] = CSR_GRAPH_UNREACHED;
+    }
+    if (source >= n)
+        return 0;
+
+    IndexedHeap heap;
+    indexed_heap_init(&heap, csr_graph_distance_compare, n);
+    distance[source] = 0;
+    if (parent)
+        parent[source] = source;
+    indexed_heap_push(&heap, source, &distance[source]);
+
+    size_t reached = 0;
+    while (!indexed_heap_is_empty(&heap))
+    {
+        size_t u;
+        indexed_heap_pop(&heap, &u);
+        reached++;
+        int64_t base = distance[u];
+        for (size_t e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+        {
+            csr_vertex_t v = graph->targets[e];
+            int64_t candidate = base + graph->weights[e];
+            if (candidate >= distance[v])
+                continue;
+            bool queued = distance[v] != CSR_GRAPH_INFINITY;
+            distance[v] = candidate;
+            if (parent)
+                parent[v] = (csr_vertex_t)u;
+            if (queued)
+                indexed_heap_decrease_key(&heap, v);
+            else
+                indexed_heap_push(&heap, v, &distance[v]);
+        }
+    }
+
+    indexed_heap_free(&heap);
+    return reached;
+}
+
+/**
+ * Turn union-find sets into dense component labels (internal helper)
+ * @param uf: Sets over the graph's vertices
+ * @param component: Receives label per vertex, dense from 0 in order of each set's lowest vertex
+ * @return: Number of labels
+ */
+static inline size_t csr_graph_label_components(UnionFind *uf, uint32_t *component)
+{
+    size_t n = (size_t)unionfind_count(uf);
+    // A root's slot holds its own label, so it can be assigned on first sight
+    for (size_t v = 0; v < n; v++)
+        component[v] = CSR_GRAPH_UNREACHED;
+    uint32_t labels = 0;
+    for (size_t v = 0; v < n; v++)
+    {
+        size_t root = (size_t)unionfind_find(uf, (unionfind_index_t)v);
+        if (component[root] == CSR_GRAPH_UNREACHED)
+            component[root] = labels++;
+        component[v] = component[root];
+    }
+    return labels;
+}
+
+/**
+ * Label connected components (weakly connected for directed graphs)
+ * @param graph: Target graph
+ * @param component: Receives component label per vertex, labels dense from 0
+ *                   in order of each component's lowest vertex
+ * @return: Number of components
+ */
+static inline size_t csr_graph_connected_components(const CSRGraph *graph, uint32_t *component)
+{
+    size_t n = graph->vertex_count;
+    UnionFind uf;
+    unionfind_init(&uf, (unionfind_index_t)n);
+    for (size_t u = 0; u < n; u++)
+    {
+        for (size_t e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+        {
+            unionfind_union(&uf, (unionfind_index_t)u, graph->targets[e]);
+        }
+    }
+
+    size_t labels = csr_graph_label_components(&uf, component);
+    unionfind_free(&uf);
+    return labels;
+}
+
+#endif // CSR_GRAPH_H
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "../dynarray/dynarray.h" // You must have dynarray.h in the include path
+#include "../allocator/allocator.h"
 
 // ---------------------- Vertex Definition ------------------------
 typedef struct V
@@ -22,16 +23,17 @@ typedef struct E
 // ---------------------- Graph Definition -------------------------
 typedef struct G
 {
-    DynArray Vertices; // Dynamic array of V*
-    DynArray Edges;    // Dynamic array of E*
+    DynArray Vertices;          // Dynamic array of V*
+    DynArray Edges;             // Dynamic array of E*
+    const Allocator *allocator; // Source of V/E made by graph_new_vertex/graph_new_edge
 } G;
 
 // ---------------------- Vertex Functions -------------------------
 
-// Creates a new vertex with a given id
-static inline V *newV(int id)
+// Creates a new vertex with a given id from an allocator (NULL = heap)
+static inline V *newV_with(const Allocator *allocator, int id)
 {
-    V *newVertex = (V *)malloc(sizeof(V));
+    V *newVertex = (V *)allocator_alloc(allocator, sizeof(V));
     if (!newVertex)
     {
         fprintf(stderr, "newV: malloc failed\n");
@@ -42,6 +44,12 @@ static inline V *newV(int id)
     return newVertex;
 }
 
+// Creates a new vertex with a given id
+static inline V *newV(int id)
+{
+    return newV_with(&HEAP_ALLOCATOR, id);
+}
+
 // Connects two vertices (adds 'end' as neighbor to 'start')
 static inline void connectV(V *start, V *end)
 {
@@ -50,10 +58,10 @@ static inline void connectV(V *start, V *end)
 
 // ---------------------- Edge Functions ---------------------------
 
-// Creates a new edge and connects startv to endv
-static inline E *newE(V *startv, V *endv, int weight)
+// Creates a new edge from an allocator (NULL = heap) and connects startv to endv
+static inline E *newE_with(const Allocator *allocator, V *startv, V *endv, int weight)
 {
-    E *edge = (E *)malloc(sizeof(E));
+    E *edge = (E *)allocator_alloc(allocator, sizeof(E));
     if (!edge)
     {
         fprintf(stderr, "newE: malloc failed\n");
@@ -66,6 +74,12 @@ static inline E *newE(V *startv, V *endv, int weight)
     return edge;
 }
 
+// Creates a new edge and connects startv to endv
+static inline E *newE(V *startv, V *endv, int weight)
+{
+    return newE_with(&HEAP_ALLOCATOR, startv, endv, weight);
+}
+
 // ---------------------- Graph Functions --------------------------
 
 // Initializes a new empty graph
@@ -73,6 +87,14 @@ static inline void graph_init(G *graph)
 {
     dynarray_init(&graph->Vertices, 0);
     dynarray_init(&graph->Edges, 0);
+    graph->allocator = &HEAP_ALLOCATOR;
+}
+
+// Initializes a new empty graph whose vertices/edges come from a custom allocator
+static inline void graph_init_with_allocator(G *graph, const Allocator *allocator)
+{
+    graph_init(graph);
+    graph->allocator = allocator;
 }
 
 // Adds a vertex to the graph
@@ -87,6 +109,22 @@ static inline void graph_add_edge(G *graph, E *edge)
     dynarray_push(&graph->Edges, edge);
 }
 
+// Creates a vertex from the graph's allocator and adds it to the graph
+static inline V *graph_new_vertex(G *graph, int id)
+{
+    V *vertex = newV_with(graph->allocator, id);
+    graph_add_vertex(graph, vertex);
+    return vertex;
+}
+
+// Creates an edge from the graph's allocator and adds it to the graph
+static inline E *graph_new_edge(G *graph, V *startv, V *endv, int weight)
+{
+    E *edge = newE_with(graph->allocator, startv, endv, weight);
+    graph_add_edge(graph, edge);
+    return edge;
+}
+
 // Frees all memory used by the graph (does not free vertices/edges themselves)
 static inline void graph_free(G *graph)
 {
@@ -94,4 +132,27 @@ static inline void graph_free(G *graph)
     dynarray_free(&graph->Edges);
 }
 
+// Frees the graph together with every vertex and edge it holds; all of them
+// must come from the graph's allocator. Region allocators skip per-node frees
+// (neighbor arrays are still released) and are reclaimed by their owner.
+static inline void graph_destroy(G *graph)
+{
+    bool bulk = allocator_frees_in_bulk(graph->allocator);
+    for (size_t i = 0; i < dynarray_size(&graph->Vertices); i++)
+    {
+        V *vertex = (V *)dynarray_get(&graph->Vertices, i);
+        dynarray_free(&vertex->neighbors);
+        if (!bulk)
+            allocator_free(graph->allocator, vertex, sizeof(V));
+    }
+    if (!bulk)
+    {
+        for (size_t i = 0; i < dynarray_size(&graph->Edges); i++)
+        {
+            allocator_free(graph->allocator, dynarray_get(&graph->Edges, i), sizeof(E));
+        }
+    }
+    graph_free(graph);
+}
+
 #endif // BASICGRAPH_H
\ No newline at end of file
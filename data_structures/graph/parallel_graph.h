@@ -0,0 +1,610 @@
+#ifndef PARALLEL_GRAPH_H
+#define PARALLEL_GRAPH_H
+
+#include <stdalign.h>
+#include "csr_graph.h"
+#include "../parallel/thread_pool.h"
+
+/**
+ * PARALLEL CSR GRAPH KERNELS
+ *
+ * Multi-threaded versions of the csr_graph.h kernels, run on a ThreadPool.
+ * Each takes the pool it should use; a one-thread pool gives the sequential
+ * schedule of the same algorithm.
+ *
+ * - BFS: level-synchronous and direction-optimizing (Beamer et al.). A level
+ *   is expanded top-down (frontier vertices claim unvisited neighbors with an
+ *   atomic bitmap OR) while the frontier is small, and bottom-up (unvisited
+ *   vertices look for any parent in the frontier bitmap, stopping at the
+ *   first) once the frontier's edges outweigh the unexplored edges / ALPHA.
+ *   It returns to top-down when the frontier drops below n / BETA. Bottom-up
+ *   needs in-edges: pass the transpose, or nothing for an undirected graph.
+ *   Per-worker buffers collect the next frontier without shared counters.
+ * - Connected components: Afforest. Threads link the first few neighbors of
+ *   every vertex with lock-free UnionFind CAS links, sample the largest
+ *   intermediate component, and then only process the remaining edges of
+ *   vertices outside it (undirected graphs; directed graphs process all edges).
+ * - PageRank: pull-based power iteration over in-edges, with per-worker
+ *   partial sums for dangling mass and convergence error.
+ *
+ * Results match the sequential kernels: BFS distances, component labels
+ * (dense, by lowest vertex), and PageRank up to floating-point summation order.
+ *
+ * Time Complexities (p threads):
+ * - BFS: O((n + m) / p + depth) per search
+ * - Connected components: O(m α(n) / p + n)
+ * - PageRank: O((n + m) / p) per iteration
+ *
+ * Space Complexity: O(n) beyond the graph
+ */
+
+// Direction-switch thresholds from Beamer et al.
+#define PARALLEL_BFS_ALPHA 14
+#define PARALLEL_BFS_BETA 24
+
+// Afforest: neighbors linked per vertex before sampling, and sample size
+#define PARALLEL_CC_NEIGHBOR_ROUNDS 2
+#define PARALLEL_CC_SAMPLES 1024
+
+// PageRank defaults
+#define PAGERANK_DEFAULT_DAMPING 0.85
+#define PAGERANK_DEFAULT_TOLERANCE 1e-9
+#define PAGERANK_DEFAULT_MAX_ITERATIONS 100
+
+// Per-worker vertex buffer and counters, one cache line apart
+typedef struct ParallelGraphBuffer
+{
+    alignas(THREAD_POOL_CACHE_LINE) csr_vertex_t *items;
+    size_t size;
+    size_t capacity;
+    size_t edges;   // Sum of out-degrees of items
+    double sum;     // PageRank partial sums
+    double error;
+} ParallelGraphBuffer;
+
+// ==================== SHARED HELPERS ====================
+
+/**
+ * Allocate one buffer per pool worker (internal helper)
+ * @param pool: Pool whose workers will fill the buffers
+ * @return: Zeroed buffers
+ */
+static inline ParallelGraphBuffer *parallel_graph_buffers_new(const ThreadPool *pool)
+{
+    size_t count = thread_pool_size(pool);
+    ParallelGraphBuffer *buffers = (ParallelGraphBuffer *)aligned_alloc(THREAD_POOL_CACHE_LINE,
+                                                                        count * sizeof(ParallelGraphBuffer));
+    if (!buffers)
+    {
+        fprintf(stderr, "parallel_graph_buffers_new: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(buffers, 0, count * sizeof(ParallelGraphBuffer));
+    return buffers;
+}
+
+/**
+ * Free per-worker buffers (internal helper)
+ * @param buffers: Buffers to free
+ * @param count: Number of buffers
+ */
+static inline void parallel_graph_buffers_free(ParallelGraphBuffer *buffers, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        free(buffers[i].items);
+    free(buffers);
+}
+
+/**
+ * Append vertex to a worker's buffer (internal helper)
+ * @param buffer: Buffer owned by the running worker
+ * @param v: Vertex to append
+ */
+static inline void parallel_graph_buffer_push(ParallelGraphBuffer *buffer, csr_vertex_t v)
+{
+    if (buffer->size == buffer->capacity)
+    {
+        size_t new_capacity = buffer->capacity ? buffer->capacity * 2 : 1024;
+        csr_vertex_t *items = (csr_vertex_t *)realloc(buffer->items, new_capacity * sizeof(csr_vertex_t));
+        if (!items)
+        {
+            fprintf(stderr, "parallel_graph_buffer_push: allocation failed\n");
+            exit(EXIT_FAILURE);
+        }
+        buffer->items = items;
+        buffer->capacity = new_capacity;
+    }
+    buffer->items[buffer->size++] = v;
+}
+
+/**
+ * Test a bitmap bit (internal helper)
+ * @param bits: Bitmap
+ * @param v: Bit index
+ * @return: true if set
+ */
+static inline bool parallel_graph_bit_test(const uint64_t *bits, csr_vertex_t v)
+{
+    return (__atomic_load_n(&bits[v >> 6], __ATOMIC_RELAXED) >> (v & 63)) & 1;
+}
+
+/**
+ * Atomically set a bitmap bit (internal helper)
+ * @param bits: Bitmap
+ * @param v: Bit index
+ * @return: true if this call set it (it was clear before)
+ */
+static inline bool parallel_graph_bit_claim(uint64_t *bits, csr_vertex_t v)
+{
+    uint64_t mask = (uint64_t)1 << (v & 63);
+    return !(__atomic_fetch_or(&bits[v >> 6], mask, __ATOMIC_RELAXED) & mask);
+}
+
+// ==================== PARALLEL BFS ====================
+
+// Shared state of one parallel BFS
+typedef struct ParallelBFSContext
+{
+    const CSRGraph *graph;
+    const CSRGraph *in_edges;      // Transpose for bottom-up steps, NULL for top-down only
+    uint32_t *distance;
+    uint64_t *visited;             // Bitmap of discovered vertices
+    uint64_t *frontier_bits;       // Bottom-up: current frontier
+    uint64_t *next_bits;           // Bottom-up: next frontier
+    const csr_vertex_t *frontier;  // Top-down: current frontier
+    uint32_t level;                // Distance of the current frontier
+    ParallelGraphBuffer *buffers;  // Next frontier, per worker
+} ParallelBFSContext;
+
+// Initialize distances (internal helper)
+static inline void parallel_bfs_reset_task(void *arg, size_t begin, size_t end, size_t worker)
+{
+    (void)worker;
+    ParallelBFSContext *ctx = (ParallelBFSContext *)arg;
+    for (size_t v = begin; v < end; v++)
+        ctx->distance[v] = CSR_GRAPH_UNREACHED;
+}
+
+// Expand a slice of the frontier along out-edges (internal helper)
+static inline void parallel_bfs_top_down_task(void *arg, size_t begin, size_t end, size_t worker)
+{
+    ParallelBFSContext *ctx = (ParallelBFSContext *)arg;
+    const CSRGraph *graph = ctx->graph;
+    ParallelGraphBuffer *out = &ctx->buffers[worker];
+    uint32_t next = ctx->level + 1;
+
+    for (size_t i = begin; i < end; i++)
+    {
+        csr_vertex_t u = ctx->frontier[i];
+        for (size_t e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+        {
+            csr_vertex_t v = graph->targets[e];
+            if (parallel_graph_bit_test(ctx->visited, v) || !parallel_graph_bit_claim(ctx->visited, v))
+                continue;
+            ctx->distance[v] = next;
+            parallel_graph_buffer_push(out, v);
+            out->edges += csr_graph_degree(graph, v);
+        }
+    }
+}
+
+// Let a range of unvisited vertices find a parent in the frontier (internal helper)
+static inline void parallel_bfs_bottom_up_task(void *arg, size_t begin, size_t end, size_t worker)
+{
+    ParallelBFSContext *ctx = (ParallelBFSContext *)arg;
+    const CSRGraph *in_edges = ctx->in_edges;
+    ParallelGraphBuffer *out = &ctx->buffers[worker];
+    uint32_t next = ctx->level + 1;
+
+    for (size_t v = begin; v < end; v++)
+    {
+        if (parallel_graph_bit_test(ctx->visited, (csr_vertex_t)v))
+            continue;
+        for (size_t e = in_edges->offsets[v]; e < in_edges->offsets[v + 1]; e++)
+        {
+            if (!parallel_graph_bit_test(ctx->frontier_bits, in_edges->targets[e]))
+                continue;
+            ctx->distance[v] = next;
+            parallel_graph_bit_claim(ctx->visited, (csr_vertex_t)v);
+            parallel_graph_bit_claim(ctx->next_bits, (csr_vertex_t)v);
+            parallel_graph_buffer_push(out, (csr_vertex_t)v);
+            out->edges += csr_graph_degree(ctx->graph, (csr_vertex_t)v);
+            break;
+        }
+    }
+}
+
+/**
+ * Direction-optimizing parallel breadth-first search
+ * @param graph: Target graph
+ * @param in_edges: Transpose of graph for bottom-up steps; NULL uses graph itself
+ *                  when it is undirected and disables bottom-up otherwise
+ * @param pool: Worker pool
+ * @param source: Start vertex
+ * @param distance: Receives hop count per vertex, CSR_GRAPH_UNREACHED if unreachable
+ * @return: Number of vertices reached
+ */
+static inline size_t csr_graph_parallel_bfs(const CSRGraph *graph, const CSRGraph *in_edges, ThreadPool *pool,
+                                            csr_vertex_t source, uint32_t *distance)
+{
+    size_t n = graph->vertex_count;
+    size_t workers = thread_pool_size(pool);
+    size_t words = (n + 63) / 64;
+    if (!in_edges && graph->undirected)
+        in_edges = graph;
+
+    ParallelBFSContext ctx;
+    ctx.graph = graph;
+    ctx.in_edges = in_edges;
+    ctx.distance = distance;
+    ctx.level = 0;
+    thread_pool_parallel_for(pool, 0, n, 0, parallel_bfs_reset_task, &ctx);
+    if (source >= n)
+        return 0;
+
+    ctx.visited = (uint64_t *)calloc(words, sizeof(uint64_t));
+    ctx.frontier_bits = (uint64_t *)calloc(words, sizeof(uint64_t));
+    ctx.next_bits = (uint64_t *)calloc(words, sizeof(uint64_t));
+    csr_vertex_t *frontier = (csr_vertex_t *)malloc(n * sizeof(csr_vertex_t));
+    if (!ctx.visited || !ctx.frontier_bits || !ctx.next_bits || !frontier)
+    {
+        fprintf(stderr, "csr_graph_parallel_bfs: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    ctx.buffers = parallel_graph_buffers_new(pool);
+
+    parallel_graph_bit_claim(ctx.visited, source);
+    distance[source] = 0;
+    frontier[0] = source;
+    size_t frontier_size = 1;
+    size_t frontier_edges = csr_graph_degree(graph, source);
+    size_t unexplored_edges = graph->edge_count - frontier_edges;
+    size_t reached = 1;
+    bool bottom_up = false;
+
+    while (frontier_size > 0)
+    {
+        // Beamer's heuristic: go bottom-up when scanning the frontier would cost more
+        if (!bottom_up && in_edges && frontier_edges > unexplored_edges / PARALLEL_BFS_ALPHA)
+        {
+            bottom_up = true;
+            memset(ctx.frontier_bits, 0, words * sizeof(uint64_t));
+            for (size_t i = 0; i < frontier_size; i++)
+                ctx.frontier_bits[frontier[i] >> 6] |= (uint64_t)1 << (frontier[i] & 63);
+        }
+        else if (bottom_up && frontier_size < n / PARALLEL_BFS_BETA)
+        {
+            bottom_up = false;
+        }
+
+        for (size_t w = 0; w < workers; w++)
+        {
+            ctx.buffers[w].size = 0;
+            ctx.buffers[w].edges = 0;
+        }
+        if (bottom_up)
+        {
+            memset(ctx.next_bits, 0, words * sizeof(uint64_t));
+            // Whole bitmap words per task so bit claims rarely share a line
+            size_t grain = ((n / (workers * THREAD_POOL_TASKS_PER_THREAD)) | 63) + 1;
+            thread_pool_parallel_for(pool, 0, n, grain, parallel_bfs_bottom_up_task, &ctx);
+            uint64_t *swap = ctx.frontier_bits;
+            ctx.frontier_bits = ctx.next_bits;
+            ctx.next_bits = swap;
+        }
+        else
+        {
+            ctx.frontier = frontier;
+            thread_pool_parallel_for(pool, 0, frontier_size, 0, parallel_bfs_top_down_task, &ctx);
+        }
+
+        // Concatenate per-worker buffers into the next frontier
+        frontier_size = 0;
+        frontier_edges = 0;
+        for (size_t w = 0; w < workers; w++)
+        {
+            if (ctx.buffers[w].size > 0)
+                memcpy(frontier + frontier_size, ctx.buffers[w].items, ctx.buffers[w].size * sizeof(csr_vertex_t));
+            frontier_size += ctx.buffers[w].size;
+            frontier_edges += ctx.buffers[w].edges;
+        }
+        unexplored_edges -= frontier_edges < unexplored_edges ? frontier_edges : unexplored_edges;
+        reached += frontier_size;
+        ctx.level++;
+    }
+
+    parallel_graph_buffers_free(ctx.buffers, workers);
+    free(frontier);
+    free(ctx.next_bits);
+    free(ctx.frontier_bits);
+    free(ctx.visited);
+    return reached;
+}
+
+// ==================== PARALLEL CONNECTED COMPONENTS ====================
+
+// Shared state of one Afforest run
+typedef struct ParallelCCContext
+{
+    const CSRGraph *graph;
+    unionfind_index_t *parent; // UnionFind parent array
+    size_t round;              // Neighbor linked in the current sampling round
+    unionfind_index_t skip;    // Root of the sampled giant component, -1 for none
+} ParallelCCContext;
+
+// Link each vertex with its round-th neighbor (internal helper)
+static inline void parallel_cc_link_round_task(void *arg, size_t begin, size_t end, size_t worker)
+{
+    (void)worker;
+    ParallelCCContext *ctx = (ParallelCCContext *)arg;
+    const CSRGraph *graph = ctx->graph;
+    for (size_t v = begin; v < end; v++)
+    {
+        size_t e = graph->offsets[v] + ctx->round;
+        if (e < graph->offsets[v + 1])
+            unionfind_union_concurrent(ctx->parent, (unionfind_index_t)v, graph->targets[e]);
+    }
+}
+
+// Point every vertex straight at its current root (internal helper)
+static inline void parallel_cc_compress_task(void *arg, size_t begin, size_t end, size_t worker)
+{
+    (void)worker;
+    ParallelCCContext *ctx = (ParallelCCContext *)arg;
+    for (size_t v = begin; v < end; v++)
+    {
+        unionfind_index_t root = unionfind_find_concurrent(ctx->parent, (unionfind_index_t)v);
+        if (root != (unionfind_index_t)v)
+            __atomic_store_n(&ctx->parent[v], root, __ATOMIC_RELAXED);
+    }
+}
+
+// Link the remaining edges of vertices outside the giant component (internal helper)
+static inline void parallel_cc_link_rest_task(void *arg, size_t begin, size_t end, size_t worker)
+{
+    (void)worker;
+    ParallelCCContext *ctx = (ParallelCCContext *)arg;
+    const CSRGraph *graph = ctx->graph;
+    for (size_t v = begin; v < end; v++)
+    {
+        if (ctx->skip >= 0 && unionfind_find_concurrent(ctx->parent, (unionfind_index_t)v) == ctx->skip)
+            continue;
+        for (size_t e = graph->offsets[v] + PARALLEL_CC_NEIGHBOR_ROUNDS; e < graph->offsets[v + 1]; e++)
+        {
+            unionfind_union_concurrent(ctx->parent, (unionfind_index_t)v, graph->targets[e]);
+        }
+    }
+}
+
+// Orders sampled roots (internal helper)
+static inline int parallel_cc_root_compare(const void *a, const void *b)
+{
+    unionfind_index_t x = *(const unionfind_index_t *)a;
+    unionfind_index_t y = *(const unionfind_index_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Pick the most frequent root among sampled vertices (internal helper)
+ * @param ctx: Afforest state after the sampling rounds
+ * @return: Root of the likely giant component
+ */
+static inline unionfind_index_t parallel_cc_sample_giant(const ParallelCCContext *ctx)
+{
+    size_t n = ctx->graph->vertex_count;
+    unionfind_index_t samples[PARALLEL_CC_SAMPLES];
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < PARALLEL_CC_SAMPLES; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        samples[i] = unionfind_find_concurrent(ctx->parent, (unionfind_index_t)(state % n));
+    }
+    qsort(samples, PARALLEL_CC_SAMPLES, sizeof(unionfind_index_t), parallel_cc_root_compare);
+
+    unionfind_index_t best = samples[0];
+    size_t best_run = 0, run = 0;
+    for (size_t i = 0; i < PARALLEL_CC_SAMPLES; i++)
+    {
+        run = (i > 0 && samples[i] == samples[i - 1]) ? run + 1 : 1;
+        if (run > best_run)
+        {
+            best_run = run;
+            best = samples[i];
+        }
+    }
+    return best;
+}
+
+/**
+ * Parallel connected components (weakly connected for directed graphs)
+ * @param graph: Target graph
+ * @param pool: Worker pool
+ * @param component: Receives label per vertex, same labels as csr_graph_connected_components
+ * @return: Number of components
+ */
+static inline size_t csr_graph_parallel_connected_components(const CSRGraph *graph, ThreadPool *pool,
+                                                             uint32_t *component)
+{
+    size_t n = graph->vertex_count;
+    UnionFind uf;
+    unionfind_init(&uf, (unionfind_index_t)n);
+    if (n == 0)
+    {
+        unionfind_free(&uf);
+        return 0;
+    }
+
+    ParallelCCContext ctx;
+    ctx.graph = graph;
+    ctx.parent = uf.parent;
+    ctx.skip = -1;
+    for (ctx.round = 0; ctx.round < PARALLEL_CC_NEIGHBOR_ROUNDS; ctx.round++)
+    {
+        thread_pool_parallel_for(pool, 0, n, 0, parallel_cc_link_round_task, &ctx);
+        thread_pool_parallel_for(pool, 0, n, 0, parallel_cc_compress_task, &ctx);
+    }
+
+    // Skipping is only sound when every edge is also seen from its other end
+    if (graph->undirected)
+        ctx.skip = parallel_cc_sample_giant(&ctx);
+    thread_pool_parallel_for(pool, 0, n, 0, parallel_cc_link_rest_task, &ctx);
+
+    unionfind_rebuild_sizes(&uf);
+    size_t labels = csr_graph_label_components(&uf, component);
+    unionfind_free(&uf);
+    return labels;
+}
+
+// ==================== PARALLEL PAGERANK ====================
+
+// Shared state of one PageRank run
+typedef struct ParallelPageRankContext
+{
+    const CSRGraph *graph;
+    const CSRGraph *in_edges;
+    const double *rank;           // Current ranks
+    double *next;                 // Ranks being computed
+    double *contribution;         // rank[u] / out-degree(u)
+    double base;                  // Teleport plus dangling share for this iteration
+    double damping;
+    ParallelGraphBuffer *buffers; // Per-worker partial sums
+} ParallelPageRankContext;
+
+// Spread each vertex's rank over its out-edges (internal helper)
+static inline void parallel_pagerank_contribute_task(void *arg, size_t begin, size_t end, size_t worker)
+{
+    ParallelPageRankContext *ctx = (ParallelPageRankContext *)arg;
+    double dangling = 0.0;
+    for (size_t u = begin; u < end; u++)
+    {
+        size_t degree = csr_graph_degree(ctx->graph, (csr_vertex_t)u);
+        if (degree == 0)
+        {
+            ctx->contribution[u] = 0.0;
+            dangling += ctx->rank[u];
+        }
+        else
+        {
+            ctx->contribution[u] = ctx->rank[u] / (double)degree;
+        }
+    }
+    ctx->buffers[worker].sum += dangling;
+}
+
+// Gather in-edge contributions into the next ranks (internal helper)
+static inline void parallel_pagerank_pull_task(void *arg, size_t begin, size_t end, size_t worker)
+{
+    ParallelPageRankContext *ctx = (ParallelPageRankContext *)arg;
+    const CSRGraph *in_edges = ctx->in_edges;
+    double error = 0.0;
+    for (size_t v = begin; v < end; v++)
+    {
+        double sum = 0.0;
+        for (size_t e = in_edges->offsets[v]; e < in_edges->offsets[v + 1]; e++)
+        {
+            sum += ctx->contribution[in_edges->targets[e]];
+        }
+        double value = ctx->base + ctx->damping * sum;
+        double change = value - ctx->rank[v];
+        error += change < 0 ? -change : change;
+        ctx->next[v] = value;
+    }
+    ctx->buffers[worker].error += error;
+}
+
+/**
+ * Parallel PageRank by power iteration
+ * @param graph: Target graph
+ * @param in_edges: Transpose of graph; NULL uses graph itself when undirected
+ *                  and builds a temporary transpose otherwise
+ * @param pool: Worker pool
+ * @param damping: Damping factor (PAGERANK_DEFAULT_DAMPING)
+ * @param tolerance: Stop when the L1 change of an iteration falls below this
+ * @param max_iterations: Iteration cap
+ * @param rank: Receives rank per vertex (sums to 1)
+ * @return: Number of iterations run
+ */
+static inline size_t csr_graph_parallel_pagerank(const CSRGraph *graph, const CSRGraph *in_edges, ThreadPool *pool,
+                                                 double damping, double tolerance, size_t max_iterations,
+                                                 double *rank)
+{
+    size_t n = graph->vertex_count;
+    if (n == 0)
+        return 0;
+
+    CSRGraph transpose;
+    bool owns_transpose = false;
+    if (!in_edges && graph->undirected)
+    {
+        in_edges = graph;
+    }
+    else if (!in_edges)
+    {
+        csr_graph_transpose(&transpose, graph);
+        in_edges = &transpose;
+        owns_transpose = true;
+    }
+
+    size_t workers = thread_pool_size(pool);
+    double *scratch = (double *)malloc(n * sizeof(double));
+    double *contribution = (double *)malloc(n * sizeof(double));
+    if (!scratch || !contribution)
+    {
+        fprintf(stderr, "csr_graph_parallel_pagerank: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t v = 0; v < n; v++)
+        rank[v] = 1.0 / (double)n;
+
+    ParallelPageRankContext ctx;
+    ctx.graph = graph;
+    ctx.in_edges = in_edges;
+    ctx.contribution = contribution;
+    ctx.damping = damping;
+    ctx.buffers = parallel_graph_buffers_new(pool);
+
+    double *current = rank;
+    double *next = scratch;
+    size_t iterations = 0;
+    while (iterations < max_iterations)
+    {
+        ctx.rank = current;
+        ctx.next = next;
+        for (size_t w = 0; w < workers; w++)
+        {
+            ctx.buffers[w].sum = 0.0;
+            ctx.buffers[w].error = 0.0;
+        }
+        thread_pool_parallel_for(pool, 0, n, 0, parallel_pagerank_contribute_task, &ctx);
+        double dangling = 0.0;
+        for (size_t w = 0; w < workers; w++)
+            dangling += ctx.buffers[w].sum;
+
+        // Dangling vertices link everywhere; teleport likewise
+        ctx.base = (1.0 - damping) / (double)n + damping * dangling / (double)n;
+        thread_pool_parallel_for(pool, 0, n, 0, parallel_pagerank_pull_task, &ctx);
+        double error = 0.0;
+        for (size_t w = 0; w < workers; w++)
+            error += ctx.buffers[w].error;
+
+        double *swap = current;
+        current = next;
+        next = swap;
+        iterations++;
+        if (error < tolerance)
+            break;
+    }
+
+    if (current != rank)
+        memcpy(rank, current, n * sizeof(double));
+    parallel_graph_buffers_free(ctx.buffers, workers);
+    free(contribution);
+    free(scratch);
+    if (owns_transpose)
+        csr_graph_free(&transpose);
+    return iterations;
+}
+
+#endif // PARALLEL_GRAPH_H
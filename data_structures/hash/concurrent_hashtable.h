@@ -0,0 +1,409 @@
+#ifndef CONCURRENT_HASHTABLE_H
+#define CONCURRENT_HASHTABLE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdalign.h>
+#include "hashtable.h"
+#include "../dynarray/dynarray.h"
+
+/**
+ * SHARDED CONCURRENT HASH TABLE
+ *
+ * Thread-safe map made of N independent HashTable shards. The shard for a key
+ * comes from the high bits of its (Fibonacci-mixed) full hash, so bucket
+ * selection inside the shard (low bits) stays independent of it. Operations on
+ * different shards never touch the same lock or cache line.
+ *
+ * Two modes:
+ * - CONCURRENT_HASHTABLE_RWLOCK: readers share a per-shard pthread rwlock,
+ *   writers take it exclusively. Plain HashTable code runs underneath.
+ * - CONCURRENT_HASHTABLE_SEQLOCK: read-mostly mode. Readers take no lock; they
+ *   traverse the chain and retry if the shard's sequence counter moved. Writers
+ *   still serialize on the shard lock, publish with release stores and never
+ *   free memory a reader might be walking: unlinked entries and replaced bucket
+ *   arrays are retired and released by concurrent_hashtable_reclaim() once no
+ *   reader is in flight (RCU-style grace period chosen by the caller), or by
+ *   concurrent_hashtable_free().
+ *
+ * Values are returned by pointer; the table does not synchronize the objects
+ * they point to. The HashFunction must return the full hash for SIZE_MAX.
+ *
+ * Time Complexities:
+ * - Insert/Search/Delete: O(1) average plus lock acquisition
+ * - Size: O(number of shards)
+ *
+ * Space Complexity: O(n + m) plus retired memory in seqlock mode
+ */
+
+// Configuration constants
+#define CONCURRENT_HASHTABLE_DEFAULT_SHARDS 16
+#define CONCURRENT_HASHTABLE_CACHE_LINE 64
+
+// Locking strategy for readers
+typedef enum ConcurrentHashTableMode {
+    CONCURRENT_HASHTABLE_RWLOCK,  // Readers share a rwlock
+    CONCURRENT_HASHTABLE_SEQLOCK  // Readers are lock-free and retry on conflict
+} ConcurrentHashTableMode;
+
+// One independently locked partition
+typedef struct ConcurrentHashShard {
+    alignas(CONCURRENT_HASHTABLE_CACHE_LINE) pthread_rwlock_t lock; // Writers always, readers in RWLOCK mode
+    atomic_uint sequence;     // SEQLOCK mode: odd while a writer is mutating
+    HashTable table;          // Entries of this shard
+    DynArray retired_entries; // SEQLOCK mode: unlinked HashEntry* awaiting reclaim
+    DynArray retired_buckets; // SEQLOCK mode: replaced bucket arrays awaiting reclaim
+} ConcurrentHashShard;
+
+// Sharded table
+typedef struct ConcurrentHashTable {
+    ConcurrentHashShard *shards;   // shard_count shards
+    size_t shard_count;            // Power of two
+    unsigned shard_shift;          // 64 - log2(shard_count)
+    ConcurrentHashTableMode mode;  // Reader strategy
+    const HashFunction *hash_func; // Shared by all shards
+} ConcurrentHashTable;
+
+// Lock-free loads/stores of pointers and counts that seqlock readers observe
+#define CONCURRENT_HASHTABLE_LOAD(lvalue) __atomic_load_n(&(lvalue), __ATOMIC_ACQUIRE)
+#define CONCURRENT_HASHTABLE_STORE(lvalue, value) __atomic_store_n(&(lvalue), (value), __ATOMIC_RELEASE)
+
+// ==================== SHARD HELPERS ====================
+
+/**
+ * Hint to the CPU that we are spinning (internal helper)
+ */
+static inline void concurrent_hashtable_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * Select shard from high bits of the mixed full hash (internal helper)
+ * @param table: Target table
+ * @param hash: Full hash of key
+ * @return: Owning shard
+ */
+static inline ConcurrentHashShard *concurrent_hashtable_shard(const ConcurrentHashTable *table, size_t hash) {
+    if (table->shard_count == 1) return &table->shards[0];
+    uint64_t mixed = (uint64_t)hash * 11400714819323198485ULL; // 2^64 / golden ratio
+    return &table->shards[mixed >> table->shard_shift];
+}
+
+/**
+ * Enter seqlock write section; shard lock must be held (internal helper)
+ * @param shard: Target shard
+ */
+static inline void concurrent_hashtable_write_begin(ConcurrentHashShard *shard) {
+    unsigned seq = atomic_load_explicit(&shard->sequence, memory_order_relaxed);
+    atomic_store_explicit(&shard->sequence, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+/**
+ * Leave seqlock write section (internal helper)
+ * @param shard: Target shard
+ */
+static inline void concurrent_hashtable_write_end(ConcurrentHashShard *shard) {
+    unsigned seq = atomic_load_explicit(&shard->sequence, memory_order_relaxed);
+    atomic_store_explicit(&shard->sequence, seq + 1, memory_order_release);
+}
+
+/**
+ * Grow shard buckets, retiring the old array for later reclaim (internal helper)
+ * Readers may be walking chains while entries are relinked; they notice via the
+ * sequence counter, and every pointer they follow stays valid memory.
+ * @param shard: Target shard in a seqlock write section
+ * @param new_capacity: New bucket count
+ */
+static inline void concurrent_hashtable_seqlock_grow(ConcurrentHashShard *shard, size_t new_capacity) {
+    HashTable *table = &shard->table;
+    HashEntry **new_buckets = (HashEntry **)calloc(new_capacity, sizeof(HashEntry *));
+    if (!new_buckets) {
+        fprintf(stderr, "concurrent_hashtable_seqlock_grow: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        HashEntry *entry = table->buckets[i];
+        while (entry) {
+            HashEntry *next = entry->next;
+            size_t index = entry->hash % new_capacity; // Cached, no re-hash
+            CONCURRENT_HASHTABLE_STORE(entry->next, new_buckets[index]);
+            new_buckets[index] = entry;
+            entry = next;
+        }
+    }
+
+    // Publish array before capacity: a reader seeing the new capacity sees the new array
+    dynarray_push(&shard->retired_buckets, table->buckets);
+    CONCURRENT_HASHTABLE_STORE(table->buckets, new_buckets);
+    CONCURRENT_HASHTABLE_STORE(table->capacity, new_capacity);
+}
+
+/**
+ * Free memory retired by seqlock writers; shard lock must be held (internal helper)
+ * @param shard: Target shard
+ */
+static inline void concurrent_hashtable_shard_reclaim(ConcurrentHashShard *shard) {
+    for (size_t i = 0; i < dynarray_size(&shard->retired_entries); i++) {
+        hashtable_free_entry((HashEntry *)dynarray_get(&shard->retired_entries, i),
+                             shard->table.hash_func, shard->table.allocator);
+    }
+    for (size_t i = 0; i < dynarray_size(&shard->retired_buckets); i++) {
+        free(dynarray_get(&shard->retired_buckets, i));
+    }
+    dynarray_clear(&shard->retired_entries);
+    dynarray_clear(&shard->retired_buckets);
+}
+
+// ==================== CORE OPERATIONS ====================
+
+/**
+ * Initialize sharded table
+ * @param table: Table to initialize
+ * @param shard_count: Number of shards (rounded up to a power of two, 0 uses default)
+ * @param initial_capacity: Starting bucket count per shard
+ * @param hash_func: Hash function to use
+ * @param mode: Reader locking strategy
+ */
+static inline void concurrent_hashtable_init(ConcurrentHashTable *table, size_t shard_count,
+                                             size_t initial_capacity, const HashFunction *hash_func,
+                                             ConcurrentHashTableMode mode) {
+    if (shard_count == 0) shard_count = CONCURRENT_HASHTABLE_DEFAULT_SHARDS;
+    size_t count = 1;
+    unsigned bits = 0;
+    while (count < shard_count) {
+        count <<= 1;
+        bits++;
+    }
+
+    table->shard_count = count;
+    table->shard_shift = 64 - bits;
+    table->mode = mode;
+    table->hash_func = hash_func;
+    table->shards = (ConcurrentHashShard *)aligned_alloc(CONCURRENT_HASHTABLE_CACHE_LINE,
+                                                         count * sizeof(ConcurrentHashShard));
+    if (!table->shards) {
+        fprintf(stderr, "concurrent_hashtable_init: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        ConcurrentHashShard *shard = &table->shards[i];
+        if (pthread_rwlock_init(&shard->lock, NULL) != 0) {
+            fprintf(stderr, "concurrent_hashtable_init: lock initialization failed\n");
+            exit(EXIT_FAILURE);
+        }
+        atomic_init(&shard->sequence, 0);
+        hashtable_init(&shard->table, initial_capacity, hash_func);
+        dynarray_init(&shard->retired_entries, 0);
+        dynarray_init(&shard->retired_buckets, 0);
+    }
+}
+
+/**
+ * Insert or update key-value pair
+ * @param table: Target table
+ * @param key: Key to insert/update (copied via hash_func->key_copy)
+ * @param value: Value to associate
+ * @return: true if successful
+ */
+static inline bool concurrent_hashtable_put(ConcurrentHashTable *table, const void *key, void *value) {
+    size_t hash = table->hash_func->hash(key, SIZE_MAX);
+    ConcurrentHashShard *shard = concurrent_hashtable_shard(table, hash);
+
+    if (table->mode == CONCURRENT_HASHTABLE_RWLOCK) {
+        pthread_rwlock_wrlock(&shard->lock);
+        bool ok = hashtable_put(&shard->table, key, value);
+        pthread_rwlock_unlock(&shard->lock);
+        return ok;
+    }
+
+    // Build the entry outside the lock; it is published fully initialized
+    HashEntry *entry = hashtable_create_entry(key, value, table->hash_func, shard->table.allocator);
+    if (!entry) return false;
+    entry->hash = hash;
+
+    pthread_rwlock_wrlock(&shard->lock);
+    HashTable *ht = &shard->table;
+    HashEntry *existing = hashtable_find_in_chain(ht, ht->buckets[hash % ht->capacity], key, hash);
+    if (existing) {
+        CONCURRENT_HASHTABLE_STORE(existing->value, value); // Single word, no section needed
+        pthread_rwlock_unlock(&shard->lock);
+        hashtable_free_entry(entry, table->hash_func, ht->allocator);
+        return true;
+    }
+
+    concurrent_hashtable_write_begin(shard);
+    if ((double)ht->size >= ht->load_factor_threshold * ht->capacity) {
+        concurrent_hashtable_seqlock_grow(shard, ht->capacity * HASHTABLE_GROWTH_FACTOR);
+    }
+    size_t index = hash % ht->capacity;
+    entry->next = ht->buckets[index];
+    CONCURRENT_HASHTABLE_STORE(ht->buckets[index], entry);
+    ht->size++;
+    concurrent_hashtable_write_end(shard);
+    pthread_rwlock_unlock(&shard->lock);
+    return true;
+}
+
+/**
+ * Retrieve value by key
+ * @param table: Target table
+ * @param key: Key to search for
+ * @return: Associated value or NULL if not found
+ */
+static inline void *concurrent_hashtable_get(ConcurrentHashTable *table, const void *key) {
+    size_t hash = table->hash_func->hash(key, SIZE_MAX);
+    ConcurrentHashShard *shard = concurrent_hashtable_shard(table, hash);
+
+    if (table->mode == CONCURRENT_HASHTABLE_RWLOCK) {
+        pthread_rwlock_rdlock(&shard->lock);
+        void *value = hashtable_lookup(&shard->table, key);
+        pthread_rwlock_unlock(&shard->lock);
+        return value;
+    }
+
+    HashTable *ht = &shard->table;
+    while (true) {
+        unsigned seq = atomic_load_explicit(&shard->sequence, memory_order_acquire);
+        if (seq & 1) { // Writer active
+            concurrent_hashtable_cpu_relax();
+            continue;
+        }
+
+        size_t capacity = CONCURRENT_HASHTABLE_LOAD(ht->capacity);
+        HashEntry **buckets = CONCURRENT_HASHTABLE_LOAD(ht->buckets);
+        HashEntry *entry = CONCURRENT_HASHTABLE_LOAD(buckets[hash % capacity]);
+        void *value = NULL;
+        bool torn = false;
+
+        while (entry) {
+            if (entry->hash == hash && table->hash_func->key_equals(entry->key, key)) {
+                value = CONCURRENT_HASHTABLE_LOAD(entry->value);
+                break;
+            }
+            entry = CONCURRENT_HASHTABLE_LOAD(entry->next);
+            // Chains may be relinked under us; bail out instead of wandering
+            if (atomic_load_explicit(&shard->sequence, memory_order_acquire) != seq) {
+                torn = true;
+                break;
+            }
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+        if (!torn && atomic_load_explicit(&shard->sequence, memory_order_relaxed) == seq) {
+            return value;
+        }
+    }
+}
+
+/**
+ * Remove key-value pair
+ * @param table: Target table
+ * @param key: Key to remove
+ * @return: true if key was found and removed
+ */
+static inline bool concurrent_hashtable_remove(ConcurrentHashTable *table, const void *key) {
+    size_t hash = table->hash_func->hash(key, SIZE_MAX);
+    ConcurrentHashShard *shard = concurrent_hashtable_shard(table, hash);
+    HashTable *ht = &shard->table;
+
+    pthread_rwlock_wrlock(&shard->lock);
+    if (table->mode == CONCURRENT_HASHTABLE_RWLOCK) {
+        bool removed = hashtable_remove(ht, key);
+        pthread_rwlock_unlock(&shard->lock);
+        return removed;
+    }
+
+    size_t index = hash % ht->capacity;
+    HashEntry *current = ht->buckets[index];
+    HashEntry *prev = NULL;
+    while (current && !(current->hash == hash && table->hash_func->key_equals(current->key, key))) {
+        prev = current;
+        current = current->next;
+    }
+
+    if (current) {
+        concurrent_hashtable_write_begin(shard);
+        if (prev) {
+            CONCURRENT_HASHTABLE_STORE(prev->next, current->next);
+        } else {
+            CONCURRENT_HASHTABLE_STORE(ht->buckets[index], current->next);
+        }
+        ht->size--;
+        concurrent_hashtable_write_end(shard);
+        dynarray_push(&shard->retired_entries, current); // Readers may still hold it
+    }
+    pthread_rwlock_unlock(&shard->lock);
+    return current != NULL;
+}
+
+/**
+ * Check if key exists
+ * @param table: Target table
+ * @param key: Key to check
+ * @return: true if key exists
+ */
+static inline bool concurrent_hashtable_contains(ConcurrentHashTable *table, const void *key) {
+    return concurrent_hashtable_get(table, key) != NULL;
+}
+
+/**
+ * Get total size (each shard is read consistently, the sum is a snapshot)
+ * @param table: Target table
+ * @return: Number of key-value pairs
+ */
+static inline size_t concurrent_hashtable_size(ConcurrentHashTable *table) {
+    size_t total = 0;
+    for (size_t i = 0; i < table->shard_count; i++) {
+        ConcurrentHashShard *shard = &table->shards[i];
+        pthread_rwlock_rdlock(&shard->lock);
+        total += shard->table.size;
+        pthread_rwlock_unlock(&shard->lock);
+    }
+    return total;
+}
+
+/**
+ * Release memory retired by seqlock writers
+ * Caller guarantees no concurrent_hashtable_get is in flight (a grace period);
+ * writers may keep running. No-op in RWLOCK mode.
+ * @param table: Target table
+ * @return: Number of entries reclaimed
+ */
+static inline size_t concurrent_hashtable_reclaim(ConcurrentHashTable *table) {
+    size_t reclaimed = 0;
+    for (size_t i = 0; i < table->shard_count; i++) {
+        ConcurrentHashShard *shard = &table->shards[i];
+        pthread_rwlock_wrlock(&shard->lock);
+        reclaimed += dynarray_size(&shard->retired_entries);
+        concurrent_hashtable_shard_reclaim(shard);
+        pthread_rwlock_unlock(&shard->lock);
+    }
+    return reclaimed;
+}
+
+/**
+ * Free all memory (no other thread may be using the table)
+ * @param table: Table to free
+ */
+static inline void concurrent_hashtable_free(ConcurrentHashTable *table) {
+    for (size_t i = 0; i < table->shard_count; i++) {
+        ConcurrentHashShard *shard = &table->shards[i];
+        concurrent_hashtable_shard_reclaim(shard);
+        dynarray_free(&shard->retired_entries);
+        dynarray_free(&shard->retired_buckets);
+        hashtable_free(&shard->table);
+        pthread_rwlock_destroy(&shard->lock);
+    }
+    free(table->shards);
+    table->shards = NULL;
+    table->shard_count = 0;
+}
+
+#endif // CONCURRENT_HASHTABLE_H
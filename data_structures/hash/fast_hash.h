@@ -0,0 +1,283 @@
+#ifndef FAST_HASH_H
+#define FAST_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * FAST BYTE HASHING
+ *
+ * wyhash-style hash that consumes 8-16 bytes per step instead of djb2's one
+ * byte per iteration. Inputs longer than FAST_HASH_STRIPE_LEN bytes are folded
+ * through an xxh3-style 8-lane accumulator with SIMD paths:
+ * - AVX2:  two 256-bit lanes per 64-byte stripe
+ * - SSE2:  four 128-bit lanes per stripe
+ * - NEON:  four 128-bit lanes per stripe
+ * - Scalar fallback (define FAST_HASH_NO_SIMD to force it)
+ *
+ * Every path (including the no-__int128 multiply) computes identical values,
+ * so hashes are stable across builds on the same endianness.
+ *
+ * Time Complexity: O(len)
+ */
+
+#if !defined(FAST_HASH_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define FAST_HASH_AVX2 1
+#elif !defined(FAST_HASH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define FAST_HASH_SSE2 1
+#elif !defined(FAST_HASH_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define FAST_HASH_NEON 1
+#endif
+
+// Configuration constants
+#define FAST_HASH_STRIPE_LEN 64 // Bytes per accumulator round
+#define FAST_HASH_SEED 0x2d358dccaa6c78a5ULL
+
+// Secrets (wyhash v4 primes)
+#define FAST_HASH_P0 0xa0761d6478bd642fULL
+#define FAST_HASH_P1 0xe7037ed1a0b428dbULL
+#define FAST_HASH_P2 0x8ebc6af09c88c6e3ULL
+#define FAST_HASH_P3 0x589965cc75374cc3ULL
+
+// Per-lane keys for the stripe accumulator
+static const uint64_t FAST_HASH_STRIPE_KEYS[8] = {
+    FAST_HASH_P0, FAST_HASH_P1, FAST_HASH_P2, FAST_HASH_P3,
+    FAST_HASH_P0 ^ FAST_HASH_P3, FAST_HASH_P1 ^ FAST_HASH_P2,
+    FAST_HASH_P2 ^ FAST_HASH_P1, FAST_HASH_P3 ^ FAST_HASH_P0};
+
+// ==================== PRIMITIVES ====================
+
+/**
+ * Unaligned little-endian loads
+ * @param p: Input
+ * @return: Loaded word
+ */
+static inline uint64_t fast_hash_read64(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t fast_hash_read32(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * Read 1-3 bytes spread over the input (wyhash short-key trick)
+ * @param p: Input
+ * @param k: Length (1..3)
+ * @return: Packed bytes
+ */
+static inline uint64_t fast_hash_read_small(const unsigned char *p, size_t k) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+/**
+ * 64x64 -> 128 multiply in place (a = low half, b = high half)
+ * @param a, b: Operands, overwritten with the product
+ */
+static inline void fast_hash_mul128(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+/**
+ * 64x64 -> 128 multiply folded to 64 bits (lo ^ hi)
+ * @param a, b: Operands
+ * @return: Mixed product
+ */
+static inline uint64_t fast_hash_mix(uint64_t a, uint64_t b) {
+    fast_hash_mul128(&a, &b);
+    return a ^ b;
+}
+
+// ==================== STRIPE ACCUMULATOR ====================
+
+/**
+ * Accumulate full 64-byte stripes, portable reference version
+ * @param acc: 8-lane accumulator
+ * @param p: Input
+ * @param stripes: Number of 64-byte stripes
+ */
+static inline void fast_hash_accumulate_scalar(uint64_t acc[8], const unsigned char *p, size_t stripes) {
+    for (size_t s = 0; s < stripes; s++, p += FAST_HASH_STRIPE_LEN) {
+        for (int j = 0; j < 8; j++) {
+            uint64_t data = fast_hash_read64(p + 8 * j);
+            uint64_t key = data ^ FAST_HASH_STRIPE_KEYS[j];
+            acc[j ^ 1] += data;
+            acc[j] += (key & 0xFFFFFFFFULL) * (key >> 32);
+        }
+    }
+}
+
+/**
+ * Accumulate full 64-byte stripes using the widest available SIMD unit
+ * @param acc: 8-lane accumulator
+ * @param p: Input
+ * @param stripes: Number of 64-byte stripes
+ */
+static inline void fast_hash_accumulate(uint64_t acc[8], const unsigned char *p, size_t stripes) {
+#if defined(FAST_HASH_AVX2)
+    __m256i va[2], vk[2];
+    for (int i = 0; i < 2; i++) {
+        va[i] = _mm256_loadu_si256((const __m256i *)(const void *)(acc + 4 * i));
+        vk[i] = _mm256_loadu_si256((const __m256i *)(const void *)(FAST_HASH_STRIPE_KEYS + 4 * i));
+    }
+    for (size_t s = 0; s < stripes; s++, p += FAST_HASH_STRIPE_LEN) {
+        for (int i = 0; i < 2; i++) {
+            __m256i data = _mm256_loadu_si256((const __m256i *)(const void *)(p + 32 * i));
+            __m256i key = _mm256_xor_si256(data, vk[i]);
+            __m256i key_hi = _mm256_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1));
+            __m256i product = _mm256_mul_epu32(key, key_hi);
+            __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            va[i] = _mm256_add_epi64(va[i], _mm256_add_epi64(swapped, product));
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        _mm256_storeu_si256((__m256i *)(void *)(acc + 4 * i), va[i]);
+    }
+#elif defined(FAST_HASH_SSE2)
+    __m128i va[4], vk[4];
+    for (int i = 0; i < 4; i++) {
+        va[i] = _mm_loadu_si128((const __m128i *)(const void *)(acc + 2 * i));
+        vk[i] = _mm_loadu_si128((const __m128i *)(const void *)(FAST_HASH_STRIPE_KEYS + 2 * i));
+    }
+    for (size_t s = 0; s < stripes; s++, p += FAST_HASH_STRIPE_LEN) {
+        for (int i = 0; i < 4; i++) {
+            __m128i data = _mm_loadu_si128((const __m128i *)(const void *)(p + 16 * i));
+            __m128i key = _mm_xor_si128(data, vk[i]);
+            __m128i key_hi = _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1));
+            __m128i product = _mm_mul_epu32(key, key_hi);
+            __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            va[i] = _mm_add_epi64(va[i], _mm_add_epi64(swapped, product));
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        _mm_storeu_si128((__m128i *)(void *)(acc + 2 * i), va[i]);
+    }
+#elif defined(FAST_HASH_NEON)
+    uint64x2_t va[4], vk[4];
+    for (int i = 0; i < 4; i++) {
+        va[i] = vld1q_u64(acc + 2 * i);
+        vk[i] = vld1q_u64(FAST_HASH_STRIPE_KEYS + 2 * i);
+    }
+    for (size_t s = 0; s < stripes; s++, p += FAST_HASH_STRIPE_LEN) {
+        for (int i = 0; i < 4; i++) {
+            uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(p + 16 * i));
+            uint64x2_t key = veorq_u64(data, vk[i]);
+            uint64x2_t product = vmull_u32(vmovn_u64(key), vshrn_n_u64(key, 32));
+            uint64x2_t swapped = vextq_u64(data, data, 1);
+            va[i] = vaddq_u64(va[i], vaddq_u64(swapped, product));
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        vst1q_u64(acc + 2 * i, va[i]);
+    }
+#else
+    fast_hash_accumulate_scalar(acc, p, stripes);
+#endif
+}
+
+// ==================== HASH ====================
+
+/**
+ * Hash arbitrary bytes
+ * @param data: Input bytes
+ * @param len: Input length
+ * @param seed: Seed value
+ * @return: 64-bit hash
+ */
+static inline uint64_t fast_hash_bytes(const void *data, size_t len, uint64_t seed) {
+    const unsigned char *p = (const unsigned char *)data;
+    uint64_t a, b;
+    seed ^= fast_hash_mix(seed ^ FAST_HASH_P0, FAST_HASH_P1);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t shift = (len >> 3) << 2;
+            a = (fast_hash_read32(p) << 32) | fast_hash_read32(p + shift);
+            b = (fast_hash_read32(p + len - 4) << 32) | fast_hash_read32(p + len - 4 - shift);
+        } else if (len > 0) {
+            a = fast_hash_read_small(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t remaining = len;
+
+        // Long input: fold whole stripes through the SIMD accumulator
+        if (remaining > FAST_HASH_STRIPE_LEN) {
+            uint64_t acc[8];
+            for (int j = 0; j < 8; j++) acc[j] = FAST_HASH_STRIPE_KEYS[j] ^ seed;
+
+            size_t stripes = (remaining - 1) / FAST_HASH_STRIPE_LEN; // Keep a non-empty tail
+            fast_hash_accumulate(acc, p, stripes);
+            p += stripes * FAST_HASH_STRIPE_LEN;
+            remaining -= stripes * FAST_HASH_STRIPE_LEN;
+
+            seed ^= fast_hash_mix(acc[0] ^ FAST_HASH_P0, acc[1] ^ FAST_HASH_P1) ^
+                    fast_hash_mix(acc[2] ^ FAST_HASH_P2, acc[3] ^ FAST_HASH_P3) ^
+                    fast_hash_mix(acc[4] ^ FAST_HASH_P1, acc[5] ^ FAST_HASH_P2) ^
+                    fast_hash_mix(acc[6] ^ FAST_HASH_P3, acc[7] ^ FAST_HASH_P0);
+        }
+
+        // Tail (17..64 bytes, or whole short input): 16 bytes per round
+        while (remaining > 16) {
+            seed = fast_hash_mix(fast_hash_read64(p) ^ FAST_HASH_P1, fast_hash_read64(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        a = fast_hash_read64(p + remaining - 16);
+        b = fast_hash_read64(p + remaining - 8);
+    }
+
+    a ^= FAST_HASH_P1;
+    b ^= seed;
+    fast_hash_mul128(&a, &b);
+    return fast_hash_mix(a ^ FAST_HASH_P0 ^ len, b ^ FAST_HASH_P1);
+}
+
+/**
+ * Hash NUL-terminated string
+ * @param str: String to hash
+ * @return: 64-bit hash
+ */
+static inline uint64_t fast_hash_string(const char *str) {
+    return fast_hash_bytes(str, strlen(str), FAST_HASH_SEED);
+}
+
+/**
+ * Name of the accumulator path selected at compile time
+ * @return: "avx2", "sse2", "neon" or "scalar"
+ */
+static inline const char *fast_hash_simd_path(void) {
+#if defined(FAST_HASH_AVX2)
+    return "avx2";
+#elif defined(FAST_HASH_SSE2)
+    return "sse2";
+#elif defined(FAST_HASH_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+#endif // FAST_HASH_H
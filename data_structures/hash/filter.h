@@ -0,0 +1,677 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include "hashset.h"
+#include "fast_hash.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * PROBABILISTIC MEMBERSHIP FILTERS
+ *
+ * Compact key sets that answer "definitely absent" or "maybe present" from a
+ * key's 64-bit hash, so lookups for missing keys can skip the table behind
+ * them. Both filters are sized from an expected key count and a target
+ * false-positive rate, and never report an added key as absent.
+ * - BloomFilter: blocked Bloom filter. All bits of a key live in one 64-byte
+ *   block, so a query reads exactly one cache line. No deletion.
+ * - CuckooFilter: buckets of four 4..16-bit fingerprints with partial-key
+ *   cuckoo hashing. Deletes keys that were added; a query reads two 8-byte
+ *   buckets, issued together.
+ * - FilteredHashTable / FilteredHashSet: a HashTable behind a CuckooFilter.
+ *   Keys are hashed once, and a miss the filter rejects never reads the
+ *   bucket array or walks a chain.
+ *
+ * Hashes are remixed before use, so weak table hashes (hash_int) are fine.
+ *
+ * Time Complexities:
+ * - Bloom add / query: O(1), one block
+ * - Cuckoo query / delete: O(1); insert: O(1) expected (bounded kicks)
+ *
+ * Space Complexity: Bloom ~1.73 log2(1/fp) bits per key (blocking adds a fifth), cuckoo
+ * (log2(1/fp) + 3) / 0.95 bits per key
+ */
+
+// Configuration constants
+#define FILTER_DEFAULT_FP_RATE 0.01 // Used when the requested rate is not in (0, 1)
+#define BLOOM_FILTER_BLOCK_WORDS 8  // 8 x 64 bits = one cache line per block
+#define BLOOM_FILTER_BLOCK_BYTES (BLOOM_FILTER_BLOCK_WORDS * sizeof(uint64_t))
+#define BLOOM_FILTER_MAX_HASHES 16
+#define CUCKOO_FILTER_BUCKET_SLOTS 4 // 16-bit fingerprint lanes of one uint64_t
+#define CUCKOO_FILTER_LOAD_PERCENT 95 // Sizing target; inserts fail a little above it
+#define CUCKOO_FILTER_MAX_KICKS 500
+
+// Per-bit multipliers: bit i of a key is the top 9 bits of hash * salt[i] within its block
+static const uint64_t BLOOM_FILTER_SALTS[BLOOM_FILTER_MAX_HASHES] = {
+    0xbe0ae8fa1ceac2cdULL, 0x8bb01460217f871dULL, 0xb64ba4fd98e616edULL, 0x39f5c88e2d94628bULL,
+    0xa34faab921eb4e09ULL, 0xc37f0ce876cf29a7ULL, 0x35fef5876ae5bc09ULL, 0x24f1e3cd369cbd3fULL,
+    0x29b21b6c6444f53bULL, 0xf488c78dd79e9be5ULL, 0x9b3d2f10218feaa7ULL, 0x3383ac783005a659ULL,
+    0x68311de3071daa8dULL, 0x11cda0b83d693da9ULL, 0x6b9ee2b31850f2abULL, 0xe5db963bfc17ebbfULL};
+
+// Blocked Bloom filter structure
+typedef struct BloomFilter {
+    uint64_t *blocks;   // block_count blocks of BLOOM_FILTER_BLOCK_WORDS, cache-line aligned
+    size_t block_count;
+    unsigned hashes;    // Bits set per key
+    size_t count;       // Keys added (repeats included)
+    size_t capacity;    // Keys it was sized for; past this the rate degrades
+} BloomFilter;
+
+// Cuckoo filter structure
+typedef struct CuckooFilter {
+    uint64_t *buckets;    // bucket_count buckets of 4 fingerprint lanes (0 = empty)
+    size_t bucket_count;  // Power of two
+    size_t count;         // Fingerprints stored, the victim included
+    uint16_t fingerprint_mask;
+    bool has_victim;      // A fingerprint evicted by a failed insert waits here (filter is full)
+    uint16_t victim;
+    size_t victim_index;
+    uint64_t rng;         // xorshift64 state for kick choices
+} CuckooFilter;
+
+// HashTable with a cuckoo filter of its keys in front
+typedef struct FilteredHashTable {
+    HashTable table;
+    CuckooFilter filter; // Holds exactly the table's keys
+    double fp_rate;      // Kept for rebuilds when the filter fills up
+} FilteredHashTable;
+
+// A filtered set is a filtered table with HASHSET_DUMMY_VALUE values (like HashSet)
+typedef FilteredHashTable FilteredHashSet;
+
+// ==================== SIZING HELPERS ====================
+
+/**
+ * Natural logarithm for x >= 1, without libm (internal helper)
+ * @param x: Argument
+ * @return: ln(x)
+ */
+static inline double filter_log(double x) {
+    const double ln2 = 0.69314718055994530942;
+    int exponent = 0;
+    while (x >= 2.0) {
+        x /= 2.0;
+        exponent++;
+    }
+    // ln(x) = 2 atanh((x - 1) / (x + 1)), |z| <= 1/3 on [1, 2)
+    double z = (x - 1.0) / (x + 1.0), z2 = z * z, term = z, sum = 0.0;
+    for (int i = 1; i < 40; i += 2) {
+        sum += term / i;
+        term *= z2;
+    }
+    return exponent * ln2 + 2.0 * sum;
+}
+
+/**
+ * Requested false-positive rate, or the default if out of range (internal helper)
+ * @param fp_rate: Requested rate
+ * @return: Rate in (0, 1)
+ */
+static inline double filter_fp_rate(double fp_rate) {
+    return fp_rate > 0.0 && fp_rate < 1.0 ? fp_rate : FILTER_DEFAULT_FP_RATE;
+}
+
+/**
+ * Spread a table hash over all 64 bits (internal helper)
+ * @param hash: Key hash
+ * @return: Remixed hash
+ */
+static inline uint64_t filter_remix(uint64_t hash) {
+    return fast_hash_mix(hash ^ FAST_HASH_P0, FAST_HASH_P1);
+}
+
+// ==================== BLOOM FILTER ====================
+
+/**
+ * Initialize blocked Bloom filter
+ * @param filter: Filter to initialize
+ * @param expected: Number of keys it is sized for
+ * @param fp_rate: Target false-positive rate at that size (outside (0, 1) = default)
+ */
+static inline void bloom_filter_init(BloomFilter *filter, size_t expected, double fp_rate) {
+    const double ln2 = 0.69314718055994530942;
+    double bits_per_key = filter_log(1.0 / filter_fp_rate(fp_rate)) / (ln2 * ln2);
+    unsigned hashes = (unsigned)(bits_per_key * ln2 + 0.5);
+    filter->hashes = hashes < 1 ? 1 : hashes > BLOOM_FILTER_MAX_HASHES ? BLOOM_FILTER_MAX_HASHES : hashes;
+
+    // Keys cluster unevenly over blocks; a fifth more bits makes up for it
+    double bits = (double)(expected > 0 ? expected : 1) * bits_per_key * 1.2;
+    filter->block_count = (size_t)(bits / (BLOOM_FILTER_BLOCK_BYTES * 8)) + 1;
+    filter->blocks = (uint64_t *)aligned_alloc(BLOOM_FILTER_BLOCK_BYTES, filter->block_count * BLOOM_FILTER_BLOCK_BYTES);
+    if (!filter->blocks) {
+        fprintf(stderr, "bloom_filter_init: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(filter->blocks, 0, filter->block_count * BLOOM_FILTER_BLOCK_BYTES);
+    filter->count = 0;
+    filter->capacity = expected;
+}
+
+/**
+ * Block of a remixed hash and the bits to test in each of its words (internal helper)
+ * @param filter: Target filter
+ * @param mixed: Remixed key hash
+ * @param masks: Receives one mask per block word
+ * @return: First word of the block
+ */
+static inline uint64_t *bloom_filter_masks(const BloomFilter *filter, uint64_t mixed,
+                                           uint64_t masks[BLOOM_FILTER_BLOCK_WORDS]) {
+    size_t block = (size_t)(((mixed >> 32) * (uint64_t)filter->block_count) >> 32);
+    for (unsigned w = 0; w < BLOOM_FILTER_BLOCK_WORDS; w++) masks[w] = 0;
+    for (unsigned i = 0; i < filter->hashes; i++) {
+        unsigned bit = (unsigned)((mixed * BLOOM_FILTER_SALTS[i]) >> 55); // 0..511
+        masks[bit / 64] |= 1ULL << (bit % 64);
+    }
+    return filter->blocks + block * BLOOM_FILTER_BLOCK_WORDS;
+}
+
+/**
+ * Add key by hash
+ * @param filter: Target filter
+ * @param hash: Key hash (any 64-bit hash of the key)
+ */
+static inline void bloom_filter_add_hash(BloomFilter *filter, uint64_t hash) {
+    uint64_t masks[BLOOM_FILTER_BLOCK_WORDS];
+    uint64_t *block = bloom_filter_masks(filter, filter_remix(hash), masks);
+    for (unsigned w = 0; w < BLOOM_FILTER_BLOCK_WORDS; w++) block[w] |= masks[w];
+    filter->count++;
+}
+
+/**
+ * Test key by hash (one cache line)
+ * @param filter: Target filter
+ * @param hash: Key hash, same function as when added
+ * @return: false if the key was never added, true if it probably was
+ */
+static inline bool bloom_filter_may_contain_hash(const BloomFilter *filter, uint64_t hash) {
+    uint64_t masks[BLOOM_FILTER_BLOCK_WORDS];
+    const uint64_t *block = bloom_filter_masks(filter, filter_remix(hash), masks);
+    uint64_t missing = 0;
+    for (unsigned w = 0; w < BLOOM_FILTER_BLOCK_WORDS; w++) missing |= masks[w] & ~block[w];
+    return missing == 0;
+}
+
+/**
+ * Add string key
+ * @param filter: Target filter
+ * @param key: NUL-terminated string
+ */
+static inline void bloom_filter_add_string(BloomFilter *filter, const char *key) {
+    bloom_filter_add_hash(filter, fast_hash_string(key));
+}
+
+/**
+ * Test string key
+ * @param filter: Target filter
+ * @param key: NUL-terminated string
+ * @return: false if the key was never added, true if it probably was
+ */
+static inline bool bloom_filter_may_contain_string(const BloomFilter *filter, const char *key) {
+    return bloom_filter_may_contain_hash(filter, fast_hash_string(key));
+}
+
+/**
+ * Remove every key
+ * @param filter: Target filter
+ */
+static inline void bloom_filter_clear(BloomFilter *filter) {
+    memset(filter->blocks, 0, filter->block_count * BLOOM_FILTER_BLOCK_BYTES);
+    filter->count = 0;
+}
+
+/**
+ * Filter memory in bytes
+ * @param filter: Target filter
+ * @return: Bytes of bit storage
+ */
+static inline size_t bloom_filter_bytes(const BloomFilter *filter) {
+    return filter->block_count * BLOOM_FILTER_BLOCK_BYTES;
+}
+
+/**
+ * Free filter memory
+ * @param filter: Filter to free
+ */
+static inline void bloom_filter_free(BloomFilter *filter) {
+    free(filter->blocks);
+    filter->blocks = NULL;
+    filter->block_count = 0;
+    filter->count = 0;
+    filter->capacity = 0;
+}
+
+// ==================== CUCKOO FILTER ====================
+
+/**
+ * Initialize cuckoo filter
+ * @param filter: Filter to initialize
+ * @param expected: Number of keys it is sized for
+ * @param fp_rate: Target false-positive rate (outside (0, 1) = default; floor ~1.2e-4)
+ */
+static inline void cuckoo_filter_init(CuckooFilter *filter, size_t expected, double fp_rate) {
+    // A query compares against 2 buckets x 4 lanes: fp ~= 8 / 2^bits
+    double target = 2.0 * CUCKOO_FILTER_BUCKET_SLOTS / filter_fp_rate(fp_rate);
+    unsigned bits = 4;
+    while (bits < 16 && (double)(1u << bits) < target) bits++;
+    filter->fingerprint_mask = (uint16_t)((1u << bits) - 1);
+
+    size_t slots = (expected * 100 + CUCKOO_FILTER_LOAD_PERCENT - 1) / CUCKOO_FILTER_LOAD_PERCENT;
+    size_t buckets = 1;
+    while (buckets * CUCKOO_FILTER_BUCKET_SLOTS < slots) buckets *= 2;
+    filter->buckets = (uint64_t *)calloc(buckets, sizeof(uint64_t));
+    if (!filter->buckets) {
+        fprintf(stderr, "cuckoo_filter_init: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    filter->bucket_count = buckets;
+    filter->count = 0;
+    filter->has_victim = false;
+    filter->victim = 0;
+    filter->victim_index = 0;
+    filter->rng = FAST_HASH_SEED;
+}
+
+/**
+ * Fingerprint and primary bucket of a remixed hash (internal helper)
+ * @param filter: Target filter
+ * @param mixed: Remixed key hash
+ * @param index: Receives the primary bucket
+ * @return: Non-zero fingerprint
+ */
+static inline uint16_t cuckoo_filter_fingerprint(const CuckooFilter *filter, uint64_t mixed, size_t *index) {
+    uint16_t fingerprint = (uint16_t)(mixed & filter->fingerprint_mask);
+    *index = (size_t)(mixed >> 32) & (filter->bucket_count - 1);
+    return fingerprint ? fingerprint : 1;
+}
+
+/**
+ * Other bucket of a fingerprint; applying it twice gives back index (internal helper)
+ * @param filter: Target filter
+ * @param index: One bucket of the fingerprint
+ * @param fingerprint: Fingerprint
+ * @return: The other bucket
+ */
+static inline size_t cuckoo_filter_alt_index(const CuckooFilter *filter, size_t index, uint16_t fingerprint) {
+    return (index ^ (size_t)(fingerprint * 0x5bd1e995u)) & (filter->bucket_count - 1);
+}
+
+/**
+ * Does a bucket hold a fingerprint (SWAR compare of all 4 lanes, internal helper)
+ * @param bucket: Bucket word
+ * @param fingerprint: Fingerprint
+ * @return: true if some lane equals fingerprint
+ */
+static inline bool cuckoo_filter_bucket_has(uint64_t bucket, uint16_t fingerprint) {
+    uint64_t v = bucket ^ (fingerprint * 0x0001000100010001ULL);
+    return ((v - 0x0001000100010001ULL) & ~v & 0x8000800080008000ULL) != 0;
+}
+
+/**
+ * Put fingerprint in a free lane of a bucket (internal helper)
+ * @param filter: Target filter
+ * @param index: Bucket
+ * @param fingerprint: Fingerprint
+ * @return: true if the bucket had a free lane
+ */
+static inline bool cuckoo_filter_bucket_put(CuckooFilter *filter, size_t index, uint16_t fingerprint) {
+    uint64_t bucket = filter->buckets[index];
+    for (unsigned lane = 0; lane < CUCKOO_FILTER_BUCKET_SLOTS; lane++) {
+        if (((bucket >> (16 * lane)) & 0xFFFF) == 0) {
+            filter->buckets[index] = bucket | (uint64_t)fingerprint << (16 * lane);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Clear one lane holding fingerprint (internal helper)
+ * @param filter: Target filter
+ * @param index: Bucket
+ * @param fingerprint: Fingerprint
+ * @return: true if found and cleared
+ */
+static inline bool cuckoo_filter_bucket_take(CuckooFilter *filter, size_t index, uint16_t fingerprint) {
+    uint64_t bucket = filter->buckets[index];
+    for (unsigned lane = 0; lane < CUCKOO_FILTER_BUCKET_SLOTS; lane++) {
+        if (((bucket >> (16 * lane)) & 0xFFFF) == fingerprint) {
+            filter->buckets[index] = bucket & ~(0xFFFFULL << (16 * lane));
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Place fingerprint by evicting random residents to their other bucket; after
+ * CUCKOO_FILTER_MAX_KICKS the last evicted fingerprint becomes the victim (internal helper)
+ * @param filter: Target filter
+ * @param index: Full bucket to start from
+ * @param fingerprint: Fingerprint to place
+ */
+static inline void cuckoo_filter_relocate(CuckooFilter *filter, size_t index, uint16_t fingerprint) {
+    for (int kick = 0; kick < CUCKOO_FILTER_MAX_KICKS; kick++) {
+        filter->rng ^= filter->rng << 13;
+        filter->rng ^= filter->rng >> 7;
+        filter->rng ^= filter->rng << 17;
+        unsigned shift = 16 * (unsigned)(filter->rng % CUCKOO_FILTER_BUCKET_SLOTS);
+        uint16_t evicted = (uint16_t)(filter->buckets[index] >> shift);
+        filter->buckets[index] = (filter->buckets[index] & ~(0xFFFFULL << shift)) | (uint64_t)fingerprint << shift;
+        fingerprint = evicted;
+        index = cuckoo_filter_alt_index(filter, index, fingerprint);
+        if (cuckoo_filter_bucket_put(filter, index, fingerprint)) return;
+    }
+    filter->has_victim = true;
+    filter->victim = fingerprint;
+    filter->victim_index = index;
+}
+
+/**
+ * Add key by hash
+ * @param filter: Target filter
+ * @param hash: Key hash (any 64-bit hash of the key)
+ * @return: true if added, false if the filter is full (nothing changed)
+ */
+static inline bool cuckoo_filter_add_hash(CuckooFilter *filter, uint64_t hash) {
+    if (filter->has_victim) return false;
+    size_t index;
+    uint16_t fingerprint = cuckoo_filter_fingerprint(filter, filter_remix(hash), &index);
+    size_t alt = cuckoo_filter_alt_index(filter, index, fingerprint);
+    filter->count++;
+    if (cuckoo_filter_bucket_put(filter, index, fingerprint) || cuckoo_filter_bucket_put(filter, alt, fingerprint)) {
+        return true;
+    }
+    cuckoo_filter_relocate(filter, (filter->rng & 1) ? index : alt, fingerprint);
+    return true;
+}
+
+/**
+ * Test key by hash (both buckets loaded independently)
+ * @param filter: Target filter
+ * @param hash: Key hash, same function as when added
+ * @return: false if the key is not in the filter, true if it probably is
+ */
+static inline bool cuckoo_filter_may_contain_hash(const CuckooFilter *filter, uint64_t hash) {
+    size_t index;
+    uint16_t fingerprint = cuckoo_filter_fingerprint(filter, filter_remix(hash), &index);
+    size_t alt = cuckoo_filter_alt_index(filter, index, fingerprint);
+    uint64_t first = filter->buckets[index], second = filter->buckets[alt];
+    bool found = cuckoo_filter_bucket_has(first, fingerprint) | cuckoo_filter_bucket_has(second, fingerprint);
+    return found || (filter->has_victim && filter->victim == fingerprint &&
+                     (filter->victim_index == index || filter->victim_index == alt));
+}
+
+/**
+ * Remove a key that was added (removing a never-added key may drop another's fingerprint)
+ * @param filter: Target filter
+ * @param hash: Key hash, same function as when added
+ * @return: true if a matching fingerprint was removed
+ */
+static inline bool cuckoo_filter_remove_hash(CuckooFilter *filter, uint64_t hash) {
+    size_t index;
+    uint16_t fingerprint = cuckoo_filter_fingerprint(filter, filter_remix(hash), &index);
+    size_t alt = cuckoo_filter_alt_index(filter, index, fingerprint);
+    if (filter->has_victim && filter->victim == fingerprint &&
+        (filter->victim_index == index || filter->victim_index == alt)) {
+        filter->has_victim = false;
+        filter->count--;
+        return true;
+    }
+    if (!cuckoo_filter_bucket_take(filter, index, fingerprint) && !cuckoo_filter_bucket_take(filter, alt, fingerprint)) {
+        return false;
+    }
+    filter->count--;
+
+    // A lane is free now: give the victim another chance
+    if (filter->has_victim) {
+        filter->has_victim = false;
+        uint16_t victim = filter->victim;
+        size_t victim_alt = cuckoo_filter_alt_index(filter, filter->victim_index, victim);
+        if (!cuckoo_filter_bucket_put(filter, filter->victim_index, victim) &&
+            !cuckoo_filter_bucket_put(filter, victim_alt, victim)) {
+            cuckoo_filter_relocate(filter, filter->victim_index, victim);
+        }
+    }
+    return true;
+}
+
+/**
+ * Add string key
+ * @param filter: Target filter
+ * @param key: NUL-terminated string
+ * @return: true if added, false if the filter is full
+ */
+static inline bool cuckoo_filter_add_string(CuckooFilter *filter, const char *key) {
+    return cuckoo_filter_add_hash(filter, fast_hash_string(key));
+}
+
+/**
+ * Test string key
+ * @param filter: Target filter
+ * @param key: NUL-terminated string
+ * @return: false if the key is not in the filter, true if it probably is
+ */
+static inline bool cuckoo_filter_may_contain_string(const CuckooFilter *filter, const char *key) {
+    return cuckoo_filter_may_contain_hash(filter, fast_hash_string(key));
+}
+
+/**
+ * Remove string key that was added
+ * @param filter: Target filter
+ * @param key: NUL-terminated string
+ * @return: true if a matching fingerprint was removed
+ */
+static inline bool cuckoo_filter_remove_string(CuckooFilter *filter, const char *key) {
+    return cuckoo_filter_remove_hash(filter, fast_hash_string(key));
+}
+
+/**
+ * Get number of stored fingerprints
+ * @param filter: Target filter
+ * @return: Keys in the filter
+ */
+static inline size_t cuckoo_filter_size(const CuckooFilter *filter) {
+    return filter->count;
+}
+
+/**
+ * Remove every key
+ * @param filter: Target filter
+ */
+static inline void cuckoo_filter_clear(CuckooFilter *filter) {
+    memset(filter->buckets, 0, filter->bucket_count * sizeof(uint64_t));
+    filter->count = 0;
+    filter->has_victim = false;
+}
+
+/**
+ * Free filter memory
+ * @param filter: Filter to free
+ */
+static inline void cuckoo_filter_free(CuckooFilter *filter) {
+    free(filter->buckets);
+    filter->buckets = NULL;
+    filter->bucket_count = 0;
+    filter->count = 0;
+    filter->has_victim = false;
+}
+
+// ==================== FILTERED HASH TABLE ====================
+
+/**
+ * Initialize hash table with a cuckoo filter in front
+ * @param table: Table to initialize
+ * @param initial_capacity: Starting bucket count (also the filter's first sizing)
+ * @param hash_func: Hash function for keys (also feeds the filter)
+ * @param fp_rate: Filter false-positive rate (outside (0, 1) = default)
+ */
+static inline void filtered_hashtable_init(FilteredHashTable *table, size_t initial_capacity,
+                                           const HashFunction *hash_func, double fp_rate) {
+    hashtable_init(&table->table, initial_capacity, hash_func);
+    table->fp_rate = filter_fp_rate(fp_rate);
+    cuckoo_filter_init(&table->filter, initial_capacity, table->fp_rate);
+}
+
+/**
+ * Rebuild the filter at twice the capacity from the cached entry hashes (internal helper)
+ * @param table: Table whose filter is full
+ */
+static inline void filtered_hashtable_grow_filter(FilteredHashTable *table) {
+    size_t expected = (table->filter.bucket_count * CUCKOO_FILTER_BUCKET_SLOTS * 2) *
+                      CUCKOO_FILTER_LOAD_PERCENT / 100;
+    for (;;) {
+        cuckoo_filter_free(&table->filter);
+        cuckoo_filter_init(&table->filter, expected, table->fp_rate);
+        HashTableIterator it;
+        HashEntry *entry;
+        bool complete = true;
+        hashtable_iter_init(&it, &table->table);
+        while (complete && (entry = hashtable_iter_next(&it))) {
+            complete = cuckoo_filter_add_hash(&table->filter, entry->hash);
+        }
+        if (complete) return;
+        expected *= 2;
+    }
+}
+
+/**
+ * Insert or update key-value pair
+ * @param table: Target table
+ * @param key: Key to insert/update
+ * @param value: Value to associate
+ * @return: true if successful
+ */
+static inline bool filtered_hashtable_put(FilteredHashTable *table, const void *key, void *value) {
+    size_t hash = hashtable_hash_key(&table->table, key);
+    bool existed = cuckoo_filter_may_contain_hash(&table->filter, hash) &&
+                   hashtable_find_entry(&table->table, key, hash) != NULL;
+    if (!hashtable_put(&table->table, key, value)) return false;
+    if (!existed && !cuckoo_filter_add_hash(&table->filter, hash)) {
+        filtered_hashtable_grow_filter(table); // The new entry is already in the table
+    }
+    return true;
+}
+
+/**
+ * Retrieve value by key; most misses end at the filter
+ * @param table: Target table
+ * @param key: Key to search for
+ * @return: Associated value or NULL if not found
+ */
+static inline void *filtered_hashtable_get(FilteredHashTable *table, const void *key) {
+    size_t hash = hashtable_hash_key(&table->table, key);
+    if (!cuckoo_filter_may_contain_hash(&table->filter, hash)) return NULL;
+    hashtable_rehash_step(&table->table, HASHTABLE_REHASH_STEP);
+    HashEntry *entry = hashtable_find_entry(&table->table, key, hash);
+    return entry ? entry->value : NULL;
+}
+
+/**
+ * Check if key exists
+ * @param table: Target table
+ * @param key: Key to check
+ * @return: true if key exists
+ */
+static inline bool filtered_hashtable_contains(FilteredHashTable *table, const void *key) {
+    size_t hash = hashtable_hash_key(&table->table, key);
+    return cuckoo_filter_may_contain_hash(&table->filter, hash) &&
+           hashtable_find_entry(&table->table, key, hash) != NULL;
+}
+
+/**
+ * Remove key-value pair (and its fingerprint)
+ * @param table: Target table
+ * @param key: Key to remove
+ * @return: true if key was found and removed
+ */
+static inline bool filtered_hashtable_remove(FilteredHashTable *table, const void *key) {
+    size_t hash = hashtable_hash_key(&table->table, key);
+    if (!cuckoo_filter_may_contain_hash(&table->filter, hash)) return false;
+    if (!hashtable_remove(&table->table, key)) return false;
+    cuckoo_filter_remove_hash(&table->filter, hash);
+    return true;
+}
+
+/**
+ * Get number of key-value pairs
+ * @param table: Target table
+ * @return: Number of pairs
+ */
+static inline size_t filtered_hashtable_size(const FilteredHashTable *table) {
+    return table->table.size;
+}
+
+/**
+ * Free table and filter
+ * @param table: Table to free
+ */
+static inline void filtered_hashtable_free(FilteredHashTable *table) {
+    hashtable_free(&table->table);
+    cuckoo_filter_free(&table->filter);
+}
+
+// ==================== FILTERED HASH SET ====================
+
+/**
+ * Initialize string set with a cuckoo filter in front
+ * @param set: Set to initialize
+ * @param fp_rate: Filter false-positive rate (outside (0, 1) = default)
+ */
+static inline void filtered_hashset_init_string(FilteredHashSet *set, double fp_rate) {
+    filtered_hashtable_init(set, HASHTABLE_DEFAULT_SIZE, &STRING_HASH_FUNC, fp_rate);
+}
+
+/**
+ * Add element to set
+ * @param set: Target set
+ * @param key: Element to add
+ * @return: true if added (false if already exists)
+ */
+static inline bool filtered_hashset_add(FilteredHashSet *set, const void *key) {
+    size_t before = set->table.size;
+    filtered_hashtable_put(set, key, HASHSET_DUMMY_VALUE);
+    return set->table.size > before;
+}
+
+/**
+ * Remove element from set
+ * @param set: Target set
+ * @param key: Element to remove
+ * @return: true if removed (false if didn't exist)
+ */
+static inline bool filtered_hashset_remove(FilteredHashSet *set, const void *key) {
+    return filtered_hashtable_remove(set, key);
+}
+
+/**
+ * Check if element exists in set
+ * @param set: Target set
+ * @param key: Element to check
+ * @return: true if element exists
+ */
+static inline bool filtered_hashset_contains(FilteredHashSet *set, const void *key) {
+    return filtered_hashtable_contains(set, key);
+}
+
+/**
+ * Check if string exists in set
+ * @param set: String set
+ * @param str: String to check
+ * @return: true if string exists
+ */
+static inline bool filtered_hashset_contains_string(FilteredHashSet *set, const char *str) {
+    return filtered_hashtable_contains(set, str);
+}
+
+/**
+ * Free set and filter
+ * @param set: Set to free
+ */
+static inline void filtered_hashset_free(FilteredHashSet *set) {
+    filtered_hashtable_free(set);
+}
+
+#endif // FILTER_H
@@ -0,0 +1,626 @@
+#ifndef FLAT_HASHTABLE_H
+#define FLAT_HASHTABLE_H
+
+#include "hashtable.h"
+#include <stdint.h>
+
+/**
+ * FLAT HASH TABLE IMPLEMENTATION (OPEN ADDRESSING)
+ *
+ * Robin Hood hashing with linear probing over a single contiguous allocation.
+ * Control bytes, cached hashes, values and keys all live inline, so a put never
+ * allocates and a lookup touches one control array plus (usually) one slot.
+ *
+ * Uses the same HashFunction vtable as HashTable (hash + key_equals). Keys are
+ * either copied by value into the slot (key_size > 0, e.g. int keys) or
+ * borrowed by pointer (key_size == 0, e.g. a string living inside a Player);
+ * borrowed keys must outlive their entry. key_copy/key_free are never called.
+ *
+ * Time Complexities:
+ * - Insert/Update: O(1) average
+ * - Search: O(1) average, probe length bounded by FLAT_HASHTABLE_MAX_PROBE
+ * - Delete: O(1) average (backward-shift deletion, no tombstones)
+ *
+ * Space Complexity: O(m) where m = slots (power of two, >= n / load factor)
+ */
+
+// Configuration constants
+#define FLAT_HASHTABLE_MIN_SIZE 8
+#define FLAT_HASHTABLE_LOAD_NUM 7 // Grow when size > 7/8 of capacity
+#define FLAT_HASHTABLE_LOAD_DEN 8
+#define FLAT_HASHTABLE_MAX_PROBE 254 // Control byte holds probe distance + 1
+
+// Control byte value for an empty slot
+#define FLAT_HASHTABLE_EMPTY 0
+
+// Flat hash table structure
+typedef struct FlatHashTable {
+    uint8_t *ctrl;                 // capacity control bytes (0 = empty, else distance + 1)
+    unsigned char *slots;          // capacity slots + 2 scratch slots (same allocation)
+    size_t size;                   // Number of key-value pairs
+    size_t capacity;               // Number of slots (power of two)
+    size_t key_size;               // Inline key bytes, 0 = borrowed key pointer
+    size_t slot_size;              // Bytes per slot
+    unsigned shift;                // 64 - log2(capacity), for Fibonacci indexing
+    const HashFunction *hash_func; // Hash function implementation
+} FlatHashTable;
+
+// Slot layout: [void *value][uint64_t hash][key bytes | const void *key]
+#define FLAT_HASHTABLE_HASH_OFFSET sizeof(void *)
+#define FLAT_HASHTABLE_KEY_OFFSET (sizeof(void *) + sizeof(uint64_t))
+
+// ==================== SLOT HELPERS ====================
+
+/**
+ * Get slot storage by index (capacity and capacity + 1 are scratch slots)
+ * @param table: Target table
+ * @param index: Slot index
+ * @return: Pointer to slot bytes
+ */
+static inline unsigned char *flat_hashtable_slot(const FlatHashTable *table, size_t index) {
+    return table->slots + index * table->slot_size;
+}
+
+/**
+ * Read value pointer stored in slot
+ * @param slot: Slot bytes
+ * @return: Stored value
+ */
+static inline void *flat_hashtable_slot_value(const unsigned char *slot) {
+    void *value;
+    memcpy(&value, slot, sizeof(void *));
+    return value;
+}
+
+/**
+ * Overwrite value pointer stored in slot
+ * @param slot: Slot bytes
+ * @param value: New value
+ */
+static inline void flat_hashtable_slot_set_value(unsigned char *slot, void *value) {
+    memcpy(slot, &value, sizeof(void *));
+}
+
+/**
+ * Read cached hash stored in slot
+ * @param slot: Slot bytes
+ * @return: Full hash of the slot's key
+ */
+static inline uint64_t flat_hashtable_slot_hash(const unsigned char *slot) {
+    uint64_t hash;
+    memcpy(&hash, slot + FLAT_HASHTABLE_HASH_OFFSET, sizeof(uint64_t));
+    return hash;
+}
+
+/**
+ * Get key stored in slot
+ * @param table: Owning table
+ * @param slot: Slot bytes
+ * @return: Pointer usable with hash_func->key_equals
+ */
+static inline const void *flat_hashtable_slot_key(const FlatHashTable *table, const unsigned char *slot) {
+    if (table->key_size > 0) {
+        return slot + FLAT_HASHTABLE_KEY_OFFSET;
+    }
+    const void *key;
+    memcpy(&key, slot + FLAT_HASHTABLE_KEY_OFFSET, sizeof(const void *));
+    return key;
+}
+
+/**
+ * Fill slot with a key-value pair
+ * @param table: Owning table
+ * @param slot: Destination slot bytes
+ * @param key: Key (copied if key_size > 0, else borrowed)
+ * @param value: Associated value
+ * @param hash: Full hash of key
+ */
+static inline void flat_hashtable_slot_fill(const FlatHashTable *table, unsigned char *slot,
+                                            const void *key, void *value, uint64_t hash) {
+    flat_hashtable_slot_set_value(slot, value);
+    memcpy(slot + FLAT_HASHTABLE_HASH_OFFSET, &hash, sizeof(uint64_t));
+    if (table->key_size > 0) {
+        memcpy(slot + FLAT_HASHTABLE_KEY_OFFSET, key, table->key_size);
+    } else {
+        memcpy(slot + FLAT_HASHTABLE_KEY_OFFSET, &key, sizeof(const void *));
+    }
+}
+
+/**
+ * Compute full 64-bit hash of key through the HashFunction vtable
+ * @param table: Target table
+ * @param key: Key to hash
+ * @return: Hash value (reduced to a slot by flat_hashtable_home)
+ */
+static inline uint64_t flat_hashtable_hash(const FlatHashTable *table, const void *key) {
+    return (uint64_t)table->hash_func->hash(key, SIZE_MAX);
+}
+
+/**
+ * Map hash to home slot with Fibonacci hashing (uses the high bits)
+ * @param hash: Full hash
+ * @param shift: 64 - log2(capacity)
+ * @return: Home slot index
+ */
+static inline size_t flat_hashtable_home(uint64_t hash, unsigned shift) {
+    return (size_t)((hash * 0x9E3779B97F4A7C15ULL) >> shift);
+}
+
+// ==================== ALLOCATION ====================
+
+/**
+ * Allocate control bytes and slots for given capacity (internal helper)
+ * @param table: Table whose layout fields are set
+ * @param capacity: Slot count (power of two)
+ */
+static inline void flat_hashtable_allocate(FlatHashTable *table, size_t capacity) {
+    size_t ctrl_bytes = (capacity + 15) & ~(size_t)15; // Keep slots 16-byte aligned
+    unsigned char *block = (unsigned char *)calloc(1, ctrl_bytes + (capacity + 2) * table->slot_size);
+    if (!block) {
+        fprintf(stderr, "flat_hashtable_allocate: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    DS_STATS_ALLOC(DS_STATS_FLAT_HASHTABLE, ctrl_bytes + (capacity + 2) * table->slot_size);
+
+    unsigned log2 = 0;
+    while (((size_t)1 << log2) < capacity) log2++;
+
+    table->ctrl = block;
+    table->slots = block + ctrl_bytes;
+    table->capacity = capacity;
+    table->shift = 64 - log2;
+}
+
+/**
+ * Robin Hood insert of a fully built slot, no duplicate check (internal helper)
+ * @param table: Target table
+ * @param src: Slot bytes to insert (may be a table scratch slot)
+ * @return: true on success, false if the probe limit was hit; the entry
+ *          displaced last is then left in scratch slot `capacity`
+ */
+static inline bool flat_hashtable_insert_slot(FlatHashTable *table, const unsigned char *src) {
+    size_t mask = table->capacity - 1;
+    unsigned char *carry = flat_hashtable_slot(table, table->capacity);
+    unsigned char *tmp = flat_hashtable_slot(table, table->capacity + 1);
+    if (src != carry) memcpy(carry, src, table->slot_size);
+
+    size_t index = flat_hashtable_home(flat_hashtable_slot_hash(carry), table->shift);
+    unsigned dist = 0;
+
+    while (true) {
+        uint8_t c = table->ctrl[index];
+        if (c == FLAT_HASHTABLE_EMPTY) {
+            memcpy(flat_hashtable_slot(table, index), carry, table->slot_size);
+            table->ctrl[index] = (uint8_t)(dist + 1);
+            table->size++;
+            return true;
+        }
+
+        // Rich entry (shorter probe distance) yields its slot to the poor one
+        if ((unsigned)(c - 1) < dist) {
+            unsigned char *slot = flat_hashtable_slot(table, index);
+            memcpy(tmp, slot, table->slot_size);
+            memcpy(slot, carry, table->slot_size);
+            memcpy(carry, tmp, table->slot_size);
+            table->ctrl[index] = (uint8_t)(dist + 1);
+            dist = c - 1;
+        }
+
+        index = (index + 1) & mask;
+        if (++dist >= FLAT_HASHTABLE_MAX_PROBE) return false;
+    }
+}
+
+/**
+ * Resize table, moving entries without recomputing hashes
+ * @param table: Table to resize
+ * @param new_capacity: Minimum new slot count (rounded up to power of two)
+ */
+static inline void flat_hashtable_resize(FlatHashTable *table, size_t new_capacity) {
+    DS_STATS_TIMER(started);
+    FlatHashTable old = *table;
+    size_t capacity = FLAT_HASHTABLE_MIN_SIZE;
+    while (capacity < new_capacity) capacity <<= 1;
+
+    while (true) {
+        flat_hashtable_allocate(table, capacity);
+        table->size = 0;
+
+        bool ok = true;
+        for (size_t i = 0; i < old.capacity && ok; i++) {
+            if (old.ctrl[i] != FLAT_HASHTABLE_EMPTY) {
+                ok = flat_hashtable_insert_slot(table, flat_hashtable_slot(&old, i));
+            }
+        }
+        if (ok) break;
+
+        // Pathological clustering: retry with more room (old table untouched)
+        free(table->ctrl);
+        capacity <<= 1;
+    }
+
+    free(old.ctrl);
+    DS_STATS_RESIZE(DS_STATS_FLAT_HASHTABLE, started);
+}
+
+// ==================== CORE OPERATIONS ====================
+
+/**
+ * Initialize flat hash table
+ * @param table: Table to initialize
+ * @param initial_capacity: Starting slot count (rounded up to power of two)
+ * @param hash_func: Hash function to use (hash + key_equals)
+ * @param key_size: Bytes copied inline per key, 0 to borrow key pointers
+ */
+static inline void flat_hashtable_init(FlatHashTable *table, size_t initial_capacity,
+                                       const HashFunction *hash_func, size_t key_size) {
+    size_t key_bytes = key_size > 0 ? key_size : sizeof(const void *);
+    size_t align = sizeof(uint64_t);
+
+    table->key_size = key_size;
+    table->slot_size = (FLAT_HASHTABLE_KEY_OFFSET + key_bytes + align - 1) & ~(align - 1);
+    table->hash_func = hash_func;
+    table->size = 0;
+
+    size_t capacity = FLAT_HASHTABLE_MIN_SIZE;
+    while (capacity < initial_capacity) capacity <<= 1;
+    flat_hashtable_allocate(table, capacity);
+}
+
+/**
+ * Initialize string table with default settings
+ * Keys are borrowed: each string must stay valid while its entry exists.
+ * @param table: Table to initialize
+ */
+static inline void flat_hashtable_init_string(FlatHashTable *table) {
+    flat_hashtable_init(table, HASHTABLE_DEFAULT_SIZE, &STRING_HASH_FUNC, 0);
+}
+
+/**
+ * Initialize integer table with default settings (keys stored inline)
+ * @param table: Table to initialize
+ */
+static inline void flat_hashtable_init_int(FlatHashTable *table) {
+    flat_hashtable_init(table, HASHTABLE_DEFAULT_SIZE, &INT_HASH_FUNC, sizeof(int));
+}
+
+/**
+ * Find slot index holding key (internal helper)
+ * @param table: Target table
+ * @param key: Key to search for
+ * @param hash: Full hash of key
+ * @return: Slot index, SIZE_MAX if not found
+ */
+static inline size_t flat_hashtable_find_index(const FlatHashTable *table, const void *key, uint64_t hash) {
+    size_t mask = table->capacity - 1;
+    size_t index = flat_hashtable_home(hash, table->shift);
+
+    for (unsigned dist = 0; dist < FLAT_HASHTABLE_MAX_PROBE; dist++) {
+        uint8_t c = table->ctrl[index];
+
+        // Robin Hood invariant: key cannot live past a richer entry or a hole
+        if (c == FLAT_HASHTABLE_EMPTY || (unsigned)(c - 1) < dist) {
+            DS_STATS_PROBE(DS_STATS_FLAT_HASHTABLE, dist + 1);
+            return SIZE_MAX;
+        }
+
+        if ((unsigned)(c - 1) == dist) {
+            const unsigned char *slot = flat_hashtable_slot(table, index);
+            if (flat_hashtable_slot_hash(slot) == hash &&
+                table->hash_func->key_equals(flat_hashtable_slot_key(table, slot), key)) {
+                DS_STATS_PROBE(DS_STATS_FLAT_HASHTABLE, dist + 1);
+                return index;
+            }
+        }
+        index = (index + 1) & mask;
+    }
+    DS_STATS_PROBE(DS_STATS_FLAT_HASHTABLE, FLAT_HASHTABLE_MAX_PROBE);
+    return SIZE_MAX;
+}
+
+/**
+ * Insert or update key-value pair
+ * @param table: Target table
+ * @param key: Key to insert/update
+ * @param value: Value to associate
+ * @return: true if successful
+ */
+static inline bool flat_hashtable_put(FlatHashTable *table, const void *key, void *value) {
+    uint64_t hash = flat_hashtable_hash(table, key);
+
+    size_t found = flat_hashtable_find_index(table, key, hash);
+    if (found != SIZE_MAX) {
+        flat_hashtable_slot_set_value(flat_hashtable_slot(table, found), value); // Update existing
+        return true;
+    }
+
+    // Grow before the load factor is exceeded
+    if ((table->size + 1) * FLAT_HASHTABLE_LOAD_DEN > table->capacity * FLAT_HASHTABLE_LOAD_NUM) {
+        flat_hashtable_resize(table, table->capacity * 2);
+    }
+
+    unsigned char *carry = flat_hashtable_slot(table, table->capacity);
+    flat_hashtable_slot_fill(table, carry, key, value, hash);
+
+    while (!flat_hashtable_insert_slot(table, carry)) {
+        // Probe limit hit: park the displaced entry, grow, and retry
+        unsigned char *pending = (unsigned char *)malloc(table->slot_size);
+        if (!pending) return false;
+        memcpy(pending, carry, table->slot_size);
+        flat_hashtable_resize(table, table->capacity * 2);
+        carry = flat_hashtable_slot(table, table->capacity);
+        memcpy(carry, pending, table->slot_size);
+        free(pending);
+    }
+    return true;
+}
+
+/**
+ * Grow table so count entries fit without further resizing
+ * @param table: Target table
+ * @param count: Total entries expected
+ */
+static inline void flat_hashtable_reserve(FlatHashTable *table, size_t count) {
+    size_t needed = (count * FLAT_HASHTABLE_LOAD_DEN + FLAT_HASHTABLE_LOAD_NUM - 1) / FLAT_HASHTABLE_LOAD_NUM;
+    if (needed > table->capacity) flat_hashtable_resize(table, needed);
+}
+
+/**
+ * Retrieve value by key
+ * @param table: Target table
+ * @param key: Key to search for
+ * @return: Associated value or NULL if not found
+ */
+static inline void *flat_hashtable_get(const FlatHashTable *table, const void *key) {
+    size_t index = flat_hashtable_find_index(table, key, flat_hashtable_hash(table, key));
+    return index != SIZE_MAX ? flat_hashtable_slot_value(flat_hashtable_slot(table, index)) : NULL;
+}
+
+/**
+ * Start loading the home slot of a hash, e.g. while a filter in front is consulted
+ * @param table: Target table
+ * @param hash: flat_hashtable_hash(table, key)
+ */
+static inline void flat_hashtable_prefetch(const FlatHashTable *table, uint64_t hash) {
+    size_t index = flat_hashtable_home(hash, table->shift);
+    __builtin_prefetch(&table->ctrl[index]);
+    __builtin_prefetch(flat_hashtable_slot(table, index));
+}
+
+/**
+ * Retrieve value by key and its precomputed hash (lets a filter in front share it)
+ * @param table: Target table
+ * @param key: Key to search for
+ * @param hash: flat_hashtable_hash(table, key)
+ * @return: Associated value or NULL if not found
+ */
+static inline void *flat_hashtable_get_with_hash(const FlatHashTable *table, const void *key, uint64_t hash) {
+    size_t index = flat_hashtable_find_index(table, key, hash);
+    return index != SIZE_MAX ? flat_hashtable_slot_value(flat_hashtable_slot(table, index)) : NULL;
+}
+
+/**
+ * Remove key-value pair (backward-shift deletion)
+ * @param table: Target table
+ * @param key: Key to remove
+ * @return: true if key was found and removed
+ */
+static inline bool flat_hashtable_remove(FlatHashTable *table, const void *key) {
+    size_t index = flat_hashtable_find_index(table, key, flat_hashtable_hash(table, key));
+    if (index == SIZE_MAX) return false;
+
+    size_t mask = table->capacity - 1;
+    size_t next = (index + 1) & mask;
+
+    // Shift following displaced entries one slot closer to home
+    while (table->ctrl[next] > 1) {
+        memcpy(flat_hashtable_slot(table, index), flat_hashtable_slot(table, next), table->slot_size);
+        table->ctrl[index] = (uint8_t)(table->ctrl[next] - 1);
+        index = next;
+        next = (next + 1) & mask;
+    }
+
+    table->ctrl[index] = FLAT_HASHTABLE_EMPTY;
+    table->size--;
+    return true;
+}
+
+/**
+ * Check if key exists
+ * @param table: Target table
+ * @param key: Key to check
+ * @return: true if key exists
+ */
+static inline bool flat_hashtable_contains(const FlatHashTable *table, const void *key) {
+    return flat_hashtable_find_index(table, key, flat_hashtable_hash(table, key)) != SIZE_MAX;
+}
+
+/**
+ * Get current size
+ * @param table: Target table
+ * @return: Number of key-value pairs
+ */
+static inline size_t flat_hashtable_size(const FlatHashTable *table) {
+    return table->size;
+}
+
+/**
+ * Check if empty
+ * @param table: Target table
+ * @return: true if empty
+ */
+static inline bool flat_hashtable_is_empty(const FlatHashTable *table) {
+    return table->size == 0;
+}
+
+/**
+ * Clear all entries (keeps capacity)
+ * @param table: Target table
+ */
+static inline void flat_hashtable_clear(FlatHashTable *table) {
+    memset(table->ctrl, FLAT_HASHTABLE_EMPTY, table->capacity);
+    table->size = 0;
+}
+
+/**
+ * Free all memory
+ * @param table: Table to free
+ */
+static inline void flat_hashtable_free(FlatHashTable *table) {
+    free(table->ctrl);
+    table->ctrl = NULL;
+    table->slots = NULL;
+    table->size = 0;
+    table->capacity = 0;
+}
+
+/**
+ * Visit every key-value pair (order unspecified, table must not be modified)
+ * @param table: Target table
+ * @param visit: Callback receiving key, value and user context
+ * @param ctx: User context
+ */
+static inline void flat_hashtable_foreach(const FlatHashTable *table,
+                                          void (*visit)(const void *key, void *value, void *ctx),
+                                          void *ctx) {
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (table->ctrl[i] != FLAT_HASHTABLE_EMPTY) {
+            const unsigned char *slot = flat_hashtable_slot(table, i);
+            visit(flat_hashtable_slot_key(table, slot), flat_hashtable_slot_value(slot), ctx);
+        }
+    }
+}
+
+// ==================== UTILITY FUNCTIONS ====================
+
+/**
+ * Get current load factor
+ * @param table: Target table
+ * @return: Current load factor
+ */
+static inline double flat_hashtable_load_factor(const FlatHashTable *table) {
+    return table->capacity > 0 ? (double)table->size / table->capacity : 0.0;
+}
+
+/**
+ * Get longest probe sequence (max displacement + 1)
+ * @param table: Target table
+ * @return: Longest probe length
+ */
+static inline size_t flat_hashtable_max_probe_length(const FlatHashTable *table) {
+    size_t max_probe = 0;
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (table->ctrl[i] > max_probe) max_probe = table->ctrl[i];
+    }
+    return max_probe;
+}
+
+/**
+ * Get average probe length over stored entries
+ * @param table: Target table
+ * @return: Mean probe length (1.0 = every key in its home slot)
+ */
+static inline double flat_hashtable_avg_probe_length(const FlatHashTable *table) {
+    size_t total = 0;
+    for (size_t i = 0; i < table->capacity; i++) {
+        total += table->ctrl[i];
+    }
+    return table->size > 0 ? (double)total / table->size : 0.0;
+}
+
+/**
+ * Validate Robin Hood invariants (for testing)
+ * @param table: Target table
+ * @return: true if every entry's distance matches its home slot
+ */
+static inline bool flat_hashtable_is_valid(const FlatHashTable *table) {
+    size_t count = 0;
+    for (size_t i = 0; i < table->capacity; i++) {
+        uint8_t c = table->ctrl[i];
+        if (c == FLAT_HASHTABLE_EMPTY) continue;
+        count++;
+        size_t home = flat_hashtable_home(flat_hashtable_slot_hash(flat_hashtable_slot(table, i)), table->shift);
+        if (((i - home) & (table->capacity - 1)) != (size_t)(c - 1)) return false;
+    }
+    return count == table->size;
+}
+
+/**
+ * Print table statistics for debugging
+ * @param table: Target table
+ */
+static inline void flat_hashtable_print_stats(const FlatHashTable *table) {
+    printf("Flat Hash Table Statistics:\n");
+    printf("  Size: %zu, Capacity: %zu, Slot Size: %zu bytes\n",
+           table->size, table->capacity, table->slot_size);
+    printf("  Load Factor: %.3f (threshold: %.3f)\n",
+           flat_hashtable_load_factor(table), (double)FLAT_HASHTABLE_LOAD_NUM / FLAT_HASHTABLE_LOAD_DEN);
+    printf("  Avg Probe Length: %.3f, Max Probe Length: %zu\n",
+           flat_hashtable_avg_probe_length(table), flat_hashtable_max_probe_length(table));
+}
+
+// ==================== CONVENIENCE FUNCTIONS ====================
+
+/**
+ * Put string key-value pair (key is borrowed, not copied)
+ * @param table: String flat table
+ * @param key: String key
+ * @param value: Value to associate
+ * @return: true if successful
+ */
+static inline bool flat_hashtable_put_string(FlatHashTable *table, const char *key, void *value) {
+    return flat_hashtable_put(table, key, value);
+}
+
+/**
+ * Get value by string key
+ * @param table: String flat table
+ * @param key: String key
+ * @return: Associated value or NULL
+ */
+static inline void *flat_hashtable_get_string(const FlatHashTable *table, const char *key) {
+    return flat_hashtable_get(table, key);
+}
+
+/**
+ * Remove by string key
+ * @param table: String flat table
+ * @param key: String key to remove
+ * @return: true if removed
+ */
+static inline bool flat_hashtable_remove_string(FlatHashTable *table, const char *key) {
+    return flat_hashtable_remove(table, key);
+}
+
+/**
+ * Put integer key-value pair (key stored inline)
+ * @param table: Integer flat table
+ * @param key: Integer key
+ * @param value: Value to associate
+ * @return: true if successful
+ */
+static inline bool flat_hashtable_put_int(FlatHashTable *table, int key, void *value) {
+    return flat_hashtable_put(table, &key, value);
+}
+
+/**
+ * Get value by integer key
+ * @param table: Integer flat table
+ * @param key: Integer key
+ * @return: Associated value or NULL
+ */
+static inline void *flat_hashtable_get_int(const FlatHashTable *table, int key) {
+    return flat_hashtable_get(table, &key);
+}
+
+/**
+ * Remove by integer key
+ * @param table: Integer flat table
+ * @param key: Integer key to remove
+ * @return: true if removed
+ */
+static inline bool flat_hashtable_remove_int(FlatHashTable *table, int key) {
+    return flat_hashtable_remove(table, &key);
+}
+
+#endif // FLAT_HASHTABLE_H
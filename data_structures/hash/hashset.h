@@ -138,26 +138,21 @@ static inline void hashset_free(HashSet *set)
  */
 static inline void hashset_union(HashSet *set1, HashSet *set2, HashSet *result)
 {
+    HashTableIterator it;
+    HashEntry *entry;
+
     // Add all elements from set1
-    for (size_t i = 0; i < set1->capacity; i++)
+    hashtable_iter_init(&it, set1);
+    while ((entry = hashtable_iter_next(&it)))
     {
-        HashEntry *entry = set1->buckets[i];
-        while (entry)
-        {
-            hashset_add(result, entry->key);
-            entry = entry->next;
-        }
+        hashset_add(result, entry->key);
     }
 
     // Add all elements from set2
-    for (size_t i = 0; i < set2->capacity; i++)
+    hashtable_iter_init(&it, set2);
+    while ((entry = hashtable_iter_next(&it)))
     {
-        HashEntry *entry = set2->buckets[i];
-        while (entry)
-        {
-            hashset_add(result, entry->key);
-            entry = entry->next;
-        }
+        hashset_add(result, entry->key);
     }
 }
 
@@ -173,16 +168,14 @@ static inline void hashset_intersection(HashSet *set1, HashSet *set2, HashSet *r
     HashSet *smaller = hashset_size(set1) <= hashset_size(set2) ? set1 : set2;
     HashSet *larger = (smaller == set1) ? set2 : set1;
 
-    for (size_t i = 0; i < smaller->capacity; i++)
+    HashTableIterator it;
+    HashEntry *entry;
+    hashtable_iter_init(&it, smaller);
+    while ((entry = hashtable_iter_next(&it)))
     {
-        HashEntry *entry = smaller->buckets[i];
-        while (entry)
+        if (hashtable_lookup(larger, entry->key))
         {
-            if (hashset_contains(larger, entry->key))
-            {
-                hashset_add(result, entry->key);
-            }
-            entry = entry->next;
+            hashset_add(result, entry->key);
         }
     }
 }
@@ -195,16 +188,14 @@ static inline void hashset_intersection(HashSet *set1, HashSet *set2, HashSet *r
  */
 static inline void hashset_difference(HashSet *set1, HashSet *set2, HashSet *result)
 {
-    for (size_t i = 0; i < set1->capacity; i++)
+    HashTableIterator it;
+    HashEntry *entry;
+    hashtable_iter_init(&it, set1);
+    while ((entry = hashtable_iter_next(&it)))
     {
-        HashEntry *entry = set1->buckets[i];
-        while (entry)
+        if (!hashtable_lookup(set2, entry->key))
         {
-            if (!hashset_contains(set2, entry->key))
-            {
-                hashset_add(result, entry->key);
-            }
-            entry = entry->next;
+            hashset_add(result, entry->key);
         }
     }
 }
@@ -220,16 +211,14 @@ static inline bool hashset_is_subset(HashSet *set1, HashSet *set2)
     if (hashset_size(set1) > hashset_size(set2))
         return false;
 
-    for (size_t i = 0; i < set1->capacity; i++)
+    HashTableIterator it;
+    HashEntry *entry;
+    hashtable_iter_init(&it, set1);
+    while ((entry = hashtable_iter_next(&it)))
     {
-        HashEntry *entry = set1->buckets[i];
-        while (entry)
+        if (!hashtable_lookup(set2, entry->key))
         {
-            if (!hashset_contains(set2, entry->key))
-            {
-                return false;
-            }
-            entry = entry->next;
+            return false;
         }
     }
     return true;
@@ -335,15 +324,15 @@ static inline void hashset_print_stats(HashSet *set)
 static inline void hashset_copy(HashSet *source, HashSet *dest)
 {
     hashset_init(dest, source->capacity, source->hash_func);
+    dest->incremental = source->incremental;
+    dest->allocator = source->allocator;
 
-    for (size_t i = 0; i < source->capacity; i++)
+    HashTableIterator it;
+    HashEntry *entry;
+    hashtable_iter_init(&it, source);
+    while ((entry = hashtable_iter_next(&it)))
     {
-        HashEntry *entry = source->buckets[i];
-        while (entry)
-        {
-            hashset_add(dest, entry->key);
-            entry = entry->next;
-        }
+        hashset_add(dest, entry->key);
     }
 }
 
@@ -4,7 +4,11 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
+#include "fast_hash.h"
+#include "../allocator/allocator.h"
+#include "../stats/ds_stats.h"
 
 /**
  * HASH TABLE IMPLEMENTATION
@@ -18,6 +22,10 @@
  * - Delete: O(1) average, O(n) worst case
  * 
  * Space Complexity: O(n + m) where n = elements, m = buckets
+ *
+ * Incremental mode (hashtable_init_incremental): growing keeps the old bucket
+ * array alive and migrates HASHTABLE_REHASH_STEP buckets on every put/get/remove,
+ * Redis dict style, so no single operation pays the O(n) rehash.
  */
 
 // Configuration constants
@@ -25,15 +33,20 @@
 #define HASHTABLE_LOAD_FACTOR 0.75
 #define HASHTABLE_MIN_SIZE 8
 #define HASHTABLE_GROWTH_FACTOR 2
+#define HASHTABLE_REHASH_STEP 4          // Buckets migrated per operation
+#define HASHTABLE_REHASH_EMPTY_VISITS 10 // Empty buckets skipped per migrated bucket
 
 // Hash table entry (separate chaining)
 typedef struct HashEntry {
     void *key;               // Generic key
     void *value;             // Associated value  
+    size_t hash;             // Cached full hash of key
     struct HashEntry *next;  // Next entry in chain
 } HashEntry;
 
 // Hash function interface for different key types
+// hash(key, SIZE_MAX) must return the full hash; tables cache it per entry
+// and reduce it modulo their capacity, so resizes never re-hash keys.
 typedef struct HashFunction {
     size_t (*hash)(const void *key, size_t capacity);       // Primary hash function
     bool (*key_equals)(const void *key1, const void *key2); // Key comparison
@@ -48,8 +61,23 @@ typedef struct HashTable {
     size_t capacity;                  // Number of buckets
     double load_factor_threshold;     // Resize trigger
     const HashFunction *hash_func;    // Hash function implementation
+    const Allocator *allocator;       // Source of HashEntry nodes
+
+    // Incremental rehashing state
+    bool incremental;                 // Migrate gradually instead of stop-the-world
+    HashEntry **old_buckets;          // Array being drained (NULL when not rehashing)
+    size_t old_capacity;              // Bucket count of old array
+    size_t rehash_index;              // Next old bucket to migrate
 } HashTable;
 
+// Iterator over all entries (covers both arrays while rehashing)
+typedef struct HashTableIterator {
+    const HashTable *table;
+    HashEntry *entry;     // Next entry to return
+    size_t bucket;        // Next bucket to scan in current array
+    bool in_old;          // Scanning old_buckets
+} HashTableIterator;
+
 // ==================== DEFAULT HASH FUNCTIONS ====================
 
 /**
@@ -69,6 +97,16 @@ static inline size_t hash_string_djb2(const void *key, size_t capacity) {
     return hash % capacity;
 }
 
+/**
+ * Fast string hash (wyhash-style, SIMD stripes for long keys)
+ * @param key: String key
+ * @param capacity: Table capacity
+ * @return: Hash value
+ */
+static inline size_t hash_string_fast(const void *key, size_t capacity) {
+    return (size_t)(fast_hash_string((const char *)key) % capacity);
+}
+
 /**
  * String equality comparison
  * @param key1, key2: String keys to compare
@@ -149,6 +187,13 @@ static inline void hash_int_free(void *key) {
 
 // Pre-defined hash functions
 static const HashFunction STRING_HASH_FUNC = {
+    .hash = hash_string_fast,
+    .key_equals = hash_string_equals,
+    .key_copy = hash_string_copy,
+    .key_free = hash_string_free
+};
+
+static const HashFunction DJB2_STRING_HASH_FUNC = {
     .hash = hash_string_djb2,
     .key_equals = hash_string_equals,
     .key_copy = hash_string_copy,
@@ -169,14 +214,18 @@ static const HashFunction INT_HASH_FUNC = {
  * @param key: Key to store
  * @param value: Value to associate
  * @param hash_func: Hash function for key operations
+ * @param allocator: Source of entry memory
  * @return: New entry or NULL on failure
  */
-static inline HashEntry *hashtable_create_entry(const void *key, void *value, const HashFunction *hash_func) {
-    HashEntry *entry = (HashEntry *)malloc(sizeof(HashEntry));
+static inline HashEntry *hashtable_create_entry(const void *key, void *value, const HashFunction *hash_func,
+                                                const Allocator *allocator) {
+    HashEntry *entry = (HashEntry *)allocator_alloc(allocator, sizeof(HashEntry));
     if (!entry) return NULL;
+    DS_STATS_ALLOC(DS_STATS_HASHTABLE, sizeof(HashEntry));
     
     entry->key = hash_func->key_copy(key);
     entry->value = value;
+    entry->hash = 0;
     entry->next = NULL;
     return entry;
 }
@@ -185,11 +234,13 @@ static inline HashEntry *hashtable_create_entry(const void *key, void *value, co
  * Free hash entry
  * @param entry: Entry to free
  * @param hash_func: Hash function for key deallocation
+ * @param allocator: Allocator the entry came from
  */
-static inline void hashtable_free_entry(HashEntry *entry, const HashFunction *hash_func) {
+static inline void hashtable_free_entry(HashEntry *entry, const HashFunction *hash_func,
+                                        const Allocator *allocator) {
     if (entry) {
-        hash_func->key_free(entry->key);
-        free(entry);
+        if (hash_func->key_free) hash_func->key_free(entry->key);
+        allocator_free(allocator, entry, sizeof(HashEntry));
     }
 }
 
@@ -206,12 +257,42 @@ static inline void hashtable_init(HashTable *table, size_t initial_capacity, con
     table->size = 0;
     table->load_factor_threshold = HASHTABLE_LOAD_FACTOR;
     table->hash_func = hash_func;
+    table->allocator = &HEAP_ALLOCATOR;
+    table->incremental = false;
+    table->old_buckets = NULL;
+    table->old_capacity = 0;
+    table->rehash_index = 0;
     
     table->buckets = (HashEntry **)calloc(table->capacity, sizeof(HashEntry *));
     if (!table->buckets) {
         fprintf(stderr, "hashtable_init: allocation failed\n");
         exit(EXIT_FAILURE);
     }
+    DS_STATS_ALLOC(DS_STATS_HASHTABLE, table->capacity * sizeof(HashEntry *));
+}
+
+/**
+ * Initialize hash table with incremental (amortized) rehashing
+ * @param table: Table to initialize
+ * @param initial_capacity: Starting bucket count
+ * @param hash_func: Hash function to use
+ */
+static inline void hashtable_init_incremental(HashTable *table, size_t initial_capacity, const HashFunction *hash_func) {
+    hashtable_init(table, initial_capacity, hash_func);
+    table->incremental = true;
+}
+
+/**
+ * Initialize hash table drawing entries from a custom allocator
+ * @param table: Table to initialize
+ * @param initial_capacity: Starting bucket count
+ * @param hash_func: Hash function to use
+ * @param allocator: Source of HashEntry nodes (e.g. a Pool of sizeof(HashEntry))
+ */
+static inline void hashtable_init_with_allocator(HashTable *table, size_t initial_capacity,
+                                                 const HashFunction *hash_func, const Allocator *allocator) {
+    hashtable_init(table, initial_capacity, hash_func);
+    table->allocator = allocator;
 }
 
 /**
@@ -230,41 +311,161 @@ static inline void hashtable_init_int(HashTable *table) {
     hashtable_init(table, HASHTABLE_DEFAULT_SIZE, &INT_HASH_FUNC);
 }
 
+/**
+ * Check if an incremental migration is in progress
+ * @param table: Target table
+ * @return: true while old buckets are still being drained
+ */
+static inline bool hashtable_is_rehashing(const HashTable *table) {
+    return table->old_buckets != NULL;
+}
+
+/**
+ * Migrate up to `steps` non-empty old buckets into the new array
+ * @param table: Target table
+ * @param steps: Maximum buckets to move
+ * @return: true if migration is still in progress afterwards
+ */
+static inline bool hashtable_rehash_step(HashTable *table, size_t steps) {
+    if (!hashtable_is_rehashing(table)) return false;
+    
+    size_t empty_visits = steps > SIZE_MAX / HASHTABLE_REHASH_EMPTY_VISITS ?
+                          SIZE_MAX : steps * HASHTABLE_REHASH_EMPTY_VISITS;
+    while (steps > 0 && table->rehash_index < table->old_capacity) {
+        HashEntry *entry = table->old_buckets[table->rehash_index];
+        if (!entry) {
+            table->rehash_index++;
+            if (--empty_visits == 0) break;
+            continue;
+        }
+        
+        // Move whole chain to its new buckets
+        while (entry) {
+            HashEntry *next = entry->next;
+            size_t new_index = entry->hash % table->capacity; // Cached, no re-hash
+            entry->next = table->buckets[new_index];
+            table->buckets[new_index] = entry;
+            entry = next;
+        }
+        table->old_buckets[table->rehash_index++] = NULL;
+        steps--;
+    }
+    
+    if (table->rehash_index >= table->old_capacity) {
+        free(table->old_buckets);
+        table->old_buckets = NULL;
+        table->old_capacity = 0;
+        table->rehash_index = 0;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Finish any in-progress migration immediately
+ * @param table: Target table
+ */
+static inline void hashtable_rehash_complete(HashTable *table) {
+    while (hashtable_rehash_step(table, SIZE_MAX)) {
+    }
+}
+
 /**
  * Resize hash table
+ * In incremental mode this only starts a migration; entries move on later operations.
  * @param table: Table to resize
  * @param new_capacity: New bucket count
  */
 static inline void hashtable_resize(HashTable *table, size_t new_capacity) {
+    DS_STATS_TIMER(started);
+    
+    // Only one migration at a time
+    hashtable_rehash_complete(table);
+    
     HashEntry **old_buckets = table->buckets;
     size_t old_capacity = table->capacity;
     
     // Initialize new table
     table->capacity = new_capacity;
-    table->size = 0;
     table->buckets = (HashEntry **)calloc(new_capacity, sizeof(HashEntry *));
     if (!table->buckets) {
         fprintf(stderr, "hashtable_resize: allocation failed\n");
         exit(EXIT_FAILURE);
     }
+    DS_STATS_ALLOC(DS_STATS_HASHTABLE, new_capacity * sizeof(HashEntry *));
     
-    // Rehash all entries
-    for (size_t i = 0; i < old_capacity; i++) {
-        HashEntry *entry = old_buckets[i];
-        while (entry) {
-            HashEntry *next = entry->next;
-            
-            // Rehash entry to new location
-            size_t new_index = table->hash_func->hash(entry->key, new_capacity);
-            entry->next = table->buckets[new_index];
-            table->buckets[new_index] = entry;
-            table->size++;
-            
-            entry = next;
-        }
-    }
+    table->old_buckets = old_buckets;
+    table->old_capacity = old_capacity;
+    table->rehash_index = 0;
     
-    free(old_buckets);
+    // Stop-the-world mode: rehash all entries now
+    if (!table->incremental) {
+        hashtable_rehash_complete(table);
+    }
+    DS_STATS_RESIZE(DS_STATS_HASHTABLE, started);
+}
+
+/**
+ * Compute full hash of key (internal helper)
+ * @param table: Target table
+ * @param key: Key to hash
+ * @return: Full hash, reduced per array with % capacity
+ */
+static inline size_t hashtable_hash_key(const HashTable *table, const void *key) {
+    return table->hash_func->hash(key, SIZE_MAX);
+}
+
+/**
+ * Walk one chain, comparing cached hashes before keys (internal helper)
+ * @param table: Owning table
+ * @param current: Chain head
+ * @param key: Key to search for
+ * @param hash: Full hash of key
+ * @param visited: Incremented per entry visited (for DS_STATS probe lengths)
+ * @return: Matching entry or NULL
+ */
+static inline HashEntry *hashtable_walk_chain(const HashTable *table, HashEntry *current,
+                                              const void *key, size_t hash, size_t *visited) {
+    while (current) {
+        ++*visited;
+        if (current->hash == hash && table->hash_func->key_equals(current->key, key)) return current;
+        current = current->next;
+    }
+    return NULL;
+}
+
+/**
+ * Find entry in one chain (internal helper)
+ * @param table: Owning table
+ * @param current: Chain head
+ * @param key: Key to search for
+ * @param hash: Full hash of key
+ * @return: Matching entry or NULL
+ */
+static inline HashEntry *hashtable_find_in_chain(const HashTable *table, HashEntry *current,
+                                                 const void *key, size_t hash) {
+    size_t visited = 0;
+    HashEntry *found = hashtable_walk_chain(table, current, key, hash, &visited);
+    DS_STATS_PROBE(DS_STATS_HASHTABLE, visited);
+    return found;
+}
+
+/**
+ * Find entry by key without migrating buckets (internal helper)
+ * @param table: Target table
+ * @param key: Key to search for
+ * @param hash: Full hash of key
+ * @return: Matching entry or NULL
+ */
+static inline HashEntry *hashtable_find_entry(const HashTable *table, const void *key, size_t hash) {
+    size_t visited = 0;
+    HashEntry *found = NULL;
+    if (hashtable_is_rehashing(table)) {
+        found = hashtable_walk_chain(table, table->old_buckets[hash % table->old_capacity], key, hash, &visited);
+    }
+    if (!found) found = hashtable_walk_chain(table, table->buckets[hash % table->capacity], key, hash, &visited);
+    DS_STATS_PROBE(DS_STATS_HASHTABLE, visited);
+    return found;
 }
 
 /**
@@ -275,26 +476,27 @@ static inline void hashtable_resize(HashTable *table, size_t new_capacity) {
  * @return: true if successful
  */
 static inline bool hashtable_put(HashTable *table, const void *key, void *value) {
+    hashtable_rehash_step(table, HASHTABLE_REHASH_STEP);
+    size_t hash = hashtable_hash_key(table, key);
+    
+    // Search for existing key
+    HashEntry *existing = hashtable_find_entry(table, key, hash);
+    if (existing) {
+        existing->value = value; // Update existing
+        return true;
+    }
+    
     // Resize if load factor exceeded
     if ((double)table->size >= table->load_factor_threshold * table->capacity) {
         hashtable_resize(table, table->capacity * HASHTABLE_GROWTH_FACTOR);
     }
     
-    size_t index = table->hash_func->hash(key, table->capacity);
+    size_t index = hash % table->capacity;
     
-    // Search for existing key
-    HashEntry *current = table->buckets[index];
-    while (current) {
-        if (table->hash_func->key_equals(current->key, key)) {
-            current->value = value; // Update existing
-            return true;
-        }
-        current = current->next;
-    }
-    
-    // Insert new entry at head of chain
-    HashEntry *new_entry = hashtable_create_entry(key, value, table->hash_func);
+    // Insert new entry at head of chain (always into the newest array)
+    HashEntry *new_entry = hashtable_create_entry(key, value, table->hash_func, table->allocator);
     if (!new_entry) return false;
+    new_entry->hash = hash;
     
     new_entry->next = table->buckets[index];
     table->buckets[index] = new_entry;
@@ -303,6 +505,29 @@ static inline bool hashtable_put(HashTable *table, const void *key, void *value)
     return true;
 }
 
+/**
+ * Insert a key known to be absent under its cached full hash
+ * No lookup, no hashing and no resize: for refilling a table of known
+ * capacity from stored entries. Inserting entries of one chain in reverse
+ * order reproduces that chain.
+ * @param table: Target table (not rehashing)
+ * @param key: Key to insert (must not be present)
+ * @param value: Value to associate
+ * @param hash: Full hash of key, as hash(key, SIZE_MAX) returns it
+ * @return: true if successful
+ */
+static inline bool hashtable_insert_hashed(HashTable *table, const void *key, void *value, size_t hash) {
+    HashEntry *new_entry = hashtable_create_entry(key, value, table->hash_func, table->allocator);
+    if (!new_entry) return false;
+    new_entry->hash = hash;
+
+    size_t index = hash % table->capacity;
+    new_entry->next = table->buckets[index];
+    table->buckets[index] = new_entry;
+    table->size++;
+    return true;
+}
+
 /**
  * Retrieve value by key
  * @param table: Target table
@@ -310,41 +535,45 @@ static inline bool hashtable_put(HashTable *table, const void *key, void *value)
  * @return: Associated value or NULL if not found
  */
 static inline void *hashtable_get(HashTable *table, const void *key) {
-    size_t index = table->hash_func->hash(key, table->capacity);
+    hashtable_rehash_step(table, HASHTABLE_REHASH_STEP);
     
-    HashEntry *current = table->buckets[index];
-    while (current) {
-        if (table->hash_func->key_equals(current->key, key)) {
-            return current->value;
-        }
-        current = current->next;
-    }
-    
-    return NULL; // Key not found
+    HashEntry *entry = hashtable_find_entry(table, key, hashtable_hash_key(table, key));
+    return entry ? entry->value : NULL;
 }
 
 /**
- * Remove key-value pair
+ * Retrieve value by key without advancing migration (safe during iteration)
  * @param table: Target table
+ * @param key: Key to search for
+ * @return: Associated value or NULL if not found
+ */
+static inline void *hashtable_lookup(const HashTable *table, const void *key) {
+    HashEntry *entry = hashtable_find_entry(table, key, hashtable_hash_key(table, key));
+    return entry ? entry->value : NULL;
+}
+
+/**
+ * Unlink and free key from one chain (internal helper)
+ * @param table: Owning table
+ * @param head: Chain head to search
  * @param key: Key to remove
+ * @param hash: Full hash of key
  * @return: true if key was found and removed
  */
-static inline bool hashtable_remove(HashTable *table, const void *key) {
-    size_t index = table->hash_func->hash(key, table->capacity);
-    
-    HashEntry *current = table->buckets[index];
+static inline bool hashtable_remove_from_chain(HashTable *table, HashEntry **head, const void *key, size_t hash) {
+    HashEntry *current = *head;
     HashEntry *prev = NULL;
     
     while (current) {
-        if (table->hash_func->key_equals(current->key, key)) {
+        if (current->hash == hash && table->hash_func->key_equals(current->key, key)) {
             // Remove entry from chain
             if (prev) {
                 prev->next = current->next;
             } else {
-                table->buckets[index] = current->next;
+                *head = current->next;
             }
             
-            hashtable_free_entry(current, table->hash_func);
+            hashtable_free_entry(current, table->hash_func, table->allocator);
             table->size--;
             return true;
         }
@@ -352,7 +581,28 @@ static inline bool hashtable_remove(HashTable *table, const void *key) {
         current = current->next;
     }
     
-    return false; // Key not found
+    return false;
+}
+
+/**
+ * Remove key-value pair
+ * @param table: Target table
+ * @param key: Key to remove
+ * @return: true if key was found and removed
+ */
+static inline bool hashtable_remove(HashTable *table, const void *key) {
+    hashtable_rehash_step(table, HASHTABLE_REHASH_STEP);
+    size_t hash = hashtable_hash_key(table, key);
+    
+    if (hashtable_is_rehashing(table)) {
+        size_t old_index = hash % table->old_capacity;
+        if (hashtable_remove_from_chain(table, &table->old_buckets[old_index], key, hash)) {
+            return true;
+        }
+    }
+    
+    size_t index = hash % table->capacity;
+    return hashtable_remove_from_chain(table, &table->buckets[index], key, hash); // false if not found
 }
 
 /**
@@ -388,11 +638,25 @@ static inline bool hashtable_is_empty(HashTable *table) {
  * @param table: Target table
  */
 static inline void hashtable_clear(HashTable *table) {
+    // Pending entries in the old array are freed first, then the array itself
+    for (size_t i = 0; i < table->old_capacity; i++) {
+        HashEntry *current = table->old_buckets[i];
+        while (current) {
+            HashEntry *next = current->next;
+            hashtable_free_entry(current, table->hash_func, table->allocator);
+            current = next;
+        }
+    }
+    free(table->old_buckets);
+    table->old_buckets = NULL;
+    table->old_capacity = 0;
+    table->rehash_index = 0;
+    
     for (size_t i = 0; i < table->capacity; i++) {
         HashEntry *current = table->buckets[i];
         while (current) {
             HashEntry *next = current->next;
-            hashtable_free_entry(current, table->hash_func);
+            hashtable_free_entry(current, table->hash_func, table->allocator);
             current = next;
         }
         table->buckets[i] = NULL;
@@ -405,12 +669,60 @@ static inline void hashtable_clear(HashTable *table) {
  * @param table: Table to free
  */
 static inline void hashtable_free(HashTable *table) {
-    hashtable_clear(table);
+    // Region allocators reclaim entries in bulk; only walk if keys need freeing
+    if (allocator_frees_in_bulk(table->allocator) && !table->hash_func->key_free) {
+        free(table->old_buckets);
+        table->old_buckets = NULL;
+        table->old_capacity = 0;
+        table->size = 0;
+    } else {
+        hashtable_clear(table);
+    }
     free(table->buckets);
     table->buckets = NULL;
     table->capacity = 0;
 }
 
+// ==================== ITERATION ====================
+
+/**
+ * Start iterating over all entries
+ * Lookups via hashtable_lookup are safe meanwhile; put/get/remove on the
+ * same table may migrate buckets and invalidate the iterator.
+ * @param it: Iterator to initialize
+ * @param table: Table to iterate
+ */
+static inline void hashtable_iter_init(HashTableIterator *it, const HashTable *table) {
+    it->table = table;
+    it->entry = NULL;
+    it->bucket = 0;
+    it->in_old = hashtable_is_rehashing(table);
+}
+
+/**
+ * Advance iterator
+ * @param it: Iterator
+ * @return: Next entry, NULL when exhausted
+ */
+static inline HashEntry *hashtable_iter_next(HashTableIterator *it) {
+    while (!it->entry) {
+        HashEntry **buckets = it->in_old ? it->table->old_buckets : it->table->buckets;
+        size_t capacity = it->in_old ? it->table->old_capacity : it->table->capacity;
+        
+        if (it->bucket >= capacity) {
+            if (!it->in_old) return NULL;
+            it->in_old = false; // Old array done, continue with new one
+            it->bucket = 0;
+            continue;
+        }
+        it->entry = buckets[it->bucket++];
+    }
+    
+    HashEntry *current = it->entry;
+    it->entry = current->next;
+    return current;
+}
+
 // ==================== UTILITY FUNCTIONS ====================
 
 /**
@@ -444,6 +756,15 @@ static inline size_t hashtable_empty_buckets(HashTable *table) {
  */
 static inline size_t hashtable_max_chain_length(HashTable *table) {
     size_t max_length = 0;
+    for (size_t i = table->rehash_index; i < table->old_capacity; i++) {
+        size_t chain_length = 0;
+        for (HashEntry *current = table->old_buckets[i]; current; current = current->next) {
+            chain_length++;
+        }
+        if (chain_length > max_length) {
+            max_length = chain_length;
+        }
+    }
     for (size_t i = 0; i < table->capacity; i++) {
         size_t chain_length = 0;
         HashEntry *current = table->buckets[i];
@@ -471,6 +792,12 @@ static inline void hashtable_print_stats(HashTable *table) {
            hashtable_empty_buckets(table), 
            100.0 * hashtable_empty_buckets(table) / table->capacity);
     printf("  Max Chain Length: %zu\n", hashtable_max_chain_length(table));
+    printf("  Rehash Mode: %s\n", table->incremental ? "incremental" : "stop-the-world");
+    if (hashtable_is_rehashing(table)) {
+        printf("  Rehashing: %zu/%zu old buckets migrated (%.1f%%)\n",
+               table->rehash_index, table->old_capacity,
+               100.0 * table->rehash_index / table->old_capacity);
+    }
 }
 
 // ==================== CONVENIENCE FUNCTIONS ====================
@@ -0,0 +1,130 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include "flat_hashtable.h"
+#include "../allocator/arena.h"
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * STRING INTERNER
+ *
+ * Maps each distinct string to a dense 32-bit id (0, 1, 2, ... in order of
+ * first use) and stores one copy of it. Copies live back to back in an arena;
+ * a flat hash table from string to id borrows those copies as keys, so
+ * interning an existing string costs one hash and one compare and copies
+ * nothing. Ids can index plain arrays and compare as integers.
+ *
+ * Strings are never removed; the interner is freed as a whole.
+ *
+ * Time Complexities:
+ * - Intern / Lookup: O(len) average (one hash)
+ * - String of id: O(1)
+ *
+ * Space Complexity: O(total distinct bytes + distinct count)
+ */
+
+// Returned by lookup for unknown strings
+#define STRING_INTERNER_NONE UINT32_MAX
+
+// String interner structure
+typedef struct StringInterner {
+    Arena arena;          // Interned string bytes
+    FlatHashTable ids;    // string -> id + 1 (keys borrowed from the arena)
+    const char **strings; // id -> string
+    size_t count;         // Distinct strings
+    size_t capacity;      // Slots in strings
+} StringInterner;
+
+// ==================== CORE OPERATIONS ====================
+
+/**
+ * Initialize empty interner
+ * @param interner: Interner to initialize
+ */
+static inline void string_interner_init(StringInterner *interner) {
+    arena_init(&interner->arena, 0);
+    flat_hashtable_init_string(&interner->ids);
+    interner->strings = NULL;
+    interner->count = 0;
+    interner->capacity = 0;
+}
+
+/**
+ * Find id of a string without adding it
+ * @param interner: Target interner
+ * @param string: NUL-terminated string
+ * @return: Id, or STRING_INTERNER_NONE if never interned
+ */
+static inline uint32_t string_interner_lookup(const StringInterner *interner, const char *string) {
+    void *slot = flat_hashtable_get(&interner->ids, string);
+    return slot ? (uint32_t)((uintptr_t)slot - 1) : STRING_INTERNER_NONE;
+}
+
+/**
+ * Get id of a string, storing a copy on first use
+ * @param interner: Target interner
+ * @param string: NUL-terminated string (not retained)
+ * @return: Dense id
+ */
+static inline uint32_t string_interner_intern(StringInterner *interner, const char *string) {
+    uint32_t id = string_interner_lookup(interner, string);
+    if (id != STRING_INTERNER_NONE) return id;
+
+    if (interner->count == interner->capacity) {
+        size_t capacity = interner->capacity ? interner->capacity * 2 : 16;
+        const char **strings = (const char **)realloc((void *)interner->strings, capacity * sizeof(const char *));
+        if (!strings) {
+            fprintf(stderr, "string_interner_intern: allocation failed\n");
+            exit(EXIT_FAILURE);
+        }
+        interner->strings = strings;
+        interner->capacity = capacity;
+    }
+    size_t length = strlen(string) + 1;
+    char *copy = (char *)arena_alloc(&interner->arena, length);
+    if (!copy || interner->count >= STRING_INTERNER_NONE) {
+        fprintf(stderr, "string_interner_intern: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(copy, string, length);
+
+    id = (uint32_t)interner->count;
+    interner->strings[interner->count++] = copy;
+    flat_hashtable_put(&interner->ids, copy, (void *)(uintptr_t)(id + 1));
+    return id;
+}
+
+/**
+ * Get the string for an id
+ * @param interner: Target interner
+ * @param id: Id from intern
+ * @return: Interned copy, NULL if id is out of range
+ */
+static inline const char *string_interner_string(const StringInterner *interner, uint32_t id) {
+    return id < interner->count ? interner->strings[id] : NULL;
+}
+
+/**
+ * Get number of distinct strings
+ * @param interner: Target interner
+ * @return: Count (ids are 0..count-1)
+ */
+static inline size_t string_interner_count(const StringInterner *interner) {
+    return interner->count;
+}
+
+/**
+ * Free interner and every interned string
+ * @param interner: Interner to free
+ */
+static inline void string_interner_free(StringInterner *interner) {
+    flat_hashtable_free(&interner->ids);
+    arena_destroy(&interner->arena);
+    free((void *)interner->strings);
+    interner->strings = NULL;
+    interner->count = 0;
+    interner->capacity = 0;
+}
+
+#endif // STRING_INTERNER_H
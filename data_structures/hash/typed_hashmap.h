@@ -0,0 +1,233 @@
+#ifndef TYPED_HASHMAP_H
+#define TYPED_HASHMAP_H
+
+#include "fast_hash.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * TYPED HASH MAP (MACRO-GENERATED)
+ *
+ * DEFINE_HASHMAP(Name, K, V, HASH, EQ) generates an open-addressing hash map
+ * `Name` with keys of type K and values of type V stored by value, side by
+ * side in one slot array. HASH(k) returns a uint64_t and EQ(a, b) returns
+ * non-zero for equal keys; both are expanded inline at compile time.
+ *
+ * Same scheme as FlatHashTable: Robin Hood linear probing with a control byte
+ * per slot holding probe distance + 1 (0 = empty), Fibonacci indexing on a
+ * power-of-two capacity and backward-shift deletion, so no tombstones and no
+ * re-hashing on delete. The map never owns what K or V point to.
+ *
+ * Usage:
+ *   DEFINE_HASHMAP(IntPlayerMap, int, Player *, TYPED_HASH_INT, TYPED_EQ)
+ *   IntPlayerMap m; IntPlayerMap_init(&m, 0); IntPlayerMap_put(&m, 23, p);
+ *   Player **found = IntPlayerMap_get(&m, 23);
+ *
+ * Time Complexities:
+ * - Put / Get / Remove: O(1) average
+ *
+ * Space Complexity: O(m * (sizeof(K) + sizeof(V) + 1)), m >= n / load factor
+ */
+
+// Configuration constants
+#define TYPED_HASHMAP_MIN_SIZE 8
+#define TYPED_HASHMAP_LOAD_NUM 7 // Grow when size > 7/8 of capacity
+#define TYPED_HASHMAP_LOAD_DEN 8
+#define TYPED_HASHMAP_MAX_PROBE 254 // Control byte holds probe distance + 1
+
+// ==================== KEY HELPERS ====================
+
+/**
+ * Mix a 64-bit integer into a well-distributed hash (splitmix64 finalizer)
+ * @param x: Input value
+ * @return: Hash value
+ */
+static inline uint64_t typed_hash_u64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+#define TYPED_HASH_INT(k) typed_hash_u64((uint64_t)(k))
+#define TYPED_HASH_PTR(k) typed_hash_u64((uint64_t)(uintptr_t)(k))
+#define TYPED_HASH_STR(k) fast_hash_string(k)
+#define TYPED_EQ(a, b) ((a) == (b))
+#define TYPED_STR_EQ(a, b) (strcmp((a), (b)) == 0)
+
+#define DEFINE_HASHMAP(Name, K, V, HASH, EQ)                                     \
+                                                                                 \
+typedef struct Name##_Slot {                                                     \
+    K key;                                                                       \
+    V value;                                                                     \
+} Name##_Slot;                                                                   \
+                                                                                 \
+typedef struct Name {                                                            \
+    uint8_t *ctrl;       /* 0 = empty, else probe distance + 1 */                \
+    Name##_Slot *slots;  /* Keys and values by value */                          \
+    size_t size;         /* Number of entries */                                 \
+    size_t capacity;     /* Number of slots (power of two) */                    \
+    unsigned shift;      /* 64 - log2(capacity), for Fibonacci indexing */       \
+} Name;                                                                          \
+                                                                                 \
+/* Home slot of a key (internal helper) */                                       \
+static inline size_t Name##_home(const Name *map, K key) {                       \
+    return (size_t)(((uint64_t)(HASH(key)) * 0x9E3779B97F4A7C15ULL) >> map->shift); \
+}                                                                                \
+                                                                                 \
+/* Allocate empty arrays for capacity (internal helper) */                       \
+static inline void Name##_allocate(Name *map, size_t capacity) {                 \
+    size_t cap = TYPED_HASHMAP_MIN_SIZE;                                         \
+    unsigned bits = 3;                                                           \
+    while (cap < capacity) { cap <<= 1; bits++; }                                \
+    map->ctrl = (uint8_t *)calloc(cap, sizeof(uint8_t));                         \
+    map->slots = (Name##_Slot *)malloc(cap * sizeof(Name##_Slot));               \
+    if (!map->ctrl || !map->slots) {                                             \
+        fprintf(stderr, #Name "_allocate: allocation failed\n");                 \
+        exit(EXIT_FAILURE);                                                      \
+    }                                                                            \
+    map->size = 0;                                                               \
+    map->capacity = cap;                                                         \
+    map->shift = 64 - bits;                                                      \
+}                                                                                \
+                                                                                 \
+/* Initialize map able to hold expected entries without resizing */             \
+static inline void Name##_init(Name *map, size_t expected) {                     \
+    Name##_allocate(map, expected * TYPED_HASHMAP_LOAD_DEN / TYPED_HASHMAP_LOAD_NUM + 1); \
+}                                                                                \
+                                                                                 \
+static inline void Name##_resize(Name *map, size_t new_capacity);                \
+                                                                                 \
+/* Robin Hood insert of an absent key, growing until it fits (internal) */       \
+static inline void Name##_insert_new(Name *map, Name##_Slot slot) {              \
+    size_t mask = map->capacity - 1;                                             \
+    size_t index = Name##_home(map, slot.key);                                   \
+    unsigned dist = 1;                                                           \
+    while (map->ctrl[index] != 0) {                                              \
+        if (map->ctrl[index] < dist) { /* Steal from the richer entry */         \
+            Name##_Slot evicted = map->slots[index];                             \
+            unsigned evicted_dist = map->ctrl[index];                            \
+            map->slots[index] = slot;                                            \
+            map->ctrl[index] = (uint8_t)dist;                                    \
+            slot = evicted;                                                      \
+            dist = evicted_dist;                                                 \
+        }                                                                        \
+        index = (index + 1) & mask;                                              \
+        if (++dist > TYPED_HASHMAP_MAX_PROBE) {                                  \
+            /* Probe overflow: grow, then place the carried slot */              \
+            Name##_resize(map, map->capacity * 2);                               \
+            Name##_insert_new(map, slot);                                        \
+            return;                                                              \
+        }                                                                        \
+    }                                                                            \
+    map->slots[index] = slot;                                                    \
+    map->ctrl[index] = (uint8_t)dist;                                            \
+    map->size++;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Rebuild into a larger slot array (internal helper) */                         \
+static inline void Name##_resize(Name *map, size_t new_capacity) {               \
+    uint8_t *old_ctrl = map->ctrl;                                               \
+    Name##_Slot *old_slots = map->slots;                                         \
+    size_t old_capacity = map->capacity;                                         \
+    Name##_allocate(map, new_capacity);                                          \
+    for (size_t i = 0; i < old_capacity; i++) {                                  \
+        if (old_ctrl[i]) Name##_insert_new(map, old_slots[i]);                   \
+    }                                                                            \
+    free(old_ctrl);                                                              \
+    free(old_slots);                                                             \
+}                                                                                \
+                                                                                 \
+/* Find slot index of key, or capacity if absent (internal helper) */            \
+static inline size_t Name##_find_index(const Name *map, K key) {                 \
+    size_t mask = map->capacity - 1;                                             \
+    size_t index = Name##_home(map, key);                                        \
+    for (unsigned dist = 1; dist <= map->ctrl[index]; dist++) {                  \
+        if (EQ(map->slots[index].key, key)) return index;                        \
+        index = (index + 1) & mask;                                              \
+    }                                                                            \
+    return map->capacity;                                                        \
+}                                                                                \
+                                                                                 \
+/* Insert or update; true if the key was new */                                  \
+static inline bool Name##_put(Name *map, K key, V value) {                       \
+    size_t index = Name##_find_index(map, key);                                  \
+    if (index < map->capacity) {                                                 \
+        map->slots[index].value = value;                                         \
+        return false;                                                            \
+    }                                                                            \
+    if ((map->size + 1) * TYPED_HASHMAP_LOAD_DEN > map->capacity * TYPED_HASHMAP_LOAD_NUM) { \
+        Name##_resize(map, map->capacity * 2);                                   \
+    }                                                                            \
+    Name##_Slot slot;                                                            \
+    slot.key = key;                                                              \
+    slot.value = value;                                                          \
+    Name##_insert_new(map, slot);                                                \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Pointer to value for key, NULL if absent (invalidated by put/remove) */       \
+static inline V *Name##_get(const Name *map, K key) {                            \
+    size_t index = Name##_find_index(map, key);                                  \
+    return index < map->capacity ? &map->slots[index].value : NULL;              \
+}                                                                                \
+                                                                                 \
+static inline bool Name##_contains(const Name *map, K key) {                     \
+    return Name##_find_index(map, key) < map->capacity;                          \
+}                                                                                \
+                                                                                 \
+/* Remove key, value into *out (may be NULL); false if absent */                 \
+static inline bool Name##_remove(Name *map, K key, V *out) {                     \
+    size_t index = Name##_find_index(map, key);                                  \
+    if (index == map->capacity) return false;                                    \
+    if (out) *out = map->slots[index].value;                                     \
+    size_t mask = map->capacity - 1;                                             \
+    size_t next = (index + 1) & mask;                                            \
+    while (map->ctrl[next] > 1) { /* Backward shift displaced successors */      \
+        map->slots[index] = map->slots[next];                                    \
+        map->ctrl[index] = (uint8_t)(map->ctrl[next] - 1);                       \
+        index = next;                                                            \
+        next = (next + 1) & mask;                                                \
+    }                                                                            \
+    map->ctrl[index] = 0;                                                        \
+    map->size--;                                                                 \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Advance iterator *pos (start at 0); false when exhausted */                   \
+static inline bool Name##_next(const Name *map, size_t *pos, K *key, V *value) { \
+    while (*pos < map->capacity) {                                               \
+        size_t i = (*pos)++;                                                     \
+        if (map->ctrl[i]) {                                                      \
+            if (key) *key = map->slots[i].key;                                   \
+            if (value) *value = map->slots[i].value;                             \
+            return true;                                                         \
+        }                                                                        \
+    }                                                                            \
+    return false;                                                                \
+}                                                                                \
+                                                                                 \
+static inline size_t Name##_size(const Name *map) { return map->size; }          \
+static inline bool Name##_is_empty(const Name *map) { return map->size == 0; }   \
+                                                                                 \
+/* Remove all entries, keeping capacity */                                       \
+static inline void Name##_clear(Name *map) {                                     \
+    memset(map->ctrl, 0, map->capacity);                                         \
+    map->size = 0;                                                               \
+}                                                                                \
+                                                                                 \
+/* Free map memory */                                                            \
+static inline void Name##_free(Name *map) {                                      \
+    free(map->ctrl);                                                             \
+    free(map->slots);                                                            \
+    map->ctrl = NULL;                                                            \
+    map->slots = NULL;                                                           \
+    map->size = 0;                                                               \
+    map->capacity = 0;                                                           \
+}
+
+#endif // TYPED_HASHMAP_H
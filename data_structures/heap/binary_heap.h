@@ -3,6 +3,7 @@
 
 #include "heap_interface.h"
 #include "../dynarray/dynarray.h"
+#include "../stats/ds_stats.h"
 #include <stdio.h>
 #include <stdbool.h>
 
@@ -18,6 +19,10 @@
  * - Extract root: O(log n)
  * - Peek: O(1)
  * - Build from array: O(n)
+ * - Merge: O(n + m)
+ * - Push many (k): O(min(k log n, n + k))
+ * - Top-k (non-destructive walk): O(k log k)
+ * - Top-k of a stream (HeapTopK): O(n log k)
  *
  * Space Complexity: O(n)
  *
@@ -50,56 +55,87 @@ static inline void binary_heap_swap(BinaryHeap *heap, size_t i, size_t j) {
 
 /**
  * Restore heap property by moving element up
+ * Moves a hole instead of swapping, one store per level.
  * @param heap: Target heap
  * @param index: Starting index
  */
 static inline void binary_heap_heapify_up(BinaryHeap *heap, size_t index) {
+    void **data = heap->data.data;
+    void *element = data[index];
+    size_t levels = 0;
+    
     while (index > 0) {
         size_t parent_idx = HEAP_PARENT(index);
-        void *current = dynarray_get(&heap->data, index);
-        void *parent = dynarray_get(&heap->data, parent_idx);
-        
-        if (heap->compare(current, parent) >= 0) break;
-        
-        binary_heap_swap(heap, index, parent_idx);
+        if (heap->compare(element, data[parent_idx]) >= 0) break;
+        data[index] = data[parent_idx];
         index = parent_idx;
+        levels++;
     }
+    data[index] = element;
+    DS_STATS_SIFT(DS_STATS_BINARY_HEAP, levels);
 }
 
 /**
  * Restore heap property by moving element down
+ * Moves a hole instead of swapping, one store per level.
  * @param heap: Target heap
  * @param index: Starting index
  */
 static inline void binary_heap_heapify_down(BinaryHeap *heap, size_t index) {
+    void **data = heap->data.data;
     size_t size = dynarray_size(&heap->data);
+    void *element = data[index];
+    size_t levels = 0;
     
     while (true) {
-        size_t target = index;
-        size_t left = HEAP_LEFT_CHILD(index);
-        size_t right = HEAP_RIGHT_CHILD(index);
+        size_t child = HEAP_LEFT_CHILD(index);
+        if (child >= size) break;
         
-        // Find smallest/largest among parent and children
-        if (left < size) {
-            void *current = dynarray_get(&heap->data, target);
-            void *left_data = dynarray_get(&heap->data, left);
-            if (heap->compare(left_data, current) < 0) {
-                target = left;
-            }
+        // Pick the child that belongs higher
+        if (child + 1 < size && heap->compare(data[child + 1], data[child]) < 0) {
+            child++;
         }
+        if (heap->compare(data[child], element) >= 0) break; // Heap property satisfied
         
-        if (right < size) {
-            void *target_data = dynarray_get(&heap->data, target);
-            void *right_data = dynarray_get(&heap->data, right);
-            if (heap->compare(right_data, target_data) < 0) {
-                target = right;
-            }
+        data[index] = data[child];
+        index = child;
+        levels++;
+    }
+    data[index] = element;
+    DS_STATS_SIFT(DS_STATS_BINARY_HEAP, levels);
+}
+
+/**
+ * Heapify whole array bottom-up in O(n) (internal helper)
+ * @param heap: Target heap
+ */
+static inline void binary_heap_heapify_all(BinaryHeap *heap) {
+    size_t count = dynarray_size(&heap->data);
+    if (count > 1) {
+        size_t last_parent = HEAP_PARENT(count - 1);
+        for (size_t i = last_parent + 1; i > 0; i--) {
+            binary_heap_heapify_down(heap, i - 1);
         }
-        
-        if (target == index) break; // Heap property satisfied
-        
-        binary_heap_swap(heap, index, target);
-        index = target;
+    }
+}
+
+/**
+ * Restore heap after appending `added` elements at the end (internal helper)
+ * Sifts each new element up when few were added, otherwise rebuilds in O(n).
+ * @param heap: Target heap
+ * @param added: Number of elements appended since the heap was valid
+ */
+static inline void binary_heap_restore_after_append(BinaryHeap *heap, size_t added) {
+    size_t size = dynarray_size(&heap->data);
+    size_t log_size = 1;
+    while ((size >> log_size) > 0) log_size++;
+    
+    if (added * log_size < size) {
+        for (size_t i = size - added; i < size; i++) {
+            binary_heap_heapify_up(heap, i);
+        }
+    } else {
+        binary_heap_heapify_all(heap);
     }
 }
 
@@ -197,12 +233,40 @@ static inline void binary_heap_build_from_array(BinaryHeap *heap, void **element
     }
     
     // Heapify from last parent down to root
-    if (count > 1) {
-        size_t last_parent = HEAP_PARENT(count - 1);
-        for (size_t i = last_parent + 1; i > 0; i--) {
-            binary_heap_heapify_down(heap, i - 1);
-        }
+    binary_heap_heapify_all(heap);
+}
+
+/**
+ * Insert many elements at once
+ * @param heap: Target heap
+ * @param elements: Elements to insert
+ * @param count: Number of elements
+ */
+static inline void binary_heap_push_many(BinaryHeap *heap, void **elements, size_t count) {
+    dynarray_reserve(&heap->data, dynarray_size(&heap->data) + count);
+    for (size_t i = 0; i < count; i++) {
+        dynarray_push(&heap->data, elements[i]);
+    }
+    binary_heap_restore_after_append(heap, count);
+}
+
+/**
+ * Extract up to max root elements in heap order
+ * @param heap: Target heap
+ * @param out: Destination array
+ * @param max: Capacity of out
+ * @return: Number of elements extracted
+ */
+static inline size_t binary_heap_pop_many(BinaryHeap *heap, void **out, size_t max) {
+    size_t count = 0;
+    void **data = heap->data.data;
+    // Pops in place, skipping dynarray_pop's per-call shrink check
+    while (count < max && heap->data.size > 0) {
+        out[count++] = data[0];
+        data[0] = data[--heap->data.size];
+        if (heap->data.size > 1) binary_heap_heapify_down(heap, 0);
     }
+    return count;
 }
 
 /**
@@ -277,15 +341,14 @@ static inline bool binary_heap_is_valid(BinaryHeap *heap) {
 }
 
 /**
- * Merge two heaps (inefficient for binary heaps)
+ * Merge two heaps by concatenating and re-heapifying in O(n + m)
+ * (sifts the new elements up instead when heap2 is small)
  * @param heap1: Destination heap
  * @param heap2: Source heap (will be emptied)
  */
 static inline void binary_heap_merge(BinaryHeap *heap1, BinaryHeap *heap2) {
-    while (!binary_heap_is_empty(heap2)) {
-        void *element = binary_heap_pop(heap2);
-        binary_heap_push(heap1, element);
-    }
+    binary_heap_push_many(heap1, heap2->data.data, dynarray_size(&heap2->data));
+    dynarray_clear(&heap2->data);
 }
 
 /**
@@ -337,6 +400,217 @@ static inline void binary_heap_print(BinaryHeap *heap, void (*print_element)(voi
     }
 }
 
+// ==================== TOP-K SELECTION ====================
+
+// Bounded collector keeping the k best elements of a stream.
+// "Best" follows heap order: compare(a, b) < 0 means a ranks above b. The
+// kept elements form a heap with the worst one at the root, so each offer is
+// O(1) when rejected and O(log k) when kept: O(n log k) over n elements.
+typedef struct HeapTopK {
+    void **items;            // Kept elements, worst at index 0
+    size_t size;             // Elements kept so far
+    size_t k;                // Capacity
+    heap_compare_fn compare; // Ranking (heap order of the source)
+} HeapTopK;
+
+/**
+ * Initialize top-k collector
+ * @param top: Collector to initialize
+ * @param k: Number of elements to keep
+ * @param compare: Ranking, negative when first argument ranks higher
+ */
+static inline void heap_top_k_init(HeapTopK *top, size_t k, heap_compare_fn compare) {
+    top->items = (void **)malloc((k > 0 ? k : 1) * sizeof(void *));
+    if (!top->items) {
+        fprintf(stderr, "heap_top_k_init: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    top->size = 0;
+    top->k = k;
+    top->compare = compare;
+}
+
+/**
+ * Restore worst-at-root order below index (internal helper)
+ * @param top: Target collector
+ * @param index: Starting index
+ */
+static inline void heap_top_k_sift_down(HeapTopK *top, size_t index) {
+    void *element = top->items[index];
+    while (true) {
+        size_t child = HEAP_LEFT_CHILD(index);
+        if (child >= top->size) break;
+        size_t right = child + 1;
+        if (right < top->size && top->compare(top->items[right], top->items[child]) > 0) {
+            child = right; // Right child ranks lower
+        }
+        if (top->compare(top->items[child], element) <= 0) break;
+        top->items[index] = top->items[child];
+        index = child;
+    }
+    top->items[index] = element;
+}
+
+/**
+ * Offer element to collector
+ * @param top: Target collector
+ * @param element: Candidate
+ * @return: true if element is currently among the k best
+ */
+static inline bool heap_top_k_offer(HeapTopK *top, void *element) {
+    if (top->k == 0) return false;
+
+    if (top->size < top->k) {
+        // Sift up: better elements sink toward the leaves
+        size_t index = top->size++;
+        while (index > 0) {
+            size_t parent = HEAP_PARENT(index);
+            if (top->compare(element, top->items[parent]) <= 0) break;
+            top->items[index] = top->items[parent];
+            index = parent;
+        }
+        top->items[index] = element;
+        return true;
+    }
+
+    // Full: replace the worst kept element only if the candidate ranks higher
+    if (top->compare(element, top->items[0]) >= 0) return false;
+    top->items[0] = element;
+    heap_top_k_sift_down(top, 0);
+    return true;
+}
+
+/**
+ * Extract kept elements best-first and empty the collector
+ * @param top: Target collector
+ * @param out: Destination, room for k elements
+ * @return: Number of elements written
+ */
+static inline size_t heap_top_k_finish(HeapTopK *top, void **out) {
+    size_t count = top->size;
+    // Popping the worst each time fills out from the back
+    while (top->size > 0) {
+        out[top->size - 1] = top->items[0];
+        top->items[0] = top->items[--top->size];
+        if (top->size > 0) heap_top_k_sift_down(top, 0);
+    }
+    return count;
+}
+
+/**
+ * Free collector memory
+ * @param top: Target collector
+ */
+static inline void heap_top_k_free(HeapTopK *top) {
+    free(top->items);
+    top->items = NULL;
+    top->size = 0;
+    top->k = 0;
+}
+
+/**
+ * Select the k best elements of an array in O(n log k)
+ * @param elements: Source array (not modified)
+ * @param count: Number of source elements
+ * @param k: Number to select
+ * @param compare: Ranking, negative when first argument ranks higher
+ * @param out: Destination, room for k elements, written best-first
+ * @return: Number of elements written (min(k, count))
+ */
+static inline size_t binary_heap_select_top_k(void **elements, size_t count, size_t k,
+                                              heap_compare_fn compare, void **out) {
+    HeapTopK top;
+    heap_top_k_init(&top, k, compare);
+    for (size_t i = 0; i < count; i++) {
+        heap_top_k_offer(&top, elements[i]);
+    }
+    size_t written = heap_top_k_finish(&top, out);
+    heap_top_k_free(&top);
+    return written;
+}
+
+/**
+ * Restore best-at-root order of the frontier below index (internal helper)
+ * @param heap: Heap the frontier indexes into
+ * @param frontier: Array of heap indices
+ * @param size: Frontier size
+ * @param index: Starting position
+ */
+static inline void binary_heap_frontier_sift_down(BinaryHeap *heap, size_t *frontier, size_t size, size_t index) {
+    size_t slot = frontier[index];
+    while (true) {
+        size_t child = HEAP_LEFT_CHILD(index);
+        if (child >= size) break;
+        if (child + 1 < size &&
+            heap->compare(dynarray_get(&heap->data, frontier[child + 1]),
+                          dynarray_get(&heap->data, frontier[child])) < 0) {
+            child++;
+        }
+        if (heap->compare(dynarray_get(&heap->data, frontier[child]), dynarray_get(&heap->data, slot)) >= 0) break;
+        frontier[index] = frontier[child];
+        index = child;
+    }
+    frontier[index] = slot;
+}
+
+/**
+ * Push heap index onto frontier (internal helper)
+ * @param heap: Heap the frontier indexes into
+ * @param frontier: Array of heap indices
+ * @param size: Frontier size before the push
+ * @param slot: Heap index to add
+ */
+static inline void binary_heap_frontier_push(BinaryHeap *heap, size_t *frontier, size_t size, size_t slot) {
+    size_t index = size;
+    while (index > 0) {
+        size_t parent = HEAP_PARENT(index);
+        if (heap->compare(dynarray_get(&heap->data, slot), dynarray_get(&heap->data, frontier[parent])) >= 0) break;
+        frontier[index] = frontier[parent];
+        index = parent;
+    }
+    frontier[index] = slot;
+}
+
+/**
+ * Read the k best elements of a heap without modifying it, O(k log k)
+ * Walks the heap from the root with a frontier of candidate positions: the
+ * next best element is always a child of one already reported.
+ * @param heap: Source heap (unchanged)
+ * @param k: Number of elements wanted
+ * @param out: Destination, room for k elements, written in heap order
+ * @return: Number of elements written (min(k, size))
+ */
+static inline size_t binary_heap_top_k(BinaryHeap *heap, size_t k, void **out) {
+    size_t size = dynarray_size(&heap->data);
+    if (k > size) k = size;
+    if (k == 0) return 0;
+
+    // Each report removes one candidate and adds at most two
+    size_t *frontier = (size_t *)malloc((k + 1) * sizeof(size_t));
+    if (!frontier) {
+        fprintf(stderr, "binary_heap_top_k: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t frontier_size = 1;
+    frontier[0] = 0;
+    for (size_t written = 0; written < k; written++) {
+        size_t best = frontier[0];
+        out[written] = dynarray_get(&heap->data, best);
+
+        frontier[0] = frontier[--frontier_size];
+        if (frontier_size > 0) binary_heap_frontier_sift_down(heap, frontier, frontier_size, 0);
+
+        size_t left = HEAP_LEFT_CHILD(best);
+        size_t right = HEAP_RIGHT_CHILD(best);
+        if (left < size) binary_heap_frontier_push(heap, frontier, frontier_size++, left);
+        if (right < size) binary_heap_frontier_push(heap, frontier, frontier_size++, right);
+    }
+
+    free(frontier);
+    return k;
+}
+
 // ==================== INTERFACE IMPLEMENTATION ====================
 
 static void binary_heap_interface_push(void *heap, void *element) {
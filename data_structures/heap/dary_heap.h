@@ -0,0 +1,353 @@
+#ifndef DARY_HEAP_H
+#define DARY_HEAP_H
+
+#include "heap_interface.h"
+#include "../stats/ds_stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * D-ARY HEAP IMPLEMENTATION
+ *
+ * Implicit heap in which every node has d children (d = 2, 4, 8 or 16). A
+ * wider node means a tree of height log_d(n): fewer levels, more compares per
+ * level, and each level's children are contiguous. The array is placed so that
+ * element 1 starts a cache line; with 8-byte pointers the 8 children of any
+ * node of an 8-ary heap (4 for 4-ary) then share one 64-byte line.
+ *
+ * Uses the same heap_compare_fn convention as BinaryHeap: compare(a, b) < 0
+ * means a belongs closer to the root.
+ *
+ * Time Complexities:
+ * - Insert: O(log_d n)
+ * - Extract root: O(d log_d n)
+ * - Peek: O(1)
+ * - Build / Merge: O(n)
+ *
+ * Space Complexity: O(n)
+ *
+ * Array representation (root at 0, d = 1 << shift):
+ * - Parent of i: (i - 1) / d
+ * - First child of i: d * i + 1
+ */
+
+// Configuration constants
+#define DARY_HEAP_CACHE_LINE 64
+#define DARY_HEAP_DEFAULT_ARITY 4
+#define DARY_HEAP_MAX_ARITY 16
+
+// D-ary heap structure
+typedef struct DaryHeap {
+    void **data;             // Elements, &data[1] cache-line aligned
+    void *block;             // Allocation backing data
+    size_t size;             // Number of elements
+    size_t capacity;         // Slots in data
+    unsigned shift;          // log2(arity)
+    heap_compare_fn compare; // Comparison function
+} DaryHeap;
+
+// ==================== HELPER FUNCTIONS ====================
+
+/**
+ * Allocate storage with &data[1] on a cache-line boundary (internal helper)
+ * @param capacity: Slots needed
+ * @param block_out: Receives the allocation to free later
+ * @return: Element array
+ */
+static inline void **dary_heap_alloc_slots(size_t capacity, void **block_out) {
+    size_t bytes = (capacity + 1) * sizeof(void *) + DARY_HEAP_CACHE_LINE;
+    bytes = (bytes + DARY_HEAP_CACHE_LINE - 1) / DARY_HEAP_CACHE_LINE * DARY_HEAP_CACHE_LINE;
+    unsigned char *block = (unsigned char *)aligned_alloc(DARY_HEAP_CACHE_LINE, bytes);
+    if (!block) {
+        fprintf(stderr, "dary_heap_alloc_slots: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    DS_STATS_ALLOC(DS_STATS_DARY_HEAP, bytes);
+    *block_out = block;
+    return (void **)(block + DARY_HEAP_CACHE_LINE - sizeof(void *));
+}
+
+/**
+ * Grow storage to hold at least min_capacity elements (internal helper)
+ * @param heap: Target heap
+ * @param min_capacity: Required slots
+ */
+static inline void dary_heap_reserve(DaryHeap *heap, size_t min_capacity) {
+    if (min_capacity <= heap->capacity) return;
+
+    DS_STATS_TIMER(started);
+    size_t new_capacity = heap->capacity ? heap->capacity : HEAP_DEFAULT_CAPACITY;
+    while (new_capacity < min_capacity) new_capacity *= HEAP_GROWTH_FACTOR;
+
+    void *block;
+    void **data = dary_heap_alloc_slots(new_capacity, &block);
+    if (heap->size > 0) memcpy(data, heap->data, heap->size * sizeof(void *));
+    free(heap->block);
+    heap->data = data;
+    heap->block = block;
+    if (heap->capacity) DS_STATS_RESIZE(DS_STATS_DARY_HEAP, started);
+    heap->capacity = new_capacity;
+}
+
+/**
+ * Move element at index toward the root (internal helper)
+ * @param heap: Target heap
+ * @param index: Starting index
+ */
+static inline void dary_heap_sift_up(DaryHeap *heap, size_t index) {
+    void **data = heap->data;
+    void *element = data[index];
+    size_t levels = 0;
+    while (index > 0) {
+        size_t parent = (index - 1) >> heap->shift;
+        if (heap->compare(element, data[parent]) >= 0) break;
+        data[index] = data[parent];
+        index = parent;
+        levels++;
+    }
+    data[index] = element;
+    DS_STATS_SIFT(DS_STATS_DARY_HEAP, levels);
+}
+
+/**
+ * Move element at index toward the leaves (internal helper)
+ * @param heap: Target heap
+ * @param index: Starting index
+ */
+static inline void dary_heap_sift_down(DaryHeap *heap, size_t index) {
+    void **data = heap->data;
+    size_t size = heap->size;
+    void *element = data[index];
+    size_t levels = 0;
+
+    while (true) {
+        size_t first = (index << heap->shift) + 1;
+        if (first >= size) break;
+        size_t last = first + ((size_t)1 << heap->shift);
+        if (last > size) last = size;
+
+        // Best child within one contiguous block
+        size_t best = first;
+        for (size_t child = first + 1; child < last; child++) {
+            if (heap->compare(data[child], data[best]) < 0) best = child;
+        }
+        if (heap->compare(data[best], element) >= 0) break;
+
+        data[index] = data[best];
+        index = best;
+        levels++;
+    }
+    data[index] = element;
+    DS_STATS_SIFT(DS_STATS_DARY_HEAP, levels);
+}
+
+/**
+ * Heapify whole array bottom-up in O(n) (internal helper)
+ * @param heap: Target heap
+ */
+static inline void dary_heap_heapify_all(DaryHeap *heap) {
+    if (heap->size < 2) return;
+    size_t last_parent = (heap->size - 2) >> heap->shift;
+    for (size_t i = last_parent + 1; i > 0; i--) {
+        dary_heap_sift_down(heap, i - 1);
+    }
+}
+
+// ==================== CORE OPERATIONS ====================
+
+/**
+ * Initialize d-ary heap
+ * @param heap: Heap to initialize
+ * @param arity: Children per node (2, 4, 8 or 16; other values round up, 0 uses default)
+ * @param compare: Comparison function for ordering
+ * @param initial_capacity: Starting capacity
+ */
+static inline void dary_heap_init(DaryHeap *heap, unsigned arity, heap_compare_fn compare, size_t initial_capacity) {
+    if (arity == 0) arity = DARY_HEAP_DEFAULT_ARITY;
+    if (arity > DARY_HEAP_MAX_ARITY) arity = DARY_HEAP_MAX_ARITY;
+    heap->shift = 1;
+    while ((1u << heap->shift) < arity) heap->shift++;
+
+    heap->data = NULL;
+    heap->block = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+    heap->compare = compare;
+    dary_heap_reserve(heap, initial_capacity > 0 ? initial_capacity : HEAP_DEFAULT_CAPACITY);
+}
+
+/**
+ * Get children per node
+ * @param heap: Target heap
+ * @return: Arity d
+ */
+static inline unsigned dary_heap_arity(const DaryHeap *heap) {
+    return 1u << heap->shift;
+}
+
+/**
+ * Insert element into heap
+ * @param heap: Target heap
+ * @param element: Element to insert
+ */
+static inline void dary_heap_push(DaryHeap *heap, void *element) {
+    dary_heap_reserve(heap, heap->size + 1);
+    heap->data[heap->size++] = element;
+    dary_heap_sift_up(heap, heap->size - 1);
+}
+
+/**
+ * Extract root element
+ * @param heap: Target heap
+ * @return: Root element, NULL if empty
+ */
+static inline void *dary_heap_pop(DaryHeap *heap) {
+    if (heap->size == 0) return NULL;
+    void *root = heap->data[0];
+    heap->data[0] = heap->data[--heap->size];
+    if (heap->size > 1) dary_heap_sift_down(heap, 0);
+    return root;
+}
+
+/**
+ * View root element without removing
+ * @param heap: Target heap
+ * @return: Root element, NULL if empty
+ */
+static inline void *dary_heap_peek(const DaryHeap *heap) {
+    return heap->size > 0 ? heap->data[0] : NULL;
+}
+
+/**
+ * Replace root with new element
+ * @param heap: Target heap
+ * @param element: New element
+ * @return: Old root element, NULL if heap was empty
+ */
+static inline void *dary_heap_replace(DaryHeap *heap, void *element) {
+    if (heap->size == 0) {
+        dary_heap_push(heap, element);
+        return NULL;
+    }
+    void *old_root = heap->data[0];
+    heap->data[0] = element;
+    dary_heap_sift_down(heap, 0);
+    return old_root;
+}
+
+/**
+ * Build heap from array in O(n) time
+ * @param heap: Target heap (previous contents discarded)
+ * @param elements: Array of elements
+ * @param count: Number of elements
+ */
+static inline void dary_heap_build_from_array(DaryHeap *heap, void **elements, size_t count) {
+    heap->size = 0;
+    dary_heap_reserve(heap, count);
+    if (count > 0) memcpy(heap->data, elements, count * sizeof(void *));
+    heap->size = count;
+    dary_heap_heapify_all(heap);
+}
+
+/**
+ * Insert many elements at once
+ * Sifts each up when the batch is small, otherwise re-heapifies in O(n + k).
+ * @param heap: Target heap
+ * @param elements: Elements to insert
+ * @param count: Number of elements
+ */
+static inline void dary_heap_push_many(DaryHeap *heap, void **elements, size_t count) {
+    if (count == 0) return;
+    dary_heap_reserve(heap, heap->size + count);
+    memcpy(heap->data + heap->size, elements, count * sizeof(void *));
+    size_t old_size = heap->size;
+    heap->size += count;
+
+    size_t levels = 1;
+    for (size_t n = heap->size; n >>= heap->shift;) levels++;
+    if (count * levels < heap->size) {
+        for (size_t i = old_size; i < heap->size; i++) dary_heap_sift_up(heap, i);
+    } else {
+        dary_heap_heapify_all(heap);
+    }
+}
+
+/**
+ * Extract up to max root elements in heap order
+ * @param heap: Target heap
+ * @param out: Destination array
+ * @param max: Capacity of out
+ * @return: Number of elements extracted
+ */
+static inline size_t dary_heap_pop_many(DaryHeap *heap, void **out, size_t max) {
+    size_t count = 0;
+    while (count < max && heap->size > 0) {
+        out[count++] = dary_heap_pop(heap);
+    }
+    return count;
+}
+
+/**
+ * Merge two heaps by concatenating and re-heapifying in O(n + m)
+ * @param heap1: Destination heap
+ * @param heap2: Source heap (will be emptied)
+ */
+static inline void dary_heap_merge(DaryHeap *heap1, DaryHeap *heap2) {
+    dary_heap_push_many(heap1, heap2->data, heap2->size);
+    heap2->size = 0;
+}
+
+/**
+ * Get current size
+ * @param heap: Target heap
+ * @return: Number of elements
+ */
+static inline size_t dary_heap_size(const DaryHeap *heap) {
+    return heap->size;
+}
+
+/**
+ * Check if empty
+ * @param heap: Target heap
+ * @return: true if empty
+ */
+static inline bool dary_heap_is_empty(const DaryHeap *heap) {
+    return heap->size == 0;
+}
+
+/**
+ * Clear all elements
+ * @param heap: Target heap
+ */
+static inline void dary_heap_clear(DaryHeap *heap) {
+    heap->size = 0;
+}
+
+/**
+ * Free heap memory
+ * @param heap: Target heap
+ */
+static inline void dary_heap_free(DaryHeap *heap) {
+    free(heap->block);
+    heap->block = NULL;
+    heap->data = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+}
+
+/**
+ * Validate heap property (for testing)
+ * @param heap: Target heap
+ * @return: true if valid heap
+ */
+static inline bool dary_heap_is_valid(const DaryHeap *heap) {
+    for (size_t i = 1; i < heap->size; i++) {
+        if (heap->compare(heap->data[(i - 1) >> heap->shift], heap->data[i]) > 0) return false;
+    }
+    return true;
+}
+
+#endif // DARY_HEAP_H
@@ -0,0 +1,481 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include "heap_interface.h"
+#include "../stats/ds_stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * INDEXED (ADDRESSABLE) BINARY HEAP
+ *
+ * Binary heap whose elements are addressed by caller-chosen integer handles
+ * (vertex indices, player ids, ...). A handle -> position map lets an element
+ * whose key changed be moved in O(log n) instead of rebuilding the heap, and
+ * lets any element be removed directly. Handles should be dense: the map is an
+ * array sized by the largest handle pushed.
+ *
+ * Ordering follows heap_compare_fn like BinaryHeap: compare(a, b) < 0 means a
+ * belongs closer to the root. Keys live inside the elements; after changing an
+ * element in place, call indexed_heap_update_key (or decrease_key when it can
+ * only move toward the root).
+ *
+ * Time Complexities:
+ * - Push / Pop / Remove / Update key: O(log n)
+ * - Decrease key: O(log n), sift up only
+ * - Bulk push: O(n + k), or O(k log n) for small batches
+ * - Peek / Contains / Get: O(1)
+ * - Top-k (non-destructive): O(k log k)
+ *
+ * Space Complexity: O(n + max handle)
+ */
+
+// Marks a handle that is not in the heap
+#define INDEXED_HEAP_ABSENT SIZE_MAX
+
+// Indexed heap structure
+typedef struct IndexedHeap {
+    size_t *heap;            // Handles in heap order
+    size_t size;             // Elements in heap
+    size_t heap_capacity;    // Slots in heap array
+    size_t *position;        // handle -> index in heap, INDEXED_HEAP_ABSENT if not present
+    void **items;            // handle -> element
+    size_t handle_capacity;  // Length of position/items
+    heap_compare_fn compare; // Element ordering
+} IndexedHeap;
+
+// ==================== HELPER FUNCTIONS ====================
+
+/**
+ * Compare elements at two heap positions (internal helper)
+ * @param heap: Target heap
+ * @param i, j: Heap indices
+ * @return: Comparison of their elements
+ */
+static inline int indexed_heap_compare_at(const IndexedHeap *heap, size_t i, size_t j) {
+    return heap->compare(heap->items[heap->heap[i]], heap->items[heap->heap[j]]);
+}
+
+/**
+ * Place handle at heap index and record its position (internal helper)
+ * @param heap: Target heap
+ * @param index: Heap index
+ * @param handle: Handle stored there
+ */
+static inline void indexed_heap_place(IndexedHeap *heap, size_t index, size_t handle) {
+    heap->heap[index] = handle;
+    heap->position[handle] = index;
+}
+
+/**
+ * Move element at index toward the root (internal helper)
+ * @param heap: Target heap
+ * @param index: Starting index
+ * @return: Final index
+ */
+static inline size_t indexed_heap_sift_up(IndexedHeap *heap, size_t index) {
+    size_t handle = heap->heap[index];
+    void *element = heap->items[handle];
+    size_t levels = 0;
+    while (index > 0) {
+        size_t parent = HEAP_PARENT(index);
+        if (heap->compare(element, heap->items[heap->heap[parent]]) >= 0) break;
+        indexed_heap_place(heap, index, heap->heap[parent]);
+        index = parent;
+        levels++;
+    }
+    indexed_heap_place(heap, index, handle);
+    DS_STATS_SIFT(DS_STATS_INDEXED_HEAP, levels);
+    return index;
+}
+
+/**
+ * Move element at index toward the leaves (internal helper)
+ * @param heap: Target heap
+ * @param index: Starting index
+ */
+static inline void indexed_heap_sift_down(IndexedHeap *heap, size_t index) {
+    size_t handle = heap->heap[index];
+    void *element = heap->items[handle];
+    size_t levels = 0;
+    while (true) {
+        size_t child = HEAP_LEFT_CHILD(index);
+        if (child >= heap->size) break;
+        if (child + 1 < heap->size && indexed_heap_compare_at(heap, child + 1, child) < 0) {
+            child++;
+        }
+        if (heap->compare(heap->items[heap->heap[child]], element) >= 0) break;
+        indexed_heap_place(heap, index, heap->heap[child]);
+        index = child;
+        levels++;
+    }
+    indexed_heap_place(heap, index, handle);
+    DS_STATS_SIFT(DS_STATS_INDEXED_HEAP, levels);
+}
+
+/**
+ * Grow handle map to cover handle (internal helper)
+ * @param heap: Target heap
+ * @param handle: Handle that must be addressable
+ */
+static inline void indexed_heap_reserve_handle(IndexedHeap *heap, size_t handle) {
+    if (handle < heap->handle_capacity) return;
+
+    DS_STATS_TIMER(started);
+    size_t new_capacity = heap->handle_capacity ? heap->handle_capacity : HEAP_DEFAULT_CAPACITY;
+    while (new_capacity <= handle) new_capacity *= HEAP_GROWTH_FACTOR;
+
+    size_t *position = (size_t *)realloc(heap->position, new_capacity * sizeof(size_t));
+    void **items = (void **)realloc(heap->items, new_capacity * sizeof(void *));
+    if (!position || !items) {
+        fprintf(stderr, "indexed_heap_reserve_handle: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = heap->handle_capacity; i < new_capacity; i++) {
+        position[i] = INDEXED_HEAP_ABSENT;
+        items[i] = NULL;
+    }
+    heap->position = position;
+    DS_STATS_ALLOC(DS_STATS_INDEXED_HEAP, new_capacity * (sizeof(size_t) + sizeof(void *)));
+    if (heap->handle_capacity) DS_STATS_RESIZE(DS_STATS_INDEXED_HEAP, started);
+    heap->items = items;
+    heap->handle_capacity = new_capacity;
+}
+
+/**
+ * Grow heap array to hold at least min_capacity handles (internal helper)
+ * @param heap: Target heap
+ * @param min_capacity: Required slots
+ */
+static inline void indexed_heap_reserve_slots(IndexedHeap *heap, size_t min_capacity) {
+    if (min_capacity <= heap->heap_capacity) return;
+
+    DS_STATS_TIMER(started);
+    size_t new_capacity = heap->heap_capacity;
+    while (new_capacity < min_capacity) new_capacity *= HEAP_GROWTH_FACTOR;
+    size_t *grown = (size_t *)realloc(heap->heap, new_capacity * sizeof(size_t));
+    if (!grown) {
+        fprintf(stderr, "indexed_heap_reserve_slots: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    heap->heap = grown;
+    heap->heap_capacity = new_capacity;
+    DS_STATS_ALLOC(DS_STATS_INDEXED_HEAP, new_capacity * sizeof(size_t));
+    DS_STATS_RESIZE(DS_STATS_INDEXED_HEAP, started);
+}
+
+/**
+ * Heapify whole handle array bottom-up in O(n) (internal helper)
+ * @param heap: Target heap
+ */
+static inline void indexed_heap_heapify_all(IndexedHeap *heap) {
+    if (heap->size < 2) return;
+    for (size_t i = HEAP_PARENT(heap->size - 1) + 1; i > 0; i--) {
+        indexed_heap_sift_down(heap, i - 1);
+    }
+}
+
+// ==================== CORE OPERATIONS ====================
+
+/**
+ * Initialize indexed heap
+ * @param heap: Heap to initialize
+ * @param compare: Comparison function for ordering
+ * @param initial_capacity: Starting element and handle capacity
+ */
+static inline void indexed_heap_init(IndexedHeap *heap, heap_compare_fn compare, size_t initial_capacity) {
+    heap->heap_capacity = initial_capacity > 0 ? initial_capacity : HEAP_DEFAULT_CAPACITY;
+    heap->heap = (size_t *)malloc(heap->heap_capacity * sizeof(size_t));
+    if (!heap->heap) {
+        fprintf(stderr, "indexed_heap_init: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    DS_STATS_ALLOC(DS_STATS_INDEXED_HEAP, heap->heap_capacity * sizeof(size_t));
+    heap->size = 0;
+    heap->position = NULL;
+    heap->items = NULL;
+    heap->handle_capacity = 0;
+    heap->compare = compare;
+    indexed_heap_reserve_handle(heap, heap->heap_capacity - 1);
+}
+
+/**
+ * Check whether a handle is in the heap
+ * @param heap: Target heap
+ * @param handle: Handle to check
+ * @return: true if present
+ */
+static inline bool indexed_heap_contains(const IndexedHeap *heap, size_t handle) {
+    return handle < heap->handle_capacity && heap->position[handle] != INDEXED_HEAP_ABSENT;
+}
+
+/**
+ * Get element stored under handle
+ * @param heap: Target heap
+ * @param handle: Handle to look up
+ * @return: Element, NULL if not present
+ */
+static inline void *indexed_heap_get(const IndexedHeap *heap, size_t handle) {
+    return indexed_heap_contains(heap, handle) ? heap->items[handle] : NULL;
+}
+
+/**
+ * Insert element under handle; an existing handle is replaced and re-sifted
+ * @param heap: Target heap
+ * @param handle: Caller-chosen handle
+ * @param element: Element to insert
+ */
+static inline void indexed_heap_push(IndexedHeap *heap, size_t handle, void *element) {
+    indexed_heap_reserve_handle(heap, handle);
+
+    if (heap->position[handle] != INDEXED_HEAP_ABSENT) {
+        heap->items[handle] = element;
+        size_t index = indexed_heap_sift_up(heap, heap->position[handle]);
+        indexed_heap_sift_down(heap, index);
+        return;
+    }
+
+    indexed_heap_reserve_slots(heap, heap->size + 1);
+    heap->items[handle] = element;
+    indexed_heap_place(heap, heap->size++, handle);
+    indexed_heap_sift_up(heap, heap->size - 1);
+}
+
+/**
+ * Insert many (handle, element) pairs at once
+ * Sifts each up when the batch is small, otherwise re-heapifies in O(n + k).
+ * Existing handles are replaced, as with indexed_heap_push.
+ * @param heap: Target heap
+ * @param handles: Caller-chosen handles
+ * @param elements: Element for each handle
+ * @param count: Number of pairs
+ */
+static inline void indexed_heap_push_many(IndexedHeap *heap, const size_t *handles, void *const *elements,
+                                          size_t count) {
+    if (count == 0) return;
+    size_t max_handle = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (handles[i] > max_handle) max_handle = handles[i];
+    }
+    indexed_heap_reserve_handle(heap, max_handle);
+    indexed_heap_reserve_slots(heap, heap->size + count);
+
+    size_t old_size = heap->size;
+    bool replaced = false;
+    for (size_t i = 0; i < count; i++) {
+        heap->items[handles[i]] = elements[i];
+        if (heap->position[handles[i]] != INDEXED_HEAP_ABSENT) {
+            replaced = true;
+        } else {
+            indexed_heap_place(heap, heap->size++, handles[i]);
+        }
+    }
+
+    size_t levels = 1;
+    for (size_t n = heap->size; n >>= 1;) levels++;
+    if (!replaced && (heap->size - old_size) * levels < heap->size) {
+        for (size_t i = old_size; i < heap->size; i++) indexed_heap_sift_up(heap, i);
+    } else {
+        indexed_heap_heapify_all(heap);
+    }
+}
+
+/**
+ * Remove element by handle
+ * @param heap: Target heap
+ * @param handle: Handle to remove
+ * @return: Removed element, NULL if not present
+ */
+static inline void *indexed_heap_remove(IndexedHeap *heap, size_t handle) {
+    if (!indexed_heap_contains(heap, handle)) return NULL;
+
+    size_t index = heap->position[handle];
+    void *element = heap->items[handle];
+    heap->position[handle] = INDEXED_HEAP_ABSENT;
+    heap->items[handle] = NULL;
+
+    // Last element fills the hole and moves whichever way it needs to
+    size_t last = heap->heap[--heap->size];
+    if (index < heap->size) {
+        indexed_heap_place(heap, index, last);
+        index = indexed_heap_sift_up(heap, index);
+        indexed_heap_sift_down(heap, index);
+    }
+    return element;
+}
+
+/**
+ * Extract root element
+ * @param heap: Target heap
+ * @param handle_out: Receives the root's handle (may be NULL)
+ * @return: Root element, NULL if empty
+ */
+static inline void *indexed_heap_pop(IndexedHeap *heap, size_t *handle_out) {
+    if (heap->size == 0) return NULL;
+    size_t handle = heap->heap[0];
+    if (handle_out) *handle_out = handle;
+    return indexed_heap_remove(heap, handle);
+}
+
+/**
+ * View root element without removing
+ * @param heap: Target heap
+ * @return: Root element, NULL if empty
+ */
+static inline void *indexed_heap_peek(const IndexedHeap *heap) {
+    return heap->size > 0 ? heap->items[heap->heap[0]] : NULL;
+}
+
+/**
+ * Get handle of root element
+ * @param heap: Target heap
+ * @return: Root handle, INDEXED_HEAP_ABSENT if empty
+ */
+static inline size_t indexed_heap_peek_handle(const IndexedHeap *heap) {
+    return heap->size > 0 ? heap->heap[0] : INDEXED_HEAP_ABSENT;
+}
+
+/**
+ * Restore order after the element under handle changed its key either way
+ * @param heap: Target heap
+ * @param handle: Handle whose element changed
+ * @return: false if handle not present
+ */
+static inline bool indexed_heap_update_key(IndexedHeap *heap, size_t handle) {
+    if (!indexed_heap_contains(heap, handle)) return false;
+    size_t index = indexed_heap_sift_up(heap, heap->position[handle]);
+    indexed_heap_sift_down(heap, index);
+    return true;
+}
+
+/**
+ * Restore order after the element under handle moved toward the root
+ * (smaller key in a min-heap, larger in a max-heap)
+ * @param heap: Target heap
+ * @param handle: Handle whose element improved
+ * @return: false if handle not present
+ */
+static inline bool indexed_heap_decrease_key(IndexedHeap *heap, size_t handle) {
+    if (!indexed_heap_contains(heap, handle)) return false;
+    indexed_heap_sift_up(heap, heap->position[handle]);
+    return true;
+}
+
+/**
+ * Get current size
+ * @param heap: Target heap
+ * @return: Number of elements
+ */
+static inline size_t indexed_heap_size(const IndexedHeap *heap) {
+    return heap->size;
+}
+
+/**
+ * Check if empty
+ * @param heap: Target heap
+ * @return: true if empty
+ */
+static inline bool indexed_heap_is_empty(const IndexedHeap *heap) {
+    return heap->size == 0;
+}
+
+/**
+ * Remove all elements (handle map keeps its size)
+ * @param heap: Target heap
+ */
+static inline void indexed_heap_clear(IndexedHeap *heap) {
+    for (size_t i = 0; i < heap->size; i++) {
+        heap->position[heap->heap[i]] = INDEXED_HEAP_ABSENT;
+        heap->items[heap->heap[i]] = NULL;
+    }
+    heap->size = 0;
+}
+
+/**
+ * Free heap memory
+ * @param heap: Target heap
+ */
+static inline void indexed_heap_free(IndexedHeap *heap) {
+    free(heap->heap);
+    free(heap->position);
+    free(heap->items);
+    heap->heap = NULL;
+    heap->position = NULL;
+    heap->items = NULL;
+    heap->size = 0;
+    heap->heap_capacity = 0;
+    heap->handle_capacity = 0;
+}
+
+// ==================== QUERIES AND VALIDATION ====================
+
+/**
+ * Read the k best elements without modifying the heap, O(k log k)
+ * @param heap: Source heap (unchanged)
+ * @param k: Number of elements wanted
+ * @param out: Destination, room for k elements, written in heap order
+ * @return: Number of elements written (min(k, size))
+ */
+static inline size_t indexed_heap_top_k(const IndexedHeap *heap, size_t k, void **out) {
+    if (k > heap->size) k = heap->size;
+    if (k == 0) return 0;
+
+    // Frontier of heap indices ordered best-first; each report adds at most two
+    size_t *frontier = (size_t *)malloc((k + 1) * sizeof(size_t));
+    if (!frontier) {
+        fprintf(stderr, "indexed_heap_top_k: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t frontier_size = 1;
+    frontier[0] = 0;
+    for (size_t written = 0; written < k; written++) {
+        size_t best = frontier[0];
+        out[written] = heap->items[heap->heap[best]];
+
+        // Pop frontier root
+        size_t moved = frontier[--frontier_size];
+        size_t index = 0;
+        while (frontier_size > 0) {
+            size_t child = HEAP_LEFT_CHILD(index);
+            if (child >= frontier_size) break;
+            if (child + 1 < frontier_size && indexed_heap_compare_at(heap, frontier[child + 1], frontier[child]) < 0) {
+                child++;
+            }
+            if (indexed_heap_compare_at(heap, frontier[child], moved) >= 0) break;
+            frontier[index] = frontier[child];
+            index = child;
+        }
+        if (frontier_size > 0) frontier[index] = moved;
+
+        // Push children of the reported element
+        for (size_t c = HEAP_LEFT_CHILD(best); c <= HEAP_RIGHT_CHILD(best) && c < heap->size; c++) {
+            size_t pos = frontier_size++;
+            while (pos > 0 && indexed_heap_compare_at(heap, c, frontier[HEAP_PARENT(pos)]) < 0) {
+                frontier[pos] = frontier[HEAP_PARENT(pos)];
+                pos = HEAP_PARENT(pos);
+            }
+            frontier[pos] = c;
+        }
+    }
+
+    free(frontier);
+    return k;
+}
+
+/**
+ * Validate heap order and handle map (for testing)
+ * @param heap: Target heap
+ * @return: true if valid
+ */
+static inline bool indexed_heap_is_valid(const IndexedHeap *heap) {
+    for (size_t i = 0; i < heap->size; i++) {
+        if (heap->position[heap->heap[i]] != i) return false;
+        if (i > 0 && indexed_heap_compare_at(heap, HEAP_PARENT(i), i) > 0) return false;
+    }
+    return true;
+}
+
+#endif // INDEXED_HEAP_H
@@ -0,0 +1,158 @@
+#ifndef TYPED_HEAP_H
+#define TYPED_HEAP_H
+
+#include "heap_interface.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * TYPED BINARY HEAP (MACRO-GENERATED)
+ *
+ * DEFINE_HEAP(Name, T, CMP) generates a binary heap `Name` storing elements of
+ * type T by value in a contiguous array. CMP(a, b) is a function or macro taking
+ * two T values and returning an int, < 0 when a belongs closer to the root
+ * (same convention as heap_compare_fn). It is expanded directly into the sift
+ * loops, so the compiler inlines it instead of calling through a pointer.
+ *
+ * Sifting moves a "hole" instead of swapping, so each level costs one copy.
+ *
+ * Usage:
+ *   #define INT_LESS(a, b) ((a) < (b) ? -1 : (a) > (b))
+ *   DEFINE_HEAP(IntMinHeap, int, INT_LESS)
+ *   IntMinHeap h; IntMinHeap_init(&h, 0); IntMinHeap_push(&h, 5);
+ *
+ * Time Complexities:
+ * - Push / Pop: O(log n)
+ * - Peek: O(1)
+ * - Build from array: O(n)
+ *
+ * Space Complexity: O(n * sizeof(T))
+ */
+
+// Ready-made comparators for arithmetic types
+#define TYPED_HEAP_MIN_CMP(a, b) (((a) > (b)) - ((a) < (b)))
+#define TYPED_HEAP_MAX_CMP(a, b) (((a) < (b)) - ((a) > (b)))
+
+#define DEFINE_HEAP(Name, T, CMP)                                                \
+                                                                                 \
+typedef struct Name {                                                            \
+    T *data;         /* Heap-ordered elements by value */                        \
+    size_t size;     /* Number of elements */                                    \
+    size_t capacity; /* Allocated capacity */                                    \
+} Name;                                                                          \
+                                                                                 \
+/* Initialize heap (0 uses HEAP_DEFAULT_CAPACITY) */                             \
+static inline void Name##_init(Name *heap, size_t initial_capacity) {            \
+    heap->size = 0;                                                              \
+    heap->capacity = initial_capacity > 0 ? initial_capacity                     \
+                                          : HEAP_DEFAULT_CAPACITY;               \
+    heap->data = (T *)malloc(heap->capacity * sizeof(T));                        \
+    if (!heap->data) {                                                           \
+        fprintf(stderr, #Name "_init: allocation failed\n");                     \
+        exit(EXIT_FAILURE);                                                      \
+    }                                                                            \
+}                                                                                \
+                                                                                 \
+/* Reserve minimum capacity */                                                   \
+static inline void Name##_reserve(Name *heap, size_t min_capacity) {             \
+    if (min_capacity <= heap->capacity) return;                                  \
+    T *new_data = (T *)realloc(heap->data, min_capacity * sizeof(T));            \
+    if (!new_data) {                                                             \
+        fprintf(stderr, #Name "_reserve: reallocation failed\n");                \
+        exit(EXIT_FAILURE);                                                      \
+    }                                                                            \
+    heap->data = new_data;                                                       \
+    heap->capacity = min_capacity;                                               \
+}                                                                                \
+                                                                                 \
+/* Move value up from index until parent is not worse (internal helper) */       \
+static inline void Name##_sift_up(Name *heap, size_t index, T value) {           \
+    while (index > 0) {                                                          \
+        size_t parent = HEAP_PARENT(index);                                      \
+        if (CMP(value, heap->data[parent]) >= 0) break;                          \
+        heap->data[index] = heap->data[parent];                                  \
+        index = parent;                                                          \
+    }                                                                            \
+    heap->data[index] = value;                                                   \
+}                                                                                \
+                                                                                 \
+/* Move value down from index until children are not better (internal) */       \
+static inline void Name##_sift_down(Name *heap, size_t index, T value) {         \
+    size_t size = heap->size;                                                    \
+    while (true) {                                                               \
+        size_t child = HEAP_LEFT_CHILD(index);                                   \
+        if (child >= size) break;                                                \
+        if (child + 1 < size && CMP(heap->data[child + 1], heap->data[child]) < 0) \
+            child++;                                                             \
+        if (CMP(heap->data[child], value) >= 0) break;                           \
+        heap->data[index] = heap->data[child];                                   \
+        index = child;                                                           \
+    }                                                                            \
+    heap->data[index] = value;                                                   \
+}                                                                                \
+                                                                                 \
+/* Insert element by value */                                                    \
+static inline void Name##_push(Name *heap, T value) {                            \
+    if (heap->size >= heap->capacity) Name##_reserve(heap, heap->capacity * 2);  \
+    Name##_sift_up(heap, heap->size++, value);                                   \
+}                                                                                \
+                                                                                 \
+/* Extract root into *out (may be NULL), false if empty */                       \
+static inline bool Name##_pop(Name *heap, T *out) {                              \
+    if (heap->size == 0) return false;                                           \
+    if (out) *out = heap->data[0];                                               \
+    heap->size--;                                                                \
+    if (heap->size > 0) Name##_sift_down(heap, 0, heap->data[heap->size]);       \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Pointer to root, NULL if empty */                                             \
+static inline T *Name##_peek(const Name *heap) {                                 \
+    return heap->size > 0 ? &heap->data[0] : NULL;                               \
+}                                                                                \
+                                                                                 \
+/* Replace root with value, old root into *out; pushes if empty */               \
+static inline bool Name##_replace(Name *heap, T value, T *out) {                 \
+    if (heap->size == 0) {                                                       \
+        Name##_push(heap, value);                                                \
+        return false;                                                            \
+    }                                                                            \
+    if (out) *out = heap->data[0];                                               \
+    Name##_sift_down(heap, 0, value);                                            \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+/* Replace contents with count values and heapify in O(n) */                     \
+static inline void Name##_build_from_array(Name *heap, const T *values,          \
+                                           size_t count) {                       \
+    Name##_reserve(heap, count);                                                 \
+    if (count) memcpy(heap->data, values, count * sizeof(T));                    \
+    heap->size = count;                                                          \
+    for (size_t i = count / 2; i-- > 0;) {                                       \
+        Name##_sift_down(heap, i, heap->data[i]);                                \
+    }                                                                            \
+}                                                                                \
+                                                                                 \
+/* Validate heap property */                                                     \
+static inline bool Name##_is_valid(const Name *heap) {                           \
+    for (size_t i = 1; i < heap->size; i++) {                                    \
+        if (CMP(heap->data[i], heap->data[HEAP_PARENT(i)]) < 0) return false;    \
+    }                                                                            \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+static inline size_t Name##_size(const Name *heap) { return heap->size; }        \
+static inline bool Name##_is_empty(const Name *heap) { return heap->size == 0; } \
+static inline void Name##_clear(Name *heap) { heap->size = 0; }                  \
+                                                                                 \
+/* Free heap memory */                                                           \
+static inline void Name##_free(Name *heap) {                                     \
+    free(heap->data);                                                            \
+    heap->data = NULL;                                                           \
+    heap->size = 0;                                                              \
+    heap->capacity = 0;                                                          \
+}
+
+#endif // TYPED_HEAP_H
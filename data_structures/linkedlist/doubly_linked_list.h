@@ -2,6 +2,7 @@
 #define DOUBLY_LINKED_LIST_H
 
 #include "list_interface.h"
+#include "../allocator/allocator.h"
 #include <stdlib.h>
 #include <stdbool.h>
 
@@ -35,18 +36,20 @@ typedef struct DoublyLinkedList
     DoublyListNode *tail;                // Last node
     size_t size;                         // Element count
     const ExtendedListInterface *vtable; // Interface for polymorphism
+    const Allocator *allocator;          // Source of nodes
 } DoublyLinkedList;
 
 // ==================== NODE OPERATIONS ====================
 
 /**
- * Create new node
+ * Create new node from allocator
+ * @param allocator: Source of node memory (NULL = heap)
  * @param data: Data to store
  * @return: New node or NULL on failure
  */
-static inline DoublyListNode *doubly_create_node(void *data)
+static inline DoublyListNode *doubly_create_node_with(const Allocator *allocator, void *data)
 {
-    DoublyListNode *node = (DoublyListNode *)malloc(sizeof(DoublyListNode));
+    DoublyListNode *node = (DoublyListNode *)allocator_alloc(allocator, sizeof(DoublyListNode));
     if (!node)
         return NULL;
 
@@ -56,14 +59,33 @@ static inline DoublyListNode *doubly_create_node(void *data)
     return node;
 }
 
+/**
+ * Create new node
+ * @param data: Data to store
+ * @return: New node or NULL on failure
+ */
+static inline DoublyListNode *doubly_create_node(void *data)
+{
+    return doubly_create_node_with(&HEAP_ALLOCATOR, data);
+}
+
+/**
+ * Return node to allocator
+ * @param allocator: Allocator the node came from (NULL = heap)
+ * @param node: Node to free
+ */
+static inline void doubly_free_node_with(const Allocator *allocator, DoublyListNode *node)
+{
+    allocator_free(allocator, node, sizeof(DoublyListNode));
+}
+
 /**
  * Free node
  * @param node: Node to free
  */
 static inline void doubly_free_node(DoublyListNode *node)
 {
-    if (node)
-        free(node);
+    doubly_free_node_with(&HEAP_ALLOCATOR, node);
 }
 
 // ==================== CORE OPERATIONS ====================
@@ -78,6 +100,18 @@ static inline void doubly_init(DoublyLinkedList *list)
     list->tail = NULL;
     list->size = 0;
     list->vtable = NULL;
+    list->allocator = &HEAP_ALLOCATOR;
+}
+
+/**
+ * Initialize empty list drawing nodes from a custom allocator
+ * @param list: List to initialize
+ * @param allocator: Source of nodes (e.g. a Pool of sizeof(DoublyListNode))
+ */
+static inline void doubly_init_with_allocator(DoublyLinkedList *list, const Allocator *allocator)
+{
+    doubly_init(list);
+    list->allocator = allocator;
 }
 
 /**
@@ -87,7 +121,7 @@ static inline void doubly_init(DoublyLinkedList *list)
  */
 static inline void doubly_push_front(DoublyLinkedList *list, void *data)
 {
-    DoublyListNode *node = doubly_create_node(data);
+    DoublyListNode *node = doubly_create_node_with(list->allocator, data);
     if (!node)
         return;
 
@@ -111,7 +145,7 @@ static inline void doubly_push_front(DoublyLinkedList *list, void *data)
  */
 static inline void doubly_push_back(DoublyLinkedList *list, void *data)
 {
-    DoublyListNode *node = doubly_create_node(data);
+    DoublyListNode *node = doubly_create_node_with(list->allocator, data);
     if (!node)
         return;
 
@@ -151,7 +185,7 @@ static inline void *doubly_pop_front(DoublyLinkedList *list)
         list->head->prev = NULL;
     }
 
-    doubly_free_node(node);
+    doubly_free_node_with(list->allocator, node);
     list->size--;
     return data;
 }
@@ -179,7 +213,7 @@ static inline void *doubly_pop_back(DoublyLinkedList *list)
         list->tail->next = NULL;
     }
 
-    doubly_free_node(node);
+    doubly_free_node_with(list->allocator, node);
     list->size--;
     return data;
 }
@@ -294,7 +328,7 @@ static inline void doubly_insert_at(DoublyLinkedList *list, size_t index, void *
         }
     }
 
-    DoublyListNode *new_node = doubly_create_node(data);
+    DoublyListNode *new_node = doubly_create_node_with(list->allocator, data);
     if (!new_node)
         return;
 
@@ -352,7 +386,7 @@ static inline void *doubly_remove_at(DoublyLinkedList *list, size_t index)
     if (current->next)
         current->next->prev = current->prev;
 
-    doubly_free_node(current);
+    doubly_free_node_with(list->allocator, current);
     list->size--;
     return data;
 }
@@ -404,7 +438,7 @@ static inline void doubly_clear(DoublyLinkedList *list)
     while (list->head)
     {
         DoublyListNode *next = list->head->next;
-        doubly_free_node(list->head);
+        doubly_free_node_with(list->allocator, list->head);
         list->head = next;
     }
     list->tail = NULL;
@@ -417,6 +451,13 @@ static inline void doubly_clear(DoublyLinkedList *list)
  */
 static inline void doubly_free(DoublyLinkedList *list)
 {
+    // Region allocators reclaim nodes on reset, no need to walk the list
+    if (allocator_frees_in_bulk(list->allocator))
+    {
+        list->head = list->tail = NULL;
+        list->size = 0;
+        return;
+    }
     doubly_clear(list);
 }
 
@@ -0,0 +1,320 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * WORK-STEALING THREAD POOL
+ *
+ * Fixed set of worker threads, each owning a deque of range tasks. Submitted
+ * tasks are dealt round-robin onto the deques; a worker takes from the back
+ * of its own deque and, when that is empty, steals from the front of the
+ * others, so an uneven split evens out without a central queue.
+ *
+ * Tasks are (fn, ctx, begin, end) ranges. Every call also receives the id of
+ * the worker running it (0..thread_count-1), so kernels can keep per-thread
+ * buffers without locking. thread_pool_wait() blocks until every submitted
+ * task has finished; it must not be called from inside a task.
+ *
+ * Time Complexities:
+ * - Submit: O(1) amortized plus one deque lock
+ * - Take / Steal: O(1) per task plus one deque lock
+ *
+ * Space Complexity: O(threads + queued tasks)
+ */
+
+// Configuration constants
+#define THREAD_POOL_CACHE_LINE 64
+#define THREAD_POOL_DEQUE_CAPACITY 64
+#define THREAD_POOL_TASKS_PER_THREAD 8 // parallel_for chunks per worker when no grain is given
+
+// Range function run by a task
+typedef void (*ThreadPoolRangeFn)(void *ctx, size_t begin, size_t end, size_t worker);
+
+// Queued unit of work
+typedef struct ThreadPoolTask {
+    ThreadPoolRangeFn fn;
+    void *ctx;
+    size_t begin;
+    size_t end;
+} ThreadPoolTask;
+
+// Per-worker task deque (ring buffer)
+typedef struct ThreadPoolDeque {
+    alignas(THREAD_POOL_CACHE_LINE) pthread_mutex_t lock;
+    ThreadPoolTask *tasks; // Ring storage
+    size_t head;           // Index of front (steal end)
+    size_t count;          // Tasks queued
+    size_t capacity;       // Ring slots (power of two)
+} ThreadPoolDeque;
+
+struct ThreadPool;
+
+// Worker thread state
+typedef struct ThreadPoolWorker {
+    struct ThreadPool *pool;
+    size_t id;
+    pthread_t thread;
+} ThreadPoolWorker;
+
+// Thread pool
+typedef struct ThreadPool {
+    ThreadPoolWorker *workers;
+    ThreadPoolDeque *deques;   // One per worker
+    size_t thread_count;
+    atomic_size_t queued;      // Tasks sitting in deques
+    atomic_size_t pending;     // Tasks submitted but not finished
+    atomic_size_t next_deque;  // Round-robin submit cursor
+    atomic_bool stop;
+    pthread_mutex_t lock;      // Guards sleeping and waiting
+    pthread_cond_t work_ready; // Signaled when tasks are queued or on stop
+    pthread_cond_t all_done;   // Signaled when pending drops to zero
+} ThreadPool;
+
+// ==================== DEQUE HELPERS ====================
+
+/**
+ * Append task at the back of a deque (internal helper)
+ * @param deque: Target deque
+ * @param task: Task to queue
+ */
+static inline void thread_pool_deque_push(ThreadPoolDeque *deque, const ThreadPoolTask *task) {
+    pthread_mutex_lock(&deque->lock);
+    if (deque->count == deque->capacity) {
+        size_t new_capacity = deque->capacity * 2;
+        ThreadPoolTask *tasks = (ThreadPoolTask *)malloc(new_capacity * sizeof(ThreadPoolTask));
+        if (!tasks) {
+            fprintf(stderr, "thread_pool_deque_push: allocation failed\n");
+            exit(EXIT_FAILURE);
+        }
+        for (size_t i = 0; i < deque->count; i++) {
+            tasks[i] = deque->tasks[(deque->head + i) & (deque->capacity - 1)];
+        }
+        free(deque->tasks);
+        deque->tasks = tasks;
+        deque->head = 0;
+        deque->capacity = new_capacity;
+    }
+    deque->tasks[(deque->head + deque->count) & (deque->capacity - 1)] = *task;
+    deque->count++;
+    pthread_mutex_unlock(&deque->lock);
+}
+
+/**
+ * Take task from the back (owner) or front (thief) of a deque (internal helper)
+ * @param deque: Target deque
+ * @param steal: Take from the front instead of the back
+ * @param out: Receives the task
+ * @return: true if a task was taken
+ */
+static inline bool thread_pool_deque_take(ThreadPoolDeque *deque, bool steal, ThreadPoolTask *out) {
+    pthread_mutex_lock(&deque->lock);
+    if (deque->count == 0) {
+        pthread_mutex_unlock(&deque->lock);
+        return false;
+    }
+    if (steal) {
+        *out = deque->tasks[deque->head];
+        deque->head = (deque->head + 1) & (deque->capacity - 1);
+    } else {
+        *out = deque->tasks[(deque->head + deque->count - 1) & (deque->capacity - 1)];
+    }
+    deque->count--;
+    pthread_mutex_unlock(&deque->lock);
+    return true;
+}
+
+// ==================== WORKER LOOP ====================
+
+/**
+ * Find work: own deque first, then steal round the others (internal helper)
+ * @param pool: Owning pool
+ * @param id: Worker id
+ * @param out: Receives the task
+ * @return: true if a task was found
+ */
+static inline bool thread_pool_find_task(ThreadPool *pool, size_t id, ThreadPoolTask *out) {
+    if (thread_pool_deque_take(&pool->deques[id], false, out)) return true;
+    for (size_t i = 1; i < pool->thread_count; i++) {
+        if (thread_pool_deque_take(&pool->deques[(id + i) % pool->thread_count], true, out)) return true;
+    }
+    return false;
+}
+
+/**
+ * Worker thread entry (internal helper)
+ * @param arg: ThreadPoolWorker
+ * @return: NULL
+ */
+static inline void *thread_pool_worker_main(void *arg) {
+    ThreadPoolWorker *worker = (ThreadPoolWorker *)arg;
+    ThreadPool *pool = worker->pool;
+    ThreadPoolTask task;
+
+    while (true) {
+        if (thread_pool_find_task(pool, worker->id, &task)) {
+            atomic_fetch_sub(&pool->queued, 1);
+            task.fn(task.ctx, task.begin, task.end, worker->id);
+            if (atomic_fetch_sub(&pool->pending, 1) == 1) {
+                pthread_mutex_lock(&pool->lock);
+                pthread_cond_broadcast(&pool->all_done);
+                pthread_mutex_unlock(&pool->lock);
+            }
+            continue;
+        }
+
+        // Sleep until new work is queued; checked under the lock so no wakeup is lost
+        pthread_mutex_lock(&pool->lock);
+        while (atomic_load(&pool->queued) == 0 && !atomic_load(&pool->stop)) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        bool stopping = atomic_load(&pool->stop) && atomic_load(&pool->queued) == 0;
+        pthread_mutex_unlock(&pool->lock);
+        if (stopping) return NULL;
+    }
+}
+
+// ==================== CORE OPERATIONS ====================
+
+/**
+ * Initialize thread pool and start its workers
+ * @param pool: Pool to initialize
+ * @param thread_count: Number of workers (0 = 1)
+ */
+static inline void thread_pool_init(ThreadPool *pool, size_t thread_count) {
+    if (thread_count == 0) thread_count = 1;
+    pool->thread_count = thread_count;
+    pool->workers = (ThreadPoolWorker *)malloc(thread_count * sizeof(ThreadPoolWorker));
+    pool->deques = (ThreadPoolDeque *)aligned_alloc(THREAD_POOL_CACHE_LINE, thread_count * sizeof(ThreadPoolDeque));
+    if (!pool->workers || !pool->deques) {
+        fprintf(stderr, "thread_pool_init: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    atomic_init(&pool->queued, 0);
+    atomic_init(&pool->pending, 0);
+    atomic_init(&pool->next_deque, 0);
+    atomic_init(&pool->stop, false);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->all_done, NULL);
+
+    for (size_t i = 0; i < thread_count; i++) {
+        ThreadPoolDeque *deque = &pool->deques[i];
+        pthread_mutex_init(&deque->lock, NULL);
+        deque->capacity = THREAD_POOL_DEQUE_CAPACITY;
+        deque->tasks = (ThreadPoolTask *)malloc(deque->capacity * sizeof(ThreadPoolTask));
+        if (!deque->tasks) {
+            fprintf(stderr, "thread_pool_init: allocation failed\n");
+            exit(EXIT_FAILURE);
+        }
+        deque->head = 0;
+        deque->count = 0;
+    }
+    for (size_t i = 0; i < thread_count; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].id = i;
+        if (pthread_create(&pool->workers[i].thread, NULL, thread_pool_worker_main, &pool->workers[i]) != 0) {
+            fprintf(stderr, "thread_pool_init: thread creation failed\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/**
+ * Get number of worker threads
+ * @param pool: Target pool
+ * @return: Worker count
+ */
+static inline size_t thread_pool_size(const ThreadPool *pool) {
+    return pool->thread_count;
+}
+
+/**
+ * Queue a range task
+ * @param pool: Target pool
+ * @param fn: Function to run as fn(ctx, begin, end, worker)
+ * @param ctx: Opaque argument
+ * @param begin: Range start passed to fn
+ * @param end: Range end passed to fn
+ */
+static inline void thread_pool_submit(ThreadPool *pool, ThreadPoolRangeFn fn, void *ctx, size_t begin, size_t end) {
+    ThreadPoolTask task = {fn, ctx, begin, end};
+    size_t target = atomic_fetch_add(&pool->next_deque, 1) % pool->thread_count;
+    atomic_fetch_add(&pool->pending, 1);
+    atomic_fetch_add(&pool->queued, 1);
+    thread_pool_deque_push(&pool->deques[target], &task);
+
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_signal(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Block until every submitted task has finished
+ * @param pool: Target pool
+ */
+static inline void thread_pool_wait(ThreadPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    while (atomic_load(&pool->pending) > 0) {
+        pthread_cond_wait(&pool->all_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Run fn over [begin, end) split into chunks, and wait for completion
+ * @param pool: Target pool
+ * @param begin: Range start
+ * @param end: Range end
+ * @param grain: Chunk length (0 = THREAD_POOL_TASKS_PER_THREAD chunks per worker)
+ * @param fn: Function run on each chunk
+ * @param ctx: Opaque argument
+ */
+static inline void thread_pool_parallel_for(ThreadPool *pool, size_t begin, size_t end, size_t grain,
+                                            ThreadPoolRangeFn fn, void *ctx) {
+    if (begin >= end) return;
+    size_t length = end - begin;
+    if (grain == 0) {
+        size_t chunks = pool->thread_count * THREAD_POOL_TASKS_PER_THREAD;
+        grain = (length + chunks - 1) / chunks;
+    }
+    for (size_t lo = begin; lo < end; lo += grain) {
+        size_t hi = (end - lo > grain) ? lo + grain : end;
+        thread_pool_submit(pool, fn, ctx, lo, hi);
+    }
+    thread_pool_wait(pool);
+}
+
+/**
+ * Stop workers after queued tasks drain and free the pool
+ * @param pool: Target pool
+ */
+static inline void thread_pool_free(ThreadPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    atomic_store(&pool->stop, true);
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->thread_count; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    for (size_t i = 0; i < pool->thread_count; i++) {
+        pthread_mutex_destroy(&pool->deques[i].lock);
+        free(pool->deques[i].tasks);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_cond_destroy(&pool->all_done);
+    free(pool->deques);
+    free(pool->workers);
+    pool->deques = NULL;
+    pool->workers = NULL;
+    pool->thread_count = 0;
+}
+
+#endif // THREAD_POOL_H
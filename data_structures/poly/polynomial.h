@@ -0,0 +1,844 @@
+#ifndef POLYNOMIAL_H
+#define POLYNOMIAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * POLYNOMIAL MULTIPLICATION
+ *
+ * Convolution of coefficient arrays, out[k] = sum of a[i] * b[k - i], with
+ * the product of lengths na and nb having na + nb - 1 coefficients. Three
+ * engines are available directly, and the dispatchers pick one by the
+ * shorter operand length:
+ * - Naive, O(na * nb), for short operands
+ * - Karatsuba, O(n^1.585), for medium operands (longer one split in chunks)
+ * - FFT / NTT, O(N log N), N = next power of two >= na + nb - 1
+ *
+ * Floating point (double): iterative in-place FFT over interleaved complex
+ * values. Twiddles are precomputed per stage in a plan, pairs of radix-2
+ * stages are fused into radix-4 passes, and butterflies are vectorized.
+ * Both real operands are packed into one complex transform, so a product
+ * costs two transforms.
+ *
+ * Exact integers: number-theoretic transform over three NTT-friendly primes
+ * with Montgomery multiplication, recombined with the Chinese remainder
+ * theorem (Garner). poly_multiply_mod reduces by any modulus < 2^31 and
+ * poly_multiply_exact returns exact int64 coefficients.
+ *
+ * SIMD paths: AVX2 (two complex values per register), SSE2 (one), scalar
+ * fallback (define POLY_NO_SIMD to force it). Twiddles are evaluated by a
+ * series, so there is no libm dependency.
+ *
+ * Time Complexities:
+ * - Naive: O(na * nb)
+ * - Karatsuba: O(max * min^0.585)
+ * - FFT / NTT: O(N log N)
+ *
+ * Space Complexity: O(N)
+ */
+
+#if !defined(POLY_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define POLY_AVX2 1
+#define POLY_SSE2 1
+#elif !defined(POLY_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define POLY_SSE2 1
+#endif
+
+// Dispatch thresholds on the shorter operand length
+#define POLY_NAIVE_MAX 48       // Naive up to this length
+#define POLY_FFT_MIN 256        // FFT from this length (Karatsuba in between)
+#define POLY_EXACT_NTT_MIN 2048 // NTT from this length for exact integer products
+
+#define POLY_KARATSUBA_BASE 32  // Karatsuba recursion switches to naive here
+#define POLY_NTT_MAX_LOG2 23    // Longest transform supported by every NTT prime
+#define POLY_NTT_MODULUS 998244353u
+
+// Complex value (interleaved real/imaginary)
+typedef struct PolyComplex {
+    double re;
+    double im;
+} PolyComplex;
+
+// Precomputed transform of one power-of-two size
+typedef struct PolyFFTPlan {
+    size_t size;            // Transform length
+    PolyComplex *twiddles;  // twiddles[h + j] = exp(-2*pi*i * j / 2h) for h = 1, 2, 4, ..., size/2
+    uint32_t *bit_reverse;  // Input permutation
+} PolyFFTPlan;
+
+// NTT prime with its Montgomery constants
+typedef struct PolyNTTPrime {
+    uint32_t p;       // Prime, p - 1 divisible by 2^POLY_NTT_MAX_LOG2
+    uint32_t g;       // Primitive root
+    uint32_t neg_inv; // -p^-1 mod 2^32
+    uint32_t r2;      // 2^64 mod p
+} PolyNTTPrime;
+
+/**
+ * Allocate or exit (internal helper)
+ * @param bytes: Size to allocate
+ * @param who: Caller name for the error message
+ * @return: New memory
+ */
+static inline void *poly_alloc(size_t bytes, const char *who) {
+    void *memory = malloc(bytes ? bytes : 1);
+    if (!memory) {
+        fprintf(stderr, "%s: allocation failed\n", who);
+        exit(EXIT_FAILURE);
+    }
+    return memory;
+}
+
+/**
+ * Smallest power of two >= n (internal helper)
+ * @param n: Length
+ * @return: Power of two (1 for n <= 1)
+ */
+static inline size_t poly_next_pow2(size_t n) {
+    size_t size = 1;
+    while (size < n) size <<= 1;
+    return size;
+}
+
+// ==================== NAIVE AND KARATSUBA ====================
+
+/**
+ * POLY_DEFINE_CLASSIC(Name, T) generates Name_naive and Name_karatsuba over
+ * coefficients of arithmetic type T, both writing na + nb - 1 outputs.
+ */
+#define POLY_DEFINE_CLASSIC(Name, T)                                                     \
+                                                                                         \
+/* Schoolbook product */                                                                 \
+static inline void Name##_naive(const T *a, size_t na, const T *b, size_t nb, T *out) {  \
+    if (!na || !nb) return;                                                              \
+    memset(out, 0, (na + nb - 1) * sizeof(T));                                           \
+    for (size_t i = 0; i < na; i++) {                                                    \
+        T x = a[i];                                                                      \
+        for (size_t j = 0; j < nb; j++) out[i + j] += x * b[j];                          \
+    }                                                                                    \
+}                                                                                        \
+                                                                                         \
+/* Karatsuba on equal lengths n; out gets 2n - 1 values, scratch 4n + 192 */             \
+static inline void Name##_karatsuba_equal(const T *a, const T *b, size_t n, T *out,      \
+                                          T *scratch) {                                  \
+    if (n <= POLY_KARATSUBA_BASE) {                                                      \
+        Name##_naive(a, n, b, n, out);                                                   \
+        return;                                                                          \
+    }                                                                                    \
+    size_t m = n / 2, h = n - m; /* low half m, high half h >= m */                      \
+    T *sum_a = scratch, *sum_b = scratch + h, *mid = scratch + 2 * h;                    \
+    T *rest = mid + 2 * h - 1;                                                           \
+    Name##_karatsuba_equal(a, b, m, out, rest);                   /* low * low */        \
+    Name##_karatsuba_equal(a + m, b + m, h, out + 2 * m, rest);   /* high * high */      \
+    out[2 * m - 1] = 0;                                                                  \
+    for (size_t i = 0; i < h; i++) {                                                     \
+        sum_a[i] = a[m + i] + (i < m ? a[i] : 0);                                        \
+        sum_b[i] = b[m + i] + (i < m ? b[i] : 0);                                        \
+    }                                                                                    \
+    Name##_karatsuba_equal(sum_a, sum_b, h, mid, rest);                                  \
+    for (size_t i = 0; i < 2 * m - 1; i++) mid[i] -= out[i];                             \
+    for (size_t i = 0; i < 2 * h - 1; i++) mid[i] -= out[2 * m + i];                     \
+    for (size_t i = 0; i < 2 * h - 1; i++) out[m + i] += mid[i];                         \
+}                                                                                        \
+                                                                                         \
+/* Karatsuba product; the longer operand is cut into chunks of the shorter */            \
+static inline void Name##_karatsuba(const T *a, size_t na, const T *b, size_t nb,        \
+                                    T *out) {                                            \
+    if (!na || !nb) return;                                                              \
+    if (na < nb) {                                                                       \
+        const T *swap = a; a = b; b = swap;                                              \
+        size_t swap_n = na; na = nb; nb = swap_n;                                        \
+    }                                                                                    \
+    if (nb <= POLY_KARATSUBA_BASE) {                                                     \
+        Name##_naive(a, na, b, nb, out);                                                 \
+        return;                                                                          \
+    }                                                                                    \
+    T *pad = (T *)poly_alloc((7 * nb + 256) * sizeof(T), #Name "_karatsuba");            \
+    T *product = pad + nb, *scratch = product + 2 * nb - 1;                              \
+    memset(out, 0, (na + nb - 1) * sizeof(T));                                           \
+    for (size_t start = 0; start < na; start += nb) {                                    \
+        size_t length = na - start < nb ? na - start : nb;                               \
+        const T *chunk = a + start;                                                      \
+        if (length < nb) { /* zero-pad the last chunk */                                 \
+            memcpy(pad, chunk, length * sizeof(T));                                      \
+            memset(pad + length, 0, (nb - length) * sizeof(T));                          \
+            chunk = pad;                                                                 \
+        }                                                                                \
+        Name##_karatsuba_equal(chunk, b, nb, product, scratch);                          \
+        for (size_t i = 0; i < length + nb - 1; i++) out[start + i] += product[i];       \
+    }                                                                                    \
+    free(pad);                                                                           \
+}
+
+// Doubles, and wrapping unsigned arithmetic for exact int64 results
+POLY_DEFINE_CLASSIC(poly_f64, double)
+POLY_DEFINE_CLASSIC(poly_u64, uint64_t)
+
+/**
+ * Schoolbook product
+ * @param a, na: First polynomial
+ * @param b, nb: Second polynomial
+ * @param out: Receives na + nb - 1 coefficients
+ */
+static inline void poly_multiply_naive(const double *a, size_t na, const double *b, size_t nb, double *out) {
+    poly_f64_naive(a, na, b, nb, out);
+}
+
+/**
+ * Karatsuba product
+ * @param a, na: First polynomial
+ * @param b, nb: Second polynomial
+ * @param out: Receives na + nb - 1 coefficients
+ */
+static inline void poly_multiply_karatsuba(const double *a, size_t na, const double *b, size_t nb, double *out) {
+    poly_f64_karatsuba(a, na, b, nb, out);
+}
+
+// ==================== FFT PLAN ====================
+
+/**
+ * exp(-2*pi*i * k / n) for power-of-two n (internal helper)
+ * Octant symmetry reduces the angle to [0, pi/4] exactly in integers, where
+ * a short Taylor series in long double is accurate to double precision.
+ * @param k: Numerator
+ * @param n: Power-of-two denominator
+ * @return: Root of unity
+ */
+static inline PolyComplex poly_unit_root(size_t k, size_t n) {
+    size_t scale = n < 8 ? 8 / n : 1;
+    size_t eighth = n * scale / 8;
+    k = (k % n) * scale;
+    size_t octant = k / eighth, t = k % eighth;
+    bool mirrored = octant & 1;
+    long double x = 6.283185307179586476925286766559L * (long double)(mirrored ? eighth - t : t) /
+                    (long double)(n * scale);
+
+    long double x2 = x * x, sin_x = 0.0L, cos_x = 0.0L, sin_term = x, cos_term = 1.0L;
+    for (int i = 0; i < 12; i++) {
+        sin_x += sin_term;
+        cos_x += cos_term;
+        sin_term *= -x2 / (long double)((2 * i + 2) * (2 * i + 3));
+        cos_term *= -x2 / (long double)((2 * i + 1) * (2 * i + 2));
+    }
+
+    double c = (double)cos_x, s = (double)sin_x, cos_theta, sin_theta;
+    switch (octant) {
+    case 0: cos_theta = c;  sin_theta = s;  break;
+    case 1: cos_theta = s;  sin_theta = c;  break;
+    case 2: cos_theta = -s; sin_theta = c;  break;
+    case 3: cos_theta = -c; sin_theta = s;  break;
+    case 4: cos_theta = -c; sin_theta = -s; break;
+    case 5: cos_theta = -s; sin_theta = -c; break;
+    case 6: cos_theta = s;  sin_theta = -c; break;
+    default: cos_theta = c; sin_theta = -s; break;
+    }
+    PolyComplex root = {cos_theta, -sin_theta};
+    return root;
+}
+
+/**
+ * Precompute twiddles and bit reversal for one transform size
+ * @param plan: Plan to initialize
+ * @param size: Transform length (rounded up to a power of two)
+ */
+static inline void poly_fft_plan_init(PolyFFTPlan *plan, size_t size) {
+    size = poly_next_pow2(size);
+    plan->size = size;
+    plan->twiddles = (PolyComplex *)poly_alloc(size * sizeof(PolyComplex), "poly_fft_plan_init");
+    plan->bit_reverse = (uint32_t *)poly_alloc(size * sizeof(uint32_t), "poly_fft_plan_init");
+
+    // Last stage from the series; smaller stages are strided copies of it
+    size_t top = size / 2;
+    for (size_t j = 0; j < top; j++) plan->twiddles[top + j] = poly_unit_root(j, size);
+    for (size_t h = top / 2; h >= 1; h /= 2) {
+        for (size_t j = 0; j < h; j++) plan->twiddles[h + j] = plan->twiddles[top + j * (top / h)];
+    }
+    plan->twiddles[0].re = 1.0;
+    plan->twiddles[0].im = 0.0;
+
+    unsigned bits = 0;
+    while (((size_t)1 << bits) < size) bits++;
+    plan->bit_reverse[0] = 0;
+    for (size_t i = 1; i < size; i++) {
+        plan->bit_reverse[i] = (plan->bit_reverse[i >> 1] >> 1) | (uint32_t)((i & 1) << (bits - 1));
+    }
+}
+
+/**
+ * Free plan tables
+ * @param plan: Plan to free
+ */
+static inline void poly_fft_plan_free(PolyFFTPlan *plan) {
+    free(plan->twiddles);
+    free(plan->bit_reverse);
+    plan->twiddles = NULL;
+    plan->bit_reverse = NULL;
+    plan->size = 0;
+}
+
+// ==================== FFT KERNELS ====================
+
+#if defined(POLY_SSE2)
+/**
+ * Complex product a * w in one register (internal helper)
+ * @param a: (re, im)
+ * @param w: (re, im)
+ * @return: (a.re w.re - a.im w.im, a.im w.re + a.re w.im)
+ */
+static inline __m128d poly_cmul_sse2(__m128d a, __m128d w) {
+    __m128d w_re = _mm_unpacklo_pd(w, w);
+    __m128d w_im = _mm_unpackhi_pd(w, w);
+    __m128d swapped = _mm_shuffle_pd(a, a, 1);
+    return _mm_add_pd(_mm_mul_pd(a, w_re), _mm_xor_pd(_mm_mul_pd(swapped, w_im), _mm_set_pd(0.0, -0.0)));
+}
+
+/**
+ * Multiply by -i: (re, im) -> (im, -re) (internal helper)
+ */
+static inline __m128d poly_mul_neg_i_sse2(__m128d a) {
+    return _mm_xor_pd(_mm_shuffle_pd(a, a, 1), _mm_set_pd(-0.0, 0.0));
+}
+#endif
+
+#if defined(POLY_AVX2)
+/**
+ * Two complex products a * w in one register (internal helper)
+ */
+static inline __m256d poly_cmul_avx2(__m256d a, __m256d w) {
+    __m256d w_re = _mm256_movedup_pd(w);
+    __m256d w_im = _mm256_permute_pd(w, 0xF);
+    __m256d swapped = _mm256_permute_pd(a, 0x5);
+    return _mm256_addsub_pd(_mm256_mul_pd(a, w_re), _mm256_mul_pd(swapped, w_im));
+}
+
+/**
+ * Two multiplications by -i (internal helper)
+ */
+static inline __m256d poly_mul_neg_i_avx2(__m256d a) {
+    return _mm256_xor_pd(_mm256_permute_pd(a, 0x5), _mm256_set_pd(-0.0, 0.0, -0.0, 0.0));
+}
+#endif
+
+/**
+ * Two fused radix-2 stages (spans h and 2h) over the whole array (internal helper)
+ * @param a: Data in bit-reversed order
+ * @param n: Length
+ * @param h: Span of the first fused stage
+ * @param twiddles: Plan twiddles
+ */
+static inline void poly_fft_radix4_pass(PolyComplex *a, size_t n, size_t h, const PolyComplex *twiddles) {
+    const PolyComplex *w1 = twiddles + h;     // Stage h:  exp(-2*pi*i * j / 2h)
+    const PolyComplex *w2 = twiddles + 2 * h; // Stage 2h: exp(-2*pi*i * j / 4h)
+#if defined(POLY_AVX2)
+    if (h >= 2) {
+        for (size_t base = 0; base < n; base += 4 * h) {
+            double *p0 = (double *)(a + base), *p1 = p0 + 2 * h, *p2 = p1 + 2 * h, *p3 = p2 + 2 * h;
+            for (size_t j = 0; j < h; j += 2) {
+                __m256d w = _mm256_loadu_pd((const double *)(w1 + j));
+                __m256d v = _mm256_loadu_pd((const double *)(w2 + j));
+                __m256d x0 = _mm256_loadu_pd(p0 + 2 * j), x1 = _mm256_loadu_pd(p1 + 2 * j);
+                __m256d x2 = _mm256_loadu_pd(p2 + 2 * j), x3 = _mm256_loadu_pd(p3 + 2 * j);
+                __m256d t = poly_cmul_avx2(x1, w);
+                __m256d y0 = _mm256_add_pd(x0, t), y1 = _mm256_sub_pd(x0, t);
+                t = poly_cmul_avx2(x3, w);
+                __m256d y2 = _mm256_add_pd(x2, t), y3 = _mm256_sub_pd(x2, t);
+                t = poly_cmul_avx2(y2, v);
+                _mm256_storeu_pd(p0 + 2 * j, _mm256_add_pd(y0, t));
+                _mm256_storeu_pd(p2 + 2 * j, _mm256_sub_pd(y0, t));
+                t = poly_mul_neg_i_avx2(poly_cmul_avx2(y3, v));
+                _mm256_storeu_pd(p1 + 2 * j, _mm256_add_pd(y1, t));
+                _mm256_storeu_pd(p3 + 2 * j, _mm256_sub_pd(y1, t));
+            }
+        }
+        return;
+    }
+#endif
+    for (size_t base = 0; base < n; base += 4 * h) {
+        PolyComplex *p0 = a + base, *p1 = p0 + h, *p2 = p1 + h, *p3 = p2 + h;
+        for (size_t j = 0; j < h; j++) {
+#if defined(POLY_SSE2)
+            __m128d w = _mm_loadu_pd((const double *)(w1 + j));
+            __m128d v = _mm_loadu_pd((const double *)(w2 + j));
+            __m128d x0 = _mm_loadu_pd((const double *)(p0 + j)), x1 = _mm_loadu_pd((const double *)(p1 + j));
+            __m128d x2 = _mm_loadu_pd((const double *)(p2 + j)), x3 = _mm_loadu_pd((const double *)(p3 + j));
+            __m128d t = poly_cmul_sse2(x1, w);
+            __m128d y0 = _mm_add_pd(x0, t), y1 = _mm_sub_pd(x0, t);
+            t = poly_cmul_sse2(x3, w);
+            __m128d y2 = _mm_add_pd(x2, t), y3 = _mm_sub_pd(x2, t);
+            t = poly_cmul_sse2(y2, v);
+            _mm_storeu_pd((double *)(p0 + j), _mm_add_pd(y0, t));
+            _mm_storeu_pd((double *)(p2 + j), _mm_sub_pd(y0, t));
+            t = poly_mul_neg_i_sse2(poly_cmul_sse2(y3, v));
+            _mm_storeu_pd((double *)(p1 + j), _mm_add_pd(y1, t));
+            _mm_storeu_pd((double *)(p3 + j), _mm_sub_pd(y1, t));
+#else
+            PolyComplex w = w1[j], v = w2[j];
+            PolyComplex x0 = p0[j], x1 = p1[j], x2 = p2[j], x3 = p3[j];
+            double tr = x1.re * w.re - x1.im * w.im, ti = x1.im * w.re + x1.re * w.im;
+            PolyComplex y0 = {x0.re + tr, x0.im + ti}, y1 = {x0.re - tr, x0.im - ti};
+            tr = x3.re * w.re - x3.im * w.im;
+            ti = x3.im * w.re + x3.re * w.im;
+            PolyComplex y2 = {x2.re + tr, x2.im + ti}, y3 = {x2.re - tr, x2.im - ti};
+            tr = y2.re * v.re - y2.im * v.im;
+            ti = y2.im * v.re + y2.re * v.im;
+            p0[j].re = y0.re + tr;
+            p0[j].im = y0.im + ti;
+            p2[j].re = y0.re - tr;
+            p2[j].im = y0.im - ti;
+            // (y3 * v) * -i
+            double ur = y3.im * v.re + y3.re * v.im, ui = -(y3.re * v.re - y3.im * v.im);
+            p1[j].re = y1.re + ur;
+            p1[j].im = y1.im + ui;
+            p3[j].re = y1.re - ur;
+            p3[j].im = y1.im - ui;
+#endif
+        }
+    }
+}
+
+/**
+ * Final radix-2 stage when log2(n) is odd (internal helper)
+ * @param a: Data
+ * @param h: Span (n / 2)
+ * @param twiddles: Plan twiddles
+ */
+static inline void poly_fft_radix2_pass(PolyComplex *a, size_t h, const PolyComplex *twiddles) {
+    const PolyComplex *w = twiddles + h;
+    PolyComplex *p0 = a, *p1 = a + h;
+    for (size_t j = 0; j < h; j++) {
+#if defined(POLY_SSE2)
+        __m128d x0 = _mm_loadu_pd((const double *)(p0 + j));
+        __m128d t = poly_cmul_sse2(_mm_loadu_pd((const double *)(p1 + j)), _mm_loadu_pd((const double *)(w + j)));
+        _mm_storeu_pd((double *)(p0 + j), _mm_add_pd(x0, t));
+        _mm_storeu_pd((double *)(p1 + j), _mm_sub_pd(x0, t));
+#else
+        PolyComplex x0 = p0[j], x1 = p1[j];
+        double tr = x1.re * w[j].re - x1.im * w[j].im, ti = x1.im * w[j].re + x1.re * w[j].im;
+        p0[j].re = x0.re + tr;
+        p0[j].im = x0.im + ti;
+        p1[j].re = x0.re - tr;
+        p1[j].im = x0.im - ti;
+#endif
+    }
+}
+
+/**
+ * Forward transform in place: data[k] = sum data[j] exp(-2*pi*i * jk / n)
+ * @param plan: Plan of the data length
+ * @param data: plan->size values
+ */
+static inline void poly_fft_forward(const PolyFFTPlan *plan, PolyComplex *data) {
+    size_t n = plan->size;
+    for (size_t i = 0; i < n; i++) {
+        size_t j = plan->bit_reverse[i];
+        if (i < j) {
+            PolyComplex swap = data[i];
+            data[i] = data[j];
+            data[j] = swap;
+        }
+    }
+    size_t h = 1;
+    for (; 4 * h <= n; h *= 4) poly_fft_radix4_pass(data, n, h, plan->twiddles);
+    if (2 * h == n) poly_fft_radix2_pass(data, h, plan->twiddles);
+}
+
+/**
+ * Inverse transform in place, scaled by 1/n (conj(FFT(conj(x))) / n)
+ * @param plan: Plan of the data length
+ * @param data: plan->size values
+ */
+static inline void poly_fft_inverse(const PolyFFTPlan *plan, PolyComplex *data) {
+    size_t n = plan->size;
+    for (size_t i = 0; i < n; i++) data[i].im = -data[i].im;
+    poly_fft_forward(plan, data);
+    double scale = 1.0 / (double)n;
+    for (size_t i = 0; i < n; i++) {
+        data[i].re *= scale;
+        data[i].im *= -scale;
+    }
+}
+
+// ==================== FLOATING-POINT PRODUCTS ====================
+
+/**
+ * FFT product of two real polynomials with a caller-provided plan
+ * @param plan: Plan of size >= na + nb - 1 (reusable across calls)
+ * @param a, na: First polynomial
+ * @param b, nb: Second polynomial
+ * @param out: Receives na + nb - 1 coefficients
+ */
+static inline void poly_multiply_fft_with_plan(const PolyFFTPlan *plan, const double *a, size_t na, const double *b,
+                                               size_t nb, double *out) {
+    if (!na || !nb) return;
+    size_t n = plan->size, need = na + nb - 1;
+    PolyComplex *z = (PolyComplex *)poly_alloc(n * sizeof(PolyComplex), "poly_multiply_fft");
+    for (size_t i = 0; i < n; i++) {
+        z[i].re = i < na ? a[i] : 0.0;
+        z[i].im = i < nb ? b[i] : 0.0;
+    }
+    poly_fft_forward(plan, z);
+
+    // With z = a + ib: A[k] B[k] = (Z[k]^2 - conj(Z[-k])^2) / 4i. Store its
+    // conjugate so a second forward transform performs the inverse.
+    for (size_t k = 0; k <= n / 2; k++) {
+        size_t j = (n - k) & (n - 1);
+        PolyComplex zk = z[k], zj = z[j];
+        double diff_re = zk.re * zk.re - zk.im * zk.im - zj.re * zj.re + zj.im * zj.im;
+        double diff_im = 2.0 * (zk.re * zk.im + zj.re * zj.im);
+        z[k].re = 0.25 * diff_im;
+        z[k].im = 0.25 * diff_re;
+        z[j].re = 0.25 * diff_im;
+        z[j].im = -0.25 * diff_re;
+    }
+    poly_fft_forward(plan, z);
+
+    double scale = 1.0 / (double)n;
+    for (size_t i = 0; i < need; i++) out[i] = z[i].re * scale;
+    free(z);
+}
+
+/**
+ * FFT product of two real polynomials
+ * @param a, na: First polynomial
+ * @param b, nb: Second polynomial
+ * @param out: Receives na + nb - 1 coefficients
+ */
+static inline void poly_multiply_fft(const double *a, size_t na, const double *b, size_t nb, double *out) {
+    if (!na || !nb) return;
+    PolyFFTPlan plan;
+    poly_fft_plan_init(&plan, na + nb - 1);
+    poly_multiply_fft_with_plan(&plan, a, na, b, nb, out);
+    poly_fft_plan_free(&plan);
+}
+
+/**
+ * Product of two real polynomials, choosing naive, Karatsuba or FFT by size
+ * @param a, na: First polynomial
+ * @param b, nb: Second polynomial
+ * @param out: Receives na + nb - 1 coefficients
+ */
+static inline void poly_multiply(const double *a, size_t na, const double *b, size_t nb, double *out) {
+    size_t shorter = na < nb ? na : nb;
+    if (shorter <= POLY_NAIVE_MAX) {
+        poly_f64_naive(a, na, b, nb, out);
+    } else if (shorter < POLY_FFT_MIN) {
+        poly_f64_karatsuba(a, na, b, nb, out);
+    } else {
+        poly_multiply_fft(a, na, b, nb, out);
+    }
+}
+
+// ==================== NUMBER-THEORETIC TRANSFORM ====================
+
+/**
+ * Modular power with 64-bit products (internal helper)
+ */
+static inline uint32_t poly_pow_mod(uint32_t base, uint64_t exponent, uint32_t p) {
+    uint64_t result = 1, x = base % p;
+    for (; exponent; exponent >>= 1) {
+        if (exponent & 1) result = result * x % p;
+        x = x * x % p;
+    }
+    return (uint32_t)result;
+}
+
+/**
+ * Montgomery constants for prime p (internal helper)
+ * @param prime: Receives p, root and constants
+ * @param p: Odd prime below 2^30
+ * @param g: Primitive root mod p
+ */
+static inline void poly_ntt_prime_init(PolyNTTPrime *prime, uint32_t p, uint32_t g) {
+    uint32_t inv = p; // Newton iteration for p^-1 mod 2^32
+    for (int i = 0; i < 5; i++) inv *= 2u - p * inv;
+    prime->p = p;
+    prime->g = g;
+    prime->neg_inv = (uint32_t)0u - inv;
+    uint64_t r = ((uint64_t)1 << 32) % p;
+    prime->r2 = (uint32_t)(r * r % p);
+}
+
+/**
+ * Montgomery product a * b / 2^32 mod p (internal helper)
+ */
+static inline uint32_t poly_mont_mul(uint32_t a, uint32_t b, const PolyNTTPrime *prime) {
+    uint64_t t = (uint64_t)a * b;
+    uint32_t m = (uint32_t)t * prime->neg_inv;
+    uint32_t u = (uint32_t)((t + (uint64_t)m * prime->p) >> 32);
+    return u >= prime->p ? u - prime->p : u;
+}
+
+/**
+ * Roots table in Montgomery form, laid out like PolyFFTPlan twiddles (internal helper)
+ * @param prime: NTT prime
+ * @param n: Power-of-two transform length
+ * @return: roots[h + j] = w_2h^j * 2^32 mod p (caller frees)
+ */
+static inline uint32_t *poly_ntt_roots(const PolyNTTPrime *prime, size_t n) {
+    uint32_t *roots = (uint32_t *)poly_alloc(n * sizeof(uint32_t), "poly_ntt_roots");
+    size_t top = n / 2;
+    if (top) {
+        uint32_t step = poly_pow_mod(prime->g, (prime->p - 1) / n, prime->p);
+        uint64_t value = ((uint64_t)1 << 32) % prime->p; // 1 in Montgomery form
+        uint32_t step_mont = poly_mont_mul(step, prime->r2, prime);
+        for (size_t j = 0; j < top; j++) {
+            roots[top + j] = (uint32_t)value;
+            value = poly_mont_mul((uint32_t)value, step_mont, prime);
+        }
+        for (size_t h = top / 2; h >= 1; h /= 2) {
+            for (size_t j = 0; j < h; j++) roots[h + j] = roots[top + j * (top / h)];
+        }
+    }
+    roots[0] = 0;
+    return roots;
+}
+
+/**
+ * Forward NTT in place on values < p (internal helper)
+ * @param a: n residues
+ * @param n: Power-of-two length
+ * @param roots: Table from poly_ntt_roots
+ * @param prime: NTT prime
+ */
+static inline void poly_ntt_forward(uint32_t *a, size_t n, const uint32_t *roots, const PolyNTTPrime *prime) {
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) {
+            uint32_t swap = a[i];
+            a[i] = a[j];
+            a[j] = swap;
+        }
+    }
+    uint32_t p = prime->p;
+    for (size_t h = 1; h < n; h *= 2) {
+        const uint32_t *w = roots + h;
+        for (size_t base = 0; base < n; base += 2 * h) {
+            uint32_t *lo = a + base, *hi = lo + h;
+            for (size_t j = 0; j < h; j++) {
+                uint32_t u = lo[j], v = poly_mont_mul(hi[j], w[j], prime);
+                uint32_t sum = u + v;
+                lo[j] = sum >= p ? sum - p : sum;
+                hi[j] = u >= v ? u - v : u + p - v;
+            }
+        }
+    }
+}
+
+/**
+ * Cyclic-free convolution mod one prime, splitting inputs longer than the
+ * prime supports into blocks (internal helper)
+ * @param a, na: First operand, residues < p
+ * @param b, nb: Second operand, residues < p
+ * @param out: Receives na + nb - 1 residues
+ * @param prime: NTT prime
+ */
+static inline void poly_ntt_convolve(const uint32_t *a, size_t na, const uint32_t *b, size_t nb, uint32_t *out,
+                                     const PolyNTTPrime *prime) {
+    size_t need = na + nb - 1;
+    size_t max = (size_t)1 << POLY_NTT_MAX_LOG2;
+    if (need > max) {
+        size_t block = max / 2;
+        uint32_t *partial = (uint32_t *)poly_alloc((2 * block - 1) * sizeof(uint32_t), "poly_ntt_convolve");
+        memset(out, 0, need * sizeof(uint32_t));
+        for (size_t i = 0; i < na; i += block) {
+            size_t la = na - i < block ? na - i : block;
+            for (size_t j = 0; j < nb; j += block) {
+                size_t lb = nb - j < block ? nb - j : block;
+                poly_ntt_convolve(a + i, la, b + j, lb, partial, prime);
+                for (size_t k = 0; k < la + lb - 1; k++) {
+                    uint32_t sum = out[i + j + k] + partial[k];
+                    out[i + j + k] = sum >= prime->p ? sum - prime->p : sum;
+                }
+            }
+        }
+        free(partial);
+        return;
+    }
+
+    size_t n = poly_next_pow2(need);
+    uint32_t *fa = (uint32_t *)poly_alloc(2 * n * sizeof(uint32_t), "poly_ntt_convolve");
+    uint32_t *fb = fa + n;
+    memcpy(fa, a, na * sizeof(uint32_t));
+    memset(fa + na, 0, (n - na) * sizeof(uint32_t));
+    memcpy(fb, b, nb * sizeof(uint32_t));
+    memset(fb + nb, 0, (n - nb) * sizeof(uint32_t));
+
+    uint32_t *roots = poly_ntt_roots(prime, n);
+    poly_ntt_forward(fa, n, roots, prime);
+    poly_ntt_forward(fb, n, roots, prime);
+
+    // Pointwise product with 1/n folded in: mont(mont(x, y), n^-1 * 2^64) = x y / n
+    uint32_t inv_n = poly_pow_mod((uint32_t)(n % prime->p), prime->p - 2, prime->p);
+    uint32_t scale = poly_mont_mul(poly_mont_mul(inv_n, prime->r2, prime), prime->r2, prime);
+    for (size_t i = 0; i < n; i++) fa[i] = poly_mont_mul(poly_mont_mul(fa[i], fb[i], prime), scale, prime);
+
+    // Inverse = forward transform, then reverse entries 1..n-1
+    poly_ntt_forward(fa, n, roots, prime);
+    out[0] = fa[0];
+    for (size_t i = 1; i < need; i++) out[i] = fa[n - i];
+    free(roots);
+    free(fa);
+}
+
+// ==================== EXACT INTEGER PRODUCTS ====================
+
+// Three NTT primes, product ~7.9e25
+typedef struct PolyCRT {
+    PolyNTTPrime primes[3];
+    uint32_t inv_p0_mod_p1;   // p0^-1 mod p1
+    uint32_t inv_p01_mod_p2;  // (p0 p1)^-1 mod p2
+    uint64_t p01;             // p0 * p1
+    uint64_t half01;          // Garner digits of (P - 1) / 2: half01 + p01 * half2
+    uint32_t half2;
+} PolyCRT;
+
+/**
+ * Set up primes and Garner constants (internal helper)
+ */
+static inline void poly_crt_init(PolyCRT *crt) {
+    poly_ntt_prime_init(&crt->primes[0], 998244353u, 3);
+    poly_ntt_prime_init(&crt->primes[1], 167772161u, 3);
+    poly_ntt_prime_init(&crt->primes[2], 469762049u, 3);
+    uint32_t p0 = crt->primes[0].p, p1 = crt->primes[1].p, p2 = crt->primes[2].p;
+    crt->inv_p0_mod_p1 = poly_pow_mod(p0 % p1, p1 - 2, p1);
+    crt->p01 = (uint64_t)p0 * p1;
+    crt->inv_p01_mod_p2 = poly_pow_mod((uint32_t)(crt->p01 % p2), p2 - 2, p2);
+
+    // (P - 1) / 2 is congruent to (p - 1) / 2 modulo each odd prime p
+    uint32_t h0 = (p0 - 1) / 2, h1 = (p1 - 1) / 2, h2 = (p2 - 1) / 2;
+    uint64_t k1 = (uint64_t)((h1 + p1 - h0 % p1) % p1) * crt->inv_p0_mod_p1 % p1;
+    crt->half01 = h0 + (uint64_t)p0 * k1;
+    crt->half2 = (uint32_t)((uint64_t)((h2 + p2 - crt->half01 % p2) % p2) * crt->inv_p01_mod_p2 % p2);
+}
+
+/**
+ * Garner digits of the value with residues r0, r1, r2 (internal helper)
+ * @param low: Receives x mod p0 p1
+ * @return: High digit, x = low + p0 p1 * digit
+ */
+static inline uint32_t poly_crt_digits(const PolyCRT *crt, uint32_t r0, uint32_t r1, uint32_t r2, uint64_t *low) {
+    uint32_t p1 = crt->primes[1].p, p2 = crt->primes[2].p;
+    uint64_t k1 = (uint64_t)((r1 + p1 - r0 % p1) % p1) * crt->inv_p0_mod_p1 % p1;
+    *low = r0 + (uint64_t)crt->primes[0].p * k1;
+    return (uint32_t)((uint64_t)((r2 + p2 - *low % p2) % p2) * crt->inv_p01_mod_p2 % p2);
+}
+
+/**
+ * Convolve residues of a and b modulo each of the three primes (internal helper)
+ * @param a, na: First operand as signed values
+ * @param b, nb: Second operand as signed values
+ * @param residues: Receives 3 * (na + nb - 1) results, one block per prime
+ */
+static inline void poly_crt_convolve(const PolyCRT *crt, const int64_t *a, size_t na, const int64_t *b, size_t nb,
+                                     uint32_t *residues) {
+    size_t need = na + nb - 1;
+    uint32_t *ra = (uint32_t *)poly_alloc((na + nb) * sizeof(uint32_t), "poly_crt_convolve");
+    uint32_t *rb = ra + na;
+    for (int q = 0; q < 3; q++) {
+        int64_t p = crt->primes[q].p;
+        for (size_t i = 0; i < na; i++) ra[i] = (uint32_t)((a[i] % p + p) % p);
+        for (size_t i = 0; i < nb; i++) rb[i] = (uint32_t)((b[i] % p + p) % p);
+        poly_ntt_convolve(ra, na, rb, nb, residues + (size_t)q * need, &crt->primes[q]);
+    }
+    free(ra);
+}
+
+/**
+ * Exact product of integer polynomials, choosing naive, Karatsuba or NTT by size
+ * @param a, na: First polynomial
+ * @param b, nb: Second polynomial
+ * @param out: Receives na + nb - 1 coefficients (each must fit in int64)
+ */
+static inline void poly_multiply_exact(const int64_t *a, size_t na, const int64_t *b, size_t nb, int64_t *out) {
+    if (!na || !nb) return;
+    size_t shorter = na < nb ? na : nb;
+    // Wrapping uint64 arithmetic is exact whenever the true result fits in int64
+    if (shorter <= POLY_NAIVE_MAX) {
+        poly_u64_naive((const uint64_t *)a, na, (const uint64_t *)b, nb, (uint64_t *)out);
+        return;
+    }
+    if (shorter < POLY_EXACT_NTT_MIN) {
+        poly_u64_karatsuba((const uint64_t *)a, na, (const uint64_t *)b, nb, (uint64_t *)out);
+        return;
+    }
+
+    PolyCRT crt;
+    poly_crt_init(&crt);
+    size_t need = na + nb - 1;
+    uint32_t *residues = (uint32_t *)poly_alloc(3 * need * sizeof(uint32_t), "poly_multiply_exact");
+    poly_crt_convolve(&crt, a, na, b, nb, residues);
+
+    // Values above (P - 1) / 2 stand for negative results: subtract P (mod 2^64)
+    uint64_t product = crt.p01 * crt.primes[2].p;
+    for (size_t i = 0; i < need; i++) {
+        uint64_t low;
+        uint32_t high = poly_crt_digits(&crt, residues[i], residues[need + i], residues[2 * need + i], &low);
+        uint64_t value = low + crt.p01 * high;
+        bool negative = high > crt.half2 || (high == crt.half2 && low > crt.half01);
+        out[i] = (int64_t)(negative ? value - product : value);
+    }
+    free(residues);
+}
+
+/**
+ * Product of polynomials modulo m
+ * Exact while min(na, nb) * (m - 1)^2 < 7.9e25 (e.g. m < 2^31 with up to 2^24 terms).
+ * @param a, na: First polynomial, coefficients < modulus
+ * @param b, nb: Second polynomial, coefficients < modulus
+ * @param modulus: Modulus in [1, 2^31]
+ * @param out: Receives na + nb - 1 coefficients mod modulus
+ */
+static inline void poly_multiply_mod(const uint32_t *a, size_t na, const uint32_t *b, size_t nb, uint32_t modulus,
+                                     uint32_t *out) {
+    if (!na || !nb) return;
+    size_t need = na + nb - 1;
+    size_t shorter = na < nb ? na : nb;
+    if (shorter <= POLY_NAIVE_MAX) {
+        memset(out, 0, need * sizeof(uint32_t));
+        for (size_t i = 0; i < na; i++) {
+            for (size_t j = 0; j < nb; j++) {
+                out[i + j] = (uint32_t)((out[i + j] + (uint64_t)a[i] * b[j]) % modulus);
+            }
+        }
+        return;
+    }
+
+    if (modulus == POLY_NTT_MODULUS) { // One transform prime suffices
+        PolyNTTPrime prime;
+        poly_ntt_prime_init(&prime, POLY_NTT_MODULUS, 3);
+        uint32_t *ra = (uint32_t *)poly_alloc((na + nb) * sizeof(uint32_t), "poly_multiply_mod");
+        for (size_t i = 0; i < na; i++) ra[i] = a[i] % modulus;
+        for (size_t i = 0; i < nb; i++) ra[na + i] = b[i] % modulus;
+        poly_ntt_convolve(ra, na, ra + na, nb, out, &prime);
+        free(ra);
+        return;
+    }
+
+    PolyCRT crt;
+    poly_crt_init(&crt);
+    int64_t *sa = (int64_t *)poly_alloc((na + nb) * sizeof(int64_t), "poly_multiply_mod");
+    for (size_t i = 0; i < na; i++) sa[i] = a[i] % modulus;
+    for (size_t i = 0; i < nb; i++) sa[na + i] = b[i] % modulus;
+    uint32_t *residues = (uint32_t *)poly_alloc(3 * need * sizeof(uint32_t), "poly_multiply_mod");
+    poly_crt_convolve(&crt, sa, na, sa + na, nb, residues);
+
+    uint64_t p01_mod = crt.p01 % modulus;
+    for (size_t i = 0; i < need; i++) {
+        uint64_t low;
+        uint32_t high = poly_crt_digits(&crt, residues[i], residues[need + i], residues[2 * need + i], &low);
+        out[i] = (uint32_t)((low % modulus + p01_mod * high % modulus) % modulus);
+    }
+    free(residues);
+    free(sa);
+}
+
+#endif // POLYNOMIAL_H
@@ -0,0 +1,345 @@
+#ifndef SEGTREE_H
+#define SEGTREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * SEGMENT TREES AND FENWICK TREE (MACRO-GENERATED)
+ *
+ * Range aggregates over an array of T, generic over a monoid: COMBINE(a, b)
+ * is associative (not necessarily commutative) and IDENTITY is its neutral
+ * element. Like DEFINE_HEAP, the operations are macros or inline functions
+ * expanded straight into the loops.
+ *
+ * DEFINE_SEGTREE(Name, T, COMBINE, IDENTITY)
+ *   Iterative bottom-up segment tree, no recursion. One flat array: leaves
+ *   at tree[size + i], node k = COMBINE(tree[2k], tree[2k + 1]), size the
+ *   power of two >= n, so tree[1] is the aggregate of the whole array.
+ *
+ * DEFINE_LAZY_SEGTREE(Name, T, COMBINE, IDENTITY, Tag, APPLY, COMPOSE, TAG_IDENTITY)
+ *   Adds range updates. APPLY(tag, value) maps an aggregate, COMPOSE(outer,
+ *   inner) is the tag applying inner then outer, TAG_IDENTITY leaves values
+ *   unchanged. Aggregates that depend on the range length (sum under range
+ *   add) keep a count inside T. Tags are pushed down only along the two
+ *   boundary paths of each operation.
+ *
+ * DEFINE_FENWICK(Name, T, ADD, SUB, ZERO)
+ *   Binary indexed tree for prefix sums over a group (needs SUB for ranges);
+ *   n + 1 values, half the memory of a segment tree and fewer operations.
+ *
+ * Ranges are half-open [lo, hi) over indices 0..n-1.
+ *
+ * Usage:
+ *   DEFINE_SEGTREE(MaxTree, int, SEGTREE_MAX, INT_MIN)
+ *   MaxTree t; MaxTree_init(&t, n); MaxTree_set(&t, 3, 42); MaxTree_query(&t, 0, 10);
+ *
+ * Time Complexities:
+ * - Build: O(n)
+ * - Point set / range query / range apply: O(log n)
+ * - Whole-array aggregate: O(1)
+ * - Fenwick add / prefix: O(log n)
+ *
+ * Space Complexity: O(n) (2 * size values, plus size tags for the lazy tree)
+ */
+
+// Ready-made monoid operations for arithmetic types
+#define SEGTREE_SUM(a, b) ((a) + (b))
+#define SEGTREE_MIN(a, b) ((b) < (a) ? (b) : (a))
+#define SEGTREE_MAX(a, b) ((a) < (b) ? (b) : (a))
+#define SEGTREE_SUB(a, b) ((a) - (b))
+
+/**
+ * Allocate or exit (internal helper)
+ * @param bytes: Size to allocate
+ * @param who: Caller name for the error message
+ * @return: New memory
+ */
+static inline void *segtree_alloc(size_t bytes, const char *who) {
+    void *memory = malloc(bytes ? bytes : 1);
+    if (!memory) {
+        fprintf(stderr, "%s: allocation failed\n", who);
+        exit(EXIT_FAILURE);
+    }
+    return memory;
+}
+
+/**
+ * Leaf count for n elements: power of two >= n (internal helper)
+ * @param n: Element count
+ * @param log: Receives log2 of the result
+ * @return: Leaf count (at least 1)
+ */
+static inline size_t segtree_leaf_count(size_t n, unsigned *log) {
+    size_t size = 1;
+    unsigned bits = 0;
+    while (size < n) {
+        size <<= 1;
+        bits++;
+    }
+    if (log) *log = bits;
+    return size;
+}
+
+// ==================== SEGMENT TREE ====================
+
+#define DEFINE_SEGTREE(Name, T, COMBINE, IDENTITY)                                         \
+                                                                                           \
+typedef struct Name {                                                                      \
+    T *tree;     /* tree[size + i] is element i, tree[1] the root */                       \
+    size_t n;    /* Elements */                                                            \
+    size_t size; /* Leaves (power of two >= n) */                                          \
+} Name;                                                                                    \
+                                                                                           \
+/* Initialize n elements set to IDENTITY */                                                \
+static inline void Name##_init(Name *st, size_t n) {                                       \
+    st->n = n;                                                                             \
+    st->size = segtree_leaf_count(n, NULL);                                                \
+    st->tree = (T *)segtree_alloc(2 * st->size * sizeof(T), #Name "_init");                \
+    for (size_t i = 0; i < 2 * st->size; i++) st->tree[i] = (IDENTITY);                    \
+}                                                                                          \
+                                                                                           \
+/* Recompute every internal node from the leaves, O(size) */                               \
+static inline void Name##_rebuild(Name *st) {                                              \
+    for (size_t k = st->size - 1; k >= 1; k--) {                                           \
+        st->tree[k] = COMBINE(st->tree[2 * k], st->tree[2 * k + 1]);                       \
+    }                                                                                      \
+}                                                                                          \
+                                                                                           \
+/* Initialize from n values in O(n) */                                                     \
+static inline void Name##_build(Name *st, const T *values, size_t n) {                     \
+    Name##_init(st, n);                                                                    \
+    if (n) memcpy(st->tree + st->size, values, n * sizeof(T));                             \
+    Name##_rebuild(st);                                                                    \
+}                                                                                          \
+                                                                                           \
+/* Leaf array: write any number of leaves, then call rebuild once */                       \
+static inline T *Name##_leaves(Name *st) {                                                 \
+    return st->tree + st->size;                                                            \
+}                                                                                          \
+                                                                                           \
+/* Grow to at least n elements; new elements are IDENTITY */                               \
+static inline void Name##_resize(Name *st, size_t n) {                                     \
+    if (n <= st->size) {                                                                   \
+        if (n > st->n) st->n = n;                                                          \
+        return;                                                                            \
+    }                                                                                      \
+    Name grown;                                                                            \
+    Name##_init(&grown, n);                                                                \
+    memcpy(grown.tree + grown.size, st->tree + st->size, st->n * sizeof(T));               \
+    Name##_rebuild(&grown);                                                                \
+    free(st->tree);                                                                        \
+    *st = grown;                                                                           \
+}                                                                                          \
+                                                                                           \
+/* Set element i and update its ancestors */                                               \
+static inline void Name##_set(Name *st, size_t i, T value) {                               \
+    size_t k = st->size + i;                                                               \
+    st->tree[k] = value;                                                                   \
+    for (k >>= 1; k >= 1; k >>= 1) {                                                       \
+        st->tree[k] = COMBINE(st->tree[2 * k], st->tree[2 * k + 1]);                       \
+    }                                                                                      \
+}                                                                                          \
+                                                                                           \
+/* Get element i */                                                                        \
+static inline T Name##_get(const Name *st, size_t i) {                                     \
+    return st->tree[st->size + i];                                                         \
+}                                                                                          \
+                                                                                           \
+/* Aggregate of elements [lo, hi) in index order (IDENTITY if empty) */                    \
+static inline T Name##_query(const Name *st, size_t lo, size_t hi) {                       \
+    T left = (IDENTITY), right = (IDENTITY);                                               \
+    for (lo += st->size, hi += st->size; lo < hi; lo >>= 1, hi >>= 1) {                    \
+        if (lo & 1) { left = COMBINE(left, st->tree[lo]); lo++; }                          \
+        if (hi & 1) { hi--; right = COMBINE(st->tree[hi], right); }                        \
+    }                                                                                      \
+    return COMBINE(left, right);                                                           \
+}                                                                                          \
+                                                                                           \
+/* Aggregate of every element */                                                           \
+static inline T Name##_all(const Name *st) {                                               \
+    return st->tree[1];                                                                    \
+}                                                                                          \
+                                                                                           \
+/* Free tree storage */                                                                    \
+static inline void Name##_free(Name *st) {                                                 \
+    free(st->tree);                                                                        \
+    st->tree = NULL;                                                                       \
+    st->n = 0;                                                                             \
+    st->size = 0;                                                                          \
+}
+
+// ==================== LAZY SEGMENT TREE ====================
+
+#define DEFINE_LAZY_SEGTREE(Name, T, COMBINE, IDENTITY, Tag, APPLY, COMPOSE, TAG_IDENTITY) \
+                                                                                           \
+typedef struct Name {                                                                      \
+    T *tree;      /* Aggregates, laid out as in DEFINE_SEGTREE */                          \
+    Tag *lazy;    /* lazy[k]: pending tag for both children of internal node k */          \
+    size_t n;     /* Elements */                                                           \
+    size_t size;  /* Leaves (power of two >= n) */                                         \
+    unsigned log; /* log2(size) */                                                         \
+} Name;                                                                                    \
+                                                                                           \
+/* Initialize n elements set to IDENTITY */                                                \
+static inline void Name##_init(Name *st, size_t n) {                                       \
+    st->n = n;                                                                             \
+    st->size = segtree_leaf_count(n, &st->log);                                            \
+    st->tree = (T *)segtree_alloc(2 * st->size * sizeof(T), #Name "_init");                \
+    st->lazy = (Tag *)segtree_alloc(st->size * sizeof(Tag), #Name "_init");                \
+    for (size_t i = 0; i < 2 * st->size; i++) st->tree[i] = (IDENTITY);                    \
+    for (size_t i = 0; i < st->size; i++) st->lazy[i] = (TAG_IDENTITY);                    \
+}                                                                                          \
+                                                                                           \
+/* Initialize from n values in O(n) */                                                     \
+static inline void Name##_build(Name *st, const T *values, size_t n) {                     \
+    Name##_init(st, n);                                                                    \
+    if (n) memcpy(st->tree + st->size, values, n * sizeof(T));                             \
+    for (size_t k = st->size - 1; k >= 1; k--) {                                           \
+        st->tree[k] = COMBINE(st->tree[2 * k], st->tree[2 * k + 1]);                       \
+    }                                                                                      \
+}                                                                                          \
+                                                                                           \
+/* Recompute node k from its children (internal helper) */                                 \
+static inline void Name##_pull(Name *st, size_t k) {                                       \
+    st->tree[k] = COMBINE(st->tree[2 * k], st->tree[2 * k + 1]);                           \
+}                                                                                          \
+                                                                                           \
+/* Apply tag to node k's aggregate and queue it for k's children (internal helper) */      \
+static inline void Name##_apply_node(Name *st, size_t k, Tag tag) {                        \
+    st->tree[k] = APPLY(tag, st->tree[k]);                                                 \
+    if (k < st->size) st->lazy[k] = COMPOSE(tag, st->lazy[k]);                             \
+}                                                                                          \
+                                                                                           \
+/* Hand node k's pending tag to its children (internal helper) */                          \
+static inline void Name##_push(Name *st, size_t k) {                                       \
+    Name##_apply_node(st, 2 * k, st->lazy[k]);                                             \
+    Name##_apply_node(st, 2 * k + 1, st->lazy[k]);                                         \
+    st->lazy[k] = (TAG_IDENTITY);                                                          \
+}                                                                                          \
+                                                                                           \
+/* Push tags down the boundary paths of leaf range [lo, hi) (internal helper) */           \
+static inline void Name##_push_bounds(Name *st, size_t lo, size_t hi) {                    \
+    for (unsigned i = st->log; i >= 1; i--) {                                              \
+        if (((lo >> i) << i) != lo) Name##_push(st, lo >> i);                              \
+        if (((hi >> i) << i) != hi) Name##_push(st, (hi - 1) >> i);                        \
+    }                                                                                      \
+}                                                                                          \
+                                                                                           \
+/* Set element i */                                                                        \
+static inline void Name##_set(Name *st, size_t i, T value) {                               \
+    size_t k = st->size + i;                                                               \
+    for (unsigned b = st->log; b >= 1; b--) Name##_push(st, k >> b);                       \
+    st->tree[k] = value;                                                                   \
+    for (unsigned b = 1; b <= st->log; b++) Name##_pull(st, k >> b);                       \
+}                                                                                          \
+                                                                                           \
+/* Get element i with every pending tag applied */                                         \
+static inline T Name##_get(Name *st, size_t i) {                                           \
+    size_t k = st->size + i;                                                               \
+    for (unsigned b = st->log; b >= 1; b--) Name##_push(st, k >> b);                       \
+    return st->tree[k];                                                                    \
+}                                                                                          \
+                                                                                           \
+/* Aggregate of elements [lo, hi) in index order (IDENTITY if empty) */                    \
+static inline T Name##_query(Name *st, size_t lo, size_t hi) {                             \
+    if (lo >= hi) return (IDENTITY);                                                       \
+    lo += st->size;                                                                        \
+    hi += st->size;                                                                        \
+    Name##_push_bounds(st, lo, hi);                                                        \
+    T left = (IDENTITY), right = (IDENTITY);                                               \
+    for (; lo < hi; lo >>= 1, hi >>= 1) {                                                  \
+        if (lo & 1) { left = COMBINE(left, st->tree[lo]); lo++; }                          \
+        if (hi & 1) { hi--; right = COMBINE(st->tree[hi], right); }                        \
+    }                                                                                      \
+    return COMBINE(left, right);                                                           \
+}                                                                                          \
+                                                                                           \
+/* Apply tag to every element of [lo, hi) */                                               \
+static inline void Name##_apply(Name *st, size_t lo, size_t hi, Tag tag) {                 \
+    if (lo >= hi) return;                                                                  \
+    lo += st->size;                                                                        \
+    hi += st->size;                                                                        \
+    Name##_push_bounds(st, lo, hi);                                                        \
+    for (size_t l = lo, h = hi; l < h; l >>= 1, h >>= 1) {                                 \
+        if (l & 1) Name##_apply_node(st, l++, tag);                                        \
+        if (h & 1) Name##_apply_node(st, --h, tag);                                        \
+    }                                                                                      \
+    for (unsigned i = 1; i <= st->log; i++) {                                              \
+        if (((lo >> i) << i) != lo) Name##_pull(st, lo >> i);                              \
+        if (((hi >> i) << i) != hi) Name##_pull(st, (hi - 1) >> i);                        \
+    }                                                                                      \
+}                                                                                          \
+                                                                                           \
+/* Aggregate of every element */                                                           \
+static inline T Name##_all(const Name *st) {                                               \
+    return st->tree[1];                                                                    \
+}                                                                                          \
+                                                                                           \
+/* Free tree storage */                                                                    \
+static inline void Name##_free(Name *st) {                                                 \
+    free(st->tree);                                                                        \
+    free(st->lazy);                                                                        \
+    st->tree = NULL;                                                                       \
+    st->lazy = NULL;                                                                       \
+    st->n = 0;                                                                             \
+    st->size = 0;                                                                          \
+    st->log = 0;                                                                           \
+}
+
+// ==================== FENWICK TREE ====================
+
+#define DEFINE_FENWICK(Name, T, ADD, SUB, ZERO)                                            \
+                                                                                           \
+typedef struct Name {                                                                      \
+    T *tree;  /* tree[k] sums elements (k - lowbit(k), k], 1-based */                      \
+    size_t n; /* Elements */                                                               \
+} Name;                                                                                    \
+                                                                                           \
+/* Initialize n elements set to ZERO */                                                    \
+static inline void Name##_init(Name *ft, size_t n) {                                       \
+    ft->n = n;                                                                             \
+    ft->tree = (T *)segtree_alloc((n + 1) * sizeof(T), #Name "_init");                     \
+    for (size_t i = 0; i <= n; i++) ft->tree[i] = (ZERO);                                  \
+}                                                                                          \
+                                                                                           \
+/* Initialize from n values in O(n): each node passes its sum to its parent */             \
+static inline void Name##_build(Name *ft, const T *values, size_t n) {                     \
+    Name##_init(ft, n);                                                                    \
+    if (n) memcpy(ft->tree + 1, values, n * sizeof(T));                                    \
+    for (size_t k = 1; k <= n; k++) {                                                      \
+        size_t parent = k + (k & (0 - k));                                                 \
+        if (parent <= n) ft->tree[parent] = ADD(ft->tree[parent], ft->tree[k]);            \
+    }                                                                                      \
+}                                                                                          \
+                                                                                           \
+/* Add delta to element i */                                                               \
+static inline void Name##_add(Name *ft, size_t i, T delta) {                               \
+    for (size_t k = i + 1; k <= ft->n; k += k & (0 - k)) {                                 \
+        ft->tree[k] = ADD(ft->tree[k], delta);                                             \
+    }                                                                                      \
+}                                                                                          \
+                                                                                           \
+/* Sum of elements [0, count) */                                                           \
+static inline T Name##_prefix(const Name *ft, size_t count) {                              \
+    T sum = (ZERO);                                                                        \
+    for (size_t k = count; k > 0; k &= k - 1) sum = ADD(sum, ft->tree[k]);                 \
+    return sum;                                                                            \
+}                                                                                          \
+                                                                                           \
+/* Sum of elements [lo, hi) */                                                             \
+static inline T Name##_range(const Name *ft, size_t lo, size_t hi) {                       \
+    return SUB(Name##_prefix(ft, hi), Name##_prefix(ft, lo));                              \
+}                                                                                          \
+                                                                                           \
+/* Free tree storage */                                                                    \
+static inline void Name##_free(Name *ft) {                                                 \
+    free(ft->tree);                                                                        \
+    ft->tree = NULL;                                                                       \
+    ft->n = 0;                                                                             \
+}
+
+#endif // SEGTREE_H
@@ -0,0 +1,275 @@
+#ifndef LIS_H
+#define LIS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * LONGEST INCREASING SUBSEQUENCE
+ *
+ * Patience sorting: tails[k] is the smallest value that can end an
+ * increasing subsequence of length k + 1 among the elements seen so far.
+ * tails is sorted, so each new element binary-searches the pile it lands on
+ * and either replaces that pile's top or starts a new pile; the pile count is
+ * the LIS length. Recording, for every element, the element on top of the
+ * previous pile when it was placed gives parent links from which one longest
+ * subsequence is read back.
+ *
+ * Variants:
+ * - Strict: a[i1] < a[i2] < ... (lower bound search)
+ * - Non-strict: a[i1] <= a[i2] <= ... (upper bound search)
+ *
+ * Streaming: lis_push appends one element and returns the updated length.
+ * Without sequence tracking only the tails are kept, O(LIS length) memory.
+ *
+ * Time Complexities:
+ * - Push: O(log L), L = current LIS length
+ * - Batch compute: O(n log L)
+ * - Reconstruct: O(L)
+ *
+ * Space Complexity: O(L) for length only, O(n) with reconstruction
+ */
+
+// No previous element
+#define LIS_NONE SIZE_MAX
+
+// Incremental LIS state
+typedef struct LISState {
+    int *tails;          // tails[k]: smallest last value of a length k + 1 subsequence
+    size_t *tail_index;  // Element ending that subsequence (tracking only)
+    size_t *parent;      // Previous element in the best subsequence ending at i (tracking only)
+    int *values;         // Pushed elements (tracking only)
+    size_t length;       // Current LIS length
+    size_t tail_capacity;
+    size_t count;        // Elements pushed
+    size_t capacity;     // Slots in parent and values
+    bool strict;         // a < b rather than a <= b
+    bool track;          // Keep what reconstruction needs
+} LISState;
+
+// ==================== SEARCH ====================
+
+/**
+ * Pile for value x: first tail not less than x (strict) or greater than x (internal helper)
+ * Branch-free binary search; appending to the last pile is checked first.
+ * @param tails: Sorted pile tops
+ * @param length: Number of piles
+ * @param x: New element
+ * @param strict: Strict variant
+ * @return: Pile index in [0, length]
+ */
+static inline size_t lis_place(const int *tails, size_t length, int x, bool strict) {
+    if (length == 0) return 0;
+    if (strict ? tails[length - 1] < x : tails[length - 1] <= x) return length;
+    const int *base = tails;
+    size_t n = length;
+    if (strict) {
+        while (n > 1) {
+            size_t half = n / 2;
+            base = base[half] < x ? base + half : base;
+            n -= half;
+        }
+        return (size_t)(base - tails) + (*base < x);
+    }
+    while (n > 1) {
+        size_t half = n / 2;
+        base = base[half] <= x ? base + half : base;
+        n -= half;
+    }
+    return (size_t)(base - tails) + (*base <= x);
+}
+
+// ==================== STREAMING ====================
+
+/**
+ * Initialize empty LIS
+ * @param lis: LIS to initialize
+ * @param strict: true for strictly increasing, false for non-decreasing
+ * @param track: true to keep parent links so the subsequence can be reconstructed
+ */
+static inline void lis_init(LISState *lis, bool strict, bool track) {
+    lis->tails = NULL;
+    lis->tail_index = NULL;
+    lis->parent = NULL;
+    lis->values = NULL;
+    lis->length = 0;
+    lis->tail_capacity = 0;
+    lis->count = 0;
+    lis->capacity = 0;
+    lis->strict = strict;
+    lis->track = track;
+}
+
+/**
+ * Double the per-element arrays (internal helper)
+ * @param lis: Target LIS
+ */
+static inline void lis_grow_elements(LISState *lis) {
+    size_t capacity = lis->capacity ? lis->capacity * 2 : 64;
+    size_t *parent = (size_t *)realloc(lis->parent, capacity * sizeof(size_t));
+    if (parent) lis->parent = parent;
+    int *values = (int *)realloc(lis->values, capacity * sizeof(int));
+    if (values) lis->values = values;
+    if (!parent || !values) {
+        fprintf(stderr, "lis_push: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    lis->capacity = capacity;
+}
+
+/**
+ * Double the pile arrays (internal helper)
+ * @param lis: Target LIS
+ */
+static inline void lis_grow_tails(LISState *lis) {
+    size_t capacity = lis->tail_capacity ? lis->tail_capacity * 2 : 64;
+    int *tails = (int *)realloc(lis->tails, capacity * sizeof(int));
+    if (tails) lis->tails = tails;
+    bool ok = tails != NULL;
+    if (lis->track) {
+        size_t *tail_index = (size_t *)realloc(lis->tail_index, capacity * sizeof(size_t));
+        if (tail_index) lis->tail_index = tail_index;
+        ok = ok && tail_index;
+    }
+    if (!ok) {
+        fprintf(stderr, "lis_push: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    lis->tail_capacity = capacity;
+}
+
+/**
+ * Append one element
+ * @param lis: Target LIS
+ * @param value: Next element of the stream
+ * @return: LIS length of the stream so far
+ */
+static inline size_t lis_push(LISState *lis, int value) {
+    size_t pile = lis_place(lis->tails, lis->length, value, lis->strict);
+    if (pile == lis->tail_capacity) lis_grow_tails(lis);
+    if (lis->track) {
+        if (lis->count == lis->capacity) lis_grow_elements(lis);
+        lis->parent[lis->count] = pile ? lis->tail_index[pile - 1] : LIS_NONE;
+        lis->values[lis->count] = value;
+        lis->tail_index[pile] = lis->count;
+    }
+    lis->tails[pile] = value;
+    lis->length += pile == lis->length;
+    lis->count++;
+    return lis->length;
+}
+
+/**
+ * Get current LIS length
+ * @param lis: Target LIS
+ * @return: Length of the longest subsequence so far
+ */
+static inline size_t lis_length(const LISState *lis) {
+    return lis->length;
+}
+
+/**
+ * Get smallest value ending a subsequence of maximum length
+ * Any element greater than it (strict) or not less (non-strict) extends the LIS.
+ * @param lis: Non-empty LIS
+ * @return: Last pile top
+ */
+static inline int lis_tail(const LISState *lis) {
+    return lis->tails[lis->length - 1];
+}
+
+/**
+ * Write positions of one longest subsequence
+ * @param lis: LIS initialized with track = true
+ * @param indices: Receives lis_length ascending stream positions
+ * @return: Number written (0 without tracking)
+ */
+static inline size_t lis_indices(const LISState *lis, size_t *indices) {
+    if (!lis->track || lis->length == 0) return 0;
+    size_t at = lis->tail_index[lis->length - 1];
+    for (size_t k = lis->length; k-- > 0;) {
+        indices[k] = at;
+        at = lis->parent[at];
+    }
+    return lis->length;
+}
+
+/**
+ * Write values of one longest subsequence
+ * @param lis: LIS initialized with track = true
+ * @param values: Receives lis_length values in stream order
+ * @return: Number written (0 without tracking)
+ */
+static inline size_t lis_values(const LISState *lis, int *values) {
+    if (!lis->track || lis->length == 0) return 0;
+    size_t at = lis->tail_index[lis->length - 1];
+    for (size_t k = lis->length; k-- > 0;) {
+        values[k] = lis->values[at];
+        at = lis->parent[at];
+    }
+    return lis->length;
+}
+
+/**
+ * Free LIS state
+ * @param lis: LIS to free
+ */
+static inline void lis_free(LISState *lis) {
+    free(lis->tails);
+    free(lis->tail_index);
+    free(lis->parent);
+    free(lis->values);
+    lis_init(lis, lis->strict, lis->track);
+}
+
+// ==================== BATCH ====================
+
+/**
+ * LIS of an array, optionally with the positions of one longest subsequence
+ * @param values: Input elements
+ * @param n: Number of elements
+ * @param strict: true for strictly increasing, false for non-decreasing
+ * @param indices: Receives the ascending positions (room for n), or NULL for length only
+ * @return: LIS length
+ */
+static inline size_t lis_compute(const int *values, size_t n, bool strict, size_t *indices) {
+    if (n == 0) return 0;
+    int *tails = (int *)malloc(n * sizeof(int));
+    size_t *tail_index = NULL, *parent = NULL;
+    if (indices) {
+        tail_index = (size_t *)malloc(n * sizeof(size_t));
+        parent = (size_t *)malloc(n * sizeof(size_t));
+    }
+    if (!tails || (indices && (!tail_index || !parent))) {
+        fprintf(stderr, "lis_compute: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t length = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t pile = lis_place(tails, length, values[i], strict);
+        tails[pile] = values[i];
+        length += pile == length;
+        if (indices) {
+            parent[i] = pile ? tail_index[pile - 1] : LIS_NONE;
+            tail_index[pile] = i;
+        }
+    }
+
+    if (indices) {
+        size_t at = tail_index[length - 1];
+        for (size_t k = length; k-- > 0;) {
+            indices[k] = at;
+            at = parent[at];
+        }
+    }
+    free(tails);
+    free(tail_index);
+    free(parent);
+    return length;
+}
+
+#endif // LIS_H
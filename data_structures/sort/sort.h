@@ -0,0 +1,427 @@
+#ifndef SORT_H
+#define SORT_H
+
+#include "../parallel/thread_pool.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * SORTING (MACRO-GENERATED INTROSORT AND MERGE SORT, LSD RADIX SORT)
+ *
+ * DEFINE_SORT(Name, T, COMPARE) generates sorts over arrays of T with
+ * COMPARE(a, b) expanded inline (two T values, <0 / 0 / >0 like qsort), so
+ * there is no per-comparison indirect call as with qsort:
+ * - Name_sort(data, n): introsort. Median-of-three quicksort, insertion sort
+ *   below SORT_INSERTION_THRESHOLD, heapsort once recursion passes
+ *   2 log2 n levels, so the worst case stays O(n log n). In place, not
+ *   stable; the fastest choice when T holds the compared values itself.
+ * - Name_merge_sort(data, n): stable bottom-up merge sort with an n-element
+ *   buffer. Fewer comparisons than introsort, and its first passes touch
+ *   neighbouring elements, so it wins when T is a pointer to records laid
+ *   out in allocation order (the usual DynArray) and each comparison is a
+ *   cache miss.
+ * - Name_parallel_sort(data, n, pool): each pool worker merge sorts one
+ *   chunk, then the chunks are merged pairwise. Every merge round is split
+ *   into one task per worker by merge-path co-ranking, so the last round
+ *   (one merge of n elements) is parallel too. Stable. Below
+ *   SORT_PARALLEL_THRESHOLD elements, or with a NULL or single-thread pool,
+ *   this falls back to Name_merge_sort.
+ *
+ * DEFINE_SORT_WITH(Name, T, Ctx, COMPARE) is the same with a context value
+ * passed through as COMPARE(ctx, a, b), for orders chosen at run time (a
+ * comparator function pointer, a key offset, ...). The generated functions
+ * take a trailing Ctx argument.
+ *
+ * sort_radix_by_key sorts pointers by a 64-bit key, stable, in O(n) with
+ * one byte-wide counting pass per key byte that actually varies.
+ * sort_key_from_int / sort_key_from_float map signed values to unsigned
+ * keys with the same order.
+ *
+ * Usage:
+ *   DEFINE_SORT(IntSort, int, SORT_CMP)
+ *   IntSort_sort(values, count);
+ *
+ * Time Complexities:
+ * - Introsort / merge sort: O(n log n) worst case
+ * - Parallel merge sort: O((n log n) / p + n log p / p) work per worker
+ * - Radix sort: O(n * varying key bytes)
+ *
+ * Space Complexity: O(log n) introsort, O(n) merge and radix buffers
+ */
+
+// Ranges at most this long are finished by insertion sort
+#define SORT_INSERTION_THRESHOLD 16
+
+// Smallest input worth splitting across a thread pool
+#ifndef SORT_PARALLEL_THRESHOLD
+#define SORT_PARALLEL_THRESHOLD 65536
+#endif
+
+// Below this many elements radix sort uses insertion sort on the keys
+#define SORT_RADIX_THRESHOLD 64
+
+// Ready-made comparator for arithmetic values
+#define SORT_CMP(a, b) (((a) > (b)) - ((a) < (b)))
+
+// Extracts the sort key of one element for sort_radix_by_key
+typedef uint64_t (*SortKeyFn)(const void *element, const void *ctx);
+
+/**
+ * Start of chunk i when n elements are cut into chunks near-equal parts (internal helper)
+ * @param n: Total elements
+ * @param chunks: Number of chunks
+ * @param i: Chunk index (0..chunks)
+ * @return: Offset of the chunk
+ */
+static inline size_t sort_chunk_start(size_t n, size_t chunks, size_t i) {
+    return i * (n / chunks) + (i < n % chunks ? i : n % chunks);
+}
+
+/**
+ * Allocate a sort buffer or exit (internal helper)
+ * @param bytes: Buffer size
+ * @param caller: Name reported on failure
+ * @return: Uninitialized buffer
+ */
+static inline void *sort_buffer_alloc(size_t bytes, const char *caller) {
+    void *buffer = malloc(bytes > 0 ? bytes : 1);
+    if (!buffer) {
+        fprintf(stderr, "%s: allocation failed\n", caller);
+        exit(EXIT_FAILURE);
+    }
+    return buffer;
+}
+
+// Swap two lvalues of type T
+#define SORT_SWAP(T, x, y) do { T sort_swap_ = (x); (x) = (y); (y) = sort_swap_; } while (0)
+
+#define DEFINE_SORT_WITH(Name, T, Ctx, COMPARE)                                             \
+                                                                                            \
+/* Insertion sort of a short range */                                                       \
+static inline void Name##_insertion(T *data, size_t n, Ctx ctx) {                           \
+    for (size_t i = 1; i < n; i++) {                                                        \
+        T value = data[i];                                                                  \
+        size_t j = i;                                                                       \
+        while (j > 0 && COMPARE(ctx, value, data[j - 1]) < 0) {                             \
+            data[j] = data[j - 1];                                                          \
+            j--;                                                                            \
+        }                                                                                   \
+        data[j] = value;                                                                    \
+    }                                                                                       \
+}                                                                                           \
+                                                                                            \
+/* Restore the max-heap property below root */                                              \
+static inline void Name##_sift(T *data, size_t root, size_t n, Ctx ctx) {                   \
+    T value = data[root];                                                                   \
+    size_t child;                                                                           \
+    while ((child = 2 * root + 1) < n) {                                                    \
+        if (child + 1 < n && COMPARE(ctx, data[child], data[child + 1]) < 0) child++;       \
+        if (COMPARE(ctx, value, data[child]) >= 0) break;                                   \
+        data[root] = data[child];                                                           \
+        root = child;                                                                       \
+    }                                                                                       \
+    data[root] = value;                                                                     \
+}                                                                                           \
+                                                                                            \
+/* Heapsort, the introsort fallback once recursion gets too deep */                         \
+static inline void Name##_heapsort(T *data, size_t n, Ctx ctx) {                            \
+    for (size_t i = n / 2; i > 0; i--) Name##_sift(data, i - 1, n, ctx);                    \
+    for (size_t end = n; end > 1; end--) {                                                  \
+        SORT_SWAP(T, data[0], data[end - 1]);                                               \
+        Name##_sift(data, 0, end - 1, ctx);                                                 \
+    }                                                                                       \
+}                                                                                           \
+                                                                                            \
+/* Quicksort the range, recursing into the smaller side only */                             \
+static inline void Name##_introsort(T *data, size_t n, unsigned depth, Ctx ctx) {           \
+    while (n > SORT_INSERTION_THRESHOLD) {                                                  \
+        if (depth == 0) {                                                                   \
+            Name##_heapsort(data, n, ctx);                                                  \
+            return;                                                                         \
+        }                                                                                   \
+        depth--;                                                                            \
+        /* Median of three; data[0] <= pivot <= data[n - 1] bound both scans */             \
+        size_t mid = n / 2;                                                                 \
+        if (COMPARE(ctx, data[mid], data[0]) < 0) SORT_SWAP(T, data[mid], data[0]);         \
+        if (COMPARE(ctx, data[n - 1], data[mid]) < 0) {                                     \
+            SORT_SWAP(T, data[mid], data[n - 1]);                                           \
+            if (COMPARE(ctx, data[mid], data[0]) < 0) SORT_SWAP(T, data[mid], data[0]);     \
+        }                                                                                   \
+        T pivot = data[mid];                                                                \
+        size_t i = 0, j = n - 1;                                                            \
+        for (;;) {                                                                          \
+            do i++; while (COMPARE(ctx, data[i], pivot) < 0);                               \
+            do j--; while (COMPARE(ctx, pivot, data[j]) < 0);                               \
+            if (i >= j) break;                                                              \
+            SORT_SWAP(T, data[i], data[j]);                                                 \
+        }                                                                                   \
+        /* [0, i) <= pivot <= [i, n), both sides non-empty */                               \
+        if (i < n - i) {                                                                    \
+            Name##_introsort(data, i, depth, ctx);                                          \
+            data += i;                                                                      \
+            n -= i;                                                                         \
+        } else {                                                                            \
+            Name##_introsort(data + i, n - i, depth, ctx);                                  \
+            n = i;                                                                          \
+        }                                                                                   \
+    }                                                                                       \
+    Name##_insertion(data, n, ctx);                                                         \
+}                                                                                           \
+                                                                                            \
+/* Sort data[0, n) in place */                                                              \
+static inline void Name##_sort(T *data, size_t n, Ctx ctx) {                                \
+    unsigned depth = 0;                                                                     \
+    for (size_t m = n; m > 1; m >>= 1) depth += 2;                                          \
+    Name##_introsort(data, n, depth, ctx);                                                  \
+}                                                                                           \
+                                                                                            \
+/* Elements of a that precede output position d of merge(a, b), a first on ties */          \
+static inline size_t Name##_corank(T const *a, size_t na, T const *b, size_t nb, size_t d,  \
+                                   Ctx ctx) {                                               \
+    size_t lo = d > nb ? d - nb : 0;                                                        \
+    size_t hi = d < na ? d : na;                                                            \
+    while (lo < hi) {                                                                       \
+        size_t i = lo + (hi - lo) / 2;                                                      \
+        /* Take more from a while a[i] does not exceed b[d - i - 1] */                      \
+        if (COMPARE(ctx, a[i], b[d - i - 1]) <= 0) lo = i + 1;                              \
+        else hi = i;                                                                        \
+    }                                                                                       \
+    return lo;                                                                              \
+}                                                                                           \
+                                                                                            \
+/* Merge sorted a and b into out */                                                         \
+static inline void Name##_merge(T const *a, size_t na, T const *b, size_t nb, T *out,       \
+                                Ctx ctx) {                                                  \
+    size_t i = 0, j = 0, k = 0;                                                             \
+    while (i < na && j < nb) {                                                              \
+        if (COMPARE(ctx, b[j], a[i]) < 0) out[k++] = b[j++];                                \
+        else out[k++] = a[i++];                                                             \
+    }                                                                                       \
+    while (i < na) out[k++] = a[i++];                                                       \
+    while (j < nb) out[k++] = b[j++];                                                       \
+}                                                                                           \
+                                                                                            \
+/* Stable merge sort of data[0, n), buffer[0, n) is scratch */                              \
+static inline void Name##_merge_sort_into(T *data, size_t n, T *buffer, Ctx ctx) {          \
+    size_t run = SORT_INSERTION_THRESHOLD;                                                  \
+    for (size_t lo = 0; lo < n; lo += run) {                                                \
+        Name##_insertion(data + lo, n - lo < run ? n - lo : run, ctx);                      \
+    }                                                                                       \
+    T *src = data;                                                                          \
+    T *dst = buffer;                                                                        \
+    for (; run < n; run *= 2) {                                                             \
+        for (size_t lo = 0; lo < n; lo += 2 * run) {                                        \
+            size_t mid = n - lo > run ? lo + run : n;                                       \
+            size_t hi = n - mid > run ? mid + run : n;                                      \
+            if (mid == hi || COMPARE(ctx, src[mid], src[mid - 1]) >= 0) {                   \
+                memcpy(dst + lo, src + lo, (hi - lo) * sizeof(T)); /* Already in order */   \
+            } else {                                                                        \
+                Name##_merge(src + lo, mid - lo, src + mid, hi - mid, dst + lo, ctx);       \
+            }                                                                               \
+        }                                                                                   \
+        T *swap = src;                                                                      \
+        src = dst;                                                                          \
+        dst = swap;                                                                         \
+    }                                                                                       \
+    if (src != data) memcpy(data, src, n * sizeof(T));                                      \
+}                                                                                           \
+                                                                                            \
+/* Stable merge sort of data[0, n) */                                                       \
+static inline void Name##_merge_sort(T *data, size_t n, Ctx ctx) {                          \
+    if (n <= SORT_INSERTION_THRESHOLD) {                                                    \
+        Name##_insertion(data, n, ctx);                                                     \
+        return;                                                                             \
+    }                                                                                       \
+    T *buffer = (T *)sort_buffer_alloc(n * sizeof(T), #Name "_merge_sort");                 \
+    Name##_merge_sort_into(data, n, buffer, ctx);                                           \
+    free(buffer);                                                                           \
+}                                                                                           \
+                                                                                            \
+/* Shared state of one parallel sort */                                                     \
+typedef struct Name##SortJob {                                                              \
+    T *src;        /* Runs being merged this round */                                       \
+    T *dst;        /* Receives the merged runs */                                           \
+    size_t n;                                                                               \
+    size_t chunks; /* Initial runs, a power of two */                                       \
+    size_t width;  /* Chunks per run this round */                                          \
+    size_t parts;  /* Tasks per merge this round */                                         \
+    Ctx ctx;                                                                                \
+} Name##SortJob;                                                                            \
+                                                                                            \
+/* Task: merge sort chunks [begin, end), using their slice of dst as scratch */             \
+static inline void Name##_sort_chunks(void *arg, size_t begin, size_t end, size_t worker) { \
+    Name##SortJob *job = (Name##SortJob *)arg;                                              \
+    (void)worker;                                                                           \
+    for (size_t c = begin; c < end; c++) {                                                  \
+        size_t lo = sort_chunk_start(job->n, job->chunks, c);                               \
+        size_t hi = sort_chunk_start(job->n, job->chunks, c + 1);                           \
+        Name##_merge_sort_into(job->src + lo, hi - lo, job->dst + lo, job->ctx);            \
+    }                                                                                       \
+}                                                                                           \
+                                                                                            \
+/* Task: merge output slices [begin, end), parts slices per pair of runs */                 \
+static inline void Name##_merge_slices(void *arg, size_t begin, size_t end,                 \
+                                       size_t worker) {                                     \
+    Name##SortJob *job = (Name##SortJob *)arg;                                              \
+    (void)worker;                                                                           \
+    for (size_t t = begin; t < end; t++) {                                                  \
+        size_t pair = t / job->parts, part = t % job->parts;                                \
+        size_t start = sort_chunk_start(job->n, job->chunks, 2 * pair * job->width);        \
+        size_t middle = sort_chunk_start(job->n, job->chunks, (2 * pair + 1) * job->width); \
+        size_t stop = sort_chunk_start(job->n, job->chunks, (2 * pair + 2) * job->width);   \
+        T const *a = job->src + start;                                                      \
+        T const *b = job->src + middle;                                                     \
+        size_t na = middle - start, nb = stop - middle, total = na + nb;                    \
+        size_t lo = part * total / job->parts, hi = (part + 1) * total / job->parts;        \
+        size_t ia = Name##_corank(a, na, b, nb, lo, job->ctx);                              \
+        size_t ja = Name##_corank(a, na, b, nb, hi, job->ctx);                              \
+        Name##_merge(a + ia, ja - ia, b + (lo - ia), (hi - ja) - (lo - ia),                 \
+                     job->dst + start + lo, job->ctx);                                      \
+    }                                                                                       \
+}                                                                                           \
+                                                                                            \
+/* Sort data[0, n) with the workers of pool */                                              \
+static inline void Name##_parallel_sort(T *data, size_t n, Ctx ctx, ThreadPool *pool) {     \
+    size_t threads = pool ? thread_pool_size(pool) : 1;                                     \
+    if (threads < 2 || n < SORT_PARALLEL_THRESHOLD) {                                       \
+        Name##_merge_sort(data, n, ctx);                                                    \
+        return;                                                                             \
+    }                                                                                       \
+    T *buffer = (T *)sort_buffer_alloc(n * sizeof(T), #Name "_parallel_sort");              \
+    Name##SortJob job = {data, buffer, n, 1, 1, 1, ctx};                                    \
+    while (job.chunks < threads) job.chunks <<= 1;                                          \
+    thread_pool_parallel_for(pool, 0, job.chunks, 1, Name##_sort_chunks, &job);             \
+    for (; job.width < job.chunks; job.width <<= 1) {                                       \
+        size_t pairs = job.chunks / (2 * job.width);                                        \
+        job.parts = (threads + pairs - 1) / pairs;                                          \
+        thread_pool_parallel_for(pool, 0, pairs * job.parts, 1, Name##_merge_slices, &job); \
+        T *swap = job.src;                                                                  \
+        job.src = job.dst;                                                                  \
+        job.dst = swap;                                                                     \
+    }                                                                                       \
+    if (job.src != data) memcpy(data, job.src, n * sizeof(T));                              \
+    free(buffer);                                                                           \
+}
+
+#define DEFINE_SORT(Name, T, COMPARE)                                                       \
+                                                                                            \
+/* Context-free adaptor so DEFINE_SORT_WITH can expand COMPARE inline */                    \
+static inline int Name##_compare_values(const void *ctx, T a, T b) {                        \
+    (void)ctx;                                                                              \
+    return COMPARE(a, b);                                                                   \
+}                                                                                           \
+                                                                                            \
+DEFINE_SORT_WITH(Name##_with, T, const void *, Name##_compare_values)                       \
+                                                                                            \
+/* Sort data[0, n) in place with introsort */                                               \
+static inline void Name##_sort(T *data, size_t n) {                                         \
+    Name##_with_sort(data, n, NULL);                                                        \
+}                                                                                           \
+                                                                                            \
+/* Stable merge sort of data[0, n) */                                                       \
+static inline void Name##_merge_sort(T *data, size_t n) {                                   \
+    Name##_with_merge_sort(data, n, NULL);                                                  \
+}                                                                                           \
+                                                                                            \
+/* Stable sort of data[0, n) on the workers of pool (NULL sorts on the caller) */           \
+static inline void Name##_parallel_sort(T *data, size_t n, ThreadPool *pool) {              \
+    Name##_with_parallel_sort(data, n, NULL, pool);                                         \
+}
+
+// ==================== RADIX SORT ====================
+
+/**
+ * Map a signed integer to an unsigned key with the same order
+ * @param value: Integer value
+ * @return: Order-preserving key
+ */
+static inline uint32_t sort_key_from_int(int32_t value) {
+    return (uint32_t)value ^ 0x80000000u;
+}
+
+/**
+ * Map a float to an unsigned key with the same order (-0 sorts before +0, NaNs at the ends)
+ * @param value: Float value
+ * @return: Order-preserving key
+ */
+static inline uint32_t sort_key_from_float(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+/**
+ * Sort pointers by key, stable: LSD radix sort, one pass per varying key byte
+ * @param data: Pointers to reorder
+ * @param n: Number of pointers
+ * @param key: Key of each element, called once per element
+ * @param ctx: Passed to key
+ */
+static inline void sort_radix_by_key(void **data, size_t n, SortKeyFn key, const void *ctx) {
+    if (n < 2) return;
+    uint64_t *keys = (uint64_t *)sort_buffer_alloc(2 * n * sizeof(uint64_t), "sort_radix_by_key");
+    for (size_t i = 0; i < n; i++) keys[i] = key(data[i], ctx);
+
+    if (n < SORT_RADIX_THRESHOLD) {
+        for (size_t i = 1; i < n; i++) {
+            uint64_t k = keys[i];
+            void *item = data[i];
+            size_t j = i;
+            for (; j > 0 && keys[j - 1] > k; j--) {
+                keys[j] = keys[j - 1];
+                data[j] = data[j - 1];
+            }
+            keys[j] = k;
+            data[j] = item;
+        }
+        free(keys);
+        return;
+    }
+
+    // All eight byte histograms in one read of the keys
+    size_t (*counts)[256] = (size_t (*)[256])calloc(8 * 256, sizeof(size_t));
+    if (!counts) {
+        fprintf(stderr, "sort_radix_by_key: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < n; i++) {
+        uint64_t k = keys[i];
+        for (unsigned byte = 0; byte < 8; byte++) counts[byte][(k >> (8 * byte)) & 0xFF]++;
+    }
+
+    void **items = (void **)sort_buffer_alloc(n * sizeof(void *), "sort_radix_by_key");
+    uint64_t *src_keys = keys, *dst_keys = keys + n;
+    void **src = data, **dst = items;
+    for (unsigned byte = 0; byte < 8; byte++) {
+        size_t *count = counts[byte];
+        unsigned shift = 8 * byte;
+        if (count[(src_keys[0] >> shift) & 0xFF] == n) continue; // Byte is the same everywhere
+        size_t offset = 0;
+        for (unsigned b = 0; b < 256; b++) {
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            size_t slot = count[(src_keys[i] >> shift) & 0xFF]++;
+            dst_keys[slot] = src_keys[i];
+            dst[slot] = src[i];
+        }
+        uint64_t *swap_keys = src_keys;
+        src_keys = dst_keys;
+        dst_keys = swap_keys;
+        void **swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != data) memcpy(data, src, n * sizeof(void *));
+    free(counts);
+    free(keys);
+    free(items);
+}
+
+#endif // SORT_H
@@ -0,0 +1,360 @@
+#ifndef DS_STATS_H
+#define DS_STATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * CONTAINER STATISTICS REGISTRY
+ *
+ * Opt-in hot-path counters, compiled in with -DDS_STATS. Containers report
+ * through the DS_STATS_* macros below; without DS_STATS the macros expand to
+ * nothing (or to a discarded expression the optimizer drops), so the
+ * instrumented paths compile to the same code as before.
+ *
+ * Counters are kept per container kind (all hash tables share one block) in
+ * a single registry, updated with relaxed atomics so instrumented containers
+ * stay usable from several threads. The registry is a weak symbol defined by
+ * this header, so every translation unit of a program shares it.
+ *
+ * Recorded:
+ * - probe length of each lookup (chain entries or slots visited), as a
+ *   power-of-two histogram with sum, count and maximum
+ * - resizes and the wall time spent in them
+ * - heap sift operations and the levels they moved
+ * - allocations and bytes requested by the container itself
+ *
+ * Export: ds_stats_write_json and ds_stats_write_prometheus (text format
+ * 0.0.4). Both also work in builds without DS_STATS and report everything
+ * as zero ("enabled": false).
+ *
+ * Time Complexities:
+ * - Record: O(1), one or two relaxed atomic adds
+ * - Export / reset: O(kinds)
+ *
+ * Space Complexity: O(kinds), fixed
+ */
+
+// Container kinds with their own counter block
+typedef enum {
+    DS_STATS_HASHTABLE,
+    DS_STATS_FLAT_HASHTABLE,
+    DS_STATS_DYNARRAY,
+    DS_STATS_BINARY_HEAP,
+    DS_STATS_DARY_HEAP,
+    DS_STATS_INDEXED_HEAP,
+    DS_STATS_KIND_COUNT
+} DSStatsKind;
+
+// Probe-length buckets: <= 1, 2, 4, ..., 64, then +Inf
+#define DS_STATS_HISTOGRAM_BUCKETS 8
+
+static const char *const DS_STATS_KIND_NAMES[DS_STATS_KIND_COUNT] = {
+    "hashtable", "flat_hashtable", "dynarray", "binary_heap", "dary_heap", "indexed_heap"};
+
+// Plain copy of one kind's counters
+typedef struct DSStatsSnapshot {
+    uint64_t lookups;                                     // Lookups with a recorded probe length
+    uint64_t probe_steps;                                 // Sum of those lengths
+    uint64_t probe_max;                                   // Longest single probe
+    uint64_t probe_histogram[DS_STATS_HISTOGRAM_BUCKETS]; // Lookups per length bucket (not cumulative)
+    uint64_t resizes;
+    uint64_t resize_ns;                                   // Wall time inside resizes
+    uint64_t sifts;                                       // Heap sift-up/sift-down calls
+    uint64_t sift_levels;                                 // Levels moved by them
+    uint64_t sift_max;                                    // Deepest single sift
+    uint64_t allocations;                                 // malloc/calloc/realloc calls
+    uint64_t allocated_bytes;                             // Bytes requested by them
+} DSStatsSnapshot;
+
+#ifdef DS_STATS
+
+#include <stdatomic.h>
+#include <time.h>
+
+// Live counters of one kind
+typedef struct DSStats {
+    _Atomic uint64_t lookups;
+    _Atomic uint64_t probe_steps;
+    _Atomic uint64_t probe_max;
+    _Atomic uint64_t probe_histogram[DS_STATS_HISTOGRAM_BUCKETS];
+    _Atomic uint64_t resizes;
+    _Atomic uint64_t resize_ns;
+    _Atomic uint64_t sifts;
+    _Atomic uint64_t sift_levels;
+    _Atomic uint64_t sift_max;
+    _Atomic uint64_t allocations;
+    _Atomic uint64_t allocated_bytes;
+} DSStats;
+
+// The registry: one definition shared by all translation units
+__attribute__((weak)) DSStats ds_stats_registry[DS_STATS_KIND_COUNT];
+
+#define DS_STATS_PROBE(kind, length) ds_stats_record_probe((kind), (uint64_t)(length))
+#define DS_STATS_SIFT(kind, levels) ds_stats_record_sift((kind), (uint64_t)(levels))
+#define DS_STATS_ALLOC(kind, bytes) ds_stats_record_alloc((kind), (uint64_t)(bytes))
+#define DS_STATS_TIMER(name) uint64_t name = ds_stats_now_ns()
+#define DS_STATS_RESIZE(kind, timer) ds_stats_record_resize((kind), (timer))
+
+/**
+ * Monotonic clock in nanoseconds (internal helper)
+ * @return: Current time
+ */
+static inline uint64_t ds_stats_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * Raise a maximum counter (internal helper)
+ * @param slot: Counter holding the maximum so far
+ * @param value: Candidate
+ */
+static inline void ds_stats_raise(_Atomic uint64_t *slot, uint64_t value) {
+    uint64_t seen = atomic_load_explicit(slot, memory_order_relaxed);
+    while (value > seen && !atomic_compare_exchange_weak_explicit(slot, &seen, value, memory_order_relaxed,
+                                                                  memory_order_relaxed)) {
+    }
+}
+
+/**
+ * Histogram bucket of a probe length (internal helper)
+ * @param length: Entries or slots visited
+ * @return: Bucket index, ceil(log2(length)) capped at the +Inf bucket
+ */
+static inline unsigned ds_stats_bucket(uint64_t length) {
+    if (length <= 1) return 0;
+    unsigned bucket = 64 - (unsigned)__builtin_clzll(length - 1);
+    return bucket < DS_STATS_HISTOGRAM_BUCKETS - 1 ? bucket : DS_STATS_HISTOGRAM_BUCKETS - 1;
+}
+
+/**
+ * Record the probe length of one lookup (use DS_STATS_PROBE)
+ * @param kind: Container kind
+ * @param length: Entries or slots visited
+ */
+static inline void ds_stats_record_probe(DSStatsKind kind, uint64_t length) {
+    DSStats *stats = &ds_stats_registry[kind];
+    atomic_fetch_add_explicit(&stats->lookups, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->probe_steps, length, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->probe_histogram[ds_stats_bucket(length)], 1, memory_order_relaxed);
+    ds_stats_raise(&stats->probe_max, length);
+}
+
+/**
+ * Record one heap sift (use DS_STATS_SIFT)
+ * @param kind: Container kind
+ * @param levels: Levels the element moved
+ */
+static inline void ds_stats_record_sift(DSStatsKind kind, uint64_t levels) {
+    DSStats *stats = &ds_stats_registry[kind];
+    atomic_fetch_add_explicit(&stats->sifts, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->sift_levels, levels, memory_order_relaxed);
+    ds_stats_raise(&stats->sift_max, levels);
+}
+
+/**
+ * Record one allocation (use DS_STATS_ALLOC)
+ * @param kind: Container kind
+ * @param bytes: Bytes requested
+ */
+static inline void ds_stats_record_alloc(DSStatsKind kind, uint64_t bytes) {
+    DSStats *stats = &ds_stats_registry[kind];
+    atomic_fetch_add_explicit(&stats->allocations, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->allocated_bytes, bytes, memory_order_relaxed);
+}
+
+/**
+ * Record one finished resize (use DS_STATS_RESIZE)
+ * @param kind: Container kind
+ * @param started: ds_stats_now_ns() when the resize began
+ */
+static inline void ds_stats_record_resize(DSStatsKind kind, uint64_t started) {
+    DSStats *stats = &ds_stats_registry[kind];
+    atomic_fetch_add_explicit(&stats->resizes, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->resize_ns, ds_stats_now_ns() - started, memory_order_relaxed);
+}
+
+#else
+
+#define DS_STATS_PROBE(kind, length) ((void)(length))
+#define DS_STATS_SIFT(kind, levels) ((void)(levels))
+#define DS_STATS_ALLOC(kind, bytes) ((void)0)
+#define DS_STATS_TIMER(name)
+#define DS_STATS_RESIZE(kind, timer) ((void)0)
+
+#endif // DS_STATS
+
+// ==================== REGISTRY ====================
+
+/**
+ * Check whether counters are compiled in
+ * @return: true when built with -DDS_STATS
+ */
+static inline bool ds_stats_enabled(void) {
+#ifdef DS_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Read one kind's counters
+ * @param kind: Container kind
+ * @param out: Receives the counters (all zero without DS_STATS)
+ */
+static inline void ds_stats_snapshot(DSStatsKind kind, DSStatsSnapshot *out) {
+    memset(out, 0, sizeof(*out));
+#ifdef DS_STATS
+    DSStats *stats = &ds_stats_registry[kind];
+    out->lookups = atomic_load_explicit(&stats->lookups, memory_order_relaxed);
+    out->probe_steps = atomic_load_explicit(&stats->probe_steps, memory_order_relaxed);
+    out->probe_max = atomic_load_explicit(&stats->probe_max, memory_order_relaxed);
+    for (unsigned b = 0; b < DS_STATS_HISTOGRAM_BUCKETS; b++) {
+        out->probe_histogram[b] = atomic_load_explicit(&stats->probe_histogram[b], memory_order_relaxed);
+    }
+    out->resizes = atomic_load_explicit(&stats->resizes, memory_order_relaxed);
+    out->resize_ns = atomic_load_explicit(&stats->resize_ns, memory_order_relaxed);
+    out->sifts = atomic_load_explicit(&stats->sifts, memory_order_relaxed);
+    out->sift_levels = atomic_load_explicit(&stats->sift_levels, memory_order_relaxed);
+    out->sift_max = atomic_load_explicit(&stats->sift_max, memory_order_relaxed);
+    out->allocations = atomic_load_explicit(&stats->allocations, memory_order_relaxed);
+    out->allocated_bytes = atomic_load_explicit(&stats->allocated_bytes, memory_order_relaxed);
+#else
+    (void)kind;
+#endif
+}
+
+/**
+ * Zero every counter
+ */
+static inline void ds_stats_reset(void) {
+#ifdef DS_STATS
+    for (int kind = 0; kind < DS_STATS_KIND_COUNT; kind++) {
+        DSStats *stats = &ds_stats_registry[kind];
+        atomic_store_explicit(&stats->lookups, 0, memory_order_relaxed);
+        atomic_store_explicit(&stats->probe_steps, 0, memory_order_relaxed);
+        atomic_store_explicit(&stats->probe_max, 0, memory_order_relaxed);
+        for (unsigned b = 0; b < DS_STATS_HISTOGRAM_BUCKETS; b++) {
+            atomic_store_explicit(&stats->probe_histogram[b], 0, memory_order_relaxed);
+        }
+        atomic_store_explicit(&stats->resizes, 0, memory_order_relaxed);
+        atomic_store_explicit(&stats->resize_ns, 0, memory_order_relaxed);
+        atomic_store_explicit(&stats->sifts, 0, memory_order_relaxed);
+        atomic_store_explicit(&stats->sift_levels, 0, memory_order_relaxed);
+        atomic_store_explicit(&stats->sift_max, 0, memory_order_relaxed);
+        atomic_store_explicit(&stats->allocations, 0, memory_order_relaxed);
+        atomic_store_explicit(&stats->allocated_bytes, 0, memory_order_relaxed);
+    }
+#endif
+}
+
+/**
+ * Upper bound of a histogram bucket as text (internal helper)
+ * @param bucket: Bucket index
+ * @param buffer: Receives "1", "2", ... or "+Inf"
+ * @param size: Buffer size
+ * @return: buffer
+ */
+static inline const char *ds_stats_bucket_label(unsigned bucket, char *buffer, size_t size) {
+    if (bucket == DS_STATS_HISTOGRAM_BUCKETS - 1) snprintf(buffer, size, "+Inf");
+    else snprintf(buffer, size, "%llu", 1ULL << bucket);
+    return buffer;
+}
+
+/**
+ * Write all counters as one JSON object
+ * Histograms are cumulative, keyed by upper bound, as in the Prometheus output.
+ * @param out: Destination stream
+ */
+static inline void ds_stats_write_json(FILE *out) {
+    char label[16];
+    fprintf(out, "{\n  \"enabled\": %s,\n  \"containers\": {\n", ds_stats_enabled() ? "true" : "false");
+    for (int kind = 0; kind < DS_STATS_KIND_COUNT; kind++) {
+        DSStatsSnapshot s;
+        ds_stats_snapshot((DSStatsKind)kind, &s);
+        fprintf(out, "    \"%s\": {\"lookups\": %llu, \"probe_steps\": %llu, \"probe_max\": %llu, \"probe_histogram\": {",
+                DS_STATS_KIND_NAMES[kind], (unsigned long long)s.lookups, (unsigned long long)s.probe_steps,
+                (unsigned long long)s.probe_max);
+        uint64_t cumulative = 0;
+        for (unsigned b = 0; b < DS_STATS_HISTOGRAM_BUCKETS; b++) {
+            cumulative += s.probe_histogram[b];
+            fprintf(out, "%s\"%s\": %llu", b ? ", " : "", ds_stats_bucket_label(b, label, sizeof(label)),
+                    (unsigned long long)cumulative);
+        }
+        fprintf(out, "}, \"resizes\": %llu, \"resize_ns\": %llu, \"sifts\": %llu, \"sift_levels\": %llu, "
+                "\"sift_max\": %llu, \"allocations\": %llu, \"allocated_bytes\": %llu}%s\n",
+                (unsigned long long)s.resizes, (unsigned long long)s.resize_ns, (unsigned long long)s.sifts,
+                (unsigned long long)s.sift_levels, (unsigned long long)s.sift_max, (unsigned long long)s.allocations,
+                (unsigned long long)s.allocated_bytes, kind + 1 < DS_STATS_KIND_COUNT ? "," : "");
+    }
+    fprintf(out, "  }\n}\n");
+}
+
+/**
+ * Write one Prometheus counter or gauge family over all kinds (internal helper)
+ * @param out: Destination stream
+ * @param name: Metric name
+ * @param type: "counter" or "gauge"
+ * @param help: HELP text
+ * @param offset: offsetof(DSStatsSnapshot, field)
+ * @param scale: Divisor applied to the value (1 for plain counts)
+ */
+static inline void ds_stats_write_family(FILE *out, const char *name, const char *type, const char *help,
+                                         size_t offset, double scale) {
+    fprintf(out, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+    for (int kind = 0; kind < DS_STATS_KIND_COUNT; kind++) {
+        DSStatsSnapshot s;
+        ds_stats_snapshot((DSStatsKind)kind, &s);
+        uint64_t value;
+        memcpy(&value, (const unsigned char *)&s + offset, sizeof(value));
+        if (scale == 1) fprintf(out, "%s{container=\"%s\"} %llu\n", name, DS_STATS_KIND_NAMES[kind], (unsigned long long)value);
+        else fprintf(out, "%s{container=\"%s\"} %.9f\n", name, DS_STATS_KIND_NAMES[kind], (double)value / scale);
+    }
+}
+
+/**
+ * Write all counters in the Prometheus text exposition format
+ * @param out: Destination stream
+ */
+static inline void ds_stats_write_prometheus(FILE *out) {
+    char label[16];
+    fprintf(out, "# HELP ds_probe_length Entries or slots visited per lookup\n# TYPE ds_probe_length histogram\n");
+    for (int kind = 0; kind < DS_STATS_KIND_COUNT; kind++) {
+        DSStatsSnapshot s;
+        ds_stats_snapshot((DSStatsKind)kind, &s);
+        uint64_t cumulative = 0;
+        for (unsigned b = 0; b < DS_STATS_HISTOGRAM_BUCKETS; b++) {
+            cumulative += s.probe_histogram[b];
+            fprintf(out, "ds_probe_length_bucket{container=\"%s\",le=\"%s\"} %llu\n", DS_STATS_KIND_NAMES[kind],
+                    ds_stats_bucket_label(b, label, sizeof(label)), (unsigned long long)cumulative);
+        }
+        fprintf(out, "ds_probe_length_sum{container=\"%s\"} %llu\n", DS_STATS_KIND_NAMES[kind],
+                (unsigned long long)s.probe_steps);
+        fprintf(out, "ds_probe_length_count{container=\"%s\"} %llu\n", DS_STATS_KIND_NAMES[kind],
+                (unsigned long long)s.lookups);
+    }
+    ds_stats_write_family(out, "ds_probe_length_max", "gauge", "Longest single lookup probe",
+                          offsetof(DSStatsSnapshot, probe_max), 1);
+    ds_stats_write_family(out, "ds_resizes_total", "counter", "Table or array resizes",
+                          offsetof(DSStatsSnapshot, resizes), 1);
+    ds_stats_write_family(out, "ds_resize_seconds_total", "counter", "Wall time spent resizing",
+                          offsetof(DSStatsSnapshot, resize_ns), 1e9);
+    ds_stats_write_family(out, "ds_sifts_total", "counter", "Heap sift-up and sift-down calls",
+                          offsetof(DSStatsSnapshot, sifts), 1);
+    ds_stats_write_family(out, "ds_sift_levels_total", "counter", "Heap levels moved by sifts",
+                          offsetof(DSStatsSnapshot, sift_levels), 1);
+    ds_stats_write_family(out, "ds_sift_levels_max", "gauge", "Deepest single sift",
+                          offsetof(DSStatsSnapshot, sift_max), 1);
+    ds_stats_write_family(out, "ds_allocations_total", "counter", "Allocations made by the container",
+                          offsetof(DSStatsSnapshot, allocations), 1);
+    ds_stats_write_family(out, "ds_allocated_bytes_total", "counter", "Bytes requested by those allocations",
+                          offsetof(DSStatsSnapshot, allocated_bytes), 1);
+}
+
+#endif // DS_STATS_H
@@ -0,0 +1,499 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "basketball_system.h"
+
+// Test results structure
+typedef struct {
+    int passed;
+    int failed;
+    const char* current_test;
+} TestResults;
+
+static TestResults results = {0, 0, ""};
+
+// Helper macros
+#define TEST_START(name) \
+    do { \
+        results.current_test = name; \
+        printf("\n=== TESTING %s ===\n", name); \
+    } while(0)
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("✓ %s\n", message); \
+            results.passed++; \
+        } else { \
+            printf("✗ %s\n", message); \
+            results.failed++; \
+        } \
+    } while(0)
+
+#define TEST_SUMMARY() \
+    do { \
+        printf("\n" \
+               "==========================================\n" \
+               "           TEST SUMMARY\n" \
+               "==========================================\n" \
+               "Total Tests: %d\n" \
+               "Passed: %d\n" \
+               "Failed: %d\n" \
+               "Success Rate: %.1f%%\n" \
+               "==========================================\n", \
+               results.passed + results.failed, \
+               results.passed, \
+               results.failed, \
+               (results.passed + results.failed > 0) ? \
+                   (100.0 * results.passed / (results.passed + results.failed)) : 0.0); \
+    } while(0)
+
+// Create an empty temporary file and store its name in path
+static void make_temp_path(char *path, size_t size) {
+    snprintf(path, size, "/tmp/system_test_XXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "make_temp_path: mkstemp failed\n");
+        exit(EXIT_FAILURE);
+    }
+    close(fd);
+}
+
+// Read a whole file into a malloc'd buffer
+static unsigned char *read_file(const char *path, size_t *size) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char *data = malloc(length > 0 ? (size_t)length : 1);
+    if (!data) {
+        fprintf(stderr, "read_file: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    *size = fread(data, 1, (size_t)length, file);
+    fclose(file);
+    return data;
+}
+
+static void write_file(const char *path, const void *data, size_t size) {
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "write_file: cannot open %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+    fwrite(data, 1, size, file);
+    fclose(file);
+}
+
+// Small league with removals and trades so ids, groups and heaps are not in insertion order
+static void build_sample_system(BasketballSystem *system) {
+    static const char *nationalities[] = {"USA", "France", "Spain", "Serbia"};
+    static const char *positions[] = {"PG", "SG", "SF", "PF", "C"};
+
+    basketball_system_init(system);
+    add_league(system, "Test League", "USA", 2024);
+    add_league(system, "Euro League", "Spain", 2024);
+    for (int t = 0; t < 6; t++) {
+        char name[32];
+        snprintf(name, sizeof(name), "Team %d", t);
+        add_team(system, name, "City", 1 + t % 2);
+    }
+    for (int i = 0; i < 300; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "Player %03d", i);
+        add_player(system, name, nationalities[i % 4], positions[i % 5], 19 + (i * 7) % 20,
+                   1.80f + (float)((i * 13) % 40) / 100.0f, 80.0f + (float)(i % 30),
+                   i % 99, (float)((i * 37) % 1000) / 10.0f, 1 + i % 6);
+    }
+    // Names over many first and second bytes so the name trie uses every node kind (skill ratings
+    // end in .05/.25/.55/.75, so no rank ties with the players above)
+    for (int c = 33; c < 127; c++) {
+        char name[4] = {(char)c, 'x', '\0', '\0'};
+        if (c == 'Q' || c == 'R') name[1] = '\0';
+        add_player(system, name, "USA", "PG", 20 + c % 15, 1.90f, 90.0f, c % 99, (float)c / 2.0f + 0.05f, 1 + c % 6);
+    }
+    for (int c = 0; c < 20; c++) {
+        char name[4] = {'Q', (char)('a' + c), c < 8 ? 'R' : '\0', '\0'};
+        add_player(system, name, "Spain", "C", 30, 2.10f, 110.0f, c, (float)(50 + c) + 0.25f, 2);
+        name[0] = 'R';
+        if (c < 8) add_player(system, name, "Spain", "C", 28, 2.05f, 105.0f, c, (float)(40 + c) + 0.75f, 3);
+    }
+    for (int id = 5; id <= 300; id += 17) remove_player(system, id);
+    for (int id = 2; id <= 300; id += 23) {
+        Player *player = find_player_by_id(system, id);
+        if (player) request_trade(system, player->team_id, 1 + (player->team_id % 6), id);
+    }
+    process_all_trades(system);
+}
+
+static bool same_player(const Player *a, const Player *b) {
+    return a && b && a->player_id == b->player_id && strcmp(a->name, b->name) == 0 &&
+           strcmp(a->nationality, b->nationality) == 0 && strcmp(a->position, b->position) == 0 &&
+           a->age == b->age && a->height == b->height && a->skill_rating == b->skill_rating &&
+           a->team_id == b->team_id;
+}
+
+// True if both lists hold the same player ids in the same order
+static bool same_id_list(const DynArray *a, const DynArray *b) {
+    if (!a || !b || a->size != b->size) return false;
+    for (size_t i = 0; i < a->size; i++) {
+        if (((Player*)a->data[i])->player_id != ((Player*)b->data[i])->player_id) return false;
+    }
+    return true;
+}
+
+// True if prefix search and top-k completion agree on both systems
+static bool same_prefix_results(BasketballSystem *a, BasketballSystem *b, const char *prefix) {
+    Player *left[64];
+    Player *right[64];
+    size_t count = find_players_by_name_prefix(a, prefix, left, 64);
+    if (count != find_players_by_name_prefix(b, prefix, right, 64)) return false;
+    for (size_t i = 0; i < count; i++) {
+        if (left[i]->player_id != right[i]->player_id) return false;
+    }
+    count = get_top_players_by_name_prefix(a, prefix, 8, left);
+    if (count != get_top_players_by_name_prefix(b, prefix, 8, right)) return false;
+    for (size_t i = 0; i < count; i++) {
+        if (left[i]->player_id != right[i]->player_id) return false;
+    }
+    return true;
+}
+
+// Test snapshot save and mmap load
+void test_snapshot_round_trip() {
+    TEST_START("Snapshot Round Trip");
+
+    char path[64];
+    make_temp_path(path, sizeof(path));
+    BasketballSystem original;
+    build_sample_system(&original);
+    TEST_ASSERT(basketball_system_save(&original, path), "Save snapshot");
+
+    BasketballSystem loaded;
+    TEST_ASSERT(basketball_system_load_mmap(&loaded, path), "Load snapshot");
+    TEST_ASSERT(loaded.players.size == original.players.size, "Player count preserved");
+    TEST_ASSERT(loaded.teams.size == original.teams.size && loaded.leagues.size == original.leagues.size,
+                "Team and league counts preserved");
+
+    bool by_id = true;
+    bool by_name = true;
+    for (size_t i = 0; i < original.players.size; i++) {
+        Player *player = original.players.data[i];
+        by_id = by_id && same_player(find_player_by_id(&loaded, player->player_id), player);
+        by_name = by_name && same_player(find_player_by_name(&loaded, player->name), player);
+    }
+    TEST_ASSERT(by_id, "Id index matches original");
+    TEST_ASSERT(by_name, "Name index matches original");
+
+    static const char *prefixes[] = {"", "Player 1", "Player 29", "Q", "Qa", "R", "Rb", "~", "Z", "None"};
+    bool completion = true;
+    for (size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); i++) {
+        completion = completion && same_prefix_results(&loaded, &original, prefixes[i]);
+    }
+    TEST_ASSERT(completion, "Name prefix search and completion match original");
+
+    const BloomFilter *names = &loaded.name_filter;
+    TEST_ASSERT(names->block_count == original.name_filter.block_count &&
+                names->hashes == original.name_filter.hashes && names->count == original.name_filter.count &&
+                memcmp(names->blocks, original.name_filter.blocks, bloom_filter_bytes(names)) == 0,
+                "Name filter bits restored");
+    TEST_ASSERT(find_player_by_name(&loaded, "Player 999") == NULL && find_player_by_name(&loaded, "Qz") == NULL,
+                "Unknown names not found");
+    TEST_ASSERT(find_player_by_id(&loaded, 5) == NULL, "Removed player stays removed");
+
+    TEST_ASSERT(same_player(get_most_skilled_player(&loaded), get_most_skilled_player(&original)) &&
+                same_player(get_youngest_player(&loaded), get_youngest_player(&original)) &&
+                same_player(get_oldest_player(&loaded), get_oldest_player(&original)) &&
+                same_player(get_tallest_player(&loaded), get_tallest_player(&original)),
+                "Heap tops match original");
+
+    bool ranks = true;
+    for (size_t rank = 0; rank < original.players.size; rank += 11) {
+        ranks = ranks && same_player(get_player_by_skill_rank(&loaded, rank), get_player_by_skill_rank(&original, rank));
+    }
+    TEST_ASSERT(ranks, "Skill ranks match original");
+
+    bool ranges = true;
+    for (int first = 1; first <= 300; first += 29) {
+        SkillStats expected = get_skill_stats_in_id_range(&original, first, first + 40);
+        SkillStats actual = get_skill_stats_in_id_range(&loaded, first, first + 40);
+        ranges = ranges && expected.count == actual.count && expected.sum == actual.sum && expected.max == actual.max;
+    }
+    TEST_ASSERT(ranges, "Skill id-range aggregates match original");
+
+    bool ages = true;
+    for (int age = 18; age <= 40; age += 3) {
+        ages = ages && count_players_in_age_range(&loaded, age, age + 4) ==
+                       count_players_in_age_range(&original, age, age + 4);
+    }
+    TEST_ASSERT(ages, "Age range counts match original");
+
+    bool rosters = true;
+    for (int team_id = 1; team_id <= 6; team_id++) {
+        rosters = rosters && same_id_list(get_team_roster(&loaded, team_id), get_team_roster(&original, team_id));
+    }
+    TEST_ASSERT(rosters, "Team rosters match original");
+    TEST_ASSERT(same_id_list(get_players_by_nationality(&loaded, "Serbia"),
+                             get_players_by_nationality(&original, "Serbia")) &&
+                same_id_list(get_players_by_position(&loaded, "C"), get_players_by_position(&original, "C")),
+                "Nationality and position groups match original");
+
+    Team *team = find_team_by_name(&loaded, "Team 3");
+    League *league = loaded.leagues.size == 2 ? loaded.leagues.data[1] : NULL;
+    TEST_ASSERT(team && team->team_id == 4 && find_team_by_id(&loaded, 4) == team, "Team indexes restored");
+    bool teams = find_team_by_name(&loaded, "Team 9") == NULL && find_team_by_id(&loaded, 0) == NULL;
+    for (size_t i = 0; i < loaded.teams.size; i++) {
+        Team *stored = loaded.teams.data[i];
+        teams = teams && find_team_by_name(&loaded, stored->name) == stored &&
+                find_team_by_id(&loaded, stored->team_id) == stored;
+    }
+    TEST_ASSERT(teams, "Every team found by name and id, absent ones not found");
+    TEST_ASSERT(league && league->league_id == 2 && strcmp(league->name, "Euro League") == 0 &&
+                league->teams.size == ((League*)original.leagues.data[1])->teams.size,
+                "Leagues restored");
+
+    PlayerFilter filter;
+    player_filter_init(&filter);
+    filter.min_age = 25;
+    filter.max_age = 30;
+    TEST_ASSERT(count_players_matching(&loaded, &filter) == count_players_matching(&original, &filter),
+                "Column filter matches original");
+
+    // The loaded system stays writable: ids continue where the original stopped
+    add_player(&loaded, "New Player", "Italy", "SF", 22, 2.0f, 95.0f, 7, 77.0f, 2);
+    add_player(&original, "New Player", "Italy", "SF", 22, 2.0f, 95.0f, 7, 77.0f, 2);
+    TEST_ASSERT(same_player(find_player_by_name(&loaded, "New Player"), find_player_by_name(&original, "New Player")),
+                "Insert after load uses the next id");
+    remove_player(&loaded, 2);
+    TEST_ASSERT(find_player_by_id(&loaded, 2) == NULL && loaded.players.size == original.players.size - 1,
+                "Remove after load");
+
+    basketball_system_free(&loaded);
+    basketball_system_free(&original);
+    remove(path);
+}
+
+// Test that damaged or foreign snapshots are rejected
+void test_snapshot_rejects_bad_files() {
+    TEST_START("Snapshot Rejection");
+
+    char path[64];
+    char damaged[64];
+    make_temp_path(path, sizeof(path));
+    make_temp_path(damaged, sizeof(damaged));
+    BasketballSystem original;
+    build_sample_system(&original);
+    basketball_system_save(&original, path);
+    basketball_system_free(&original);
+
+    size_t size = 0;
+    unsigned char *data = read_file(path, &size);
+    TEST_ASSERT(data && size > 64, "Read snapshot bytes");
+
+    BasketballSystem loaded;
+    unsigned char *copy = malloc(size);
+    if (!copy) {
+        fprintf(stderr, "test_snapshot_rejects_bad_files: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // The version field follows the 8-byte magic
+    memcpy(copy, data, size);
+    uint32_t version = BASKETBALL_SNAPSHOT_VERSION + 1;
+    memcpy(copy + 8, &version, sizeof(version));
+    write_file(damaged, copy, size);
+    TEST_ASSERT(!basketball_system_load_mmap(&loaded, damaged) && loaded.players.size == 0,
+                "Reject version mismatch");
+    basketball_system_free(&loaded);
+
+    memcpy(copy, data, size);
+    copy[0] ^= 0xFF;
+    write_file(damaged, copy, size);
+    TEST_ASSERT(!basketball_system_load_mmap(&loaded, damaged) && loaded.players.size == 0, "Reject bad magic");
+    basketball_system_free(&loaded);
+
+    write_file(damaged, data, size / 2);
+    TEST_ASSERT(!basketball_system_load_mmap(&loaded, damaged) && loaded.players.size == 0,
+                "Reject file truncated mid-section");
+    basketball_system_free(&loaded);
+
+    write_file(damaged, data, 16);
+    TEST_ASSERT(!basketball_system_load_mmap(&loaded, damaged) && loaded.players.size == 0,
+                "Reject file shorter than the header");
+    basketball_system_free(&loaded);
+
+    remove(damaged);
+    TEST_ASSERT(!basketball_system_load_mmap(&loaded, damaged), "Reject missing file");
+    basketball_system_free(&loaded);
+
+    free(copy);
+    free(data);
+    remove(path);
+}
+
+// Ingest a feed into a fresh system with the given pipeline settings
+static bool ingest_text(BasketballSystem *system, const char *text, IngestFormat format, size_t readers,
+                        size_t chunk_bytes, size_t queue_depth, IngestReport *report) {
+    char path[64];
+    make_temp_path(path, sizeof(path));
+    write_file(path, text, strlen(text));
+    basketball_system_init(system);
+    IngestOptions options;
+    ingest_options_init(&options);
+    options.format = format;
+    options.readers = readers;
+    options.chunk_bytes = chunk_bytes;
+    options.queue_depth = queue_depth;
+    bool ok = basketball_system_ingest(system, path, &options, report);
+    remove(path);
+    return ok;
+}
+
+// Test CSV parsing: header, quoting, CRLF, blank and malformed lines
+void test_ingest_csv() {
+    TEST_START("Ingest CSV");
+
+    const char *feed =
+        "name,nationality,position,age,height,weight,jersey_number,skill_rating,team_id\r\n"
+        "\"Smith, John\",USA,PG,25,1.95,90,3,80.5,1\r\n"
+        "\"Shaq \"\"Diesel\"\"\" , USA , C , 30 , 2.16 , 147 , 34 , 95 , 2\n"
+        "\n"
+        "   \r\n"
+        "Bad Age,USA,PG,2x,2.0,100,1,80,1\n"
+        "Short Row,USA,PG\n"
+        "\"Open Quote,USA,PG,25,2.0,100,1,80,1\n"
+        "Tail,Spain,SF,22,2.01,100,7,70,3";
+    BasketballSystem system;
+    IngestReport report;
+    TEST_ASSERT(ingest_text(&system, feed, INGEST_FORMAT_CSV, 2, 0, 0, &report), "Ingest CSV feed");
+    TEST_ASSERT(report.records == 3 && report.rejected == 3, "Report counts records and rejected lines");
+    TEST_ASSERT(report.bytes == strlen(feed) && system.players.size == 3, "Report bytes and committed players");
+
+    Player *smith = find_player_by_id(&system, 1);
+    Player *shaq = find_player_by_id(&system, 2);
+    Player *tail = find_player_by_id(&system, 3);
+    TEST_ASSERT(smith && strcmp(smith->name, "Smith, John") == 0 && smith->team_id == 1,
+                "Quoted comma and CRLF line end");
+    TEST_ASSERT(shaq && strcmp(shaq->name, "Shaq \"Diesel\"") == 0 && strcmp(shaq->position, "C") == 0 &&
+                shaq->age == 30 && shaq->skill_rating == 95.0f,
+                "Doubled quote and padded fields");
+    TEST_ASSERT(tail && strcmp(tail->name, "Tail") == 0 && tail->team_id == 3, "Last line without newline");
+    TEST_ASSERT(find_player_by_name(&system, "name") == NULL, "Header line skipped");
+    TEST_ASSERT(find_player_by_name(&system, "Smith, John") == smith && get_team_roster(&system, 2)->size == 1 &&
+                count_players_in_age_range(&system, 20, 26) == 2,
+                "Ingested players are indexed");
+
+    basketball_system_free(&system);
+}
+
+// Test JSON lines parsing: escapes, key order, unknown keys, missing fields
+void test_ingest_json_lines() {
+    TEST_START("Ingest JSON Lines");
+
+    const char *feed =
+        "{\"name\":\"Caf\\u00e9 \\\"Q\\\" \\\\\\/\",\"nationality\":\"France\",\"position\":\"C\",\"age\":22,"
+        "\"height\":2.1,\"weight\":100,\"jersey_number\":3,\"skill_rating\":81.5,\"team_id\":2,\"extra\":null}\n"
+        "  { \"team_id\" : 4 , \"skill_rating\":1,\"jersey_number\":2,\"weight\":3,\"height\":4,\"age\":5,"
+        "\"league\":\"X\",\"position\":\"PG\",\"nationality\":\"USA\",\"name\":\"Tab\\tName\" }  \r\n"
+        "\n"
+        "{\"name\":\"Missing\",\"nationality\":\"USA\"}\n"
+        "{\"name\":\"Nested\",\"x\":{\"a\":1}}\n"
+        "{\"name\":\"Trailing\",\"nationality\":\"USA\",\"position\":\"C\",\"age\":22,\"height\":2.1,"
+        "\"weight\":100,\"jersey_number\":3,\"skill_rating\":81.5,\"team_id\":2} x\n"
+        "{\"name\":\"Unterminated\n";
+    BasketballSystem system;
+    IngestReport report;
+    TEST_ASSERT(ingest_text(&system, feed, INGEST_FORMAT_JSON_LINES, 2, 16, 0, &report), "Ingest JSON feed");
+    TEST_ASSERT(report.records == 2 && report.rejected == 4, "Report counts records and rejected lines");
+
+    Player *first = find_player_by_id(&system, 1);
+    Player *second = find_player_by_id(&system, 2);
+    TEST_ASSERT(first && strcmp(first->name, "Caf\xC3\xA9 \"Q\" \\/") == 0, "Unicode and character escapes");
+    TEST_ASSERT(first && first->team_id == 2 && first->skill_rating == 81.5f && first->height == 2.1f,
+                "Numbers parsed, unknown null key ignored");
+    TEST_ASSERT(second && strcmp(second->name, "Tab\tName") == 0 && second->team_id == 4 && second->age == 5 &&
+                strcmp(second->nationality, "USA") == 0,
+                "Keys in any order, unknown string key ignored");
+    TEST_ASSERT(find_player_by_name(&system, "Missing") == NULL && find_player_by_name(&system, "Trailing") == NULL,
+                "Incomplete and trailing-garbage objects rejected");
+
+    basketball_system_free(&system);
+}
+
+// Test that many small chunks across readers commit in file order under backpressure
+void test_ingest_chunking() {
+    TEST_START("Ingest Chunking");
+
+    enum { LINES = 600 };
+    size_t capacity = LINES * 64;
+    char *feed = malloc(capacity);
+    if (!feed) {
+        fprintf(stderr, "test_ingest_chunking: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t length = 0;
+    size_t expected = 0;
+    size_t malformed = 0;
+    for (int i = 0; i < LINES; i++) {
+        if (i % 7 == 3) {
+            length += (size_t)snprintf(feed + length, capacity - length, "Broken %d,USA\n", i);
+            malformed++;
+        } else {
+            length += (size_t)snprintf(feed + length, capacity - length, "P%04d,USA,SF,%d,2.0,95,%d,%d.5,%d\n",
+                                       i, 20 + i % 15, i % 99, i % 99, 1 + i % 5);
+            expected++;
+        }
+    }
+
+    size_t readers[] = {1, 4, 4};
+    size_t depths[] = {0, 0, 1};
+    for (int run = 0; run < 3; run++) {
+        BasketballSystem system;
+        IngestReport report;
+        char message[96];
+        bool ok = ingest_text(&system, feed, INGEST_FORMAT_CSV, readers[run], 64, depths[run], &report);
+        bool ordered = true;
+        size_t id = 1;
+        for (int i = 0; i < LINES; i++) {
+            if (i % 7 == 3) continue;
+            char name[16];
+            snprintf(name, sizeof(name), "P%04d", i);
+            Player *player = find_player_by_id(&system, (int)id++);
+            ordered = ordered && player && strcmp(player->name, name) == 0;
+        }
+        snprintf(message, sizeof(message), "%zu readers, queue depth %zu: counts, %zu chunks, file order",
+                 readers[run], depths[run], report.parse.batches);
+        TEST_ASSERT(ok && report.records == expected && report.rejected == malformed && report.parse.batches > 100 &&
+                    report.commit.batches == report.parse.batches && ordered,
+                    message);
+        basketball_system_free(&system);
+    }
+    free(feed);
+
+    BasketballSystem system;
+    IngestReport report;
+    TEST_ASSERT(ingest_text(&system, "", INGEST_FORMAT_CSV, 2, 0, 0, &report) && report.records == 0,
+                "Empty feed");
+    TEST_ASSERT(!basketball_system_ingest(&system, "/tmp/system_test_missing_feed", NULL, &report), "Missing feed");
+    basketball_system_free(&system);
+}
+
+int main() {
+    printf("======================================================================\n");
+    printf("           BASKETBALL SYSTEM TEST SUITE\n");
+    printf("======================================================================\n");
+
+    test_snapshot_round_trip();
+    test_snapshot_rejects_bad_files();
+    test_ingest_csv();
+    test_ingest_json_lines();
+    test_ingest_chunking();
+
+    // Print final summary
+    TEST_SUMMARY();
+
+    return results.failed == 0 ? 0 : 1;
+}
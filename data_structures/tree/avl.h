@@ -2,6 +2,8 @@
 #define AVL_H
 
 #include "tree.h"
+#include <stdint.h>
+#include <string.h>
 
 // AVL Tree uses the basic tree structure but with TreeNode renamed to AVLNode for clarity
 typedef TreeNode AVLNode;
@@ -49,22 +51,22 @@ static inline AVLNode *avl_rotate_left(AVLNode *x)
     return y; // New root
 }
 
-// Insert a node with AVL balancing
-static inline AVLNode *avl_insert_node(AVLNode *node, int data)
+// Insert a node with AVL balancing, allocating from allocator
+static inline AVLNode *avl_insert_node_with(const Allocator *allocator, AVLNode *node, int data)
 {
     // 1. Perform normal BST insertion
     if (node == NULL)
     {
-        return tree_create_node(data);
+        return tree_create_node_with(allocator, data);
     }
 
     if (data < node->data)
     {
-        node->left = avl_insert_node(node->left, data);
+        node->left = avl_insert_node_with(allocator, node->left, data);
     }
     else if (data > node->data)
     {
-        node->right = avl_insert_node(node->right, data);
+        node->right = avl_insert_node_with(allocator, node->right, data);
     }
     else
     {
@@ -110,8 +112,14 @@ static inline AVLNode *avl_insert_node(AVLNode *node, int data)
     return node;
 }
 
-// Delete a node with AVL balancing
-static inline AVLNode *avl_delete_node(AVLNode *root, int data)
+// Insert a node with AVL balancing
+static inline AVLNode *avl_insert_node(AVLNode *node, int data)
+{
+    return avl_insert_node_with(&HEAP_ALLOCATOR, node, data);
+}
+
+// Delete a node with AVL balancing, returning it to allocator
+static inline AVLNode *avl_delete_node_with(const Allocator *allocator, AVLNode *root, int data)
 {
     // 1. Perform standard BST delete
     if (root == NULL)
@@ -121,11 +129,11 @@ static inline AVLNode *avl_delete_node(AVLNode *root, int data)
 
     if (data < root->data)
     {
-        root->left = avl_delete_node(root->left, data);
+        root->left = avl_delete_node_with(allocator, root->left, data);
     }
     else if (data > root->data)
     {
-        root->right = avl_delete_node(root->right, data);
+        root->right = avl_delete_node_with(allocator, root->right, data);
     }
     else
     {
@@ -145,7 +153,7 @@ static inline AVLNode *avl_delete_node(AVLNode *root, int data)
                 // One child case
                 *root = *temp; // Copy the contents of the non-empty child
             }
-            free(temp);
+            allocator_free(allocator, temp, sizeof(AVLNode));
         }
         else
         {
@@ -156,7 +164,7 @@ static inline AVLNode *avl_delete_node(AVLNode *root, int data)
             root->data = temp->data;
 
             // Delete the inorder successor
-            root->right = avl_delete_node(root->right, temp->data);
+            root->right = avl_delete_node_with(allocator, root->right, temp->data);
         }
     }
 
@@ -203,6 +211,12 @@ static inline AVLNode *avl_delete_node(AVLNode *root, int data)
     return root;
 }
 
+// Delete a node with AVL balancing
+static inline AVLNode *avl_delete_node(AVLNode *root, int data)
+{
+    return avl_delete_node_with(&HEAP_ALLOCATOR, root, data);
+}
+
 // ==================== AVL TREE FUNCTIONS ====================
 
 // Initialize an empty AVL tree
@@ -211,11 +225,17 @@ static inline void avl_init(AVLTree *tree)
     tree_init(tree);
 }
 
+// Initialize an empty AVL tree drawing nodes from a custom allocator
+static inline void avl_init_with_allocator(AVLTree *tree, const Allocator *allocator)
+{
+    tree_init_with_allocator(tree, allocator);
+}
+
 // Insert a value into the AVL tree
 static inline void avl_insert(AVLTree *tree, int data)
 {
     AVLNode *old_root = tree->root;
-    tree->root = avl_insert_node(tree->root, data);
+    tree->root = avl_insert_node_with(tree->allocator, tree->root, data);
 
     // Only increment size if a new node was actually added
     if (tree->root != old_root || tree->size == 0)
@@ -233,7 +253,7 @@ static inline bool avl_delete(AVLTree *tree, int data)
         return false; // Value not found
     }
 
-    tree->root = avl_delete_node(tree->root, data);
+    tree->root = avl_delete_node_with(tree->allocator, tree->root, data);
     tree->size--;
     return true;
 }
@@ -362,4 +382,630 @@ static inline bool avl_is_valid(AVLTree *tree)
     return avl_is_valid_helper(tree->root, NULL, NULL);
 }
 
-#endif // AVL_H
\ No newline at end of file
+// ==================== ORDER-STATISTIC AVL (GENERIC KEYS) ====================
+//
+// AVLOrderTree is an augmented AVL tree keyed by caller-owned keys with a
+// qsort-style comparator. Every node caches its subtree size, which gives
+// rank/select in O(log n) and range reporting in O(log n + k). Duplicate keys
+// are allowed: equal keys are ordered by value pointer, so each (key, value)
+// pair is unique and can be removed in O(log n). Keys are borrowed (typically a
+// field inside the value) and must not change while the pair is in the tree.
+
+// Key comparator: <0, 0, >0 like qsort
+typedef int (*AVLCompareFn)(const void *a, const void *b);
+
+// Range visitor: return false to stop early
+typedef bool (*AVLVisitFn)(const void *key, void *value, void *ctx);
+
+// Order-statistic node
+typedef struct AVLOrderNode
+{
+    const void *key;            // Borrowed key
+    void *value;                // Associated value
+    int height;                 // Leaf = 1
+    size_t count;               // Nodes in this subtree
+    struct AVLOrderNode *left;  // Smaller pairs
+    struct AVLOrderNode *right; // Larger pairs
+} AVLOrderNode;
+
+// Order-statistic tree
+typedef struct AVLOrderTree
+{
+    AVLOrderNode *root;         // Root node
+    AVLCompareFn compare;       // Key order
+    const Allocator *allocator; // Source of nodes
+} AVLOrderTree;
+
+// Compare int keys
+static inline int avl_compare_int(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Compare float keys
+static inline int avl_compare_float(const void *a, const void *b)
+{
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+// Compare string keys
+static inline int avl_compare_string(const void *a, const void *b)
+{
+    return strcmp((const char *)a, (const char *)b);
+}
+
+// Height of order node (0 for NULL)
+static inline int avl_order_height(const AVLOrderNode *node)
+{
+    return node ? node->height : 0;
+}
+
+// Subtree size of order node (0 for NULL)
+static inline size_t avl_order_count(const AVLOrderNode *node)
+{
+    return node ? node->count : 0;
+}
+
+// Recompute cached height and size from children
+static inline void avl_order_update(AVLOrderNode *node)
+{
+    node->height = 1 + tree_max(avl_order_height(node->left), avl_order_height(node->right));
+    node->count = 1 + avl_order_count(node->left) + avl_order_count(node->right);
+}
+
+// Compare (key, value) pair against node, ties broken by value address
+static inline int avl_order_compare_pair(const AVLOrderTree *tree, const void *key, const void *value,
+                                         const AVLOrderNode *node)
+{
+    int cmp = tree->compare(key, node->key);
+    if (cmp != 0)
+        return cmp;
+    uintptr_t a = (uintptr_t)value, b = (uintptr_t)node->value;
+    return (a > b) - (a < b);
+}
+
+// Right rotate, keeping sizes
+static inline AVLOrderNode *avl_order_rotate_right(AVLOrderNode *y)
+{
+    AVLOrderNode *x = y->left;
+    y->left = x->right;
+    x->right = y;
+    avl_order_update(y);
+    avl_order_update(x);
+    return x;
+}
+
+// Left rotate, keeping sizes
+static inline AVLOrderNode *avl_order_rotate_left(AVLOrderNode *x)
+{
+    AVLOrderNode *y = x->right;
+    x->right = y->left;
+    y->left = x;
+    avl_order_update(x);
+    avl_order_update(y);
+    return y;
+}
+
+// Restore AVL balance at node after a child changed
+static inline AVLOrderNode *avl_order_rebalance(AVLOrderNode *node)
+{
+    avl_order_update(node);
+    int balance = avl_order_height(node->left) - avl_order_height(node->right);
+
+    if (balance > 1)
+    {
+        if (avl_order_height(node->left->left) < avl_order_height(node->left->right))
+        {
+            node->left = avl_order_rotate_left(node->left);
+        }
+        return avl_order_rotate_right(node);
+    }
+    if (balance < -1)
+    {
+        if (avl_order_height(node->right->right) < avl_order_height(node->right->left))
+        {
+            node->right = avl_order_rotate_right(node->right);
+        }
+        return avl_order_rotate_left(node);
+    }
+    return node;
+}
+
+// Insert pair below node; *inserted reports whether a node was added
+static inline AVLOrderNode *avl_order_insert_node(AVLOrderTree *tree, AVLOrderNode *node,
+                                                  const void *key, void *value, bool *inserted)
+{
+    if (node == NULL)
+    {
+        AVLOrderNode *fresh = (AVLOrderNode *)allocator_alloc(tree->allocator, sizeof(AVLOrderNode));
+        if (!fresh)
+        {
+            fprintf(stderr, "avl_order_insert: allocation failed\n");
+            exit(EXIT_FAILURE);
+        }
+        fresh->key = key;
+        fresh->value = value;
+        fresh->height = 1;
+        fresh->count = 1;
+        fresh->left = NULL;
+        fresh->right = NULL;
+        *inserted = true;
+        return fresh;
+    }
+
+    int cmp = avl_order_compare_pair(tree, key, value, node);
+    if (cmp < 0)
+    {
+        node->left = avl_order_insert_node(tree, node->left, key, value, inserted);
+    }
+    else if (cmp > 0)
+    {
+        node->right = avl_order_insert_node(tree, node->right, key, value, inserted);
+    }
+    else
+    {
+        return node; // Pair already present
+    }
+    return avl_order_rebalance(node);
+}
+
+// Detach minimum node of subtree into *min, returning the new subtree root
+static inline AVLOrderNode *avl_order_detach_min(AVLOrderNode *node, AVLOrderNode **min)
+{
+    if (node->left == NULL)
+    {
+        *min = node;
+        return node->right;
+    }
+    node->left = avl_order_detach_min(node->left, min);
+    return avl_order_rebalance(node);
+}
+
+// Remove pair below node; *removed reports whether a node was freed
+static inline AVLOrderNode *avl_order_remove_node(AVLOrderTree *tree, AVLOrderNode *node,
+                                                  const void *key, const void *value, bool *removed)
+{
+    if (node == NULL)
+        return NULL;
+
+    int cmp = avl_order_compare_pair(tree, key, value, node);
+    if (cmp < 0)
+    {
+        node->left = avl_order_remove_node(tree, node->left, key, value, removed);
+    }
+    else if (cmp > 0)
+    {
+        node->right = avl_order_remove_node(tree, node->right, key, value, removed);
+    }
+    else
+    {
+        AVLOrderNode *replacement;
+        if (node->left == NULL || node->right == NULL)
+        {
+            replacement = node->left ? node->left : node->right;
+        }
+        else
+        {
+            // Successor takes the removed node's place
+            AVLOrderNode *right = avl_order_detach_min(node->right, &replacement);
+            replacement->left = node->left;
+            replacement->right = right;
+        }
+        allocator_free(tree->allocator, node, sizeof(AVLOrderNode));
+        *removed = true;
+        if (replacement == NULL)
+            return NULL;
+        node = replacement;
+    }
+    return avl_order_rebalance(node);
+}
+
+/**
+ * Initialize empty order-statistic tree
+ * @param tree: Tree to initialize
+ * @param compare: Key comparator
+ */
+static inline void avl_order_init(AVLOrderTree *tree, AVLCompareFn compare)
+{
+    tree->root = NULL;
+    tree->compare = compare;
+    tree->allocator = &HEAP_ALLOCATOR;
+}
+
+/**
+ * Initialize empty order-statistic tree drawing nodes from a custom allocator
+ * @param tree: Tree to initialize
+ * @param compare: Key comparator
+ * @param allocator: Source of AVLOrderNode nodes (e.g. a Pool of sizeof(AVLOrderNode))
+ */
+static inline void avl_order_init_with_allocator(AVLOrderTree *tree, AVLCompareFn compare,
+                                                 const Allocator *allocator)
+{
+    avl_order_init(tree, compare);
+    tree->allocator = allocator;
+}
+
+/**
+ * Insert (key, value) pair
+ * @param tree: Target tree
+ * @param key: Borrowed key, must stay valid and unchanged while stored
+ * @param value: Associated value
+ * @return: true if added, false if the exact pair was already present
+ */
+static inline bool avl_order_insert(AVLOrderTree *tree, const void *key, void *value)
+{
+    bool inserted = false;
+    tree->root = avl_order_insert_node(tree, tree->root, key, value, &inserted);
+    return inserted;
+}
+
+/**
+ * Remove (key, value) pair
+ * @param tree: Target tree
+ * @param key: Key the pair was inserted with (same current value)
+ * @param value: Associated value
+ * @return: true if the pair was found and removed
+ */
+static inline bool avl_order_remove(AVLOrderTree *tree, const void *key, const void *value)
+{
+    bool removed = false;
+    tree->root = avl_order_remove_node(tree, tree->root, key, value, &removed);
+    return removed;
+}
+
+// Append nodes below node to out in order, returning the new count (internal helper)
+static inline size_t avl_order_flatten(AVLOrderNode *node, AVLOrderNode **out, size_t count)
+{
+    while (node)
+    {
+        count = avl_order_flatten(node->left, out, count);
+        out[count++] = node;
+        node = node->right;
+    }
+    return count;
+}
+
+// Link sorted nodes[lo, hi) into a perfectly balanced subtree (internal helper)
+static inline AVLOrderNode *avl_order_build_balanced(AVLOrderNode **nodes, size_t lo, size_t hi)
+{
+    if (lo >= hi)
+        return NULL;
+    size_t mid = lo + (hi - lo) / 2;
+    AVLOrderNode *node = nodes[mid];
+    node->left = avl_order_build_balanced(nodes, lo, mid);
+    node->right = avl_order_build_balanced(nodes, mid + 1, hi);
+    avl_order_update(node);
+    return node;
+}
+
+// Bottom-up merge sort of nodes by (key, value); sorted input costs O(n) (internal helper)
+static inline void avl_order_sort_nodes(const AVLOrderTree *tree, AVLOrderNode **nodes,
+                                        AVLOrderNode **scratch, size_t count)
+{
+    AVLOrderNode **src = nodes, **dst = scratch;
+    for (size_t width = 1; width < count; width *= 2)
+    {
+        for (size_t lo = 0; lo < count; lo += 2 * width)
+        {
+            size_t mid = lo + width < count ? lo + width : count;
+            size_t hi = mid + width < count ? mid + width : count;
+            size_t i = lo, j = mid, k = lo;
+            // Runs already in order are copied without merging
+            if (mid < hi && avl_order_compare_pair(tree, src[mid - 1]->key, src[mid - 1]->value, src[mid]) <= 0)
+            {
+                memcpy(dst + lo, src + lo, (hi - lo) * sizeof(AVLOrderNode *));
+                continue;
+            }
+            while (i < mid && j < hi)
+            {
+                dst[k++] = avl_order_compare_pair(tree, src[j]->key, src[j]->value, src[i]) < 0 ? src[j++]
+                                                                                              : src[i++];
+            }
+            while (i < mid)
+                dst[k++] = src[i++];
+            while (j < hi)
+                dst[k++] = src[j++];
+        }
+        AVLOrderNode **swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != nodes)
+        memcpy(nodes, src, count * sizeof(AVLOrderNode *));
+}
+
+/**
+ * Insert many (key, value) pairs at once
+ * Small batches are inserted one by one; larger ones are sorted, merged with
+ * the existing in-order sequence and relinked into a balanced tree in
+ * O(n + k log k), or O(n + k) when the batch is already sorted.
+ * @param tree: Target tree
+ * @param keys: Borrowed keys, must stay valid and unchanged while stored
+ * @param values: Associated values
+ * @param count: Number of pairs
+ * @return: Number of pairs added (exact duplicates are skipped)
+ */
+static inline size_t avl_order_insert_many(AVLOrderTree *tree, const void *const *keys, void *const *values,
+                                           size_t count)
+{
+    size_t existing = avl_order_count(tree->root);
+    size_t total = existing + count;
+    size_t levels = 1;
+    for (size_t n = total; n >>= 1;)
+        levels++;
+    if (count * levels < existing)
+    {
+        size_t inserted = 0;
+        for (size_t i = 0; i < count; i++)
+            inserted += avl_order_insert(tree, keys[i], values[i]);
+        return inserted;
+    }
+
+    AVLOrderNode **nodes = (AVLOrderNode **)malloc((total + 1) * sizeof(AVLOrderNode *));
+    AVLOrderNode **scratch = (AVLOrderNode **)malloc((total + 1) * sizeof(AVLOrderNode *));
+    if (!nodes || !scratch)
+    {
+        fprintf(stderr, "avl_order_insert_many: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Existing pairs first (already sorted), then the new run
+    avl_order_flatten(tree->root, nodes, 0);
+    AVLOrderNode **added = nodes + existing;
+    for (size_t i = 0; i < count; i++)
+    {
+        added[i] = (AVLOrderNode *)allocator_alloc(tree->allocator, sizeof(AVLOrderNode));
+        if (!added[i])
+        {
+            fprintf(stderr, "avl_order_insert_many: allocation failed\n");
+            exit(EXIT_FAILURE);
+        }
+        added[i]->key = keys[i];
+        added[i]->value = values[i];
+    }
+    avl_order_sort_nodes(tree, added, scratch, count);
+
+    // Merge both runs; on ties the existing node goes first so the new copy is dropped
+    size_t i = 0, j = existing, out = 0;
+    while (i < existing || j < total)
+    {
+        if (j == total ||
+            (i < existing && avl_order_compare_pair(tree, nodes[j]->key, nodes[j]->value, nodes[i]) >= 0))
+        {
+            scratch[out++] = nodes[i++];
+        }
+        else if (out > 0 &&
+                 avl_order_compare_pair(tree, nodes[j]->key, nodes[j]->value, scratch[out - 1]) == 0)
+        {
+            allocator_free(tree->allocator, nodes[j++], sizeof(AVLOrderNode));
+        }
+        else
+        {
+            scratch[out++] = nodes[j++];
+        }
+    }
+
+    tree->root = avl_order_build_balanced(scratch, 0, out);
+    free(nodes);
+    free(scratch);
+    return out - existing;
+}
+
+/**
+ * Get number of pairs
+ * @param tree: Target tree
+ * @return: Pair count
+ */
+static inline size_t avl_order_size(const AVLOrderTree *tree)
+{
+    return avl_order_count(tree->root);
+}
+
+/**
+ * Count pairs with key strictly less than key
+ * @param tree: Target tree
+ * @param key: Probe key
+ * @return: Rank of the first pair with this key (0-based)
+ */
+static inline size_t avl_rank(const AVLOrderTree *tree, const void *key)
+{
+    size_t rank = 0;
+    const AVLOrderNode *node = tree->root;
+    while (node)
+    {
+        if (tree->compare(node->key, key) < 0)
+        {
+            rank += avl_order_count(node->left) + 1;
+            node = node->right;
+        }
+        else
+        {
+            node = node->left;
+        }
+    }
+    return rank;
+}
+
+/**
+ * Count pairs with key less than or equal to key (internal helper)
+ * @param tree: Target tree
+ * @param key: Probe key
+ * @return: Number of pairs with key <= key
+ */
+static inline size_t avl_rank_upper(const AVLOrderTree *tree, const void *key)
+{
+    size_t rank = 0;
+    const AVLOrderNode *node = tree->root;
+    while (node)
+    {
+        if (tree->compare(node->key, key) <= 0)
+        {
+            rank += avl_order_count(node->left) + 1;
+            node = node->right;
+        }
+        else
+        {
+            node = node->left;
+        }
+    }
+    return rank;
+}
+
+/**
+ * Find the pair at sorted position index
+ * @param tree: Target tree
+ * @param index: 0-based position in ascending key order
+ * @return: Node holding the pair, NULL if index >= size
+ */
+static inline const AVLOrderNode *avl_select(const AVLOrderTree *tree, size_t index)
+{
+    const AVLOrderNode *node = tree->root;
+    while (node)
+    {
+        size_t left = avl_order_count(node->left);
+        if (index < left)
+        {
+            node = node->left;
+        }
+        else if (index == left)
+        {
+            return node;
+        }
+        else
+        {
+            index -= left + 1;
+            node = node->right;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Count pairs with lo <= key <= hi in O(log n)
+ * @param tree: Target tree
+ * @param lo: Lower bound (inclusive)
+ * @param hi: Upper bound (inclusive)
+ * @return: Number of pairs in range
+ */
+static inline size_t avl_count_range(const AVLOrderTree *tree, const void *lo, const void *hi)
+{
+    if (tree->compare(lo, hi) > 0)
+        return 0;
+    return avl_rank_upper(tree, hi) - avl_rank(tree, lo);
+}
+
+// Visit in-range pairs below node in order (internal helper)
+static inline bool avl_range_node(const AVLOrderTree *tree, const AVLOrderNode *node, const void *lo,
+                                  const void *hi, AVLVisitFn visit, void *ctx)
+{
+    while (node)
+    {
+        int above_lo = tree->compare(node->key, lo) >= 0;
+        int below_hi = tree->compare(node->key, hi) <= 0;
+        if (above_lo && !avl_range_node(tree, node->left, lo, hi, visit, ctx))
+            return false;
+        if (above_lo && below_hi && !visit(node->key, node->value, ctx))
+            return false;
+        if (!below_hi)
+            return true; // Right subtree is entirely above hi
+        node = node->right;
+    }
+    return true;
+}
+
+/**
+ * Visit every pair with lo <= key <= hi in ascending order, O(log n + k)
+ * @param tree: Target tree
+ * @param lo: Lower bound (inclusive)
+ * @param hi: Upper bound (inclusive)
+ * @param visit: Callback, return false to stop
+ * @param ctx: Passed through to visit
+ */
+static inline void avl_range(const AVLOrderTree *tree, const void *lo, const void *hi,
+                             AVLVisitFn visit, void *ctx)
+{
+    avl_range_node(tree, tree->root, lo, hi, visit, ctx);
+}
+
+// Visit pairs below node in descending order (internal helper)
+static inline bool avl_order_visit_desc_node(const AVLOrderNode *node, AVLVisitFn visit, void *ctx)
+{
+    while (node)
+    {
+        if (!avl_order_visit_desc_node(node->right, visit, ctx))
+            return false;
+        if (!visit(node->key, node->value, ctx))
+            return false;
+        node = node->left;
+    }
+    return true;
+}
+
+/**
+ * Visit pairs from largest key down until visit returns false (top-k walks)
+ * @param tree: Target tree
+ * @param visit: Callback, return false to stop
+ * @param ctx: Passed through to visit
+ */
+static inline void avl_order_visit_desc(const AVLOrderTree *tree, AVLVisitFn visit, void *ctx)
+{
+    avl_order_visit_desc_node(tree->root, visit, ctx);
+}
+
+// Free every node below node (internal helper)
+static inline void avl_order_free_nodes(const Allocator *allocator, AVLOrderNode *node)
+{
+    while (node)
+    {
+        AVLOrderNode *right = node->right;
+        avl_order_free_nodes(allocator, node->left);
+        allocator_free(allocator, node, sizeof(AVLOrderNode));
+        node = right;
+    }
+}
+
+/**
+ * Free all nodes (keys and values are not touched)
+ * @param tree: Tree to free
+ */
+static inline void avl_order_free(AVLOrderTree *tree)
+{
+    if (!allocator_frees_in_bulk(tree->allocator))
+    {
+        avl_order_free_nodes(tree->allocator, tree->root);
+    }
+    tree->root = NULL;
+}
+
+// Validate order, balance, heights and sizes below node (internal helper)
+static inline bool avl_order_is_valid_node(const AVLOrderTree *tree, const AVLOrderNode *node,
+                                           const AVLOrderNode *lo, const AVLOrderNode *hi)
+{
+    if (node == NULL)
+        return true;
+    if (lo && avl_order_compare_pair(tree, node->key, node->value, lo) <= 0)
+        return false;
+    if (hi && avl_order_compare_pair(tree, node->key, node->value, hi) >= 0)
+        return false;
+
+    int balance = avl_order_height(node->left) - avl_order_height(node->right);
+    if (balance < -1 || balance > 1)
+        return false;
+    if (node->height != 1 + tree_max(avl_order_height(node->left), avl_order_height(node->right)))
+        return false;
+    if (node->count != 1 + avl_order_count(node->left) + avl_order_count(node->right))
+        return false;
+
+    return avl_order_is_valid_node(tree, node->left, lo, node) &&
+           avl_order_is_valid_node(tree, node->right, node, hi);
+}
+
+// Check order-statistic tree invariants (for testing)
+static inline bool avl_order_is_valid(const AVLOrderTree *tree)
+{
+    return avl_order_is_valid_node(tree, tree->root, NULL, NULL);
+}
+
+#endif // AVL_H
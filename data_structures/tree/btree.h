@@ -0,0 +1,686 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include "../allocator/allocator.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * B+-TREE ORDERED MAP (MACRO-GENERATED)
+ *
+ * DEFINE_BTREE(Name, K, V, COMPARE) generates an ordered map `Name` from K to
+ * V. Keys and values are stored by value inside nodes of about
+ * BTREE_NODE_BYTES, so one prefetched node visit compares dozens of keys,
+ * where tree.h/avl.h pay a pointer chase and ~32 bytes per key.
+ * COMPARE(a, b) takes two K values and returns <0, 0, >0 like qsort; it is
+ * expanded inline.
+ * - Branches hold separator keys: keys[i] <= every key under children[i + 1]
+ * - Leaves hold the entries and are doubly linked for in-order range scans
+ * - Every node but the root is at least half full; all leaves share a depth
+ *
+ * The semantic API mirrors avl.h: Name_insert / Name_delete / Name_search,
+ * plus Name_get, lower-bound iterators, Name_range (inclusive, like avl_range)
+ * and Name_build, which bulk loads sorted input into packed leaves.
+ *
+ * Usage:
+ *   DEFINE_BTREE(IntMap, int, int, BTREE_CMP)
+ *   IntMap m; IntMap_init(&m); IntMap_insert(&m, 5, 50); IntMap_free(&m);
+ *
+ * Time Complexities (B = keys per node):
+ * - Search / Insert / Delete: O(log n), O(log_B n) node visits
+ * - Range scan: O(log n + k)
+ * - Bulk load from sorted input: O(n)
+ *
+ * Space Complexity: O(n) with nodes at least half full
+ */
+
+// Target node size in bytes: 16 cache lines, prefetched as a node is entered
+#ifndef BTREE_NODE_BYTES
+#define BTREE_NODE_BYTES 1024
+#endif
+
+// Upper bound on tree height (fan-out >= 3 on every level)
+#define BTREE_MAX_DEPTH 48
+
+// Entries per node: what fits in BTREE_NODE_BYTES after overhead, at least 4
+#define BTREE_CAPACITY(entry, overhead)                                                     \
+    ((BTREE_NODE_BYTES - sizeof(BTreeNode) - (overhead)) / (entry) < 4                      \
+         ? 4                                                                                \
+         : (BTREE_NODE_BYTES - sizeof(BTreeNode) - (overhead)) / (entry))
+
+// Ready-made comparator for arithmetic keys
+#define BTREE_CMP(a, b) (((a) > (b)) - ((a) < (b)))
+
+// Header shared by leaves and branches
+typedef struct BTreeNode {
+    uint16_t count; // Entries (leaf) or separator keys (branch)
+    uint16_t leaf;  // Non-zero for leaves
+} BTreeNode;
+
+/**
+ * Start loading every cache line of a node before searching it (internal helper)
+ * @param node: Node about to be searched
+ * @param size: Node size
+ */
+static inline void btree_prefetch(const void *node, size_t size) {
+#if defined(__GNUC__)
+    for (size_t offset = 64; offset < size; offset += 64) {
+        __builtin_prefetch((const char *)node + offset);
+    }
+#else
+    (void)node;
+    (void)size;
+#endif
+}
+
+/**
+ * Allocate a node or exit (internal helper)
+ * @param allocator: Source of nodes
+ * @param size: Node size
+ * @param caller: Name reported on failure
+ * @return: Uninitialized node
+ */
+static inline void *btree_node_alloc(const Allocator *allocator, size_t size, const char *caller) {
+    void *node = allocator_alloc(allocator, size);
+    if (!node) {
+        fprintf(stderr, "%s: allocation failed\n", caller);
+        exit(EXIT_FAILURE);
+    }
+    return node;
+}
+
+#define DEFINE_BTREE(Name, K, V, COMPARE)                                                  \
+                                                                                           \
+enum {                                                                                     \
+    Name##_LEAF_CAPACITY = BTREE_CAPACITY(sizeof(K) + sizeof(V), 2 * sizeof(void *)),      \
+    Name##_BRANCH_CAPACITY = BTREE_CAPACITY(sizeof(K) + sizeof(void *), sizeof(void *)),   \
+    Name##_LEAF_MIN = Name##_LEAF_CAPACITY / 2,                                            \
+    Name##_BRANCH_MIN = Name##_BRANCH_CAPACITY / 2                                         \
+};                                                                                         \
+                                                                                           \
+typedef struct Name##Leaf {                                                                \
+    BTreeNode n;                                                                           \
+    struct Name##Leaf *prev; /* Leaf chain in key order */                                 \
+    struct Name##Leaf *next;                                                               \
+    K keys[Name##_LEAF_CAPACITY];                                                          \
+    V values[Name##_LEAF_CAPACITY];                                                        \
+} Name##Leaf;                                                                              \
+                                                                                           \
+typedef struct Name##Branch {                                                              \
+    BTreeNode n;                                                                           \
+    K keys[Name##_BRANCH_CAPACITY]; /* keys[i] <= keys under children[i + 1] */            \
+    BTreeNode *children[Name##_BRANCH_CAPACITY + 1];                                       \
+} Name##Branch;                                                                            \
+                                                                                           \
+/* Largest node: object size for a Pool serving both kinds */                              \
+enum {                                                                                     \
+    Name##_NODE_SIZE = sizeof(Name##Leaf) > sizeof(Name##Branch) ? sizeof(Name##Leaf)      \
+                                                                 : sizeof(Name##Branch)    \
+};                                                                                         \
+                                                                                           \
+typedef struct Name {                                                                      \
+    BTreeNode *root;            /* NULL when empty */                                      \
+    Name##Leaf *first;          /* Leaf with the smallest keys */                          \
+    Name##Leaf *last;           /* Leaf with the largest keys */                           \
+    size_t size;                /* Entries */                                              \
+    unsigned height;            /* Branch levels above the leaves */                       \
+    const Allocator *allocator; /* Source of nodes */                                      \
+} Name;                                                                                    \
+                                                                                           \
+/* Position of one entry; leaf is NULL past the end */                                     \
+typedef struct Name##Iter {                                                                \
+    Name##Leaf *leaf;                                                                      \
+    size_t index;                                                                          \
+} Name##Iter;                                                                              \
+                                                                                           \
+/* Range visitor: return false to stop early */                                            \
+typedef bool (*Name##VisitFn)(const K *key, V *value, void *ctx);                          \
+                                                                                           \
+/* Initialize empty map */                                                                 \
+static inline void Name##_init(Name *t) {                                                  \
+    t->root = NULL;                                                                        \
+    t->first = NULL;                                                                       \
+    t->last = NULL;                                                                        \
+    t->size = 0;                                                                           \
+    t->height = 0;                                                                         \
+    t->allocator = &HEAP_ALLOCATOR;                                                        \
+}                                                                                          \
+                                                                                           \
+/* Initialize empty map drawing nodes from allocator (Pool of Name##_NODE_SIZE) */         \
+static inline void Name##_init_with_allocator(Name *t, const Allocator *allocator) {       \
+    Name##_init(t);                                                                        \
+    t->allocator = allocator;                                                              \
+}                                                                                          \
+                                                                                           \
+/* New empty leaf (internal helper) */                                                     \
+static inline Name##Leaf *Name##_leaf_new(Name *t) {                                       \
+    Name##Leaf *leaf = (Name##Leaf *)btree_node_alloc(t->allocator, sizeof(Name##Leaf),    \
+                                                       #Name "_insert");                   \
+    leaf->n.count = 0;                                                                     \
+    leaf->n.leaf = 1;                                                                      \
+    leaf->prev = NULL;                                                                     \
+    leaf->next = NULL;                                                                     \
+    return leaf;                                                                           \
+}                                                                                          \
+                                                                                           \
+/* New empty branch (internal helper) */                                                   \
+static inline Name##Branch *Name##_branch_new(Name *t) {                                   \
+    Name##Branch *branch = (Name##Branch *)btree_node_alloc(t->allocator,                  \
+                                                             sizeof(Name##Branch),         \
+                                                             #Name "_insert");             \
+    branch->n.count = 0;                                                                   \
+    branch->n.leaf = 0;                                                                    \
+    return branch;                                                                         \
+}                                                                                          \
+                                                                                           \
+/* First index whose key is >= key (internal helper) */                                    \
+static inline size_t Name##_lower(const K *keys, size_t count, K key) {                    \
+    size_t lo = 0;                                                                         \
+    while (count > 0) {                                                                    \
+        size_t half = count / 2;                                                           \
+        if (COMPARE(keys[lo + half], key) < 0) {                                           \
+            lo += half + 1;                                                                \
+            count -= half + 1;                                                             \
+        } else {                                                                           \
+            count = half;                                                                  \
+        }                                                                                  \
+    }                                                                                      \
+    return lo;                                                                             \
+}                                                                                          \
+                                                                                           \
+/* Child of branch that may hold key: separators <= key (internal helper) */               \
+static inline size_t Name##_child_index(const Name##Branch *b, K key) {                    \
+    size_t lo = 0, count = b->n.count;                                                     \
+    while (count > 0) {                                                                    \
+        size_t half = count / 2;                                                           \
+        if (COMPARE(b->keys[lo + half], key) <= 0) {                                       \
+            lo += half + 1;                                                                \
+            count -= half + 1;                                                             \
+        } else {                                                                           \
+            count = half;                                                                  \
+        }                                                                                  \
+    }                                                                                      \
+    return lo;                                                                             \
+}                                                                                          \
+                                                                                           \
+/* Leaf that would hold key, recording the branch path (internal helper) */                \
+static inline Name##Leaf *Name##_descend(const Name *t, K key, Name##Branch **path,        \
+                                         size_t *slots, unsigned *depth) {                 \
+    BTreeNode *node = t->root;                                                             \
+    unsigned d = 0;                                                                        \
+    while (!node->leaf) {                                                                  \
+        Name##Branch *b = (Name##Branch *)node;                                            \
+        btree_prefetch(b, sizeof(Name##Branch));                                           \
+        size_t i = Name##_child_index(b, key);                                             \
+        if (path) {                                                                        \
+            path[d] = b;                                                                   \
+            slots[d] = i;                                                                  \
+        }                                                                                  \
+        d++;                                                                               \
+        node = b->children[i];                                                             \
+    }                                                                                      \
+    if (depth) *depth = d;                                                                 \
+    btree_prefetch(node, sizeof(Name##Leaf));                                              \
+    return (Name##Leaf *)node;                                                             \
+}                                                                                          \
+                                                                                           \
+/* Insert entry at pos of a non-full leaf (internal helper) */                             \
+static inline void Name##_leaf_put(Name##Leaf *leaf, size_t pos, K key, V value) {         \
+    size_t tail = leaf->n.count - pos;                                                     \
+    memmove(leaf->keys + pos + 1, leaf->keys + pos, tail * sizeof(K));                     \
+    memmove(leaf->values + pos + 1, leaf->values + pos, tail * sizeof(V));                 \
+    leaf->keys[pos] = key;                                                                 \
+    leaf->values[pos] = value;                                                             \
+    leaf->n.count++;                                                                       \
+}                                                                                          \
+                                                                                           \
+/* Remove entry at pos of a leaf (internal helper) */                                      \
+static inline void Name##_leaf_take(Name##Leaf *leaf, size_t pos) {                        \
+    size_t tail = leaf->n.count - pos - 1;                                                 \
+    memmove(leaf->keys + pos, leaf->keys + pos + 1, tail * sizeof(K));                     \
+    memmove(leaf->values + pos, leaf->values + pos + 1, tail * sizeof(V));                 \
+    leaf->n.count--;                                                                       \
+}                                                                                          \
+                                                                                           \
+/* Insert separator at i and its right child at i + 1 of a non-full branch */              \
+static inline void Name##_branch_put(Name##Branch *b, size_t i, K key, BTreeNode *child) { \
+    size_t tail = b->n.count - i;                                                          \
+    memmove(b->keys + i + 1, b->keys + i, tail * sizeof(K));                               \
+    memmove(b->children + i + 2, b->children + i + 1, tail * sizeof(BTreeNode *));         \
+    b->keys[i] = key;                                                                      \
+    b->children[i + 1] = child;                                                            \
+    b->n.count++;                                                                          \
+}                                                                                          \
+                                                                                           \
+/* Remove separator i and child i + 1 of a branch (internal helper) */                     \
+static inline void Name##_branch_take(Name##Branch *b, size_t i) {                         \
+    size_t tail = b->n.count - i - 1;                                                      \
+    memmove(b->keys + i, b->keys + i + 1, tail * sizeof(K));                               \
+    memmove(b->children + i + 1, b->children + i + 2, tail * sizeof(BTreeNode *));         \
+    b->n.count--;                                                                          \
+}                                                                                          \
+                                                                                           \
+/* Check whether key is present */                                                         \
+static inline bool Name##_search(const Name *t, K key) {                                   \
+    if (!t->root) return false;                                                            \
+    Name##Leaf *leaf = Name##_descend(t, key, NULL, NULL, NULL);                           \
+    size_t pos = Name##_lower(leaf->keys, leaf->n.count, key);                             \
+    return pos < leaf->n.count && COMPARE(leaf->keys[pos], key) == 0;                      \
+}                                                                                          \
+                                                                                           \
+/* Value stored for key, NULL if absent (valid until the next insert/delete) */            \
+static inline V *Name##_get(const Name *t, K key) {                                        \
+    if (!t->root) return NULL;                                                             \
+    Name##Leaf *leaf = Name##_descend(t, key, NULL, NULL, NULL);                           \
+    size_t pos = Name##_lower(leaf->keys, leaf->n.count, key);                             \
+    bool found = pos < leaf->n.count && COMPARE(leaf->keys[pos], key) == 0;                \
+    return found ? &leaf->values[pos] : NULL;                                              \
+}                                                                                          \
+                                                                                           \
+/* Insert or replace; true if key was new */                                               \
+static inline bool Name##_insert(Name *t, K key, V value) {                                \
+    if (!t->root) {                                                                        \
+        Name##Leaf *leaf = Name##_leaf_new(t);                                             \
+        Name##_leaf_put(leaf, 0, key, value);                                              \
+        t->root = &leaf->n;                                                                \
+        t->first = t->last = leaf;                                                         \
+        t->size = 1;                                                                       \
+        return true;                                                                       \
+    }                                                                                      \
+    Name##Branch *path[BTREE_MAX_DEPTH];                                                   \
+    size_t slots[BTREE_MAX_DEPTH];                                                         \
+    unsigned depth;                                                                        \
+    Name##Leaf *leaf = Name##_descend(t, key, path, slots, &depth);                        \
+    size_t pos = Name##_lower(leaf->keys, leaf->n.count, key);                             \
+    if (pos < leaf->n.count && COMPARE(leaf->keys[pos], key) == 0) {                       \
+        leaf->values[pos] = value;                                                         \
+        return false;                                                                      \
+    }                                                                                      \
+    t->size++;                                                                             \
+    if (leaf->n.count < Name##_LEAF_CAPACITY) {                                            \
+        Name##_leaf_put(leaf, pos, key, value);                                            \
+        return true;                                                                       \
+    }                                                                                      \
+                                                                                           \
+    /* Split the full leaf: the upper half moves to a new right sibling */                 \
+    Name##Leaf *right = Name##_leaf_new(t);                                                \
+    size_t mid = (Name##_LEAF_CAPACITY + 1) / 2;                                           \
+    right->n.count = (uint16_t)(Name##_LEAF_CAPACITY - mid);                               \
+    memcpy(right->keys, leaf->keys + mid, right->n.count * sizeof(K));                     \
+    memcpy(right->values, leaf->values + mid, right->n.count * sizeof(V));                 \
+    leaf->n.count = (uint16_t)mid;                                                         \
+    right->prev = leaf;                                                                    \
+    right->next = leaf->next;                                                              \
+    if (leaf->next) {                                                                      \
+        leaf->next->prev = right;                                                          \
+    } else {                                                                               \
+        t->last = right;                                                                   \
+    }                                                                                      \
+    leaf->next = right;                                                                    \
+    if (pos < mid) {                                                                       \
+        Name##_leaf_put(leaf, pos, key, value);                                            \
+    } else {                                                                               \
+        Name##_leaf_put(right, pos - mid, key, value);                                     \
+    }                                                                                      \
+                                                                                           \
+    /* Push separators up, splitting full branches around their middle key */              \
+    K separator = right->keys[0];                                                          \
+    BTreeNode *child = &right->n;                                                          \
+    while (depth > 0) {                                                                    \
+        Name##Branch *b = path[--depth];                                                   \
+        size_t i = slots[depth];                                                           \
+        if (b->n.count < Name##_BRANCH_CAPACITY) {                                         \
+            Name##_branch_put(b, i, separator, child);                                     \
+            return true;                                                                   \
+        }                                                                                  \
+        K keys[Name##_BRANCH_CAPACITY + 1];                                                \
+        BTreeNode *children[Name##_BRANCH_CAPACITY + 2];                                   \
+        size_t tail = Name##_BRANCH_CAPACITY - i;                                          \
+        memcpy(keys, b->keys, i * sizeof(K));                                              \
+        keys[i] = separator;                                                               \
+        memcpy(keys + i + 1, b->keys + i, tail * sizeof(K));                               \
+        memcpy(children, b->children, (i + 1) * sizeof(BTreeNode *));                      \
+        children[i + 1] = child;                                                           \
+        memcpy(children + i + 2, b->children + i + 1, tail * sizeof(BTreeNode *));         \
+                                                                                           \
+        size_t half = (Name##_BRANCH_CAPACITY + 1) / 2;                                    \
+        Name##Branch *split = Name##_branch_new(t);                                        \
+        b->n.count = (uint16_t)half;                                                       \
+        memcpy(b->keys, keys, half * sizeof(K));                                           \
+        memcpy(b->children, children, (half + 1) * sizeof(BTreeNode *));                   \
+        split->n.count = (uint16_t)(Name##_BRANCH_CAPACITY - half);                        \
+        memcpy(split->keys, keys + half + 1, split->n.count * sizeof(K));                  \
+        memcpy(split->children, children + half + 1,                                       \
+               (split->n.count + 1) * sizeof(BTreeNode *));                                \
+        separator = keys[half];                                                            \
+        child = &split->n;                                                                 \
+    }                                                                                      \
+                                                                                           \
+    /* The root split: grow by one level */                                                \
+    Name##Branch *root = Name##_branch_new(t);                                             \
+    root->n.count = 1;                                                                     \
+    root->keys[0] = separator;                                                             \
+    root->children[0] = t->root;                                                           \
+    root->children[1] = child;                                                             \
+    t->root = &root->n;                                                                    \
+    t->height++;                                                                           \
+    return true;                                                                           \
+}                                                                                          \
+                                                                                           \
+/* Append right leaf to left and unlink it (internal helper) */                            \
+static inline void Name##_leaf_merge(Name *t, Name##Leaf *left, Name##Leaf *right) {       \
+    memcpy(left->keys + left->n.count, right->keys, right->n.count * sizeof(K));           \
+    memcpy(left->values + left->n.count, right->values, right->n.count * sizeof(V));       \
+    left->n.count = (uint16_t)(left->n.count + right->n.count);                            \
+    left->next = right->next;                                                              \
+    if (right->next) {                                                                     \
+        right->next->prev = left;                                                          \
+    } else {                                                                               \
+        t->last = left;                                                                    \
+    }                                                                                      \
+    allocator_free(t->allocator, right, sizeof(Name##Leaf));                               \
+}                                                                                          \
+                                                                                           \
+/* Append separator and right branch to left (internal helper) */                          \
+static inline void Name##_branch_merge(Name *t, Name##Branch *left, K separator,           \
+                                       Name##Branch *right) {                              \
+    size_t count = left->n.count;                                                          \
+    left->keys[count] = separator;                                                         \
+    memcpy(left->keys + count + 1, right->keys, right->n.count * sizeof(K));               \
+    memcpy(left->children + count + 1, right->children,                                    \
+           (right->n.count + 1) * sizeof(BTreeNode *));                                    \
+    left->n.count = (uint16_t)(count + 1 + right->n.count);                                \
+    allocator_free(t->allocator, right, sizeof(Name##Branch));                             \
+}                                                                                          \
+                                                                                           \
+/* Refill an underfull branch at path[depth] from a sibling or merge (internal) */         \
+static inline void Name##_fix_branch(Name *t, Name##Branch **path, const size_t *slots,    \
+                                     unsigned depth) {                                     \
+    for (;;) {                                                                             \
+        Name##Branch *b = path[depth];                                                     \
+        if (depth == 0) {                                                                  \
+            if (b->n.count == 0) {                                                         \
+                t->root = b->children[0];                                                  \
+                allocator_free(t->allocator, b, sizeof(Name##Branch));                     \
+                t->height--;                                                               \
+            }                                                                              \
+            return;                                                                        \
+        }                                                                                  \
+        if (b->n.count >= Name##_BRANCH_MIN) return;                                       \
+        Name##Branch *parent = path[depth - 1];                                            \
+        size_t j = slots[depth - 1];                                                       \
+        Name##Branch *left = j > 0 ? (Name##Branch *)parent->children[j - 1] : NULL;       \
+        Name##Branch *right =                                                              \
+            j < parent->n.count ? (Name##Branch *)parent->children[j + 1] : NULL;          \
+        if (left && left->n.count > Name##_BRANCH_MIN) {                                   \
+            /* Rotate the left sibling's last child through the parent */                  \
+            memmove(b->keys + 1, b->keys, b->n.count * sizeof(K));                         \
+            memmove(b->children + 1, b->children, (b->n.count + 1) * sizeof(BTreeNode *)); \
+            b->keys[0] = parent->keys[j - 1];                                              \
+            b->children[0] = left->children[left->n.count];                                \
+            b->n.count++;                                                                  \
+            parent->keys[j - 1] = left->keys[left->n.count - 1];                           \
+            left->n.count--;                                                               \
+            return;                                                                        \
+        }                                                                                  \
+        if (right && right->n.count > Name##_BRANCH_MIN) {                                 \
+            b->keys[b->n.count] = parent->keys[j];                                         \
+            b->children[b->n.count + 1] = right->children[0];                              \
+            b->n.count++;                                                                  \
+            parent->keys[j] = right->keys[0];                                              \
+            memmove(right->keys, right->keys + 1, (right->n.count - 1) * sizeof(K));       \
+            memmove(right->children, right->children + 1,                                  \
+                    right->n.count * sizeof(BTreeNode *));                                 \
+            right->n.count--;                                                              \
+            return;                                                                        \
+        }                                                                                  \
+        if (left) {                                                                        \
+            Name##_branch_merge(t, left, parent->keys[j - 1], b);                          \
+            Name##_branch_take(parent, j - 1);                                             \
+        } else {                                                                           \
+            Name##_branch_merge(t, b, parent->keys[j], right);                             \
+            Name##_branch_take(parent, j);                                                 \
+        }                                                                                  \
+        depth--;                                                                           \
+    }                                                                                      \
+}                                                                                          \
+                                                                                           \
+/* Remove key; true if it was present */                                                   \
+static inline bool Name##_delete(Name *t, K key) {                                         \
+    if (!t->root) return false;                                                            \
+    Name##Branch *path[BTREE_MAX_DEPTH];                                                   \
+    size_t slots[BTREE_MAX_DEPTH];                                                         \
+    unsigned depth;                                                                        \
+    Name##Leaf *leaf = Name##_descend(t, key, path, slots, &depth);                        \
+    size_t pos = Name##_lower(leaf->keys, leaf->n.count, key);                             \
+    if (pos >= leaf->n.count || COMPARE(leaf->keys[pos], key) != 0) return false;          \
+    Name##_leaf_take(leaf, pos);                                                           \
+    t->size--;                                                                             \
+                                                                                           \
+    if (depth == 0) {                                                                      \
+        if (leaf->n.count == 0) {                                                          \
+            allocator_free(t->allocator, leaf, sizeof(Name##Leaf));                        \
+            t->root = NULL;                                                                \
+            t->first = t->last = NULL;                                                     \
+        }                                                                                  \
+        return true;                                                                       \
+    }                                                                                      \
+    if (leaf->n.count >= Name##_LEAF_MIN) return true;                                     \
+                                                                                           \
+    /* Underfull leaf: borrow from a sibling, else merge (separators may stay stale) */    \
+    Name##Branch *parent = path[depth - 1];                                                \
+    size_t i = slots[depth - 1];                                                           \
+    Name##Leaf *left = i > 0 ? (Name##Leaf *)parent->children[i - 1] : NULL;               \
+    Name##Leaf *right =                                                                    \
+        i < parent->n.count ? (Name##Leaf *)parent->children[i + 1] : NULL;                \
+    if (left && left->n.count > Name##_LEAF_MIN) {                                         \
+        size_t last = left->n.count - 1u;                                                  \
+        Name##_leaf_put(leaf, 0, left->keys[last], left->values[last]);                    \
+        left->n.count--;                                                                   \
+        parent->keys[i - 1] = leaf->keys[0];                                               \
+        return true;                                                                       \
+    }                                                                                      \
+    if (right && right->n.count > Name##_LEAF_MIN) {                                       \
+        Name##_leaf_put(leaf, leaf->n.count, right->keys[0], right->values[0]);            \
+        Name##_leaf_take(right, 0);                                                        \
+        parent->keys[i] = right->keys[0];                                                  \
+        return true;                                                                       \
+    }                                                                                      \
+    if (left) {                                                                            \
+        Name##_leaf_merge(t, left, leaf);                                                  \
+        Name##_branch_take(parent, i - 1);                                                 \
+    } else {                                                                               \
+        Name##_leaf_merge(t, leaf, right);                                                 \
+        Name##_branch_take(parent, i);                                                     \
+    }                                                                                      \
+    Name##_fix_branch(t, path, slots, depth - 1);                                          \
+    return true;                                                                           \
+}                                                                                          \
+                                                                                           \
+/* Bulk load strictly increasing keys into packed leaves, O(n) */                          \
+/* A non-empty map falls back to one insert per entry */                                   \
+static inline void Name##_build(Name *t, const K *keys, const V *values, size_t n) {       \
+    if (t->root) {                                                                         \
+        for (size_t i = 0; i < n; i++) Name##_insert(t, keys[i], values[i]);               \
+        return;                                                                            \
+    }                                                                                      \
+    if (n == 0) return;                                                                    \
+    size_t count = (n + Name##_LEAF_CAPACITY - 1) / Name##_LEAF_CAPACITY;                  \
+    BTreeNode **level = (BTreeNode **)malloc(count * sizeof(BTreeNode *));                 \
+    K *mins = (K *)malloc(count * sizeof(K));                                              \
+    if (!level || !mins) {                                                                 \
+        fprintf(stderr, #Name "_build: allocation failed\n");                              \
+        exit(EXIT_FAILURE);                                                                \
+    }                                                                                      \
+                                                                                           \
+    /* Spread entries evenly so every leaf is at least half full */                        \
+    Name##Leaf *prev = NULL;                                                               \
+    size_t at = 0;                                                                         \
+    for (size_t l = 0; l < count; l++) {                                                   \
+        size_t take = n / count + (l < n % count);                                         \
+        Name##Leaf *leaf = Name##_leaf_new(t);                                             \
+        memcpy(leaf->keys, keys + at, take * sizeof(K));                                   \
+        memcpy(leaf->values, values + at, take * sizeof(V));                               \
+        leaf->n.count = (uint16_t)take;                                                    \
+        leaf->prev = prev;                                                                 \
+        if (prev) {                                                                        \
+            prev->next = leaf;                                                             \
+        } else {                                                                           \
+            t->first = leaf;                                                               \
+        }                                                                                  \
+        prev = leaf;                                                                       \
+        mins[l] = keys[at];                                                                \
+        level[l] = &leaf->n;                                                               \
+        at += take;                                                                        \
+    }                                                                                      \
+    t->last = prev;                                                                        \
+                                                                                           \
+    /* Branch levels: each separator is the smallest key of its child */                   \
+    while (count > 1) {                                                                    \
+        size_t parents = (count + Name##_BRANCH_CAPACITY) / (Name##_BRANCH_CAPACITY + 1);  \
+        size_t child = 0;                                                                  \
+        for (size_t p = 0; p < parents; p++) {                                             \
+            size_t take = count / parents + (p < count % parents);                         \
+            Name##Branch *b = Name##_branch_new(t);                                        \
+            b->n.count = (uint16_t)(take - 1);                                             \
+            for (size_t c = 0; c < take; c++) {                                            \
+                b->children[c] = level[child + c];                                         \
+                if (c) b->keys[c - 1] = mins[child + c];                                   \
+            }                                                                              \
+            mins[p] = mins[child];                                                         \
+            level[p] = &b->n;                                                              \
+            child += take;                                                                 \
+        }                                                                                  \
+        count = parents;                                                                   \
+        t->height++;                                                                       \
+    }                                                                                      \
+    t->root = level[0];                                                                    \
+    t->size = n;                                                                           \
+    free(level);                                                                           \
+    free(mins);                                                                            \
+}                                                                                          \
+                                                                                           \
+/* Iterator at the smallest key */                                                         \
+static inline Name##Iter Name##_begin(const Name *t) {                                     \
+    Name##Iter it = {t->first, 0};                                                         \
+    return it;                                                                             \
+}                                                                                          \
+                                                                                           \
+/* Iterator at the first key >= key */                                                     \
+static inline Name##Iter Name##_lower_bound(const Name *t, K key) {                        \
+    Name##Iter it = {NULL, 0};                                                             \
+    if (!t->root) return it;                                                               \
+    it.leaf = Name##_descend(t, key, NULL, NULL, NULL);                                    \
+    it.index = Name##_lower(it.leaf->keys, it.leaf->n.count, key);                         \
+    if (it.index == it.leaf->n.count) {                                                    \
+        it.leaf = it.leaf->next;                                                           \
+        it.index = 0;                                                                      \
+    }                                                                                      \
+    return it;                                                                             \
+}                                                                                          \
+                                                                                           \
+/* Whether the iterator points at an entry */                                              \
+static inline bool Name##_iter_valid(const Name##Iter *it) {                               \
+    return it->leaf != NULL;                                                               \
+}                                                                                          \
+                                                                                           \
+/* Key at the iterator */                                                                  \
+static inline const K *Name##_iter_key(const Name##Iter *it) {                             \
+    return &it->leaf->keys[it->index];                                                     \
+}                                                                                          \
+                                                                                           \
+/* Value at the iterator */                                                                \
+static inline V *Name##_iter_value(const Name##Iter *it) {                                 \
+    return &it->leaf->values[it->index];                                                   \
+}                                                                                          \
+                                                                                           \
+/* Advance to the next key along the leaf chain */                                         \
+static inline void Name##_iter_next(Name##Iter *it) {                                      \
+    if (++it->index == it->leaf->n.count) {                                                \
+        it->leaf = it->leaf->next;                                                         \
+        it->index = 0;                                                                     \
+    }                                                                                      \
+}                                                                                          \
+                                                                                           \
+/* Visit entries with lo <= key <= hi in ascending order, O(log n + k) */                  \
+static inline void Name##_range(const Name *t, K lo, K hi, Name##VisitFn visit,            \
+                                void *ctx) {                                               \
+    for (Name##Iter it = Name##_lower_bound(t, lo); it.leaf; Name##_iter_next(&it)) {      \
+        if (COMPARE(it.leaf->keys[it.index], hi) > 0) return;                              \
+        if (!visit(&it.leaf->keys[it.index], &it.leaf->values[it.index], ctx)) return;     \
+    }                                                                                      \
+}                                                                                          \
+                                                                                           \
+/* Get number of entries */                                                                \
+static inline size_t Name##_size(const Name *t) {                                          \
+    return t->size;                                                                        \
+}                                                                                          \
+                                                                                           \
+/* Free nodes below node (internal helper) */                                              \
+static inline void Name##_free_node(const Allocator *allocator, BTreeNode *node) {         \
+    if (node->leaf) {                                                                      \
+        allocator_free(allocator, node, sizeof(Name##Leaf));                               \
+        return;                                                                            \
+    }                                                                                      \
+    Name##Branch *b = (Name##Branch *)node;                                                \
+    for (size_t i = 0; i <= b->n.count; i++) Name##_free_node(allocator, b->children[i]);  \
+    allocator_free(allocator, b, sizeof(Name##Branch));                                    \
+}                                                                                          \
+                                                                                           \
+/* Free all nodes (keys and values are stored by value) */                                 \
+static inline void Name##_free(Name *t) {                                                  \
+    if (t->root && !allocator_frees_in_bulk(t->allocator)) {                               \
+        Name##_free_node(t->allocator, t->root);                                           \
+    }                                                                                      \
+    const Allocator *allocator = t->allocator;                                             \
+    Name##_init_with_allocator(t, allocator);                                              \
+}                                                                                          \
+                                                                                           \
+/* Check node fill, key order, separator bounds, depth and leaf chain (internal) */        \
+static inline bool Name##_valid_node(const Name *t, const BTreeNode *node, const K *lo,    \
+                                     const K *hi, unsigned depth, size_t *entries,         \
+                                     const Name##Leaf **chain) {                           \
+    bool root = node == t->root;                                                           \
+    if (node->leaf) {                                                                      \
+        const Name##Leaf *leaf = (const Name##Leaf *)node;                                 \
+        if (depth != t->height || leaf != *chain) return false;                            \
+        if (leaf->n.count < (root ? 1 : Name##_LEAF_MIN)) return false;                    \
+        for (size_t i = 0; i < leaf->n.count; i++) {                                       \
+            if (i && COMPARE(leaf->keys[i - 1], leaf->keys[i]) >= 0) return false;         \
+            if (lo && COMPARE(leaf->keys[i], *lo) < 0) return false;                       \
+            if (hi && COMPARE(leaf->keys[i], *hi) >= 0) return false;                      \
+        }                                                                                  \
+        if (leaf->next && leaf->next->prev != leaf) return false;                          \
+        *entries += leaf->n.count;                                                         \
+        *chain = leaf->next;                                                               \
+        return true;                                                                       \
+    }                                                                                      \
+    const Name##Branch *b = (const Name##Branch *)node;                                    \
+    if (b->n.count < (root ? 1 : Name##_BRANCH_MIN)) return false;                         \
+    for (size_t i = 0; i <= b->n.count; i++) {                                             \
+        const K *child_lo = i ? &b->keys[i - 1] : lo;                                      \
+        const K *child_hi = i < b->n.count ? &b->keys[i] : hi;                             \
+        if (i && i < b->n.count && COMPARE(b->keys[i - 1], b->keys[i]) >= 0) return false; \
+        if (!Name##_valid_node(t, b->children[i], child_lo, child_hi, depth + 1, entries,  \
+                               chain)) {                                                   \
+            return false;                                                                  \
+        }                                                                                  \
+    }                                                                                      \
+    return true;                                                                           \
+}                                                                                          \
+                                                                                           \
+/* Check B+-tree invariants (for testing) */                                               \
+static inline bool Name##_is_valid(const Name *t) {                                        \
+    if (!t->root) return t->size == 0 && !t->first && !t->last;                            \
+    size_t entries = 0;                                                                    \
+    const Name##Leaf *chain = t->first;                                                    \
+    if (t->first->prev || t->last->next) return false;                                     \
+    return Name##_valid_node(t, t->root, NULL, NULL, 0, &entries, &chain) && !chain &&     \
+           entries == t->size;                                                             \
+}
+
+#endif // BTREE_H
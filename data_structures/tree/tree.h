@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include "../allocator/allocator.h"
 
 /**
  * BINARY SEARCH TREE IMPLEMENTATION
@@ -21,6 +23,15 @@
  * Space Complexity: O(n)
  *
  * Note: This is an unbalanced tree. Use AVL tree for guaranteed O(log n) operations.
+ *
+ * StaticTree is the frozen form for read-only lookup tables: the balanced
+ * tree over sorted keys stored in Eytzinger (BFS) order in one cache-line
+ * aligned array. Node k has children 2k and 2k + 1, so the 16 descendants
+ * four levels below k share one cache line and can be prefetched while the
+ * current level is compared. Descent is branch-free; search_many interleaves
+ * independent lookups so their cache misses overlap.
+ * - Build: O(n)
+ * - Search / Lower bound: O(log n), about log(n) / 4 cache misses
  */
 
 // Tree node structure
@@ -35,20 +46,42 @@ typedef struct TreeNode
 // Tree structure
 typedef struct Tree
 {
-    TreeNode *root; // Root node
-    size_t size;    // Number of nodes
+    TreeNode *root;             // Root node
+    size_t size;                // Number of nodes
+    const Allocator *allocator; // Source of nodes
 } Tree;
 
+// Static tree alignment: one line holds 16 keys
+#define STATIC_TREE_CACHE_LINE 64
+
+// Lookups advanced together by static_tree_search_many
+#define STATIC_TREE_LANES 8
+
+#if defined(__GNUC__)
+#define STATIC_TREE_PREFETCH(address) __builtin_prefetch((const void *)(address))
+#else
+#define STATIC_TREE_PREFETCH(address) ((void)0)
+#endif
+
+// Read-only search tree in Eytzinger order
+typedef struct StaticTree
+{
+    int *keys;       // keys[1..size] in BFS order of the balanced tree (keys[0] unused)
+    size_t size;     // Number of keys
+    unsigned levels; // Complete levels: floor(log2(size + 1))
+} StaticTree;
+
 // ==================== NODE OPERATIONS ====================
 
 /**
- * Create new tree node
+ * Create new tree node from allocator
+ * @param allocator: Source of node memory (NULL = heap)
  * @param data: Value to store
- * @return: New node or NULL on failure
+ * @return: New node (exits on allocation failure)
  */
-static inline TreeNode *tree_create_node(int data)
+static inline TreeNode *tree_create_node_with(const Allocator *allocator, int data)
 {
-    TreeNode *node = (TreeNode *)malloc(sizeof(TreeNode));
+    TreeNode *node = (TreeNode *)allocator_alloc(allocator, sizeof(TreeNode));
     if (!node)
     {
         fprintf(stderr, "tree_create_node: allocation failed\n");
@@ -62,6 +95,16 @@ static inline TreeNode *tree_create_node(int data)
     return node;
 }
 
+/**
+ * Create new tree node
+ * @param data: Value to store
+ * @return: New node (exits on allocation failure)
+ */
+static inline TreeNode *tree_create_node(int data)
+{
+    return tree_create_node_with(&HEAP_ALLOCATOR, data);
+}
+
 /**
  * Get height of node (-1 for NULL nodes)
  * @param node: Target node
@@ -144,41 +187,52 @@ static inline TreeNode *tree_search_node(TreeNode *root, int data)
 }
 
 /**
- * Free all nodes in subtree
+ * Return all nodes in subtree to allocator
+ * @param allocator: Allocator the nodes came from (NULL = heap)
  * @param root: Root of subtree to free
  */
-static inline void tree_free_nodes(TreeNode *root)
+static inline void tree_free_nodes_with(const Allocator *allocator, TreeNode *root)
 {
     if (root)
     {
-        tree_free_nodes(root->left);
-        tree_free_nodes(root->right);
-        free(root);
+        tree_free_nodes_with(allocator, root->left);
+        tree_free_nodes_with(allocator, root->right);
+        allocator_free(allocator, root, sizeof(TreeNode));
     }
 }
 
+/**
+ * Free all nodes in subtree
+ * @param root: Root of subtree to free
+ */
+static inline void tree_free_nodes(TreeNode *root)
+{
+    tree_free_nodes_with(&HEAP_ALLOCATOR, root);
+}
+
 // ==================== BST OPERATIONS ====================
 
 /**
- * Insert value into BST subtree
+ * Insert value into BST subtree, allocating from allocator
+ * @param allocator: Source of new node (NULL = heap)
  * @param node: Root of subtree
  * @param data: Value to insert
  * @return: New root of subtree
  */
-static inline TreeNode *tree_insert_node(TreeNode *node, int data)
+static inline TreeNode *tree_insert_node_with(const Allocator *allocator, TreeNode *node, int data)
 {
     if (!node)
     {
-        return tree_create_node(data);
+        return tree_create_node_with(allocator, data);
     }
 
     if (data < node->data)
     {
-        node->left = tree_insert_node(node->left, data);
+        node->left = tree_insert_node_with(allocator, node->left, data);
     }
     else if (data > node->data)
     {
-        node->right = tree_insert_node(node->right, data);
+        node->right = tree_insert_node_with(allocator, node->right, data);
     }
     // Equal keys not allowed - return unchanged
 
@@ -187,23 +241,35 @@ static inline TreeNode *tree_insert_node(TreeNode *node, int data)
 }
 
 /**
- * Delete value from BST subtree
+ * Insert value into BST subtree
+ * @param node: Root of subtree
+ * @param data: Value to insert
+ * @return: New root of subtree
+ */
+static inline TreeNode *tree_insert_node(TreeNode *node, int data)
+{
+    return tree_insert_node_with(&HEAP_ALLOCATOR, node, data);
+}
+
+/**
+ * Delete value from BST subtree, returning the node to allocator
+ * @param allocator: Allocator the nodes came from (NULL = heap)
  * @param root: Root of subtree
  * @param data: Value to delete
  * @return: New root of subtree
  */
-static inline TreeNode *tree_delete_node(TreeNode *root, int data)
+static inline TreeNode *tree_delete_node_with(const Allocator *allocator, TreeNode *root, int data)
 {
     if (!root)
         return root;
 
     if (data < root->data)
     {
-        root->left = tree_delete_node(root->left, data);
+        root->left = tree_delete_node_with(allocator, root->left, data);
     }
     else if (data > root->data)
     {
-        root->right = tree_delete_node(root->right, data);
+        root->right = tree_delete_node_with(allocator, root->right, data);
     }
     else
     {
@@ -211,26 +277,37 @@ static inline TreeNode *tree_delete_node(TreeNode *root, int data)
         if (!root->left)
         {
             TreeNode *temp = root->right;
-            free(root);
+            allocator_free(allocator, root, sizeof(TreeNode));
             return temp;
         }
         else if (!root->right)
         {
             TreeNode *temp = root->left;
-            free(root);
+            allocator_free(allocator, root, sizeof(TreeNode));
             return temp;
         }
 
         // Node with two children - replace with inorder successor
         TreeNode *temp = tree_find_min(root->right);
         root->data = temp->data;
-        root->right = tree_delete_node(root->right, temp->data);
+        root->right = tree_delete_node_with(allocator, root->right, temp->data);
     }
 
     tree_update_height(root);
     return root;
 }
 
+/**
+ * Delete value from BST subtree
+ * @param root: Root of subtree
+ * @param data: Value to delete
+ * @return: New root of subtree
+ */
+static inline TreeNode *tree_delete_node(TreeNode *root, int data)
+{
+    return tree_delete_node_with(&HEAP_ALLOCATOR, root, data);
+}
+
 // ==================== TREE OPERATIONS ====================
 
 /**
@@ -241,6 +318,18 @@ static inline void tree_init(Tree *tree)
 {
     tree->root = NULL;
     tree->size = 0;
+    tree->allocator = &HEAP_ALLOCATOR;
+}
+
+/**
+ * Initialize empty tree drawing nodes from a custom allocator
+ * @param tree: Tree to initialize
+ * @param allocator: Source of nodes (e.g. an Arena or a Pool of sizeof(TreeNode))
+ */
+static inline void tree_init_with_allocator(Tree *tree, const Allocator *allocator)
+{
+    tree_init(tree);
+    tree->allocator = allocator;
 }
 
 /**
@@ -250,14 +339,12 @@ static inline void tree_init(Tree *tree)
  */
 static inline void tree_insert(Tree *tree, int data)
 {
-    TreeNode *old_root = tree->root;
-    tree->root = tree_insert_node(tree->root, data);
-
-    // Only increment size if new node was added
-    if (tree->root != old_root || tree->size == 0)
+    // Duplicates are ignored, so only count values that were absent
+    if (!tree_search_node(tree->root, data))
     {
         tree->size++;
     }
+    tree->root = tree_insert_node_with(tree->allocator, tree->root, data);
 }
 
 /**
@@ -272,7 +359,7 @@ static inline bool tree_delete(Tree *tree, int data)
     if (!found)
         return false;
 
-    tree->root = tree_delete_node(tree->root, data);
+    tree->root = tree_delete_node_with(tree->allocator, tree->root, data);
     tree->size--;
     return true;
 }
@@ -314,7 +401,11 @@ static inline bool tree_is_empty(Tree *tree)
  */
 static inline void tree_free(Tree *tree)
 {
-    tree_free_nodes(tree->root);
+    // Region allocators reclaim nodes on reset, no need to walk the tree
+    if (!allocator_frees_in_bulk(tree->allocator))
+    {
+        tree_free_nodes_with(tree->allocator, tree->root);
+    }
     tree->root = NULL;
     tree->size = 0;
 }
@@ -513,6 +604,7 @@ static inline TreeNode *tree_from_sorted_array_helper(int *arr, int start, int e
 
 /**
  * Create balanced tree from sorted array
+ * For a read-only table, static_tree_from_sorted_array gives faster lookups.
  * @param tree: Tree to initialize
  * @param arr: Sorted array of unique values
  * @param size: Array size
@@ -556,6 +648,201 @@ static inline size_t tree_to_array(Tree *tree, int *arr)
     return index;
 }
 
+// ==================== STATIC LAYOUT ====================
+
+/**
+ * Write sorted keys into Eytzinger slots by inorder walk (internal helper)
+ * @param keys: Destination, 1-based
+ * @param sorted: Sorted source
+ * @param size: Number of keys
+ * @param next: Next source index
+ * @param k: Current slot
+ * @return: Next source index after the subtree at k
+ */
+static inline size_t static_tree_fill(int *keys, const int *sorted, size_t size, size_t next, size_t k)
+{
+    if (k <= size)
+    {
+        next = static_tree_fill(keys, sorted, size, next, 2 * k);
+        keys[k] = sorted[next++];
+        next = static_tree_fill(keys, sorted, size, next, 2 * k + 1);
+    }
+    return next;
+}
+
+/**
+ * Build static tree from sorted array
+ * @param tree: Static tree to initialize
+ * @param arr: Sorted values (duplicates allowed)
+ * @param size: Array size
+ */
+static inline void static_tree_from_sorted_array(StaticTree *tree, const int *arr, size_t size)
+{
+    // keys[0] sits on a line boundary so slots 16k..16k+15 share a line
+    size_t bytes = (size + 1) * sizeof(int);
+    bytes = (bytes + STATIC_TREE_CACHE_LINE - 1) / STATIC_TREE_CACHE_LINE * STATIC_TREE_CACHE_LINE;
+    tree->keys = (int *)aligned_alloc(STATIC_TREE_CACHE_LINE, bytes);
+    if (!tree->keys)
+    {
+        fprintf(stderr, "static_tree_from_sorted_array: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    tree->keys[0] = 0;
+    tree->size = size;
+    tree->levels = 0;
+    while (((size_t)2 << tree->levels) - 1 <= size)
+    {
+        tree->levels++;
+    }
+    static_tree_fill(tree->keys, arr, size, 0, 1);
+}
+
+/**
+ * Freeze a tree into its static layout (the tree is left unchanged)
+ * @param tree: Source tree
+ * @param frozen: Static tree to initialize
+ */
+static inline void tree_freeze(Tree *tree, StaticTree *frozen)
+{
+    size_t size = tree_count_nodes(tree->root);
+    int *sorted = (int *)malloc((size ? size : 1) * sizeof(int));
+    if (!sorted)
+    {
+        fprintf(stderr, "tree_freeze: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t count = tree_to_array(tree, sorted);
+    static_tree_from_sorted_array(frozen, sorted, count);
+    free(sorted);
+}
+
+/**
+ * Map a finished descent to the slot where it last went left (internal helper)
+ * @param k: Slot below the leaves
+ * @return: Lower bound slot, 0 if every key is smaller
+ */
+static inline size_t static_tree_resolve(size_t k)
+{
+    // Right turns appended trailing ones; drop them and the final left turn
+#if defined(__GNUC__)
+    return k >> (__builtin_ctzll(~(unsigned long long)k) + 1);
+#else
+    while (k & 1)
+    {
+        k >>= 1;
+    }
+    return k >> 1;
+#endif
+}
+
+/**
+ * Find first key not less than key
+ * @param tree: Target static tree
+ * @param key: Value to look for
+ * @return: Slot of the lower bound (read with static_tree_key), 0 if none
+ */
+static inline size_t static_tree_lower_bound(const StaticTree *tree, int key)
+{
+    const int *keys = tree->keys;
+    size_t k = 1;
+    while (k <= tree->size)
+    {
+        STATIC_TREE_PREFETCH((uintptr_t)keys + k * STATIC_TREE_CACHE_LINE);
+        k = 2 * k + (keys[k] < key);
+    }
+    return static_tree_resolve(k);
+}
+
+/**
+ * Get key stored in a slot
+ * @param tree: Target static tree
+ * @param slot: Non-zero slot from static_tree_lower_bound
+ * @return: Key
+ */
+static inline int static_tree_key(const StaticTree *tree, size_t slot)
+{
+    return tree->keys[slot];
+}
+
+/**
+ * Check whether key is present
+ * @param tree: Target static tree
+ * @param key: Value to look for
+ * @return: true if found
+ */
+static inline bool static_tree_search(const StaticTree *tree, int key)
+{
+    size_t slot = static_tree_lower_bound(tree, key);
+    return slot && tree->keys[slot] == key;
+}
+
+/**
+ * Check many keys, advancing STATIC_TREE_LANES lookups level by level
+ * The complete levels need no bounds check, so each group descends in
+ * lock step and keeps several cache misses in flight.
+ * @param tree: Target static tree
+ * @param queries: Values to look for
+ * @param count: Number of queries
+ * @param found: Receives count results
+ */
+static inline void static_tree_search_many(const StaticTree *tree, const int *queries, size_t count, bool *found)
+{
+    const int *keys = tree->keys;
+    size_t i = 0;
+    for (; i + STATIC_TREE_LANES <= count; i += STATIC_TREE_LANES)
+    {
+        size_t k[STATIC_TREE_LANES];
+        for (unsigned lane = 0; lane < STATIC_TREE_LANES; lane++)
+        {
+            k[lane] = 1;
+        }
+        for (unsigned level = 0; level < tree->levels; level++)
+        {
+            for (unsigned lane = 0; lane < STATIC_TREE_LANES; lane++)
+            {
+                STATIC_TREE_PREFETCH((uintptr_t)keys + k[lane] * STATIC_TREE_CACHE_LINE);
+                k[lane] = 2 * k[lane] + (keys[k[lane]] < queries[i + lane]);
+            }
+        }
+        for (unsigned lane = 0; lane < STATIC_TREE_LANES; lane++)
+        {
+            // At most one partial level remains
+            if (k[lane] <= tree->size)
+            {
+                k[lane] = 2 * k[lane] + (keys[k[lane]] < queries[i + lane]);
+            }
+            size_t slot = static_tree_resolve(k[lane]);
+            found[i + lane] = slot && keys[slot] == queries[i + lane];
+        }
+    }
+    for (; i < count; i++)
+    {
+        found[i] = static_tree_search(tree, queries[i]);
+    }
+}
+
+/**
+ * Get number of keys
+ * @param tree: Target static tree
+ * @return: Key count
+ */
+static inline size_t static_tree_size(const StaticTree *tree)
+{
+    return tree->size;
+}
+
+/**
+ * Free static tree
+ * @param tree: Static tree to free
+ */
+static inline void static_tree_free(StaticTree *tree)
+{
+    free(tree->keys);
+    tree->keys = NULL;
+    tree->size = 0;
+    tree->levels = 0;
+}
+
 // ==================== CONVENIENCE FUNCTIONS ====================
 
 /**
@@ -0,0 +1,1018 @@
+#ifndef TRIE_H
+#define TRIE_H
+
+#include "../allocator/pool.h"
+#include <float.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * ADAPTIVE RADIX TRIE
+ *
+ * Compressed radix trie over NUL-terminated strings (ART, Leis et al.).
+ * Inner nodes adapt their fan-out to the number of children:
+ * - Node4 / Node16: sorted key bytes next to child pointers (Node16 is
+ *   searched with one SSE2 compare)
+ * - Node48: 256-byte index into 48 child slots
+ * - Node256: direct child array
+ * Single-child chains are collapsed into a per-node prefix (the first
+ * TRIE_MAX_PREFIX bytes are stored, longer prefixes are checked against a
+ * leaf), and leaves are tagged pointers storing the key, a score and a value.
+ * Keys are borrowed: they must stay valid and unchanged while indexed.
+ *
+ * Every inner node caches the highest leaf score beneath it, so top-k
+ * completion visits subtrees best-first and stops after k leaves instead of
+ * enumerating every match.
+ *
+ * Each node kind and the leaves come from their own pool, so millions of
+ * keys cost a few large blocks rather than one malloc per node. A Trie must
+ * not be moved after trie_init (the pools embed their allocators).
+ *
+ * Time Complexities (k = key length):
+ * - Insert / Lookup / Remove: O(k)
+ * - Prefix iteration: O(k + matches)
+ * - Top-k completion: O(k + k_results * fan-out * log)
+ * - Score update: O(k * fan-out)
+ *
+ * Space Complexity: O(n) nodes, each sized to its fan-out
+ */
+
+#if !defined(TRIE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define TRIE_SSE2 1
+#endif
+
+// Prefix bytes stored in each inner node
+#define TRIE_MAX_PREFIX 10
+
+// Node kinds
+enum {
+    TRIE_NODE4 = 1,
+    TRIE_NODE16,
+    TRIE_NODE48,
+    TRIE_NODE256
+};
+
+// Leaf: borrowed key and its payload
+typedef struct TrieLeaf {
+    const unsigned char *key; // Borrowed, NUL-terminated
+    uint32_t key_len;         // Including the NUL
+    float score;              // Ranking for top-k completion
+    void *value;
+} TrieLeaf;
+
+// Header shared by every inner node
+typedef struct TrieNode {
+    uint32_t prefix_len; // Bytes skipped by this node (may exceed TRIE_MAX_PREFIX)
+    float best;          // Highest leaf score in this subtree
+    uint16_t count;      // Children
+    uint8_t type;        // TRIE_NODE4 .. TRIE_NODE256
+    unsigned char prefix[TRIE_MAX_PREFIX];
+} TrieNode;
+
+typedef struct TrieNode4 {
+    TrieNode n;
+    unsigned char keys[4];
+    void *children[4];
+} TrieNode4;
+
+typedef struct TrieNode16 {
+    TrieNode n;
+    unsigned char keys[16];
+    void *children[16];
+} TrieNode16;
+
+typedef struct TrieNode48 {
+    TrieNode n;
+    unsigned char index[256]; // Key byte -> slot + 1, 0 if absent
+    void *children[48];
+} TrieNode48;
+
+typedef struct TrieNode256 {
+    TrieNode n;
+    void *children[256];
+} TrieNode256;
+
+// Trie structure
+typedef struct Trie {
+    void *root;  // TrieNode or tagged TrieLeaf, NULL if empty
+    size_t size; // Keys
+    Pool node4_pool;
+    Pool node16_pool;
+    Pool node48_pool;
+    Pool node256_pool;
+    Pool leaf_pool;
+} Trie;
+
+// Callback for prefix iteration; return false to stop
+typedef bool (*TrieVisitFn)(const char *key, void *value, void *ctx);
+
+// Children pointers tag leaves with the low bit
+#define TRIE_IS_LEAF(p) (((uintptr_t)(p)) & 1)
+#define TRIE_LEAF(p) ((TrieLeaf *)((uintptr_t)(p) & ~(uintptr_t)1))
+#define TRIE_TAG_LEAF(l) ((void *)((uintptr_t)(l) | 1))
+
+// ==================== NODE ALLOCATION ====================
+
+/**
+ * Initialize empty trie
+ * @param trie: Trie to initialize
+ */
+static inline void trie_init(Trie *trie) {
+    trie->root = NULL;
+    trie->size = 0;
+    pool_init(&trie->node4_pool, sizeof(TrieNode4), 512);
+    pool_init(&trie->node16_pool, sizeof(TrieNode16), 128);
+    pool_init(&trie->node48_pool, sizeof(TrieNode48), 32);
+    pool_init(&trie->node256_pool, sizeof(TrieNode256), 8);
+    pool_init(&trie->leaf_pool, sizeof(TrieLeaf), 1024);
+}
+
+/**
+ * Pool of a node kind (internal helper)
+ */
+static inline Pool *trie_pool_of(Trie *trie, uint8_t type) {
+    switch (type) {
+    case TRIE_NODE4: return &trie->node4_pool;
+    case TRIE_NODE16: return &trie->node16_pool;
+    case TRIE_NODE48: return &trie->node48_pool;
+    default: return &trie->node256_pool;
+    }
+}
+
+/**
+ * Allocate an empty inner node (internal helper)
+ * @param trie: Owning trie
+ * @param type: Node kind
+ * @return: Zeroed node
+ */
+static inline TrieNode *trie_node_new(Trie *trie, uint8_t type) {
+    static const size_t sizes[] = {0, sizeof(TrieNode4), sizeof(TrieNode16), sizeof(TrieNode48),
+                                   sizeof(TrieNode256)};
+    TrieNode *node = (TrieNode *)pool_alloc(trie_pool_of(trie, type));
+    if (!node) {
+        fprintf(stderr, "trie_insert: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(node, 0, sizes[type]);
+    node->type = type;
+    return node;
+}
+
+/**
+ * Return an inner node to its pool (internal helper)
+ */
+static inline void trie_node_release(Trie *trie, TrieNode *node) {
+    pool_free(trie_pool_of(trie, node->type), node);
+}
+
+/**
+ * Copy header fields into a resized node (internal helper)
+ */
+static inline void trie_copy_header(TrieNode *dest, const TrieNode *src) {
+    dest->prefix_len = src->prefix_len;
+    dest->best = src->best;
+    dest->count = src->count;
+    memcpy(dest->prefix, src->prefix, TRIE_MAX_PREFIX);
+}
+
+// ==================== NODE SEARCH ====================
+
+/**
+ * Index of the lowest set bit (internal helper)
+ */
+static inline unsigned trie_lowest_bit(unsigned mask) {
+#if defined(__GNUC__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned bit = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * Slot holding the child for byte c (internal helper)
+ * @param node: Inner node
+ * @param c: Key byte
+ * @return: Pointer to the child slot, NULL if absent
+ */
+static inline void **trie_find_child(TrieNode *node, unsigned char c) {
+    switch (node->type) {
+    case TRIE_NODE4: {
+        TrieNode4 *n = (TrieNode4 *)node;
+        for (unsigned i = 0; i < node->count; i++) {
+            if (n->keys[i] == c) return &n->children[i];
+        }
+        return NULL;
+    }
+    case TRIE_NODE16: {
+        TrieNode16 *n = (TrieNode16 *)node;
+#if defined(TRIE_SSE2)
+        __m128i match = _mm_cmpeq_epi8(_mm_set1_epi8((char)c), _mm_loadu_si128((const __m128i *)(const void *)n->keys));
+        unsigned mask = (unsigned)_mm_movemask_epi8(match) & ((1u << node->count) - 1);
+        return mask ? &n->children[trie_lowest_bit(mask)] : NULL;
+#else
+        for (unsigned i = 0; i < node->count; i++) {
+            if (n->keys[i] == c) return &n->children[i];
+        }
+        return NULL;
+#endif
+    }
+    case TRIE_NODE48: {
+        TrieNode48 *n = (TrieNode48 *)node;
+        return n->index[c] ? &n->children[n->index[c] - 1] : NULL;
+    }
+    default: {
+        TrieNode256 *n = (TrieNode256 *)node;
+        return n->children[c] ? &n->children[c] : NULL;
+    }
+    }
+}
+
+/**
+ * Leftmost leaf of a subtree (internal helper)
+ * @param child: Node or tagged leaf
+ * @return: Leaf with the smallest key
+ */
+static inline TrieLeaf *trie_minimum(const void *child) {
+    while (!TRIE_IS_LEAF(child)) {
+        const TrieNode *node = (const TrieNode *)child;
+        switch (node->type) {
+        case TRIE_NODE4: child = ((const TrieNode4 *)node)->children[0]; break;
+        case TRIE_NODE16: child = ((const TrieNode16 *)node)->children[0]; break;
+        case TRIE_NODE48: {
+            const TrieNode48 *n = (const TrieNode48 *)node;
+            unsigned c = 0;
+            while (!n->index[c]) c++;
+            child = n->children[n->index[c] - 1];
+            break;
+        }
+        default: {
+            const TrieNode256 *n = (const TrieNode256 *)node;
+            unsigned c = 0;
+            while (!n->children[c]) c++;
+            child = n->children[c];
+            break;
+        }
+        }
+    }
+    return TRIE_LEAF(child);
+}
+
+/**
+ * Bytes of node's prefix matching key from depth, exact even past the stored bytes (internal helper)
+ * @param node: Inner node with a prefix
+ * @param key: Key bytes
+ * @param len: Bytes of key to compare
+ * @param depth: Offset of the node's prefix in key
+ * @return: Matching length, at most node->prefix_len
+ */
+static inline size_t trie_prefix_mismatch(const TrieNode *node, const unsigned char *key, size_t len, size_t depth) {
+    size_t stored = node->prefix_len < TRIE_MAX_PREFIX ? node->prefix_len : TRIE_MAX_PREFIX;
+    size_t limit = len - depth < stored ? len - depth : stored;
+    size_t i = 0;
+    for (; i < limit; i++) {
+        if (node->prefix[i] != key[depth + i]) return i;
+    }
+    if (i == stored && node->prefix_len > TRIE_MAX_PREFIX) {
+        // Remaining prefix bytes equal those of any leaf below
+        const TrieLeaf *leaf = trie_minimum(node);
+        limit = node->prefix_len < len - depth ? node->prefix_len : len - depth;
+        for (; i < limit; i++) {
+            if (leaf->key[depth + i] != key[depth + i]) return i;
+        }
+    }
+    return i;
+}
+
+/**
+ * Whether leaf's key equals key (internal helper)
+ */
+static inline bool trie_leaf_matches(const TrieLeaf *leaf, const unsigned char *key, size_t len) {
+    return leaf->key_len == len && memcmp(leaf->key, key, len) == 0;
+}
+
+/**
+ * Highest score in a subtree (internal helper)
+ */
+static inline float trie_child_best(const void *child) {
+    return TRIE_IS_LEAF(child) ? TRIE_LEAF(child)->score : ((const TrieNode *)child)->best;
+}
+
+/**
+ * Find leaf of a key (internal helper)
+ * @param trie: Target trie
+ * @param key: NUL-terminated key
+ * @return: Leaf or NULL
+ */
+static inline TrieLeaf *trie_find_leaf(const Trie *trie, const char *key) {
+    const unsigned char *bytes = (const unsigned char *)key;
+    size_t len = strlen(key) + 1, depth = 0;
+    void *child = trie->root;
+    while (child) {
+        if (TRIE_IS_LEAF(child)) {
+            TrieLeaf *leaf = TRIE_LEAF(child);
+            return trie_leaf_matches(leaf, bytes, len) ? leaf : NULL;
+        }
+        TrieNode *node = (TrieNode *)child;
+        if (node->prefix_len) {
+            // Optimistic: compare the stored bytes, the final leaf check covers the rest
+            size_t stored = node->prefix_len < TRIE_MAX_PREFIX ? node->prefix_len : TRIE_MAX_PREFIX;
+            if (len - depth < stored || memcmp(node->prefix, bytes + depth, stored) != 0) return NULL;
+            depth += node->prefix_len;
+            if (depth >= len) return NULL;
+        }
+        void **slot = trie_find_child(node, bytes[depth]);
+        child = slot ? *slot : NULL;
+        depth++;
+    }
+    return NULL;
+}
+
+// ==================== NODE UPDATES ====================
+
+/**
+ * Add child for byte c, growing the node when full (internal helper)
+ * @param trie: Owning trie
+ * @param node: Inner node
+ * @param ref: Slot pointing to node (updated when the node is replaced)
+ * @param c: Key byte (not present yet)
+ * @param child: Node or tagged leaf
+ */
+static inline void trie_add_child(Trie *trie, TrieNode *node, void **ref, unsigned char c, void *child) {
+    switch (node->type) {
+    case TRIE_NODE4: {
+        TrieNode4 *n = (TrieNode4 *)node;
+        if (node->count < 4) {
+            unsigned pos = 0;
+            while (pos < node->count && n->keys[pos] < c) pos++;
+            memmove(n->keys + pos + 1, n->keys + pos, node->count - pos);
+            memmove(n->children + pos + 1, n->children + pos, (node->count - pos) * sizeof(void *));
+            n->keys[pos] = c;
+            n->children[pos] = child;
+            node->count++;
+            return;
+        }
+        TrieNode16 *grown = (TrieNode16 *)trie_node_new(trie, TRIE_NODE16);
+        trie_copy_header(&grown->n, node);
+        memcpy(grown->keys, n->keys, 4);
+        memcpy(grown->children, n->children, 4 * sizeof(void *));
+        *ref = grown;
+        trie_node_release(trie, node);
+        trie_add_child(trie, &grown->n, ref, c, child);
+        return;
+    }
+    case TRIE_NODE16: {
+        TrieNode16 *n = (TrieNode16 *)node;
+        if (node->count < 16) {
+            unsigned pos;
+#if defined(TRIE_SSE2)
+            // Unsigned byte compare via sign flip: first key greater than c
+            __m128i flip = _mm_set1_epi8((char)0x80);
+            __m128i keys = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(const void *)n->keys), flip);
+            __m128i greater = _mm_cmplt_epi8(_mm_xor_si128(_mm_set1_epi8((char)c), flip), keys);
+            unsigned mask = (unsigned)_mm_movemask_epi8(greater) & ((1u << node->count) - 1);
+            pos = mask ? trie_lowest_bit(mask) : node->count;
+#else
+            pos = 0;
+            while (pos < node->count && n->keys[pos] < c) pos++;
+#endif
+            memmove(n->keys + pos + 1, n->keys + pos, node->count - pos);
+            memmove(n->children + pos + 1, n->children + pos, (node->count - pos) * sizeof(void *));
+            n->keys[pos] = c;
+            n->children[pos] = child;
+            node->count++;
+            return;
+        }
+        TrieNode48 *grown = (TrieNode48 *)trie_node_new(trie, TRIE_NODE48);
+        trie_copy_header(&grown->n, node);
+        for (unsigned i = 0; i < 16; i++) {
+            grown->children[i] = n->children[i];
+            grown->index[n->keys[i]] = (unsigned char)(i + 1);
+        }
+        *ref = grown;
+        trie_node_release(trie, node);
+        trie_add_child(trie, &grown->n, ref, c, child);
+        return;
+    }
+    case TRIE_NODE48: {
+        TrieNode48 *n = (TrieNode48 *)node;
+        if (node->count < 48) {
+            unsigned slot = 0;
+            while (n->children[slot]) slot++;
+            n->children[slot] = child;
+            n->index[c] = (unsigned char)(slot + 1);
+            node->count++;
+            return;
+        }
+        TrieNode256 *grown = (TrieNode256 *)trie_node_new(trie, TRIE_NODE256);
+        trie_copy_header(&grown->n, node);
+        for (unsigned b = 0; b < 256; b++) {
+            if (n->index[b]) grown->children[b] = n->children[n->index[b] - 1];
+        }
+        *ref = grown;
+        trie_node_release(trie, node);
+        trie_add_child(trie, &grown->n, ref, c, child);
+        return;
+    }
+    default: {
+        TrieNode256 *n = (TrieNode256 *)node;
+        n->children[c] = child;
+        node->count++;
+        return;
+    }
+    }
+}
+
+/**
+ * New Node4 holding two children (internal helper)
+ */
+static inline TrieNode *trie_node4_pair(Trie *trie, unsigned char c1, void *child1, unsigned char c2, void *child2) {
+    TrieNode4 *n = (TrieNode4 *)trie_node_new(trie, TRIE_NODE4);
+    bool ordered = c1 < c2;
+    n->keys[0] = ordered ? c1 : c2;
+    n->children[0] = ordered ? child1 : child2;
+    n->keys[1] = ordered ? c2 : c1;
+    n->children[1] = ordered ? child2 : child1;
+    n->n.count = 2;
+    float best1 = trie_child_best(child1), best2 = trie_child_best(child2);
+    n->n.best = best1 > best2 ? best1 : best2;
+    return &n->n;
+}
+
+/**
+ * Insert a new leaf below slot ref (internal helper)
+ * @param trie: Owning trie
+ * @param ref: Slot of the subtree
+ * @param leaf: Leaf whose key is not in the trie yet
+ * @param depth: Key bytes consumed above ref
+ */
+static inline void trie_insert_at(Trie *trie, void **ref, TrieLeaf *leaf, size_t depth) {
+    const unsigned char *key = leaf->key;
+    size_t len = leaf->key_len;
+    for (;;) {
+        void *child = *ref;
+        if (!child) {
+            *ref = TRIE_TAG_LEAF(leaf);
+            return;
+        }
+
+        if (TRIE_IS_LEAF(child)) {
+            // Split a leaf: new node over the common part of both keys
+            TrieLeaf *other = TRIE_LEAF(child);
+            size_t common = 0;
+            while (other->key[depth + common] == key[depth + common]) common++;
+            TrieNode *split = trie_node4_pair(trie, other->key[depth + common], child, key[depth + common],
+                                              TRIE_TAG_LEAF(leaf));
+            split->prefix_len = (uint32_t)common;
+            memcpy(split->prefix, key + depth, common < TRIE_MAX_PREFIX ? common : TRIE_MAX_PREFIX);
+            *ref = split;
+            return;
+        }
+
+        TrieNode *node = (TrieNode *)child;
+        if (node->prefix_len) {
+            size_t match = trie_prefix_mismatch(node, key, len, depth);
+            if (match < node->prefix_len) {
+                // Split the compressed path at the first differing byte
+                unsigned char old_byte;
+                if (node->prefix_len <= TRIE_MAX_PREFIX) {
+                    old_byte = node->prefix[match];
+                    node->prefix_len -= (uint32_t)(match + 1);
+                    memmove(node->prefix, node->prefix + match + 1, node->prefix_len);
+                } else {
+                    const TrieLeaf *any = trie_minimum(node);
+                    old_byte = any->key[depth + match];
+                    node->prefix_len -= (uint32_t)(match + 1);
+                    memcpy(node->prefix, any->key + depth + match + 1,
+                           node->prefix_len < TRIE_MAX_PREFIX ? node->prefix_len : TRIE_MAX_PREFIX);
+                }
+                TrieNode *split = trie_node4_pair(trie, old_byte, node, key[depth + match], TRIE_TAG_LEAF(leaf));
+                split->prefix_len = (uint32_t)match;
+                memcpy(split->prefix, key + depth, match < TRIE_MAX_PREFIX ? match : TRIE_MAX_PREFIX);
+                *ref = split;
+                return;
+            }
+            depth += node->prefix_len;
+        }
+
+        if (leaf->score > node->best) node->best = leaf->score;
+        void **slot = trie_find_child(node, key[depth]);
+        if (!slot) {
+            trie_add_child(trie, node, ref, key[depth], TRIE_TAG_LEAF(leaf));
+            return;
+        }
+        ref = slot;
+        depth++;
+    }
+}
+
+/**
+ * Recompute a node's best score from its children (internal helper)
+ */
+static inline void trie_refresh_best(TrieNode *node) {
+    float best = -FLT_MAX;
+    switch (node->type) {
+    case TRIE_NODE4:
+    case TRIE_NODE16: {
+        void **children = node->type == TRIE_NODE4 ? ((TrieNode4 *)node)->children : ((TrieNode16 *)node)->children;
+        for (unsigned i = 0; i < node->count; i++) {
+            float score = trie_child_best(children[i]);
+            if (score > best) best = score;
+        }
+        break;
+    }
+    case TRIE_NODE48: {
+        TrieNode48 *n = (TrieNode48 *)node;
+        for (unsigned i = 0; i < 48; i++) {
+            if (n->children[i] && trie_child_best(n->children[i]) > best) best = trie_child_best(n->children[i]);
+        }
+        break;
+    }
+    default: {
+        TrieNode256 *n = (TrieNode256 *)node;
+        for (unsigned b = 0; b < 256; b++) {
+            if (n->children[b] && trie_child_best(n->children[b]) > best) best = trie_child_best(n->children[b]);
+        }
+        break;
+    }
+    }
+    node->best = best;
+}
+
+/**
+ * Remove child at slot for byte c, shrinking the node when sparse (internal helper)
+ * @param trie: Owning trie
+ * @param node: Inner node
+ * @param ref: Slot pointing to node (updated when the node is replaced)
+ * @param c: Key byte of the child
+ * @param slot: Child slot from trie_find_child
+ */
+static inline void trie_remove_child(Trie *trie, TrieNode *node, void **ref, unsigned char c, void **slot) {
+    switch (node->type) {
+    case TRIE_NODE4: {
+        TrieNode4 *n = (TrieNode4 *)node;
+        unsigned pos = (unsigned)(slot - n->children);
+        memmove(n->keys + pos, n->keys + pos + 1, node->count - 1 - pos);
+        memmove(n->children + pos, n->children + pos + 1, (node->count - 1 - pos) * sizeof(void *));
+        node->count--;
+        if (node->count == 1) {
+            // Collapse: the only child absorbs this node's prefix and key byte
+            void *only = n->children[0];
+            if (!TRIE_IS_LEAF(only)) {
+                TrieNode *below = (TrieNode *)only;
+                unsigned char prefix[TRIE_MAX_PREFIX];
+                size_t length = node->prefix_len < TRIE_MAX_PREFIX ? node->prefix_len : TRIE_MAX_PREFIX;
+                memcpy(prefix, node->prefix, length);
+                if (length < TRIE_MAX_PREFIX) prefix[length++] = n->keys[0];
+                size_t below_stored = below->prefix_len < TRIE_MAX_PREFIX ? below->prefix_len : TRIE_MAX_PREFIX;
+                size_t take = TRIE_MAX_PREFIX - length < below_stored ? TRIE_MAX_PREFIX - length : below_stored;
+                memcpy(prefix + length, below->prefix, take);
+                length += take;
+                memcpy(below->prefix, prefix, length);
+                below->prefix_len += node->prefix_len + 1;
+            }
+            *ref = only;
+            trie_node_release(trie, node);
+        }
+        return;
+    }
+    case TRIE_NODE16: {
+        TrieNode16 *n = (TrieNode16 *)node;
+        unsigned pos = (unsigned)(slot - n->children);
+        memmove(n->keys + pos, n->keys + pos + 1, node->count - 1 - pos);
+        memmove(n->children + pos, n->children + pos + 1, (node->count - 1 - pos) * sizeof(void *));
+        node->count--;
+        if (node->count == 3) {
+            TrieNode4 *shrunk = (TrieNode4 *)trie_node_new(trie, TRIE_NODE4);
+            trie_copy_header(&shrunk->n, node);
+            memcpy(shrunk->keys, n->keys, 3);
+            memcpy(shrunk->children, n->children, 3 * sizeof(void *));
+            *ref = shrunk;
+            trie_node_release(trie, node);
+        }
+        return;
+    }
+    case TRIE_NODE48: {
+        TrieNode48 *n = (TrieNode48 *)node;
+        n->children[n->index[c] - 1] = NULL;
+        n->index[c] = 0;
+        node->count--;
+        if (node->count == 12) {
+            TrieNode16 *shrunk = (TrieNode16 *)trie_node_new(trie, TRIE_NODE16);
+            trie_copy_header(&shrunk->n, node);
+            unsigned i = 0;
+            for (unsigned b = 0; b < 256; b++) {
+                if (!n->index[b]) continue;
+                shrunk->keys[i] = (unsigned char)b;
+                shrunk->children[i++] = n->children[n->index[b] - 1];
+            }
+            *ref = shrunk;
+            trie_node_release(trie, node);
+        }
+        return;
+    }
+    default: {
+        TrieNode256 *n = (TrieNode256 *)node;
+        n->children[c] = NULL;
+        node->count--;
+        if (node->count == 37) {
+            TrieNode48 *shrunk = (TrieNode48 *)trie_node_new(trie, TRIE_NODE48);
+            trie_copy_header(&shrunk->n, node);
+            unsigned i = 0;
+            for (unsigned b = 0; b < 256; b++) {
+                if (!n->children[b]) continue;
+                shrunk->children[i] = n->children[b];
+                shrunk->index[b] = (unsigned char)(++i);
+            }
+            *ref = shrunk;
+            trie_node_release(trie, node);
+        }
+        return;
+    }
+    }
+}
+
+/**
+ * Remove key below slot ref and refresh best scores on the way up (internal helper)
+ * @param trie: Owning trie
+ * @param ref: Slot of the subtree
+ * @param key: Key bytes including the NUL
+ * @param len: Key length
+ * @param depth: Key bytes consumed above ref
+ * @return: Removed leaf or NULL
+ */
+static inline TrieLeaf *trie_remove_at(Trie *trie, void **ref, const unsigned char *key, size_t len, size_t depth) {
+    void *child = *ref;
+    if (!child) return NULL;
+    if (TRIE_IS_LEAF(child)) {
+        TrieLeaf *leaf = TRIE_LEAF(child);
+        if (!trie_leaf_matches(leaf, key, len)) return NULL;
+        *ref = NULL;
+        return leaf;
+    }
+
+    TrieNode *node = (TrieNode *)child;
+    if (node->prefix_len) {
+        if (trie_prefix_mismatch(node, key, len, depth) < node->prefix_len) return NULL;
+        depth += node->prefix_len;
+        if (depth >= len) return NULL;
+    }
+    void **slot = trie_find_child(node, key[depth]);
+    if (!slot) return NULL;
+
+    TrieLeaf *removed;
+    if (TRIE_IS_LEAF(*slot)) {
+        removed = TRIE_LEAF(*slot);
+        if (!trie_leaf_matches(removed, key, len)) return NULL;
+        float best = node->best;
+        trie_remove_child(trie, node, ref, key[depth], slot);
+        if (!TRIE_IS_LEAF(*ref) && removed->score >= best) trie_refresh_best((TrieNode *)*ref);
+        return removed;
+    }
+    removed = trie_remove_at(trie, slot, key, len, depth + 1);
+    if (removed && removed->score >= node->best) trie_refresh_best(node);
+    return removed;
+}
+
+/**
+ * Set a leaf's score and refresh the cached maxima on its path (internal helper)
+ * @param node: Subtree root (inner node)
+ * @param leaf: Leaf below node
+ * @param score: New score
+ * @param depth: Key bytes consumed above node
+ */
+static inline void trie_rescore_at(TrieNode *node, TrieLeaf *leaf, float score, size_t depth) {
+    depth += node->prefix_len;
+    void *child = *trie_find_child(node, leaf->key[depth]);
+    if (TRIE_IS_LEAF(child)) {
+        leaf->score = score;
+    } else {
+        trie_rescore_at((TrieNode *)child, leaf, score, depth + 1);
+    }
+    if (score >= node->best) {
+        node->best = score;
+    } else {
+        trie_refresh_best(node);
+    }
+}
+
+// ==================== CORE OPERATIONS ====================
+
+/**
+ * Insert or replace key
+ * @param trie: Target trie
+ * @param key: NUL-terminated key (borrowed, must outlive the entry)
+ * @param score: Ranking used by top-k completion
+ * @param value: Value to store
+ * @return: true if the key was new, false if an existing entry was replaced
+ */
+static inline bool trie_insert(Trie *trie, const char *key, float score, void *value) {
+    TrieLeaf *existing = trie_find_leaf(trie, key);
+    if (existing) {
+        existing->value = value;
+        if (existing->score != score) {
+            if (TRIE_IS_LEAF(trie->root)) {
+                existing->score = score;
+            } else {
+                trie_rescore_at((TrieNode *)trie->root, existing, score, 0);
+            }
+        }
+        return false;
+    }
+    TrieLeaf *leaf = (TrieLeaf *)pool_alloc(&trie->leaf_pool);
+    if (!leaf) {
+        fprintf(stderr, "trie_insert: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    leaf->key = (const unsigned char *)key;
+    leaf->key_len = (uint32_t)(strlen(key) + 1);
+    leaf->score = score;
+    leaf->value = value;
+    trie_insert_at(trie, &trie->root, leaf, 0);
+    trie->size++;
+    return true;
+}
+
+/**
+ * Look up key
+ * @param trie: Target trie
+ * @param key: NUL-terminated key
+ * @return: Value or NULL if absent
+ */
+static inline void *trie_get(const Trie *trie, const char *key) {
+    TrieLeaf *leaf = trie_find_leaf(trie, key);
+    return leaf ? leaf->value : NULL;
+}
+
+/**
+ * Check whether key is present
+ * @param trie: Target trie
+ * @param key: NUL-terminated key
+ * @return: true if present
+ */
+static inline bool trie_contains(const Trie *trie, const char *key) {
+    return trie_find_leaf(trie, key) != NULL;
+}
+
+/**
+ * Change the score of an existing key
+ * @param trie: Target trie
+ * @param key: NUL-terminated key
+ * @param score: New score
+ * @return: true if key was found
+ */
+static inline bool trie_update_score(Trie *trie, const char *key, float score) {
+    TrieLeaf *leaf = trie_find_leaf(trie, key);
+    if (!leaf) return false;
+    if (TRIE_IS_LEAF(trie->root)) {
+        leaf->score = score;
+    } else {
+        trie_rescore_at((TrieNode *)trie->root, leaf, score, 0);
+    }
+    return true;
+}
+
+/**
+ * Remove key
+ * @param trie: Target trie
+ * @param key: NUL-terminated key
+ * @return: Removed value, NULL if absent
+ */
+static inline void *trie_remove(Trie *trie, const char *key) {
+    TrieLeaf *leaf = trie_remove_at(trie, &trie->root, (const unsigned char *)key, strlen(key) + 1, 0);
+    if (!leaf) return NULL;
+    void *value = leaf->value;
+    pool_free(&trie->leaf_pool, leaf);
+    trie->size--;
+    return value;
+}
+
+/**
+ * Get number of keys
+ * @param trie: Target trie
+ * @return: Key count
+ */
+static inline size_t trie_size(const Trie *trie) {
+    return trie->size;
+}
+
+/**
+ * Free every node and leaf (keys are borrowed and not freed)
+ * @param trie: Trie to free
+ */
+static inline void trie_free(Trie *trie) {
+    pool_destroy(&trie->node4_pool);
+    pool_destroy(&trie->node16_pool);
+    pool_destroy(&trie->node48_pool);
+    pool_destroy(&trie->node256_pool);
+    pool_destroy(&trie->leaf_pool);
+    trie->root = NULL;
+    trie->size = 0;
+}
+
+// ==================== PREFIX SEARCH ====================
+
+/**
+ * Subtree holding exactly the keys that start with prefix (internal helper)
+ * @param trie: Target trie
+ * @param prefix: Prefix bytes (no NUL)
+ * @param len: Prefix length
+ * @return: Node or tagged leaf, NULL if no key matches
+ */
+static inline void *trie_prefix_root(const Trie *trie, const unsigned char *prefix, size_t len) {
+    void *child = trie->root;
+    size_t depth = 0;
+    while (child) {
+        if (TRIE_IS_LEAF(child)) {
+            const TrieLeaf *leaf = TRIE_LEAF(child);
+            return leaf->key_len > len && memcmp(leaf->key, prefix, len) == 0 ? child : NULL;
+        }
+        if (depth == len) return child;
+        TrieNode *node = (TrieNode *)child;
+        if (node->prefix_len) {
+            size_t match = trie_prefix_mismatch(node, prefix, len, depth);
+            if (depth + match == len) return child; // Prefix ends inside this node's path
+            if (match < node->prefix_len) return NULL;
+            depth += node->prefix_len;
+        }
+        void **slot = trie_find_child(node, prefix[depth]);
+        child = slot ? *slot : NULL;
+        depth++;
+    }
+    return NULL;
+}
+
+/**
+ * Visit a subtree in key order (internal helper)
+ * @param child: Node or tagged leaf
+ * @param fn: Callback
+ * @param ctx: Callback context
+ * @param visited: Incremented per visited key
+ * @return: false once the callback stops iteration
+ */
+static inline bool trie_visit(const void *child, TrieVisitFn fn, void *ctx, size_t *visited) {
+    if (TRIE_IS_LEAF(child)) {
+        TrieLeaf *leaf = TRIE_LEAF(child);
+        (*visited)++;
+        return fn((const char *)leaf->key, leaf->value, ctx);
+    }
+    const TrieNode *node = (const TrieNode *)child;
+    switch (node->type) {
+    case TRIE_NODE4:
+    case TRIE_NODE16: {
+        void *const *children = node->type == TRIE_NODE4 ? ((const TrieNode4 *)node)->children
+                                                         : ((const TrieNode16 *)node)->children;
+        for (unsigned i = 0; i < node->count; i++) {
+            if (!trie_visit(children[i], fn, ctx, visited)) return false;
+        }
+        return true;
+    }
+    case TRIE_NODE48: {
+        const TrieNode48 *n = (const TrieNode48 *)node;
+        for (unsigned b = 0; b < 256; b++) {
+            if (n->index[b] && !trie_visit(n->children[n->index[b] - 1], fn, ctx, visited)) return false;
+        }
+        return true;
+    }
+    default: {
+        const TrieNode256 *n = (const TrieNode256 *)node;
+        for (unsigned b = 0; b < 256; b++) {
+            if (n->children[b] && !trie_visit(n->children[b], fn, ctx, visited)) return false;
+        }
+        return true;
+    }
+    }
+}
+
+/**
+ * Visit keys starting with prefix in lexicographic (byte) order
+ * @param trie: Target trie
+ * @param prefix: Prefix ("" visits every key)
+ * @param fn: Callback, return false to stop
+ * @param ctx: Callback context
+ * @return: Number of keys visited
+ */
+static inline size_t trie_prefix_iterate(const Trie *trie, const char *prefix, TrieVisitFn fn, void *ctx) {
+    const void *root = trie_prefix_root(trie, (const unsigned char *)prefix, strlen(prefix));
+    size_t visited = 0;
+    if (root) trie_visit(root, fn, ctx, &visited);
+    return visited;
+}
+
+// Best-first frontier entry for top-k completion (internal)
+typedef struct TrieFrontier {
+    float best;
+    void *child;
+} TrieFrontier;
+
+// Frontier entries kept on the stack before top-k spills to the heap
+#define TRIE_FRONTIER_LOCAL 64
+
+/**
+ * Push onto the frontier max-heap (internal helper)
+ * @param heap: Heap array, initially local
+ * @param local: Stack buffer that must not be freed
+ */
+static inline void trie_frontier_push(TrieFrontier **heap, const TrieFrontier *local, size_t *size,
+                                      size_t *capacity, void *child) {
+    if (*size == *capacity) {
+        *capacity *= 2;
+        TrieFrontier *grown = *heap == local ? (TrieFrontier *)malloc(*capacity * sizeof(TrieFrontier))
+                                             : (TrieFrontier *)realloc(*heap, *capacity * sizeof(TrieFrontier));
+        if (!grown) {
+            fprintf(stderr, "trie_top_k: allocation failed\n");
+            exit(EXIT_FAILURE);
+        }
+        if (*heap == local) memcpy(grown, local, *size * sizeof(TrieFrontier));
+        *heap = grown;
+    }
+    TrieFrontier entry = {trie_child_best(child), child};
+    size_t i = (*size)++;
+    while (i > 0 && (*heap)[(i - 1) / 2].best < entry.best) {
+        (*heap)[i] = (*heap)[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    (*heap)[i] = entry;
+}
+
+/**
+ * Pop the highest entry of the frontier max-heap (internal helper)
+ */
+static inline void *trie_frontier_pop(TrieFrontier *heap, size_t *size) {
+    void *top = heap[0].child;
+    TrieFrontier last = heap[--(*size)];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= *size) break;
+        if (child + 1 < *size && heap[child + 1].best > heap[child].best) child++;
+        if (heap[child].best <= last.best) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    if (*size) heap[i] = last;
+    return top;
+}
+
+/**
+ * Highest-scoring keys that start with prefix
+ * Subtrees are expanded best-first by their cached maximum, so only the
+ * paths towards the k results are explored.
+ * @param trie: Target trie
+ * @param prefix: Prefix ("" ranks every key)
+ * @param k: Results wanted
+ * @param values: Receives up to k values, highest score first
+ * @return: Number of values written
+ */
+static inline size_t trie_top_k(const Trie *trie, const char *prefix, size_t k, void **values) {
+    void *root = trie_prefix_root(trie, (const unsigned char *)prefix, strlen(prefix));
+    if (!root || k == 0) return 0;
+    TrieFrontier local[TRIE_FRONTIER_LOCAL];
+    TrieFrontier *heap = local;
+    size_t size = 1, capacity = TRIE_FRONTIER_LOCAL, found = 0;
+    local[0] = (TrieFrontier){trie_child_best(root), root};
+    while (size && found < k) {
+        void *child = trie_frontier_pop(heap, &size);
+        if (TRIE_IS_LEAF(child)) {
+            values[found++] = TRIE_LEAF(child)->value;
+            continue;
+        }
+        const TrieNode *node = (const TrieNode *)child;
+        switch (node->type) {
+        case TRIE_NODE4:
+        case TRIE_NODE16: {
+            void *const *children = node->type == TRIE_NODE4 ? ((const TrieNode4 *)node)->children
+                                                             : ((const TrieNode16 *)node)->children;
+            for (unsigned i = 0; i < node->count; i++) trie_frontier_push(&heap, local, &size, &capacity, children[i]);
+            break;
+        }
+        case TRIE_NODE48: {
+            const TrieNode48 *n = (const TrieNode48 *)node;
+            for (unsigned i = 0; i < 48; i++) {
+                if (n->children[i]) trie_frontier_push(&heap, local, &size, &capacity, n->children[i]);
+            }
+            break;
+        }
+        default: {
+            const TrieNode256 *n = (const TrieNode256 *)node;
+            for (unsigned b = 0; b < 256; b++) {
+                if (n->children[b]) trie_frontier_push(&heap, local, &size, &capacity, n->children[b]);
+            }
+            break;
+        }
+        }
+    }
+    if (heap != local) free(heap);
+    return found;
+}
+
+#endif // TRIE_H
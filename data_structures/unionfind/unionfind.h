@@ -3,18 +3,32 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <pthread.h>
 
 /**
  * UNION-FIND (DISJOINT SET UNION) IMPLEMENTATION
  *
  * Efficient data structure for maintaining disjoint sets with union and find operations.
- * Uses path compression and union by rank optimizations for nearly constant time operations.
+ * Uses path halving and union by size optimizations for nearly constant time operations.
+ *
+ * Memory layout: one signed index per element. A non-negative entry is the
+ * parent's index; a negative entry marks a root and stores -(size of its set).
+ * A union touches two entries instead of parent, rank and size arrays.
+ *
+ * Indices are 64-bit so sets can exceed 2^31 elements; define
+ * UNIONFIND_32BIT_INDEX before including to halve memory when n < 2^31.
+ *
+ * unionfind_union_edges() unions a whole edge list across threads. Threads
+ * link roots with a single CAS, ordered by a fixed per-index priority so no
+ * cycle can form; set sizes are rebuilt in one pass after the threads join.
  *
  * Time Complexities (with optimizations):
  * - Find: O(α(n)) - inverse Ackermann function (practically constant)
  * - Union: O(α(n)) - inverse Ackermann function (practically constant)
  * - Connected: O(α(n)) - two find operations
+ * - Union edges: O(m α(n) / threads + n)
  *
  * Space Complexity: O(n) where n is number of elements
  *
@@ -27,14 +41,19 @@
  * - Cycle detection in graphs
  */
 
+// Element index type
+#ifdef UNIONFIND_32BIT_INDEX
+typedef int32_t unionfind_index_t;
+#else
+typedef int64_t unionfind_index_t;
+#endif
+
 // Union-Find structure
 typedef struct UnionFind
 {
-    int *parent;    // Parent array for tree structure
-    int *rank;      // Rank array for union by rank optimization
-    int *size;      // Size of each component (optional)
-    int n;          // Total number of elements
-    int components; // Number of disjoint components
+    unionfind_index_t *parent;    // Parent index, or -(set size) at a root
+    unionfind_index_t n;          // Total number of elements
+    unionfind_index_t components; // Number of disjoint components
 } UnionFind;
 
 // ==================== CORE OPERATIONS ====================
@@ -44,86 +63,77 @@ typedef struct UnionFind
  * @param uf: UnionFind structure to initialize
  * @param n: Number of elements (0 to n-1)
  */
-static inline void unionfind_init(UnionFind *uf, int n)
+static inline void unionfind_init(UnionFind *uf, unionfind_index_t n)
 {
     uf->n = n;
     uf->components = n; // Initially each element is its own component
 
-    // Allocate arrays
-    uf->parent = (int *)malloc(n * sizeof(int));
-    uf->rank = (int *)malloc(n * sizeof(int));
-    uf->size = (int *)malloc(n * sizeof(int));
-
-    if (!uf->parent || !uf->rank || !uf->size)
+    uf->parent = (unionfind_index_t *)malloc((n > 0 ? (size_t)n : 1) * sizeof(unionfind_index_t));
+    if (!uf->parent)
     {
         fprintf(stderr, "unionfind_init: allocation failed\n");
         exit(EXIT_FAILURE);
     }
 
-    // Initialize: each element is its own parent with rank 0 and size 1
-    for (int i = 0; i < n; i++)
+    // Initialize: each element is a root of size 1
+    for (unionfind_index_t i = 0; i < n; i++)
     {
-        uf->parent[i] = i;
-        uf->rank[i] = 0;
-        uf->size[i] = 1;
+        uf->parent[i] = -1;
     }
 }
 
 /**
- * Find root of element with path compression
+ * Find root of element with path halving
+ * Iterative, so deep trees cannot overflow the stack.
  * @param uf: UnionFind structure
  * @param x: Element to find root of
  * @return: Root of the set containing x
  */
-static inline int unionfind_find(UnionFind *uf, int x)
+static inline unionfind_index_t unionfind_find(UnionFind *uf, unionfind_index_t x)
 {
     if (x < 0 || x >= uf->n)
         return -1; // Invalid element
 
-    // Path compression: make every node point directly to root
-    if (uf->parent[x] != x)
+    unionfind_index_t *parent = uf->parent;
+    while (parent[x] >= 0)
     {
-        uf->parent[x] = unionfind_find(uf, uf->parent[x]);
+        unionfind_index_t p = parent[x];
+        if (parent[p] < 0)
+            return p;
+        // Path halving: point x at its grandparent and skip ahead
+        parent[x] = parent[p];
+        x = parent[p];
     }
-    return uf->parent[x];
+    return x;
 }
 
 /**
  * Union two sets containing elements x and y
- * Uses union by rank optimization
+ * Uses union by size optimization
  * @param uf: UnionFind structure
  * @param x: First element
  * @param y: Second element
  * @return: true if union was performed (elements were in different sets)
  */
-static inline bool unionfind_union(UnionFind *uf, int x, int y)
+static inline bool unionfind_union(UnionFind *uf, unionfind_index_t x, unionfind_index_t y)
 {
-    int root_x = unionfind_find(uf, x);
-    int root_y = unionfind_find(uf, y);
+    unionfind_index_t root_x = unionfind_find(uf, x);
+    unionfind_index_t root_y = unionfind_find(uf, y);
 
     if (root_x == -1 || root_y == -1)
         return false; // Invalid elements
     if (root_x == root_y)
         return false; // Already in same set
 
-    // Union by rank: attach smaller tree under larger tree
-    if (uf->rank[root_x] < uf->rank[root_y])
-    {
-        uf->parent[root_x] = root_y;
-        uf->size[root_y] += uf->size[root_x];
-    }
-    else if (uf->rank[root_x] > uf->rank[root_y])
+    // Union by size: attach smaller tree under larger tree (sizes are negated)
+    if (uf->parent[root_x] > uf->parent[root_y])
     {
-        uf->parent[root_y] = root_x;
-        uf->size[root_x] += uf->size[root_y];
-    }
-    else
-    {
-        // Same rank: make one root and increase its rank
-        uf->parent[root_y] = root_x;
-        uf->size[root_x] += uf->size[root_y];
-        uf->rank[root_x]++;
+        unionfind_index_t tmp = root_x;
+        root_x = root_y;
+        root_y = tmp;
     }
+    uf->parent[root_x] += uf->parent[root_y];
+    uf->parent[root_y] = root_x;
 
     uf->components--; // One less component after union
     return true;
@@ -136,7 +146,7 @@ static inline bool unionfind_union(UnionFind *uf, int x, int y)
  * @param y: Second element
  * @return: true if x and y are in the same set
  */
-static inline bool unionfind_connected(UnionFind *uf, int x, int y)
+static inline bool unionfind_connected(UnionFind *uf, unionfind_index_t x, unionfind_index_t y)
 {
     return unionfind_find(uf, x) == unionfind_find(uf, y);
 }
@@ -147,10 +157,10 @@ static inline bool unionfind_connected(UnionFind *uf, int x, int y)
  * @param x: Element to query
  * @return: Size of set containing x, -1 if invalid element
  */
-static inline int unionfind_size_of(UnionFind *uf, int x)
+static inline unionfind_index_t unionfind_size_of(UnionFind *uf, unionfind_index_t x)
 {
-    int root = unionfind_find(uf, x);
-    return root == -1 ? -1 : uf->size[root];
+    unionfind_index_t root = unionfind_find(uf, x);
+    return root == -1 ? -1 : -uf->parent[root];
 }
 
 /**
@@ -158,7 +168,7 @@ static inline int unionfind_size_of(UnionFind *uf, int x)
  * @param uf: UnionFind structure
  * @return: Number of separate components
  */
-static inline int unionfind_components(UnionFind *uf)
+static inline unionfind_index_t unionfind_components(UnionFind *uf)
 {
     return uf->components;
 }
@@ -168,7 +178,7 @@ static inline int unionfind_components(UnionFind *uf)
  * @param uf: UnionFind structure
  * @return: Total number of elements
  */
-static inline int unionfind_count(UnionFind *uf)
+static inline unionfind_index_t unionfind_count(UnionFind *uf)
 {
     return uf->n;
 }
@@ -179,11 +189,11 @@ static inline int unionfind_count(UnionFind *uf)
  * @param x: Element to check
  * @return: true if x is a root
  */
-static inline bool unionfind_is_root(UnionFind *uf, int x)
+static inline bool unionfind_is_root(UnionFind *uf, unionfind_index_t x)
 {
     if (x < 0 || x >= uf->n)
         return false;
-    return uf->parent[x] == x;
+    return uf->parent[x] < 0;
 }
 
 // ==================== UTILITY OPERATIONS ====================
@@ -194,10 +204,10 @@ static inline bool unionfind_is_root(UnionFind *uf, int x)
  * @param roots: Array to store roots (caller must allocate)
  * @return: Number of roots found
  */
-static inline int unionfind_get_roots(UnionFind *uf, int *roots)
+static inline unionfind_index_t unionfind_get_roots(UnionFind *uf, unionfind_index_t *roots)
 {
-    int count = 0;
-    for (int i = 0; i < uf->n; i++)
+    unionfind_index_t count = 0;
+    for (unionfind_index_t i = 0; i < uf->n; i++)
     {
         if (unionfind_is_root(uf, i))
         {
@@ -214,14 +224,15 @@ static inline int unionfind_get_roots(UnionFind *uf, int *roots)
  * @param component: Array to store component elements (caller must allocate)
  * @return: Number of elements in component, -1 if invalid x
  */
-static inline int unionfind_get_component(UnionFind *uf, int x, int *component)
+static inline unionfind_index_t unionfind_get_component(UnionFind *uf, unionfind_index_t x,
+                                                        unionfind_index_t *component)
 {
-    int root = unionfind_find(uf, x);
+    unionfind_index_t root = unionfind_find(uf, x);
     if (root == -1)
         return -1;
 
-    int count = 0;
-    for (int i = 0; i < uf->n; i++)
+    unionfind_index_t count = 0;
+    for (unionfind_index_t i = 0; i < uf->n; i++)
     {
         if (unionfind_find(uf, i) == root)
         {
@@ -239,11 +250,9 @@ static inline void unionfind_reset(UnionFind *uf)
 {
     uf->components = uf->n;
 
-    for (int i = 0; i < uf->n; i++)
+    for (unionfind_index_t i = 0; i < uf->n; i++)
     {
-        uf->parent[i] = i;
-        uf->rank[i] = 0;
-        uf->size[i] = 1;
+        uf->parent[i] = -1;
     }
 }
 
@@ -258,16 +267,6 @@ static inline void unionfind_free(UnionFind *uf)
         free(uf->parent);
         uf->parent = NULL;
     }
-    if (uf->rank)
-    {
-        free(uf->rank);
-        uf->rank = NULL;
-    }
-    if (uf->size)
-    {
-        free(uf->size);
-        uf->size = NULL;
-    }
     uf->n = 0;
     uf->components = 0;
 }
@@ -281,33 +280,29 @@ static inline void unionfind_free(UnionFind *uf)
 static inline void unionfind_print(UnionFind *uf)
 {
     printf("Union-Find Structure:\n");
-    printf("  Elements: %d, Components: %d\n", uf->n, uf->components);
+    printf("  Elements: %lld, Components: %lld\n", (long long)uf->n, (long long)uf->components);
 
     printf("  Element:  ");
-    for (int i = 0; i < uf->n; i++)
+    for (unionfind_index_t i = 0; i < uf->n; i++)
     {
-        printf("%3d ", i);
+        printf("%3lld ", (long long)i);
     }
     printf("\n");
 
     printf("  Parent:   ");
-    for (int i = 0; i < uf->n; i++)
+    for (unionfind_index_t i = 0; i < uf->n; i++)
     {
-        printf("%3d ", uf->parent[i]);
-    }
-    printf("\n");
-
-    printf("  Rank:     ");
-    for (int i = 0; i < uf->n; i++)
-    {
-        printf("%3d ", uf->rank[i]);
+        printf("%3lld ", (long long)(uf->parent[i] < 0 ? i : uf->parent[i]));
     }
     printf("\n");
 
     printf("  Size:     ");
-    for (int i = 0; i < uf->n; i++)
+    for (unionfind_index_t i = 0; i < uf->n; i++)
     {
-        printf("%3d ", uf->size[i]);
+        if (uf->parent[i] < 0)
+            printf("%3lld ", (long long)-uf->parent[i]);
+        else
+            printf("  - ");
     }
     printf("\n");
 }
@@ -318,10 +313,10 @@ static inline void unionfind_print(UnionFind *uf)
  */
 static inline void unionfind_print_components(UnionFind *uf)
 {
-    printf("Components (%d total):\n", uf->components);
+    printf("Components (%lld total):\n", (long long)uf->components);
 
-    int *roots = (int *)malloc(uf->n * sizeof(int));
-    int *component = (int *)malloc(uf->n * sizeof(int));
+    unionfind_index_t *roots = (unionfind_index_t *)malloc(uf->n * sizeof(unionfind_index_t));
+    unionfind_index_t *component = (unionfind_index_t *)malloc(uf->n * sizeof(unionfind_index_t));
 
     if (!roots || !component)
     {
@@ -330,17 +325,17 @@ static inline void unionfind_print_components(UnionFind *uf)
         return;
     }
 
-    int num_roots = unionfind_get_roots(uf, roots);
+    unionfind_index_t num_roots = unionfind_get_roots(uf, roots);
 
-    for (int i = 0; i < num_roots; i++)
+    for (unionfind_index_t i = 0; i < num_roots; i++)
     {
-        int root = roots[i];
-        int comp_size = unionfind_get_component(uf, root, component);
+        unionfind_index_t root = roots[i];
+        unionfind_index_t comp_size = unionfind_get_component(uf, root, component);
 
-        printf("  Component %d (size %d): { ", i + 1, comp_size);
-        for (int j = 0; j < comp_size; j++)
+        printf("  Component %lld (size %lld): { ", (long long)i + 1, (long long)comp_size);
+        for (unionfind_index_t j = 0; j < comp_size; j++)
         {
-            printf("%d", component[j]);
+            printf("%lld", (long long)component[j]);
             if (j < comp_size - 1)
                 printf(", ");
         }
@@ -358,54 +353,42 @@ static inline void unionfind_print_components(UnionFind *uf)
  */
 static inline bool unionfind_validate(UnionFind *uf)
 {
-    // Check that all elements are valid
-    for (int i = 0; i < uf->n; i++)
+    // Check that all parent links are in range and root sizes add up to n
+    unionfind_index_t actual_components = 0;
+    unionfind_index_t total_size = 0;
+    for (unionfind_index_t i = 0; i < uf->n; i++)
     {
-        if (uf->parent[i] < 0 || uf->parent[i] >= uf->n)
+        if (uf->parent[i] >= uf->n || uf->parent[i] == i)
         {
             return false; // Invalid parent
         }
-        if (uf->rank[i] < 0)
-        {
-            return false; // Invalid rank
-        }
-        if (uf->size[i] < 1)
-        {
-            return false; // Invalid size
-        }
-    }
-
-    // Check that component count is correct
-    int actual_components = 0;
-    for (int i = 0; i < uf->n; i++)
-    {
-        if (unionfind_is_root(uf, i))
+        if (uf->parent[i] < 0)
         {
             actual_components++;
+            total_size -= uf->parent[i];
         }
     }
 
-    return actual_components == uf->components;
+    return actual_components == uf->components && total_size == uf->n;
 }
 
 // ==================== SPECIALIZED OPERATIONS ====================
 
 /**
- * @brief
- *
- *
+ * Union all listed elements into a single set
  * @param uf: UnionFind structure
  * @param elements: Array of elements to union
  * @param count: Number of elements
  * @return: Number of unions performed
  */
-static inline int unionfind_union_all(UnionFind *uf, int *elements, int count)
+static inline unionfind_index_t unionfind_union_all(UnionFind *uf, const unionfind_index_t *elements,
+                                                    unionfind_index_t count)
 {
     if (count < 2)
         return 0;
 
-    int unions_performed = 0;
-    for (int i = 1; i < count; i++)
+    unionfind_index_t unions_performed = 0;
+    for (unionfind_index_t i = 1; i < count; i++)
     {
         if (unionfind_union(uf, elements[0], elements[i]))
         {
@@ -415,6 +398,203 @@ static inline int unionfind_union_all(UnionFind *uf, int *elements, int count)
     return unions_performed;
 }
 
+// ==================== PARALLEL BULK UNION ====================
+
+// Per-thread slice of an edge list
+typedef struct UnionFindEdgeTask
+{
+    UnionFind *uf;
+    const unionfind_index_t *edges; // Flat (u, v) pairs
+    size_t begin;                   // First pair of the slice
+    size_t end;                     // One past the last pair
+    size_t unions;                  // Successful links made by this thread
+} UnionFindEdgeTask;
+
+/**
+ * Fixed link priority: roots are only linked under higher-priority roots (internal helper)
+ * Multiplying by an odd constant is a bijection, so priorities never tie, and
+ * which root wins looks random rather than following index order.
+ * @param x: Element index
+ * @return: Priority of x
+ */
+static inline uint64_t unionfind_priority(unionfind_index_t x)
+{
+    return (uint64_t)x * 0x9E3779B97F4A7C15ull;
+}
+
+/**
+ * Find root while other threads link and halve concurrently (internal helper)
+ * @param parent: Shared parent array
+ * @param x: Valid element
+ * @return: Root observed for x
+ */
+static inline unionfind_index_t unionfind_find_concurrent(unionfind_index_t *parent, unionfind_index_t x)
+{
+    while (true)
+    {
+        unionfind_index_t p = __atomic_load_n(&parent[x], __ATOMIC_ACQUIRE);
+        if (p < 0)
+            return x;
+        unionfind_index_t gp = __atomic_load_n(&parent[p], __ATOMIC_ACQUIRE);
+        if (gp < 0)
+            return p;
+        // Path halving: only replaces a parent link with an ancestor, never a root marker
+        __atomic_compare_exchange_n(&parent[x], &p, gp, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+        x = gp;
+    }
+}
+
+/**
+ * Link the sets of u and v with a CAS on the losing root (internal helper)
+ * @param parent: Shared parent array
+ * @param u: First element
+ * @param v: Second element
+ * @return: true if this call merged two sets
+ */
+static inline bool unionfind_union_concurrent(unionfind_index_t *parent, unionfind_index_t u, unionfind_index_t v)
+{
+    while (true)
+    {
+        unionfind_index_t root_u = unionfind_find_concurrent(parent, u);
+        unionfind_index_t root_v = unionfind_find_concurrent(parent, v);
+        if (root_u == root_v)
+            return false;
+
+        // The lower-priority root becomes the child
+        if (unionfind_priority(root_u) > unionfind_priority(root_v))
+        {
+            unionfind_index_t tmp = root_u;
+            root_u = root_v;
+            root_v = tmp;
+        }
+        unionfind_index_t marker = __atomic_load_n(&parent[root_u], __ATOMIC_ACQUIRE);
+        if (marker < 0 &&
+            __atomic_compare_exchange_n(&parent[root_u], &marker, root_v, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            return true;
+        }
+        // root_u was linked by another thread meanwhile; retry from the new roots
+        u = root_u;
+    }
+}
+
+/**
+ * Thread entry for unionfind_union_edges (internal helper)
+ * @param arg: UnionFindEdgeTask
+ * @return: NULL
+ */
+static inline void *unionfind_edge_worker(void *arg)
+{
+    UnionFindEdgeTask *task = (UnionFindEdgeTask *)arg;
+    unionfind_index_t *parent = task->uf->parent;
+    for (size_t i = task->begin; i < task->end; i++)
+    {
+        if (unionfind_union_concurrent(parent, task->edges[2 * i], task->edges[2 * i + 1]))
+        {
+            task->unions++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Restore root sizes and component count after concurrent linking (internal helper)
+ * Root markers lost their sizes when linked, so sizes are recounted from scratch.
+ * @param uf: UnionFind structure
+ */
+static inline void unionfind_rebuild_sizes(UnionFind *uf)
+{
+    unionfind_index_t *parent = uf->parent;
+    uf->components = 0;
+    for (unionfind_index_t i = 0; i < uf->n; i++)
+    {
+        if (parent[i] < 0)
+        {
+            parent[i] = -1;
+            uf->components++;
+        }
+    }
+    // Point every element straight at its root, then count it there
+    for (unionfind_index_t i = 0; i < uf->n; i++)
+    {
+        if (parent[i] >= 0)
+            parent[i] = unionfind_find(uf, i);
+    }
+    for (unionfind_index_t i = 0; i < uf->n; i++)
+    {
+        if (parent[i] >= 0)
+            parent[parent[i]]--;
+    }
+}
+
+/**
+ * Union every (u, v) pair of an edge list, optionally across threads
+ * Out-of-range endpoints are skipped. With more than one thread the pairs are
+ * split into contiguous slices and linked lock-free; the structure must not be
+ * used by anyone else until the call returns.
+ * @param uf: UnionFind structure
+ * @param edges: Flat array of 2 * edge_count endpoints
+ * @param edge_count: Number of pairs
+ * @param num_threads: Worker threads (0 or 1 runs on the calling thread)
+ * @return: Number of unions performed
+ */
+static inline size_t unionfind_union_edges(UnionFind *uf, const unionfind_index_t *edges, size_t edge_count,
+                                           unsigned num_threads)
+{
+    for (size_t i = 0; i < 2 * edge_count; i++)
+    {
+        if (edges[i] < 0 || edges[i] >= uf->n)
+        {
+            // Rare: fall back to the checked sequential path
+            num_threads = 1;
+            break;
+        }
+    }
+
+    if (num_threads <= 1 || edge_count < num_threads)
+    {
+        size_t unions = 0;
+        for (size_t i = 0; i < edge_count; i++)
+        {
+            if (unionfind_union(uf, edges[2 * i], edges[2 * i + 1]))
+                unions++;
+        }
+        return unions;
+    }
+
+    pthread_t *threads = (pthread_t *)malloc(num_threads * sizeof(pthread_t));
+    UnionFindEdgeTask *tasks = (UnionFindEdgeTask *)malloc(num_threads * sizeof(UnionFindEdgeTask));
+    if (!threads || !tasks)
+    {
+        fprintf(stderr, "unionfind_union_edges: allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t chunk = edge_count / num_threads;
+    for (unsigned t = 0; t < num_threads; t++)
+    {
+        tasks[t].uf = uf;
+        tasks[t].edges = edges;
+        tasks[t].begin = t * chunk;
+        tasks[t].end = (t == num_threads - 1) ? edge_count : (t + 1) * chunk;
+        tasks[t].unions = 0;
+        pthread_create(&threads[t], NULL, unionfind_edge_worker, &tasks[t]);
+    }
+
+    size_t unions = 0;
+    for (unsigned t = 0; t < num_threads; t++)
+    {
+        pthread_join(threads[t], NULL);
+        unions += tasks[t].unions;
+    }
+    free(threads);
+    free(tasks);
+
+    unionfind_rebuild_sizes(uf);
+    return unions;
+}
+
 /**
  * Check if all elements are connected (single component)
  * @param uf: UnionFind structure
@@ -430,14 +610,14 @@ static inline bool unionfind_all_connected(UnionFind *uf)
  * @param uf: UnionFind structure
  * @return: Size of largest component
  */
-static inline int unionfind_max_component_size(UnionFind *uf)
+static inline unionfind_index_t unionfind_max_component_size(UnionFind *uf)
 {
-    int max_size = 0;
-    for (int i = 0; i < uf->n; i++)
+    unionfind_index_t max_size = 0;
+    for (unionfind_index_t i = 0; i < uf->n; i++)
     {
-        if (unionfind_is_root(uf, i) && uf->size[i] > max_size)
+        if (uf->parent[i] < 0 && -uf->parent[i] > max_size)
         {
-            max_size = uf->size[i];
+            max_size = -uf->parent[i];
         }
     }
     return max_size;
@@ -451,4 +631,4 @@ static inline int unionfind_max_component_size(UnionFind *uf)
 #define UNIONFIND_CONNECTED(uf, x, y) unionfind_connected(&(uf), (x), (y))
 #define UNIONFIND_FREE(uf) unionfind_free(&(uf))
 
-#endif // UNIONFIND_H
\ No newline at end of file
+#endif // UNIONFIND_H